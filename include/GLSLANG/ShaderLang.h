@@ -13,6 +13,7 @@
 #include <array>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 //
@@ -25,7 +26,7 @@
 
 // Version number for shader translation API.
 // It is incremented every time the API changes.
-#define ANGLE_SH_VERSION 169
+#define ANGLE_SH_VERSION 177
 
 enum ShShaderSpec
 {
@@ -211,6 +212,23 @@ const ShCompileOptions SH_REWRITE_FLOAT_UNARY_MINUS_OPERATOR = UINT64_C(1) << 29
 // It works by using an expression to emulate this function.
 const ShCompileOptions SH_EMULATE_ATAN2_FLOAT_FUNCTION = UINT64_C(1) << 30;
 
+// This flag makes the compiler time each of its passes and measure the size of the shader.
+// The results can be queried by calling sh::GetCompileStatistics().
+const ShCompileOptions SH_COLLECT_COMPILE_STATISTICS = UINT64_C(1) << 31;
+
+// This flag makes the compiler remove code from function bodies that can't affect the results of
+// the shader, and compute built-in calls that a statement repeats only once. The translated code is
+// smaller and quicker for the driver to compile. Variable reflection only includes the variables
+// that the remaining code uses.
+const ShCompileOptions SH_OPTIMIZE_OUTPUT = UINT64_C(1) << 32;
+
+// This flag makes the ESSL and GLSL outputs as short as possible: local variables, function
+// parameters, user-defined functions and global variables that aren't part of the shader interface
+// get short names, and comments, indentation and redundant parentheses are left out. The names
+// that were replaced can be queried by calling sh::GetMinifiedNameMap(). It has no effect on HLSL
+// output.
+const ShCompileOptions SH_MINIFY_OUTPUT = UINT64_C(1) << 33;
+
 // Defines alternate strategies for implementing array index clamping.
 enum ShArrayIndexClampingStrategy
 {
@@ -221,6 +239,36 @@ enum ShArrayIndexClampingStrategy
     SH_CLAMP_WITH_USER_DEFINED_INT_CLAMP_FUNCTION
 };
 
+// Wall time spent in one pass of the compiler.
+struct ShCompilePassStatistics
+{
+    // Analysis passes that share a traversal of the tree are reported together, with their names
+    // joined by '+'. "Parse" includes preprocessing and "Translate" is output generation.
+    std::string name;
+    double seconds;
+};
+
+// Statistics collected by a compilation with SH_COLLECT_COMPILE_STATISTICS.
+struct ShCompileStatistics
+{
+    // The passes in the order they ran. Passes that were disabled by compile options or that were
+    // skipped because of an error are not listed.
+    std::vector<ShCompilePassStatistics> passes;
+    // Wall time of the whole compilation, including the parts that are not timed as passes.
+    double totalSeconds;
+    // Number of nodes in the tree that is passed to output generation.
+    size_t astNodeCount;
+    // Approximate number of bytes taken up by that tree: its nodes, their child lists, constant
+    // values and the types that are not shared through the type cache.
+    size_t astBytes;
+    // Number of symbols declared at global scope in the shader.
+    size_t globalSymbolCount;
+    // Number of built-in symbols available to shaders of the compiler's type and spec.
+    size_t builtInSymbolCount;
+    // Number of bytes requested from the compiler's pool allocator.
+    size_t poolAllocatedBytes;
+};
+
 // The 64 bits hash function. The first parameter is the input string; the
 // second parameter is the string length.
 using ShHashFunction64 = khronos_uint64_t (*)(const char *, size_t);
@@ -363,6 +411,71 @@ struct ShBuiltInResources
     int MaxAtomicCounterBufferSize;
 };
 
+// Parameters shared by all the shaders translated by a call to sh::TranslateBatch().
+struct ShBatchOptions
+{
+    ShShaderSpec spec;
+    ShShaderOutput output;
+    ShBuiltInResources resources;
+    ShCompileOptions compileOptions;
+    // Number of threads to translate on. 0 uses one thread per hardware thread.
+    unsigned int threadCount;
+};
+
+// A shader to translate with sh::TranslateBatch().
+struct ShBatchShader
+{
+    // Identifies the shader in the results, for example the path of its source file.
+    std::string name;
+    // GL_VERTEX_SHADER, GL_FRAGMENT_SHADER or GL_COMPUTE_SHADER.
+    sh::GLenum type;
+    std::string source;
+};
+
+// The result of translating a shader with sh::TranslateBatch().
+struct ShBatchResult
+{
+    std::string name;
+    bool success;
+    std::string infoLog;
+    // Only set if the shader compiled and SH_OBJECT_CODE was given.
+    std::string objectCode;
+    // Wall time of the compilation.
+    double seconds;
+};
+
+// A variant of a shader, compiled with sh::CompileVariants().
+struct ShShaderVariant
+{
+    // Identifies the variant in the results.
+    std::string name;
+    // Macros to define, as names and values, in the order they are defined.
+    std::vector<std::pair<std::string, std::string>> defines;
+};
+
+// Variants of a shader that only differ in the macros they define before a shared body.
+struct ShShaderVariantSet
+{
+    // Comes before the defines of every variant, for example a #version directive.
+    std::string preamble;
+    std::string body;
+    std::vector<ShShaderVariant> variants;
+};
+
+// How much compilation sh::CompileVariants() saved.
+struct ShVariantStatistics
+{
+    size_t variantCount;
+    // Variants that were compiled. The others preprocessed to the same source as one of these and
+    // got a copy of its results.
+    size_t compiledVariantCount;
+    // Fraction of the variants that were not compiled.
+    double dedupRate;
+    // Whether the body was tokenized once for all the variants. It is tokenized again for each
+    // variant if tokenizing it reports an error, so that every variant reports the error.
+    bool bodyTokensReused;
+};
+
 //
 // ShHandle held by but opaque to the driver.  It is allocated,
 // managed, and de-allocated by the compiler. Its contents
@@ -441,6 +554,8 @@ void ShDestruct(ShHandle handle);
 //                 Can be queried by calling sh::GetObjectCode().
 // SH_VARIABLES: Extracts attributes, uniforms, and varyings.
 //               Can be queried by calling ShGetVariableInfo().
+// SH_COLLECT_COMPILE_STATISTICS: Times the compiler passes and measures the shader.
+//                                Can be queried by calling sh::GetCompileStatistics().
 //
 bool ShCompile(const ShHandle handle,
                const char *const shaderStrings[],
@@ -473,6 +588,18 @@ const std::string &ShGetObjectCode(const ShHandle handle);
 // handle: Specifies the compiler
 const std::map<std::string, std::string> *ShGetNameHashingMap(const ShHandle handle);
 
+// Returns an (original_name, minified_name) map containing the user defined names that
+// SH_MINIFY_OUTPUT replaced in the object code of the last compilation.
+// Parameters:
+// handle: Specifies the compiler
+const std::map<std::string, std::string> *ShGetMinifiedNameMap(const ShHandle handle);
+
+// Returns the statistics of the last compilation.
+// Returns NULL on failure, or if the last compilation didn't use SH_COLLECT_COMPILE_STATISTICS.
+// Parameters:
+// handle: Specifies the compiler
+const ShCompileStatistics *ShGetCompileStatistics(const ShHandle handle);
+
 // Shader variable inspection.
 // Returns a pointer to a list of variables of the designated type.
 // (See ShaderVars.h for type definitions, included above)
@@ -486,6 +613,13 @@ const std::vector<sh::OutputVariable> *ShGetOutputVariables(const ShHandle handl
 const std::vector<sh::InterfaceBlock> *ShGetInterfaceBlocks(const ShHandle handle);
 sh::WorkGroupSize ShGetComputeShaderLocalGroupSize(const ShHandle handle);
 
+// Moves the reflection of the last compilation into |reflectionOut|. The lists above are built
+// from it, so they are empty afterwards until the next compilation.
+// Parameters:
+// handle: Specifies the compiler
+// reflectionOut: receives the reflection, replacing its contents
+void ShTakeReflection(const ShHandle handle, sh::ShaderReflection *reflectionOut);
+
 // Returns true if the passed in variables pack in maxVectors following
 // the packing rules from the GLSL 1.017 spec, Appendix A, section 7.
 // Returns false otherwise. Also look at the SH_ENFORCE_PACKING_RESTRICTIONS
@@ -512,6 +646,39 @@ bool ShGetInterfaceBlockRegister(const ShHandle handle,
 // have been extracted from structs.
 const std::map<std::string, unsigned int> *ShGetUniformRegisterMap(const ShHandle handle);
 
+// Translates a batch of shaders, spread over several threads. Every thread constructs one compiler
+// per shader type and reuses it for all the shaders of that type it translates, so a batch is
+// much faster than compiling the shaders one by one with fresh compilers.
+// The results are written in the same order as the shaders.
+// Returns true if all the shaders compiled, false otherwise.
+// Parameters:
+// options: Specifies the spec, output, resources, compile options and number of threads.
+// shaders: Specifies the shaders to translate.
+// results: Receives one result per shader.
+bool ShTranslateBatch(const ShBatchOptions &options,
+                      const std::vector<ShBatchShader> &shaders,
+                      std::vector<ShBatchResult> *results);
+
+// Compiles variants of a shader that only differ in the macros they define. The preamble, the
+// defines of a variant and the body are compiled as three strings, so locations in the body are
+// reported in string 2. The body is tokenized once for all the variants, and a variant that
+// preprocesses to the same source as an earlier one gets a copy of its results instead of being
+// compiled again. SH_SOURCE_PATH is ignored.
+// The results are written in the same order as the variants. Afterwards, the other queries on the
+// handle return the results of the last variant that was compiled.
+// Returns true if all the variants compiled, false otherwise.
+// Parameters:
+// handle: Specifies the handle of the compiler to be used.
+// variantSet: Specifies the preamble, body and variants to compile.
+// compileOptions: A mask of compile options, as for ShCompile().
+// results: Receives one result per variant.
+// statistics: Receives how many variants were compiled. Can be null.
+bool ShCompileVariants(const ShHandle handle,
+                       const ShShaderVariantSet &variantSet,
+                       ShCompileOptions compileOptions,
+                       std::vector<ShBatchResult> *results,
+                       ShVariantStatistics *statistics);
+
 // Temporary duplicate of the scoped APIs, to be removed when we roll ANGLE and fix Chromium.
 // TODO(jmadill): Consolidate with these APIs once we roll ANGLE.
 
@@ -583,6 +750,8 @@ void Destruct(ShHandle handle);
 //                 Can be queried by calling sh::GetObjectCode().
 // SH_VARIABLES: Extracts attributes, uniforms, and varyings.
 //               Can be queried by calling ShGetVariableInfo().
+// SH_COLLECT_COMPILE_STATISTICS: Times the compiler passes and measures the shader.
+//                                Can be queried by calling sh::GetCompileStatistics().
 //
 bool Compile(const ShHandle handle,
              const char *const shaderStrings[],
@@ -614,6 +783,18 @@ const std::string &GetObjectCode(const ShHandle handle);
 // handle: Specifies the compiler
 const std::map<std::string, std::string> *GetNameHashingMap(const ShHandle handle);
 
+// Returns an (original_name, minified_name) map containing the user defined names that
+// SH_MINIFY_OUTPUT replaced in the object code of the last compilation.
+// Parameters:
+// handle: Specifies the compiler
+const std::map<std::string, std::string> *GetMinifiedNameMap(const ShHandle handle);
+
+// Returns the statistics of the last compilation.
+// Returns NULL on failure, or if the last compilation didn't use SH_COLLECT_COMPILE_STATISTICS.
+// Parameters:
+// handle: Specifies the compiler
+const ShCompileStatistics *GetCompileStatistics(const ShHandle handle);
+
 // Shader variable inspection.
 // Returns a pointer to a list of variables of the designated type.
 // (See ShaderVars.h for type definitions, included above)
@@ -627,6 +808,13 @@ const std::vector<sh::OutputVariable> *GetOutputVariables(const ShHandle handle)
 const std::vector<sh::InterfaceBlock> *GetInterfaceBlocks(const ShHandle handle);
 sh::WorkGroupSize GetComputeShaderLocalGroupSize(const ShHandle handle);
 
+// Moves the reflection of the last compilation into |reflectionOut|. The lists above are built
+// from it, so they are empty afterwards until the next compilation.
+// Parameters:
+// handle: Specifies the compiler
+// reflectionOut: receives the reflection, replacing its contents
+void TakeReflection(const ShHandle handle, sh::ShaderReflection *reflectionOut);
+
 // Returns true if the passed in variables pack in maxVectors followingthe packing rules from the
 // GLSL 1.017 spec, Appendix A, section 7.
 // Returns false otherwise. Also look at the SH_ENFORCE_PACKING_RESTRICTIONS
@@ -652,6 +840,39 @@ bool GetInterfaceBlockRegister(const ShHandle handle,
 // Note that the map contains also registers of samplers that have been extracted from structs.
 const std::map<std::string, unsigned int> *GetUniformRegisterMap(const ShHandle handle);
 
+// Translates a batch of shaders, spread over several threads. Every thread constructs one compiler
+// per shader type and reuses it for all the shaders of that type it translates, so a batch is
+// much faster than compiling the shaders one by one with fresh compilers.
+// The results are written in the same order as the shaders.
+// Returns true if all the shaders compiled, false otherwise.
+// Parameters:
+// options: Specifies the spec, output, resources, compile options and number of threads.
+// shaders: Specifies the shaders to translate.
+// results: Receives one result per shader.
+bool TranslateBatch(const ShBatchOptions &options,
+                    const std::vector<ShBatchShader> &shaders,
+                    std::vector<ShBatchResult> *results);
+
+// Compiles variants of a shader that only differ in the macros they define. The preamble, the
+// defines of a variant and the body are compiled as three strings, so locations in the body are
+// reported in string 2. The body is tokenized once for all the variants, and a variant that
+// preprocesses to the same source as an earlier one gets a copy of its results instead of being
+// compiled again. SH_SOURCE_PATH is ignored.
+// The results are written in the same order as the variants. Afterwards, the other queries on the
+// handle return the results of the last variant that was compiled.
+// Returns true if all the variants compiled, false otherwise.
+// Parameters:
+// handle: Specifies the handle of the compiler to be used.
+// variantSet: Specifies the preamble, body and variants to compile.
+// compileOptions: A mask of compile options, as for sh::Compile().
+// results: Receives one result per variant.
+// statistics: Receives how many variants were compiled. Can be null.
+bool CompileVariants(const ShHandle handle,
+                     const ShShaderVariantSet &variantSet,
+                     ShCompileOptions compileOptions,
+                     std::vector<ShBatchResult> *results,
+                     ShVariantStatistics *statistics);
+
 }  // namespace sh
 
 #endif // GLSLANG_SHADERLANG_H_
@@ -45,6 +45,8 @@ enum BlockLayoutType
 // Note: we must override the copy constructor and assignment operator so we can
 // work around excessive GCC binary bloating:
 // See https://code.google.com/p/angleproject/issues/detail?id=697
+// The move constructors and assignment operators are noexcept so that vectors of variables move
+// their elements instead of copying their names and fields when they grow.
 struct ShaderVariable
 {
     ShaderVariable();
@@ -52,6 +54,8 @@ struct ShaderVariable
     ~ShaderVariable();
     ShaderVariable(const ShaderVariable &other);
     ShaderVariable &operator=(const ShaderVariable &other);
+    ShaderVariable(ShaderVariable &&other) noexcept;
+    ShaderVariable &operator=(ShaderVariable &&other) noexcept;
 
     bool isArray() const { return arraySize > 0; }
     unsigned int elementCount() const { return std::max(1u, arraySize); }
@@ -100,6 +104,8 @@ struct Uniform : public ShaderVariable
     ~Uniform();
     Uniform(const Uniform &other);
     Uniform &operator=(const Uniform &other);
+    Uniform(Uniform &&other) noexcept;
+    Uniform &operator=(Uniform &&other) noexcept;
     bool operator==(const Uniform &other) const;
     bool operator!=(const Uniform &other) const
     {
@@ -121,6 +127,8 @@ struct InterfaceVariable : public ShaderVariable
     ~InterfaceVariable();
     InterfaceVariable(const InterfaceVariable &other);
     InterfaceVariable &operator=(const InterfaceVariable &other);
+    InterfaceVariable(InterfaceVariable &&other) noexcept;
+    InterfaceVariable &operator=(InterfaceVariable &&other) noexcept;
     bool operator==(const InterfaceVariable &other) const;
     bool operator!=(const InterfaceVariable &other) const { return !operator==(other); }
 
@@ -133,6 +141,8 @@ struct Attribute : public InterfaceVariable
     ~Attribute();
     Attribute(const Attribute &other);
     Attribute &operator=(const Attribute &other);
+    Attribute(Attribute &&other) noexcept;
+    Attribute &operator=(Attribute &&other) noexcept;
     bool operator==(const Attribute &other) const;
     bool operator!=(const Attribute &other) const { return !operator==(other); }
 };
@@ -143,6 +153,8 @@ struct OutputVariable : public InterfaceVariable
     ~OutputVariable();
     OutputVariable(const OutputVariable &other);
     OutputVariable &operator=(const OutputVariable &other);
+    OutputVariable(OutputVariable &&other) noexcept;
+    OutputVariable &operator=(OutputVariable &&other) noexcept;
     bool operator==(const OutputVariable &other) const;
     bool operator!=(const OutputVariable &other) const { return !operator==(other); }
 };
@@ -153,6 +165,8 @@ struct InterfaceBlockField : public ShaderVariable
     ~InterfaceBlockField();
     InterfaceBlockField(const InterfaceBlockField &other);
     InterfaceBlockField &operator=(const InterfaceBlockField &other);
+    InterfaceBlockField(InterfaceBlockField &&other) noexcept;
+    InterfaceBlockField &operator=(InterfaceBlockField &&other) noexcept;
     bool operator==(const InterfaceBlockField &other) const;
     bool operator!=(const InterfaceBlockField &other) const
     {
@@ -175,6 +189,8 @@ struct Varying : public ShaderVariable
     ~Varying();
     Varying(const Varying &otherg);
     Varying &operator=(const Varying &other);
+    Varying(Varying &&other) noexcept;
+    Varying &operator=(Varying &&other) noexcept;
     bool operator==(const Varying &other) const;
     bool operator!=(const Varying &other) const
     {
@@ -201,6 +217,8 @@ struct InterfaceBlock
     ~InterfaceBlock();
     InterfaceBlock(const InterfaceBlock &other);
     InterfaceBlock &operator=(const InterfaceBlock &other);
+    InterfaceBlock(InterfaceBlock &&other) noexcept;
+    InterfaceBlock &operator=(InterfaceBlock &&other) noexcept;
 
     // Fields from blocks with non-empty instance names are prefixed with the block name.
     std::string fieldPrefix() const;
@@ -218,6 +236,116 @@ struct InterfaceBlock
     std::vector<InterfaceBlockField> fields;
 };
 
+// The variables of a compilation in a compact form. Every variable, struct field and interface
+// block field is a fixed-size record, names are ranges of one string pool, and the fields of a
+// struct or interface block are a range of consecutive records in |fields|. Building, moving or
+// reading it doesn't allocate for each variable like the lists of ShaderVariable do, which are
+// built from it on request.
+struct ShaderReflection
+{
+    struct StringRange
+    {
+        StringRange() : offset(0), length(0) {}
+
+        unsigned int offset;
+        unsigned int length;
+    };
+
+    struct FieldRange
+    {
+        FieldRange() : first(0), count(0) {}
+
+        unsigned int first;
+        unsigned int count;
+    };
+
+    struct Variable
+    {
+        Variable();
+
+        bool isArray() const { return arraySize > 0; }
+        unsigned int elementCount() const { return std::max(1u, arraySize); }
+        bool isStruct() const { return fieldRange.count > 0; }
+
+        GLenum type;
+        GLenum precision;
+        StringRange name;
+        StringRange mappedName;
+        StringRange structName;
+        unsigned int arraySize;
+        bool staticUse;
+        FieldRange fieldRange;
+
+        // Only meaningful for attributes and output variables.
+        int location;
+        // Only meaningful for varyings.
+        InterpolationType interpolation;
+        bool isInvariant;
+        // Only meaningful for the fields of interface blocks.
+        bool isRowMajorLayout;
+    };
+
+    struct Block
+    {
+        Block();
+
+        StringRange name;
+        StringRange mappedName;
+        StringRange instanceName;
+        unsigned int arraySize;
+        BlockLayoutType layout;
+        bool isRowMajorLayout;
+        bool staticUse;
+        FieldRange fieldRange;
+    };
+
+    ShaderReflection();
+    ~ShaderReflection();
+    ShaderReflection(const ShaderReflection &other);
+    ShaderReflection &operator=(const ShaderReflection &other);
+    ShaderReflection(ShaderReflection &&other) noexcept;
+    ShaderReflection &operator=(ShaderReflection &&other) noexcept;
+
+    void clear();
+
+    // Appends to the string pool.
+    StringRange addString(const char *str, size_t length);
+    StringRange addString(const std::string &str);
+    // Appends |count| default records to |fields|.
+    FieldRange addFields(size_t count);
+
+    std::string getString(StringRange range) const;
+    bool stringEquals(StringRange range, const char *str, size_t length) const;
+    bool stringEquals(StringRange range, const char *str) const;
+    bool stringEquals(StringRange range, const std::string &str) const;
+    static bool StringsEqual(const ShaderReflection &a,
+                             StringRange rangeA,
+                             const ShaderReflection &b,
+                             StringRange rangeB);
+
+    bool isBuiltIn(const Variable &variable) const;
+    const Variable &getField(FieldRange range, size_t index) const;
+    Variable &getField(FieldRange range, size_t index);
+
+    // Build the lists of ShaderVariable that the records describe, replacing the contents of the
+    // output.
+    void getAttributes(std::vector<Attribute> *attributesOut) const;
+    void getOutputVariables(std::vector<OutputVariable> *outputVariablesOut) const;
+    void getUniforms(std::vector<Uniform> *uniformsOut) const;
+    void getVaryings(std::vector<Varying> *varyingsOut) const;
+    void getInterfaceBlocks(std::vector<InterfaceBlock> *interfaceBlocksOut) const;
+    // Builds the Varying that one record of |varyings| describes.
+    void getVarying(const Variable &record, Varying *varyingOut) const;
+
+    std::string strings;
+    std::vector<Variable> attributes;
+    std::vector<Variable> outputVariables;
+    std::vector<Variable> uniforms;
+    std::vector<Variable> varyings;
+    std::vector<Block> interfaceBlocks;
+    std::vector<Variable> fields;
+};
+
 struct WorkGroupSize
 {
     void fill(int fillValue);
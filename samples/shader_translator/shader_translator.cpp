@@ -11,6 +11,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
 #include <sstream>
 #include <vector>
 #include "angle_gl.h"
@@ -32,6 +35,46 @@ static bool CompileFile(char *fileName, ShHandle compiler, ShCompileOptions comp
 static void LogMsg(const char *msg, const char *name, const int num, const char *logName);
 static void PrintVariable(const std::string &prefix, size_t index, const sh::ShaderVariable &var);
 static void PrintActiveVariables(ShHandle compiler);
+static void PrintCompileStatistics(const ShCompileStatistics &statistics);
+
+// Compile statistics summed over all the shaders given on the command line, used to find the
+// shaders and passes that dominate the compile time of a corpus.
+struct AggregateStatistics
+{
+    struct Shader
+    {
+        std::string fileName;
+        double seconds;
+        size_t astNodeCount;
+        size_t poolAllocatedBytes;
+    };
+
+    std::vector<Shader> shaders;
+    std::map<std::string, double> passSeconds;
+};
+static void AddToAggregateStatistics(const char *fileName,
+                                     const ShCompileStatistics &statistics,
+                                     AggregateStatistics *aggregate);
+static void PrintAggregateStatistics(const AggregateStatistics &aggregate);
+
+// In batch mode the files are collected while parsing the command line, and then translated
+// together on several threads by sh::TranslateBatch().
+struct BatchSettings
+{
+    BatchSettings() : enabled(false), threadCount(0) {}
+
+    bool enabled;
+    int threadCount;
+    std::string outputDirectory;
+    std::string reportFile;
+    std::vector<std::string> files;
+};
+static bool ReadManifest(const char *fileName, std::vector<std::string> *files);
+static TFailCode RunBatch(const BatchSettings &batch,
+                          ShShaderSpec spec,
+                          ShShaderOutput output,
+                          const ShBuiltInResources &resources,
+                          ShCompileOptions compileOptions);
 
 // If NUM_SOURCE_STRINGS is set to a value > 1, the input file data is
 // broken into that many chunks. This will affect file/line numbering in
@@ -76,6 +119,10 @@ int main(int argc, char *argv[])
     ShHandle computeCompiler  = 0;
     ShShaderSpec spec = SH_GLES2_SPEC;
     ShShaderOutput output = SH_ESSL_OUTPUT;
+    bool printStatistics = false;
+    bool aggregateStatistics = false;
+    AggregateStatistics aggregate;
+    BatchSettings batch;
 
     sh::Initialize();
 
@@ -94,6 +141,56 @@ int main(int argc, char *argv[])
               case 'o': compileOptions |= SH_OBJECT_CODE; break;
               case 'u': compileOptions |= SH_VARIABLES; break;
               case 'p': resources.WEBGL_debug_shader_precision = 1; break;
+              case 't':
+                compileOptions |= SH_COLLECT_COMPILE_STATISTICS;
+                if (argv[0][2] == '\0')
+                {
+                    printStatistics = true;
+                }
+                else if (argv[0][2] == '=' && argv[0][3] == 'a')
+                {
+                    aggregateStatistics = true;
+                }
+                else
+                {
+                    failCode = EFailUsage;
+                }
+                break;
+              case 'm':
+                if (argv[0][2] == '=' && ReadManifest(&argv[0][3], &batch.files))
+                {
+                    batch.enabled = true;
+                }
+                else
+                {
+                    failCode = EFailUsage;
+                }
+                break;
+              case 'j':
+                if (argv[0][2] == '=' && ParseIntValue(&argv[0][3], 0, &batch.threadCount) &&
+                    batch.threadCount >= 0)
+                {
+                    batch.enabled = true;
+                }
+                else
+                {
+                    failCode = EFailUsage;
+                }
+                break;
+              case 'd':
+              case 'r':
+                if (argv[0][2] == '=' && argv[0][3] != '\0')
+                {
+                    std::string &path =
+                        argv[0][1] == 'd' ? batch.outputDirectory : batch.reportFile;
+                    path          = &argv[0][3];
+                    batch.enabled = true;
+                }
+                else
+                {
+                    failCode = EFailUsage;
+                }
+                break;
               case 's':
                 if (argv[0][2] == '=')
                 {
@@ -217,6 +314,10 @@ int main(int argc, char *argv[])
               default: failCode = EFailUsage;
             }
         }
+        else if (batch.enabled)
+        {
+            batch.files.push_back(argv[0]);
+        }
         else
         {
             if (spec != SH_GLES2_SPEC && spec != SH_WEBGL_SPEC)
@@ -278,6 +379,18 @@ int main(int argc, char *argv[])
                     LogMsg("END", "COMPILER", numCompiles, "VARIABLES");
                     printf("\n\n");
                 }
+                const ShCompileStatistics *statistics = sh::GetCompileStatistics(compiler);
+                if (statistics && printStatistics)
+                {
+                    LogMsg("BEGIN", "COMPILER", numCompiles, "STATISTICS");
+                    PrintCompileStatistics(*statistics);
+                    LogMsg("END", "COMPILER", numCompiles, "STATISTICS");
+                    printf("\n\n");
+                }
+                if (statistics && aggregateStatistics)
+                {
+                    AddToAggregateStatistics(argv[0], *statistics, &aggregate);
+                }
                 if (!compiled)
                   failCode = EFailCompile;
                 ++numCompiles;
@@ -289,10 +402,19 @@ int main(int argc, char *argv[])
         }
     }
 
-    if ((vertexCompiler == 0) && (fragmentCompiler == 0) && (computeCompiler == 0))
+    if (batch.enabled)
+    {
+        if (failCode == ESuccess)
+            failCode = RunBatch(batch, spec, output, resources, compileOptions);
+    }
+    else if ((vertexCompiler == 0) && (fragmentCompiler == 0) && (computeCompiler == 0))
+    {
         failCode = EFailUsage;
+    }
     if (failCode == EFailUsage)
         usage();
+    else if (aggregateStatistics)
+        PrintAggregateStatistics(aggregate);
 
     if (vertexCompiler)
         sh::Destruct(vertexCompiler);
@@ -313,12 +435,19 @@ void usage()
 {
     // clang-format off
     printf(
-        "Usage: translate [-i -o -u -l -p -b=e -b=g -b=h9 -x=i -x=d] file1 file2 ...\n"
+        "Usage: translate [-i -o -u -l -p -t -b=e -b=g -b=h9 -x=i -x=d] file1 file2 ...\n"
         "Where: filename : filename ending in .frag or .vert\n"
         "       -i       : print intermediate tree\n"
         "       -o       : print translated code\n"
         "       -u       : print active attribs, uniforms, varyings and program outputs\n"
         "       -p       : use precision emulation\n"
+        "       -t       : print compile time of each pass and size statistics\n"
+        "       -t=a     : print compile statistics summed over all the files\n"
+        "       -m=FILE  : batch mode, also translate the files listed in FILE, one per line\n"
+        "       -j=NUM   : batch mode, translate on NUM threads (default one per core)\n"
+        "       -d=DIR   : batch mode, write the translated code of each file to DIR, with the\n"
+        "                  path separators in its name replaced by '_'\n"
+        "       -r=FILE  : batch mode, write the JSON summary to FILE instead of stdout\n"
         "       -s=e2    : use GLES2 spec (this is by default)\n"
         "       -s=e3    : use GLES3 spec (in development)\n"
         "       -s=e31   : use GLES31 spec (in development)\n"
@@ -492,6 +621,251 @@ static void PrintActiveVariables(ShHandle compiler)
     }
 }
 
+static void PrintCompileStatistics(const ShCompileStatistics &statistics)
+{
+    for (const ShCompilePassStatistics &pass : statistics.passes)
+    {
+        printf("%-48s %10.3f ms\n", pass.name.c_str(), pass.seconds * 1000.0);
+    }
+    printf("%-48s %10.3f ms\n", "Total", statistics.totalSeconds * 1000.0);
+    printf("AST nodes: %u\n", static_cast<unsigned int>(statistics.astNodeCount));
+    printf("global symbols: %u\n", static_cast<unsigned int>(statistics.globalSymbolCount));
+    printf("built-in symbols: %u\n", static_cast<unsigned int>(statistics.builtInSymbolCount));
+    printf("pool allocated bytes: %u\n",
+           static_cast<unsigned int>(statistics.poolAllocatedBytes));
+}
+
+static void AddToAggregateStatistics(const char *fileName,
+                                     const ShCompileStatistics &statistics,
+                                     AggregateStatistics *aggregate)
+{
+    aggregate->shaders.push_back({fileName, statistics.totalSeconds, statistics.astNodeCount,
+                                  statistics.poolAllocatedBytes});
+    for (const ShCompilePassStatistics &pass : statistics.passes)
+    {
+        aggregate->passSeconds[pass.name] += pass.seconds;
+    }
+}
+
+static void PrintAggregateStatistics(const AggregateStatistics &aggregate)
+{
+    if (aggregate.shaders.empty())
+        return;
+
+    double totalSeconds = 0.0;
+    for (const AggregateStatistics::Shader &shader : aggregate.shaders)
+    {
+        totalSeconds += shader.seconds;
+    }
+
+    printf("#### BEGIN AGGREGATE STATISTICS ####\n");
+    printf("shaders: %u\n", static_cast<unsigned int>(aggregate.shaders.size()));
+    printf("total: %.3f ms, mean: %.3f ms\n\n", totalSeconds * 1000.0,
+           totalSeconds * 1000.0 / aggregate.shaders.size());
+
+    // Passes by the share of the corpus compile time they account for.
+    std::vector<std::pair<double, std::string>> passes;
+    for (const auto &pass : aggregate.passSeconds)
+    {
+        passes.push_back(std::make_pair(pass.second, pass.first));
+    }
+    std::sort(passes.rbegin(), passes.rend());
+    for (const auto &pass : passes)
+    {
+        printf("%-48s %10.3f ms %5.1f%%\n", pass.second.c_str(), pass.first * 1000.0,
+               totalSeconds > 0.0 ? pass.first * 100.0 / totalSeconds : 0.0);
+    }
+    printf("\n");
+
+    // The slowest shaders are the ones worth looking at in a content pipeline.
+    const size_t kSlowestShaderCount = 10;
+    std::vector<AggregateStatistics::Shader> shaders = aggregate.shaders;
+    std::sort(shaders.begin(), shaders.end(),
+              [](const AggregateStatistics::Shader &a, const AggregateStatistics::Shader &b) {
+                  return a.seconds > b.seconds;
+              });
+    shaders.resize(std::min(shaders.size(), kSlowestShaderCount));
+    printf("slowest shaders:\n");
+    for (const AggregateStatistics::Shader &shader : shaders)
+    {
+        printf("%10.3f ms %8u nodes %10u bytes  %s\n", shader.seconds * 1000.0,
+               static_cast<unsigned int>(shader.astNodeCount),
+               static_cast<unsigned int>(shader.poolAllocatedBytes), shader.fileName.c_str());
+    }
+    printf("#### END AGGREGATE STATISTICS ####\n");
+}
+
+static bool ReadManifest(const char *fileName, std::vector<std::string> *files)
+{
+    FILE *in = fopen(fileName, "rb");
+    if (!in)
+    {
+        printf("Error: unable to open manifest: %s\n", fileName);
+        return false;
+    }
+
+    // One file per line. Empty lines and lines starting with '#' are skipped.
+    char line[4096];
+    while (fgets(line, sizeof(line), in))
+    {
+        std::string file(line);
+        while (!file.empty() && (file.back() == '\n' || file.back() == '\r'))
+            file.pop_back();
+        if (!file.empty() && file[0] != '#')
+            files->push_back(file);
+    }
+
+    fclose(in);
+    return true;
+}
+
+static bool ReadFile(const char *fileName, std::string *contents)
+{
+    FILE *in = fopen(fileName, "rb");
+    if (!in)
+    {
+        printf("Error: unable to open input file: %s\n", fileName);
+        return false;
+    }
+
+    char buffer[4096];
+    size_t nread;
+    while ((nread = fread(buffer, 1, sizeof(buffer), in)) > 0)
+        contents->append(buffer, nread);
+
+    fclose(in);
+    return true;
+}
+
+static bool WriteFile(const std::string &fileName, const std::string &contents)
+{
+    FILE *out = fopen(fileName.c_str(), "wb");
+    if (!out)
+    {
+        printf("Error: unable to open output file: %s\n", fileName.c_str());
+        return false;
+    }
+
+    bool success = fwrite(contents.data(), 1, contents.size(), out) == contents.size();
+    fclose(out);
+    return success;
+}
+
+static std::string JSONString(const std::string &value)
+{
+    std::string result = "\"";
+    for (char c : value)
+    {
+        switch (c)
+        {
+          case '"': result += "\\\""; break;
+          case '\\': result += "\\\\"; break;
+          case '\n': result += "\\n"; break;
+          case '\r': result += "\\r"; break;
+          case '\t': result += "\\t"; break;
+          default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                result += escaped;
+            }
+            else
+            {
+                result += c;
+            }
+            break;
+        }
+    }
+    return result + "\"";
+}
+
+static TFailCode RunBatch(const BatchSettings &batch,
+                          ShShaderSpec spec,
+                          ShShaderOutput output,
+                          const ShBuiltInResources &resources,
+                          ShCompileOptions compileOptions)
+{
+    if (batch.files.empty())
+        return EFailUsage;
+
+    ShBatchOptions options;
+    options.spec      = spec;
+    options.output    = output;
+    options.resources = resources;
+    if (spec != SH_GLES2_SPEC && spec != SH_WEBGL_SPEC)
+    {
+        options.resources.MaxDrawBuffers = 8;
+    }
+    options.compileOptions = compileOptions;
+    if (!batch.outputDirectory.empty())
+    {
+        options.compileOptions |= SH_OBJECT_CODE;
+    }
+    options.threadCount = static_cast<unsigned int>(batch.threadCount);
+
+    std::vector<ShBatchShader> shaders(batch.files.size());
+    for (size_t i = 0; i < batch.files.size(); ++i)
+    {
+        shaders[i].name = batch.files[i];
+        shaders[i].type = FindShaderType(batch.files[i].c_str());
+        if (!ReadFile(batch.files[i].c_str(), &shaders[i].source))
+            return EFailCompile;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ShBatchResult> results;
+    bool allCompiled = sh::TranslateBatch(options, shaders, &results);
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t failedCount = 0;
+    std::string report = "{\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const ShBatchResult &result = results[i];
+        char timing[64];
+        snprintf(timing, sizeof(timing), "%.6f", result.seconds);
+
+        report += "    {\"name\": " + JSONString(result.name) +
+                  ", \"success\": " + (result.success ? "true" : "false") +
+                  ", \"seconds\": " + timing;
+        if (!result.success)
+        {
+            report += ", \"infoLog\": " + JSONString(result.infoLog);
+            ++failedCount;
+        }
+        report += (i + 1 < results.size()) ? "},\n" : "}\n";
+
+        if (result.success && !batch.outputDirectory.empty())
+        {
+            std::string fileName = result.name;
+            std::replace(fileName.begin(), fileName.end(), '/', '_');
+            std::replace(fileName.begin(), fileName.end(), '\\', '_');
+            if (!WriteFile(batch.outputDirectory + "/" + fileName, result.objectCode))
+                allCompiled = false;
+        }
+    }
+
+    char summary[256];
+    snprintf(summary, sizeof(summary),
+             "  ],\n  \"shaders\": %u,\n  \"failed\": %u,\n  \"seconds\": %.6f\n}\n",
+             static_cast<unsigned int>(results.size()), static_cast<unsigned int>(failedCount),
+             seconds);
+    report += summary;
+
+    if (batch.reportFile.empty())
+    {
+        fputs(report.c_str(), stdout);
+    }
+    else if (!WriteFile(batch.reportFile, report))
+    {
+        return EFailCompile;
+    }
+
+    return allCompiled ? ESuccess : EFailCompile;
+}
+
 static bool ReadShaderSource(const char *fileName, ShaderSource &source)
 {
     FILE *in = fopen(fileName, "rb");
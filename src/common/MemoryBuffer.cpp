@@ -77,4 +77,166 @@ uint8_t *MemoryBuffer::data()
     return mData;
 }
 
+// ScratchBufferLease implementation.
+ScratchBufferLease::ScratchBufferLease() : mPool(nullptr), mBuffer(nullptr), mSize(0)
+{
 }
+
+ScratchBufferLease::ScratchBufferLease(ScratchBufferPool *pool, MemoryBuffer *buffer, size_t size)
+    : mPool(pool), mBuffer(buffer), mSize(size)
+{
+}
+
+ScratchBufferLease::ScratchBufferLease(ScratchBufferLease &&other)
+    : mPool(other.mPool), mBuffer(other.mBuffer), mSize(other.mSize)
+{
+    other.mPool   = nullptr;
+    other.mBuffer = nullptr;
+    other.mSize   = 0;
+}
+
+ScratchBufferLease::~ScratchBufferLease()
+{
+    release();
+}
+
+ScratchBufferLease &ScratchBufferLease::operator=(ScratchBufferLease &&other)
+{
+    std::swap(mPool, other.mPool);
+    std::swap(mBuffer, other.mBuffer);
+    std::swap(mSize, other.mSize);
+    return *this;
+}
+
+void ScratchBufferLease::release()
+{
+    if (mBuffer)
+    {
+        ASSERT(mPool);
+        mPool->recycle(mBuffer);
+        mBuffer = nullptr;
+        mPool   = nullptr;
+        mSize   = 0;
+    }
+}
+
+// ScratchBufferPool implementation.
+ScratchBufferPool::Counters::Counters()
+    : leases(0),
+      allocations(0),
+      trimmedBuffers(0),
+      pooledBytes(0),
+      leasedBytes(0),
+      peakLeasedBytes(0)
+{
+}
+
+ScratchBufferPool::ScratchBufferPool() : mLeasesSinceTrim(0), mIntervalPeakLeasedBytes(0)
+{
+}
+
+ScratchBufferPool::~ScratchBufferPool()
+{
+    // All leases must be returned before the pool goes away.
+    ASSERT(mCounters.leasedBytes == 0);
+}
+
+// static
+size_t ScratchBufferPool::GetBinIndex(size_t size)
+{
+    size_t binIndex = 0;
+    while (GetBinSize(binIndex) < size && binIndex + 1 < kBinCount)
+    {
+        binIndex++;
+    }
+    return binIndex;
+}
+
+// static
+size_t ScratchBufferPool::GetBinSize(size_t binIndex)
+{
+    return static_cast<size_t>(1) << (binIndex + kMinBinSizeLog2);
+}
+
+bool ScratchBufferPool::lease(size_t size, ScratchBufferLease *leaseOut)
+{
+    ASSERT(leaseOut);
+    leaseOut->release();
+
+    if (++mLeasesSinceTrim >= kTrimInterval)
+    {
+        trim();
+    }
+
+    size_t binIndex = GetBinIndex(size);
+    std::vector<std::unique_ptr<MemoryBuffer>> &bin = mFreeBins[binIndex];
+
+    MemoryBuffer *buffer = nullptr;
+    if (!bin.empty() && bin.back()->size() >= size)
+    {
+        buffer = bin.back().release();
+        bin.pop_back();
+    }
+    else
+    {
+        // Requests past the last size class are allocated at their exact size.
+        size_t allocationSize = std::max(GetBinSize(binIndex), size);
+        std::unique_ptr<MemoryBuffer> newBuffer(new MemoryBuffer());
+        if (!newBuffer->resize(allocationSize))
+        {
+            return false;
+        }
+        mCounters.allocations++;
+        mCounters.pooledBytes += allocationSize;
+        buffer = newBuffer.release();
+    }
+
+    mCounters.leases++;
+    mCounters.leasedBytes += buffer->size();
+    mCounters.peakLeasedBytes = std::max(mCounters.peakLeasedBytes, mCounters.leasedBytes);
+    mIntervalPeakLeasedBytes  = std::max(mIntervalPeakLeasedBytes, mCounters.leasedBytes);
+
+    *leaseOut = ScratchBufferLease(this, buffer, size);
+    return true;
+}
+
+void ScratchBufferPool::recycle(MemoryBuffer *buffer)
+{
+    ASSERT(mCounters.leasedBytes >= buffer->size());
+    mCounters.leasedBytes -= buffer->size();
+    mFreeBins[GetBinIndex(buffer->size())].emplace_back(buffer);
+}
+
+void ScratchBufferPool::trim()
+{
+    // Release the largest free buffers first until the pool is no bigger than what was needed
+    // at once during the last interval.
+    for (size_t binIndex = kBinCount; binIndex > 0 && mCounters.pooledBytes > mIntervalPeakLeasedBytes;
+         --binIndex)
+    {
+        std::vector<std::unique_ptr<MemoryBuffer>> &bin = mFreeBins[binIndex - 1];
+        while (!bin.empty() && mCounters.pooledBytes > mIntervalPeakLeasedBytes)
+        {
+            mCounters.pooledBytes -= bin.back()->size();
+            mCounters.trimmedBuffers++;
+            bin.pop_back();
+        }
+    }
+
+    mLeasesSinceTrim         = 0;
+    mIntervalPeakLeasedBytes = mCounters.leasedBytes;
+}
+
+void ScratchBufferPool::clear()
+{
+    for (std::vector<std::unique_ptr<MemoryBuffer>> &bin : mFreeBins)
+    {
+        for (const std::unique_ptr<MemoryBuffer> &buffer : bin)
+        {
+            mCounters.pooledBytes -= buffer->size();
+        }
+        bin.clear();
+    }
+}
+
+}  // namespace rx
@@ -9,8 +9,11 @@
 
 #include "common/angleutils.h"
 
+#include <array>
 #include <cstddef>
+#include <memory>
 #include <stdint.h>
+#include <vector>
 
 namespace rx
 {
@@ -33,6 +36,84 @@ class MemoryBuffer : angle::NonCopyable
     uint8_t *mData;
 };
 
+class ScratchBufferPool;
+
+// A MemoryBuffer borrowed from a ScratchBufferPool. The buffer goes back to the pool when the
+// lease is released or destroyed. The buffer may be larger than the requested size.
+class ScratchBufferLease : angle::NonCopyable
+{
+  public:
+    ScratchBufferLease();
+    ScratchBufferLease(ScratchBufferLease &&other);
+    ~ScratchBufferLease();
+
+    ScratchBufferLease &operator=(ScratchBufferLease &&other);
+
+    void release();
+
+    bool valid() const { return mBuffer != nullptr; }
+    size_t size() const { return mSize; }
+    uint8_t *data() { return mBuffer->data(); }
+    MemoryBuffer *get() { return mBuffer; }
+
+  private:
+    friend class ScratchBufferPool;
+    ScratchBufferLease(ScratchBufferPool *pool, MemoryBuffer *buffer, size_t size);
+
+    ScratchBufferPool *mPool;
+    MemoryBuffer *mBuffer;
+    size_t mSize;
+};
+
+// Hands out temporary MemoryBuffers for conversions and staging. Free buffers are kept in
+// power-of-two size classes so that repeated requests of similar sizes don't go back to malloc.
+// Every kTrimInterval leases, free buffers beyond the peak amount of memory leased at once during
+// that interval are returned to the system.
+class ScratchBufferPool : angle::NonCopyable
+{
+  public:
+    struct Counters
+    {
+        Counters();
+
+        size_t leases;
+        size_t allocations;
+        size_t trimmedBuffers;
+        size_t pooledBytes;
+        size_t leasedBytes;
+        size_t peakLeasedBytes;
+    };
+
+    static constexpr size_t kTrimInterval = 1000;
+
+    ScratchBufferPool();
+    ~ScratchBufferPool();
+
+    // Returns false if the memory could not be allocated.
+    bool lease(size_t size, ScratchBufferLease *leaseOut);
+
+    // Frees the free buffers above the high-water mark of the last interval.
+    void trim();
+    // Frees all free buffers.
+    void clear();
+
+    const Counters &getCounters() const { return mCounters; }
+
+  private:
+    friend class ScratchBufferLease;
+    void recycle(MemoryBuffer *buffer);
+
+    static constexpr size_t kMinBinSizeLog2 = 8;
+    static constexpr size_t kBinCount       = 24;
+    static size_t GetBinIndex(size_t size);
+    static size_t GetBinSize(size_t binIndex);
+
+    std::array<std::vector<std::unique_ptr<MemoryBuffer>>, kBinCount> mFreeBins;
+    size_t mLeasesSinceTrim;
+    size_t mIntervalPeakLeasedBytes;
+    Counters mCounters;
+};
+
 }
 
 #endif // COMMON_MEMORYBUFFER_H_
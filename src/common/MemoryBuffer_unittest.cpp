@@ -0,0 +1,105 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Unit tests for ANGLE's MemoryBuffer and ScratchBufferPool classes.
+//
+
+#include "gtest/gtest.h"
+
+#include "common/MemoryBuffer.h"
+
+using namespace rx;
+
+namespace
+{
+
+// Tests that a released buffer is handed out again for a request in the same size class.
+TEST(ScratchBufferPoolTest, ReuseSameSizeClass)
+{
+    ScratchBufferPool pool;
+
+    uint8_t *firstData = nullptr;
+    {
+        ScratchBufferLease lease;
+        ASSERT_TRUE(pool.lease(1000, &lease));
+        ASSERT_TRUE(lease.valid());
+        EXPECT_EQ(1000u, lease.size());
+        EXPECT_GE(lease.get()->size(), 1000u);
+        firstData = lease.data();
+    }
+
+    ScratchBufferLease lease;
+    ASSERT_TRUE(pool.lease(900, &lease));
+    EXPECT_EQ(firstData, lease.data());
+
+    const ScratchBufferPool::Counters &counters = pool.getCounters();
+    EXPECT_EQ(2u, counters.leases);
+    EXPECT_EQ(1u, counters.allocations);
+}
+
+// Tests that concurrent leases get distinct buffers and are accounted for.
+TEST(ScratchBufferPoolTest, ConcurrentLeases)
+{
+    ScratchBufferPool pool;
+
+    ScratchBufferLease first;
+    ScratchBufferLease second;
+    ASSERT_TRUE(pool.lease(4096, &first));
+    ASSERT_TRUE(pool.lease(4096, &second));
+    EXPECT_NE(first.data(), second.data());
+    EXPECT_EQ(8192u, pool.getCounters().leasedBytes);
+
+    first.release();
+    EXPECT_FALSE(first.valid());
+    EXPECT_EQ(4096u, pool.getCounters().leasedBytes);
+    EXPECT_EQ(8192u, pool.getCounters().peakLeasedBytes);
+}
+
+// Tests that leases can be moved without returning the buffer twice.
+TEST(ScratchBufferPoolTest, MoveLease)
+{
+    ScratchBufferPool pool;
+
+    ScratchBufferLease lease;
+    ASSERT_TRUE(pool.lease(300, &lease));
+    uint8_t *data = lease.data();
+
+    ScratchBufferLease moved(std::move(lease));
+    EXPECT_FALSE(lease.valid());
+    EXPECT_EQ(data, moved.data());
+
+    moved.release();
+    EXPECT_EQ(0u, pool.getCounters().leasedBytes);
+}
+
+// Tests that trimming frees buffers above the high-water mark of the last interval.
+TEST(ScratchBufferPoolTest, TrimToHighWaterMark)
+{
+    ScratchBufferPool pool;
+
+    {
+        ScratchBufferLease big;
+        ScratchBufferLease small;
+        ASSERT_TRUE(pool.lease(1 << 20, &big));
+        ASSERT_TRUE(pool.lease(1 << 10, &small));
+    }
+
+    // The next interval only ever needs the small buffer.
+    pool.trim();
+    {
+        ScratchBufferLease small;
+        ASSERT_TRUE(pool.lease(1 << 10, &small));
+    }
+    pool.trim();
+
+    const ScratchBufferPool::Counters &counters = pool.getCounters();
+    EXPECT_EQ(1u, counters.trimmedBuffers);
+    EXPECT_EQ(static_cast<size_t>(1 << 10), counters.pooledBytes);
+
+    pool.clear();
+    EXPECT_EQ(0u, pool.getCounters().pooledBytes);
+}
+
+}  // anonymous namespace
@@ -0,0 +1,227 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RegisterAllocator:
+//   Tracks which components of a range of four-component registers are in use, for packing
+//   uniforms and varyings as in the GLSL ES 1.00 spec, Appendix A, section 7.
+//
+
+#include "common/RegisterAllocator.h"
+
+#include <algorithm>
+#include <bitset>
+
+#include "common/BitSetIterator.h"
+#include "common/debug.h"
+
+namespace angle
+{
+
+namespace
+{
+
+// Returns a word with the bits [begin, end) set. end may be the number of bits in the word.
+template <typename Word>
+Word GetBitRangeMask(unsigned int begin, unsigned int end)
+{
+    const unsigned int bitsPerWord = sizeof(Word) * 8u;
+    ASSERT(begin < end && end <= bitsPerWord);
+    Word mask = ~static_cast<Word>(0) << begin;
+    if (end < bitsPerWord)
+    {
+        mask &= (static_cast<Word>(1) << end) - 1u;
+    }
+    return mask;
+}
+
+}  // anonymous namespace
+
+template <typename Visitor>
+void RegisterAllocator::visitFreeRuns(unsigned int column,
+                                      unsigned int columnCount,
+                                      Visitor visitor) const
+{
+    unsigned int runStart = findNextRow(column, columnCount, 0u, true);
+    while (runStart < mRowCount)
+    {
+        unsigned int runEnd = findNextRow(column, columnCount, runStart, false);
+        if (visitor(runStart, runEnd) || runEnd == mRowCount)
+        {
+            return;
+        }
+        runStart = findNextRow(column, columnCount, runEnd, true);
+    }
+}
+
+RegisterAllocator::RegisterAllocator(unsigned int rowCount) : mRowCount(rowCount)
+{
+    const unsigned int wordCount = (rowCount + kBitsPerWord - 1u) / kBitsPerWord;
+    for (std::vector<Word> &freeRows : mFreeRows)
+    {
+        freeRows.assign(wordCount, ~static_cast<Word>(0));
+        if (rowCount % kBitsPerWord != 0u)
+        {
+            freeRows.back() = GetBitRangeMask<Word>(0u, rowCount % kBitsPerWord);
+        }
+    }
+}
+
+bool RegisterAllocator::isFree(unsigned int row,
+                               unsigned int column,
+                               unsigned int rowCount,
+                               unsigned int columnCount) const
+{
+    ASSERT(row + rowCount <= mRowCount && column + columnCount <= kColumnCount);
+    return rowCount == 0u || findNextRow(column, columnCount, row, false) >= row + rowCount;
+}
+
+void RegisterAllocator::allocate(unsigned int row,
+                                 unsigned int column,
+                                 unsigned int rowCount,
+                                 unsigned int columnCount)
+{
+    ASSERT(isFree(row, column, rowCount, columnCount));
+
+    const unsigned int end = row + rowCount;
+    while (row < end)
+    {
+        const unsigned int wordIndex = row / kBitsPerWord;
+        const unsigned int wordEnd   = end - wordIndex * kBitsPerWord;
+        const Word mask              = GetBitRangeMask<Word>(
+            row % kBitsPerWord, wordEnd < kBitsPerWord ? wordEnd : kBitsPerWord);
+        for (unsigned int columnIndex = column; columnIndex < column + columnCount; ++columnIndex)
+        {
+            mFreeRows[columnIndex][wordIndex] &= ~mask;
+        }
+        row = (wordIndex + 1u) * kBitsPerWord;
+    }
+}
+
+bool RegisterAllocator::findFirstFreeRows(unsigned int column,
+                                          unsigned int columnCount,
+                                          unsigned int rowCount,
+                                          unsigned int *rowOut) const
+{
+    bool found = false;
+    visitFreeRuns(column, columnCount, [&](unsigned int runStart, unsigned int runEnd) {
+        if (runEnd - runStart >= rowCount)
+        {
+            *rowOut = runStart;
+            found   = true;
+        }
+        return found;
+    });
+    return found;
+}
+
+bool RegisterAllocator::findLastFreeRows(unsigned int column,
+                                         unsigned int columnCount,
+                                         unsigned int rowCount,
+                                         unsigned int *rowOut) const
+{
+    bool found = false;
+    visitFreeRuns(column, columnCount, [&](unsigned int runStart, unsigned int runEnd) {
+        if (runEnd - runStart >= rowCount)
+        {
+            *rowOut = runEnd - rowCount;
+            found   = true;
+        }
+        return false;
+    });
+    return found;
+}
+
+bool RegisterAllocator::findSmallestFreeRun(unsigned int column,
+                                            unsigned int rowCount,
+                                            unsigned int *rowOut,
+                                            unsigned int *runSizeOut) const
+{
+    bool found = false;
+    visitFreeRuns(column, 1u, [&](unsigned int runStart, unsigned int runEnd) {
+        unsigned int runSize = runEnd - runStart;
+        if (runSize >= rowCount && (!found || runSize < *runSizeOut))
+        {
+            *rowOut     = runStart;
+            *runSizeOut = runSize;
+            found       = true;
+        }
+        // A run can't fit any tighter than this.
+        return found && runSize == rowCount;
+    });
+    return found;
+}
+
+unsigned int RegisterAllocator::getLongestFreeRun(unsigned int column) const
+{
+    unsigned int longestRun = 0u;
+    visitFreeRuns(column, 1u, [&](unsigned int runStart, unsigned int runEnd) {
+        longestRun = std::max(longestRun, runEnd - runStart);
+        return false;
+    });
+    return longestRun;
+}
+
+unsigned int RegisterAllocator::getFreeRowCount(unsigned int column) const
+{
+    size_t count = 0u;
+    for (Word word : mFreeRows[column])
+    {
+        count += std::bitset<kBitsPerWord>(word).count();
+    }
+    return static_cast<unsigned int>(count);
+}
+
+unsigned int RegisterAllocator::getUsedRowCount() const
+{
+    size_t freeCount = 0u;
+    for (unsigned int wordIndex = 0u; wordIndex < mFreeRows[0].size(); ++wordIndex)
+    {
+        freeCount += std::bitset<kBitsPerWord>(getFreeWord(0u, kColumnCount, wordIndex)).count();
+    }
+    return mRowCount - static_cast<unsigned int>(freeCount);
+}
+
+RegisterAllocator::Word RegisterAllocator::getFreeWord(unsigned int column,
+                                                       unsigned int columnCount,
+                                                       unsigned int wordIndex) const
+{
+    ASSERT(columnCount > 0u && column + columnCount <= kColumnCount);
+    Word word = mFreeRows[column][wordIndex];
+    for (unsigned int columnIndex = column + 1u; columnIndex < column + columnCount; ++columnIndex)
+    {
+        word &= mFreeRows[columnIndex][wordIndex];
+    }
+    return word;
+}
+
+unsigned int RegisterAllocator::findNextRow(unsigned int column,
+                                            unsigned int columnCount,
+                                            unsigned int startRow,
+                                            bool free) const
+{
+    const unsigned int wordCount = static_cast<unsigned int>(mFreeRows[column].size());
+    for (unsigned int wordIndex = startRow / kBitsPerWord; wordIndex < wordCount; ++wordIndex)
+    {
+        Word word = getFreeWord(column, columnCount, wordIndex);
+        if (!free)
+        {
+            word = ~word;
+        }
+        if (wordIndex == startRow / kBitsPerWord)
+        {
+            word &= GetBitRangeMask<Word>(startRow % kBitsPerWord, kBitsPerWord);
+        }
+        if (word != 0u)
+        {
+            // The bits past the last row are set when looking for a row that isn't free.
+            unsigned int row =
+                wordIndex * kBitsPerWord + static_cast<unsigned int>(ScanForward(word));
+            return std::min(row, mRowCount);
+        }
+    }
+    return mRowCount;
+}
+
+}  // namespace angle
@@ -0,0 +1,93 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RegisterAllocator:
+//   Tracks which components of a range of four-component registers are in use, for packing
+//   uniforms and varyings as in the GLSL ES 1.00 spec, Appendix A, section 7.
+//
+
+#ifndef COMMON_REGISTERALLOCATOR_H_
+#define COMMON_REGISTERALLOCATOR_H_
+
+#include <array>
+#include <vector>
+
+#include "common/angleutils.h"
+
+namespace angle
+{
+
+// Every column keeps a bitmask of its free rows, so runs of free rows are found with a bit scan
+// per word instead of a test per register.
+class RegisterAllocator final : angle::NonCopyable
+{
+  public:
+    static const unsigned int kColumnCount = 4u;
+
+    explicit RegisterAllocator(unsigned int rowCount);
+
+    unsigned int getRowCount() const { return mRowCount; }
+
+    // Returns whether the rows [row, row + rowCount) are free in the columns
+    // [column, column + columnCount).
+    bool isFree(unsigned int row,
+                unsigned int column,
+                unsigned int rowCount,
+                unsigned int columnCount) const;
+    void allocate(unsigned int row,
+                  unsigned int column,
+                  unsigned int rowCount,
+                  unsigned int columnCount);
+
+    // Find the lowest or the highest row from which rowCount rows are free in the columns
+    // [column, column + columnCount). Return false if there is no such row.
+    bool findFirstFreeRows(unsigned int column,
+                           unsigned int columnCount,
+                           unsigned int rowCount,
+                           unsigned int *rowOut) const;
+    bool findLastFreeRows(unsigned int column,
+                          unsigned int columnCount,
+                          unsigned int rowCount,
+                          unsigned int *rowOut) const;
+
+    // Finds the smallest run of free rows of the column that holds rowCount rows. Of runs with the
+    // same size, the lowest one is returned.
+    bool findSmallestFreeRun(unsigned int column,
+                             unsigned int rowCount,
+                             unsigned int *rowOut,
+                             unsigned int *runSizeOut) const;
+
+    unsigned int getLongestFreeRun(unsigned int column) const;
+    unsigned int getFreeRowCount(unsigned int column) const;
+
+    // Returns how many rows have at least one column in use.
+    unsigned int getUsedRowCount() const;
+
+  private:
+    using Word = unsigned long;
+    static const unsigned int kBitsPerWord = sizeof(Word) * 8u;
+
+    // The rows that are free in all the columns [column, column + columnCount).
+    Word getFreeWord(unsigned int column, unsigned int columnCount, unsigned int wordIndex) const;
+
+    // Returns the first row from startRow on that is free, or isn't free, in all the columns, or
+    // the row count if there is none.
+    unsigned int findNextRow(unsigned int column,
+                             unsigned int columnCount,
+                             unsigned int startRow,
+                             bool free) const;
+
+    // Calls visitor(runStart, runEnd) for every run of rows that are free in all the columns, from
+    // the lowest to the highest one. Stops when the visitor returns true.
+    template <typename Visitor>
+    void visitFreeRuns(unsigned int column, unsigned int columnCount, Visitor visitor) const;
+
+    unsigned int mRowCount;
+    std::array<std::vector<Word>, kColumnCount> mFreeRows;
+};
+
+}  // namespace angle
+
+#endif  // COMMON_REGISTERALLOCATOR_H_
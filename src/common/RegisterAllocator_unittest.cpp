@@ -0,0 +1,106 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RegisterAllocator_unittest:
+//   Tests for the register allocator that the uniform and varying packers share.
+//
+
+#include <gtest/gtest.h>
+
+#include "common/RegisterAllocator.h"
+
+using namespace angle;
+
+namespace
+{
+
+// Test that allocated registers aren't free, and that the registers around them still are.
+TEST(RegisterAllocatorTest, Allocate)
+{
+    RegisterAllocator registers(8);
+    EXPECT_EQ(8u, registers.getRowCount());
+    EXPECT_TRUE(registers.isFree(0, 0, 8, 4));
+    EXPECT_EQ(0u, registers.getUsedRowCount());
+
+    registers.allocate(2, 1, 3, 2);
+    EXPECT_FALSE(registers.isFree(0, 0, 8, 4));
+    EXPECT_FALSE(registers.isFree(4, 2, 1, 1));
+    EXPECT_TRUE(registers.isFree(0, 0, 8, 1));
+    EXPECT_TRUE(registers.isFree(0, 1, 2, 3));
+    EXPECT_TRUE(registers.isFree(5, 0, 3, 4));
+    EXPECT_EQ(3u, registers.getUsedRowCount());
+    EXPECT_EQ(8u, registers.getFreeRowCount(0));
+    EXPECT_EQ(5u, registers.getFreeRowCount(1));
+}
+
+// Test finding the lowest and the highest rows that fit a block of registers.
+TEST(RegisterAllocatorTest, FindFreeRows)
+{
+    RegisterAllocator registers(10);
+    registers.allocate(0, 0, 2, 4);
+    registers.allocate(4, 0, 1, 1);
+    registers.allocate(8, 3, 1, 1);
+
+    unsigned int row = 0;
+    ASSERT_TRUE(registers.findFirstFreeRows(0, 2, 2, &row));
+    EXPECT_EQ(2u, row);
+    ASSERT_TRUE(registers.findFirstFreeRows(0, 2, 3, &row));
+    EXPECT_EQ(5u, row);
+    ASSERT_TRUE(registers.findFirstFreeRows(1, 2, 8, &row));
+    EXPECT_EQ(2u, row);
+    EXPECT_FALSE(registers.findFirstFreeRows(1, 3, 8, &row));
+    EXPECT_FALSE(registers.findFirstFreeRows(0, 1, 6, &row));
+
+    ASSERT_TRUE(registers.findLastFreeRows(2, 2, 2, &row));
+    EXPECT_EQ(6u, row);
+    ASSERT_TRUE(registers.findLastFreeRows(0, 1, 2, &row));
+    EXPECT_EQ(8u, row);
+}
+
+// Test that the smallest run of free rows that fits is found, and the lowest one of equal runs.
+TEST(RegisterAllocatorTest, FindSmallestFreeRun)
+{
+    RegisterAllocator registers(12);
+    registers.allocate(3, 0, 1, 1);
+    registers.allocate(6, 0, 1, 1);
+    registers.allocate(9, 0, 1, 1);
+
+    unsigned int row     = 0;
+    unsigned int runSize = 0;
+    ASSERT_TRUE(registers.findSmallestFreeRun(0, 2, &row, &runSize));
+    EXPECT_EQ(2u, runSize);
+    EXPECT_EQ(4u, row);
+    ASSERT_TRUE(registers.findSmallestFreeRun(0, 3, &row, &runSize));
+    EXPECT_EQ(3u, runSize);
+    EXPECT_EQ(0u, row);
+    EXPECT_FALSE(registers.findSmallestFreeRun(0, 4, &row, &runSize));
+    EXPECT_EQ(3u, registers.getLongestFreeRun(0));
+    EXPECT_EQ(12u, registers.getLongestFreeRun(1));
+}
+
+// Test register counts that span several words of the bitmasks.
+TEST(RegisterAllocatorTest, ManyRows)
+{
+    const unsigned int kRowCount = 300;
+    RegisterAllocator registers(kRowCount);
+
+    // A block across a word boundary.
+    registers.allocate(60, 0, 10, 4);
+    unsigned int row = 0;
+    ASSERT_TRUE(registers.findFirstFreeRows(0, 4, 61, &row));
+    EXPECT_EQ(70u, row);
+    ASSERT_TRUE(registers.findLastFreeRows(0, 4, 1, &row));
+    EXPECT_EQ(kRowCount - 1, row);
+    EXPECT_EQ(kRowCount - 70, registers.getLongestFreeRun(2));
+
+    registers.allocate(70, 0, kRowCount - 70, 1);
+    EXPECT_EQ(60u, registers.getLongestFreeRun(0));
+    EXPECT_EQ(60u, registers.getFreeRowCount(0));
+    EXPECT_EQ(kRowCount - 60, registers.getUsedRowCount());
+    EXPECT_FALSE(registers.findFirstFreeRows(0, 1, 61, &row));
+    EXPECT_TRUE(registers.isFree(70, 1, kRowCount - 70, 3));
+}
+
+}  // anonymous namespace
@@ -626,6 +626,18 @@ int VariableSortOrder(GLenum type)
 }
 
 std::string ParseUniformName(const std::string &name, size_t *outSubscript)
+{
+    size_t nameLength = 0;
+    size_t subscript  = ParseArrayIndex(name, &nameLength);
+    if (outSubscript)
+    {
+        *outSubscript = subscript;
+    }
+
+    return name.substr(0, nameLength);
+}
+
+size_t ParseArrayIndex(const std::string &name, size_t *nameLengthOut)
 {
     // Strip any trailing array operator and retrieve the subscript
     size_t open = name.find_last_of('[');
@@ -633,27 +645,15 @@ std::string ParseUniformName(const std::string &name, size_t *outSubscript)
     bool hasIndex = (open != std::string::npos) && (close == name.length() - 1);
     if (!hasIndex)
     {
-        if (outSubscript)
-        {
-            *outSubscript = GL_INVALID_INDEX;
-        }
-        return name;
+        *nameLengthOut = name.length();
+        return GL_INVALID_INDEX;
     }
 
-    if (outSubscript)
-    {
-        int index = atoi(name.substr(open + 1).c_str());
-        if (index >= 0)
-        {
-            *outSubscript = index;
-        }
-        else
-        {
-            *outSubscript = GL_INVALID_INDEX;
-        }
-    }
+    *nameLengthOut = open;
 
-    return name.substr(0, open);
+    // atoi stops at the closing bracket.
+    int index = atoi(name.c_str() + open + 1);
+    return (index >= 0 ? static_cast<size_t>(index) : GL_INVALID_INDEX);
 }
 
 template <>
@@ -50,6 +50,10 @@ GLenum LayerIndexToCubeMapTextureTarget(size_t index);
 // set to GL_INVALID_INDEX if the provided name is not an array or the array index is invalid.
 std::string ParseUniformName(const std::string &name, size_t *outSubscript);
 
+// Like ParseUniformName, but returns the array index and sets nameLengthOut to the length of the
+// base name instead of copying it.
+size_t ParseArrayIndex(const std::string &name, size_t *nameLengthOut);
+
 // Find the range of index values in the provided indices pointer.  Primitive restart indices are
 // only counted in the range if primitive restart is disabled.
 IndexRange ComputeIndexRange(GLenum indexType,
@@ -52,4 +52,17 @@ TEST(ParseUniformName, TrailingWhitespace)
     EXPECT_EQ(GL_INVALID_INDEX, index);
 }
 
+TEST(ParseArrayIndex, NameLength)
+{
+    size_t nameLength = 0;
+    EXPECT_EQ(12u, gl::ParseArrayIndex("s[1].foo[12]", &nameLength));
+    EXPECT_EQ(8u, nameLength);
+
+    EXPECT_EQ(GL_INVALID_INDEX, gl::ParseArrayIndex("foo[-1]", &nameLength));
+    EXPECT_EQ(3u, nameLength);
+
+    EXPECT_EQ(GL_INVALID_INDEX, gl::ParseArrayIndex("s[1].foo", &nameLength));
+    EXPECT_EQ(8u, nameLength);
+}
+
 }
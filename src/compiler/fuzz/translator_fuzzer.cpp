@@ -5,9 +5,23 @@
 //
 
 // translator_fuzzer.cpp: A libfuzzer fuzzer for the shader translator.
+//
+// Besides looking for crashes, the fuzzer can guard the performance of the translator. Pass any
+// of these flags after the libFuzzer ones (libFuzzer ignores flags that start with "--"):
+//   --time_budget_ms=N  report an input that takes longer than N milliseconds to translate.
+//   --pool_budget_mb=N  report an input that allocates more than N megabytes from the pool.
+//   --perf_log=FILE     append a line for every input to FILE: the translation time in seconds,
+//                       the pool memory and source size in bytes, and the type, spec and output.
+// An input that goes over a budget is reported as a crash, so libFuzzer saves it, and running the
+// fuzzer on the saved input with -minimize_crash=1 shrinks it while it stays over the budget. The
+// report ends with the input written as an entry of the slow shader corpus in
+// src/tests/perf_tests/SlowShaderCorpus.cpp, which the TranslatorPerf perf tests translate.
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unordered_map>
 #include <iostream>
 
@@ -44,6 +58,166 @@ struct hash<TranslatorCacheKey>
 
 static std::unordered_map<TranslatorCacheKey, TCompiler *> translators;
 
+struct OutputInfo
+{
+    uint32_t output;
+    const char *name;
+};
+
+static const OutputInfo kValidOutputs[] = {
+    {SH_ESSL_OUTPUT, "SH_ESSL_OUTPUT"},
+    {SH_GLSL_COMPATIBILITY_OUTPUT, "SH_GLSL_COMPATIBILITY_OUTPUT"},
+    {SH_GLSL_130_OUTPUT, "SH_GLSL_130_OUTPUT"},
+    {SH_GLSL_140_OUTPUT, "SH_GLSL_140_OUTPUT"},
+    {SH_GLSL_150_CORE_OUTPUT, "SH_GLSL_150_CORE_OUTPUT"},
+    {SH_GLSL_330_CORE_OUTPUT, "SH_GLSL_330_CORE_OUTPUT"},
+    {SH_GLSL_400_CORE_OUTPUT, "SH_GLSL_400_CORE_OUTPUT"},
+    {SH_GLSL_410_CORE_OUTPUT, "SH_GLSL_410_CORE_OUTPUT"},
+    {SH_GLSL_420_CORE_OUTPUT, "SH_GLSL_420_CORE_OUTPUT"},
+    {SH_GLSL_430_CORE_OUTPUT, "SH_GLSL_430_CORE_OUTPUT"},
+    {SH_GLSL_440_CORE_OUTPUT, "SH_GLSL_440_CORE_OUTPUT"},
+    {SH_GLSL_450_CORE_OUTPUT, "SH_GLSL_450_CORE_OUTPUT"},
+    {SH_HLSL_3_0_OUTPUT, "SH_HLSL_3_0_OUTPUT"},
+    {SH_HLSL_4_1_OUTPUT, "SH_HLSL_4_1_OUTPUT"},
+    {SH_HLSL_4_0_FL9_3_OUTPUT, "SH_HLSL_4_0_FL9_3_OUTPUT"},
+};
+
+// Performance guard settings, parsed from the command line. A budget of zero is not checked.
+static double timeBudgetSeconds = 0.0;
+static size_t poolBudgetBytes   = 0;
+static FILE *perfLog            = nullptr;
+
+static bool IsPerfGuardEnabled()
+{
+    return timeBudgetSeconds > 0.0 || poolBudgetBytes > 0 || perfLog != nullptr;
+}
+
+static const char *GetFlagValue(const char *arg, const char *flag)
+{
+    size_t flagLength = strlen(flag);
+    if (strncmp(arg, flag, flagLength) != 0 || arg[flagLength] != '=')
+    {
+        return nullptr;
+    }
+    return arg + flagLength + 1;
+}
+
+static const char *GetSpecName(uint32_t spec)
+{
+    switch (spec)
+    {
+        case SH_GLES2_SPEC:
+            return "SH_GLES2_SPEC";
+        case SH_WEBGL_SPEC:
+            return "SH_WEBGL_SPEC";
+        case SH_GLES3_SPEC:
+            return "SH_GLES3_SPEC";
+        case SH_WEBGL2_SPEC:
+            return "SH_WEBGL2_SPEC";
+        default:
+            return "?";
+    }
+}
+
+static const char *GetOutputName(uint32_t output)
+{
+    for (const OutputInfo &info : kValidOutputs)
+    {
+        if (info.output == output)
+        {
+            return info.name;
+        }
+    }
+    return "?";
+}
+
+// Writes the source as C string literals, one per line of the shader.
+static void PrintSourceLiterals(const char *source)
+{
+    fprintf(stderr, "        \"");
+    for (const char *c = source; *c != 0; ++c)
+    {
+        unsigned char ch = static_cast<unsigned char>(*c);
+        if (ch == '\n')
+        {
+            fprintf(stderr, "\\n\"");
+            if (c[1] != 0)
+            {
+                fprintf(stderr, "\n        \"");
+                continue;
+            }
+            fprintf(stderr, "\n");
+            return;
+        }
+        if (ch == '"' || ch == '\\')
+        {
+            fprintf(stderr, "\\%c", ch);
+        }
+        else if (ch < 0x20 || ch >= 0x7f)
+        {
+            // Octal escapes have at most three digits, so they can't run into the next character.
+            fprintf(stderr, "\\%03o", ch);
+        }
+        else
+        {
+            fputc(ch, stderr);
+        }
+    }
+    fprintf(stderr, "\"\n");
+}
+
+static void ReportSlowInput(const TranslatorCacheKey &key,
+                            uint64_t options,
+                            const char *source,
+                            const ShCompileStatistics &statistics)
+{
+    fprintf(stderr, "==translator_fuzzer== Input is over the performance budget.\n");
+    fprintf(stderr, "  Translation time: %.2f ms (budget %.2f ms)\n",
+            statistics.totalSeconds * 1000.0, timeBudgetSeconds * 1000.0);
+    fprintf(stderr, "  Pool memory: %zu bytes (budget %zu bytes)\n",
+            statistics.poolAllocatedBytes, poolBudgetBytes);
+    fprintf(stderr, "  AST nodes: %zu\n", statistics.astNodeCount);
+    for (const ShCompilePassStatistics &pass : statistics.passes)
+    {
+        fprintf(stderr, "  Pass %s: %.2f ms\n", pass.name.c_str(), pass.seconds * 1000.0);
+    }
+
+    fprintf(stderr, "Slow shader corpus entry:\n");
+    fprintf(stderr, "    {\"name\", %s, %s, %s, 0x%llxull,\n",
+            key.type == GL_FRAGMENT_SHADER ? "GL_FRAGMENT_SHADER" : "GL_VERTEX_SHADER",
+            GetSpecName(key.spec), GetOutputName(key.output),
+            static_cast<unsigned long long>(options));
+    PrintSourceLiterals(source);
+    fprintf(stderr, "    },\n");
+}
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv)
+{
+    for (int i = 1; i < *argc; ++i)
+    {
+        const char *arg   = (*argv)[i];
+        const char *value = nullptr;
+        if ((value = GetFlagValue(arg, "--time_budget_ms")) != nullptr)
+        {
+            timeBudgetSeconds = atof(value) / 1000.0;
+        }
+        else if ((value = GetFlagValue(arg, "--pool_budget_mb")) != nullptr)
+        {
+            poolBudgetBytes = static_cast<size_t>(atof(value) * 1024.0 * 1024.0);
+        }
+        else if ((value = GetFlagValue(arg, "--perf_log")) != nullptr)
+        {
+            perfLog = fopen(value, "a");
+            if (perfLog == nullptr)
+            {
+                fprintf(stderr, "translator_fuzzer: can't open %s\n", value);
+                exit(1);
+            }
+        }
+    }
+    return 0;
+}
+
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
 {
     // Reserve some size for future compile options
@@ -76,26 +250,10 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
         return 0;
     }
 
-    std::vector<uint32_t> validOutputs;
-    validOutputs.push_back(SH_ESSL_OUTPUT);
-    validOutputs.push_back(SH_GLSL_COMPATIBILITY_OUTPUT);
-    validOutputs.push_back(SH_GLSL_130_OUTPUT);
-    validOutputs.push_back(SH_GLSL_140_OUTPUT);
-    validOutputs.push_back(SH_GLSL_150_CORE_OUTPUT);
-    validOutputs.push_back(SH_GLSL_330_CORE_OUTPUT);
-    validOutputs.push_back(SH_GLSL_400_CORE_OUTPUT);
-    validOutputs.push_back(SH_GLSL_410_CORE_OUTPUT);
-    validOutputs.push_back(SH_GLSL_420_CORE_OUTPUT);
-    validOutputs.push_back(SH_GLSL_430_CORE_OUTPUT);
-    validOutputs.push_back(SH_GLSL_440_CORE_OUTPUT);
-    validOutputs.push_back(SH_GLSL_450_CORE_OUTPUT);
-    validOutputs.push_back(SH_HLSL_3_0_OUTPUT);
-    validOutputs.push_back(SH_HLSL_4_1_OUTPUT);
-    validOutputs.push_back(SH_HLSL_4_0_FL9_3_OUTPUT);
     bool found = false;
-    for (auto valid : validOutputs)
+    for (const OutputInfo &valid : kValidOutputs)
     {
-        found = found || (valid == output);
+        found = found || (valid.output == output);
     }
     if (!found)
     {
@@ -156,7 +314,32 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
     TCompiler *translator = translators[key];
 
     const char *shaderStrings[] = {reinterpret_cast<const char *>(data)};
-    translator->compile(shaderStrings, 1, options);
+    if (!IsPerfGuardEnabled())
+    {
+        translator->compile(shaderStrings, 1, options);
+        return 0;
+    }
+
+    translator->compile(shaderStrings, 1, options | SH_COLLECT_COMPILE_STATISTICS);
+    const ShCompileStatistics *statistics = translator->getCompileStatistics();
+    if (!statistics)
+    {
+        return 0;
+    }
+
+    if (perfLog)
+    {
+        fprintf(perfLog, "%.6f %zu %zu 0x%x %u 0x%x\n", statistics->totalSeconds,
+                statistics->poolAllocatedBytes, size, type, spec, output);
+        fflush(perfLog);
+    }
+
+    if ((timeBudgetSeconds > 0.0 && statistics->totalSeconds > timeBudgetSeconds) ||
+        (poolBudgetBytes > 0 && statistics->poolAllocatedBytes > poolBudgetBytes))
+    {
+        ReportSlowInput(key, options, shaderStrings[0], *statistics);
+        abort();
+    }
 
     return 0;
 }
@@ -15,6 +15,7 @@
 #include "compiler/preprocessor/DirectiveHandlerBase.h"
 #include "compiler/preprocessor/ExpressionParser.h"
 #include "compiler/preprocessor/MacroExpander.h"
+#include "compiler/preprocessor/StringTable.h"
 #include "compiler/preprocessor/Token.h"
 #include "compiler/preprocessor/Tokenizer.h"
 
@@ -57,31 +58,31 @@ DirectiveType getDirective(const pp::Token *token)
     if (token->type != pp::Token::IDENTIFIER)
         return DIRECTIVE_NONE;
 
-    if (token->text == kDirectiveDefine)
+    if (token->text() == kDirectiveDefine)
         return DIRECTIVE_DEFINE;
-    if (token->text == kDirectiveUndef)
+    if (token->text() == kDirectiveUndef)
         return DIRECTIVE_UNDEF;
-    if (token->text == kDirectiveIf)
+    if (token->text() == kDirectiveIf)
         return DIRECTIVE_IF;
-    if (token->text == kDirectiveIfdef)
+    if (token->text() == kDirectiveIfdef)
         return DIRECTIVE_IFDEF;
-    if (token->text == kDirectiveIfndef)
+    if (token->text() == kDirectiveIfndef)
         return DIRECTIVE_IFNDEF;
-    if (token->text == kDirectiveElse)
+    if (token->text() == kDirectiveElse)
         return DIRECTIVE_ELSE;
-    if (token->text == kDirectiveElif)
+    if (token->text() == kDirectiveElif)
         return DIRECTIVE_ELIF;
-    if (token->text == kDirectiveEndif)
+    if (token->text() == kDirectiveEndif)
         return DIRECTIVE_ENDIF;
-    if (token->text == kDirectiveError)
+    if (token->text() == kDirectiveError)
         return DIRECTIVE_ERROR;
-    if (token->text == kDirectivePragma)
+    if (token->text() == kDirectivePragma)
         return DIRECTIVE_PRAGMA;
-    if (token->text == kDirectiveExtension)
+    if (token->text() == kDirectiveExtension)
         return DIRECTIVE_EXTENSION;
-    if (token->text == kDirectiveVersion)
+    if (token->text() == kDirectiveVersion)
         return DIRECTIVE_VERSION;
-    if (token->text == kDirectiveLine)
+    if (token->text() == kDirectiveLine)
         return DIRECTIVE_LINE;
 
     return DIRECTIVE_NONE;
@@ -120,7 +121,7 @@ void skipUntilEOD(pp::Lexer *lexer, pp::Token *token)
 bool isMacroNameReserved(const std::string &name)
 {
     // Names prefixed with "GL_" and the name "defined" are reserved.
-    return name == "defined" || (name.substr(0, 3) == "GL_");
+    return name == "defined" || (name.compare(0, 3, "GL_") == 0);
 }
 
 bool hasDoubleUnderscores(const std::string &name)
@@ -128,9 +129,9 @@ bool hasDoubleUnderscores(const std::string &name)
     return (name.find("__") != std::string::npos);
 }
 
-bool isMacroPredefined(const std::string &name, const pp::MacroSet &macroSet)
+bool isMacroPredefined(const std::string *internedName, const pp::MacroSet &macroSet)
 {
-    pp::MacroSet::const_iterator iter = macroSet.find(name);
+    pp::MacroSet::const_iterator iter = macroSet.find(internedName);
     return iter != macroSet.end() ? iter->second.predefined : false;
 }
 
@@ -142,8 +143,11 @@ namespace pp
 class DefinedParser : public Lexer
 {
   public:
-    DefinedParser(Lexer *lexer, const MacroSet *macroSet, Diagnostics *diagnostics)
-        : mLexer(lexer), mMacroSet(macroSet), mDiagnostics(diagnostics)
+    DefinedParser(Lexer *lexer,
+                  const MacroSet *macroSet,
+                  StringTable *strings,
+                  Diagnostics *diagnostics)
+        : mLexer(lexer), mMacroSet(macroSet), mStrings(strings), mDiagnostics(diagnostics)
     {
     }
 
@@ -155,7 +159,7 @@ class DefinedParser : public Lexer
         mLexer->lex(token);
         if (token->type != Token::IDENTIFIER)
             return;
-        if (token->text != kDefined)
+        if (token->text() != kDefined)
             return;
 
         bool paren = false;
@@ -168,12 +172,12 @@ class DefinedParser : public Lexer
 
         if (token->type != Token::IDENTIFIER)
         {
-            mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text);
+            mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text());
             skipUntilEOD(mLexer, token);
             return;
         }
-        MacroSet::const_iterator iter = mMacroSet->find(token->text);
-        std::string expression        = iter != mMacroSet->end() ? "1" : "0";
+        MacroSet::const_iterator iter = mMacroSet->find(token->internedText());
+        const char *expression        = iter != mMacroSet->end() ? "1" : "0";
 
         if (paren)
         {
@@ -181,7 +185,7 @@ class DefinedParser : public Lexer
             if (token->type != ')')
             {
                 mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location,
-                                     token->text);
+                                     token->text());
                 skipUntilEOD(mLexer, token);
                 return;
             }
@@ -190,17 +194,19 @@ class DefinedParser : public Lexer
         // We have a valid defined operator.
         // Convert the current token into a CONST_INT token.
         token->type = Token::CONST_INT;
-        token->text = expression;
+        token->setText(mStrings->intern(expression));
     }
 
   private:
     Lexer *mLexer;
     const MacroSet *mMacroSet;
+    StringTable *mStrings;
     Diagnostics *mDiagnostics;
 };
 
 DirectiveParser::DirectiveParser(Tokenizer *tokenizer,
                                  MacroSet *macroSet,
+                                 StringTable *strings,
                                  Diagnostics *diagnostics,
                                  DirectiveHandler *directiveHandler,
                                  int maxMacroExpansionDepth)
@@ -208,6 +214,7 @@ DirectiveParser::DirectiveParser(Tokenizer *tokenizer,
       mSeenNonPreprocessorToken(false),
       mTokenizer(tokenizer),
       mMacroSet(macroSet),
+      mStrings(strings),
       mDiagnostics(diagnostics),
       mDirectiveHandler(directiveHandler),
       mShaderVersion(100),
@@ -272,7 +279,7 @@ void DirectiveParser::parseDirective(Token *token)
     {
         case DIRECTIVE_NONE:
             mDiagnostics->report(Diagnostics::PP_DIRECTIVE_INVALID_NAME, token->location,
-                                 token->text);
+                                 token->text());
             skipUntilEOD(mTokenizer, token);
             break;
         case DIRECTIVE_DEFINE:
@@ -322,7 +329,7 @@ void DirectiveParser::parseDirective(Token *token)
     skipUntilEOD(mTokenizer, token);
     if (token->type == Token::LAST)
     {
-        mDiagnostics->report(Diagnostics::PP_EOF_IN_DIRECTIVE, token->location, token->text);
+        mDiagnostics->report(Diagnostics::PP_EOF_IN_DIRECTIVE, token->location, token->text());
     }
 }
 
@@ -333,18 +340,18 @@ void DirectiveParser::parseDefine(Token *token)
     mTokenizer->lex(token);
     if (token->type != Token::IDENTIFIER)
     {
-        mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text);
+        mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text());
         return;
     }
-    if (isMacroPredefined(token->text, *mMacroSet))
+    if (isMacroPredefined(token->internedText(), *mMacroSet))
     {
         mDiagnostics->report(Diagnostics::PP_MACRO_PREDEFINED_REDEFINED, token->location,
-                             token->text);
+                             token->text());
         return;
     }
-    if (isMacroNameReserved(token->text))
+    if (isMacroNameReserved(token->text()))
     {
-        mDiagnostics->report(Diagnostics::PP_MACRO_NAME_RESERVED, token->location, token->text);
+        mDiagnostics->report(Diagnostics::PP_MACRO_NAME_RESERVED, token->location, token->text());
         return;
     }
     // Using double underscores is allowed, but may result in unintended
@@ -352,15 +359,16 @@ void DirectiveParser::parseDefine(Token *token)
     // specified in ESSL 3.10, but the intent judging from Khronos
     // discussions and dEQP tests was that double underscores should be
     // allowed in earlier ESSL versions too.
-    if (hasDoubleUnderscores(token->text))
+    if (hasDoubleUnderscores(token->text()))
     {
         mDiagnostics->report(Diagnostics::PP_WARNING_MACRO_NAME_RESERVED, token->location,
-                             token->text);
+                             token->text());
     }
 
+    const std::string *internedName = token->internedText();
     Macro macro;
     macro.type = Macro::kTypeObj;
-    macro.name = token->text;
+    macro.name = *internedName;
 
     mTokenizer->lex(token);
     if (token->type == '(' && !token->hasLeadingSpace())
@@ -373,22 +381,22 @@ void DirectiveParser::parseDefine(Token *token)
             if (token->type != Token::IDENTIFIER)
                 break;
 
-            if (std::find(macro.parameters.begin(), macro.parameters.end(), token->text) !=
+            if (std::find(macro.parameters.begin(), macro.parameters.end(), token->text()) !=
                 macro.parameters.end())
             {
                 mDiagnostics->report(Diagnostics::PP_MACRO_DUPLICATE_PARAMETER_NAMES,
-                                     token->location, token->text);
+                                     token->location, token->text());
                 return;
             }
 
-            macro.parameters.push_back(token->text);
+            macro.parameters.push_back(token->text());
 
             mTokenizer->lex(token);  // Get ','.
         } while (token->type == ',');
 
         if (token->type != ')')
         {
-            mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text);
+            mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text());
             return;
         }
         mTokenizer->lex(token);  // Get ')'.
@@ -409,15 +417,19 @@ void DirectiveParser::parseDefine(Token *token)
         // the replacement list for either form of macro.
         macro.replacements.front().setHasLeadingSpace(false);
     }
+    if (macro.type == Macro::kTypeFunc)
+    {
+        macro.bindParameters();
+    }
 
     // Check for macro redefinition.
-    MacroSet::const_iterator iter = mMacroSet->find(macro.name);
+    MacroSet::const_iterator iter = mMacroSet->find(internedName);
     if (iter != mMacroSet->end() && !macro.equals(iter->second))
     {
         mDiagnostics->report(Diagnostics::PP_MACRO_REDEFINED, token->location, macro.name);
         return;
     }
-    mMacroSet->insert(std::make_pair(macro.name, macro));
+    mMacroSet->insert(std::make_pair(internedName, std::move(macro)));
 }
 
 void DirectiveParser::parseUndef(Token *token)
@@ -427,23 +439,23 @@ void DirectiveParser::parseUndef(Token *token)
     mTokenizer->lex(token);
     if (token->type != Token::IDENTIFIER)
     {
-        mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text);
+        mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text());
         return;
     }
 
-    MacroSet::iterator iter = mMacroSet->find(token->text);
+    MacroSet::iterator iter = mMacroSet->find(token->internedText());
     if (iter != mMacroSet->end())
     {
         if (iter->second.predefined)
         {
             mDiagnostics->report(Diagnostics::PP_MACRO_PREDEFINED_UNDEFINED, token->location,
-                                 token->text);
+                                 token->text());
             return;
         }
         else if (iter->second.expansionCount > 0)
         {
             mDiagnostics->report(Diagnostics::PP_MACRO_UNDEFINED_WHILE_INVOKED, token->location,
-                                 token->text);
+                                 token->text());
             return;
         }
         else
@@ -455,7 +467,7 @@ void DirectiveParser::parseUndef(Token *token)
     mTokenizer->lex(token);
     if (!isEOD(token))
     {
-        mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text);
+        mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text());
         skipUntilEOD(mTokenizer, token);
     }
 }
@@ -485,7 +497,7 @@ void DirectiveParser::parseElse(Token *token)
     if (mConditionalStack.empty())
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_ELSE_WITHOUT_IF, token->location,
-                             token->text);
+                             token->text());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -500,7 +512,7 @@ void DirectiveParser::parseElse(Token *token)
     if (block.foundElseGroup)
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_ELSE_AFTER_ELSE, token->location,
-                             token->text);
+                             token->text());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -514,7 +526,7 @@ void DirectiveParser::parseElse(Token *token)
     if (!isEOD(token))
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_UNEXPECTED_TOKEN, token->location,
-                             token->text);
+                             token->text());
         skipUntilEOD(mTokenizer, token);
     }
 }
@@ -526,7 +538,7 @@ void DirectiveParser::parseElif(Token *token)
     if (mConditionalStack.empty())
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_ELIF_WITHOUT_IF, token->location,
-                             token->text);
+                             token->text());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -541,7 +553,7 @@ void DirectiveParser::parseElif(Token *token)
     if (block.foundElseGroup)
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_ELIF_AFTER_ELSE, token->location,
-                             token->text);
+                             token->text());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -566,7 +578,7 @@ void DirectiveParser::parseEndif(Token *token)
     if (mConditionalStack.empty())
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_ENDIF_WITHOUT_IF, token->location,
-                             token->text);
+                             token->text());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -578,7 +590,7 @@ void DirectiveParser::parseEndif(Token *token)
     if (!isEOD(token))
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_UNEXPECTED_TOKEN, token->location,
-                             token->text);
+                             token->text());
         skipUntilEOD(mTokenizer, token);
     }
 }
@@ -615,7 +627,7 @@ void DirectiveParser::parsePragma(Token *token)
     int state = PRAGMA_NAME;
 
     mTokenizer->lex(token);
-    bool stdgl = token->text == "STDGL";
+    bool stdgl = token->text() == "STDGL";
     if (stdgl)
     {
         mTokenizer->lex(token);
@@ -625,14 +637,14 @@ void DirectiveParser::parsePragma(Token *token)
         switch (state++)
         {
             case PRAGMA_NAME:
-                name  = token->text;
+                name  = token->text();
                 valid = valid && (token->type == Token::IDENTIFIER);
                 break;
             case LEFT_PAREN:
                 valid = valid && (token->type == '(');
                 break;
             case PRAGMA_VALUE:
-                value = token->text;
+                value = token->text();
                 valid = valid && (token->type == Token::IDENTIFIER);
                 break;
             case RIGHT_PAREN:
@@ -682,17 +694,17 @@ void DirectiveParser::parseExtension(Token *token)
                 if (valid && (token->type != Token::IDENTIFIER))
                 {
                     mDiagnostics->report(Diagnostics::PP_INVALID_EXTENSION_NAME, token->location,
-                                         token->text);
+                                         token->text());
                     valid = false;
                 }
                 if (valid)
-                    name = token->text;
+                    name = token->text();
                 break;
             case COLON:
                 if (valid && (token->type != ':'))
                 {
                     mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location,
-                                         token->text);
+                                         token->text());
                     valid = false;
                 }
                 break;
@@ -700,17 +712,17 @@ void DirectiveParser::parseExtension(Token *token)
                 if (valid && (token->type != Token::IDENTIFIER))
                 {
                     mDiagnostics->report(Diagnostics::PP_INVALID_EXTENSION_BEHAVIOR,
-                                         token->location, token->text);
+                                         token->location, token->text());
                     valid = false;
                 }
                 if (valid)
-                    behavior = token->text;
+                    behavior = token->text();
                 break;
             default:
                 if (valid)
                 {
                     mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location,
-                                         token->text);
+                                         token->text());
                     valid = false;
                 }
                 break;
@@ -720,7 +732,7 @@ void DirectiveParser::parseExtension(Token *token)
     if (valid && (state != EXT_BEHAVIOR + 1))
     {
         mDiagnostics->report(Diagnostics::PP_INVALID_EXTENSION_DIRECTIVE, token->location,
-                             token->text);
+                             token->text());
         valid = false;
     }
     if (valid && mSeenNonPreprocessorToken)
@@ -728,13 +740,13 @@ void DirectiveParser::parseExtension(Token *token)
         if (mShaderVersion >= 300)
         {
             mDiagnostics->report(Diagnostics::PP_NON_PP_TOKEN_BEFORE_EXTENSION_ESSL3,
-                                 token->location, token->text);
+                                 token->location, token->text());
             valid = false;
         }
         else
         {
             mDiagnostics->report(Diagnostics::PP_NON_PP_TOKEN_BEFORE_EXTENSION_ESSL1,
-                                 token->location, token->text);
+                                 token->location, token->text());
         }
     }
     if (valid)
@@ -748,7 +760,7 @@ void DirectiveParser::parseVersion(Token *token)
     if (mPastFirstStatement)
     {
         mDiagnostics->report(Diagnostics::PP_VERSION_NOT_FIRST_STATEMENT, token->location,
-                             token->text);
+                             token->text());
         skipUntilEOD(mTokenizer, token);
         return;
     }
@@ -773,13 +785,13 @@ void DirectiveParser::parseVersion(Token *token)
                 if (token->type != Token::CONST_INT)
                 {
                     mDiagnostics->report(Diagnostics::PP_INVALID_VERSION_NUMBER, token->location,
-                                         token->text);
+                                         token->text());
                     valid = false;
                 }
                 if (valid && !token->iValue(&version))
                 {
                     mDiagnostics->report(Diagnostics::PP_INTEGER_OVERFLOW, token->location,
-                                         token->text);
+                                         token->text());
                     valid = false;
                 }
                 if (valid)
@@ -788,17 +800,17 @@ void DirectiveParser::parseVersion(Token *token)
                 }
                 break;
             case VERSION_PROFILE:
-                if (token->type != Token::IDENTIFIER || token->text != "es")
+                if (token->type != Token::IDENTIFIER || token->text() != "es")
                 {
                     mDiagnostics->report(Diagnostics::PP_INVALID_VERSION_DIRECTIVE, token->location,
-                                         token->text);
+                                         token->text());
                     valid = false;
                 }
                 state = VERSION_ENDLINE;
                 break;
             default:
                 mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location,
-                                     token->text);
+                                     token->text());
                 valid = false;
                 break;
         }
@@ -809,14 +821,14 @@ void DirectiveParser::parseVersion(Token *token)
     if (valid && (state != VERSION_ENDLINE))
     {
         mDiagnostics->report(Diagnostics::PP_INVALID_VERSION_DIRECTIVE, token->location,
-                             token->text);
+                             token->text());
         valid = false;
     }
 
     if (valid && version >= 300 && token->location.line > 1)
     {
         mDiagnostics->report(Diagnostics::PP_VERSION_NOT_FIRST_LINE_ESSL3, token->location,
-                             token->text);
+                             token->text());
         valid = false;
     }
 
@@ -824,7 +836,7 @@ void DirectiveParser::parseVersion(Token *token)
     {
         mDirectiveHandler->handleVersion(token->location, version);
         mShaderVersion = version;
-        PredefineMacro(mMacroSet, "__VERSION__", version);
+        PredefineMacro(mMacroSet, mStrings, "__VERSION__", version);
     }
 }
 
@@ -836,14 +848,15 @@ void DirectiveParser::parseLine(Token *token)
     bool parsedFileNumber = false;
     int line = 0, file = 0;
 
-    MacroExpander macroExpander(mTokenizer, mMacroSet, mDiagnostics, mMaxMacroExpansionDepth);
+    MacroExpander macroExpander(mTokenizer, mMacroSet, mStrings, mDiagnostics,
+                                mMaxMacroExpansionDepth);
 
     // Lex the first token after "#line" so we can check it for EOD.
     macroExpander.lex(token);
 
     if (isEOD(token))
     {
-        mDiagnostics->report(Diagnostics::PP_INVALID_LINE_DIRECTIVE, token->location, token->text);
+        mDiagnostics->report(Diagnostics::PP_INVALID_LINE_DIRECTIVE, token->location, token->text());
         valid = false;
     }
     else
@@ -875,7 +888,7 @@ void DirectiveParser::parseLine(Token *token)
             if (valid)
             {
                 mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location,
-                                     token->text);
+                                     token->text());
                 valid = false;
             }
             skipUntilEOD(mTokenizer, token);
@@ -902,7 +915,7 @@ bool DirectiveParser::skipping() const
 void DirectiveParser::parseConditionalIf(Token *token)
 {
     ConditionalBlock block;
-    block.type     = token->text;
+    block.type     = token->text();
     block.location = token->location;
 
     if (skipping())
@@ -944,8 +957,9 @@ int DirectiveParser::parseExpressionIf(Token *token)
 {
     ASSERT((getDirective(token) == DIRECTIVE_IF) || (getDirective(token) == DIRECTIVE_ELIF));
 
-    DefinedParser definedParser(mTokenizer, mMacroSet, mDiagnostics);
-    MacroExpander macroExpander(&definedParser, mMacroSet, mDiagnostics, mMaxMacroExpansionDepth);
+    DefinedParser definedParser(mTokenizer, mMacroSet, mStrings, mDiagnostics);
+    MacroExpander macroExpander(&definedParser, mMacroSet, mStrings, mDiagnostics,
+                                mMaxMacroExpansionDepth);
     ExpressionParser expressionParser(&macroExpander, mDiagnostics);
 
     int expression = 0;
@@ -960,7 +974,7 @@ int DirectiveParser::parseExpressionIf(Token *token)
     if (!isEOD(token))
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_UNEXPECTED_TOKEN, token->location,
-                             token->text);
+                             token->text());
         skipUntilEOD(mTokenizer, token);
     }
 
@@ -974,12 +988,12 @@ int DirectiveParser::parseExpressionIfdef(Token *token)
     mTokenizer->lex(token);
     if (token->type != Token::IDENTIFIER)
     {
-        mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text);
+        mDiagnostics->report(Diagnostics::PP_UNEXPECTED_TOKEN, token->location, token->text());
         skipUntilEOD(mTokenizer, token);
         return 0;
     }
 
-    MacroSet::const_iterator iter = mMacroSet->find(token->text);
+    MacroSet::const_iterator iter = mMacroSet->find(token->internedText());
     int expression                = iter != mMacroSet->end() ? 1 : 0;
 
     // Check if there are tokens after #ifdef expression.
@@ -987,7 +1001,7 @@ int DirectiveParser::parseExpressionIfdef(Token *token)
     if (!isEOD(token))
     {
         mDiagnostics->report(Diagnostics::PP_CONDITIONAL_UNEXPECTED_TOKEN, token->location,
-                             token->text);
+                             token->text());
         skipUntilEOD(mTokenizer, token);
     }
     return expression;
@@ -16,6 +16,7 @@ namespace pp
 
 class Diagnostics;
 class DirectiveHandler;
+class StringTable;
 class Tokenizer;
 
 class DirectiveParser : public Lexer
@@ -23,6 +24,7 @@ class DirectiveParser : public Lexer
   public:
     DirectiveParser(Tokenizer *tokenizer,
                     MacroSet *macroSet,
+                    StringTable *strings,
                     Diagnostics *diagnostics,
                     DirectiveHandler *directiveHandler,
                     int maxMacroExpansionDepth);
@@ -71,6 +73,7 @@ class DirectiveParser : public Lexer
     std::vector<ConditionalBlock> mConditionalStack;
     Tokenizer *mTokenizer;
     MacroSet *mMacroSet;
+    StringTable *mStrings;
     Diagnostics *mDiagnostics;
     DirectiveHandler *mDirectiveHandler;
     int mShaderVersion;
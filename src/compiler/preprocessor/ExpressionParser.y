@@ -119,7 +119,7 @@ expression
             // This rule should be applied right after the token is lexed, so we can
             // refer to context->token in the error message.
             context->diagnostics->report(context->errorSettings.unexpectedIdentifier,
-                                         context->token->location, context->token->text);
+                                         context->token->location, context->token->text());
             *(context->valid) = false;
         }
         $$ = $1;
@@ -353,7 +353,7 @@ int yylex(YYSTYPE *lvalp, Context *context)
                                      context->errorSettings.integerLiteralsMustFit32BitSignedRange))
         {
             context->diagnostics->report(pp::Diagnostics::PP_INTEGER_OVERFLOW,
-                                         token->location, token->text);
+                                         token->location, token->text());
             *(context->valid) = false;
         }
         *lvalp = static_cast<YYSTYPE>(val);
@@ -6,7 +6,10 @@
 
 #include "compiler/preprocessor/Macro.h"
 
+#include <algorithm>
+
 #include "common/angleutils.h"
+#include "compiler/preprocessor/StringTable.h"
 #include "compiler/preprocessor/Token.h"
 
 namespace pp
@@ -18,11 +21,31 @@ bool Macro::equals(const Macro &other) const
            (replacements == other.replacements);
 }
 
-void PredefineMacro(MacroSet *macroSet, const char *name, int value)
+void Macro::bindParameters()
+{
+    replacementParameters.clear();
+    replacementParameters.reserve(replacements.size());
+    for (const Token &repl : replacements)
+    {
+        int index = -1;
+        if (repl.type == Token::IDENTIFIER)
+        {
+            Parameters::const_iterator iter =
+                std::find(parameters.begin(), parameters.end(), repl.text());
+            if (iter != parameters.end())
+            {
+                index = static_cast<int>(iter - parameters.begin());
+            }
+        }
+        replacementParameters.push_back(index);
+    }
+}
+
+void PredefineMacro(MacroSet *macroSet, StringTable *strings, const char *name, int value)
 {
     Token token;
     token.type = Token::CONST_INT;
-    token.text = ToString(value);
+    token.setText(strings->intern(ToString(value)));
 
     Macro macro;
     macro.predefined = true;
@@ -30,7 +53,7 @@ void PredefineMacro(MacroSet *macroSet, const char *name, int value)
     macro.name       = name;
     macro.replacements.push_back(token);
 
-    (*macroSet)[name] = macro;
+    (*macroSet)[strings->intern(name)] = macro;
 }
 
 }  // namespace pp
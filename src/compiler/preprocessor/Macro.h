@@ -7,13 +7,14 @@
 #ifndef COMPILER_PREPROCESSOR_MACRO_H_
 #define COMPILER_PREPROCESSOR_MACRO_H_
 
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace pp
 {
 
+class StringTable;
 struct Token;
 
 struct Macro
@@ -29,6 +30,10 @@ struct Macro
     Macro() : predefined(false), disabled(false), expansionCount(0), type(kTypeObj) {}
     bool equals(const Macro &other) const;
 
+    // Resolves which replacement tokens name a parameter. Must be called once the parameters and
+    // replacement list of a function-like macro are complete.
+    void bindParameters();
+
     bool predefined;
     mutable bool disabled;
     mutable int expansionCount;
@@ -37,11 +42,18 @@ struct Macro
     std::string name;
     Parameters parameters;
     Replacements replacements;
+
+    // For each replacement token, the index of the parameter it names or -1, so that expansion
+    // doesn't have to compare every identifier against the parameter list.
+    std::vector<int> replacementParameters;
 };
 
-typedef std::map<std::string, Macro> MacroSet;
+// Looked up for every identifier the preprocessor sees, so it is keyed on the name interned in the
+// preprocessor's StringTable, and hashing or comparing a key never reads the name. Nothing may
+// depend on the iteration order.
+typedef std::unordered_map<const std::string *, Macro> MacroSet;
 
-void PredefineMacro(MacroSet *macroSet, const char *name, int value);
+void PredefineMacro(MacroSet *macroSet, StringTable *strings, const char *name, int value);
 
 }  // namespace pp
 
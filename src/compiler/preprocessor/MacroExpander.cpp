@@ -6,10 +6,9 @@
 
 #include "compiler/preprocessor/MacroExpander.h"
 
-#include <algorithm>
-
 #include "common/debug.h"
 #include "compiler/preprocessor/DiagnosticsBase.h"
+#include "compiler/preprocessor/StringTable.h"
 #include "compiler/preprocessor/Token.h"
 
 namespace pp
@@ -20,20 +19,15 @@ namespace
 
 const size_t kMaxContextTokens = 10000;
 
+// Lexes a range of tokens owned by someone else.
 class TokenLexer : public Lexer
 {
   public:
-    typedef std::vector<Token> TokenVector;
-
-    TokenLexer(TokenVector *tokens)
-    {
-        tokens->swap(mTokens);
-        mIter = mTokens.begin();
-    }
+    TokenLexer(const Token *begin, const Token *end) : mIter(begin), mEnd(end) {}
 
     void lex(Token *token) override
     {
-        if (mIter == mTokens.end())
+        if (mIter == mEnd)
         {
             token->reset();
             token->type = Token::LAST;
@@ -45,12 +39,90 @@ class TokenLexer : public Lexer
     }
 
   private:
-    TokenVector mTokens;
-    TokenVector::const_iterator mIter;
+    const Token *mIter;
+    const Token *mEnd;
 };
 
 }  // anonymous namespace
 
+// The arguments of one macro invocation, stored back to back in one vector.
+struct MacroExpander::MacroArgs
+{
+    void clear()
+    {
+        tokens.clear();
+        ends.clear();
+    }
+    size_t size() const { return ends.size(); }
+    const Token *begin(size_t arg) const { return tokens.data() + (arg == 0 ? 0 : ends[arg - 1]); }
+    const Token *end(size_t arg) const { return tokens.data() + ends[arg]; }
+    bool empty(size_t arg) const { return begin(arg) == end(arg); }
+
+    void beginArg() { ends.push_back(tokens.size()); }
+    void append(const Token &token)
+    {
+        tokens.push_back(token);
+        ends.back() = tokens.size();
+    }
+
+    std::vector<Token> tokens;
+    // One past the last token of each argument.
+    std::vector<size_t> ends;
+};
+
+// Contexts and argument lists that are no longer in use. An expander shares its pool with the
+// nested expanders that pre-expand its macro arguments, so that once the pool is warmed up,
+// expanding a macro reuses the storage of earlier expansions instead of allocating.
+struct MacroExpander::ExpansionPool : angle::NonCopyable
+{
+    ~ExpansionPool()
+    {
+        for (MacroContext *context : spareContexts)
+        {
+            delete context;
+        }
+        for (MacroArgs *args : spareArgs)
+        {
+            delete args;
+        }
+    }
+
+    MacroContext *allocateContext()
+    {
+        MacroContext *context = nullptr;
+        if (spareContexts.empty())
+        {
+            context = new MacroContext;
+        }
+        else
+        {
+            context = spareContexts.back();
+            spareContexts.pop_back();
+        }
+        context->reset();
+        return context;
+    }
+
+    MacroArgs *allocateArgs()
+    {
+        MacroArgs *args = nullptr;
+        if (spareArgs.empty())
+        {
+            args = new MacroArgs;
+        }
+        else
+        {
+            args = spareArgs.back();
+            spareArgs.pop_back();
+        }
+        args->clear();
+        return args;
+    }
+
+    std::vector<MacroContext *> spareContexts;
+    std::vector<MacroArgs *> spareArgs;
+};
+
 class MacroExpander::ScopedMacroReenabler final : angle::NonCopyable
 {
   public:
@@ -79,24 +151,40 @@ MacroExpander::ScopedMacroReenabler::~ScopedMacroReenabler()
 
 MacroExpander::MacroExpander(Lexer *lexer,
                              MacroSet *macroSet,
+                             StringTable *strings,
                              Diagnostics *diagnostics,
                              int allowedMacroExpansionDepth)
     : mLexer(lexer),
       mMacroSet(macroSet),
+      mStrings(strings),
       mDiagnostics(diagnostics),
+      mOwnedPool(new ExpansionPool),
+      mPool(mOwnedPool.get()),
+      mHasReserveToken(false),
       mTotalTokensInContexts(0),
       mAllowedMacroExpansionDepth(allowedMacroExpansionDepth),
       mDeferReenablingMacros(false)
 {
 }
 
+MacroExpander::MacroExpander(Lexer *lexer, MacroExpander *parent)
+    : mLexer(lexer),
+      mMacroSet(parent->mMacroSet),
+      mStrings(parent->mStrings),
+      mDiagnostics(parent->mDiagnostics),
+      mPool(parent->mPool),
+      mHasReserveToken(false),
+      mTotalTokensInContexts(0),
+      mAllowedMacroExpansionDepth(parent->mAllowedMacroExpansionDepth - 1),
+      mDeferReenablingMacros(false)
+{
+}
+
 MacroExpander::~MacroExpander()
 {
     ASSERT(mMacrosToReenable.empty());
-    for (MacroContext *context : mContextStack)
-    {
-        delete context;
-    }
+    mPool->spareContexts.insert(mPool->spareContexts.end(), mContextStack.begin(),
+                                mContextStack.end());
 }
 
 void MacroExpander::lex(Token *token)
@@ -111,7 +199,7 @@ void MacroExpander::lex(Token *token)
         if (token->expansionDisabled())
             break;
 
-        MacroSet::const_iterator iter = mMacroSet->find(token->text);
+        MacroSet::const_iterator iter = mMacroSet->find(token->internedText());
         if (iter == mMacroSet->end())
             break;
 
@@ -140,10 +228,10 @@ void MacroExpander::lex(Token *token)
 
 void MacroExpander::getToken(Token *token)
 {
-    if (mReserveToken.get())
+    if (mHasReserveToken)
     {
-        *token = *mReserveToken;
-        mReserveToken.reset();
+        *token           = mReserveToken;
+        mHasReserveToken = false;
         return;
     }
 
@@ -155,7 +243,7 @@ void MacroExpander::getToken(Token *token)
 
     if (!mContextStack.empty())
     {
-        *token = mContextStack.back()->get();
+        mContextStack.back()->get(token);
     }
     else
     {
@@ -170,12 +258,14 @@ void MacroExpander::ungetToken(const Token &token)
     {
         MacroContext *context = mContextStack.back();
         context->unget();
-        ASSERT(context->replacements[context->index] == token);
+        ASSERT((*context->replacements)[context->index].type == token.type &&
+               (*context->replacements)[context->index].internedText() == token.internedText());
     }
     else
     {
-        ASSERT(!mReserveToken.get());
-        mReserveToken.reset(new Token(token));
+        ASSERT(!mHasReserveToken);
+        mReserveToken    = token;
+        mHasReserveToken = true;
     }
 }
 
@@ -195,20 +285,21 @@ bool MacroExpander::pushMacro(const Macro &macro, const Token &identifier)
     ASSERT(!macro.disabled);
     ASSERT(!identifier.expansionDisabled());
     ASSERT(identifier.type == Token::IDENTIFIER);
-    ASSERT(identifier.text == macro.name);
+    ASSERT(identifier.text() == macro.name);
 
-    std::vector<Token> replacements;
-    if (!expandMacro(macro, identifier, &replacements))
+    MacroContext *context = mPool->allocateContext();
+    if (!expandMacro(macro, identifier, context))
+    {
+        mPool->spareContexts.push_back(context);
         return false;
+    }
 
     // Macro is disabled for expansion until it is popped off the stack.
     macro.disabled = true;
 
-    MacroContext *context = new MacroContext;
-    context->macro        = &macro;
-    context->replacements.swap(replacements);
+    context->macro = &macro;
     mContextStack.push_back(context);
-    mTotalTokensInContexts += context->replacements.size();
+    mTotalTokensInContexts += context->size();
     return true;
 }
 
@@ -231,16 +322,14 @@ void MacroExpander::popMacro()
         context->macro->disabled = false;
     }
     context->macro->expansionCount--;
-    mTotalTokensInContexts -= context->replacements.size();
-    delete context;
+    mTotalTokensInContexts -= context->size();
+    mPool->spareContexts.push_back(context);
 }
 
 bool MacroExpander::expandMacro(const Macro &macro,
                                 const Token &identifier,
-                                std::vector<Token> *replacements)
+                                MacroContext *context)
 {
-    replacements->clear();
-
     // In the case of an object-like macro, the replacement list gets its location
     // from the identifier, but in the case of a function-like macro, the replacement
     // list gets its location from the closing parenthesis of the macro invocation.
@@ -248,83 +337,101 @@ bool MacroExpander::expandMacro(const Macro &macro,
     SourceLocation replacementLocation = identifier.location;
     if (macro.type == Macro::kTypeObj)
     {
-        replacements->assign(macro.replacements.begin(), macro.replacements.end());
-
         if (macro.predefined)
         {
             const char kLine[] = "__LINE__";
             const char kFile[] = "__FILE__";
 
+            std::vector<Token> *replacements = &context->expansion;
+            replacements->assign(macro.replacements.begin(), macro.replacements.end());
+
             ASSERT(replacements->size() == 1);
             Token &repl = replacements->front();
             if (macro.name == kLine)
             {
-                repl.text = ToString(identifier.location.line);
+                repl.setText(mStrings->intern(ToString(identifier.location.line)));
             }
             else if (macro.name == kFile)
             {
-                repl.text = ToString(identifier.location.file);
+                repl.setText(mStrings->intern(ToString(identifier.location.file)));
             }
         }
+        else
+        {
+            // The tokens only differ from the macro's own in their location and the padding of
+            // the first one, which the context fills in as it goes.
+            context->replacements = &macro.replacements;
+        }
     }
     else
     {
         ASSERT(macro.type == Macro::kTypeFunc);
-        std::vector<MacroArg> args;
-        args.reserve(macro.parameters.size());
-        if (!collectMacroArgs(macro, identifier, &args, &replacementLocation))
-            return false;
-
-        replaceMacroParams(macro, args, replacements);
-    }
-
-    for (std::size_t i = 0; i < replacements->size(); ++i)
-    {
-        Token &repl = replacements->at(i);
-        if (i == 0)
+        MacroArgs *args = mPool->allocateArgs();
+        bool collected  = collectMacroArgs(macro, identifier, args, &replacementLocation);
+        if (collected)
         {
-            // The first token in the replacement list inherits the padding
-            // properties of the identifier token.
-            repl.setAtStartOfLine(identifier.atStartOfLine());
-            repl.setHasLeadingSpace(identifier.hasLeadingSpace());
+            replaceMacroParams(macro, *args, &context->expansion);
         }
-        repl.location = replacementLocation;
+        mPool->spareArgs.push_back(args);
+        if (!collected)
+            return false;
     }
+
+    // The first token in the replacement list inherits the padding
+    // properties of the identifier token.
+    context->firstAtStartOfLine   = identifier.atStartOfLine();
+    context->firstHasLeadingSpace = identifier.hasLeadingSpace();
+    context->location             = replacementLocation;
     return true;
 }
 
 bool MacroExpander::collectMacroArgs(const Macro &macro,
                                      const Token &identifier,
-                                     std::vector<MacroArg> *args,
+                                     MacroArgs *args,
                                      SourceLocation *closingParenthesisLocation)
 {
     Token token;
     getToken(&token);
     ASSERT(token.type == '(');
 
-    args->push_back(MacroArg());
-
     // Defer reenabling macros until args collection is finished to avoid the possibility of
     // infinite recursion. Otherwise infinite recursion might happen when expanding the args after
     // macros have been popped from the context stack when parsing the args.
     ScopedMacroReenabler deferReenablingMacros(this);
 
+    // The arguments are collected as written and then pre-expanded into args.
+    MacroArgs *rawArgs = mPool->allocateArgs();
+    bool collected =
+        collectRawMacroArgs(macro, identifier, rawArgs, closingParenthesisLocation, &token) &&
+        preExpandMacroArgs(*rawArgs, args, &token);
+    mPool->spareArgs.push_back(rawArgs);
+    return collected;
+}
+
+bool MacroExpander::collectRawMacroArgs(const Macro &macro,
+                                        const Token &identifier,
+                                        MacroArgs *args,
+                                        SourceLocation *closingParenthesisLocation,
+                                        Token *token)
+{
+    args->beginArg();
+
     int openParens = 1;
     while (openParens != 0)
     {
-        getToken(&token);
+        getToken(token);
 
-        if (token.type == Token::LAST)
+        if (token->type == Token::LAST)
         {
             mDiagnostics->report(Diagnostics::PP_MACRO_UNTERMINATED_INVOCATION, identifier.location,
-                                 identifier.text);
+                                 identifier.text());
             // Do not lose EOF token.
-            ungetToken(token);
+            ungetToken(*token);
             return false;
         }
 
         bool isArg = false;  // True if token is part of the current argument.
-        switch (token.type)
+        switch (token->type)
         {
             case '(':
                 ++openParens;
@@ -333,14 +440,14 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
             case ')':
                 --openParens;
                 isArg                       = openParens != 0;
-                *closingParenthesisLocation = token.location;
+                *closingParenthesisLocation = token->location;
                 break;
             case ',':
                 // The individual arguments are separated by comma tokens, but
                 // the comma tokens between matching inner parentheses do not
                 // seperate arguments.
                 if (openParens == 1)
-                    args->push_back(MacroArg());
+                    args->beginArg();
                 isArg = openParens != 1;
                 break;
             default:
@@ -349,17 +456,16 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
         }
         if (isArg)
         {
-            MacroArg &arg = args->back();
             // Initial whitespace is not part of the argument.
-            if (arg.empty())
-                token.setHasLeadingSpace(false);
-            arg.push_back(token);
+            if (args->empty(args->size() - 1))
+                token->setHasLeadingSpace(false);
+            args->append(*token);
         }
     }
 
     const Macro::Parameters &params = macro.parameters;
     // If there is only one empty argument, it is equivalent to no argument.
-    if (params.empty() && (args->size() == 1) && args->front().empty())
+    if (params.empty() && (args->size() == 1) && args->empty(0))
     {
         args->clear();
     }
@@ -369,35 +475,40 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
         Diagnostics::ID id = args->size() < macro.parameters.size()
                                  ? Diagnostics::PP_MACRO_TOO_FEW_ARGS
                                  : Diagnostics::PP_MACRO_TOO_MANY_ARGS;
-        mDiagnostics->report(id, identifier.location, identifier.text);
+        mDiagnostics->report(id, identifier.location, identifier.text());
         return false;
     }
+    return true;
+}
 
+bool MacroExpander::preExpandMacroArgs(const MacroArgs &rawArgs, MacroArgs *args, Token *token)
+{
     // Pre-expand each argument before substitution.
     // This step expands each argument individually before they are
     // inserted into the macro body.
     size_t numTokens = 0;
-    for (auto &arg : *args)
+    for (size_t i = 0; i < rawArgs.size(); ++i)
     {
-        TokenLexer lexer(&arg);
+        TokenLexer lexer(rawArgs.begin(i), rawArgs.end(i));
         if (mAllowedMacroExpansionDepth < 1)
         {
-            mDiagnostics->report(Diagnostics::PP_MACRO_INVOCATION_CHAIN_TOO_DEEP, token.location,
-                                 token.text);
+            mDiagnostics->report(Diagnostics::PP_MACRO_INVOCATION_CHAIN_TOO_DEEP, token->location,
+                                 token->text());
             return false;
         }
-        MacroExpander expander(&lexer, mMacroSet, mDiagnostics, mAllowedMacroExpansionDepth - 1);
+        MacroExpander expander(&lexer, this);
 
-        arg.clear();
-        expander.lex(&token);
-        while (token.type != Token::LAST)
+        args->beginArg();
+        expander.lex(token);
+        while (token->type != Token::LAST)
         {
-            arg.push_back(token);
-            expander.lex(&token);
+            args->append(*token);
+            expander.lex(token);
             numTokens++;
             if (numTokens + mTotalTokensInContexts > kMaxContextTokens)
             {
-                mDiagnostics->report(Diagnostics::PP_OUT_OF_MEMORY, token.location, token.text);
+                mDiagnostics->report(Diagnostics::PP_OUT_OF_MEMORY, token->location,
+                                     token->text());
                 return false;
             }
         }
@@ -406,63 +517,81 @@ bool MacroExpander::collectMacroArgs(const Macro &macro,
 }
 
 void MacroExpander::replaceMacroParams(const Macro &macro,
-                                       const std::vector<MacroArg> &args,
+                                       const MacroArgs &args,
                                        std::vector<Token> *replacements)
 {
+    ASSERT(macro.replacementParameters.size() == macro.replacements.size());
     for (std::size_t i = 0; i < macro.replacements.size(); ++i)
     {
         if (!replacements->empty() &&
             replacements->size() + mTotalTokensInContexts > kMaxContextTokens)
         {
             const Token &token = replacements->back();
-            mDiagnostics->report(Diagnostics::PP_OUT_OF_MEMORY, token.location, token.text);
+            mDiagnostics->report(Diagnostics::PP_OUT_OF_MEMORY, token.location, token.text());
             return;
         }
 
         const Token &repl = macro.replacements[i];
-        if (repl.type != Token::IDENTIFIER)
+        int iArg          = macro.replacementParameters[i];
+        if (iArg < 0)
         {
             replacements->push_back(repl);
             continue;
         }
 
-        // TODO(alokp): Optimize this.
-        // There is no need to search for macro params every time.
-        // The param index can be cached with the replacement token.
-        Macro::Parameters::const_iterator iter =
-            std::find(macro.parameters.begin(), macro.parameters.end(), repl.text);
-        if (iter == macro.parameters.end())
-        {
-            replacements->push_back(repl);
-            continue;
-        }
-
-        std::size_t iArg    = std::distance(macro.parameters.begin(), iter);
-        const MacroArg &arg = args[iArg];
-        if (arg.empty())
+        if (args.empty(iArg))
         {
             continue;
         }
         std::size_t iRepl = replacements->size();
-        replacements->insert(replacements->end(), arg.begin(), arg.end());
+        replacements->insert(replacements->end(), args.begin(iArg), args.end(iArg));
         // The replacement token inherits padding properties from
         // macro replacement token.
         replacements->at(iRepl).setHasLeadingSpace(repl.hasLeadingSpace());
     }
 }
 
-MacroExpander::MacroContext::MacroContext() : macro(0), index(0)
+MacroExpander::MacroContext::MacroContext()
+    : macro(nullptr),
+      index(0),
+      replacements(&expansion),
+      firstAtStartOfLine(false),
+      firstHasLeadingSpace(false)
+{
+}
+
+void MacroExpander::MacroContext::reset()
 {
+    macro        = nullptr;
+    index        = 0;
+    replacements = &expansion;
+    expansion.clear();
+    location             = SourceLocation();
+    firstAtStartOfLine   = false;
+    firstHasLeadingSpace = false;
 }
 
 bool MacroExpander::MacroContext::empty() const
 {
-    return index == replacements.size();
+    return index == replacements->size();
 }
 
-const Token &MacroExpander::MacroContext::get()
+size_t MacroExpander::MacroContext::size() const
 {
-    return replacements[index++];
+    return replacements->size();
+}
+
+void MacroExpander::MacroContext::get(Token *token)
+{
+    // Assigning into the caller's token reuses its text storage.
+    *token          = (*replacements)[index];
+    token->location = location;
+    if (index == 0)
+    {
+        token->setAtStartOfLine(firstAtStartOfLine);
+        token->setHasLeadingSpace(firstHasLeadingSpace);
+    }
+    index++;
 }
 
 void MacroExpander::MacroContext::unget()
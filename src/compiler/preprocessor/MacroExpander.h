@@ -12,18 +12,21 @@
 
 #include "compiler/preprocessor/Lexer.h"
 #include "compiler/preprocessor/Macro.h"
+#include "compiler/preprocessor/SourceLocation.h"
+#include "compiler/preprocessor/Token.h"
 
 namespace pp
 {
 
 class Diagnostics;
-struct SourceLocation;
+class StringTable;
 
 class MacroExpander : public Lexer
 {
   public:
     MacroExpander(Lexer *lexer,
                   MacroSet *macroSet,
+                  StringTable *strings,
                   Diagnostics *diagnostics,
                   int allowedMacroExpansionDepth);
     ~MacroExpander() override;
@@ -31,41 +34,71 @@ class MacroExpander : public Lexer
     void lex(Token *token) override;
 
   private:
+    struct ExpansionPool;
+    struct MacroArgs;
+
+    // Creates an expander for pre-expanding one of parent's macro arguments, which shares the
+    // parent's pool.
+    MacroExpander(Lexer *lexer, MacroExpander *parent);
+
     void getToken(Token *token);
     void ungetToken(const Token &token);
     bool isNextTokenLeftParen();
 
-    bool pushMacro(const Macro &macro, const Token &identifier);
-    void popMacro();
-
-    bool expandMacro(const Macro &macro, const Token &identifier, std::vector<Token> *replacements);
-
-    typedef std::vector<Token> MacroArg;
-    bool collectMacroArgs(const Macro &macro,
-                          const Token &identifier,
-                          std::vector<MacroArg> *args,
-                          SourceLocation *closingParenthesisLocation);
-    void replaceMacroParams(const Macro &macro,
-                            const std::vector<MacroArg> &args,
-                            std::vector<Token> *replacements);
-
     struct MacroContext
     {
         MacroContext();
+        void reset();
         bool empty() const;
-        const Token &get();
+        size_t size() const;
+        void get(Token *token);
         void unget();
 
         const Macro *macro;
         std::size_t index;
-        std::vector<Token> replacements;
+
+        // Object-like macros are read straight out of the macro's replacement list. Other
+        // expansions are built in |expansion|, which keeps its storage when the context is
+        // recycled.
+        const std::vector<Token> *replacements;
+        std::vector<Token> expansion;
+
+        // Applied to each token as it is handed out.
+        SourceLocation location;
+        bool firstAtStartOfLine;
+        bool firstHasLeadingSpace;
     };
 
+    bool pushMacro(const Macro &macro, const Token &identifier);
+    void popMacro();
+
+    bool expandMacro(const Macro &macro, const Token &identifier, MacroContext *context);
+
+    bool collectMacroArgs(const Macro &macro,
+                          const Token &identifier,
+                          MacroArgs *args,
+                          SourceLocation *closingParenthesisLocation);
+    bool collectRawMacroArgs(const Macro &macro,
+                             const Token &identifier,
+                             MacroArgs *args,
+                             SourceLocation *closingParenthesisLocation,
+                             Token *token);
+    bool preExpandMacroArgs(const MacroArgs &rawArgs, MacroArgs *args, Token *token);
+    void replaceMacroParams(const Macro &macro,
+                            const MacroArgs &args,
+                            std::vector<Token> *replacements);
+
     Lexer *mLexer;
     MacroSet *mMacroSet;
+    StringTable *mStrings;
     Diagnostics *mDiagnostics;
 
-    std::unique_ptr<Token> mReserveToken;
+    // Set only in the expander that owns the pool; nested expanders use their parent's.
+    std::unique_ptr<ExpansionPool> mOwnedPool;
+    ExpansionPool *mPool;
+
+    Token mReserveToken;
+    bool mHasReserveToken;
     std::vector<MacroContext *> mContextStack;
     size_t mTotalTokensInContexts;
 
@@ -11,6 +11,7 @@
 #include "compiler/preprocessor/DirectiveParser.h"
 #include "compiler/preprocessor/Macro.h"
 #include "compiler/preprocessor/MacroExpander.h"
+#include "compiler/preprocessor/StringTable.h"
 #include "compiler/preprocessor/Token.h"
 #include "compiler/preprocessor/Tokenizer.h"
 
@@ -20,6 +21,8 @@ namespace pp
 struct PreprocessorImpl
 {
     Diagnostics *diagnostics;
+    // Declared first so that it outlives every token and macro that refers to its strings.
+    StringTable strings;
     MacroSet macroSet;
     Tokenizer tokenizer;
     DirectiveParser directiveParser;
@@ -29,13 +32,18 @@ struct PreprocessorImpl
                      DirectiveHandler *directiveHandler,
                      const PreprocessorSettings &settings)
         : diagnostics(diag),
-          tokenizer(diag),
+          tokenizer(diag, &strings),
           directiveParser(&tokenizer,
                           &macroSet,
+                          &strings,
                           diag,
                           directiveHandler,
                           settings.maxMacroExpansionDepth),
-          macroExpander(&directiveParser, &macroSet, diag, settings.maxMacroExpansionDepth)
+          macroExpander(&directiveParser,
+                        &macroSet,
+                        &strings,
+                        diag,
+                        settings.maxMacroExpansionDepth)
     {
     }
 };
@@ -65,9 +73,14 @@ bool Preprocessor::init(size_t count, const char *const string[], const int leng
     return mImpl->tokenizer.init(count, string, length);
 }
 
+void Preprocessor::appendTokens(const std::vector<Token> *tokens)
+{
+    mImpl->tokenizer.appendTokens(tokens);
+}
+
 void Preprocessor::predefineMacro(const char *name, int value)
 {
-    PredefineMacro(&mImpl->macroSet, name, value);
+    PredefineMacro(&mImpl->macroSet, &mImpl->strings, name, value);
 }
 
 void Preprocessor::lex(Token *token)
@@ -86,11 +99,11 @@ void Preprocessor::lex(Token *token)
                 break;
             case Token::PP_NUMBER:
                 mImpl->diagnostics->report(Diagnostics::PP_INVALID_NUMBER, token->location,
-                                           token->text);
+                                           token->text());
                 break;
             case Token::PP_OTHER:
                 mImpl->diagnostics->report(Diagnostics::PP_INVALID_CHARACTER, token->location,
-                                           token->text);
+                                           token->text());
                 break;
             default:
                 validToken = true;
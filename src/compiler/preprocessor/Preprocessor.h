@@ -8,6 +8,7 @@
 #define COMPILER_PREPROCESSOR_PREPROCESSOR_H_
 
 #include <cstddef>
+#include <vector>
 
 #include "common/angleutils.h"
 
@@ -43,9 +44,13 @@ class Preprocessor : angle::NonCopyable
     // corresponding string or a value less than 0 to indicate that the string
     // is null terminated.
     bool init(size_t count, const char *const string[], const int length[]);
+    // Appends tokens produced by Tokenizer::TokenizeString() to the strings given to init(), as
+    // one more string that doesn't need to be tokenized again. Must be called after init().
+    void appendTokens(const std::vector<Token> *tokens);
     // Adds a pre-defined macro.
     void predefineMacro(const char *name, int value);
 
+    // The token's text belongs to the preprocessor and is only valid as long as it is.
     void lex(Token *token);
 
     // Set maximum preprocessor token size
@@ -0,0 +1,28 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+#include "compiler/preprocessor/StringTable.h"
+
+namespace pp
+{
+
+StringTable::StringTable()
+{
+}
+
+StringTable::~StringTable()
+{
+}
+
+const std::string *StringTable::intern(const std::string &text)
+{
+    if (text.empty())
+        return nullptr;
+    // Only copies the text if it isn't in the table yet.
+    return &*mStrings.insert(text).first;
+}
+
+}  // namespace pp
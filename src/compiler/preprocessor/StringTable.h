@@ -0,0 +1,37 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// StringTable.h: Stores each distinct token text once, so that tokens can refer to their text with
+// a pointer and identifiers can be compared and hashed by that pointer.
+
+#ifndef COMPILER_PREPROCESSOR_STRINGTABLE_H_
+#define COMPILER_PREPROCESSOR_STRINGTABLE_H_
+
+#include <string>
+#include <unordered_set>
+
+#include "common/angleutils.h"
+
+namespace pp
+{
+
+class StringTable : angle::NonCopyable
+{
+  public:
+    StringTable();
+    ~StringTable();
+
+    // Returns the table's copy of text, which stays valid for the lifetime of the table. Equal
+    // strings interned in the same table get the same pointer. Empty text is interned as null.
+    const std::string *intern(const std::string &text);
+
+  private:
+    // The set's nodes don't move when it grows, so the pointers it hands out stay valid.
+    std::unordered_set<std::string> mStrings;
+};
+
+}  // namespace pp
+
+#endif  // COMPILER_PREPROCESSOR_STRINGTABLE_H_
@@ -17,13 +17,14 @@ void Token::reset()
     type     = 0;
     flags    = 0;
     location = SourceLocation();
-    text.clear();
+    mText    = nullptr;
 }
 
 bool Token::equals(const Token &other) const
 {
+    // Tokens from different tables can have equal text behind different pointers.
     return (type == other.type) && (flags == other.flags) && (location == other.location) &&
-           (text == other.text);
+           (mText == other.mText || text() == other.text());
 }
 
 void Token::setAtStartOfLine(bool start)
@@ -53,19 +54,26 @@ void Token::setExpansionDisabled(bool disable)
 bool Token::iValue(int *value) const
 {
     ASSERT(type == CONST_INT);
-    return numeric_lex_int(text, value);
+    return numeric_lex_int(text(), value);
 }
 
 bool Token::uValue(unsigned int *value) const
 {
     ASSERT(type == CONST_INT);
-    return numeric_lex_int(text, value);
+    return numeric_lex_int(text(), value);
 }
 
 bool Token::fValue(float *value) const
 {
     ASSERT(type == CONST_FLOAT);
-    return numeric_lex_float(text, value);
+    return numeric_lex_float(text(), value);
+}
+
+// static
+const std::string &Token::EmptyText()
+{
+    static const std::string emptyText;
+    return emptyText;
 }
 
 std::ostream &operator<<(std::ostream &out, const Token &token)
@@ -73,7 +81,7 @@ std::ostream &operator<<(std::ostream &out, const Token &token)
     if (token.hasLeadingSpace())
         out << " ";
 
-    out << token.text;
+    out << token.text();
     return out;
 }
 
@@ -62,7 +62,7 @@ struct Token
         EXPANSION_DISABLED = 1 << 2
     };
 
-    Token() : type(0), flags(0) {}
+    Token() : type(0), flags(0), mText(nullptr) {}
 
     void reset();
     bool equals(const Token &other) const;
@@ -84,10 +84,21 @@ struct Token
     bool uValue(unsigned int *value) const;
     bool fValue(float *value) const;
 
+    // The text is interned in a StringTable, which must outlive the token. Copying a token only
+    // copies the pointer. Tokens whose text comes from the same table have equal text exactly when
+    // they have the same text pointer, which is null for empty text.
+    const std::string &text() const { return mText != nullptr ? *mText : EmptyText(); }
+    const std::string *internedText() const { return mText; }
+    void setText(const std::string *internedText) { mText = internedText; }
+
     int type;
     unsigned int flags;
     SourceLocation location;
-    std::string text;
+
+  private:
+    static const std::string &EmptyText();
+
+    const std::string *mText;
 };
 
 inline bool operator==(const Token &lhs, const Token &rhs)
@@ -722,7 +722,9 @@ IF YOU MODIFY THIS FILE YOU ALSO NEED TO RUN generate_parser.sh.
 
 #include "compiler/preprocessor/Tokenizer.h"
 
+#include "common/debug.h"
 #include "compiler/preprocessor/DiagnosticsBase.h"
+#include "compiler/preprocessor/StringTable.h"
 #include "compiler/preprocessor/Token.h"
 
 #if defined(__GNUC__)
@@ -2794,7 +2796,32 @@ void ppfree (void * ptr , yyscan_t yyscanner)
 
 namespace pp {
 
-Tokenizer::Tokenizer(Diagnostics *diagnostics) : mHandle(nullptr), mMaxTokenSize(256)
+namespace
+{
+
+// Counts the diagnostics reported while a string is tokenized ahead of time.
+class CountingDiagnostics : public Diagnostics
+{
+  public:
+    CountingDiagnostics() : count(0) {}
+
+    size_t count;
+
+  protected:
+    void print(ID id, const SourceLocation &loc, const std::string &text) override { ++count; }
+};
+
+}  // anonymous namespace
+
+Tokenizer::Tokenizer(Diagnostics *diagnostics, StringTable *strings)
+    : mHandle(nullptr),
+      mMaxTokenSize(256),
+      mStrings(strings),
+      mAppendedTokens(nullptr),
+      mNextAppendedToken(0),
+      mReplaying(false),
+      mReplayFileNumber(0),
+      mReplayLineOffset(0)
 {
     mContext.diagnostics = diagnostics;
 }
@@ -2810,11 +2837,47 @@ bool Tokenizer::init(size_t count, const char * const string[], const int length
         return false;
 
     mContext.input = Input(count, string, length);
+    mAppendedTokens = nullptr;
+    mReplaying      = false;
     return initScanner();
 }
 
+bool Tokenizer::TokenizeString(const char *string,
+                               size_t maxTokenSize,
+                               StringTable *strings,
+                               std::vector<Token> *tokens)
+{
+    CountingDiagnostics diagnostics;
+    Tokenizer tokenizer(&diagnostics, strings);
+    if (!tokenizer.init(1, &string, nullptr))
+        return false;
+    tokenizer.setMaxTokenSize(maxTokenSize);
+
+    tokens->clear();
+    Token token;
+    do
+    {
+        tokenizer.lex(&token);
+        tokens->push_back(token);
+    } while (token.type != Token::LAST);
+
+    return diagnostics.count == 0;
+}
+
+void Tokenizer::appendTokens(const std::vector<Token> *tokens)
+{
+    ASSERT(!tokens->empty() && tokens->back().type == Token::LAST);
+    mAppendedTokens    = tokens;
+    mNextAppendedToken = 0;
+}
+
 void Tokenizer::setFileNumber(int file)
 {
+    if (mReplaying)
+    {
+        mReplayFileNumber = file;
+        return;
+    }
     // We use column number as file number.
     // See macro yyfileno.
     ppset_column(file,mHandle);
@@ -2822,6 +2885,15 @@ void Tokenizer::setFileNumber(int file)
 
 void Tokenizer::setLineNumber(int line)
 {
+    if (mReplaying)
+    {
+        // Like the scanner, number the line after the directive. The directive ended with the
+        // last token that was replayed.
+        int directiveLine =
+            mNextAppendedToken > 0 ? (*mAppendedTokens)[mNextAppendedToken - 1].location.line : 1;
+        mReplayLineOffset = line - (directiveLine + 1);
+        return;
+    }
     ppset_lineno(line,mHandle);
 }
 
@@ -2832,13 +2904,32 @@ void Tokenizer::setMaxTokenSize(size_t maxTokenSize)
 
 void Tokenizer::lex(Token *token)
 {
-    token->type = pplex(&token->text,&token->location,mHandle);
-    if (token->text.size() > mMaxTokenSize)
+    if (mReplaying)
+    {
+        replayAppendedToken(token);
+        return;
+    }
+
+    token->type = pplex(&mText,&token->location,mHandle);
+    if (token->type == Token::LAST && mAppendedTokens != nullptr)
+    {
+        // The appended tokens follow as one more string, numbered the way the scanner numbers the
+        // strings it reads.
+        mReplaying        = true;
+        mReplayFileNumber = token->location.file + 1;
+        mReplayLineOffset = 0;
+        replayAppendedToken(token);
+        return;
+    }
+
+    if (mText.size() > mMaxTokenSize)
     {
         mContext.diagnostics->report(Diagnostics::PP_TOKEN_TOO_LONG,
-                                     token->location, token->text);
-        token->text.erase(mMaxTokenSize);
+                                     token->location, mText);
+        mText.erase(mMaxTokenSize);
     }
+    // The scanner reuses mText's storage, so the text is only copied the first time it is seen.
+    token->setText(mStrings->intern(mText));
 
     token->flags = 0;
 
@@ -2849,6 +2940,20 @@ void Tokenizer::lex(Token *token)
     mContext.leadingSpace = false;
 }
 
+void Tokenizer::replayAppendedToken(Token *token)
+{
+    // The tokens were checked against the maximum token size when they were tokenized. Their text
+    // is interned in the table they were tokenized with, so it is interned again in this one.
+    *token = (*mAppendedTokens)[mNextAppendedToken];
+    if (token->type != Token::LAST)
+        ++mNextAppendedToken;
+    if (token->internedText() != nullptr)
+        token->setText(mStrings->intern(*token->internedText()));
+
+    token->location.file = mReplayFileNumber;
+    token->location.line += mReplayLineOffset;
+}
+
 bool Tokenizer::initScanner()
 {
     if ((mHandle == nullptr) && pplex_init_extra(&mContext, &mHandle))
@@ -7,6 +7,9 @@
 #ifndef COMPILER_PREPROCESSOR_TOKENIZER_H_
 #define COMPILER_PREPROCESSOR_TOKENIZER_H_
 
+#include <string>
+#include <vector>
+
 #include "common/angleutils.h"
 #include "compiler/preprocessor/Input.h"
 #include "compiler/preprocessor/Lexer.h"
@@ -15,6 +18,7 @@ namespace pp
 {
 
 class Diagnostics;
+class StringTable;
 
 class Tokenizer : public Lexer
 {
@@ -33,11 +37,24 @@ class Tokenizer : public Lexer
         bool lineStart;
     };
 
-    Tokenizer(Diagnostics *diagnostics);
+    // Token text is interned in strings, which must outlive the tokens.
+    Tokenizer(Diagnostics *diagnostics, StringTable *strings);
     ~Tokenizer();
 
     bool init(size_t count, const char *const string[], const int length[]);
 
+    // Tokenizes a whole string ahead of time, so that its tokens can be appended to other strings
+    // with appendTokens(). Returns false if tokenizing reported anything, since replaying the
+    // tokens wouldn't report it again.
+    static bool TokenizeString(const char *string,
+                               size_t maxTokenSize,
+                               StringTable *strings,
+                               std::vector<Token> *tokens);
+    // Replays the tokens once the strings given to init() are exhausted, as if they were the
+    // source of one more string. Must be called after init(), and the tokens must outlive the
+    // tokenizer's use of them.
+    void appendTokens(const std::vector<Token> *tokens);
+
     void setFileNumber(int file);
     void setLineNumber(int line);
     void setMaxTokenSize(size_t maxTokenSize);
@@ -45,12 +62,22 @@ class Tokenizer : public Lexer
     void lex(Token *token) override;
 
   private:
+    void replayAppendedToken(Token *token);
     bool initScanner();
     void destroyScanner();
 
     void *mHandle;         // Scanner handle.
     Context mContext;      // Scanner extra.
     size_t mMaxTokenSize;  // Maximum token size
+    StringTable *mStrings;
+    std::string mText;  // Text of the token being scanned, before it is interned.
+
+    const std::vector<Token> *mAppendedTokens;
+    size_t mNextAppendedToken;
+    bool mReplaying;
+    // Location of the appended tokens, as changed by #line directives.
+    int mReplayFileNumber;
+    int mReplayLineOffset;
 };
 
 }  // namespace pp
@@ -0,0 +1,120 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BatchTranslator:
+//   Implementation of multi-threaded batch translation.
+//
+
+#include "compiler/translator/BatchTranslator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <thread>
+
+namespace sh
+{
+
+BatchTranslator::BatchTranslator(const ShBatchOptions &options,
+                                 const std::vector<ShBatchShader> &shaders,
+                                 std::vector<ShBatchResult> *results)
+    : mOptions(options), mShaders(shaders), mResults(results), mNextShader(0), mAllCompiled(true)
+{
+}
+
+bool BatchTranslator::run()
+{
+    mResults->assign(mShaders.size(), ShBatchResult());
+    mNextShader  = 0;
+    mAllCompiled = true;
+
+    unsigned int threadCount = getThreadCount();
+    if (threadCount <= 1)
+    {
+        translateShaders();
+        return mAllCompiled;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(&BatchTranslator::translateShaders, this);
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    return mAllCompiled;
+}
+
+void BatchTranslator::translateShaders()
+{
+    // Constructing a compiler builds its built-in symbol table, which costs more than compiling
+    // most shaders, so each thread keeps one compiler per shader type for the whole batch.
+    std::map<sh::GLenum, ShHandle> compilers;
+
+    for (size_t index = mNextShader++; index < mShaders.size(); index = mNextShader++)
+    {
+        const ShBatchShader &shader = mShaders[index];
+        ShBatchResult &result       = (*mResults)[index];
+        result.name                 = shader.name;
+
+        auto compilerIt = compilers.find(shader.type);
+        if (compilerIt == compilers.end())
+        {
+            ShHandle compiler = ShConstructCompiler(shader.type, mOptions.spec, mOptions.output,
+                                                    &mOptions.resources);
+            compilerIt = compilers.insert(std::make_pair(shader.type, compiler)).first;
+        }
+
+        ShHandle compiler = compilerIt->second;
+        if (compiler == nullptr)
+        {
+            result.success = false;
+            result.infoLog = "Unable to construct a compiler for this shader type and output.";
+            mAllCompiled   = false;
+            continue;
+        }
+
+        const char *source = shader.source.c_str();
+        auto start         = std::chrono::steady_clock::now();
+        result.success     = ShCompile(compiler, &source, 1, mOptions.compileOptions);
+        result.seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        result.infoLog = ShGetInfoLog(compiler);
+        if (result.success && (mOptions.compileOptions & SH_OBJECT_CODE))
+        {
+            result.objectCode = ShGetObjectCode(compiler);
+        }
+        if (!result.success)
+        {
+            mAllCompiled = false;
+        }
+    }
+
+    for (const auto &compiler : compilers)
+    {
+        if (compiler.second != nullptr)
+        {
+            ShDestruct(compiler.second);
+        }
+    }
+}
+
+unsigned int BatchTranslator::getThreadCount() const
+{
+    unsigned int threadCount = mOptions.threadCount;
+    if (threadCount == 0)
+    {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    return static_cast<unsigned int>(
+        std::min<size_t>(threadCount, std::max<size_t>(mShaders.size(), 1)));
+}
+
+}  // namespace sh
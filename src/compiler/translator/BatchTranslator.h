@@ -0,0 +1,50 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BatchTranslator:
+//   Translates a batch of shaders on several threads. Each thread owns its compilers, and with
+//   them their pool allocators, so the threads don't share any per-compilation state.
+//
+
+#ifndef COMPILER_TRANSLATOR_BATCHTRANSLATOR_H_
+#define COMPILER_TRANSLATOR_BATCHTRANSLATOR_H_
+
+#include <atomic>
+#include <vector>
+
+#include "GLSLANG/ShaderLang.h"
+#include "common/angleutils.h"
+
+namespace sh
+{
+
+class BatchTranslator : angle::NonCopyable
+{
+  public:
+    BatchTranslator(const ShBatchOptions &options,
+                    const std::vector<ShBatchShader> &shaders,
+                    std::vector<ShBatchResult> *results);
+
+    // Returns true if all the shaders compiled.
+    bool run();
+
+  private:
+    // Takes shaders off the shared queue until it's empty. Shaders are handed out one at a time
+    // so that a few expensive shaders don't hold up the threads that got cheap ones.
+    void translateShaders();
+
+    unsigned int getThreadCount() const;
+
+    const ShBatchOptions &mOptions;
+    const std::vector<ShBatchShader> &mShaders;
+    std::vector<ShBatchResult> *mResults;
+
+    std::atomic<size_t> mNextShader;
+    std::atomic<bool> mAllCompiled;
+};
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_BATCHTRANSLATOR_H_
@@ -6,8 +6,6 @@
 
 #include "angle_gl.h"
 #include "compiler/translator/BuiltInFunctionEmulator.h"
-#include "compiler/translator/SymbolTable.h"
-#include "compiler/translator/Cache.h"
 
 namespace sh
 {
@@ -24,8 +22,8 @@ class BuiltInFunctionEmulator::BuiltInFunctionEmulationMarker : public TIntermTr
     {
         if (visit == PreVisit)
         {
-            bool needToEmulate =
-                mEmulator.SetFunctionCalled(node->getOp(), node->getOperand()->getType());
+            bool needToEmulate = mEmulator.SetFunctionCalled(
+                FunctionId(node->getOp(), node->getOperand()->getType()));
             if (needToEmulate)
                 node->setUseEmulatedFunction();
         }
@@ -76,8 +74,8 @@ class BuiltInFunctionEmulator::BuiltInFunctionEmulationMarker : public TIntermTr
                 TIntermTyped *param2 = sequence[1]->getAsTyped();
                 if (!param1 || !param2)
                     return true;
-                needToEmulate = mEmulator.SetFunctionCalled(node->getOp(), param1->getType(),
-                                                            param2->getType());
+                needToEmulate = mEmulator.SetFunctionCalled(
+                    FunctionId(node->getOp(), param1->getType(), param2->getType()));
             }
             else if (sequence.size() == 3)
             {
@@ -86,8 +84,8 @@ class BuiltInFunctionEmulator::BuiltInFunctionEmulationMarker : public TIntermTr
                 TIntermTyped *param3 = sequence[2]->getAsTyped();
                 if (!param1 || !param2 || !param3)
                     return true;
-                needToEmulate = mEmulator.SetFunctionCalled(node->getOp(), param1->getType(),
-                                                            param2->getType(), param3->getType());
+                needToEmulate = mEmulator.SetFunctionCalled(FunctionId(
+                    node->getOp(), param1->getType(), param2->getType(), param3->getType()));
             }
             else
             {
@@ -108,50 +106,12 @@ BuiltInFunctionEmulator::BuiltInFunctionEmulator()
 {
 }
 
-BuiltInFunctionEmulator::FunctionId BuiltInFunctionEmulator::addEmulatedFunction(
-    TOperator op,
-    const TType *param,
-    const char *emulatedFunctionDefinition)
+void BuiltInFunctionEmulator::addEmulatedFunctions(const EmulatedFunction *functions, size_t count)
 {
-    FunctionId id(op, param);
-    mEmulatedFunctions[id] = std::string(emulatedFunctionDefinition);
-    return id;
-}
-
-BuiltInFunctionEmulator::FunctionId BuiltInFunctionEmulator::addEmulatedFunction(
-    TOperator op,
-    const TType *param1,
-    const TType *param2,
-    const char *emulatedFunctionDefinition)
-{
-    FunctionId id(op, param1, param2);
-    mEmulatedFunctions[id] = std::string(emulatedFunctionDefinition);
-    return id;
-}
-
-BuiltInFunctionEmulator::FunctionId BuiltInFunctionEmulator::addEmulatedFunctionWithDependency(
-    FunctionId dependency,
-    TOperator op,
-    const TType *param1,
-    const TType *param2,
-    const char *emulatedFunctionDefinition)
-{
-    FunctionId id(op, param1, param2);
-    mEmulatedFunctions[id]    = std::string(emulatedFunctionDefinition);
-    mFunctionDependencies[id] = dependency;
-    return id;
-}
-
-BuiltInFunctionEmulator::FunctionId BuiltInFunctionEmulator::addEmulatedFunction(
-    TOperator op,
-    const TType *param1,
-    const TType *param2,
-    const TType *param3,
-    const char *emulatedFunctionDefinition)
-{
-    FunctionId id(op, param1, param2, param3);
-    mEmulatedFunctions[id] = std::string(emulatedFunctionDefinition);
-    return id;
+    for (size_t index = 0; index < count; ++index)
+    {
+        mEmulatedFunctions.push_back(&functions[index]);
+    }
 }
 
 bool BuiltInFunctionEmulator::IsOutputEmpty() const
@@ -161,53 +121,43 @@ bool BuiltInFunctionEmulator::IsOutputEmpty() const
 
 void BuiltInFunctionEmulator::OutputEmulatedFunctions(TInfoSinkBase &out) const
 {
-    for (size_t i = 0; i < mFunctions.size(); ++i)
+    for (const EmulatedFunction *function : mFunctions)
     {
-        out << mEmulatedFunctions.find(mFunctions[i])->second << "\n\n";
+        out << function->definition << "\n\n";
     }
 }
 
-bool BuiltInFunctionEmulator::SetFunctionCalled(TOperator op, const TType &param)
+const BuiltInFunctionEmulator::EmulatedFunction *BuiltInFunctionEmulator::findEmulatedFunction(
+    const FunctionId &functionId) const
 {
-    return SetFunctionCalled(FunctionId(op, &param));
-}
-
-bool BuiltInFunctionEmulator::SetFunctionCalled(TOperator op,
-                                                const TType &param1,
-                                                const TType &param2)
-{
-    return SetFunctionCalled(FunctionId(op, &param1, &param2));
-}
-
-bool BuiltInFunctionEmulator::SetFunctionCalled(TOperator op,
-                                                const TType &param1,
-                                                const TType &param2,
-                                                const TType &param3)
-{
-    return SetFunctionCalled(FunctionId(op, &param1, &param2, &param3));
+    for (const EmulatedFunction *function : mEmulatedFunctions)
+    {
+        if (function->id == functionId)
+        {
+            return function;
+        }
+    }
+    return nullptr;
 }
 
 bool BuiltInFunctionEmulator::SetFunctionCalled(const FunctionId &functionId)
 {
-    if (mEmulatedFunctions.find(functionId) != mEmulatedFunctions.end())
+    const EmulatedFunction *function = findEmulatedFunction(functionId);
+    if (function == nullptr)
+    {
+        return false;
+    }
+    if (std::find(mFunctions.begin(), mFunctions.end(), function) != mFunctions.end())
     {
-        for (size_t i = 0; i < mFunctions.size(); ++i)
-        {
-            if (mFunctions[i] == functionId)
-                return true;
-        }
-        // If the function depends on another, mark the dependency as called.
-        auto dependency = mFunctionDependencies.find(functionId);
-        if (dependency != mFunctionDependencies.end())
-        {
-            SetFunctionCalled((*dependency).second);
-        }
-        // Copy the functionId if it needs to be stored, to make sure that the TType pointers inside
-        // remain valid and constant.
-        mFunctions.push_back(functionId.getCopy());
         return true;
     }
-    return false;
+    // If the function depends on another, mark the dependency as called.
+    if (function->dependency != FunctionId())
+    {
+        SetFunctionCalled(function->dependency);
+    }
+    mFunctions.push_back(function);
+    return true;
 }
 
 void BuiltInFunctionEmulator::MarkBuiltInFunctionsForEmulation(TIntermNode *root)
@@ -221,10 +171,18 @@ void BuiltInFunctionEmulator::MarkBuiltInFunctionsForEmulation(TIntermNode *root
     root->traverse(&marker);
 }
 
+TIntermTraverser *BuiltInFunctionEmulator::CreateMarker()
+{
+    if (mEmulatedFunctions.empty())
+        return nullptr;
+
+    return new BuiltInFunctionEmulationMarker(*this);
+}
+
 void BuiltInFunctionEmulator::Cleanup()
 {
+    mEmulatedFunctions.clear();
     mFunctions.clear();
-    mFunctionDependencies.clear();
 }
 
 // static
@@ -234,58 +192,38 @@ TString BuiltInFunctionEmulator::GetEmulatedFunctionName(const TString &name)
     return "webgl_" + name.substr(0, name.length() - 1) + "_emu(";
 }
 
-BuiltInFunctionEmulator::FunctionId::FunctionId()
-    : mOp(EOpNull),
-      mParam1(TCache::getType(EbtVoid)),
-      mParam2(TCache::getType(EbtVoid)),
-      mParam3(TCache::getType(EbtVoid))
-{
-}
-
-BuiltInFunctionEmulator::FunctionId::FunctionId(TOperator op, const TType *param)
-    : mOp(op), mParam1(param), mParam2(TCache::getType(EbtVoid)), mParam3(TCache::getType(EbtVoid))
+BuiltInFunctionEmulator::FunctionId::FunctionId(TOperator op, const TType &param)
+    : mKey(Pack(op, GetParamKey(param), GetParamKey(ParamType(EbtVoid)),
+                GetParamKey(ParamType(EbtVoid))))
 {
 }
 
 BuiltInFunctionEmulator::FunctionId::FunctionId(TOperator op,
-                                                const TType *param1,
-                                                const TType *param2)
-    : mOp(op), mParam1(param1), mParam2(param2), mParam3(TCache::getType(EbtVoid))
+                                                const TType &param1,
+                                                const TType &param2)
+    : mKey(Pack(op, GetParamKey(param1), GetParamKey(param2), GetParamKey(ParamType(EbtVoid))))
 {
 }
 
 BuiltInFunctionEmulator::FunctionId::FunctionId(TOperator op,
-                                                const TType *param1,
-                                                const TType *param2,
-                                                const TType *param3)
-    : mOp(op), mParam1(param1), mParam2(param2), mParam3(param3)
-{
-}
-
-bool BuiltInFunctionEmulator::FunctionId::operator==(
-    const BuiltInFunctionEmulator::FunctionId &other) const
-{
-    return (mOp == other.mOp && *mParam1 == *other.mParam1 && *mParam2 == *other.mParam2 &&
-            *mParam3 == *other.mParam3);
-}
-
-bool BuiltInFunctionEmulator::FunctionId::operator<(
-    const BuiltInFunctionEmulator::FunctionId &other) const
+                                                const TType &param1,
+                                                const TType &param2,
+                                                const TType &param3)
+    : mKey(Pack(op, GetParamKey(param1), GetParamKey(param2), GetParamKey(param3)))
 {
-    if (mOp != other.mOp)
-        return mOp < other.mOp;
-    if (*mParam1 != *other.mParam1)
-        return *mParam1 < *other.mParam1;
-    if (*mParam2 != *other.mParam2)
-        return *mParam2 < *other.mParam2;
-    if (*mParam3 != *other.mParam3)
-        return *mParam3 < *other.mParam3;
-    return false;  // all fields are equal
 }
 
-BuiltInFunctionEmulator::FunctionId BuiltInFunctionEmulator::FunctionId::getCopy() const
+// static
+uint64_t BuiltInFunctionEmulator::FunctionId::GetParamKey(const TType &param)
 {
-    return FunctionId(mOp, new TType(*mParam1), new TType(*mParam2), new TType(*mParam3));
+    if (param.isArray() || param.getStruct() != nullptr)
+    {
+        // Not the key of any parameter type.
+        return 0xFFFFu;
+    }
+    return GetParamKey(ParamType(param.getBasicType(),
+                                 static_cast<unsigned char>(param.getNominalSize()),
+                                 static_cast<unsigned char>(param.getSecondarySize())));
 }
 
 }  // namespace sh
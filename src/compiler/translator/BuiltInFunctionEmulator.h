@@ -25,6 +25,13 @@ class BuiltInFunctionEmulator
 
     void MarkBuiltInFunctionsForEmulation(TIntermNode *root);
 
+    // Returns a traverser that does the marking, so that it can share a traversal with other
+    // passes, or null if there is nothing to emulate. It is allocated from the pool allocator of
+    // the current compilation.
+    TIntermTraverser *CreateMarker();
+
+    // Forgets the added and the called functions, so that the emulator can be set up for another
+    // compilation.
     void Cleanup();
 
     // "name(" becomes "webgl_name_emu(".
@@ -35,52 +42,78 @@ class BuiltInFunctionEmulator
     // Output function emulation definition. This should be before any other shader source.
     void OutputEmulatedFunctions(TInfoSinkBase &out) const;
 
+    // The type of a parameter of an emulated function: a scalar, vector or matrix that is not an
+    // array.
+    struct ParamType
+    {
+        constexpr ParamType(TBasicType typeIn,
+                            unsigned char primarySizeIn   = 1,
+                            unsigned char secondarySizeIn = 1)
+            : type(typeIn), primarySize(primarySizeIn), secondarySize(secondarySizeIn)
+        {
+        }
+
+        TBasicType type;
+        unsigned char primarySize;
+        unsigned char secondarySize;
+    };
+
+    // Identifies a built-in function by its operator and the types of up to three parameters,
+    // packed into a single integer so that looking up a call is a few integer comparisons.
     class FunctionId
     {
       public:
-        FunctionId();
-        FunctionId(TOperator op, const TType *param);
-        FunctionId(TOperator op, const TType *param1, const TType *param2);
-        FunctionId(TOperator op, const TType *param1, const TType *param2, const TType *param3);
-
-        FunctionId(const FunctionId &) = default;
-        FunctionId &operator=(const FunctionId &) = default;
-
-        bool operator==(const FunctionId &other) const;
-        bool operator<(const FunctionId &other) const;
-
-        FunctionId getCopy() const;
+        constexpr FunctionId() : mKey(0) {}
+        constexpr FunctionId(TOperator op,
+                             ParamType param1,
+                             ParamType param2 = ParamType(EbtVoid),
+                             ParamType param3 = ParamType(EbtVoid))
+            : mKey(Pack(op, GetParamKey(param1), GetParamKey(param2), GetParamKey(param3)))
+        {
+        }
+
+        // Ids of calls that take arrays or structs match no emulated function.
+        FunctionId(TOperator op, const TType &param);
+        FunctionId(TOperator op, const TType &param1, const TType &param2);
+        FunctionId(TOperator op, const TType &param1, const TType &param2, const TType &param3);
+
+        bool operator==(const FunctionId &other) const { return mKey == other.mKey; }
+        bool operator!=(const FunctionId &other) const { return mKey != other.mKey; }
 
       private:
-        TOperator mOp;
-
-        // The memory that these TType objects use is freed by PoolAllocator. The
-        // BuiltInFunctionEmulator's lifetime can extend until after the memory pool is freed, but
-        // that's not an issue since this class never destructs these objects.
-        const TType *mParam1;
-        const TType *mParam2;
-        const TType *mParam3;
+        static constexpr uint64_t Pack(TOperator op,
+                                       uint64_t param1,
+                                       uint64_t param2,
+                                       uint64_t param3)
+        {
+            return static_cast<uint64_t>(op) | (param1 << 16) | (param2 << 32) | (param3 << 48);
+        }
+        static constexpr uint64_t GetParamKey(ParamType param)
+        {
+            return static_cast<uint64_t>(param.type) | (param.primarySize << 8) |
+                   (param.secondarySize << 12);
+        }
+        static uint64_t GetParamKey(const TType &param);
+
+        uint64_t mKey;
+    };
+
+    struct EmulatedFunction
+    {
+        FunctionId id;
+        // The emulated function that this one calls, or a null id.
+        FunctionId dependency;
+        const char *definition;
     };
 
-    // Add functions that need to be emulated.
-    FunctionId addEmulatedFunction(TOperator op,
-                                   const TType *param,
-                                   const char *emulatedFunctionDefinition);
-    FunctionId addEmulatedFunction(TOperator op,
-                                   const TType *param1,
-                                   const TType *param2,
-                                   const char *emulatedFunctionDefinition);
-    FunctionId addEmulatedFunction(TOperator op,
-                                   const TType *param1,
-                                   const TType *param2,
-                                   const TType *param3,
-                                   const char *emulatedFunctionDefinition);
-
-    FunctionId addEmulatedFunctionWithDependency(FunctionId dependency,
-                                                 TOperator op,
-                                                 const TType *param1,
-                                                 const TType *param2,
-                                                 const char *emulatedFunctionDefinition);
+    // Add functions that need to be emulated. The tables are generated into static storage by
+    // gen_emulated_builtin_function_tables.py, and they are not copied.
+    void addEmulatedFunctions(const EmulatedFunction *functions, size_t count);
+    template <size_t N>
+    void addEmulatedFunctions(const EmulatedFunction (&functions)[N])
+    {
+        addEmulatedFunctions(functions, N);
+    }
 
   private:
     class BuiltInFunctionEmulationMarker;
@@ -88,24 +121,15 @@ class BuiltInFunctionEmulator
     // Records that a function is called by the shader and might need to be emulated. If the
     // function is not in mEmulatedFunctions, this becomes a no-op. Returns true if the function
     // call needs to be replaced with an emulated one.
-    bool SetFunctionCalled(TOperator op, const TType &param);
-    bool SetFunctionCalled(TOperator op, const TType &param1, const TType &param2);
-    bool SetFunctionCalled(TOperator op,
-                           const TType &param1,
-                           const TType &param2,
-                           const TType &param3);
-
     bool SetFunctionCalled(const FunctionId &functionId);
 
-    // Map from function id to emulated function definition
-    std::map<FunctionId, std::string> mEmulatedFunctions;
+    const EmulatedFunction *findEmulatedFunction(const FunctionId &functionId) const;
 
-    // Map from dependent functions to their dependencies. This structure allows each function to
-    // have at most one dependency.
-    std::map<FunctionId, FunctionId> mFunctionDependencies;
+    // The functions that can be emulated in this compilation.
+    std::vector<const EmulatedFunction *> mEmulatedFunctions;
 
-    // Called function ids
-    std::vector<FunctionId> mFunctions;
+    // Called functions, in the order that their definitions are output.
+    std::vector<const EmulatedFunction *> mFunctions;
 };
 
 }  // namespace sh
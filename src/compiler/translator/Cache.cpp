@@ -15,24 +15,6 @@
 namespace sh
 {
 
-namespace
-{
-
-class TScopedAllocator : angle::NonCopyable
-{
-  public:
-    TScopedAllocator(TPoolAllocator *allocator) : mPreviousAllocator(GetGlobalPoolAllocator())
-    {
-        SetGlobalPoolAllocator(allocator);
-    }
-    ~TScopedAllocator() { SetGlobalPoolAllocator(mPreviousAllocator); }
-
-  private:
-    TPoolAllocator *mPreviousAllocator;
-};
-
-}  // namespace
-
 TCache::TypeKey::TypeKey(TBasicType basicType,
                          TPrecision precision,
                          TQualifier qualifier,
@@ -57,6 +39,15 @@ TCache::TypeKey::TypeKey(TBasicType basicType,
 
 TCache *TCache::sCache = nullptr;
 
+TCache::TCache() : mTableCount(0)
+{
+    for (TableEntry &entry : mTable)
+    {
+        entry.key.store(0, std::memory_order_relaxed);
+        entry.type.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
 void TCache::initialize()
 {
     if (sCache == nullptr)
@@ -77,19 +68,84 @@ const TType *TCache::getType(TBasicType basicType,
                              unsigned char secondarySize)
 {
     TypeKey key(basicType, precision, qualifier, primarySize, secondarySize);
+    const TType *cachedType = sCache->findType(key);
+    if (cachedType)
+    {
+        return cachedType;
+    }
+
+    std::lock_guard<std::mutex> lock(sCache->mMutex);
     auto it = sCache->mTypes.find(key);
     if (it != sCache->mTypes.end())
     {
         return it->second;
     }
 
-    TScopedAllocator scopedAllocator(&sCache->mAllocator);
+    TScopedGlobalPoolAllocator scopedAllocator(&sCache->mAllocator);
 
     TType *type = new TType(basicType, precision, qualifier, primarySize, secondarySize);
     type->realize();
     sCache->mTypes.insert(std::make_pair(key, type));
+    sCache->addToTable(key, type);
 
     return type;
 }
 
+const TType *TCache::getCanonicalType(const TType &type)
+{
+    if (sCache == nullptr || type.isArray() || type.getStruct() || type.getInterfaceBlock() ||
+        type.isInvariant() || !type.getLayoutQualifier().isEmpty() ||
+        type.getLayoutQualifier().locationsSpecified != 0 || !type.getMemoryQualifier().isEmpty())
+    {
+        return nullptr;
+    }
+    return getType(type.getBasicType(), type.getPrecision(), type.getQualifier(),
+                   static_cast<unsigned char>(type.getNominalSize()),
+                   static_cast<unsigned char>(type.getSecondarySize()));
+}
+
+// static
+size_t TCache::GetTableIndex(const TypeKey &key)
+{
+    // Fibonacci hashing: the top bits of the product depend on all the bits of the key.
+    return static_cast<size_t>((key.value * UINT64_C(0x9E3779B97F4A7C15)) >>
+                               (64 - kTableSizeLog2));
+}
+
+const TType *TCache::findType(const TypeKey &key) const
+{
+    const uint64_t storedKey = key.value | kKeyPresent;
+    // The table is never more than three quarters full, so the probe always ends.
+    for (size_t index = GetTableIndex(key);; index = (index + 1) % kTableSize)
+    {
+        uint64_t entryKey = mTable[index].key.load(std::memory_order_acquire);
+        if (entryKey == storedKey)
+        {
+            return mTable[index].type.load(std::memory_order_relaxed);
+        }
+        if (entryKey == 0)
+        {
+            return nullptr;
+        }
+    }
+}
+
+void TCache::addToTable(const TypeKey &key, const TType *type)
+{
+    // Types that don't fit are still found in mTypes.
+    if (mTableCount >= kTableSize * 3 / 4)
+    {
+        return;
+    }
+    ++mTableCount;
+
+    size_t index = GetTableIndex(key);
+    while (mTable[index].key.load(std::memory_order_relaxed) != 0)
+    {
+        index = (index + 1) % kTableSize;
+    }
+    mTable[index].type.store(type, std::memory_order_relaxed);
+    mTable[index].key.store(key.value | kKeyPresent, std::memory_order_release);
+}
+
 }  // namespace sh
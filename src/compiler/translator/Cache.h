@@ -11,7 +11,9 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <atomic>
 #include <map>
+#include <mutex>
 
 #include "compiler/translator/Types.h"
 #include "compiler/translator/PoolAlloc.h"
@@ -48,8 +50,13 @@ class TCache
                                 unsigned char primarySize,
                                 unsigned char secondarySize);
 
+    // Returns the cached copy of a type, or nullptr if the type is an array, a structure or an
+    // interface block, has layout or memory qualifiers or is invariant: only the types that the
+    // other getType() functions create are cached. Also returns nullptr before initialize().
+    static const TType *getCanonicalType(const TType &type);
+
   private:
-    TCache() {}
+    TCache();
 
     union TypeKey {
         TypeKey(TBasicType basicType,
@@ -73,6 +80,28 @@ class TCache
     };
     typedef std::map<TypeKey, const TType *> TypeMap;
 
+    static size_t GetTableIndex(const TypeKey &key);
+    // Finds a type in mTable without taking the mutex.
+    const TType *findType(const TypeKey &key) const;
+    void addToTable(const TypeKey &key, const TType *type);
+
+    // Every node of every tree points to a type from the cache, so lookups mustn't contend. Most
+    // of them are served from this open-addressed copy of mTypes, which is read without taking
+    // the mutex. Entries are only ever added, under the mutex, and an entry's key is published
+    // after its type. Keys are stored with kKeyPresent set so that zero marks an empty entry.
+    static const size_t kTableSizeLog2 = 10;
+    static const size_t kTableSize     = 1 << kTableSizeLog2;
+    static const uint64_t kKeyPresent  = UINT64_C(1) << 63;
+    struct TableEntry
+    {
+        std::atomic<uint64_t> key;
+        std::atomic<const TType *> type;
+    };
+    TableEntry mTable[kTableSize];
+    size_t mTableCount;
+
+    // The cache is shared by compilers running on different threads.
+    std::mutex mMutex;
     TypeMap mTypes;
     TPoolAllocator mAllocator;
 
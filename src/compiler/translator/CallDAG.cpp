@@ -322,6 +322,8 @@ CallDAG::InitResult CallDAG::init(TIntermNode *root, TInfoSinkBase *info)
 {
     ASSERT(info);
 
+    // The creator's names and worklists are only needed until the records are filled in.
+    TScopedPoolRewind scopedRewind(GetGlobalPoolAllocator());
     CallDAGCreator creator(info);
 
     // Creates the mapping of functions to callees
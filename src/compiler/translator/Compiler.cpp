@@ -6,7 +6,9 @@
 
 #include "compiler/translator/Compiler.h"
 
+#include <chrono>
 #include <sstream>
+#include <utility>
 
 #include "angle_gl.h"
 #include "common/utilities.h"
@@ -17,9 +19,10 @@
 #include "compiler/translator/EmulateGLFragColorBroadcast.h"
 #include "compiler/translator/EmulatePrecision.h"
 #include "compiler/translator/Initialize.h"
-#include "compiler/translator/InitializeParseContext.h"
 #include "compiler/translator/InitializeVariables.h"
+#include "compiler/translator/OptimizeOutput.h"
 #include "compiler/translator/ParseContext.h"
+#include "compiler/translator/PassManager.h"
 #include "compiler/translator/PruneEmptyDeclarations.h"
 #include "compiler/translator/RegenerateStructNames.h"
 #include "compiler/translator/RemoveInvariantDeclaration.h"
@@ -32,6 +35,10 @@
 #include "compiler/translator/ValidateMaxParameters.h"
 #include "compiler/translator/ValidateOutputs.h"
 #include "compiler/translator/VariablePacker.h"
+#include "compiler/translator/length_limits.h"
+#include "compiler/preprocessor/DiagnosticsBase.h"
+#include "compiler/preprocessor/DirectiveHandlerBase.h"
+#include "compiler/preprocessor/Token.h"
 #include "third_party/compiler/ArrayBoundsClamper.h"
 
 namespace sh
@@ -73,6 +80,86 @@ void DumpFuzzerCase(char const *const *shaderStrings,
     fclose(f);
 }
 #endif  // defined(ANGLE_ENABLE_FUZZER_CORPUS_OUTPUT)
+
+// Writes out the output of the preprocessor, including its diagnostics and the directives it hands
+// on, so that two preprocessed sources can be compared.
+class PreprocessorOutputWriter : public pp::Diagnostics, public pp::DirectiveHandler
+{
+  public:
+    PreprocessorOutputWriter(std::string *output) : mOutput(output) {}
+
+    void writeToken(const pp::Token &token)
+    {
+        writeInt(token.type);
+        writeLocation(token.location);
+        writeString(token.text());
+    }
+
+    void handleError(const pp::SourceLocation &loc, const std::string &msg) override
+    {
+        writeEvent('E', loc);
+        writeString(msg);
+    }
+
+    void handlePragma(const pp::SourceLocation &loc,
+                      const std::string &name,
+                      const std::string &value,
+                      bool stdgl) override
+    {
+        writeEvent('P', loc);
+        writeString(name);
+        writeString(value);
+        writeInt(stdgl);
+    }
+
+    void handleExtension(const pp::SourceLocation &loc,
+                         const std::string &name,
+                         const std::string &behavior) override
+    {
+        writeEvent('X', loc);
+        writeString(name);
+        writeString(behavior);
+    }
+
+    void handleVersion(const pp::SourceLocation &loc, int version) override
+    {
+        writeEvent('V', loc);
+        writeInt(version);
+    }
+
+  protected:
+    void print(ID id, const pp::SourceLocation &loc, const std::string &text) override
+    {
+        writeEvent('D', loc);
+        writeInt(id);
+        writeString(text);
+    }
+
+  private:
+    // Events are told apart from tokens by a negative type.
+    void writeEvent(char event, const pp::SourceLocation &loc)
+    {
+        writeInt(-event);
+        writeLocation(loc);
+    }
+    void writeLocation(const pp::SourceLocation &loc)
+    {
+        writeInt(loc.file);
+        writeInt(loc.line);
+    }
+    void writeInt(int value)
+    {
+        mOutput->append(reinterpret_cast<const char *>(&value), sizeof(int));
+    }
+    void writeString(const std::string &value)
+    {
+        writeInt(static_cast<int>(value.size()));
+        mOutput->append(value);
+    }
+
+    std::string *mOutput;
+};
+
 }  // anonymous namespace
 
 bool IsWebGLBasedSpec(ShShaderSpec spec)
@@ -137,19 +224,15 @@ namespace
 class TScopedPoolAllocator
 {
   public:
-    TScopedPoolAllocator(TPoolAllocator *allocator) : mAllocator(allocator)
+    TScopedPoolAllocator(TPoolAllocator *allocator) : mAllocator(allocator), mBinding(allocator)
     {
         mAllocator->push();
-        SetGlobalPoolAllocator(mAllocator);
-    }
-    ~TScopedPoolAllocator()
-    {
-        SetGlobalPoolAllocator(NULL);
-        mAllocator->pop();
     }
+    ~TScopedPoolAllocator() { mAllocator->pop(); }
 
   private:
     TPoolAllocator *mAllocator;
+    TScopedGlobalPoolAllocator mBinding;
 };
 
 class TScopedSymbolTableLevel
@@ -170,6 +253,83 @@ class TScopedSymbolTableLevel
     TSymbolTable *mTable;
 };
 
+// Counts every node of the tree, and the bytes that the nodes, their child lists and the types
+// that they don't share through the cache take up.
+class CountNodesTraverser : public TIntermTraverser
+{
+  public:
+    CountNodesTraverser() : TIntermTraverser(true, false, false), mCount(0), mBytes(0) {}
+
+    void visitSymbol(TIntermSymbol *node) override { countTyped(node); }
+    void visitRaw(TIntermRaw *node) override { countTyped(node); }
+    void visitConstantUnion(TIntermConstantUnion *node) override
+    {
+        countTyped(node);
+        mBytes += node->getType().getObjectSize() * sizeof(TConstantUnion);
+    }
+    bool visitSwizzle(Visit visit, TIntermSwizzle *node) override { return countTyped(node); }
+    bool visitBinary(Visit visit, TIntermBinary *node) override { return countTyped(node); }
+    bool visitUnary(Visit visit, TIntermUnary *node) override { return countTyped(node); }
+    bool visitTernary(Visit visit, TIntermTernary *node) override { return countTyped(node); }
+    bool visitIfElse(Visit visit, TIntermIfElse *node) override { return count(node); }
+    bool visitSwitch(Visit visit, TIntermSwitch *node) override { return count(node); }
+    bool visitCase(Visit visit, TIntermCase *node) override { return count(node); }
+    bool visitFunctionDefinition(Visit visit, TIntermFunctionDefinition *node) override
+    {
+        return countTyped(node);
+    }
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override
+    {
+        return countSequence(node) && countTyped(node);
+    }
+    bool visitBlock(Visit visit, TIntermBlock *node) override
+    {
+        return countSequence(node) && count(node);
+    }
+    bool visitInvariantDeclaration(Visit visit, TIntermInvariantDeclaration *node) override
+    {
+        return count(node);
+    }
+    bool visitDeclaration(Visit visit, TIntermDeclaration *node) override
+    {
+        return countSequence(node) && count(node);
+    }
+    bool visitLoop(Visit visit, TIntermLoop *node) override { return count(node); }
+    bool visitBranch(Visit visit, TIntermBranch *node) override { return count(node); }
+
+    size_t getCount() const { return mCount; }
+    size_t getBytes() const { return mBytes; }
+
+  private:
+    template <typename T>
+    bool count(T *node)
+    {
+        ++mCount;
+        mBytes += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool countTyped(T *node)
+    {
+        // Copies of a node share its type, so this overestimates a little.
+        if (TCache::getCanonicalType(node->getType()) != &node->getType())
+        {
+            mBytes += sizeof(TType);
+        }
+        return count(node);
+    }
+
+    bool countSequence(TIntermAggregateBase *node)
+    {
+        mBytes += node->getSequence()->capacity() * sizeof(TIntermNode *);
+        return true;
+    }
+
+    size_t mCount;
+    size_t mBytes;
+};
+
 int MapSpecToShaderVersion(ShShaderSpec spec)
 {
     switch (spec)
@@ -194,12 +354,10 @@ int MapSpecToShaderVersion(ShShaderSpec spec)
 TShHandleBase::TShHandleBase()
 {
     allocator.push();
-    SetGlobalPoolAllocator(&allocator);
 }
 
 TShHandleBase::~TShHandleBase()
 {
-    SetGlobalPoolAllocator(NULL);
     allocator.popAll();
 }
 
@@ -217,7 +375,9 @@ TCompiler::TCompiler(sh::GLenum type, ShShaderSpec spec, ShShaderOutput output)
       builtInFunctionEmulator(),
       mSourcePath(NULL),
       mComputeShaderLocalSizeDeclared(false),
-      mTemporaryIndex(0)
+      mTemporaryIndex(0),
+      mCompileStatistics(),
+      mCompileStatisticsCollected(false)
 {
     mComputeShaderLocalSize.fill(1);
 }
@@ -244,7 +404,9 @@ bool TCompiler::Init(const ShBuiltInResources &resources)
     maxCallStackDepth       = resources.MaxCallStackDepth;
     maxFunctionParameters   = resources.MaxFunctionParameters;
 
-    SetGlobalPoolAllocator(&allocator);
+    // The pool is only current while the compiler is in use, so a compiler can be built on one
+    // thread and used on another.
+    TScopedGlobalPoolAllocator scopedAlloc(&allocator);
 
     // Generate built-in symbol table.
     if (!InitBuiltInSymbolTable(resources))
@@ -264,17 +426,20 @@ TIntermBlock *TCompiler::compileTreeForTesting(const char *const shaderStrings[]
                                                size_t numStrings,
                                                ShCompileOptions compileOptions)
 {
-    return compileTreeImpl(shaderStrings, numStrings, compileOptions);
+    // The tree is left in the compiler's pool so that tests can inspect it.
+    TScopedGlobalPoolAllocator scopedAlloc(&allocator);
+    return compileTreeImpl(shaderStrings, numStrings, nullptr, compileOptions);
 }
 
 TIntermBlock *TCompiler::compileTreeImpl(const char *const shaderStrings[],
                                          size_t numStrings,
+                                         const std::vector<pp::Token> *appendedTokens,
                                          const ShCompileOptions compileOptions)
 {
     clearResults();
 
     ASSERT(numStrings > 0);
-    ASSERT(GetGlobalPoolAllocator());
+    ASSERT(GetGlobalPoolAllocator() == &allocator);
 
     // Reset the extension behavior for each compilation unit.
     ResetExtensionBehavior(extensionBehavior);
@@ -291,16 +456,19 @@ TIntermBlock *TCompiler::compileTreeImpl(const char *const shaderStrings[],
                                compileOptions, true, infoSink, getResources());
 
     parseContext.setFragmentPrecisionHighOnESSL1(fragmentPrecisionHigh);
-    SetGlobalParseContext(&parseContext);
 
     // We preserve symbols at the built-in level from compile-to-compile.
     // Start pushing the user-defined symbols at global level.
     TScopedSymbolTableLevel scopedSymbolLevel(&symbolTable);
 
     // Parse shader.
-    bool success = (PaParseStrings(numStrings - firstSource, &shaderStrings[firstSource], nullptr,
-                                   &parseContext) == 0) &&
-                   (parseContext.getTreeRoot() != nullptr);
+    bool success = false;
+    {
+        PassManager::ScopedTimer timer(&mPassManager, "Parse");
+        success = (PaParseStrings(numStrings - firstSource, &shaderStrings[firstSource], nullptr,
+                                  appendedTokens, &parseContext) == 0) &&
+                  (parseContext.getTreeRoot() != nullptr);
+    }
 
     shaderVersion = parseContext.getShaderVersion();
     if (success && MapSpecToShaderVersion(shaderSpec) < shaderVersion)
@@ -327,11 +495,17 @@ TIntermBlock *TCompiler::compileTreeImpl(const char *const shaderStrings[],
 
         // Disallow expressions deemed too complex.
         if (success && (compileOptions & SH_LIMIT_EXPRESSION_COMPLEXITY))
+        {
+            PassManager::ScopedTimer timer(&mPassManager, "LimitExpressionComplexity");
             success = limitExpressionComplexity(root);
+        }
 
         // Create the function DAG and check there is no recursion
         if (success)
+        {
+            PassManager::ScopedTimer timer(&mPassManager, "InitCallDag");
             success = initCallDag(root);
+        }
 
         if (success && (compileOptions & SH_LIMIT_CALL_STACK_DEPTH))
             success = checkCallDepth();
@@ -345,44 +519,21 @@ TIntermBlock *TCompiler::compileTreeImpl(const char *const shaderStrings[],
         }
 
         if (success && !(compileOptions & SH_DONT_PRUNE_UNUSED_FUNCTIONS))
+        {
+            PassManager::ScopedTimer timer(&mPassManager, "PruneUnusedFunctions");
             success = pruneUnusedFunctions(root);
+        }
 
         // Prune empty declarations to work around driver bugs and to keep declaration output
         // simple.
         if (success)
-            PruneEmptyDeclarations(root);
-
-        if (success && shaderVersion == 300 && shaderType == GL_FRAGMENT_SHADER)
-            success = validateOutputs(root);
-
-        if (success && shouldRunLoopAndIndexingValidation(compileOptions))
-            success = validateLimitations(root);
-
-        // Fail compilation if precision emulation not supported.
-        if (success && getResources().WEBGL_debug_shader_precision &&
-            getPragma().debugShaderPrecision)
         {
-            if (!EmulatePrecision::SupportedInLanguage(outputType))
-            {
-                infoSink.info.prefix(EPrefixError);
-                infoSink.info << "Precision emulation not supported for this output type.";
-                success = false;
-            }
+            PassManager::ScopedTimer timer(&mPassManager, "PruneEmptyDeclarations");
+            PruneEmptyDeclarations(root);
         }
 
-        // Built-in function emulation needs to happen after validateLimitations pass.
         if (success)
-        {
-            // TODO(jmadill): Remove global pool allocator.
-            GetGlobalPoolAllocator()->lock();
-            initBuiltInFunctionEmulator(&builtInFunctionEmulator, compileOptions);
-            GetGlobalPoolAllocator()->unlock();
-            builtInFunctionEmulator.MarkBuiltInFunctionsForEmulation(root);
-        }
-
-        // Clamping uniform array bounds needs to happen after validateLimitations pass.
-        if (success && (compileOptions & SH_CLAMP_INDIRECT_ARRAY_BOUNDS))
-            arrayBoundsClamper.MarkIndirectArrayBoundsForClamping(root);
+            success = validateAndMarkTree(root, compileOptions);
 
         // gl_Position is always written in compatibility output mode
         if (success && shaderType == GL_VERTEX_SHADER &&
@@ -391,17 +542,27 @@ TIntermBlock *TCompiler::compileTreeImpl(const char *const shaderStrings[],
             initializeGLPosition(root);
 
         if (success && RemoveInvariant(shaderType, shaderVersion, outputType, compileOptions))
+        {
+            PassManager::ScopedTimer timer(&mPassManager, "RemoveInvariantDeclaration");
             sh::RemoveInvariantDeclaration(root);
+        }
 
         // This pass might emit short circuits so keep it before the short circuit unfolding
         if (success && (compileOptions & SH_REWRITE_DO_WHILE_LOOPS))
+        {
+            PassManager::ScopedTimer timer(&mPassManager, "RewriteDoWhile");
             RewriteDoWhile(root, getTemporaryIndex());
+        }
 
         if (success && (compileOptions & SH_ADD_AND_TRUE_TO_LOOP_CONDITION))
+        {
+            PassManager::ScopedTimer timer(&mPassManager, "AddAndTrueToLoopCondition");
             sh::AddAndTrueToLoopCondition(root);
+        }
 
         if (success && (compileOptions & SH_UNFOLD_SHORT_CIRCUIT))
         {
+            PassManager::ScopedTimer timer(&mPassManager, "UnfoldShortCircuitAST");
             UnfoldShortCircuitAST unfoldShortCircuit;
             root->traverse(&unfoldShortCircuit);
             unfoldShortCircuit.updateTree();
@@ -409,18 +570,29 @@ TIntermBlock *TCompiler::compileTreeImpl(const char *const shaderStrings[],
 
         if (success && (compileOptions & SH_REMOVE_POW_WITH_CONSTANT_EXPONENT))
         {
+            PassManager::ScopedTimer timer(&mPassManager, "RemovePow");
             RemovePow(root);
         }
 
+        if (success && (compileOptions & SH_OPTIMIZE_OUTPUT))
+        {
+            PassManager::ScopedTimer timer(&mPassManager, "OptimizeOutput");
+            OptimizeOutput(root, symbolTable, shaderVersion, &mTemporaryIndex);
+        }
+
         if (success && shouldCollectVariables(compileOptions))
         {
-            collectVariables(root);
+            {
+                PassManager::ScopedTimer timer(&mPassManager, "CollectVariables");
+                collectVariables(root);
+            }
             if (compileOptions & SH_USE_UNUSED_STANDARD_SHARED_BLOCKS)
             {
                 useAllMembersInUnusedStandardAndSharedBlocks(root);
             }
             if (compileOptions & SH_ENFORCE_PACKING_RESTRICTIONS)
             {
+                PassManager::ScopedTimer timer(&mPassManager, "EnforcePackingRestrictions");
                 success = enforcePackingRestrictions();
                 if (!success)
                 {
@@ -436,12 +608,14 @@ TIntermBlock *TCompiler::compileTreeImpl(const char *const shaderStrings[],
 
         if (success && (compileOptions & SH_SCALARIZE_VEC_AND_MAT_CONSTRUCTOR_ARGS))
         {
+            PassManager::ScopedTimer timer(&mPassManager, "ScalarizeVecAndMatConstructorArgs");
             ScalarizeVecAndMatConstructorArgs(root, shaderType, fragmentPrecisionHigh,
                                               &mTemporaryIndex);
         }
 
         if (success && (compileOptions & SH_REGENERATE_STRUCT_NAMES))
         {
+            PassManager::ScopedTimer timer(&mPassManager, "RegenerateStructNames");
             RegenerateStructNames gen(symbolTable, shaderVersion);
             root->traverse(&gen);
         }
@@ -450,16 +624,20 @@ TIntermBlock *TCompiler::compileTreeImpl(const char *const shaderStrings[],
             compileResources.EXT_draw_buffers && compileResources.MaxDrawBuffers > 1 &&
             IsExtensionEnabled(extensionBehavior, "GL_EXT_draw_buffers"))
         {
-            EmulateGLFragColorBroadcast(root, compileResources.MaxDrawBuffers, &outputVariables);
+            EmulateGLFragColorBroadcast(root, compileResources.MaxDrawBuffers, &mReflection);
+            clearVariableLists();
         }
 
         if (success)
         {
+            PassManager::ScopedTimer timer(&mPassManager, "DeferGlobalInitializers");
             DeferGlobalInitializers(root);
         }
+
+        if (success && (compileOptions & SH_COLLECT_COMPILE_STATISTICS))
+            collectTreeStatistics(root);
     }
 
-    SetGlobalParseContext(NULL);
     if (success)
         return root;
 
@@ -468,7 +646,56 @@ TIntermBlock *TCompiler::compileTreeImpl(const char *const shaderStrings[],
 
 bool TCompiler::compile(const char *const shaderStrings[],
                         size_t numStrings,
-                        ShCompileOptions compileOptionsIn)
+                        ShCompileOptions compileOptions)
+{
+    return compileImpl(shaderStrings, numStrings, nullptr, compileOptions);
+}
+
+bool TCompiler::compile(const char *const shaderStrings[],
+                        size_t numStrings,
+                        const std::vector<pp::Token> &appendedTokens,
+                        ShCompileOptions compileOptions)
+{
+    return compileImpl(shaderStrings, numStrings, &appendedTokens, compileOptions);
+}
+
+void TCompiler::preprocess(const char *const shaderStrings[],
+                           size_t numStrings,
+                           const std::vector<pp::Token> *appendedTokens,
+                           std::string *output)
+{
+    output->clear();
+    // The state of the compiler that the preprocessing depends on.
+    output->push_back(fragmentPrecisionHigh ? 'H' : 'M');
+
+    PreprocessorOutputWriter writer(output);
+    pp::Preprocessor preprocessor(&writer, &writer, pp::PreprocessorSettings());
+    if (!preprocessor.init(numStrings, shaderStrings, nullptr))
+        return;
+
+    // Set up like glslang_scan() does.
+    for (const auto &extension : extensionBehavior)
+    {
+        preprocessor.predefineMacro(extension.first.c_str(), 1);
+    }
+    if (fragmentPrecisionHigh)
+        preprocessor.predefineMacro("GL_FRAGMENT_PRECISION_HIGH", 1);
+    preprocessor.setMaxTokenSize(GetGlobalMaxTokenSize(shaderSpec));
+    if (appendedTokens)
+        preprocessor.appendTokens(appendedTokens);
+
+    pp::Token token;
+    do
+    {
+        preprocessor.lex(&token);
+        writer.writeToken(token);
+    } while (token.type != pp::Token::LAST);
+}
+
+bool TCompiler::compileImpl(const char *const shaderStrings[],
+                            size_t numStrings,
+                            const std::vector<pp::Token> *appendedTokens,
+                            ShCompileOptions compileOptionsIn)
 {
 #if defined(ANGLE_ENABLE_FUZZER_CORPUS_OUTPUT)
     DumpFuzzerCase(shaderStrings, numStrings, shaderType, shaderSpec, outputType, compileOptionsIn);
@@ -486,8 +713,13 @@ bool TCompiler::compile(const char *const shaderStrings[],
         compileOptions |= SH_FLATTEN_PRAGMA_STDGL_INVARIANT_ALL;
     }
 
+    const bool collectStatistics  = (compileOptions & SH_COLLECT_COMPILE_STATISTICS) != 0;
+    const auto compileStart       = std::chrono::steady_clock::now();
+    const size_t poolBytesAtStart = allocator.getTotalAllocatedBytes();
+    mPassManager.setTimingEnabled(collectStatistics);
+
     TScopedPoolAllocator scopedAlloc(&allocator);
-    TIntermBlock *root = compileTreeImpl(shaderStrings, numStrings, compileOptions);
+    TIntermBlock *root = compileTreeImpl(shaderStrings, numStrings, appendedTokens, compileOptions);
 
     if (root)
     {
@@ -495,13 +727,30 @@ bool TCompiler::compile(const char *const shaderStrings[],
             TIntermediate::outputTree(root, infoSink.info);
 
         if (compileOptions & SH_OBJECT_CODE)
+        {
+            PassManager::ScopedTimer timer(&mPassManager, "Translate");
             translate(root, compileOptions);
+        }
 
         // The IntermNode tree doesn't need to be deleted here, since the
         // memory will be freed in a big chunk by the PoolAllocator.
-        return true;
     }
-    return false;
+
+    // Statistics are reported for failed compilations as well, since those can be the slow ones.
+    if (collectStatistics)
+    {
+        for (const PassManager::PassTiming &timing : mPassManager.getTimings())
+        {
+            mCompileStatistics.passes.push_back({timing.name, timing.seconds});
+        }
+        mCompileStatistics.totalSeconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - compileStart).count();
+        mCompileStatistics.poolAllocatedBytes =
+            allocator.getTotalAllocatedBytes() - poolBytesAtStart;
+        mCompileStatisticsCollected = true;
+    }
+
+    return root != nullptr;
 }
 
 bool TCompiler::InitBuiltInSymbolTable(const ShBuiltInResources &resources)
@@ -643,20 +892,89 @@ void TCompiler::clearResults()
     infoSink.obj.erase();
     infoSink.debug.erase();
 
-    attributes.clear();
-    outputVariables.clear();
-    uniforms.clear();
-    expandedUniforms.clear();
-    varyings.clear();
-    interfaceBlocks.clear();
+    mReflection.clear();
+    clearVariableLists();
     variablesCollected = false;
 
     builtInFunctionEmulator.Cleanup();
 
     nameMap.clear();
+    mMinifiedNameMap.clear();
 
     mSourcePath     = NULL;
     mTemporaryIndex = 0;
+
+    mPassManager.clearTimings();
+    mCompileStatistics          = ShCompileStatistics();
+    mCompileStatisticsCollected = false;
+}
+
+const std::vector<sh::Attribute> &TCompiler::getAttributes() const
+{
+    if (!mAttributeList)
+    {
+        mAttributeList.reset(new std::vector<sh::Attribute>());
+        mReflection.getAttributes(mAttributeList.get());
+    }
+    return *mAttributeList;
+}
+
+const std::vector<sh::OutputVariable> &TCompiler::getOutputVariables() const
+{
+    if (!mOutputVariableList)
+    {
+        mOutputVariableList.reset(new std::vector<sh::OutputVariable>());
+        mReflection.getOutputVariables(mOutputVariableList.get());
+    }
+    return *mOutputVariableList;
+}
+
+const std::vector<sh::Uniform> &TCompiler::getUniforms() const
+{
+    if (!mUniformList)
+    {
+        mUniformList.reset(new std::vector<sh::Uniform>());
+        mReflection.getUniforms(mUniformList.get());
+    }
+    return *mUniformList;
+}
+
+const std::vector<sh::Varying> &TCompiler::getVaryings() const
+{
+    if (!mVaryingList)
+    {
+        mVaryingList.reset(new std::vector<sh::Varying>());
+        mReflection.getVaryings(mVaryingList.get());
+    }
+    return *mVaryingList;
+}
+
+const std::vector<sh::InterfaceBlock> &TCompiler::getInterfaceBlocks() const
+{
+    if (!mInterfaceBlockList)
+    {
+        mInterfaceBlockList.reset(new std::vector<sh::InterfaceBlock>());
+        mReflection.getInterfaceBlocks(mInterfaceBlockList.get());
+    }
+    return *mInterfaceBlockList;
+}
+
+void TCompiler::takeReflection(sh::ShaderReflection *reflectionOut)
+{
+    *reflectionOut = std::move(mReflection);
+
+    // Leave the reflection empty rather than in an unspecified state.
+    mReflection.clear();
+    clearVariableLists();
+}
+
+void TCompiler::clearVariableLists()
+{
+    mAttributeList.reset();
+    mOutputVariableList.reset();
+    mUniformList.reset();
+    mVaryingList.reset();
+    mInterfaceBlockList.reset();
 }
 
 bool TCompiler::initCallDag(TIntermNode *root)
@@ -826,18 +1144,82 @@ bool TCompiler::pruneUnusedFunctions(TIntermBlock *root)
     return true;
 }
 
-bool TCompiler::validateOutputs(TIntermNode *root)
+bool TCompiler::validateAndMarkTree(TIntermNode *root, ShCompileOptions compileOptions)
 {
-    ValidateOutputs validateOutputs(getExtensionBehavior(), compileResources.MaxDrawBuffers);
-    root->traverse(&validateOutputs);
-    return (validateOutputs.validateAndCountErrors(infoSink.info) == 0);
+    bool validateOutputs = shaderVersion == 300 && shaderType == GL_FRAGMENT_SHADER;
+    ValidateOutputs outputValidator(getExtensionBehavior(), compileResources.MaxDrawBuffers);
+    if (validateOutputs)
+    {
+        mPassManager.addAnalysis("ValidateOutputs", &outputValidator,
+                                 PassManager::DEPENDENCY_NONE, PassManager::DEPENDENCY_NONE);
+    }
+
+    // Loop errors are held back so that the info log is the same as if the passes had run one
+    // after the other, stopping at the first failure.
+    bool validateLimitations = shouldRunLoopAndIndexingValidation(compileOptions);
+    TInfoSinkBase limitationErrors;
+    ValidateLimitations limitationValidator(shaderType, &symbolTable, shaderVersion,
+                                            &limitationErrors);
+    if (validateLimitations)
+    {
+        mPassManager.addAnalysis("ValidateLimitations", &limitationValidator,
+                                 PassManager::DEPENDENCY_NONE, PassManager::DEPENDENCY_NONE);
+    }
+
+    allocator.lock();
+    initBuiltInFunctionEmulator(&builtInFunctionEmulator, compileOptions);
+    allocator.unlock();
+    TIntermTraverser *emulationMarker = builtInFunctionEmulator.CreateMarker();
+    if (emulationMarker)
+    {
+        mPassManager.addAnalysis("MarkBuiltInFunctionsForEmulation", emulationMarker,
+                                 PassManager::DEPENDENCY_NONE,
+                                 PassManager::DEPENDENCY_EMULATED_FUNCTIONS);
+    }
+
+    if (compileOptions & SH_CLAMP_INDIRECT_ARRAY_BOUNDS)
+    {
+        mPassManager.addAnalysis("MarkIndirectArrayBoundsForClamping",
+                                 arrayBoundsClamper.CreateMarker(), PassManager::DEPENDENCY_NONE,
+                                 PassManager::DEPENDENCY_INDEX_CLAMPING);
+    }
+
+    mPassManager.runAnalyses(root);
+
+    if (validateOutputs && outputValidator.validateAndCountErrors(infoSink.info) != 0)
+        return false;
+
+    if (validateLimitations && limitationValidator.numErrors() != 0)
+    {
+        infoSink.info << limitationErrors.str();
+        return false;
+    }
+
+    // Fail compilation if precision emulation not supported.
+    if (getResources().WEBGL_debug_shader_precision && getPragma().debugShaderPrecision &&
+        !EmulatePrecision::SupportedInLanguage(outputType))
+    {
+        infoSink.info.prefix(EPrefixError);
+        infoSink.info << "Precision emulation not supported for this output type.";
+        return false;
+    }
+
+    return true;
 }
 
-bool TCompiler::validateLimitations(TIntermNode *root)
+void TCompiler::collectTreeStatistics(TIntermNode *root)
 {
-    ValidateLimitations validate(shaderType, &infoSink.info);
-    root->traverse(&validate);
-    return validate.numErrors() == 0;
+    CountNodesTraverser nodeCounter;
+    root->traverse(&nodeCounter);
+    mCompileStatistics.astNodeCount = nodeCounter.getCount();
+    mCompileStatistics.astBytes     = nodeCounter.getBytes();
+
+    mCompileStatistics.globalSymbolCount  = symbolTable.getSymbolCount(GLOBAL_LEVEL);
+    mCompileStatistics.builtInSymbolCount = 0;
+    for (ESymbolLevel level = 0; level <= LAST_BUILTIN_LEVEL; ++level)
+    {
+        mCompileStatistics.builtInSymbolCount += symbolTable.getSymbolCount(level);
+    }
 }
 
 bool TCompiler::limitExpressionComplexity(TIntermNode *root)
@@ -864,13 +1246,9 @@ void TCompiler::collectVariables(TIntermNode *root)
 {
     if (!variablesCollected)
     {
-        sh::CollectVariables collect(&attributes, &outputVariables, &uniforms, &varyings,
-                                     &interfaceBlocks, hashFunction, symbolTable,
-                                     extensionBehavior);
+        sh::CollectVariables collect(&mReflection, hashFunction, symbolTable, extensionBehavior);
         root->traverse(&collect);
-
-        // This is for enforcePackingRestriction().
-        sh::ExpandUniforms(uniforms, &expandedUniforms);
+        clearVariableLists();
         variablesCollected = true;
     }
 }
@@ -887,6 +1265,9 @@ bool TCompiler::wereVariablesCollected() const
 
 bool TCompiler::enforcePackingRestrictions()
 {
+    std::vector<sh::ShaderVariable> expandedUniforms;
+    sh::ExpandUniforms(getUniforms(), &expandedUniforms);
+
     VariablePacker packer;
     return packer.CheckVariablesWithinPackingLimits(maxUniformVectors, expandedUniforms);
 }
@@ -904,7 +1285,7 @@ void TCompiler::useAllMembersInUnusedStandardAndSharedBlocks(TIntermNode *root)
 {
     sh::InterfaceBlockList list;
 
-    for (auto block : interfaceBlocks)
+    for (const auto &block : getInterfaceBlocks())
     {
         if (!block.staticUse &&
             (block.layout == sh::BLOCKLAYOUT_STANDARD || block.layout == sh::BLOCKLAYOUT_SHARED))
@@ -921,7 +1302,7 @@ void TCompiler::initializeOutputVariables(TIntermNode *root)
     InitVariableList list;
     if (shaderType == GL_VERTEX_SHADER)
     {
-        for (auto var : varyings)
+        for (const auto &var : getVaryings())
         {
             list.push_back(var);
         }
@@ -929,7 +1310,7 @@ void TCompiler::initializeOutputVariables(TIntermNode *root)
     else
     {
         ASSERT(shaderType == GL_FRAGMENT_SHADER);
-        for (auto var : outputVariables)
+        for (const auto &var : getOutputVariables())
         {
             list.push_back(var);
         }
@@ -980,9 +1361,9 @@ void TCompiler::writePragma(ShCompileOptions compileOptions)
 bool TCompiler::isVaryingDefined(const char *varyingName)
 {
     ASSERT(variablesCollected);
-    for (size_t ii = 0; ii < varyings.size(); ++ii)
+    for (const auto &varying : mReflection.varyings)
     {
-        if (varyings[ii].name == varyingName)
+        if (mReflection.stringEquals(varying.name, varyingName))
         {
             return true;
         }
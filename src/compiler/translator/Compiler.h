@@ -14,16 +14,24 @@
 // This should not be included by driver code.
 //
 
+#include <memory>
+
 #include "compiler/translator/BuiltInFunctionEmulator.h"
 #include "compiler/translator/CallDAG.h"
 #include "compiler/translator/ExtensionBehavior.h"
 #include "compiler/translator/HashNames.h"
 #include "compiler/translator/InfoSink.h"
+#include "compiler/translator/PassManager.h"
 #include "compiler/translator/Pragma.h"
 #include "compiler/translator/SymbolTable.h"
 #include "compiler/translator/VariableInfo.h"
 #include "third_party/compiler/ArrayBoundsClamper.h"
 
+namespace pp
+{
+struct Token;
+}  // namespace pp
+
 namespace sh
 {
 
@@ -85,8 +93,8 @@ class TCompiler : public TShHandleBase
     bool Init(const ShBuiltInResources &resources);
 
     // compileTreeForTesting should be used only when tests require access to
-    // the AST. Users of this function need to manually manage the global pool
-    // allocator. Returns nullptr whenever there are compilation errors.
+    // the AST. The AST is allocated from the compiler's pool and lives until the
+    // compiler is destroyed. Returns nullptr whenever there are compilation errors.
     TIntermBlock *compileTreeForTesting(const char *const shaderStrings[],
                                         size_t numStrings,
                                         ShCompileOptions compileOptions);
@@ -94,6 +102,21 @@ class TCompiler : public TShHandleBase
     bool compile(const char *const shaderStrings[],
                  size_t numStrings,
                  ShCompileOptions compileOptions);
+    // Compiles the strings followed by tokens from pp::Tokenizer::TokenizeString(), which stand
+    // in for one more string that doesn't have to be tokenized again.
+    bool compile(const char *const shaderStrings[],
+                 size_t numStrings,
+                 const std::vector<pp::Token> &appendedTokens,
+                 ShCompileOptions compileOptions);
+
+    // Runs only the preprocessor, the way compile() would, over the strings followed by the
+    // appended tokens if they aren't null. Writes out everything the rest of the compilation
+    // depends on: the preprocessed tokens and their locations, the directives and the
+    // preprocessor's diagnostics. Sources with the same output compile to the same results.
+    void preprocess(const char *const shaderStrings[],
+                    size_t numStrings,
+                    const std::vector<pp::Token> *appendedTokens,
+                    std::string *output);
 
     // Get results of the last compilation.
     int getShaderVersion() const { return shaderVersion; }
@@ -105,14 +128,31 @@ class TCompiler : public TShHandleBase
     // Clears the results from the previous compilation.
     void clearResults();
 
-    const std::vector<sh::Attribute> &getAttributes() const { return attributes; }
-    const std::vector<sh::OutputVariable> &getOutputVariables() const { return outputVariables; }
-    const std::vector<sh::Uniform> &getUniforms() const { return uniforms; }
-    const std::vector<sh::Varying> &getVaryings() const { return varyings; }
-    const std::vector<sh::InterfaceBlock> &getInterfaceBlocks() const { return interfaceBlocks; }
+    // How long each pass of the last compilation took, in the order they ran.
+    const std::vector<PassManager::PassTiming> &getPassTimings() const
+    {
+        return mPassManager.getTimings();
+    }
+
+    // Statistics of the last compilation, or nullptr if it didn't collect any.
+    const ShCompileStatistics *getCompileStatistics() const
+    {
+        return mCompileStatisticsCollected ? &mCompileStatistics : nullptr;
+    }
+
+    const sh::ShaderReflection &getReflection() const { return mReflection; }
+    // Lists of the variables in the reflection, built on first use.
+    const std::vector<sh::Attribute> &getAttributes() const;
+    const std::vector<sh::OutputVariable> &getOutputVariables() const;
+    const std::vector<sh::Uniform> &getUniforms() const;
+    const std::vector<sh::Varying> &getVaryings() const;
+    const std::vector<sh::InterfaceBlock> &getInterfaceBlocks() const;
+    // Moves the reflection out of the compiler.
+    void takeReflection(sh::ShaderReflection *reflectionOut);
 
     ShHashFunction64 getHashFunction() const { return hashFunction; }
     NameMap &getNameMap() { return nameMap; }
+    NameMap &getMinifiedNameMap() { return mMinifiedNameMap; }
     TSymbolTable &getSymbolTable() { return symbolTable; }
     ShShaderSpec getShaderSpec() const { return shaderSpec; }
     ShShaderOutput getOutputType() const { return outputType; }
@@ -131,11 +171,6 @@ class TCompiler : public TShHandleBase
     void setResourceString();
     // Return false if the call depth is exceeded.
     bool checkCallDepth();
-    // Returns true if a program has no conflicting or missing fragment outputs
-    bool validateOutputs(TIntermNode *root);
-    // Returns true if the given shader does not exceed the minimum
-    // functionality mandated in GLSL 1.0 spec Appendix A.
-    bool validateLimitations(TIntermNode *root);
     // Add emulated functions to the built-in function emulator.
     virtual void initBuiltInFunctionEmulator(BuiltInFunctionEmulator *emu,
                                              ShCompileOptions compileOptions){};
@@ -175,12 +210,7 @@ class TCompiler : public TShHandleBase
     virtual bool shouldCollectVariables(ShCompileOptions compileOptions);
 
     bool wereVariablesCollected() const;
-    std::vector<sh::Attribute> attributes;
-    std::vector<sh::OutputVariable> outputVariables;
-    std::vector<sh::Uniform> uniforms;
-    std::vector<sh::ShaderVariable> expandedUniforms;
-    std::vector<sh::Varying> varyings;
-    std::vector<sh::InterfaceBlock> interfaceBlocks;
+    sh::ShaderReflection mReflection;
 
   private:
     // Creates the function call DAG for further analysis, returning false if there is a recursion
@@ -193,15 +223,37 @@ class TCompiler : public TShHandleBase
 
     // Collect info for all attribs, uniforms, varyings.
     void collectVariables(TIntermNode *root);
+    // Drops the lists built from the reflection, which must be done whenever it changes.
+    void clearVariableLists();
+
+    // Validates the fragment outputs and the GLSL 1.0 spec Appendix A limitations, and marks the
+    // nodes that need built-in function emulation or index clamping. These passes only read the
+    // tree, so they share a single traversal. Returns false if validation fails.
+    bool validateAndMarkTree(TIntermNode *root, ShCompileOptions compileOptions);
+
+    // Measures the tree and the symbol table for SH_COLLECT_COMPILE_STATISTICS.
+    void collectTreeStatistics(TIntermNode *root);
 
     bool variablesCollected;
 
+    // The lists returned by the getters, or null until they are first used.
+    mutable std::unique_ptr<std::vector<sh::Attribute>> mAttributeList;
+    mutable std::unique_ptr<std::vector<sh::OutputVariable>> mOutputVariableList;
+    mutable std::unique_ptr<std::vector<sh::Uniform>> mUniformList;
+    mutable std::unique_ptr<std::vector<sh::Varying>> mVaryingList;
+    mutable std::unique_ptr<std::vector<sh::InterfaceBlock>> mInterfaceBlockList;
+
     // Removes unused function declarations and prototypes from the AST
     class UnusedPredicate;
     bool pruneUnusedFunctions(TIntermBlock *root);
 
+    bool compileImpl(const char *const shaderStrings[],
+                     size_t numStrings,
+                     const std::vector<pp::Token> *appendedTokens,
+                     ShCompileOptions compileOptionsIn);
     TIntermBlock *compileTreeImpl(const char *const shaderStrings[],
                                   size_t numStrings,
+                                  const std::vector<pp::Token> *appendedTokens,
                                   const ShCompileOptions compileOptions);
 
     sh::GLenum shaderType;
@@ -249,9 +301,16 @@ class TCompiler : public TShHandleBase
     ShHashFunction64 hashFunction;
     NameMap nameMap;
 
+    // Names replaced by SH_MINIFY_OUTPUT.
+    NameMap mMinifiedNameMap;
+
     TPragma mPragma;
 
     unsigned int mTemporaryIndex;
+
+    PassManager mPassManager;
+    ShCompileStatistics mCompileStatistics;
+    bool mCompileStatisticsCollected;
 };
 
 //
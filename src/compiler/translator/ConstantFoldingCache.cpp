@@ -0,0 +1,148 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ConstantFoldingCache.cpp: Remembers the values that constant expressions folded to.
+//
+
+#include "compiler/translator/ConstantFoldingCache.h"
+
+#include <string.h>
+
+namespace sh
+{
+
+TConstantFoldingCache::TConstantFoldingCache()
+{
+}
+
+// static
+bool TConstantFoldingCache::IsCached(TOperator op)
+{
+    // Folding the other operators takes one operation per component, which is about as fast as
+    // looking the result up.
+    switch (op)
+    {
+        case EOpVectorTimesMatrix:
+        case EOpMatrixTimesVector:
+        case EOpMatrixTimesMatrix:
+        case EOpOuterProduct:
+        case EOpDeterminant:
+        case EOpInverse:
+        case EOpSin:
+        case EOpCos:
+        case EOpTan:
+        case EOpAsin:
+        case EOpAcos:
+        case EOpAtan:
+        case EOpSinh:
+        case EOpCosh:
+        case EOpTanh:
+        case EOpAsinh:
+        case EOpAcosh:
+        case EOpAtanh:
+        case EOpPow:
+        case EOpExp:
+        case EOpLog:
+        case EOpExp2:
+        case EOpLog2:
+        case EOpSqrt:
+        case EOpInverseSqrt:
+        case EOpMod:
+        case EOpSmoothStep:
+        case EOpPackSnorm2x16:
+        case EOpPackUnorm2x16:
+        case EOpPackHalf2x16:
+        case EOpUnpackSnorm2x16:
+        case EOpUnpackUnorm2x16:
+        case EOpUnpackHalf2x16:
+        case EOpLength:
+        case EOpDistance:
+        case EOpDot:
+        case EOpCross:
+        case EOpNormalize:
+        case EOpFaceForward:
+        case EOpReflect:
+        case EOpRefract:
+            return true;
+        default:
+            return false;
+    }
+}
+
+const TConstantUnion *TConstantFoldingCache::find(TOperator op,
+                                                  const TType &resultType,
+                                                  const TIntermConstantUnion *const *operands,
+                                                  size_t operandCount)
+{
+    // The values of an operation depend on the operator and on the types and values of the
+    // operands. The result type tells apart the overloads of the operators.
+    int header[] = {op, resultType.getBasicType(), resultType.getNominalSize(),
+                    resultType.getSecondarySize(), static_cast<int>(resultType.getObjectSize())};
+    size_t keySize = sizeof(header);
+    for (size_t operandIndex = 0; operandIndex < operandCount; ++operandIndex)
+    {
+        keySize += sizeof(header) +
+                   operands[operandIndex]->getType().getObjectSize() * kBytesPerComponent;
+    }
+    mKey.resize(keySize);
+    char *key = &mKey[0];
+    memcpy(key, header, sizeof(header));
+    key += sizeof(header);
+
+    for (size_t operandIndex = 0; operandIndex < operandCount; ++operandIndex)
+    {
+        const TType &type   = operands[operandIndex]->getType();
+        size_t objectSize   = type.getObjectSize();
+        int operandHeader[] = {type.getBasicType(), type.getNominalSize(), type.getSecondarySize(),
+                               static_cast<int>(type.getArraySize()),
+                               static_cast<int>(objectSize)};
+        static_assert(sizeof(operandHeader) == sizeof(header), "Key headers differ in size");
+        memcpy(key, operandHeader, sizeof(operandHeader));
+        key += sizeof(operandHeader);
+
+        const TConstantUnion *values = operands[operandIndex]->getUnionArrayPointer();
+        for (size_t i = 0; i < objectSize; ++i)
+        {
+            // Only the member of the union that is in use is compared. Structures mix types.
+            TBasicType basicType = values[i].getType();
+            unsigned int bits    = 0;
+            switch (basicType)
+            {
+                case EbtFloat:
+                {
+                    float value = values[i].getFConst();
+                    memcpy(&bits, &value, sizeof(bits));
+                    break;
+                }
+                case EbtInt:
+                    bits = static_cast<unsigned int>(values[i].getIConst());
+                    break;
+                case EbtUInt:
+                    bits = values[i].getUConst();
+                    break;
+                case EbtBool:
+                    bits = values[i].getBConst() ? 1u : 0u;
+                    break;
+                default:
+                    break;
+            }
+            key[0] = static_cast<char>(basicType);
+            memcpy(key + 1, &bits, sizeof(bits));
+            key += kBytesPerComponent;
+        }
+    }
+    ASSERT(key == mKey.data() + mKey.size());
+
+    auto it = mValues.find(mKey);
+    return it != mValues.end() ? it->second : nullptr;
+}
+
+void TConstantFoldingCache::insert(const TConstantUnion *values)
+{
+    ASSERT(values != nullptr);
+    mValues[mKey] = values;
+}
+
+}  // namespace sh
@@ -0,0 +1,83 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ConstantFoldingCache.h: Remembers the values that constant expressions folded to, so that an
+// expression that a shader repeats is only folded once.
+//
+
+#ifndef COMPILER_TRANSLATOR_CONSTANTFOLDINGCACHE_H_
+#define COMPILER_TRANSLATOR_CONSTANTFOLDINGCACHE_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "common/angleutils.h"
+#include "compiler/translator/Diagnostics.h"
+#include "compiler/translator/IntermNode.h"
+
+namespace sh
+{
+
+// The cached values are allocated from the pool of the compilation, so a cache must not outlive
+// it. Only folds that don't report anything are cached, so that each occurrence of an expression
+// that does gets its own diagnostics.
+class TConstantFoldingCache : angle::NonCopyable
+{
+  public:
+    TConstantFoldingCache();
+
+    // Whether folding the operator takes long enough for the cache to be worth looking up.
+    static bool IsCached(TOperator op);
+
+    // Looks up the values that an operation on constant operands folded to. Returns nullptr if the
+    // operation hasn't been cached, in which case insert() caches it.
+    const TConstantUnion *find(TOperator op,
+                               const TType &resultType,
+                               const TIntermConstantUnion *const *operands,
+                               size_t operandCount);
+    // Caches the values of the operation that find() didn't find.
+    void insert(const TConstantUnion *values);
+
+  private:
+    // The basic type and the bits of the value.
+    static const size_t kBytesPerComponent = 5;
+
+    std::unordered_map<std::string, const TConstantUnion *> mValues;
+    // Key of the last find().
+    std::string mKey;
+};
+
+// Folds a unary, binary or aggregate operation that has only constant operands, with the results
+// of earlier identical folds reused through the cache when there is one.
+template <typename FoldFunction>
+const TConstantUnion *FoldWithCache(TConstantFoldingCache *cache,
+                                    TOperator op,
+                                    const TType &resultType,
+                                    const TIntermConstantUnion *const *operands,
+                                    size_t operandCount,
+                                    const TDiagnostics *diagnostics,
+                                    FoldFunction fold)
+{
+    if (cache == nullptr || !TConstantFoldingCache::IsCached(op))
+    {
+        return fold();
+    }
+    const TConstantUnion *values = cache->find(op, resultType, operands, operandCount);
+    if (values == nullptr)
+    {
+        int diagnosticCount = diagnostics->numErrors() + diagnostics->numWarnings();
+        values              = fold();
+        if (values != nullptr &&
+            diagnostics->numErrors() + diagnostics->numWarnings() == diagnosticCount)
+        {
+            cache->insert(values);
+        }
+    }
+    return values;
+}
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_CONSTANTFOLDINGCACHE_H_
@@ -121,9 +121,9 @@ bool DeferGlobalInitializersTraverser::visitBinary(Visit visit, TIntermBinary *n
                     if (siblingBinary)
                     {
                         ASSERT(siblingBinary->getOp() == EOpInitialize);
-                        siblingBinary->getLeft()->getTypePointer()->setQualifier(EvqGlobal);
+                        siblingBinary->getLeft()->setQualifier(EvqGlobal);
                     }
-                    siblingNode->getAsTyped()->getTypePointer()->setQualifier(EvqGlobal);
+                    siblingNode->getAsTyped()->setQualifier(EvqGlobal);
                 }
                 // This node is one of the siblings.
                 ASSERT(symbolNode->getQualifier() == EvqGlobal);
@@ -112,7 +112,7 @@ void GLFragColorBroadcastTraverser::broadcastGLFragColor()
 
 void EmulateGLFragColorBroadcast(TIntermNode *root,
                                  int maxDrawBuffers,
-                                 std::vector<sh::OutputVariable> *outputVariables)
+                                 ShaderReflection *reflection)
 {
     ASSERT(maxDrawBuffers > 1);
     GLFragColorBroadcastTraverser traverser(maxDrawBuffers);
@@ -121,13 +121,13 @@ void EmulateGLFragColorBroadcast(TIntermNode *root,
     {
         traverser.updateTree();
         traverser.broadcastGLFragColor();
-        for (auto &var : *outputVariables)
+        for (auto &var : reflection->outputVariables)
         {
-            if (var.name == "gl_FragColor")
+            if (reflection->stringEquals(var.name, "gl_FragColor"))
             {
                 // TODO(zmo): Find a way to keep the original variable information.
-                var.name       = "gl_FragData";
-                var.mappedName = "gl_FragData";
+                var.name       = reflection->addString("gl_FragData");
+                var.mappedName = var.name;
                 var.arraySize  = maxDrawBuffers;
             }
         }
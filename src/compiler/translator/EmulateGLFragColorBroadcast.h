@@ -10,19 +10,17 @@
 #ifndef COMPILER_TRANSLATOR_EMULATEGLFRAGCOLORBROADCAST_H_
 #define COMPILER_TRANSLATOR_EMULATEGLFRAGCOLORBROADCAST_H_
 
-#include <vector>
-
 namespace sh
 {
-struct OutputVariable;
+struct ShaderReflection;
 class TIntermNode;
 
 // Replace all gl_FragColor with gl_FragData[0], and in the end of main() function,
 // assign gl_FragData[1] ... gl_FragData[maxDrawBuffers - 1] with gl_FragData[0].
-// If gl_FragColor is in outputVariables, it is replaced by gl_FragData.
+// If gl_FragColor is in the output variables of reflection, it is replaced by gl_FragData.
 void EmulateGLFragColorBroadcast(TIntermNode *root,
                                  int maxDrawBuffers,
-                                 std::vector<OutputVariable> *outputVariables);
+                                 ShaderReflection *reflection);
 }
 
 #endif  // COMPILER_TRANSLATOR_EMULATEGLFRAGCOLORBROADCAST_H_
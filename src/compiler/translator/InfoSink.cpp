@@ -38,14 +38,12 @@ void TInfoSinkBase::prefix(TPrefixType p)
 
 void TInfoSinkBase::location(int file, int line)
 {
-    TPersistStringStream stream;
+    *this << file;
     if (line)
-        stream << file << ":" << line;
+        *this << ":" << line;
     else
-        stream << file << ":? ";
-    stream << ": ";
-
-    sink.append(stream.str());
+        sink.append(":? ");
+    sink.append(": ");
 }
 
 void TInfoSinkBase::location(const TSourceLoc &loc)
@@ -8,7 +8,13 @@
 #define COMPILER_TRANSLATOR_INFOSINK_H_
 
 #include <math.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <type_traits>
+
 #include "compiler/translator/Common.h"
 
 namespace sh
@@ -73,9 +79,16 @@ class TInfoSinkBase
     }
     TInfoSinkBase &operator<<(const TString &str)
     {
-        sink.append(str.c_str());
+        sink.append(str.data(), str.size());
         return *this;
     }
+    // Integers are formatted into a buffer on the stack rather than through a stream.
+    TInfoSinkBase &operator<<(int i) { return appendSigned(i); }
+    TInfoSinkBase &operator<<(long i) { return appendSigned(i); }
+    TInfoSinkBase &operator<<(long long i) { return appendSigned(i); }
+    TInfoSinkBase &operator<<(unsigned int i) { return appendUnsigned(i); }
+    TInfoSinkBase &operator<<(unsigned long i) { return appendUnsigned(i); }
+    TInfoSinkBase &operator<<(unsigned long long i) { return appendUnsigned(i); }
     // Make sure floats are written with correct precision.
     TInfoSinkBase &operator<<(float f)
     {
@@ -83,20 +96,11 @@ class TInfoSinkBase
         // does not have a fractional part, the default precision format does
         // not write the decimal portion which gets interpreted as integer by
         // the compiler.
-        TPersistStringStream stream;
-        if (fractionalPart(f) == 0.0f)
-        {
-            stream.precision(1);
-            stream << std::showpoint << std::fixed << f;
-        }
-        else
-        {
-            stream.unsetf(std::ios::fixed);
-            stream.unsetf(std::ios::scientific);
-            stream.precision(8);
-            stream << f;
-        }
-        sink.append(stream.str());
+        // Large enough for FLT_MAX in fixed notation.
+        char buffer[64];
+        const char *format = fractionalPart(f) == 0.0f ? "%.1f" : "%.8g";
+        int length         = snprintf(buffer, sizeof(buffer), format, f);
+        appendNumber(buffer, static_cast<size_t>(length));
         return *this;
     }
     // Write boolean values as their names instead of integral value.
@@ -107,6 +111,17 @@ class TInfoSinkBase
         return *this;
     }
 
+    // Appends length characters of str, which doesn't need to be null-terminated.
+    void append(const char *str, size_t length) { sink.append(str, length); }
+    // Grows the sink ahead of emitting roughly this many characters in total.
+    void reserve(size_t capacity)
+    {
+        if (capacity > sink.capacity())
+        {
+            sink.reserve(std::max(capacity, sink.capacity() * 2));
+        }
+    }
+
     void erase() { sink.clear(); }
     int size() { return static_cast<int>(sink.size()); }
 
@@ -119,6 +134,58 @@ class TInfoSinkBase
     void message(TPrefixType p, const TSourceLoc &loc, const char *m);
 
   private:
+    // snprintf writes the decimal point of the C locale that the host process has set, which
+    // can be a comma or even several bytes. Everything else it writes for a float is a digit, a
+    // sign, an exponent or inf/nan, so the decimal point is whatever run of other characters is
+    // left, and it is written as '.' whatever the locale.
+    void appendNumber(const char *str, size_t length)
+    {
+        const char *kNumberCharacters = "0123456789+-eEinfaINFA";
+        char buffer[64];
+        size_t outLength = 0;
+        for (size_t index = 0; index < length && outLength < sizeof(buffer);)
+        {
+            if (strchr(kNumberCharacters, str[index]) != nullptr)
+            {
+                buffer[outLength++] = str[index++];
+                continue;
+            }
+            buffer[outLength++] = '.';
+            while (index < length && strchr(kNumberCharacters, str[index]) == nullptr)
+            {
+                ++index;
+            }
+        }
+        sink.append(buffer, outLength);
+    }
+
+    template <typename T>
+    TInfoSinkBase &appendUnsigned(T value)
+    {
+        char buffer[24];
+        char *end   = buffer + sizeof(buffer);
+        char *begin = end;
+        do
+        {
+            *--begin = static_cast<char>('0' + value % 10u);
+            value /= 10u;
+        } while (value != 0u);
+        sink.append(begin, end - begin);
+        return *this;
+    }
+    template <typename T>
+    TInfoSinkBase &appendSigned(T value)
+    {
+        typedef typename std::make_unsigned<T>::type UnsignedT;
+        if (value < 0)
+        {
+            sink.append(1, '-');
+            // Negate in the unsigned type so that the most negative value doesn't overflow.
+            return appendUnsigned(static_cast<UnsignedT>(0u - static_cast<UnsignedT>(value)));
+        }
+        return appendUnsigned(static_cast<UnsignedT>(value));
+    }
+
     TPersistString sink;
 };
 
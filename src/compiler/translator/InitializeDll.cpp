@@ -6,30 +6,14 @@
 
 #include "compiler/translator/Cache.h"
 #include "compiler/translator/InitializeDll.h"
-#include "compiler/translator/InitializeGlobals.h"
-#include "compiler/translator/InitializeParseContext.h"
 
 #include "common/platform.h"
 
-#include <assert.h>
-
 namespace sh
 {
 
 bool InitProcess()
 {
-    if (!InitializePoolIndex())
-    {
-        assert(0 && "InitProcess(): Failed to initalize global pool");
-        return false;
-    }
-
-    if (!InitializeParseContextIndex())
-    {
-        assert(0 && "InitProcess(): Failed to initalize parse context");
-        return false;
-    }
-
     TCache::initialize();
 
     return true;
@@ -37,8 +21,6 @@ bool InitProcess()
 
 void DetachProcess()
 {
-    FreeParseContextIndex();
-    FreePoolIndex();
     TCache::destroy();
 }
 
@@ -1,13 +0,0 @@
-//
-// Copyright (c) 2002-2010 The ANGLE Project Authors. All rights reserved.
-// Use of this source code is governed by a BSD-style license that can be
-// found in the LICENSE file.
-//
-
-#ifndef COMPILER_TRANSLATOR_INITIALIZEGLOBALS_H_
-#define COMPILER_TRANSLATOR_INITIALIZEGLOBALS_H_
-
-bool InitializePoolIndex();
-void FreePoolIndex();
-
-#endif  // COMPILER_TRANSLATOR_INITIALIZEGLOBALS_H_
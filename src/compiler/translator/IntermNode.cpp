@@ -17,6 +17,8 @@
 
 #include "common/mathutil.h"
 #include "common/matrix_utils.h"
+#include "compiler/translator/Cache.h"
+#include "compiler/translator/ConstantFoldingCache.h"
 #include "compiler/translator/Diagnostics.h"
 #include "compiler/translator/HashNames.h"
 #include "compiler/translator/IntermNode.h"
@@ -47,6 +49,108 @@ TConstantUnion *Vectorize(const TConstantUnion &constant, size_t size)
     return constUnion;
 }
 
+struct AddOperation
+{
+    static float Float(float lhs, float rhs) { return lhs + rhs; }
+    static int Int(int lhs, int rhs) { return gl::WrappingSum<int>(lhs, rhs); }
+    static unsigned int UInt(unsigned int lhs, unsigned int rhs)
+    {
+        return gl::WrappingSum<unsigned int>(lhs, rhs);
+    }
+    static TConstantUnion Checked(const TConstantUnion &lhs,
+                                  const TConstantUnion &rhs,
+                                  TDiagnostics *diagnostics,
+                                  const TSourceLoc &line)
+    {
+        return TConstantUnion::add(lhs, rhs, diagnostics, line);
+    }
+};
+
+struct SubOperation
+{
+    static float Float(float lhs, float rhs) { return lhs - rhs; }
+    static int Int(int lhs, int rhs) { return gl::WrappingDiff<int>(lhs, rhs); }
+    static unsigned int UInt(unsigned int lhs, unsigned int rhs)
+    {
+        return gl::WrappingDiff<unsigned int>(lhs, rhs);
+    }
+    static TConstantUnion Checked(const TConstantUnion &lhs,
+                                  const TConstantUnion &rhs,
+                                  TDiagnostics *diagnostics,
+                                  const TSourceLoc &line)
+    {
+        return TConstantUnion::sub(lhs, rhs, diagnostics, line);
+    }
+};
+
+struct MulOperation
+{
+    static float Float(float lhs, float rhs) { return lhs * rhs; }
+    static int Int(int lhs, int rhs) { return gl::WrappingMul(lhs, rhs); }
+    static unsigned int UInt(unsigned int lhs, unsigned int rhs) { return lhs * rhs; }
+    static TConstantUnion Checked(const TConstantUnion &lhs,
+                                  const TConstantUnion &rhs,
+                                  TDiagnostics *diagnostics,
+                                  const TSourceLoc &line)
+    {
+        return TConstantUnion::mul(lhs, rhs, diagnostics, line);
+    }
+};
+
+// Folds a component-wise arithmetic operation on whole vectors or matrices: the basic type is only
+// looked at once, and each loop works on plain numbers. A stride of 0 repeats a scalar operand.
+// Float results that aren't finite are folded again through TConstantUnion, which warns about
+// them.
+template <typename Operation>
+TConstantUnion *FoldArithmetic(TBasicType basicType,
+                               const TConstantUnion *leftArray,
+                               size_t leftStride,
+                               const TConstantUnion *rightArray,
+                               size_t rightStride,
+                               size_t size,
+                               TDiagnostics *diagnostics,
+                               const TSourceLoc &line)
+{
+    TConstantUnion *resultArray = new TConstantUnion[size];
+    switch (basicType)
+    {
+        case EbtFloat:
+            for (size_t i = 0; i < size; ++i)
+            {
+                const TConstantUnion &lhs = leftArray[i * leftStride];
+                const TConstantUnion &rhs = rightArray[i * rightStride];
+                float result              = Operation::Float(lhs.getFConst(), rhs.getFConst());
+                if (gl::isInf(result) || gl::isNaN(result))
+                {
+                    resultArray[i] = Operation::Checked(lhs, rhs, diagnostics, line);
+                }
+                else
+                {
+                    resultArray[i].setFConst(result);
+                }
+            }
+            break;
+        case EbtInt:
+            for (size_t i = 0; i < size; ++i)
+            {
+                resultArray[i].setIConst(Operation::Int(leftArray[i * leftStride].getIConst(),
+                                                        rightArray[i * rightStride].getIConst()));
+            }
+            break;
+        case EbtUInt:
+            for (size_t i = 0; i < size; ++i)
+            {
+                resultArray[i].setUConst(Operation::UInt(leftArray[i * leftStride].getUConst(),
+                                                         rightArray[i * rightStride].getUConst()));
+            }
+            break;
+        default:
+            UNREACHABLE();
+            break;
+    }
+    return resultArray;
+}
+
 void UndefinedConstantFoldingError(const TSourceLoc &loc,
                                    TOperator op,
                                    TBasicType basicType,
@@ -105,7 +209,7 @@ TIntermTyped *CreateFoldedNode(const TConstantUnion *constArray,
         return nullptr;
     }
     TIntermTyped *folded = new TIntermConstantUnion(constArray, originalNode->getType());
-    folded->getTypePointer()->setQualifier(qualifier);
+    folded->setQualifier(qualifier);
     folded->setLine(originalNode->getLine());
     return folded;
 }
@@ -151,12 +255,44 @@ void SetUnionArrayFromMatrix(const angle::Matrix<float> &m, TConstantUnion *resu
 //
 ////////////////////////////////////////////////////////////////
 
+void TIntermTyped::setType(const TType &t)
+{
+    // Basic types come from the cache that all compilations share. Others are copied to the pool,
+    // and the copy is only shared with copies of this node.
+    mType = TCache::getCanonicalType(t);
+    if (mType == nullptr)
+    {
+        mType = new TType(t);
+    }
+}
+
 void TIntermTyped::setTypePreservePrecision(const TType &t)
 {
     TPrecision precision = getPrecision();
-    mType                = t;
-    ASSERT(mType.getBasicType() != EbtBool || precision == EbpUndefined);
-    mType.setPrecision(precision);
+    ASSERT(t.getBasicType() != EbtBool || precision == EbpUndefined);
+    TType type(t);
+    type.setPrecision(precision);
+    setType(type);
+}
+
+void TIntermTyped::setQualifier(TQualifier qualifier)
+{
+    if (mType->getQualifier() != qualifier)
+    {
+        TType type(*mType);
+        type.setQualifier(qualifier);
+        setType(type);
+    }
+}
+
+void TIntermTyped::setPrecision(TPrecision precision)
+{
+    if (mType->getPrecision() != precision)
+    {
+        TType type(*mType);
+        type.setPrecision(precision);
+        setType(type);
+    }
 }
 
 #define REPLACE_IF_IS(node, type, original, replacement) \
@@ -285,7 +421,7 @@ void TIntermAggregate::setPrecisionFromChildren()
     mGotPrecisionFromChildren = true;
     if (getBasicType() == EbtBool)
     {
-        mType.setPrecision(EbpUndefined);
+        setPrecision(EbpUndefined);
         return;
     }
 
@@ -298,7 +434,7 @@ void TIntermAggregate::setPrecisionFromChildren()
             precision = GetHigherPrecision(typed->getPrecision(), precision);
         ++childIter;
     }
-    mType.setPrecision(precision);
+    setPrecision(precision);
 }
 
 void TIntermAggregate::setBuiltInFunctionPrecision()
@@ -322,9 +458,9 @@ void TIntermAggregate::setBuiltInFunctionPrecision()
     // ESSL 3.0 spec section 8: textureSize always gets highp precision.
     // All other functions that take a sampler are assumed to be texture functions.
     if (mFunctionInfo.getName().find("textureSize") == 0)
-        mType.setPrecision(EbpHigh);
+        setPrecision(EbpHigh);
     else
-        mType.setPrecision(precision);
+        setPrecision(precision);
 }
 
 void TIntermBlock::appendStatement(TIntermNode *statement)
@@ -754,9 +890,12 @@ void TIntermUnary::promote()
             setType(TType(EbtBool, EbpUndefined, resultQualifier, operandPrimarySize));
             break;
         default:
-            setType(mOperand->getType());
-            mType.setQualifier(resultQualifier);
+        {
+            TType type(mOperand->getType());
+            type.setQualifier(resultQualifier);
+            setType(type);
             break;
+        }
     }
 }
 
@@ -796,8 +935,7 @@ TIntermTernary::TIntermTernary(TIntermTyped *cond,
       mTrueExpression(trueExpression),
       mFalseExpression(falseExpression)
 {
-    getTypePointer()->setQualifier(
-        TIntermTernary::DetermineQualifier(cond, trueExpression, falseExpression));
+    setQualifier(TIntermTernary::DetermineQualifier(cond, trueExpression, falseExpression));
 }
 
 // static
@@ -898,7 +1036,7 @@ void TIntermBinary::promote()
     if (mLeft->getQualifier() != EvqConst || mRight->getQualifier() != EvqConst)
     {
         resultQualifier = EvqTemporary;
-        getTypePointer()->setQualifier(EvqTemporary);
+        setQualifier(EvqTemporary);
     }
 
     // Handle indexing ops.
@@ -908,7 +1046,9 @@ void TIntermBinary::promote()
         case EOpIndexIndirect:
             if (mLeft->isArray())
             {
-                mType.clearArrayness();
+                TType type(*mType);
+                type.clearArrayness();
+                setType(type);
             }
             else if (mLeft->isMatrix())
             {
@@ -928,16 +1068,18 @@ void TIntermBinary::promote()
         {
             const TFieldList &fields = mLeft->getType().getStruct()->fields();
             const int i              = mRight->getAsConstantUnion()->getIConst(0);
-            setType(*fields[i]->type());
-            getTypePointer()->setQualifier(resultQualifier);
+            TType type(*fields[i]->type());
+            type.setQualifier(resultQualifier);
+            setType(type);
             return;
         }
         case EOpIndexDirectInterfaceBlock:
         {
             const TFieldList &fields = mLeft->getType().getInterfaceBlock()->fields();
             const int i              = mRight->getAsConstantUnion()->getIConst(0);
-            setType(*fields[i]->type());
-            getTypePointer()->setQualifier(resultQualifier);
+            TType type(*fields[i]->type());
+            type.setQualifier(resultQualifier);
+            setType(type);
             return;
         }
         default:
@@ -948,7 +1090,7 @@ void TIntermBinary::promote()
 
     // The result gets promoted to the highest precision.
     TPrecision higherPrecision = GetHigherPrecision(mLeft->getPrecision(), mRight->getPrecision());
-    getTypePointer()->setPrecision(higherPrecision);
+    setPrecision(higherPrecision);
 
     const int nominalSize = std::max(mLeft->getNominalSize(), mRight->getNominalSize());
 
@@ -1124,10 +1266,10 @@ TIntermTyped *TIntermSwizzle::fold()
     {
         constArray[i] = *operandConstant->foldIndexing(mSwizzleOffsets.at(i));
     }
-    return CreateFoldedNode(constArray, this, mType.getQualifier());
+    return CreateFoldedNode(constArray, this, mType->getQualifier());
 }
 
-TIntermTyped *TIntermBinary::fold(TDiagnostics *diagnostics)
+TIntermTyped *TIntermBinary::fold(TDiagnostics *diagnostics, TConstantFoldingCache *cache)
 {
     TIntermConstantUnion *leftConstant  = mLeft->getAsConstantUnion();
     TIntermConstantUnion *rightConstant = mRight->getAsConstantUnion();
@@ -1142,7 +1284,7 @@ TIntermTyped *TIntermBinary::fold(TDiagnostics *diagnostics)
             int index = rightConstant->getIConst(0);
 
             const TConstantUnion *constArray = leftConstant->foldIndexing(index);
-            return CreateFoldedNode(constArray, this, mType.getQualifier());
+            return CreateFoldedNode(constArray, this, mType->getQualifier());
         }
         case EOpIndexDirectStruct:
         {
@@ -1160,7 +1302,7 @@ TIntermTyped *TIntermBinary::fold(TDiagnostics *diagnostics)
             }
 
             const TConstantUnion *constArray = leftConstant->getUnionArrayPointer();
-            return CreateFoldedNode(constArray + previousFieldsSize, this, mType.getQualifier());
+            return CreateFoldedNode(constArray + previousFieldsSize, this, mType->getQualifier());
         }
         case EOpIndexIndirect:
         case EOpIndexDirectInterfaceBlock:
@@ -1172,16 +1314,20 @@ TIntermTyped *TIntermBinary::fold(TDiagnostics *diagnostics)
             {
                 return nullptr;
             }
-            TConstantUnion *constArray =
-                leftConstant->foldBinary(mOp, rightConstant, diagnostics, mLeft->getLine());
+            auto foldOperation = [&]() {
+                return leftConstant->foldBinary(mOp, rightConstant, diagnostics, mLeft->getLine());
+            };
+            const TIntermConstantUnion *operands[] = {leftConstant, rightConstant};
+            const TConstantUnion *constArray =
+                FoldWithCache(cache, mOp, *mType, operands, 2, diagnostics, foldOperation);
 
             // Nodes may be constant folded without being qualified as constant.
-            return CreateFoldedNode(constArray, this, mType.getQualifier());
+            return CreateFoldedNode(constArray, this, mType->getQualifier());
         }
     }
 }
 
-TIntermTyped *TIntermUnary::fold(TDiagnostics *diagnostics)
+TIntermTyped *TIntermUnary::fold(TDiagnostics *diagnostics, TConstantFoldingCache *cache)
 {
     TIntermConstantUnion *operandConstant = mOperand->getAsConstantUnion();
     if (operandConstant == nullptr)
@@ -1189,47 +1335,53 @@ TIntermTyped *TIntermUnary::fold(TDiagnostics *diagnostics)
         return nullptr;
     }
 
-    TConstantUnion *constArray = nullptr;
-    switch (mOp)
-    {
-        case EOpAny:
-        case EOpAll:
-        case EOpLength:
-        case EOpTranspose:
-        case EOpDeterminant:
-        case EOpInverse:
-        case EOpPackSnorm2x16:
-        case EOpUnpackSnorm2x16:
-        case EOpPackUnorm2x16:
-        case EOpUnpackUnorm2x16:
-        case EOpPackHalf2x16:
-        case EOpUnpackHalf2x16:
-            constArray = operandConstant->foldUnaryNonComponentWise(mOp);
-            break;
-        default:
-            constArray = operandConstant->foldUnaryComponentWise(mOp, diagnostics);
-            break;
-    }
+    auto foldOperation = [&]() -> TConstantUnion * {
+        switch (mOp)
+        {
+            case EOpAny:
+            case EOpAll:
+            case EOpLength:
+            case EOpTranspose:
+            case EOpDeterminant:
+            case EOpInverse:
+            case EOpPackSnorm2x16:
+            case EOpUnpackSnorm2x16:
+            case EOpPackUnorm2x16:
+            case EOpUnpackUnorm2x16:
+            case EOpPackHalf2x16:
+            case EOpUnpackHalf2x16:
+                return operandConstant->foldUnaryNonComponentWise(mOp);
+            default:
+                return operandConstant->foldUnaryComponentWise(mOp, diagnostics);
+        }
+    };
+    const TIntermConstantUnion *operands[] = {operandConstant};
+    const TConstantUnion *constArray =
+        FoldWithCache(cache, mOp, *mType, operands, 1, diagnostics, foldOperation);
 
     // Nodes may be constant folded without being qualified as constant.
-    return CreateFoldedNode(constArray, this, mType.getQualifier());
+    return CreateFoldedNode(constArray, this, mType->getQualifier());
 }
 
-TIntermTyped *TIntermAggregate::fold(TDiagnostics *diagnostics)
+TIntermTyped *TIntermAggregate::fold(TDiagnostics *diagnostics, TConstantFoldingCache *cache)
 {
     // Make sure that all params are constant before actual constant folding.
+    TVector<const TIntermConstantUnion *> operands;
+    operands.reserve(getSequence()->size());
     for (auto *param : *getSequence())
     {
         if (param->getAsConstantUnion() == nullptr)
         {
             return nullptr;
         }
+        operands.push_back(param->getAsConstantUnion());
     }
-    TConstantUnion *constArray = nullptr;
-    if (isConstructor())
-        constArray = TIntermConstantUnion::FoldAggregateConstructor(this);
-    else
-        constArray = TIntermConstantUnion::FoldAggregateBuiltIn(this, diagnostics);
+    auto foldOperation = [&]() {
+        return isConstructor() ? TIntermConstantUnion::FoldAggregateConstructor(this)
+                               : TIntermConstantUnion::FoldAggregateBuiltIn(this, diagnostics);
+    };
+    const TConstantUnion *constArray = FoldWithCache(cache, mOp, *mType, operands.data(),
+                                                     operands.size(), diagnostics, foldOperation);
 
     // Nodes may be constant folded without being qualified as constant.
     TQualifier resultQualifier = areChildrenConstQualified() ? EvqConst : EvqTemporary;
@@ -1252,46 +1404,54 @@ TConstantUnion *TIntermConstantUnion::foldBinary(TOperator op,
 
     ASSERT(leftArray && rightArray);
 
-    size_t objectSize = getType().getObjectSize();
+    size_t objectSize  = getType().getObjectSize();
+    size_t leftStride  = 1;
+    size_t rightStride = 1;
 
     // for a case like float f = vec4(2, 3, 4, 5) + 1.2;
     if (rightNode->getType().getObjectSize() == 1 && objectSize > 1)
     {
-        rightArray = Vectorize(*rightNode->getUnionArrayPointer(), objectSize);
+        rightStride = 0;
     }
     else if (rightNode->getType().getObjectSize() > 1 && objectSize == 1)
     {
         // for a case like float f = 1.2 + vec4(2, 3, 4, 5);
-        leftArray  = Vectorize(*getUnionArrayPointer(), rightNode->getType().getObjectSize());
+        leftStride = 0;
         objectSize = rightNode->getType().getObjectSize();
     }
 
-    TConstantUnion *resultArray = nullptr;
-
+    TBasicType basicType = getType().getBasicType();
     switch (op)
     {
         case EOpAdd:
-            resultArray = new TConstantUnion[objectSize];
-            for (size_t i = 0; i < objectSize; i++)
-                resultArray[i] =
-                    TConstantUnion::add(leftArray[i], rightArray[i], diagnostics, line);
-            break;
+            return FoldArithmetic<AddOperation>(basicType, leftArray, leftStride, rightArray,
+                                                rightStride, objectSize, diagnostics, line);
         case EOpSub:
-            resultArray = new TConstantUnion[objectSize];
-            for (size_t i = 0; i < objectSize; i++)
-                resultArray[i] =
-                    TConstantUnion::sub(leftArray[i], rightArray[i], diagnostics, line);
-            break;
-
+            return FoldArithmetic<SubOperation>(basicType, leftArray, leftStride, rightArray,
+                                                rightStride, objectSize, diagnostics, line);
         case EOpMul:
         case EOpVectorTimesScalar:
         case EOpMatrixTimesScalar:
-            resultArray = new TConstantUnion[objectSize];
-            for (size_t i = 0; i < objectSize; i++)
-                resultArray[i] =
-                    TConstantUnion::mul(leftArray[i], rightArray[i], diagnostics, line);
+            return FoldArithmetic<MulOperation>(basicType, leftArray, leftStride, rightArray,
+                                                rightStride, objectSize, diagnostics, line);
+        default:
             break;
+    }
+
+    // The other operators work on operands with the same number of components.
+    if (leftStride == 0)
+    {
+        leftArray = Vectorize(*leftArray, objectSize);
+    }
+    if (rightStride == 0)
+    {
+        rightArray = Vectorize(*rightArray, objectSize);
+    }
 
+    TConstantUnion *resultArray = nullptr;
+
+    switch (op)
+    {
         case EOpMatrixTimesMatrix:
         {
             // TODO(jmadll): This code should check for overflows.
@@ -1309,14 +1469,13 @@ TConstantUnion *TIntermConstantUnion::foldBinary(TOperator op,
             {
                 for (int column = 0; column < resultCols; column++)
                 {
-                    resultArray[resultRows * column + row].setFConst(0.0f);
+                    float sum = 0.0f;
                     for (int i = 0; i < leftCols; i++)
                     {
-                        resultArray[resultRows * column + row].setFConst(
-                            resultArray[resultRows * column + row].getFConst() +
-                            leftArray[i * leftRows + row].getFConst() *
-                                rightArray[column * rightRows + i].getFConst());
+                        sum += leftArray[i * leftRows + row].getFConst() *
+                               rightArray[column * rightRows + i].getFConst();
                     }
+                    resultArray[resultRows * column + row].setFConst(sum);
                 }
             }
         }
@@ -1472,14 +1631,13 @@ TConstantUnion *TIntermConstantUnion::foldBinary(TOperator op,
 
             for (int matrixRow = 0; matrixRow < matrixRows; matrixRow++)
             {
-                resultArray[matrixRow].setFConst(0.0f);
+                float sum = 0.0f;
                 for (int col = 0; col < matrixCols; col++)
                 {
-                    resultArray[matrixRow].setFConst(
-                        resultArray[matrixRow].getFConst() +
-                        leftArray[col * matrixRows + matrixRow].getFConst() *
-                            rightArray[col].getFConst());
+                    sum += leftArray[col * matrixRows + matrixRow].getFConst() *
+                           rightArray[col].getFConst();
                 }
+                resultArray[matrixRow].setFConst(sum);
             }
         }
         break;
@@ -1496,14 +1654,13 @@ TConstantUnion *TIntermConstantUnion::foldBinary(TOperator op,
 
             for (int matrixCol = 0; matrixCol < matrixCols; matrixCol++)
             {
-                resultArray[matrixCol].setFConst(0.0f);
+                float sum = 0.0f;
                 for (int matrixRow = 0; matrixRow < matrixRows; matrixRow++)
                 {
-                    resultArray[matrixCol].setFConst(
-                        resultArray[matrixCol].getFConst() +
-                        leftArray[matrixRow].getFConst() *
-                            rightArray[matrixCol * matrixRows + matrixRow].getFConst());
+                    sum += leftArray[matrixRow].getFConst() *
+                           rightArray[matrixCol * matrixRows + matrixRow].getFConst();
                 }
+                resultArray[matrixCol].setFConst(sum);
             }
         }
         break;
@@ -2249,6 +2406,14 @@ TConstantUnion *TIntermConstantUnion::FoldAggregateConstructor(TIntermAggregate
         TIntermConstantUnion *argumentConstant   = argument->getAsConstantUnion();
         size_t argumentSize                      = argumentConstant->getType().getObjectSize();
         const TConstantUnion *argumentUnionArray = argumentConstant->getUnionArrayPointer();
+        if (argumentConstant->getBasicType() == basicType)
+        {
+            // The values don't need converting.
+            size_t copySize = std::min(argumentSize, resultSize - resultIndex);
+            std::copy(argumentUnionArray, argumentUnionArray + copySize, resultArray + resultIndex);
+            resultIndex += copySize;
+            continue;
+        }
         for (size_t i = 0u; i < argumentSize; ++i)
         {
             if (resultIndex >= resultSize)
@@ -30,6 +30,7 @@
 namespace sh
 {
 
+class TConstantFoldingCache;
 class TDiagnostics;
 
 class TIntermTraverser;
@@ -139,7 +140,7 @@ struct TIntermNodePair
 class TIntermTyped : public TIntermNode
 {
   public:
-    TIntermTyped(const TType &t) : mType(t) {}
+    TIntermTyped(const TType &t) { setType(t); }
 
     virtual TIntermTyped *deepCopy() const = 0;
 
@@ -147,30 +148,33 @@ class TIntermTyped : public TIntermNode
 
     virtual bool hasSideEffects() const = 0;
 
-    void setType(const TType &t) { mType = t; }
+    // The node points to a canonical copy of its type, which is never changed: setting the type,
+    // or a part of it, points the node to another copy.
+    void setType(const TType &t);
     void setTypePreservePrecision(const TType &t);
-    const TType &getType() const { return mType; }
-    TType *getTypePointer() { return &mType; }
-
-    TBasicType getBasicType() const { return mType.getBasicType(); }
-    TQualifier getQualifier() const { return mType.getQualifier(); }
-    TPrecision getPrecision() const { return mType.getPrecision(); }
-    TMemoryQualifier getMemoryQualifier() const { return mType.getMemoryQualifier(); }
-    int getCols() const { return mType.getCols(); }
-    int getRows() const { return mType.getRows(); }
-    int getNominalSize() const { return mType.getNominalSize(); }
-    int getSecondarySize() const { return mType.getSecondarySize(); }
-
-    bool isInterfaceBlock() const { return mType.isInterfaceBlock(); }
-    bool isMatrix() const { return mType.isMatrix(); }
-    bool isArray() const { return mType.isArray(); }
-    bool isVector() const { return mType.isVector(); }
-    bool isScalar() const { return mType.isScalar(); }
-    bool isScalarInt() const { return mType.isScalarInt(); }
-    const char *getBasicString() const { return mType.getBasicString(); }
-    TString getCompleteString() const { return mType.getCompleteString(); }
-
-    unsigned int getArraySize() const { return mType.getArraySize(); }
+    void setQualifier(TQualifier qualifier);
+    void setPrecision(TPrecision precision);
+    const TType &getType() const { return *mType; }
+
+    TBasicType getBasicType() const { return mType->getBasicType(); }
+    TQualifier getQualifier() const { return mType->getQualifier(); }
+    TPrecision getPrecision() const { return mType->getPrecision(); }
+    TMemoryQualifier getMemoryQualifier() const { return mType->getMemoryQualifier(); }
+    int getCols() const { return mType->getCols(); }
+    int getRows() const { return mType->getRows(); }
+    int getNominalSize() const { return mType->getNominalSize(); }
+    int getSecondarySize() const { return mType->getSecondarySize(); }
+
+    bool isInterfaceBlock() const { return mType->isInterfaceBlock(); }
+    bool isMatrix() const { return mType->isMatrix(); }
+    bool isArray() const { return mType->isArray(); }
+    bool isVector() const { return mType->isVector(); }
+    bool isScalar() const { return mType->isScalar(); }
+    bool isScalarInt() const { return mType->isScalarInt(); }
+    const char *getBasicString() const { return mType->getBasicString(); }
+    TString getCompleteString() const { return mType->getCompleteString(); }
+
+    unsigned int getArraySize() const { return mType->getArraySize(); }
 
     bool isConstructorWithOnlyConstantUnionParameters();
 
@@ -179,7 +183,7 @@ class TIntermTyped : public TIntermNode
     static TIntermTyped *CreateBool(bool value);
 
   protected:
-    TType mType;
+    const TType *mType;
 
     TIntermTyped(const TIntermTyped &node);
 };
@@ -271,6 +275,7 @@ class TIntermSymbol : public TIntermTyped
     const TName &getName() const { return mSymbol; }
 
     void setId(int newId) { mId = newId; }
+    void setName(const TString &name) { mSymbol.setString(name); }
 
     void setInternal(bool internal) { mSymbol.setInternal(internal); }
 
@@ -427,6 +432,7 @@ class TIntermSwizzle : public TIntermTyped
     bool hasSideEffects() const override { return mOperand->hasSideEffects(); }
 
     TIntermTyped *getOperand() { return mOperand; }
+    const TVector<int> &getSwizzleOffsets() const { return mSwizzleOffsets; }
     void writeOffsetsAsXYZW(TInfoSinkBase *out) const;
 
     bool hasDuplicateOffsets() const;
@@ -471,7 +477,9 @@ class TIntermBinary : public TIntermOperator
 
     TIntermTyped *getLeft() const { return mLeft; }
     TIntermTyped *getRight() const { return mRight; }
-    TIntermTyped *fold(TDiagnostics *diagnostics);
+    // Folds the operation if its operands are constant. The cache, when given, lets identical
+    // operations share the values they fold to.
+    TIntermTyped *fold(TDiagnostics *diagnostics, TConstantFoldingCache *cache = nullptr);
 
     void setAddIndexClamp() { mAddIndexClamp = true; }
     bool getAddIndexClamp() { return mAddIndexClamp; }
@@ -506,7 +514,7 @@ class TIntermUnary : public TIntermOperator
     bool hasSideEffects() const override { return isAssignment() || mOperand->hasSideEffects(); }
 
     TIntermTyped *getOperand() { return mOperand; }
-    TIntermTyped *fold(TDiagnostics *diagnostics);
+    TIntermTyped *fold(TDiagnostics *diagnostics, TConstantFoldingCache *cache = nullptr);
 
     void setUseEmulatedFunction() { mUseEmulatedFunction = true; }
     bool getUseEmulatedFunction() { return mUseEmulatedFunction; }
@@ -644,7 +652,7 @@ class TIntermAggregate : public TIntermOperator, public TIntermAggregateBase
 
     // Conservatively assume function calls and other aggregate operators have side-effects
     bool hasSideEffects() const override { return true; }
-    TIntermTyped *fold(TDiagnostics *diagnostics);
+    TIntermTyped *fold(TDiagnostics *diagnostics, TConstantFoldingCache *cache = nullptr);
 
     TIntermSequence *getSequence() override { return &mSequence; }
     const TIntermSequence *getSequence() const override { return &mSequence; }
@@ -913,6 +921,9 @@ class TIntermTraverser : angle::NonCopyable
 
     int getMaxDepth() const { return mMaxDepth; }
 
+    // True if the visit functions are only called before the children of a node are traversed.
+    bool visitsOnlyBeforeChildren() const { return preVisit && !inVisit && !postVisit; }
+
     // Return the original name if hash function pointer is NULL;
     // otherwise return the hashed name.
     static TString hash(const TString &name, ShHashFunction64 hashFunction);
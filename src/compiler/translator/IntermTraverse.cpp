@@ -162,7 +162,7 @@ TIntermSymbol *TIntermTraverser::createTempSymbol(const TType &type, TQualifier
     node->setInternal(true);
 
     ASSERT(qualifier == EvqTemporary || qualifier == EvqConst || qualifier == EvqGlobal);
-    node->getTypePointer()->setQualifier(qualifier);
+    node->setQualifier(qualifier);
     // TODO(oetuaho): Might be useful to sanitize layout qualifier etc. on the type of the created
     // symbol. This might need to be done in other places as well.
     return node;
@@ -665,7 +665,7 @@ void TLValueTrackingTraverser::traverseAggregate(TIntermAggregate *node)
                 TFunction call(&opString, &dummyReturnType, node->getOp());
                 for (auto *child : *sequence)
                 {
-                    TType *paramType = child->getAsTyped()->getTypePointer();
+                    const TType *paramType = &child->getAsTyped()->getType();
                     TConstParameter p(paramType);
                     call.addParameter(p);
                 }
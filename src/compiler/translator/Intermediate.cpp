@@ -221,7 +221,7 @@ TIntermTyped *TIntermediate::AddComma(TIntermTyped *left,
         commaNode->setLine(line);
     }
     TQualifier resultQualifier = TIntermBinary::GetCommaQualifier(shaderVersion, left, right);
-    commaNode->getTypePointer()->setQualifier(resultQualifier);
+    commaNode->setQualifier(resultQualifier);
     return commaNode;
 }
 
@@ -244,12 +244,12 @@ TIntermTyped *TIntermediate::AddTernarySelection(TIntermTyped *cond,
             TIntermTernary::DetermineQualifier(cond, trueExpression, falseExpression);
         if (cond->getAsConstantUnion()->getBConst(0))
         {
-            trueExpression->getTypePointer()->setQualifier(resultQualifier);
+            trueExpression->setQualifier(resultQualifier);
             return trueExpression;
         }
         else
         {
-            falseExpression->getTypePointer()->setQualifier(resultQualifier);
+            falseExpression->setQualifier(resultQualifier);
             return falseExpression;
         }
     }
@@ -351,7 +351,8 @@ TIntermBranch *TIntermediate::addBranch(TOperator branchOp,
 }
 
 TIntermTyped *TIntermediate::foldAggregateBuiltIn(TIntermAggregate *aggregate,
-                                                  TDiagnostics *diagnostics)
+                                                  TDiagnostics *diagnostics,
+                                                  TConstantFoldingCache *cache)
 {
     switch (aggregate->getOp())
     {
@@ -378,12 +379,12 @@ TIntermTyped *TIntermediate::foldAggregateBuiltIn(TIntermAggregate *aggregate,
         case EOpFaceForward:
         case EOpReflect:
         case EOpRefract:
-            return aggregate->fold(diagnostics);
+            return aggregate->fold(diagnostics, cache);
         default:
             // TODO: Add support for folding array constructors
             if (aggregate->isConstructor() && !aggregate->isArray())
             {
-                return aggregate->fold(diagnostics);
+                return aggregate->fold(diagnostics, cache);
             }
             // Constant folding not supported for the built-in.
             return nullptr;
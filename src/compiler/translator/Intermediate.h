@@ -71,7 +71,9 @@ class TIntermediate
 
     static void outputTree(TIntermNode *, TInfoSinkBase &);
 
-    TIntermTyped *foldAggregateBuiltIn(TIntermAggregate *aggregate, TDiagnostics *diagnostics);
+    TIntermTyped *foldAggregateBuiltIn(TIntermAggregate *aggregate,
+                                       TDiagnostics *diagnostics,
+                                       TConstantFoldingCache *cache);
 
   private:
     void operator=(TIntermediate &);  // prevent assignments
@@ -0,0 +1,370 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// MinifyOutput.cpp: Gives the names that aren't part of the shader interface short replacements,
+// and removes the whitespace and comments that the driver doesn't need from the output.
+//
+
+#include "compiler/translator/MinifyOutput.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "compiler/translator/InfoSink.h"
+#include "compiler/translator/IntermNode.h"
+#include "compiler/translator/SymbolTable.h"
+
+namespace sh
+{
+
+namespace
+{
+
+const char kLetters[]      = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+const char kAlphanumeric[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+const unsigned int kLetterCount       = 52u;
+const unsigned int kAlphanumericCount = 62u;
+
+// Returns the index-th name of the sequence a, b, ..., Z, a0, b0, ..., Z9, a00, ... Names that are
+// longer than a letter have a digit as their second character, so they can't be keywords, reserved
+// words or built-in names.
+TString MinifiedName(unsigned int index)
+{
+    if (index < kLetterCount)
+    {
+        return TString(1, kLetters[index]);
+    }
+    index -= kLetterCount;
+    TString name(1, kLetters[index % kLetterCount]);
+    index /= kLetterCount;
+    name += static_cast<char>('0' + index % 10u);
+    index /= 10u;
+    while (index > 0u)
+    {
+        --index;
+        name += kAlphanumeric[index % kAlphanumericCount];
+        index /= kAlphanumericCount;
+    }
+    return name;
+}
+
+// Qualifiers of variables can change when they are used in expressions, so this is only checked
+// where the variables are declared.
+bool IsMinifiableDeclaration(const TIntermSymbol *symbol)
+{
+    const TName &name = symbol->getName();
+    if (name.getString().empty() || name.getString().compare(0, 3, "gl_") == 0)
+    {
+        return false;
+    }
+    switch (symbol->getQualifier())
+    {
+        case EvqTemporary:
+        case EvqGlobal:
+        case EvqConst:
+        case EvqIn:
+        case EvqOut:
+        case EvqInOut:
+        case EvqConstReadOnly:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Internal variables get a prefix in the output, which keeps them apart from the user-defined
+// variables with the same name.
+TString GetOutputName(const TName &name)
+{
+    return name.isInternal() ? "webgl_angle_" + name.getString() : name.getString();
+}
+
+// Finds the names that can be replaced and how often they are referenced, and all the other names
+// that the output may contain.
+class CollectNamesTraverser : public TIntermTraverser
+{
+  public:
+    CollectNamesTraverser() : TIntermTraverser(true, false, false) {}
+
+    void visitSymbol(TIntermSymbol *node) override
+    {
+        recordType(node->getType());
+        if (mMinifiableIds.count(node->getId()) > 0)
+        {
+            ++mReferenceCounts[GetOutputName(node->getName())];
+            mSymbols.push_back(node);
+        }
+        else
+        {
+            mUsedNames.insert(node->getSymbol());
+        }
+    }
+
+    void visitConstantUnion(TIntermConstantUnion *node) override { recordType(node->getType()); }
+
+    bool visitFunctionDefinition(Visit visit, TIntermFunctionDefinition *node) override
+    {
+        recordType(node->getType());
+        recordFunction(node->getFunctionSymbolInfo(), true);
+        return true;
+    }
+
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override
+    {
+        recordType(node->getType());
+        if (node->getOp() == EOpPrototype)
+        {
+            recordFunction(node->getFunctionSymbolInfo(), true);
+        }
+        else if (node->getOp() == EOpFunctionCall)
+        {
+            recordFunction(node->getFunctionSymbolInfo(), node->isUserDefined());
+        }
+        if (node->getOp() == EOpPrototype || node->getOp() == EOpParameters)
+        {
+            for (TIntermNode *parameter : *node->getSequence())
+            {
+                recordDeclaration(parameter->getAsSymbolNode());
+            }
+        }
+        return true;
+    }
+
+    bool visitDeclaration(Visit visit, TIntermDeclaration *node) override
+    {
+        for (TIntermNode *declarator : *node->getSequence())
+        {
+            TIntermBinary *initialization = declarator->getAsBinaryNode();
+            if (initialization)
+            {
+                declarator = initialization->getLeft();
+            }
+            recordDeclaration(declarator->getAsSymbolNode());
+        }
+        return true;
+    }
+
+    // Assigns the replacements in the order of how often the names are referenced.
+    void assignNames(NameMap *minifiedNames) const
+    {
+        std::vector<std::pair<int, TString>> names;
+        for (const auto &count : mReferenceCounts)
+        {
+            names.push_back(std::make_pair(-count.second, count.first));
+        }
+        std::sort(names.begin(), names.end());
+
+        unsigned int nextIndex = 0u;
+        for (const auto &name : names)
+        {
+            TString minifiedName;
+            do
+            {
+                minifiedName = MinifiedName(nextIndex++);
+            } while (mUsedNames.count(minifiedName) > 0);
+            (*minifiedNames)[name.second.c_str()] = minifiedName.c_str();
+        }
+    }
+
+    const std::vector<TIntermSymbol *> &getSymbols() const { return mSymbols; }
+    const std::vector<TFunctionSymbolInfo *> &getFunctions() const { return mFunctions; }
+
+  private:
+    void recordDeclaration(const TIntermSymbol *symbol)
+    {
+        if (symbol && IsMinifiableDeclaration(symbol))
+        {
+            mMinifiableIds.insert(symbol->getId());
+        }
+    }
+
+    void recordFunction(TFunctionSymbolInfo *info, bool isUserDefined)
+    {
+        const TString name = TFunction::unmangleName(info->getName());
+        if (isUserDefined && !info->getNameObj().isInternal() && !info->isMain())
+        {
+            ++mReferenceCounts[name];
+            mFunctions.push_back(info);
+        }
+        else
+        {
+            mUsedNames.insert(name);
+        }
+    }
+
+    void recordFields(const TFieldListCollection *collection)
+    {
+        if (!mRecordedFieldLists.insert(collection).second)
+        {
+            return;
+        }
+        mUsedNames.insert(collection->name());
+        for (const TField *field : collection->fields())
+        {
+            mUsedNames.insert(field->name());
+            recordType(*field->type());
+        }
+    }
+
+    void recordType(const TType &type)
+    {
+        if (type.getStruct())
+        {
+            recordFields(type.getStruct());
+        }
+        if (type.getInterfaceBlock())
+        {
+            const TInterfaceBlock *interfaceBlock = type.getInterfaceBlock();
+            if (interfaceBlock->hasInstanceName())
+            {
+                mUsedNames.insert(interfaceBlock->instanceName());
+            }
+            recordFields(interfaceBlock);
+        }
+    }
+
+    std::set<int> mMinifiableIds;
+    std::map<TString, int> mReferenceCounts;
+    std::set<TString> mUsedNames;
+    std::set<const TFieldListCollection *> mRecordedFieldLists;
+    std::vector<TIntermSymbol *> mSymbols;
+    std::vector<TFunctionSymbolInfo *> mFunctions;
+};
+
+bool IsIdentifierCharacter(char c)
+{
+    // Dots are included so that numbers like 1. and .5 stay apart from their neighbors.
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' ||
+           c == '.';
+}
+
+// Returns whether whitespace between the two characters has to be kept for the tokens to stay
+// the same.
+bool NeedsSeparator(char previous, char next)
+{
+    if (IsIdentifierCharacter(previous) && IsIdentifierCharacter(next))
+    {
+        return true;
+    }
+    // The punctuators that would form a longer punctuator or a comment when written together.
+    switch (previous)
+    {
+        case '+':
+        case '-':
+        case '&':
+        case '|':
+        case '^':
+        case '<':
+        case '>':
+            return next == previous || next == '=';
+        case '*':
+        case '%':
+        case '!':
+        case '=':
+            return next == '=';
+        case '/':
+            return next == '=' || next == '/' || next == '*';
+        default:
+            return false;
+    }
+}
+
+}  // anonymous namespace
+
+void MinifyNames(TIntermNode *root, NameMap *minifiedNames)
+{
+    CollectNamesTraverser collect;
+    root->traverse(&collect);
+    collect.assignNames(minifiedNames);
+
+    for (TIntermSymbol *symbol : collect.getSymbols())
+    {
+        symbol->setName(minifiedNames->at(GetOutputName(symbol->getName()).c_str()).c_str());
+        symbol->setInternal(false);
+    }
+    for (TFunctionSymbolInfo *function : collect.getFunctions())
+    {
+        const TString &mangledName = function->getName();
+        size_t parenthesis         = mangledName.find('(');
+        TString name               = mangledName.substr(0, parenthesis);
+        TString minifiedName = minifiedNames->at(name.c_str()).c_str();
+        if (parenthesis != TString::npos)
+        {
+            minifiedName += mangledName.substr(parenthesis);
+        }
+        function->setName(minifiedName);
+    }
+}
+
+void MinifyWhitespace(TInfoSinkBase *sink)
+{
+    const std::string source = sink->str();
+    std::string minified;
+    minified.reserve(source.size());
+
+    bool atLineStart   = true;
+    bool hadWhitespace = false;
+    size_t index       = 0u;
+    while (index < source.size())
+    {
+        char c = source[index];
+        if (c == '\n')
+        {
+            atLineStart   = true;
+            hadWhitespace = true;
+            ++index;
+        }
+        else if (c == ' ' || c == '\t' || c == '\r')
+        {
+            hadWhitespace = true;
+            ++index;
+        }
+        else if (c == '/' && index + 1 < source.size() && source[index + 1] == '/')
+        {
+            index         = std::min(source.find('\n', index), source.size());
+            hadWhitespace = true;
+        }
+        else if (c == '/' && index + 1 < source.size() && source[index + 1] == '*')
+        {
+            size_t end    = source.find("*/", index + 2);
+            index         = end == std::string::npos ? source.size() : end + 2;
+            hadWhitespace = true;
+        }
+        else if (c == '#' && atLineStart)
+        {
+            if (!minified.empty() && minified.back() != '\n')
+            {
+                minified += '\n';
+            }
+            size_t end = std::min(source.find('\n', index), source.size());
+            minified.append(source, index, end - index);
+            minified += '\n';
+            index         = end;
+            hadWhitespace = false;
+        }
+        else
+        {
+            if (hadWhitespace && !minified.empty() && NeedsSeparator(minified.back(), c))
+            {
+                minified += ' ';
+            }
+            minified += c;
+            atLineStart   = false;
+            hadWhitespace = false;
+            ++index;
+        }
+    }
+    if (!minified.empty() && minified.back() != '\n')
+    {
+        minified += '\n';
+    }
+
+    sink->erase();
+    sink->append(minified.data(), minified.size());
+}
+
+}  // namespace sh
@@ -0,0 +1,33 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// MinifyOutput.h: Helpers for SH_MINIFY_OUTPUT, which makes the ESSL and GLSL outputs as short as
+// possible. Redundant parentheses are left out by TOutputGLSLBase itself.
+//
+
+#ifndef COMPILER_TRANSLATOR_MINIFYOUTPUT_H_
+#define COMPILER_TRANSLATOR_MINIFYOUTPUT_H_
+
+#include "compiler/translator/HashNames.h"
+
+namespace sh
+{
+class TInfoSinkBase;
+class TIntermNode;
+
+// Renames the local variables, including the temporary variables that ANGLE adds, the function
+// parameters, the user-defined functions and the global variables that aren't part of the shader
+// interface. The names that are referenced most get the shortest replacements. Every original name
+// gets one replacement that isn't used anywhere else in the shader, so the scoping of the shader
+// stays the same. The replaced names are added to minifiedNames.
+void MinifyNames(TIntermNode *root, NameMap *minifiedNames);
+
+// Removes comments and the whitespace that doesn't separate tokens. Preprocessor directives keep
+// lines of their own.
+void MinifyWhitespace(TInfoSinkBase *sink);
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_MINIFYOUTPUT_H_
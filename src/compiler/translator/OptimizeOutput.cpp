@@ -0,0 +1,858 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// OptimizeOutput.cpp: Propagates constants into local variable reads, folds the expressions that
+// become constant, removes dead stores and unused local variables, and computes repeated built-in
+// calls once per statement.
+//
+
+#include "compiler/translator/OptimizeOutput.h"
+
+#include <map>
+#include <string.h>
+#include <unordered_map>
+#include <vector>
+
+#include "compiler/translator/Diagnostics.h"
+#include "compiler/translator/InfoSink.h"
+#include "compiler/translator/IntermNode.h"
+#include "compiler/translator/Intermediate.h"
+
+namespace sh
+{
+
+namespace
+{
+
+// Each round of propagation, folding and removal can make more code removable. Real shaders
+// settle in two or three rounds.
+const int kMaxRounds = 8;
+
+// Limits the number of temporaries a single statement's repeated calls are moved into.
+const int kMaxTemporariesPerStatement = 16;
+
+// Unlike TIntermTyped::hasSideEffects(), knows that calling most built-in functions has none.
+class SideEffectTraverser : public TIntermTraverser
+{
+  public:
+    SideEffectTraverser() : TIntermTraverser(true, false, false), mHasSideEffects(false) {}
+
+    bool visitBinary(Visit visit, TIntermBinary *node) override
+    {
+        return record(node->isAssignment());
+    }
+    bool visitUnary(Visit visit, TIntermUnary *node) override
+    {
+        return record(node->isAssignment());
+    }
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override
+    {
+        // modf() writes its out parameter. Texture functions are calls too, and user-defined
+        // functions can do anything.
+        return record(node->getOp() == EOpFunctionCall || node->getOp() == EOpModf);
+    }
+
+    bool hasSideEffects() const { return mHasSideEffects; }
+
+  private:
+    bool record(bool hasSideEffects)
+    {
+        mHasSideEffects = mHasSideEffects || hasSideEffects;
+        return !mHasSideEffects;
+    }
+
+    bool mHasSideEffects;
+};
+
+bool HasSideEffects(TIntermNode *node)
+{
+    SideEffectTraverser traverser;
+    node->traverse(&traverser);
+    return traverser.hasSideEffects();
+}
+
+// Returns the variable that an l-value expression like v.x or a[i].y writes to.
+TIntermSymbol *GetBaseSymbol(TIntermTyped *node)
+{
+    while (true)
+    {
+        TIntermSwizzle *swizzle = node->getAsSwizzleNode();
+        TIntermBinary *binary   = node->getAsBinaryNode();
+        if (swizzle)
+        {
+            node = swizzle->getOperand();
+        }
+        else if (binary && (binary->getOp() == EOpIndexDirect ||
+                            binary->getOp() == EOpIndexIndirect ||
+                            binary->getOp() == EOpIndexDirectStruct))
+        {
+            node = binary->getLeft();
+        }
+        else
+        {
+            return node->getAsSymbolNode();
+        }
+    }
+}
+
+struct LocalVariable
+{
+    LocalVariable() : constantValue(nullptr), reads(0), writes(0), pinned(false) {}
+
+    // Set if the variable is initialized with a constant.
+    TIntermConstantUnion *constantValue;
+    int reads;
+    int writes;
+    // Set if some write to the variable can't be removed as a statement of its own, like a write
+    // through an out parameter or in the middle of an expression.
+    bool pinned;
+};
+
+typedef std::unordered_map<int, LocalVariable> LocalVariableMap;
+
+// Counts the reads and writes of variables declared in function bodies. Temporaries that earlier
+// passes added have id 0 and are left alone.
+class CollectLocalVariablesTraverser : public TLValueTrackingTraverser
+{
+  public:
+    CollectLocalVariablesTraverser(const TSymbolTable &symbolTable,
+                                   int shaderVersion,
+                                   LocalVariableMap *variables)
+        : TLValueTrackingTraverser(true, false, false, symbolTable, shaderVersion),
+          mVariables(variables)
+    {
+    }
+
+    bool visitDeclaration(Visit visit, TIntermDeclaration *node) override;
+    void visitSymbol(TIntermSymbol *node) override;
+
+  private:
+    bool isStatementLevelWrite(TIntermSymbol *node);
+
+    LocalVariableMap *mVariables;
+};
+
+bool CollectLocalVariablesTraverser::visitDeclaration(Visit visit, TIntermDeclaration *node)
+{
+    if (mInGlobalScope)
+    {
+        return true;
+    }
+    for (TIntermNode *declarator : *node->getSequence())
+    {
+        TIntermSymbol *symbol          = declarator->getAsSymbolNode();
+        TIntermBinary *initialization = declarator->getAsBinaryNode();
+        if (initialization)
+        {
+            ASSERT(initialization->getOp() == EOpInitialize);
+            symbol = initialization->getLeft()->getAsSymbolNode();
+        }
+        if (symbol == nullptr || symbol->getId() == 0)
+        {
+            continue;
+        }
+        LocalVariable &variable = (*mVariables)[symbol->getId()];
+        const TType &type       = symbol->getType();
+        if (initialization && type.getQualifier() == EvqTemporary && !type.isArray() &&
+            type.getStruct() == nullptr)
+        {
+            variable.constantValue = initialization->getRight()->getAsConstantUnion();
+        }
+    }
+    return true;
+}
+
+void CollectLocalVariablesTraverser::visitSymbol(TIntermSymbol *node)
+{
+    auto variable = mVariables->find(node->getId());
+    if (variable == mVariables->end())
+    {
+        return;
+    }
+    // Declaring the variable neither reads nor writes it.
+    TIntermBinary *parentBinary = getParentNode()->getAsBinaryNode();
+    if (getParentNode()->getAsDeclarationNode() ||
+        (parentBinary && parentBinary->getOp() == EOpInitialize && parentBinary->getLeft() == node))
+    {
+        return;
+    }
+    if (!isLValueRequiredHere())
+    {
+        ++variable->second.reads;
+        return;
+    }
+    ++variable->second.writes;
+    if (!isStatementLevelWrite(node))
+    {
+        variable->second.pinned = true;
+    }
+}
+
+// A write can be removed on its own if it's an assignment, increment or decrement statement that
+// writes to the variable or to a part of it.
+bool CollectLocalVariablesTraverser::isStatementLevelWrite(TIntermSymbol *node)
+{
+    TIntermNode *current = node;
+    for (unsigned int depth = 0u;; ++depth)
+    {
+        TIntermNode *parent = getAncestorNode(depth);
+        if (parent == nullptr)
+        {
+            return false;
+        }
+        TIntermSwizzle *swizzle = parent->getAsSwizzleNode();
+        TIntermBinary *binary   = parent->getAsBinaryNode();
+        TIntermUnary *unary     = parent->getAsUnaryNode();
+        if (swizzle || (binary && binary->getLeft() == current &&
+                        (binary->getOp() == EOpIndexDirect || binary->getOp() == EOpIndexIndirect ||
+                         binary->getOp() == EOpIndexDirectStruct)))
+        {
+            current = parent;
+            continue;
+        }
+        bool isStore = (binary && binary->isAssignment() && binary->getLeft() == current) ||
+                       (unary && unary->isAssignment());
+        TIntermNode *statementParent = getAncestorNode(depth + 1u);
+        return isStore && statementParent != nullptr && statementParent->getAsBlock() != nullptr;
+    }
+}
+
+// Replaces reads of constant local variables with the constant, folds what that makes constant,
+// prunes the branches that can't be taken, and removes statements that can't affect the results.
+class PropagateAndRemoveTraverser : public TIntermTraverser
+{
+  public:
+    PropagateAndRemoveTraverser(const LocalVariableMap &variables);
+
+    void visitSymbol(TIntermSymbol *node) override;
+    bool visitSwizzle(Visit visit, TIntermSwizzle *node) override;
+    bool visitBinary(Visit visit, TIntermBinary *node) override;
+    bool visitUnary(Visit visit, TIntermUnary *node) override;
+    bool visitTernary(Visit visit, TIntermTernary *node) override;
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override;
+    bool visitIfElse(Visit visit, TIntermIfElse *node) override;
+    bool visitLoop(Visit visit, TIntermLoop *node) override;
+    bool visitBlock(Visit visit, TIntermBlock *node) override;
+
+    bool changedTree() const { return mChangedTree; }
+
+  private:
+    const LocalVariable *findVariable(TIntermSymbol *symbol) const;
+    void replace(TIntermNode *node, TIntermNode *replacement);
+    void replaceWithFolded(TIntermTyped *node, TIntermTyped *folded, int errors, int warnings);
+    bool isUnusedDeclarator(TIntermNode *declarator) const;
+    bool isDeadStatement(TIntermNode *statement) const;
+
+    const LocalVariableMap &mVariables;
+    // Expressions that only fold with a warning, like a division by zero, are left for the
+    // driver, so the diagnostics are only kept to be counted.
+    TInfoSink mFoldingInfoSink;
+    TDiagnostics mFoldingDiagnostics;
+    TIntermediate mIntermediate;
+    bool mChangedTree;
+};
+
+PropagateAndRemoveTraverser::PropagateAndRemoveTraverser(const LocalVariableMap &variables)
+    : TIntermTraverser(false, false, true),
+      mVariables(variables),
+      mFoldingDiagnostics(mFoldingInfoSink),
+      mChangedTree(false)
+{
+}
+
+const LocalVariable *PropagateAndRemoveTraverser::findVariable(TIntermSymbol *symbol) const
+{
+    if (symbol == nullptr)
+    {
+        return nullptr;
+    }
+    auto variable = mVariables.find(symbol->getId());
+    return variable != mVariables.end() ? &variable->second : nullptr;
+}
+
+void PropagateAndRemoveTraverser::replace(TIntermNode *node, TIntermNode *replacement)
+{
+    bool replaced = getParentNode()->replaceChildNode(node, replacement);
+    ASSERT(replaced);
+    mChangedTree = true;
+}
+
+void PropagateAndRemoveTraverser::replaceWithFolded(TIntermTyped *node,
+                                                    TIntermTyped *folded,
+                                                    int errors,
+                                                    int warnings)
+{
+    if (folded != nullptr && folded != node && mFoldingDiagnostics.numErrors() == errors &&
+        mFoldingDiagnostics.numWarnings() == warnings)
+    {
+        replace(node, folded);
+    }
+}
+
+void PropagateAndRemoveTraverser::visitSymbol(TIntermSymbol *node)
+{
+    const LocalVariable *variable = findVariable(node);
+    if (variable == nullptr || variable->constantValue == nullptr || variable->writes > 0)
+    {
+        return;
+    }
+    TIntermBinary *parentBinary = getParentNode()->getAsBinaryNode();
+    if (parentBinary && parentBinary->getOp() == EOpInitialize && parentBinary->getLeft() == node)
+    {
+        return;
+    }
+    TType type(node->getType());
+    type.setQualifier(EvqConst);
+    TIntermConstantUnion *constant =
+        new TIntermConstantUnion(variable->constantValue->getUnionArrayPointer(), type);
+    constant->setLine(node->getLine());
+    replace(node, constant);
+}
+
+bool PropagateAndRemoveTraverser::visitSwizzle(Visit visit, TIntermSwizzle *node)
+{
+    if (node->getOperand()->getAsConstantUnion())
+    {
+        replaceWithFolded(node, node->fold(), mFoldingDiagnostics.numErrors(),
+                          mFoldingDiagnostics.numWarnings());
+    }
+    return true;
+}
+
+bool PropagateAndRemoveTraverser::visitBinary(Visit visit, TIntermBinary *node)
+{
+    TOperator op = node->getOp();
+    if (node->isAssignment() || op == EOpInitialize || op == EOpComma)
+    {
+        return true;
+    }
+    TIntermConstantUnion *right = node->getRight()->getAsConstantUnion();
+    if (right == nullptr)
+    {
+        return true;
+    }
+    if (node->getLeft()->getAsConstantUnion())
+    {
+        int errors   = mFoldingDiagnostics.numErrors();
+        int warnings = mFoldingDiagnostics.numWarnings();
+        replaceWithFolded(node, node->fold(&mFoldingDiagnostics), errors, warnings);
+        return true;
+    }
+
+    // An index that became constant doesn't need the dynamic indexing workarounds.
+    const TType &indexedType = node->getLeft()->getType();
+    if (op == EOpIndexIndirect && right->getType().getObjectSize() == 1u)
+    {
+        int size = indexedType.isArray()
+                       ? static_cast<int>(indexedType.getArraySize())
+                       : (indexedType.isMatrix() ? indexedType.getCols()
+                                                 : indexedType.getNominalSize());
+        int index = right->getBasicType() == EbtUInt ? static_cast<int>(right->getUConst(0))
+                                                     : right->getIConst(0);
+        if (index >= 0 && index < size)
+        {
+            TIntermBinary *direct = new TIntermBinary(EOpIndexDirect, node->getLeft(), right);
+            direct->setLine(node->getLine());
+            replace(node, direct);
+        }
+    }
+    return true;
+}
+
+bool PropagateAndRemoveTraverser::visitUnary(Visit visit, TIntermUnary *node)
+{
+    if (!node->isAssignment() && node->getOperand()->getAsConstantUnion())
+    {
+        int errors   = mFoldingDiagnostics.numErrors();
+        int warnings = mFoldingDiagnostics.numWarnings();
+        replaceWithFolded(node, node->fold(&mFoldingDiagnostics), errors, warnings);
+    }
+    return true;
+}
+
+bool PropagateAndRemoveTraverser::visitTernary(Visit visit, TIntermTernary *node)
+{
+    TIntermConstantUnion *condition = node->getCondition()->getAsConstantUnion();
+    if (condition)
+    {
+        replace(node, condition->getBConst(0) ? node->getTrueExpression()
+                                              : node->getFalseExpression());
+    }
+    return true;
+}
+
+bool PropagateAndRemoveTraverser::visitAggregate(Visit visit, TIntermAggregate *node)
+{
+    if (node->getOp() == EOpFunctionCall)
+    {
+        return true;
+    }
+    for (TIntermNode *argument : *node->getSequence())
+    {
+        if (argument->getAsConstantUnion() == nullptr)
+        {
+            return true;
+        }
+    }
+    int errors   = mFoldingDiagnostics.numErrors();
+    int warnings = mFoldingDiagnostics.numWarnings();
+    replaceWithFolded(node, mIntermediate.foldAggregateBuiltIn(node, &mFoldingDiagnostics, nullptr),
+                      errors, warnings);
+    return true;
+}
+
+bool PropagateAndRemoveTraverser::visitIfElse(Visit visit, TIntermIfElse *node)
+{
+    TIntermConstantUnion *condition = node->getCondition()->getAsConstantUnion();
+    TIntermBlock *parentBlock       = getParentNode()->getAsBlock();
+    if (condition == nullptr || parentBlock == nullptr)
+    {
+        return true;
+    }
+    TIntermBlock *taken = condition->getBConst(0) ? node->getTrueBlock() : node->getFalseBlock();
+    if (taken)
+    {
+        replace(node, taken);
+    }
+    else
+    {
+        mMultiReplacements.push_back(
+            NodeReplaceWithMultipleEntry(parentBlock, node, TIntermSequence()));
+        mChangedTree = true;
+    }
+    return true;
+}
+
+bool PropagateAndRemoveTraverser::visitLoop(Visit visit, TIntermLoop *node)
+{
+    TIntermBlock *parentBlock = getParentNode()->getAsBlock();
+    if (parentBlock == nullptr || node->getType() == ELoopDoWhile || node->getCondition() == nullptr)
+    {
+        return true;
+    }
+    // A for loop's init statement runs even when the condition is false.
+    TIntermConstantUnion *condition = node->getCondition()->getAsConstantUnion();
+    if (condition && !condition->getBConst(0) &&
+        (node->getInit() == nullptr || !HasSideEffects(node->getInit())))
+    {
+        mMultiReplacements.push_back(
+            NodeReplaceWithMultipleEntry(parentBlock, node, TIntermSequence()));
+        mChangedTree = true;
+    }
+    return true;
+}
+
+bool PropagateAndRemoveTraverser::isUnusedDeclarator(TIntermNode *declarator) const
+{
+    TIntermSymbol *symbol         = declarator->getAsSymbolNode();
+    TIntermTyped *initializer     = nullptr;
+    TIntermBinary *initialization = declarator->getAsBinaryNode();
+    if (initialization)
+    {
+        symbol      = initialization->getLeft()->getAsSymbolNode();
+        initializer = initialization->getRight();
+    }
+    const LocalVariable *variable = findVariable(symbol);
+    // A struct declaration can also define the struct.
+    if (variable == nullptr || variable->reads > 0 || variable->writes > 0 ||
+        symbol->getType().getStruct() != nullptr)
+    {
+        return false;
+    }
+    return initializer == nullptr || !HasSideEffects(initializer);
+}
+
+bool PropagateAndRemoveTraverser::isDeadStatement(TIntermNode *statement) const
+{
+    TIntermTyped *expression = statement->getAsTyped();
+    if (expression == nullptr)
+    {
+        return false;
+    }
+    TIntermBinary *binary = expression->getAsBinaryNode();
+    TIntermUnary *unary   = expression->getAsUnaryNode();
+    TIntermTyped *target  = nullptr;
+    if (binary && binary->isAssignment())
+    {
+        if (HasSideEffects(binary->getRight()))
+        {
+            return false;
+        }
+        target = binary->getLeft();
+    }
+    else if (unary && unary->isAssignment())
+    {
+        target = unary->getOperand();
+    }
+    else
+    {
+        // An expression statement that doesn't store anything.
+        return !HasSideEffects(expression);
+    }
+    if (HasSideEffects(target))
+    {
+        return false;
+    }
+    const LocalVariable *variable = findVariable(GetBaseSymbol(target));
+    return variable != nullptr && variable->reads == 0 && !variable->pinned;
+}
+
+bool PropagateAndRemoveTraverser::visitBlock(Visit visit, TIntermBlock *node)
+{
+    if (mInGlobalScope)
+    {
+        return true;
+    }
+    for (TIntermNode *statement : *node->getSequence())
+    {
+        TIntermDeclaration *declaration = statement->getAsDeclarationNode();
+        if (declaration == nullptr)
+        {
+            if (isDeadStatement(statement))
+            {
+                mMultiReplacements.push_back(
+                    NodeReplaceWithMultipleEntry(node, statement, TIntermSequence()));
+                mChangedTree = true;
+            }
+            continue;
+        }
+
+        TIntermSequence *declarators = declaration->getSequence();
+        std::vector<TIntermNode *> unusedDeclarators;
+        for (TIntermNode *declarator : *declarators)
+        {
+            if (isUnusedDeclarator(declarator))
+            {
+                unusedDeclarators.push_back(declarator);
+            }
+        }
+        if (unusedDeclarators.size() == declarators->size())
+        {
+            mMultiReplacements.push_back(
+                NodeReplaceWithMultipleEntry(node, declaration, TIntermSequence()));
+        }
+        else
+        {
+            for (TIntermNode *declarator : unusedDeclarators)
+            {
+                mMultiReplacements.push_back(
+                    NodeReplaceWithMultipleEntry(declaration, declarator, TIntermSequence()));
+            }
+        }
+        mChangedTree = mChangedTree || !unusedDeclarators.empty();
+    }
+    return true;
+}
+
+bool IsBuiltInCall(TIntermTyped *node)
+{
+    TIntermUnary *unary         = node->getAsUnaryNode();
+    TIntermAggregate *aggregate = node->getAsAggregate();
+    if (unary)
+    {
+        return unary->getOp() >= EOpRadians;
+    }
+    return aggregate && aggregate->getOp() >= EOpRadians && aggregate->getOp() <= EOpAll &&
+           aggregate->getOp() != EOpModf;
+}
+
+template <typename T>
+void AppendBytes(TString *key, const T &value)
+{
+    char bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    key->append(bytes, sizeof(T));
+}
+
+// Writes a key that is the same for two expressions if and only if they compute the same value
+// when evaluated in the same place. Returns false for expressions that contain calls.
+bool AppendExpressionKey(TIntermTyped *node, TString *key)
+{
+    if (TIntermSymbol *symbol = node->getAsSymbolNode())
+    {
+        key->push_back('S');
+        AppendBytes(key, symbol->getId());
+        // Temporaries all have id 0.
+        *key += symbol->getSymbol();
+        key->push_back('\0');
+        return true;
+    }
+    if (TIntermConstantUnion *constant = node->getAsConstantUnion())
+    {
+        key->push_back('C');
+        AppendBytes(key, constant->getBasicType());
+        for (size_t i = 0; i < constant->getType().getObjectSize(); ++i)
+        {
+            switch (constant->getBasicType())
+            {
+                case EbtFloat:
+                    AppendBytes(key, constant->getFConst(i));
+                    break;
+                case EbtInt:
+                    AppendBytes(key, constant->getIConst(i));
+                    break;
+                case EbtUInt:
+                    AppendBytes(key, constant->getUConst(i));
+                    break;
+                case EbtBool:
+                    AppendBytes(key, constant->getBConst(i));
+                    break;
+                default:
+                    return false;
+            }
+        }
+        // Constant vectors of the same values can still differ in size.
+        AppendBytes(key, constant->getType().getObjectSize());
+        return true;
+    }
+    if (TIntermSwizzle *swizzle = node->getAsSwizzleNode())
+    {
+        key->push_back('W');
+        for (int offset : swizzle->getSwizzleOffsets())
+        {
+            key->push_back(static_cast<char>('0' + offset));
+        }
+        key->push_back('\0');
+        return AppendExpressionKey(swizzle->getOperand(), key);
+    }
+    if (TIntermUnary *unary = node->getAsUnaryNode())
+    {
+        key->push_back('U');
+        AppendBytes(key, unary->getOp());
+        return !unary->isAssignment() && AppendExpressionKey(unary->getOperand(), key);
+    }
+    if (TIntermBinary *binary = node->getAsBinaryNode())
+    {
+        key->push_back('B');
+        AppendBytes(key, binary->getOp());
+        return !binary->isAssignment() && AppendExpressionKey(binary->getLeft(), key) &&
+               AppendExpressionKey(binary->getRight(), key);
+    }
+    TIntermAggregate *aggregate = node->getAsAggregate();
+    if (aggregate == nullptr || aggregate->getOp() == EOpFunctionCall ||
+        aggregate->getOp() == EOpModf || aggregate->getOp() == EOpConstructStruct ||
+        aggregate->isArray())
+    {
+        return false;
+    }
+    key->push_back('A');
+    AppendBytes(key, aggregate->getOp());
+    AppendBytes(key, aggregate->getSequence()->size());
+    for (TIntermNode *argument : *aggregate->getSequence())
+    {
+        if (!AppendExpressionKey(argument->getAsTyped(), key))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct BuiltInCall
+{
+    TIntermNode *parent;
+    TIntermTyped *node;
+    TString key;
+};
+
+// Collects the built-in calls in an expression that are always evaluated when the expression is,
+// in the order they appear.
+void CollectBuiltInCalls(TIntermNode *parent, TIntermTyped *node, std::vector<BuiltInCall> *calls)
+{
+    if (IsBuiltInCall(node))
+    {
+        BuiltInCall call;
+        call.parent = parent;
+        call.node   = node;
+        if (AppendExpressionKey(node, &call.key))
+        {
+            calls->push_back(call);
+        }
+    }
+
+    if (TIntermSwizzle *swizzle = node->getAsSwizzleNode())
+    {
+        CollectBuiltInCalls(node, swizzle->getOperand(), calls);
+    }
+    else if (TIntermUnary *unary = node->getAsUnaryNode())
+    {
+        CollectBuiltInCalls(node, unary->getOperand(), calls);
+    }
+    else if (TIntermBinary *binary = node->getAsBinaryNode())
+    {
+        CollectBuiltInCalls(node, binary->getLeft(), calls);
+        if (binary->getOp() != EOpLogicalAnd && binary->getOp() != EOpLogicalOr)
+        {
+            CollectBuiltInCalls(node, binary->getRight(), calls);
+        }
+    }
+    else if (TIntermTernary *ternary = node->getAsTernaryNode())
+    {
+        CollectBuiltInCalls(node, ternary->getCondition(), calls);
+    }
+    else if (TIntermAggregate *aggregate = node->getAsAggregate())
+    {
+        for (TIntermNode *argument : *aggregate->getSequence())
+        {
+            CollectBuiltInCalls(node, argument->getAsTyped(), calls);
+        }
+    }
+}
+
+// Returns the expression of a statement that is evaluated right before the statement's effect,
+// so that its built-in calls can move into temporaries declared before the statement.
+TIntermTyped *GetStatementExpression(TIntermNode *statement)
+{
+    TIntermTyped *expression = nullptr;
+    if (TIntermBinary *assignment = statement->getAsBinaryNode())
+    {
+        if (assignment->isAssignment() && !HasSideEffects(assignment->getLeft()))
+        {
+            expression = assignment->getRight();
+        }
+    }
+    else if (TIntermDeclaration *declaration = statement->getAsDeclarationNode())
+    {
+        TIntermBinary *initialization = declaration->getSequence()->size() == 1u
+                                            ? declaration->getSequence()->back()->getAsBinaryNode()
+                                            : nullptr;
+        if (initialization && initialization->getType().getQualifier() == EvqTemporary)
+        {
+            expression = initialization->getRight();
+        }
+    }
+    else if (TIntermBranch *branch = statement->getAsBranchNode())
+    {
+        if (branch->getFlowOp() == EOpReturn)
+        {
+            expression = branch->getExpression();
+        }
+    }
+    else if (TIntermIfElse *ifElse = statement->getAsIfElseNode())
+    {
+        expression = ifElse->getCondition();
+    }
+    if (expression == nullptr || HasSideEffects(expression))
+    {
+        return nullptr;
+    }
+    return expression;
+}
+
+// Moves the built-in calls that a statement repeats into temporaries.
+class ReuseBuiltInCallsTraverser : public TIntermTraverser
+{
+  public:
+    ReuseBuiltInCallsTraverser() : TIntermTraverser(true, false, false) {}
+
+    bool visitBlock(Visit visit, TIntermBlock *node) override;
+
+  private:
+    bool moveRepeatedCall(TIntermTyped *expression, TIntermSequence *hoisted);
+};
+
+bool ReuseBuiltInCallsTraverser::moveRepeatedCall(TIntermTyped *expression,
+                                                  TIntermSequence *hoisted)
+{
+    std::vector<BuiltInCall> calls;
+    CollectBuiltInCalls(nullptr, expression, &calls);
+
+    std::map<TString, size_t> firstCalls;
+    for (size_t i = 0; i < calls.size(); ++i)
+    {
+        auto first = firstCalls.insert(std::make_pair(calls[i].key, i));
+        if (first.second)
+        {
+            continue;
+        }
+        // The call is repeated. The first call becomes the temporary's initializer, and all of
+        // them are replaced by the temporary.
+        const BuiltInCall &firstCall = calls[first.first->second];
+        if (firstCall.parent == nullptr)
+        {
+            return false;
+        }
+        hoisted->push_back(createTempInitDeclaration(firstCall.node));
+        for (const BuiltInCall &call : calls)
+        {
+            if (call.key == firstCall.key)
+            {
+                bool replaced = call.parent->replaceChildNode(
+                    call.node, createTempSymbol(firstCall.node->getType()));
+                ASSERT(replaced);
+            }
+        }
+        nextTemporaryIndex();
+        return true;
+    }
+    return false;
+}
+
+bool ReuseBuiltInCallsTraverser::visitBlock(Visit visit, TIntermBlock *node)
+{
+    if (mInGlobalScope)
+    {
+        return true;
+    }
+    TIntermSequence *statements = node->getSequence();
+    for (TIntermNode *statement : *statements)
+    {
+        // Declarations can't go between case labels.
+        if (statement->getAsCaseNode())
+        {
+            return true;
+        }
+    }
+
+    TIntermSequence optimized;
+    for (TIntermNode *statement : *statements)
+    {
+        TIntermTyped *expression = GetStatementExpression(statement);
+        if (expression)
+        {
+            TIntermSequence hoisted;
+            for (int i = 0; i < kMaxTemporariesPerStatement; ++i)
+            {
+                if (!moveRepeatedCall(expression, &hoisted))
+                {
+                    break;
+                }
+            }
+            optimized.insert(optimized.end(), hoisted.begin(), hoisted.end());
+        }
+        optimized.push_back(statement);
+    }
+    statements->swap(optimized);
+    return true;
+}
+
+}  // anonymous namespace
+
+void OptimizeOutput(TIntermBlock *root,
+                    const TSymbolTable &symbolTable,
+                    int shaderVersion,
+                    unsigned int *temporaryIndex)
+{
+    for (int round = 0; round < kMaxRounds; ++round)
+    {
+        LocalVariableMap variables;
+        CollectLocalVariablesTraverser collect(symbolTable, shaderVersion, &variables);
+        root->traverse(&collect);
+
+        PropagateAndRemoveTraverser propagateAndRemove(variables);
+        root->traverse(&propagateAndRemove);
+        propagateAndRemove.updateTree();
+        if (!propagateAndRemove.changedTree())
+        {
+            break;
+        }
+    }
+
+    ReuseBuiltInCallsTraverser reuseBuiltInCalls;
+    reuseBuiltInCalls.useTemporaryIndex(temporaryIndex);
+    root->traverse(&reuseBuiltInCalls);
+}
+
+}  // namespace sh
@@ -0,0 +1,32 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// OptimizeOutput.h: Removes code from function bodies that can't affect the results of a shader
+// and computes repeated built-in calls once, so that the driver gets less code to compile:
+//  - local variables that are initialized with a constant and never written again are replaced
+//    by the constant, and the expressions that become constant are folded.
+//  - stores to local variables that are never read, and local variables that are never used, are
+//    removed.
+//  - if statements and ternary operators whose condition became constant are pruned.
+//  - calls to built-in functions that a statement repeats with the same arguments are computed
+//    once into a temporary variable.
+//
+
+#ifndef COMPILER_TRANSLATOR_OPTIMIZEOUTPUT_H_
+#define COMPILER_TRANSLATOR_OPTIMIZEOUTPUT_H_
+
+namespace sh
+{
+class TIntermBlock;
+class TSymbolTable;
+
+void OptimizeOutput(TIntermBlock *root,
+                    const TSymbolTable &symbolTable,
+                    int shaderVersion,
+                    unsigned int *temporaryIndex);
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_OPTIMIZEOUTPUT_H_
@@ -17,7 +17,8 @@ TOutputESSL::TOutputESSL(TInfoSinkBase &objSink,
                          sh::GLenum shaderType,
                          int shaderVersion,
                          bool forceHighp,
-                         ShCompileOptions compileOptions)
+                         ShCompileOptions compileOptions,
+                         const NameMap &minifiedNames)
     : TOutputGLSLBase(objSink,
                       clampingStrategy,
                       hashFunction,
@@ -26,7 +27,8 @@ TOutputESSL::TOutputESSL(TInfoSinkBase &objSink,
                       shaderType,
                       shaderVersion,
                       SH_ESSL_OUTPUT,
-                      compileOptions),
+                      compileOptions,
+                      minifiedNames),
       mForceHighp(forceHighp)
 {
 }
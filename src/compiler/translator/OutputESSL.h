@@ -23,7 +23,8 @@ class TOutputESSL : public TOutputGLSLBase
                 sh::GLenum shaderType,
                 int shaderVersion,
                 bool forceHighp,
-                ShCompileOptions compileOptions);
+                ShCompileOptions compileOptions,
+                const NameMap &minifiedNames);
 
   protected:
     bool writeVariablePrecision(TPrecision precision) override;
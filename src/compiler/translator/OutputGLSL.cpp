@@ -17,7 +17,8 @@ TOutputGLSL::TOutputGLSL(TInfoSinkBase &objSink,
                          sh::GLenum shaderType,
                          int shaderVersion,
                          ShShaderOutput output,
-                         ShCompileOptions compileOptions)
+                         ShCompileOptions compileOptions,
+                         const NameMap &minifiedNames)
     : TOutputGLSLBase(objSink,
                       clampingStrategy,
                       hashFunction,
@@ -26,7 +27,8 @@ TOutputGLSL::TOutputGLSL(TInfoSinkBase &objSink,
                       shaderType,
                       shaderVersion,
                       output,
-                      compileOptions)
+                      compileOptions,
+                      minifiedNames)
 {
 }
 
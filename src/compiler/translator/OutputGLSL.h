@@ -23,7 +23,8 @@ class TOutputGLSL : public TOutputGLSLBase
                 sh::GLenum shaderType,
                 int shaderVersion,
                 ShShaderOutput output,
-                ShCompileOptions compileOptions);
+                ShCompileOptions compileOptions,
+                const NameMap &minifiedNames);
 
   protected:
     bool writeVariablePrecision(TPrecision) override;
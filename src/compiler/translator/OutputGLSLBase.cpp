@@ -10,18 +10,17 @@
 #include "common/mathutil.h"
 
 #include <cfloat>
+#include <cmath>
 
 namespace sh
 {
 
 namespace
 {
-TString arrayBrackets(const TType &type)
+void writeArrayBrackets(TInfoSinkBase &out, const TType &type)
 {
     ASSERT(type.isArray());
-    TInfoSinkBase out;
     out << "[" << type.getArraySize() << "]";
-    return TString(out.c_str());
 }
 
 bool isSingleStatement(TIntermNode *node)
@@ -79,6 +78,175 @@ bool NeedsToWriteLayoutQualifier(const TType &type)
     return false;
 }
 
+// Returns the precedence of the operator at the root of an expression, from 1 for the comma
+// operator to 17 for function calls, constructors and variables.
+int GetPrecedence(TIntermTyped *node)
+{
+    if (TIntermBinary *binary = node->getAsBinaryNode())
+    {
+        switch (binary->getOp())
+        {
+            case EOpComma:
+                return 1;
+            case EOpLogicalOr:
+                return 4;
+            case EOpLogicalXor:
+                return 5;
+            case EOpLogicalAnd:
+                return 6;
+            case EOpBitwiseOr:
+                return 7;
+            case EOpBitwiseXor:
+                return 8;
+            case EOpBitwiseAnd:
+                return 9;
+            case EOpEqual:
+            case EOpNotEqual:
+                return 10;
+            case EOpLessThan:
+            case EOpGreaterThan:
+            case EOpLessThanEqual:
+            case EOpGreaterThanEqual:
+                return 11;
+            case EOpBitShiftLeft:
+            case EOpBitShiftRight:
+                return 12;
+            case EOpAdd:
+            case EOpSub:
+                return 13;
+            case EOpMul:
+            case EOpDiv:
+            case EOpIMod:
+            case EOpVectorTimesScalar:
+            case EOpVectorTimesMatrix:
+            case EOpMatrixTimesVector:
+            case EOpMatrixTimesScalar:
+            case EOpMatrixTimesMatrix:
+                return 14;
+            case EOpIndexDirect:
+            case EOpIndexIndirect:
+            case EOpIndexDirectStruct:
+            case EOpIndexDirectInterfaceBlock:
+                return 16;
+            default:
+                // Assignments and initializers.
+                return 2;
+        }
+    }
+    if (TIntermUnary *unary = node->getAsUnaryNode())
+    {
+        switch (unary->getOp())
+        {
+            case EOpNegative:
+            case EOpPositive:
+            case EOpLogicalNot:
+            case EOpBitwiseNot:
+            case EOpPreIncrement:
+            case EOpPreDecrement:
+                return 15;
+            case EOpPostIncrement:
+            case EOpPostDecrement:
+                return 16;
+            default:
+                // Built-in functions.
+                return 17;
+        }
+    }
+    if (node->getAsTernaryNode())
+    {
+        return 3;
+    }
+    if (node->getAsSwizzleNode())
+    {
+        return 16;
+    }
+    if (TIntermConstantUnion *constant = node->getAsConstantUnion())
+    {
+        if (constant->getType().getObjectSize() > 1 || constant->getBasicType() == EbtStruct)
+        {
+            return 17;
+        }
+        // A scalar constant can't be swizzled or indexed without parentheses, and a negative one
+        // is written like a negated value.
+        switch (constant->getBasicType())
+        {
+            case EbtFloat:
+                return std::signbit(constant->getFConst(0)) ? 14 : 15;
+            case EbtInt:
+                return constant->getIConst(0) < 0 ? 14 : 15;
+            default:
+                return 15;
+        }
+    }
+    return 17;
+}
+
+// Leaves out the characters that don't change the value of a float literal, like in 1. and .5.
+std::string MinifyFloat(std::string text)
+{
+    size_t exponent = text.find('e');
+    if (exponent != std::string::npos)
+    {
+        size_t digits = exponent + 1;
+        if (text[digits] == '+')
+        {
+            text.erase(digits, 1);
+        }
+        else if (text[digits] == '-')
+        {
+            ++digits;
+        }
+        while (digits + 1 < text.size() && text[digits] == '0')
+        {
+            text.erase(digits, 1);
+        }
+        return text;
+    }
+    if (text.size() > 2 && text.compare(text.size() - 2, 2, ".0") == 0)
+    {
+        text.erase(text.size() - 1);
+    }
+    size_t integerPart = text[0] == '-' ? 1 : 0;
+    if (text.size() > integerPart + 2 && text.compare(integerPart, 2, "0.") == 0)
+    {
+        text.erase(integerPart, 1);
+    }
+    return text;
+}
+
+// Returns whether all the components of a vector constant are the same, so that it can be written
+// with a single argument to its constructor.
+bool IsSplat(const TConstantUnion *components, size_t size)
+{
+    for (size_t i = 1; i < size; ++i)
+    {
+        const TConstantUnion &component = components[i];
+        switch (component.getType())
+        {
+            case EbtFloat:
+                if (gl::bitCast<uint32_t>(component.getFConst()) !=
+                    gl::bitCast<uint32_t>(components[0].getFConst()))
+                    return false;
+                break;
+            case EbtInt:
+                if (component.getIConst() != components[0].getIConst())
+                    return false;
+                break;
+            case EbtUInt:
+                if (component.getUConst() != components[0].getUConst())
+                    return false;
+                break;
+            case EbtBool:
+                if (component.getBConst() != components[0].getBConst())
+                    return false;
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace
 
 TOutputGLSLBase::TOutputGLSLBase(TInfoSinkBase &objSink,
@@ -89,7 +257,8 @@ TOutputGLSLBase::TOutputGLSLBase(TInfoSinkBase &objSink,
                                  sh::GLenum shaderType,
                                  int shaderVersion,
                                  ShShaderOutput output,
-                                 ShCompileOptions compileOptions)
+                                 ShCompileOptions compileOptions,
+                                 const NameMap &minifiedNames)
     : TIntermTraverser(true, true, true),
       mObjSink(objSink),
       mDeclaringVariables(false),
@@ -100,8 +269,13 @@ TOutputGLSLBase::TOutputGLSLBase(TInfoSinkBase &objSink,
       mShaderType(shaderType),
       mShaderVersion(shaderVersion),
       mOutput(output),
-      mCompileOptions(compileOptions)
+      mCompileOptions(compileOptions),
+      mMinify((compileOptions & SH_MINIFY_OUTPUT) != 0)
 {
+    for (const auto &minifiedName : minifiedNames)
+    {
+        mMinifiedNames.insert(minifiedName.second.c_str());
+    }
 }
 
 void TOutputGLSLBase::writeInvariantQualifier(const TType &type)
@@ -119,6 +293,12 @@ void TOutputGLSLBase::writeFloat(TInfoSinkBase &out, float f)
     {
         out << "uintBitsToFloat(" << gl::bitCast<uint32_t>(f) << "u)";
     }
+    else if (mMinify)
+    {
+        TInfoSinkBase text;
+        text << std::min(FLT_MAX, std::max(-FLT_MAX, f));
+        out << MinifyFloat(text.str());
+    }
     else
     {
         out << std::min(FLT_MAX, std::max(-FLT_MAX, f));
@@ -143,9 +323,68 @@ void TOutputGLSLBase::writeBuiltInFunctionTriplet(Visit visit,
                                                   const char *preStr,
                                                   bool useEmulatedFunction)
 {
-    TString preString =
-        useEmulatedFunction ? BuiltInFunctionEmulator::GetEmulatedFunctionName(preStr) : preStr;
-    writeTriplet(visit, preString.c_str(), ", ", ")");
+    if (visit == PreVisit && useEmulatedFunction)
+        objSink() << BuiltInFunctionEmulator::GetEmulatedFunctionName(preStr);
+    else
+        writeTriplet(visit, preStr, ", ", ")");
+}
+
+bool TOutputGLSLBase::needsParentheses(TIntermTyped *node)
+{
+    int precedence = GetPrecedence(node);
+    if (!mMinify || precedence == 1)
+    {
+        return true;
+    }
+
+    TIntermNode *parent = getParentNode();
+    if (parent == nullptr)
+    {
+        return false;
+    }
+    if (TIntermBinary *binary = parent->getAsBinaryNode())
+    {
+        int parentPrecedence = GetPrecedence(binary);
+        if (parentPrecedence == 16)
+        {
+            // The index is written in brackets.
+            return node == binary->getLeft() && precedence < 16;
+        }
+        if (binary->getOp() == EOpInitialize)
+        {
+            return false;
+        }
+        if (precedence != parentPrecedence)
+        {
+            return precedence < parentPrecedence;
+        }
+        // Assignments group right to left and the other operators left to right.
+        return binary->isAssignment() ? node == binary->getLeft() : node == binary->getRight();
+    }
+    if (TIntermUnary *unary = parent->getAsUnaryNode())
+    {
+        // Nested prefix operators could also form ++ or -- without the parentheses.
+        return GetPrecedence(unary) < 17 && precedence < 16;
+    }
+    if (parent->getAsSwizzleNode())
+    {
+        return precedence < 16;
+    }
+    if (TIntermTernary *ternary = parent->getAsTernaryNode())
+    {
+        if (node == ternary->getCondition())
+        {
+            return precedence <= 3;
+        }
+        return node == ternary->getFalseExpression() && precedence < 3;
+    }
+    return false;
+}
+
+void TOutputGLSLBase::writeOperatorTriplet(Visit visit, TIntermTyped *node, const char *inStr)
+{
+    bool parenthesize = visit != InVisit && needsParentheses(node);
+    writeTriplet(visit, parenthesize ? "(" : nullptr, inStr, parenthesize ? ")" : nullptr);
 }
 
 void TOutputGLSLBase::writeLayoutQualifier(const TType &type)
@@ -304,7 +543,7 @@ void TOutputGLSLBase::writeFunctionParameters(const TIntermSequence &args)
         if (!arg->getName().getString().empty())
             out << " " << hashName(arg->getName());
         if (type.isArray())
-            out << arrayBrackets(type);
+            writeArrayBrackets(out, type);
 
         // Put a comma if this is not the last argument.
         if (iter != args.end() - 1)
@@ -339,6 +578,13 @@ const TConstantUnion *TOutputGLSLBase::writeConstantUnion(const TType &type,
         bool writeType = size > 1;
         if (writeType)
             out << getTypeName(type) << "(";
+        const TConstantUnion *end = pConstUnion + size;
+        if (mMinify && writeType && type.isVector() && !type.isArray() &&
+            IsSplat(pConstUnion, size))
+        {
+            // Vector constructors replicate a single scalar argument.
+            size = 1;
+        }
         for (size_t i = 0; i < size; ++i, ++pConstUnion)
         {
             switch (pConstUnion->getType())
@@ -363,6 +609,7 @@ const TConstantUnion *TOutputGLSLBase::writeConstantUnion(const TType &type,
         }
         if (writeType)
             out << ")";
+        pConstUnion = end;
     }
     return pConstUnion;
 }
@@ -375,7 +622,7 @@ void TOutputGLSLBase::writeConstructorTriplet(Visit visit, const TType &type)
         if (type.isArray())
         {
             out << getTypeName(type);
-            out << arrayBrackets(type);
+            writeArrayBrackets(out, type);
             out << "(";
         }
         else
@@ -395,12 +642,17 @@ void TOutputGLSLBase::visitSymbol(TIntermSymbol *node)
     out << hashVariableName(node->getName());
 
     if (mDeclaringVariables && node->getType().isArray())
-        out << arrayBrackets(node->getType());
+        writeArrayBrackets(out, node->getType());
 }
 
 void TOutputGLSLBase::visitConstantUnion(TIntermConstantUnion *node)
 {
+    bool parenthesize = mMinify && needsParentheses(node);
+    if (parenthesize)
+        objSink() << "(";
     writeConstantUnion(node->getType(), node->getUnionArrayPointer());
+    if (parenthesize)
+        objSink() << ")";
 }
 
 bool TOutputGLSLBase::visitSwizzle(Visit visit, TIntermSwizzle *node)
@@ -421,7 +673,7 @@ bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
     switch (node->getOp())
     {
         case EOpComma:
-            writeTriplet(visit, "(", ", ", ")");
+            writeOperatorTriplet(visit, node, ", ");
             break;
         case EOpInitialize:
             if (visit == InVisit)
@@ -432,19 +684,19 @@ bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
             }
             break;
         case EOpAssign:
-            writeTriplet(visit, "(", " = ", ")");
+            writeOperatorTriplet(visit, node, " = ");
             break;
         case EOpAddAssign:
-            writeTriplet(visit, "(", " += ", ")");
+            writeOperatorTriplet(visit, node, " += ");
             break;
         case EOpSubAssign:
-            writeTriplet(visit, "(", " -= ", ")");
+            writeOperatorTriplet(visit, node, " -= ");
             break;
         case EOpDivAssign:
-            writeTriplet(visit, "(", " /= ", ")");
+            writeOperatorTriplet(visit, node, " /= ");
             break;
         case EOpIModAssign:
-            writeTriplet(visit, "(", " %= ", ")");
+            writeOperatorTriplet(visit, node, " %= ");
             break;
         // Notice the fall-through.
         case EOpMulAssign:
@@ -452,22 +704,22 @@ bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
         case EOpVectorTimesScalarAssign:
         case EOpMatrixTimesScalarAssign:
         case EOpMatrixTimesMatrixAssign:
-            writeTriplet(visit, "(", " *= ", ")");
+            writeOperatorTriplet(visit, node, " *= ");
             break;
         case EOpBitShiftLeftAssign:
-            writeTriplet(visit, "(", " <<= ", ")");
+            writeOperatorTriplet(visit, node, " <<= ");
             break;
         case EOpBitShiftRightAssign:
-            writeTriplet(visit, "(", " >>= ", ")");
+            writeOperatorTriplet(visit, node, " >>= ");
             break;
         case EOpBitwiseAndAssign:
-            writeTriplet(visit, "(", " &= ", ")");
+            writeOperatorTriplet(visit, node, " &= ");
             break;
         case EOpBitwiseXorAssign:
-            writeTriplet(visit, "(", " ^= ", ")");
+            writeOperatorTriplet(visit, node, " ^= ");
             break;
         case EOpBitwiseOrAssign:
-            writeTriplet(visit, "(", " |= ", ")");
+            writeOperatorTriplet(visit, node, " |= ");
             break;
 
         case EOpIndexDirect:
@@ -550,53 +802,53 @@ bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
             break;
 
         case EOpAdd:
-            writeTriplet(visit, "(", " + ", ")");
+            writeOperatorTriplet(visit, node, " + ");
             break;
         case EOpSub:
-            writeTriplet(visit, "(", " - ", ")");
+            writeOperatorTriplet(visit, node, " - ");
             break;
         case EOpMul:
-            writeTriplet(visit, "(", " * ", ")");
+            writeOperatorTriplet(visit, node, " * ");
             break;
         case EOpDiv:
-            writeTriplet(visit, "(", " / ", ")");
+            writeOperatorTriplet(visit, node, " / ");
             break;
         case EOpIMod:
-            writeTriplet(visit, "(", " % ", ")");
+            writeOperatorTriplet(visit, node, " % ");
             break;
         case EOpBitShiftLeft:
-            writeTriplet(visit, "(", " << ", ")");
+            writeOperatorTriplet(visit, node, " << ");
             break;
         case EOpBitShiftRight:
-            writeTriplet(visit, "(", " >> ", ")");
+            writeOperatorTriplet(visit, node, " >> ");
             break;
         case EOpBitwiseAnd:
-            writeTriplet(visit, "(", " & ", ")");
+            writeOperatorTriplet(visit, node, " & ");
             break;
         case EOpBitwiseXor:
-            writeTriplet(visit, "(", " ^ ", ")");
+            writeOperatorTriplet(visit, node, " ^ ");
             break;
         case EOpBitwiseOr:
-            writeTriplet(visit, "(", " | ", ")");
+            writeOperatorTriplet(visit, node, " | ");
             break;
 
         case EOpEqual:
-            writeTriplet(visit, "(", " == ", ")");
+            writeOperatorTriplet(visit, node, " == ");
             break;
         case EOpNotEqual:
-            writeTriplet(visit, "(", " != ", ")");
+            writeOperatorTriplet(visit, node, " != ");
             break;
         case EOpLessThan:
-            writeTriplet(visit, "(", " < ", ")");
+            writeOperatorTriplet(visit, node, " < ");
             break;
         case EOpGreaterThan:
-            writeTriplet(visit, "(", " > ", ")");
+            writeOperatorTriplet(visit, node, " > ");
             break;
         case EOpLessThanEqual:
-            writeTriplet(visit, "(", " <= ", ")");
+            writeOperatorTriplet(visit, node, " <= ");
             break;
         case EOpGreaterThanEqual:
-            writeTriplet(visit, "(", " >= ", ")");
+            writeOperatorTriplet(visit, node, " >= ");
             break;
 
         // Notice the fall-through.
@@ -605,17 +857,17 @@ bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
         case EOpMatrixTimesVector:
         case EOpMatrixTimesScalar:
         case EOpMatrixTimesMatrix:
-            writeTriplet(visit, "(", " * ", ")");
+            writeOperatorTriplet(visit, node, " * ");
             break;
 
         case EOpLogicalOr:
-            writeTriplet(visit, "(", " || ", ")");
+            writeOperatorTriplet(visit, node, " || ");
             break;
         case EOpLogicalXor:
-            writeTriplet(visit, "(", " ^^ ", ")");
+            writeOperatorTriplet(visit, node, " ^^ ");
             break;
         case EOpLogicalAnd:
-            writeTriplet(visit, "(", " && ", ")");
+            writeOperatorTriplet(visit, node, " && ");
             break;
         default:
             UNREACHABLE();
@@ -626,8 +878,8 @@ bool TOutputGLSLBase::visitBinary(Visit visit, TIntermBinary *node)
 
 bool TOutputGLSLBase::visitUnary(Visit visit, TIntermUnary *node)
 {
-    TString preString;
-    TString postString = ")";
+    const char *preString  = "";
+    const char *postString = ")";
 
     switch (node->getOp())
     {
@@ -826,9 +1078,22 @@ bool TOutputGLSLBase::visitUnary(Visit visit, TIntermUnary *node)
             UNREACHABLE();
     }
 
+    if (preString[0] == '(' && !needsParentheses(node))
+    {
+        // Skip the parentheses around the operator and its operand.
+        ++preString;
+        if (node->getOp() == EOpPostIncrement)
+            postString = "++";
+        else if (node->getOp() == EOpPostDecrement)
+            postString = "--";
+        else
+            postString = "";
+    }
+
     if (visit == PreVisit && node->getUseEmulatedFunction())
-        preString = BuiltInFunctionEmulator::GetEmulatedFunctionName(preString);
-    writeTriplet(visit, preString.c_str(), NULL, postString.c_str());
+        objSink() << BuiltInFunctionEmulator::GetEmulatedFunctionName(preString);
+    else
+        writeTriplet(visit, preString, NULL, postString);
 
     return true;
 }
@@ -836,6 +1101,22 @@ bool TOutputGLSLBase::visitUnary(Visit visit, TIntermUnary *node)
 bool TOutputGLSLBase::visitTernary(Visit visit, TIntermTernary *node)
 {
     TInfoSinkBase &out = objSink();
+    if (mMinify)
+    {
+        bool parenthesize = needsParentheses(node);
+        if (parenthesize)
+            out << "(";
+        incrementDepth(node);
+        node->getCondition()->traverse(this);
+        out << "?";
+        node->getTrueExpression()->traverse(this);
+        out << ":";
+        node->getFalseExpression()->traverse(this);
+        decrementDepth();
+        if (parenthesize)
+            out << ")";
+        return false;
+    }
     // Notice two brackets at the beginning and end. The outer ones
     // encapsulate the whole ternary expression. This preserves the
     // order of precedence when ternary expressions are used in a
@@ -939,7 +1220,7 @@ bool TOutputGLSLBase::visitFunctionDefinition(Visit visit, TIntermFunctionDefini
         const TType &type = node->getType();
         writeVariableType(type);
         if (type.isArray())
-            out << arrayBrackets(type);
+            writeArrayBrackets(out, type);
     }
 
     out << " " << hashFunctionNameIfNeeded(node->getFunctionSymbolInfo()->getNameObj());
@@ -982,7 +1263,7 @@ bool TOutputGLSLBase::visitAggregate(Visit visit, TIntermAggregate *node)
                 const TType &type = node->getType();
                 writeVariableType(type);
                 if (type.isArray())
-                    out << arrayBrackets(type);
+                    writeArrayBrackets(out, type);
             }
 
             out << " " << hashFunctionNameIfNeeded(node->getFunctionSymbolInfo()->getNameObj());
@@ -1264,7 +1545,7 @@ TString TOutputGLSLBase::hashName(const TName &name)
         // names don't conflict with user-defined names from WebGL.
         return "webgl_angle_" + name.getString();
     }
-    if (mHashFunction == nullptr)
+    if (mHashFunction == nullptr || mMinifiedNames.count(name.getString()) > 0)
     {
         return name.getString();
     }
@@ -1326,7 +1607,7 @@ void TOutputGLSLBase::declareStruct(const TStructure *structure)
             out << " ";
         out << getTypeName(*field->type()) << " " << hashName(TName(field->name()));
         if (field->type()->isArray())
-            out << arrayBrackets(*field->type());
+            writeArrayBrackets(out, *field->type());
         out << ";\n";
     }
     out << "}";
@@ -1394,7 +1675,7 @@ void TOutputGLSLBase::declareInterfaceBlock(const TInterfaceBlock *interfaceBloc
             out << " ";
         out << getTypeName(*field->type()) << " " << hashName(TName(field->name()));
         if (field->type()->isArray())
-            out << arrayBrackets(*field->type());
+            writeArrayBrackets(out, *field->type());
         out << ";\n";
     }
     out << "}";
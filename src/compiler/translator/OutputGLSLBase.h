@@ -9,6 +9,7 @@
 
 #include <set>
 
+#include "compiler/translator/HashNames.h"
 #include "compiler/translator/IntermNode.h"
 #include "compiler/translator/ParseContext.h"
 
@@ -26,7 +27,8 @@ class TOutputGLSLBase : public TIntermTraverser
                     sh::GLenum shaderType,
                     int shaderVersion,
                     ShShaderOutput output,
-                    ShCompileOptions compileOptions);
+                    ShCompileOptions compileOptions,
+                    const NameMap &minifiedNames);
 
     ShShaderOutput getShaderOutput() const { return mOutput; }
 
@@ -81,6 +83,11 @@ class TOutputGLSLBase : public TIntermTraverser
 
     void writeBuiltInFunctionTriplet(Visit visit, const char *preStr, bool useEmulatedFunction);
 
+    // Returns whether the expression has to be written in parentheses. The output keeps all of its
+    // parentheses unless SH_MINIFY_OUTPUT is used.
+    bool needsParentheses(TIntermTyped *node);
+    void writeOperatorTriplet(Visit visit, TIntermTyped *node, const char *inStr);
+
     const char *mapQualifierToString(TQualifier qialifier);
 
     TInfoSinkBase &mObjSink;
@@ -105,6 +112,11 @@ class TOutputGLSLBase : public TIntermTraverser
     ShShaderOutput mOutput;
 
     ShCompileOptions mCompileOptions;
+
+    bool mMinify;
+    // The names that SH_MINIFY_OUTPUT gave to variables and functions. They are written as they
+    // are instead of being hashed.
+    std::set<TString> mMinifiedNames;
 };
 
 }  // namespace sh
@@ -192,9 +192,11 @@ void OutputHLSL::output(TIntermNode *treeRoot, TInfoSinkBase &objSink)
     header(mHeader, &builtInFunctionEmulator);
     mInfoSinkStack.pop();
 
-    objSink << mHeader.c_str();
-    objSink << mBody.c_str();
-    objSink << mFooter.c_str();
+    objSink.reserve(objSink.str().size() + mHeader.str().size() + mBody.str().size() +
+                    mFooter.str().size());
+    objSink << mHeader.str();
+    objSink << mBody.str();
+    objSink << mFooter.str();
 
     builtInFunctionEmulator.Cleanup();
 }
@@ -814,13 +816,13 @@ void OutputHLSL::outputEqual(Visit visit, const TType &type, TOperator op, TInfo
         if (type.isArray())
         {
             const TString &functionName = addArrayEqualityFunction(type);
-            outputTriplet(out, visit, (functionName + "(").c_str(), ", ", ")");
+            outputCallTriplet(out, visit, functionName, "(");
         }
         else if (type.getBasicType() == EbtStruct)
         {
             const TStructure &structure = *type.getStruct();
             const TString &functionName = addStructEqualityFunction(structure);
-            outputTriplet(out, visit, (functionName + "(").c_str(), ", ", ")");
+            outputCallTriplet(out, visit, functionName, "(");
         }
         else
         {
@@ -916,7 +918,7 @@ bool OutputHLSL::visitBinary(Visit visit, TIntermBinary *node)
                 ASSERT(rightAgg == nullptr || rightAgg->getOp() != EOpFunctionCall);
 
                 const TString &functionName = addArrayAssignmentFunction(node->getType());
-                outputTriplet(out, visit, (functionName + "(").c_str(), ", ", ")");
+                outputCallTriplet(out, visit, functionName, "(");
             }
             else
             {
@@ -1843,7 +1845,7 @@ bool OutputHLSL::visitAggregate(Visit visit, TIntermAggregate *node)
             }
             const TString &structName = StructNameString(*node->getType().getStruct());
             mStructureHLSL->addConstructor(node->getType(), structName, node->getSequence());
-            outputTriplet(out, visit, (structName + "_ctor(").c_str(), ", ", ")");
+            outputCallTriplet(out, visit, structName, "_ctor(");
         }
         break;
         case EOpLessThan:
@@ -2450,6 +2452,21 @@ void OutputHLSL::outputTriplet(TInfoSinkBase &out,
     }
 }
 
+void OutputHLSL::outputCallTriplet(TInfoSinkBase &out,
+                                   Visit visit,
+                                   const TString &functionName,
+                                   const char *nameSuffix)
+{
+    if (visit == PreVisit)
+    {
+        out << functionName << nameSuffix;
+    }
+    else
+    {
+        outputTriplet(out, visit, nullptr, ", ", ")");
+    }
+}
+
 void OutputHLSL::outputLineDirective(TInfoSinkBase &out, int line)
 {
     if ((mCompileOptions & SH_LINE_DIRECTIVES) && (line > 0))
@@ -2636,8 +2653,14 @@ const TConstantUnion *OutputHLSL::writeConstantUnion(TInfoSinkBase &out,
 
 void OutputHLSL::writeEmulatedFunctionTriplet(TInfoSinkBase &out, Visit visit, const char *preStr)
 {
-    TString preString = BuiltInFunctionEmulator::GetEmulatedFunctionName(preStr);
-    outputTriplet(out, visit, preString.c_str(), ", ", ")");
+    if (visit == PreVisit)
+    {
+        out << BuiltInFunctionEmulator::GetEmulatedFunctionName(preStr);
+    }
+    else
+    {
+        outputTriplet(out, visit, nullptr, ", ", ")");
+    }
 }
 
 bool OutputHLSL::writeSameSymbolInitializer(TInfoSinkBase &out,
@@ -93,6 +93,12 @@ class OutputHLSL : public TIntermTraverser
                        const char *preString,
                        const char *inString,
                        const char *postString);
+    // Emit a call to a generated function, with its arguments separated by commas. The name is
+    // only written on the pre-visit, so no temporary string is built for the other phases.
+    void outputCallTriplet(TInfoSinkBase &out,
+                           Visit visit,
+                           const TString &functionName,
+                           const char *nameSuffix);
     void outputLineDirective(TInfoSinkBase &out, int line);
     TString argumentString(const TIntermSymbol *symbol);
     int vectorSize(const TType &type) const;
@@ -2729,7 +2729,8 @@ TIntermTyped *TParseContext::addConstructor(TIntermNode *arguments,
 
     constructor->setType(type);
 
-    TIntermTyped *constConstructor = intermediate.foldAggregateBuiltIn(constructor, &mDiagnostics);
+    TIntermTyped *constConstructor =
+        intermediate.foldAggregateBuiltIn(constructor, &mDiagnostics, &mFoldingCache);
     if (constConstructor)
     {
         return constConstructor;
@@ -3652,7 +3653,7 @@ TIntermTyped *TParseContext::createUnaryMath(TOperator op,
     TIntermUnary *node = new TIntermUnary(op, child);
     node->setLine(loc);
 
-    TIntermTyped *foldedNode = node->fold(&mDiagnostics);
+    TIntermTyped *foldedNode = node->fold(&mDiagnostics, &mFoldingCache);
     if (foldedNode)
         return foldedNode;
 
@@ -3987,7 +3988,7 @@ TIntermTyped *TParseContext::addBinaryMathInternal(TOperator op,
     node->setLine(loc);
 
     // See if we can fold constants.
-    TIntermTyped *foldedNode = node->fold(&mDiagnostics);
+    TIntermTyped *foldedNode = node->fold(&mDiagnostics, &mFoldingCache);
     if (foldedNode)
         return foldedNode;
 
@@ -4380,7 +4381,7 @@ TIntermTyped *TParseContext::addFunctionCallOrMethod(TFunction *fnCall,
                     aggregate->setPrecisionFromChildren();
                     if (aggregate->areChildrenConstQualified())
                     {
-                        aggregate->getTypePointer()->setQualifier(EvqConst);
+                        aggregate->setQualifier(EvqConst);
                     }
 
                     // Some built-in functions have out parameters too.
@@ -4388,8 +4389,8 @@ TIntermTyped *TParseContext::addFunctionCallOrMethod(TFunction *fnCall,
 
                     // See if we can constant fold a built-in. Note that this may be possible even
                     // if it is not const-qualified.
-                    TIntermTyped *foldedNode =
-                        intermediate.foldAggregateBuiltIn(aggregate, &mDiagnostics);
+                    TIntermTyped *foldedNode = intermediate.foldAggregateBuiltIn(
+                        aggregate, &mDiagnostics, &mFoldingCache);
                     if (foldedNode)
                     {
                         callNode = foldedNode;
@@ -4499,6 +4500,7 @@ TIntermTyped *TParseContext::addTernarySelection(TIntermTyped *cond,
 int PaParseStrings(size_t count,
                    const char *const string[],
                    const int length[],
+                   const std::vector<pp::Token> *appendedTokens,
                    TParseContext *context)
 {
     if ((count == 0) || (string == NULL))
@@ -4508,6 +4510,8 @@ int PaParseStrings(size_t count,
         return 1;
 
     int error = glslang_scan(count, string, length, context);
+    if (!error && appendedTokens)
+        context->getPreprocessor().appendTokens(appendedTokens);
     if (!error)
         error = glslang_parse(context);
 
@@ -7,6 +7,7 @@
 #define COMPILER_TRANSLATOR_PARSECONTEXT_H_
 
 #include "compiler/translator/Compiler.h"
+#include "compiler/translator/ConstantFoldingCache.h"
 #include "compiler/translator/Diagnostics.h"
 #include "compiler/translator/DirectiveHandler.h"
 #include "compiler/translator/Intermediate.h"
@@ -441,6 +442,7 @@ class TParseContext : angle::NonCopyable
     TLayoutBlockStorage mDefaultBlockStorage;
     TString mHashErrMsg;
     TDiagnostics mDiagnostics;
+    TConstantFoldingCache mFoldingCache;
     TDirectiveHandler mDirectiveHandler;
     pp::Preprocessor mPreprocessor;
     void *mScanner;
@@ -458,9 +460,12 @@ class TParseContext : angle::NonCopyable
     bool mDeclaringFunction;
 };
 
+// appendedTokens, if not null, follow the strings as one more string. See
+// pp::Tokenizer::TokenizeString().
 int PaParseStrings(size_t count,
                    const char *const string[],
                    const int length[],
+                   const std::vector<pp::Token> *appendedTokens,
                    TParseContext *context);
 
 }  // namespace sh
@@ -0,0 +1,270 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManager:
+//   Implementation of the fused AST pass runner.
+//
+
+#include "compiler/translator/PassManager.h"
+
+#include "compiler/translator/IntermNode.h"
+
+namespace sh
+{
+
+namespace
+{
+
+// Forwards every node visit to a set of pre-visit-only traversers. A traverser that declines to
+// visit the children of a node is left out until the traversal has moved past that node.
+class FusedTraverser : public TIntermTraverser
+{
+  public:
+    FusedTraverser(const std::vector<TIntermTraverser *> &members)
+        : TIntermTraverser(true, false, true),
+          mMembers(members),
+          mActive(members.size(), true),
+          mActiveCount(members.size())
+    {
+    }
+
+    void visitSymbol(TIntermSymbol *node) override
+    {
+        for (size_t i = 0; i < mMembers.size(); ++i)
+        {
+            if (mActive[i])
+                mMembers[i]->visitSymbol(node);
+        }
+    }
+
+    void visitRaw(TIntermRaw *node) override
+    {
+        for (size_t i = 0; i < mMembers.size(); ++i)
+        {
+            if (mActive[i])
+                mMembers[i]->visitRaw(node);
+        }
+    }
+
+    void visitConstantUnion(TIntermConstantUnion *node) override
+    {
+        for (size_t i = 0; i < mMembers.size(); ++i)
+        {
+            if (mActive[i])
+                mMembers[i]->visitConstantUnion(node);
+        }
+    }
+
+    bool visitSwizzle(Visit visit, TIntermSwizzle *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitSwizzle);
+    }
+    bool visitBinary(Visit visit, TIntermBinary *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitBinary);
+    }
+    bool visitUnary(Visit visit, TIntermUnary *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitUnary);
+    }
+    bool visitTernary(Visit visit, TIntermTernary *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitTernary);
+    }
+    bool visitIfElse(Visit visit, TIntermIfElse *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitIfElse);
+    }
+    bool visitSwitch(Visit visit, TIntermSwitch *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitSwitch);
+    }
+    bool visitCase(Visit visit, TIntermCase *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitCase);
+    }
+    bool visitFunctionDefinition(Visit visit, TIntermFunctionDefinition *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitFunctionDefinition);
+    }
+    bool visitAggregate(Visit visit, TIntermAggregate *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitAggregate);
+    }
+    bool visitBlock(Visit visit, TIntermBlock *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitBlock);
+    }
+    bool visitInvariantDeclaration(Visit visit, TIntermInvariantDeclaration *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitInvariantDeclaration);
+    }
+    bool visitDeclaration(Visit visit, TIntermDeclaration *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitDeclaration);
+    }
+    bool visitLoop(Visit visit, TIntermLoop *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitLoop);
+    }
+    bool visitBranch(Visit visit, TIntermBranch *node) override
+    {
+        return dispatch(visit, node, &TIntermTraverser::visitBranch);
+    }
+
+  private:
+    struct SkippedSubtree
+    {
+        TIntermNode *node;
+        size_t member;
+    };
+
+    template <typename NodeType>
+    bool dispatch(Visit visit,
+                  NodeType *node,
+                  bool (TIntermTraverser::*visitFunction)(Visit, NodeType *))
+    {
+        if (visit == PostVisit)
+        {
+            // The members only visit before the children, so all that's left to do is to bring
+            // back the ones that skipped this node's subtree.
+            reactivateMembers(node);
+            return true;
+        }
+
+        ASSERT(visit == PreVisit);
+        for (size_t i = 0; i < mMembers.size(); ++i)
+        {
+            if (mActive[i] && !(mMembers[i]->*visitFunction)(PreVisit, node))
+            {
+                mActive[i] = false;
+                --mActiveCount;
+                mSkipped.push_back({node, i});
+            }
+        }
+
+        if (mActiveCount == 0)
+        {
+            // Nobody is interested in the subtree. There won't be a post-visit to reactivate the
+            // members in, so do it now.
+            reactivateMembers(node);
+            return false;
+        }
+        return true;
+    }
+
+    void reactivateMembers(TIntermNode *node)
+    {
+        while (!mSkipped.empty() && mSkipped.back().node == node)
+        {
+            mActive[mSkipped.back().member] = true;
+            ++mActiveCount;
+            mSkipped.pop_back();
+        }
+    }
+
+    const std::vector<TIntermTraverser *> &mMembers;
+    std::vector<bool> mActive;
+    size_t mActiveCount;
+    std::vector<SkippedSubtree> mSkipped;
+};
+
+}  // anonymous namespace
+
+PassManager::ScopedTimer::ScopedTimer(PassManager *manager, const char *name)
+    : mManager(manager), mName(name)
+{
+    if (mManager->mTimingEnabled)
+    {
+        mStart = std::chrono::steady_clock::now();
+    }
+}
+
+PassManager::ScopedTimer::~ScopedTimer()
+{
+    if (mManager->mTimingEnabled)
+    {
+        mManager->recordTiming(mName, std::chrono::steady_clock::now() - mStart);
+    }
+}
+
+PassManager::PassManager() : mTimingEnabled(true)
+{
+}
+
+PassManager::~PassManager()
+{
+}
+
+void PassManager::addAnalysis(const char *name,
+                              TIntermTraverser *traverser,
+                              unsigned int reads,
+                              unsigned int writes)
+{
+    ASSERT(traverser != nullptr && traverser->visitsOnlyBeforeChildren());
+    mAnalyses.push_back({name, traverser, reads, writes});
+}
+
+void PassManager::runAnalyses(TIntermNode *root)
+{
+    size_t first = 0;
+    while (first < mAnalyses.size())
+    {
+        // Grow the group for as long as the next analysis doesn't depend on the order in which
+        // the passes see each node.
+        std::vector<TIntermTraverser *> group;
+        std::string groupName;
+        unsigned int groupReads  = 0;
+        unsigned int groupWrites = 0;
+
+        size_t last = first;
+        for (; last < mAnalyses.size(); ++last)
+        {
+            const Analysis &analysis = mAnalyses[last];
+            if ((analysis.writes & (groupReads | groupWrites)) != 0 ||
+                (analysis.reads & groupWrites) != 0)
+            {
+                break;
+            }
+
+            group.push_back(analysis.traverser);
+            if (!groupName.empty())
+            {
+                groupName += "+";
+            }
+            groupName += analysis.name;
+            groupReads |= analysis.reads;
+            groupWrites |= analysis.writes;
+        }
+
+        ScopedTimer timer(this, groupName.c_str());
+        if (group.size() == 1)
+        {
+            root->traverse(group[0]);
+        }
+        else
+        {
+            FusedTraverser fused(group);
+            root->traverse(&fused);
+        }
+
+        first = last;
+    }
+
+    mAnalyses.clear();
+}
+
+void PassManager::clearTimings()
+{
+    mTimings.clear();
+}
+
+void PassManager::recordTiming(const std::string &name,
+                               std::chrono::steady_clock::duration duration)
+{
+    mTimings.push_back({name, std::chrono::duration<double>(duration).count()});
+}
+
+}  // namespace sh
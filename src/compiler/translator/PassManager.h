@@ -0,0 +1,99 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManager:
+//   Runs AST analysis passes, fusing the ones that don't interfere with each other into a single
+//   traversal, and records how long each pass of a compilation takes.
+//
+
+#ifndef COMPILER_TRANSLATOR_PASSMANAGER_H_
+#define COMPILER_TRANSLATOR_PASSMANAGER_H_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "common/angleutils.h"
+
+namespace sh
+{
+
+class TIntermNode;
+class TIntermTraverser;
+
+class PassManager : angle::NonCopyable
+{
+  public:
+    // Node annotations that analysis passes set or look at, besides the tree itself. Passes that
+    // change the structure of the tree are never fused and don't need to declare anything.
+    enum Dependency : unsigned int
+    {
+        DEPENDENCY_NONE = 0,
+        // TIntermOperator::setUseEmulatedFunction()
+        DEPENDENCY_EMULATED_FUNCTIONS = 1 << 0,
+        // TIntermBinary::setAddIndexClamp()
+        DEPENDENCY_INDEX_CLAMPING = 1 << 1,
+    };
+
+    struct PassTiming
+    {
+        // Fused passes are reported together, with their names joined by '+'.
+        std::string name;
+        double seconds;
+    };
+
+    // Records the time spent in a pass that runs outside of the manager.
+    class ScopedTimer final : angle::NonCopyable
+    {
+      public:
+        ScopedTimer(PassManager *manager, const char *name);
+        ~ScopedTimer();
+
+      private:
+        PassManager *mManager;
+        const char *mName;
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+    PassManager();
+    ~PassManager();
+
+    // Queues an analysis pass. |traverser| may only set the annotations in |writes| and must not
+    // change the tree. Since it may share its traversal with other passes, it must only visit
+    // nodes before their children, and must not rely on its own path or depth in the tree.
+    void addAnalysis(const char *name,
+                     TIntermTraverser *traverser,
+                     unsigned int reads,
+                     unsigned int writes);
+
+    // Runs the queued analyses in order and clears the queue. Consecutive analyses share one
+    // traversal as long as none of them writes an annotation that another one reads or writes.
+    void runAnalyses(TIntermNode *root);
+
+    // Timing is enabled by default. When it's disabled, passes run without being timed.
+    void setTimingEnabled(bool enabled) { mTimingEnabled = enabled; }
+
+    const std::vector<PassTiming> &getTimings() const { return mTimings; }
+    void clearTimings();
+
+  private:
+    struct Analysis
+    {
+        const char *name;
+        TIntermTraverser *traverser;
+        unsigned int reads;
+        unsigned int writes;
+    };
+
+    void recordTiming(const std::string &name, std::chrono::steady_clock::duration duration);
+
+    std::vector<Analysis> mAnalyses;
+    bool mTimingEnabled;
+    std::vector<PassTiming> mTimings;
+};
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_PASSMANAGER_H_
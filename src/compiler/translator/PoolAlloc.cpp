@@ -14,50 +14,48 @@
 #include "common/debug.h"
 #include "common/platform.h"
 #include "common/tls.h"
-#include "compiler/translator/InitializeGlobals.h"
 
-TLSIndex PoolIndex = TLS_INVALID_INDEX;
-
-bool InitializePoolIndex()
+namespace
 {
-    assert(PoolIndex == TLS_INVALID_INDEX);
-
-    PoolIndex = CreateTLSIndex();
-    return PoolIndex != TLS_INVALID_INDEX;
-}
 
-void FreePoolIndex()
+// The index is created the first time any thread needs it, so there's nothing to set up before
+// allocators are used, and it lives for as long as the process.
+TLSIndex GetPoolIndex()
 {
-    assert(PoolIndex != TLS_INVALID_INDEX);
-
-    DestroyTLSIndex(PoolIndex);
-    PoolIndex = TLS_INVALID_INDEX;
+    static const TLSIndex poolIndex = CreateTLSIndex();
+    assert(poolIndex != TLS_INVALID_INDEX);
+    return poolIndex;
 }
 
+}  // anonymous namespace
+
 TPoolAllocator *GetGlobalPoolAllocator()
 {
-    assert(PoolIndex != TLS_INVALID_INDEX);
-    return static_cast<TPoolAllocator *>(GetTLSValue(PoolIndex));
+    return static_cast<TPoolAllocator *>(GetTLSValue(GetPoolIndex()));
 }
 
 void SetGlobalPoolAllocator(TPoolAllocator *poolAllocator)
 {
-    assert(PoolIndex != TLS_INVALID_INDEX);
-    SetTLSValue(PoolIndex, poolAllocator);
+    SetTLSValue(GetPoolIndex(), poolAllocator);
 }
 
 //
 // Implement the functionality of the TPoolAllocator class, which
 // is documented in PoolAlloc.h.
 //
-TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment)
+TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment, int maxPageSize)
     : alignment(allocationAlignment),
+      numCalls(0),
+      totalBytes(0),
 #if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
       pageSize(growthIncrement),
+      maxPageSize(maxPageSize),
       freeList(0),
+      largeFreeList(0),
       inUseList(0),
-      numCalls(0),
-      totalBytes(0),
+      pageAllocations(0),
+      pageReuses(0),
+      reservedBytes(0),
 #endif
       mLocked(false)
 {
@@ -78,16 +76,22 @@ TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment)
 #if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
     //
     // Don't allow page sizes we know are smaller than all common
-    // OS page sizes.
+    // OS page sizes.  Page sizes are kept aligned so that the
+    // aligned offset of a full page never runs past its end.
     //
     if (pageSize < 4 * 1024)
         pageSize = 4 * 1024;
+    pageSize = (pageSize + alignmentMask) & ~alignmentMask;
+    if (this->maxPageSize < pageSize)
+        this->maxPageSize = pageSize;
+    this->maxPageSize = (this->maxPageSize + alignmentMask) & ~alignmentMask;
+    nextPageSize      = pageSize;
 
     //
-    // A large currentPageOffset indicates a new page needs to
-    // be obtained to allocate memory.
+    // There is no current page: the first allocation needs a new one.
     //
-    currentPageOffset = pageSize;
+    currentPageOffset = 0;
+    currentPageEnd    = 0;
 
     //
     // Align header skip
@@ -117,12 +121,7 @@ TPoolAllocator::~TPoolAllocator()
     // here, because we did it already when the block was
     // placed into the free list.
     //
-    while (freeList)
-    {
-        tHeader *next = freeList->nextPage;
-        delete[] reinterpret_cast<char *>(freeList);
-        freeList = next;
-    }
+    releaseUnusedPages();
 #else  // !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
     for (auto &allocs : mStack)
     {
@@ -176,15 +175,10 @@ void TAllocation::checkGuardBlock(unsigned char *blockMem,
 
 void TPoolAllocator::push()
 {
+    // The marker is taken before the push so that pop() rewinds to it at the depth it was made.
+    Marker marker = mark();
 #if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
-    tAllocState state = {currentPageOffset, inUseList};
-
-    mStack.push_back(state);
-
-    //
-    // Indicate there is no current page to allocate from.
-    //
-    currentPageOffset = pageSize;
+    mStack.push_back(marker);
 #else  // !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
     mStack.push_back({});
 #endif
@@ -203,17 +197,80 @@ void TPoolAllocator::pop()
         return;
 
 #if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
-    tHeader *page     = mStack.back().page;
-    currentPageOffset = mStack.back().offset;
+    restore(mStack.back());
+    mStack.pop_back();
+#else  // !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+    for (auto &alloc : mStack.back())
+    {
+        free(alloc);
+    }
+    mStack.pop_back();
+#endif
+}
+
+//
+// Do a mass-deallocation of all the individual allocations
+// that have occurred.
+//
+void TPoolAllocator::popAll()
+{
+    while (mStack.size() > 0)
+        pop();
+}
+
+TPoolAllocator::Marker TPoolAllocator::mark() const
+{
+    Marker marker;
+    marker.stackDepth = mStack.size();
+#if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+    marker.offset = currentPageOffset;
+    marker.page   = inUseList;
+#ifdef GUARD_BLOCKS
+    marker.lastAllocation = inUseList ? inUseList->lastAllocation : 0;
+#endif
+#else  // !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+    marker.allocationCount = mStack.empty() ? 0 : mStack.back().size();
+#endif
+    return marker;
+}
+
+void TPoolAllocator::rewind(const Marker &marker)
+{
+    ASSERT(marker.stackDepth == mStack.size());
 
-    while (inUseList != page)
+#if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+    restore(marker);
+#else  // !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+    if (mStack.empty())
+        return;
+
+    std::vector<void *> &allocs = mStack.back();
+    for (size_t i = marker.allocationCount; i < allocs.size(); ++i)
+    {
+        free(allocs[i]);
+    }
+    allocs.resize(marker.allocationCount);
+#endif
+}
+
+#if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+//
+// Free the pages allocated since the marker, and carry on allocating
+// from where the marker was on its page.
+//
+void TPoolAllocator::restore(const Marker &marker)
+{
+    while (inUseList != marker.page)
     {
         // invoke destructor to free allocation list
         inUseList->~tHeader();
 
         tHeader *nextInUse = inUseList->nextPage;
-        if (inUseList->pageCount > 1)
-            delete[] reinterpret_cast<char *>(inUseList);
+        if (inUseList->size > maxPageSize)
+        {
+            inUseList->nextPage = largeFreeList;
+            largeFreeList       = inUseList;
+        }
         else
         {
             inUseList->nextPage = freeList;
@@ -222,37 +279,108 @@ void TPoolAllocator::pop()
         inUseList = nextInUse;
     }
 
-    mStack.pop_back();
-#else  // !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
-    for (auto &alloc : mStack.back())
+    if (inUseList)
     {
-        free(alloc);
+#ifdef GUARD_BLOCKS
+        if (inUseList->lastAllocation)
+            inUseList->lastAllocation->checkAllocList();
+        inUseList->lastAllocation = marker.lastAllocation;
+#endif
+        currentPageEnd = inUseList->size;
     }
-    mStack.pop_back();
+    else
+    {
+        currentPageEnd = 0;
+    }
+    currentPageOffset = marker.offset;
+}
+
+TPoolAllocator::tHeader *TPoolAllocator::newPage(tHeader **freePages,
+                                                 size_t minimumSize,
+                                                 size_t size)
+{
+    // First fit: nearly all kept pages are big enough for anything but large blocks.
+    tHeader **link = freePages;
+    while (*link && (*link)->size < minimumSize)
+    {
+        link = &(*link)->nextPage;
+    }
+
+    tHeader *memory = *link;
+    if (memory)
+    {
+        *link = memory->nextPage;
+        size  = memory->size;
+        ++pageReuses;
+    }
+    else
+    {
+        memory = reinterpret_cast<tHeader *>(::new char[size]);
+        if (memory == 0)
+            return 0;
+        ++pageAllocations;
+        reservedBytes += size;
+    }
+
+    // Use placement-new to initialize header
+    new (memory) tHeader(inUseList, size);
+    inUseList      = memory;
+    currentPageEnd = size;
+    return memory;
+}
+
+void TPoolAllocator::freePages(tHeader *pages)
+{
+    while (pages)
+    {
+        tHeader *next = pages->nextPage;
+        reservedBytes -= pages->size;
+        delete[] reinterpret_cast<char *>(pages);
+        pages = next;
+    }
+}
+#endif
+
+void TPoolAllocator::releaseUnusedPages()
+{
+#if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+    freePages(freeList);
+    freePages(largeFreeList);
+    freeList      = 0;
+    largeFreeList = 0;
+    nextPageSize  = pageSize;
 #endif
 }
 
-//
-// Do a mass-deallocation of all the individual allocations
-// that have occurred.
-//
-void TPoolAllocator::popAll()
+TPoolAllocator::Statistics TPoolAllocator::getStatistics() const
 {
-    while (mStack.size() > 0)
-        pop();
+    Statistics statistics;
+    statistics.allocationCount = static_cast<size_t>(numCalls);
+    statistics.allocatedBytes  = totalBytes;
+#if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+    statistics.pageAllocationCount = pageAllocations;
+    statistics.pageReuseCount      = pageReuses;
+    statistics.reservedBytes       = reservedBytes;
+#else
+    // Every allocation goes to the OS on its own.
+    statistics.pageAllocationCount = static_cast<size_t>(numCalls);
+    statistics.pageReuseCount      = 0;
+    statistics.reservedBytes       = 0;
+#endif
+    return statistics;
 }
 
 void *TPoolAllocator::allocate(size_t numBytes)
 {
     ASSERT(!mLocked);
 
-#if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
     //
     // Just keep some interesting statistics.
     //
     ++numCalls;
     totalBytes += numBytes;
 
+#if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
     // If we are using guard blocks, all allocations are bracketed by
     // them: [guardblock][allocation][guardblock].  numBytes is how
     // much memory the caller asked for.  allocationSize is the total
@@ -267,7 +395,7 @@ void *TPoolAllocator::allocate(size_t numBytes)
     // Do the allocation, most likely case first, for efficiency.
     // This step could be moved to be inline sometime.
     //
-    if (allocationSize <= pageSize - currentPageOffset)
+    if (allocationSize <= currentPageEnd - currentPageOffset)
     {
         //
         // Safe to allocate from currentPageOffset.
@@ -279,53 +407,44 @@ void *TPoolAllocator::allocate(size_t numBytes)
         return initializeAllocation(inUseList, memory, numBytes);
     }
 
-    if (allocationSize > pageSize - headerSkip)
+    if (allocationSize > maxPageSize - headerSkip)
     {
         //
-        // Do a multi-page allocation.  Don't mix these with the others.
-        // The OS is efficient and allocating and free-ing multiple pages.
+        // Do a large allocation.  Don't mix these with the others.
         //
         size_t numBytesToAlloc = allocationSize + headerSkip;
         // Detect integer overflow.
         if (numBytesToAlloc < allocationSize)
             return 0;
 
-        tHeader *memory = reinterpret_cast<tHeader *>(::new char[numBytesToAlloc]);
+        tHeader *memory = newPage(&largeFreeList, numBytesToAlloc, numBytesToAlloc);
         if (memory == 0)
             return 0;
 
-        // Use placement-new to initialize header
-        new (memory) tHeader(inUseList, (numBytesToAlloc + pageSize - 1) / pageSize);
-        inUseList = memory;
+        currentPageOffset = currentPageEnd;  // make next allocation come from a new page
 
-        currentPageOffset = pageSize;  // make next allocation come from a new page
-
-        // No guard blocks for multi-page allocations (yet)
+        // No guard blocks for large allocations (yet)
         return reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(memory) + headerSkip);
     }
 
     //
-    // Need a simple page to allocate from.
+    // Need a simple page to allocate from.  Pages from the OS grow
+    // geometrically, so big shaders need few of them.
     //
-    tHeader *memory;
-    if (freeList)
-    {
-        memory   = freeList;
-        freeList = freeList->nextPage;
-    }
-    else
+    size_t minimumSize = (headerSkip + allocationSize + alignmentMask) & ~alignmentMask;
+    size_t size        = nextPageSize > minimumSize ? nextPageSize : minimumSize;
+    size_t allocations = pageAllocations;
+
+    tHeader *memory = newPage(&freeList, minimumSize, size);
+    if (memory == 0)
+        return 0;
+    if (pageAllocations != allocations && nextPageSize < maxPageSize)
     {
-        memory = reinterpret_cast<tHeader *>(::new char[pageSize]);
-        if (memory == 0)
-            return 0;
+        nextPageSize = nextPageSize * 2 < maxPageSize ? nextPageSize * 2 : maxPageSize;
     }
 
-    // Use placement-new to initialize header
-    new (memory) tHeader(inUseList, 1);
-    inUseList = memory;
-
     unsigned char *ret = reinterpret_cast<unsigned char *>(inUseList) + headerSkip;
-    currentPageOffset  = (headerSkip + allocationSize + alignmentMask) & ~alignmentMask;
+    currentPageOffset  = minimumSize;
 
     return initializeAllocation(inUseList, ret, numBytes);
 #else  // !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
@@ -110,9 +110,14 @@ class TAllocation
 // repositories of free pages or used pages.
 //
 // Page stacks are linked together with a simple header at the beginning
-// of each allocation obtained from the underlying OS.  Multi-page allocations
-// are returned to the OS.  Individual page allocations are kept for future
-// re-use.
+// of each allocation obtained from the OS.  Pages start at the growth
+// increment and double each time a new one is needed, up to the maximum
+// page size, so that large shaders need few trips to the OS.  Allocations
+// too big for a page get a block of their own.
+//
+// Pages and large blocks that are freed by pop() or rewind() are kept for
+// re-use, so a pool that is reset between compiles settles at the high-water
+// mark of the largest compile and stops going to the OS.
 //
 // The "page size" used is not, nor must it match, the underlying OS
 // page size.  But, having it be about that size or equal to a set of
@@ -120,8 +125,13 @@ class TAllocation
 //
 class TPoolAllocator
 {
+  private:
+    struct tHeader;
+
   public:
-    TPoolAllocator(int growthIncrement = 8 * 1024, int allocationAlignment = 16);
+    TPoolAllocator(int growthIncrement = 8 * 1024,
+                   int allocationAlignment = 16,
+                   int maxPageSize = 256 * 1024);
 
     //
     // Don't call the destructor just to free up the memory, call pop()
@@ -145,6 +155,32 @@ class TPoolAllocator
     //
     void popAll();
 
+    //
+    // A position in the pool, for freeing temporaries without a push() and
+    // pop() pair: everything allocated after mark() is freed by rewind().
+    // Markers must be rewound in reverse order of creation, and at the same
+    // push() depth they were made at.
+    //
+    class Marker
+    {
+      private:
+        friend class TPoolAllocator;
+
+        size_t stackDepth;
+#if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+        size_t offset;
+        tHeader *page;
+#ifdef GUARD_BLOCKS
+        TAllocation *lastAllocation;
+#endif
+#else
+        size_t allocationCount;
+#endif
+    };
+
+    Marker mark() const;
+    void rewind(const Marker &marker);
+
     //
     // Call allocate() to actually acquire memory.  Returns 0 if no memory
     // available, otherwise a properly aligned pointer to 'numBytes' of memory.
@@ -158,24 +194,46 @@ class TPoolAllocator
     // by calling pop(), and to not have to solve memory leak problems.
     //
 
+    //
+    // Call releaseUnusedPages() to return the pages kept for re-use to the OS.
+    //
+    void releaseUnusedPages();
+
     // Catch unwanted allocations.
     // TODO(jmadill): Remove this when we remove the global allocator.
     void lock();
     void unlock();
 
+    struct Statistics
+    {
+        size_t allocationCount;      // calls to allocate()
+        size_t allocatedBytes;       // bytes requested through allocate()
+        size_t pageAllocationCount;  // pages and large blocks obtained from the OS
+        size_t pageReuseCount;       // pages and large blocks re-used after a pop() or rewind()
+        size_t reservedBytes;        // bytes currently held from the OS, in use or kept
+    };
+    Statistics getStatistics() const;
+
+    // Number of bytes requested through allocate() over the lifetime of the pool, not counting
+    // the alignment, guard blocks and page headers.
+    size_t getTotalAllocatedBytes() const { return totalBytes; }
+
   private:
     size_t alignment;  // all returned allocations will be aligned at
                        // this granularity, which will be a power of 2
     size_t alignmentMask;
 
+    int numCalls;       // just an interesting statistic
+    size_t totalBytes;  // just an interesting statistic
+
 #if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
     friend struct tHeader;
 
     struct tHeader
     {
-        tHeader(tHeader *nextPage, size_t pageCount)
+        tHeader(tHeader *nextPage, size_t size)
             : nextPage(nextPage),
-              pageCount(pageCount)
+              size(size)
 #ifdef GUARD_BLOCKS
               ,
               lastAllocation(0)
@@ -192,18 +250,13 @@ class TPoolAllocator
         }
 
         tHeader *nextPage;
-        size_t pageCount;
+        size_t size;  // of the whole page, header included
 #ifdef GUARD_BLOCKS
         TAllocation *lastAllocation;
 #endif
     };
 
-    struct tAllocState
-    {
-        size_t offset;
-        tHeader *page;
-    };
-    typedef std::vector<tAllocState> tAllocStack;
+    typedef std::vector<Marker> tAllocStack;
 
     // Track allocations if and only if we're using guard blocks
     void *initializeAllocation(tHeader *block, unsigned char *memory, size_t numBytes)
@@ -216,17 +269,29 @@ class TPoolAllocator
         return TAllocation::offsetAllocation(memory);
     }
 
-    size_t pageSize;           // granularity of allocation from the OS
+    // Makes a page of at least 'minimumSize' bytes the current one. Kept pages are re-used if
+    // one is big enough, otherwise a page of 'size' bytes comes from the OS.
+    tHeader *newPage(tHeader **freePages, size_t minimumSize, size_t size);
+    void freePages(tHeader *pages);
+    void restore(const Marker &marker);
+
+    size_t pageSize;           // size of the first page, and the most allocate()
+                               //      serves from shared pages at first
+    size_t maxPageSize;        // pages stop growing at this size
+    size_t nextPageSize;       // size of the next page to get from the OS
     size_t headerSkip;         // amount of memory to skip to make room for the
                                //      header (basically, size of header, rounded
                                //      up to make it aligned
     size_t currentPageOffset;  // next offset in top of inUseList to allocate from
-    tHeader *freeList;         // list of popped memory
+    size_t currentPageEnd;     // size of the top of inUseList
+    tHeader *freeList;         // list of popped pages
+    tHeader *largeFreeList;    // list of popped large blocks
     tHeader *inUseList;        // list of all memory currently being used
     tAllocStack mStack;        // stack of where to allocate from, to partition pool
 
-    int numCalls;       // just an interesting statistic
-    size_t totalBytes;  // just an interesting statistic
+    size_t pageAllocations;  // just an interesting statistic
+    size_t pageReuses;       // just an interesting statistic
+    size_t reservedBytes;    // just an interesting statistic
 
 #else  // !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
     std::vector<std::vector<void *>> mStack;
@@ -242,9 +307,56 @@ class TPoolAllocator
 // different times.  But a simple use is to have a global pop
 // with everyone using the same global allocator.
 //
+// The "global" allocator is per thread: it is the pool that objects and containers created on
+// this thread without an explicit allocator are bound to.
+//
 extern TPoolAllocator *GetGlobalPoolAllocator();
 extern void SetGlobalPoolAllocator(TPoolAllocator *poolAllocator);
 
+//
+// Makes a pool the current thread's global allocator for the lifetime of this object, and
+// restores the previous one afterwards, so that compilers can be used from any thread and
+// from within each other.
+//
+class TScopedGlobalPoolAllocator
+{
+  public:
+    TScopedGlobalPoolAllocator(TPoolAllocator *allocator)
+        : mPreviousAllocator(GetGlobalPoolAllocator())
+    {
+        SetGlobalPoolAllocator(allocator);
+    }
+    ~TScopedGlobalPoolAllocator() { SetGlobalPoolAllocator(mPreviousAllocator); }
+
+  private:
+    TScopedGlobalPoolAllocator(const TScopedGlobalPoolAllocator &);
+    TScopedGlobalPoolAllocator &operator=(const TScopedGlobalPoolAllocator &);
+
+    TPoolAllocator *mPreviousAllocator;
+};
+
+//
+// Frees everything allocated from a pool during the lifetime of this object.
+// For temporaries that die within a pass, while what the pass creates for
+// later ones is allocated before or after it.
+//
+class TScopedPoolRewind
+{
+  public:
+    TScopedPoolRewind(TPoolAllocator *allocator)
+        : mAllocator(allocator), mMarker(allocator->mark())
+    {
+    }
+    ~TScopedPoolRewind() { mAllocator->rewind(mMarker); }
+
+  private:
+    TScopedPoolRewind(const TScopedPoolRewind &);
+    TScopedPoolRewind &operator=(const TScopedPoolRewind &);
+
+    TPoolAllocator *mAllocator;
+    TPoolAllocator::Marker mMarker;
+};
+
 //
 // This STL compatible allocator is intended to be used as the allocator
 // parameter to templatized STL containers, like vector and map.
@@ -252,6 +364,11 @@ extern void SetGlobalPoolAllocator(TPoolAllocator *poolAllocator);
 // It will use the pools for allocation, and not
 // do any deallocation, but will still do destruction.
 //
+// An allocator remembers the pool it was created for: either the one it is given, or the
+// thread's global allocator at the time it is constructed. Containers therefore keep
+// allocating from their own pool even when another compiler's pool is current. Allocators
+// created while no pool is current look up the global allocator on each allocation instead.
+//
 template <class T>
 class pool_allocator
 {
@@ -272,19 +389,25 @@ class pool_allocator
     pointer address(reference x) const { return &x; }
     const_pointer address(const_reference x) const { return &x; }
 
-    pool_allocator() {}
+    pool_allocator() : mAllocator(GetGlobalPoolAllocator()) {}
+    explicit pool_allocator(TPoolAllocator &allocator) : mAllocator(&allocator) {}
 
     template <class Other>
-    pool_allocator(const pool_allocator<Other> &p)
+    pool_allocator(const pool_allocator<Other> &p) : mAllocator(p.getBoundAllocator())
     {
     }
 
     template <class Other>
     pool_allocator<T> &operator=(const pool_allocator<Other> &p)
     {
+        mAllocator = p.getBoundAllocator();
         return *this;
     }
 
+    // Copies of a container allocate from the pool that is current where the copy is made, not
+    // from the pool of the original, which may belong to another thread.
+    pool_allocator select_on_container_copy_construction() const { return pool_allocator(); }
+
 #if defined(__SUNPRO_CC) && !defined(_RWSTD_ALLOCATOR)
     // libCStd on some platforms have a different allocate/deallocate interface.
     // Caller pre-bakes sizeof(T) into 'n' which is the number of bytes to be
@@ -307,13 +430,20 @@ class pool_allocator
     void construct(pointer p, const T &val) { new ((void *)p) T(val); }
     void destroy(pointer p) { p->T::~T(); }
 
-    bool operator==(const pool_allocator &rhs) const { return true; }
-    bool operator!=(const pool_allocator &rhs) const { return false; }
+    bool operator==(const pool_allocator &rhs) const { return mAllocator == rhs.mAllocator; }
+    bool operator!=(const pool_allocator &rhs) const { return mAllocator != rhs.mAllocator; }
 
     size_type max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
     size_type max_size(int size) const { return static_cast<size_type>(-1) / size; }
 
-    TPoolAllocator &getAllocator() const { return *GetGlobalPoolAllocator(); }
+    TPoolAllocator &getAllocator() const
+    {
+        return mAllocator ? *mAllocator : *GetGlobalPoolAllocator();
+    }
+    TPoolAllocator *getBoundAllocator() const { return mAllocator; }
+
+  private:
+    TPoolAllocator *mAllocator;
 };
 
 #endif  // COMPILER_TRANSLATOR_POOLALLOC_H_
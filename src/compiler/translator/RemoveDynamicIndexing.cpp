@@ -63,7 +63,7 @@ TIntermSymbol *CreateBaseSymbol(const TType &type, TQualifier qualifier)
 {
     TIntermSymbol *symbol = new TIntermSymbol(0, "base", type);
     symbol->setInternal(true);
-    symbol->getTypePointer()->setQualifier(qualifier);
+    symbol->setQualifier(qualifier);
     return symbol;
 }
 
@@ -71,7 +71,7 @@ TIntermSymbol *CreateIndexSymbol()
 {
     TIntermSymbol *symbol = new TIntermSymbol(0, "index", TType(EbtInt, EbpHigh));
     symbol->setInternal(true);
-    symbol->getTypePointer()->setQualifier(EvqIn);
+    symbol->setQualifier(EvqIn);
     return symbol;
 }
 
@@ -79,7 +79,7 @@ TIntermSymbol *CreateValueSymbol(const TType &type)
 {
     TIntermSymbol *symbol = new TIntermSymbol(0, "value", type);
     symbol->setInternal(true);
-    symbol->getTypePointer()->setQualifier(EvqIn);
+    symbol->setQualifier(EvqIn);
     return symbol;
 }
 
@@ -11,8 +11,10 @@
 
 #include "GLSLANG/ShaderLang.h"
 
+#include "compiler/translator/BatchTranslator.h"
 #include "compiler/translator/Compiler.h"
 #include "compiler/translator/InitializeDll.h"
+#include "compiler/translator/ShaderVariants.h"
 #include "compiler/translator/length_limits.h"
 #ifdef ANGLE_ENABLE_HLSL
 #include "compiler/translator/TranslatorHLSL.h"
@@ -335,6 +337,23 @@ const std::map<std::string, std::string> *ShGetNameHashingMap(const ShHandle han
     return &(compiler->getNameMap());
 }
 
+const std::map<std::string, std::string> *ShGetMinifiedNameMap(const ShHandle handle)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler);
+    return &(compiler->getMinifiedNameMap());
+}
+
+const ShCompileStatistics *ShGetCompileStatistics(const ShHandle handle)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    if (!compiler)
+    {
+        return nullptr;
+    }
+    return compiler->getCompileStatistics();
+}
+
 const std::vector<Uniform> *ShGetUniforms(const ShHandle handle)
 {
     return GetShaderVariables<Uniform>(handle);
@@ -360,6 +379,13 @@ const std::vector<InterfaceBlock> *ShGetInterfaceBlocks(const ShHandle handle)
     return GetShaderVariables<InterfaceBlock>(handle);
 }
 
+void ShTakeReflection(const ShHandle handle, sh::ShaderReflection *reflectionOut)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler && reflectionOut);
+    compiler->takeReflection(reflectionOut);
+}
+
 WorkGroupSize ShGetComputeShaderLocalGroupSize(const ShHandle handle)
 {
     ASSERT(handle);
@@ -412,6 +438,28 @@ const std::map<std::string, unsigned int> *ShGetUniformRegisterMap(const ShHandl
 #endif  // ANGLE_ENABLE_HLSL
 }
 
+bool ShTranslateBatch(const ShBatchOptions &options,
+                      const std::vector<ShBatchShader> &shaders,
+                      std::vector<ShBatchResult> *results)
+{
+    ASSERT(results);
+    BatchTranslator translator(options, shaders, results);
+    return translator.run();
+}
+
+bool ShCompileVariants(const ShHandle handle,
+                       const ShShaderVariantSet &variantSet,
+                       ShCompileOptions compileOptions,
+                       std::vector<ShBatchResult> *results,
+                       ShVariantStatistics *statistics)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler);
+    ASSERT(results);
+
+    return CompileShaderVariants(compiler, variantSet, compileOptions, results, statistics);
+}
+
 namespace sh
 {
 bool Initialize()
@@ -485,6 +533,16 @@ const std::map<std::string, std::string> *GetNameHashingMap(const ShHandle handl
     return ShGetNameHashingMap(handle);
 }
 
+const std::map<std::string, std::string> *GetMinifiedNameMap(const ShHandle handle)
+{
+    return ShGetMinifiedNameMap(handle);
+}
+
+const ShCompileStatistics *GetCompileStatistics(const ShHandle handle)
+{
+    return ShGetCompileStatistics(handle);
+}
+
 const std::vector<sh::Uniform> *GetUniforms(const ShHandle handle)
 {
     return ShGetUniforms(handle);
@@ -512,6 +570,11 @@ sh::WorkGroupSize GetComputeShaderLocalGroupSize(const ShHandle handle)
     return ShGetComputeShaderLocalGroupSize(handle);
 }
 
+void TakeReflection(const ShHandle handle, sh::ShaderReflection *reflectionOut)
+{
+    ShTakeReflection(handle, reflectionOut);
+}
+
 bool CheckVariablesWithinPackingLimits(int maxVectors,
                                        const std::vector<sh::ShaderVariable> &variables)
 {
@@ -530,4 +593,20 @@ const std::map<std::string, unsigned int> *GetUniformRegisterMap(const ShHandle
     return ShGetUniformRegisterMap(handle);
 }
 
+bool TranslateBatch(const ShBatchOptions &options,
+                    const std::vector<ShBatchShader> &shaders,
+                    std::vector<ShBatchResult> *results)
+{
+    return ShTranslateBatch(options, shaders, results);
+}
+
+bool CompileVariants(const ShHandle handle,
+                     const ShShaderVariantSet &variantSet,
+                     ShCompileOptions compileOptions,
+                     std::vector<ShBatchResult> *results,
+                     ShVariantStatistics *statistics)
+{
+    return ShCompileVariants(handle, variantSet, compileOptions, results, statistics);
+}
+
 }  // namespace sh
@@ -0,0 +1,134 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShaderVariants:
+//   Implementation of shader variant compilation.
+//
+
+#include "compiler/translator/ShaderVariants.h"
+
+#include <chrono>
+#include <unordered_map>
+
+#include "compiler/translator/Compiler.h"
+#include "compiler/translator/length_limits.h"
+#include "compiler/preprocessor/StringTable.h"
+#include "compiler/preprocessor/Token.h"
+#include "compiler/preprocessor/Tokenizer.h"
+
+namespace sh
+{
+
+namespace
+{
+
+std::string GetDefinesString(const std::string &preamble, const ShShaderVariant &variant)
+{
+    // A directive must start on a line of its own, so end the preamble's last line first.
+    std::string defines;
+    if (!preamble.empty() && preamble.back() != '\n')
+    {
+        defines = "\n";
+    }
+    for (const auto &define : variant.defines)
+    {
+        defines += "#define " + define.first + " " + define.second + "\n";
+    }
+    // The body has to start on a line of its own for its tokens to be reusable, so end the
+    // preamble's last line even if there is nothing to define.
+    if (defines.empty())
+    {
+        defines = "\n";
+    }
+    return defines;
+}
+
+}  // anonymous namespace
+
+bool CompileShaderVariants(TCompiler *compiler,
+                           const ShShaderVariantSet &variantSet,
+                           ShCompileOptions compileOptions,
+                           std::vector<ShBatchResult> *results,
+                           ShVariantStatistics *statistics)
+{
+    // The strings are made up here, none of them is a path.
+    compileOptions &= ~SH_SOURCE_PATH;
+
+    // Each compilation interns the body's text again in its own preprocessor's table.
+    pp::StringTable bodyStrings;
+    std::vector<pp::Token> bodyTokens;
+    bool reuseBodyTokens = pp::Tokenizer::TokenizeString(
+        variantSet.body.c_str(), GetGlobalMaxTokenSize(compiler->getShaderSpec()), &bodyStrings,
+        &bodyTokens);
+#if defined(ANGLE_ENABLE_FUZZER_CORPUS_OUTPUT)
+    // The corpus needs the whole source of each compilation.
+    reuseBodyTokens = false;
+#endif  // defined(ANGLE_ENABLE_FUZZER_CORPUS_OUTPUT)
+    const std::vector<pp::Token> *appendedTokens = reuseBodyTokens ? &bodyTokens : nullptr;
+    const size_t numStrings                      = reuseBodyTokens ? 2 : 3;
+
+    // Index of the variant that was compiled for each distinct preprocessed source.
+    std::unordered_map<std::string, size_t> compiledVariants;
+    std::string preprocessed;
+
+    results->assign(variantSet.variants.size(), ShBatchResult());
+    size_t compiledVariantCount = 0;
+    bool allCompiled            = true;
+
+    for (size_t index = 0; index < variantSet.variants.size(); ++index)
+    {
+        const ShShaderVariant &variant = variantSet.variants[index];
+        ShBatchResult &result          = (*results)[index];
+        auto start                     = std::chrono::steady_clock::now();
+
+        std::string defines         = GetDefinesString(variantSet.preamble, variant);
+        const char *shaderStrings[] = {variantSet.preamble.c_str(), defines.c_str(),
+                                       variantSet.body.c_str()};
+        compiler->preprocess(shaderStrings, numStrings, appendedTokens, &preprocessed);
+
+        auto compiledVariant = compiledVariants.find(preprocessed);
+        if (compiledVariant != compiledVariants.end())
+        {
+            result = (*results)[compiledVariant->second];
+        }
+        else
+        {
+            result.success = reuseBodyTokens
+                                 ? compiler->compile(shaderStrings, numStrings, bodyTokens,
+                                                     compileOptions)
+                                 : compiler->compile(shaderStrings, numStrings, compileOptions);
+            result.infoLog = compiler->getInfoSink().info.str();
+            if (result.success && (compileOptions & SH_OBJECT_CODE))
+            {
+                result.objectCode = compiler->getInfoSink().obj.str();
+            }
+            compiledVariants.insert(std::make_pair(preprocessed, index));
+            ++compiledVariantCount;
+        }
+
+        result.name = variant.name;
+        result.seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (!result.success)
+        {
+            allCompiled = false;
+        }
+    }
+
+    if (statistics)
+    {
+        statistics->variantCount         = variantSet.variants.size();
+        statistics->compiledVariantCount = compiledVariantCount;
+        statistics->dedupRate =
+            variantSet.variants.empty()
+                ? 0.0
+                : 1.0 - static_cast<double>(compiledVariantCount) / variantSet.variants.size();
+        statistics->bodyTokensReused = reuseBodyTokens;
+    }
+
+    return allCompiled;
+}
+
+}  // namespace sh
@@ -0,0 +1,32 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShaderVariants:
+//   Compiles variants of a shader that only differ in the macros they define, tokenizing the
+//   shared body once and compiling each distinct preprocessed source once.
+//
+
+#ifndef COMPILER_TRANSLATOR_SHADERVARIANTS_H_
+#define COMPILER_TRANSLATOR_SHADERVARIANTS_H_
+
+#include <vector>
+
+#include "GLSLANG/ShaderLang.h"
+
+namespace sh
+{
+
+class TCompiler;
+
+// Returns true if all the variants compiled. statistics can be null.
+bool CompileShaderVariants(TCompiler *compiler,
+                           const ShShaderVariantSet &variantSet,
+                           ShCompileOptions compileOptions,
+                           std::vector<ShBatchResult> *results,
+                           ShVariantStatistics *statistics);
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_SHADERVARIANTS_H_
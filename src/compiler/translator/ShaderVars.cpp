@@ -9,6 +9,9 @@
 
 #include <GLSLANG/ShaderLang.h>
 
+#include <string.h>
+#include <utility>
+
 #include "common/debug.h"
 
 namespace sh
@@ -21,6 +24,40 @@ InterpolationType GetNonAuxiliaryInterpolationType(InterpolationType interpolati
 {
     return (interpolation == INTERPOLATION_CENTROID ? INTERPOLATION_SMOOTH : interpolation);
 }
+
+void GetShaderVariable(const ShaderReflection &reflection,
+                       const ShaderReflection::Variable &record,
+                       ShaderVariable *variable)
+{
+    variable->type       = record.type;
+    variable->precision  = record.precision;
+    variable->name       = reflection.getString(record.name);
+    variable->mappedName = reflection.getString(record.mappedName);
+    variable->arraySize  = record.arraySize;
+    variable->staticUse  = record.staticUse;
+    variable->structName = reflection.getString(record.structName);
+
+    variable->fields.resize(record.fieldRange.count);
+    for (size_t fieldIndex = 0; fieldIndex < record.fieldRange.count; ++fieldIndex)
+    {
+        GetShaderVariable(reflection, reflection.getField(record.fieldRange, fieldIndex),
+                          &variable->fields[fieldIndex]);
+    }
+}
+
+template <typename VarT>
+void GetInterfaceVariables(const ShaderReflection &reflection,
+                           const std::vector<ShaderReflection::Variable> &records,
+                           std::vector<VarT> *variablesOut)
+{
+    variablesOut->clear();
+    variablesOut->resize(records.size());
+    for (size_t index = 0; index < records.size(); ++index)
+    {
+        GetShaderVariable(reflection, records[index], &(*variablesOut)[index]);
+        (*variablesOut)[index].location = records[index].location;
+    }
+}
 }
 // The ES 3.0 spec is not clear on this point, but the ES 3.1 spec, and discussion
 // on Khronos.org, clarifies that a smooth/flat mismatch produces a link error,
@@ -68,6 +105,31 @@ ShaderVariable &ShaderVariable::operator=(const ShaderVariable &other)
     return *this;
 }
 
+ShaderVariable::ShaderVariable(ShaderVariable &&other) noexcept
+    : type(other.type),
+      precision(other.precision),
+      name(std::move(other.name)),
+      mappedName(std::move(other.mappedName)),
+      arraySize(other.arraySize),
+      staticUse(other.staticUse),
+      fields(std::move(other.fields)),
+      structName(std::move(other.structName))
+{
+}
+
+ShaderVariable &ShaderVariable::operator=(ShaderVariable &&other) noexcept
+{
+    type       = other.type;
+    precision  = other.precision;
+    name       = std::move(other.name);
+    mappedName = std::move(other.mappedName);
+    arraySize  = other.arraySize;
+    staticUse  = other.staticUse;
+    fields     = std::move(other.fields);
+    structName = std::move(other.structName);
+    return *this;
+}
+
 bool ShaderVariable::operator==(const ShaderVariable &other) const
 {
     if (type != other.type || precision != other.precision || name != other.name ||
@@ -199,6 +261,16 @@ Uniform &Uniform::operator=(const Uniform &other)
     return *this;
 }
 
+Uniform::Uniform(Uniform &&other) noexcept : ShaderVariable(std::move(other))
+{
+}
+
+Uniform &Uniform::operator=(Uniform &&other) noexcept
+{
+    ShaderVariable::operator=(std::move(other));
+    return *this;
+}
+
 bool Uniform::operator==(const Uniform &other) const
 {
     return ShaderVariable::operator==(other);
@@ -229,6 +301,18 @@ InterfaceVariable &InterfaceVariable::operator=(const InterfaceVariable &other)
     return *this;
 }
 
+InterfaceVariable::InterfaceVariable(InterfaceVariable &&other) noexcept
+    : ShaderVariable(std::move(other)), location(other.location)
+{
+}
+
+InterfaceVariable &InterfaceVariable::operator=(InterfaceVariable &&other) noexcept
+{
+    ShaderVariable::operator=(std::move(other));
+    location                = other.location;
+    return *this;
+}
+
 bool InterfaceVariable::operator==(const InterfaceVariable &other) const
 {
     return (ShaderVariable::operator==(other) && location == other.location);
@@ -252,6 +336,16 @@ Attribute &Attribute::operator=(const Attribute &other)
     return *this;
 }
 
+Attribute::Attribute(Attribute &&other) noexcept : InterfaceVariable(std::move(other))
+{
+}
+
+Attribute &Attribute::operator=(Attribute &&other) noexcept
+{
+    InterfaceVariable::operator=(std::move(other));
+    return *this;
+}
+
 bool Attribute::operator==(const Attribute &other) const
 {
     return InterfaceVariable::operator==(other);
@@ -275,6 +369,17 @@ OutputVariable &OutputVariable::operator=(const OutputVariable &other)
     return *this;
 }
 
+OutputVariable::OutputVariable(OutputVariable &&other) noexcept
+    : InterfaceVariable(std::move(other))
+{
+}
+
+OutputVariable &OutputVariable::operator=(OutputVariable &&other) noexcept
+{
+    InterfaceVariable::operator=(std::move(other));
+    return *this;
+}
+
 bool OutputVariable::operator==(const OutputVariable &other) const
 {
     return InterfaceVariable::operator==(other);
@@ -300,6 +405,18 @@ InterfaceBlockField &InterfaceBlockField::operator=(const InterfaceBlockField &o
     return *this;
 }
 
+InterfaceBlockField::InterfaceBlockField(InterfaceBlockField &&other) noexcept
+    : ShaderVariable(std::move(other)), isRowMajorLayout(other.isRowMajorLayout)
+{
+}
+
+InterfaceBlockField &InterfaceBlockField::operator=(InterfaceBlockField &&other) noexcept
+{
+    ShaderVariable::operator=(std::move(other));
+    isRowMajorLayout        = other.isRowMajorLayout;
+    return *this;
+}
+
 bool InterfaceBlockField::operator==(const InterfaceBlockField &other) const
 {
     return (ShaderVariable::operator==(other) && isRowMajorLayout == other.isRowMajorLayout);
@@ -333,6 +450,21 @@ Varying &Varying::operator=(const Varying &other)
     return *this;
 }
 
+Varying::Varying(Varying &&other) noexcept
+    : ShaderVariable(std::move(other)),
+      interpolation(other.interpolation),
+      isInvariant(other.isInvariant)
+{
+}
+
+Varying &Varying::operator=(Varying &&other) noexcept
+{
+    ShaderVariable::operator=(std::move(other));
+    interpolation           = other.interpolation;
+    isInvariant             = other.isInvariant;
+    return *this;
+}
+
 bool Varying::operator==(const Varying &other) const
 {
     return (ShaderVariable::operator==(other) && interpolation == other.interpolation &&
@@ -385,6 +517,31 @@ InterfaceBlock &InterfaceBlock::operator=(const InterfaceBlock &other)
     return *this;
 }
 
+InterfaceBlock::InterfaceBlock(InterfaceBlock &&other) noexcept
+    : name(std::move(other.name)),
+      mappedName(std::move(other.mappedName)),
+      instanceName(std::move(other.instanceName)),
+      arraySize(other.arraySize),
+      layout(other.layout),
+      isRowMajorLayout(other.isRowMajorLayout),
+      staticUse(other.staticUse),
+      fields(std::move(other.fields))
+{
+}
+
+InterfaceBlock &InterfaceBlock::operator=(InterfaceBlock &&other) noexcept
+{
+    name             = std::move(other.name);
+    mappedName       = std::move(other.mappedName);
+    instanceName     = std::move(other.instanceName);
+    arraySize        = other.arraySize;
+    layout           = other.layout;
+    isRowMajorLayout = other.isRowMajorLayout;
+    staticUse        = other.staticUse;
+    fields           = std::move(other.fields);
+    return *this;
+}
+
 std::string InterfaceBlock::fieldPrefix() const
 {
     return instanceName.empty() ? "" : name;
@@ -410,6 +567,188 @@ bool InterfaceBlock::isSameInterfaceBlockAtLinkTime(const InterfaceBlock &other)
     return true;
 }
 
+ShaderReflection::Variable::Variable()
+    : type(0),
+      precision(0),
+      arraySize(0),
+      staticUse(false),
+      location(-1),
+      interpolation(INTERPOLATION_SMOOTH),
+      isInvariant(false),
+      isRowMajorLayout(false)
+{
+}
+
+ShaderReflection::Block::Block()
+    : arraySize(0), layout(BLOCKLAYOUT_PACKED), isRowMajorLayout(false), staticUse(false)
+{
+}
+
+ShaderReflection::ShaderReflection()
+{
+}
+
+ShaderReflection::~ShaderReflection()
+{
+}
+
+ShaderReflection::ShaderReflection(const ShaderReflection &other) = default;
+
+ShaderReflection &ShaderReflection::operator=(const ShaderReflection &other) = default;
+
+ShaderReflection::ShaderReflection(ShaderReflection &&other) noexcept = default;
+
+ShaderReflection &ShaderReflection::operator=(ShaderReflection &&other) noexcept = default;
+
+void ShaderReflection::clear()
+{
+    strings.clear();
+    attributes.clear();
+    outputVariables.clear();
+    uniforms.clear();
+    varyings.clear();
+    interfaceBlocks.clear();
+    fields.clear();
+}
+
+ShaderReflection::StringRange ShaderReflection::addString(const char *str, size_t length)
+{
+    StringRange range;
+    range.offset = static_cast<unsigned int>(strings.size());
+    range.length = static_cast<unsigned int>(length);
+    strings.append(str, length);
+    return range;
+}
+
+ShaderReflection::StringRange ShaderReflection::addString(const std::string &str)
+{
+    return addString(str.c_str(), str.length());
+}
+
+ShaderReflection::FieldRange ShaderReflection::addFields(size_t count)
+{
+    FieldRange range;
+    range.first = static_cast<unsigned int>(fields.size());
+    range.count = static_cast<unsigned int>(count);
+    fields.resize(fields.size() + count);
+    return range;
+}
+
+std::string ShaderReflection::getString(StringRange range) const
+{
+    ASSERT(range.offset + range.length <= strings.size());
+    return std::string(strings.data() + range.offset, range.length);
+}
+
+bool ShaderReflection::stringEquals(StringRange range, const char *str, size_t length) const
+{
+    ASSERT(range.offset + range.length <= strings.size());
+    return range.length == length && memcmp(strings.data() + range.offset, str, length) == 0;
+}
+
+bool ShaderReflection::stringEquals(StringRange range, const char *str) const
+{
+    return stringEquals(range, str, strlen(str));
+}
+
+bool ShaderReflection::stringEquals(StringRange range, const std::string &str) const
+{
+    return stringEquals(range, str.c_str(), str.length());
+}
+
+// static
+bool ShaderReflection::StringsEqual(const ShaderReflection &a,
+                                    StringRange rangeA,
+                                    const ShaderReflection &b,
+                                    StringRange rangeB)
+{
+    ASSERT(rangeB.offset + rangeB.length <= b.strings.size());
+    return a.stringEquals(rangeA, b.strings.data() + rangeB.offset, rangeB.length);
+}
+
+bool ShaderReflection::isBuiltIn(const Variable &variable) const
+{
+    const char kPrefix[] = "gl_";
+    return variable.name.length >= 3 &&
+           memcmp(strings.data() + variable.name.offset, kPrefix, 3) == 0;
+}
+
+const ShaderReflection::Variable &ShaderReflection::getField(FieldRange range, size_t index) const
+{
+    ASSERT(index < range.count);
+    return fields[range.first + index];
+}
+
+ShaderReflection::Variable &ShaderReflection::getField(FieldRange range, size_t index)
+{
+    ASSERT(index < range.count);
+    return fields[range.first + index];
+}
+
+void ShaderReflection::getAttributes(std::vector<Attribute> *attributesOut) const
+{
+    GetInterfaceVariables(*this, attributes, attributesOut);
+}
+
+void ShaderReflection::getOutputVariables(std::vector<OutputVariable> *outputVariablesOut) const
+{
+    GetInterfaceVariables(*this, outputVariables, outputVariablesOut);
+}
+
+void ShaderReflection::getUniforms(std::vector<Uniform> *uniformsOut) const
+{
+    uniformsOut->clear();
+    uniformsOut->resize(uniforms.size());
+    for (size_t index = 0; index < uniforms.size(); ++index)
+    {
+        GetShaderVariable(*this, uniforms[index], &(*uniformsOut)[index]);
+    }
+}
+
+void ShaderReflection::getVaryings(std::vector<Varying> *varyingsOut) const
+{
+    varyingsOut->clear();
+    varyingsOut->resize(varyings.size());
+    for (size_t index = 0; index < varyings.size(); ++index)
+    {
+        getVarying(varyings[index], &(*varyingsOut)[index]);
+    }
+}
+
+void ShaderReflection::getVarying(const Variable &record, Varying *varyingOut) const
+{
+    GetShaderVariable(*this, record, varyingOut);
+    varyingOut->interpolation = record.interpolation;
+    varyingOut->isInvariant   = record.isInvariant;
+}
+
+void ShaderReflection::getInterfaceBlocks(std::vector<InterfaceBlock> *interfaceBlocksOut) const
+{
+    interfaceBlocksOut->clear();
+    interfaceBlocksOut->resize(interfaceBlocks.size());
+    for (size_t index = 0; index < interfaceBlocks.size(); ++index)
+    {
+        const Block &record   = interfaceBlocks[index];
+        InterfaceBlock &block = (*interfaceBlocksOut)[index];
+
+        block.name             = getString(record.name);
+        block.mappedName       = getString(record.mappedName);
+        block.instanceName     = getString(record.instanceName);
+        block.arraySize        = record.arraySize;
+        block.layout           = record.layout;
+        block.isRowMajorLayout = record.isRowMajorLayout;
+        block.staticUse        = record.staticUse;
+
+        block.fields.resize(record.fieldRange.count);
+        for (size_t fieldIndex = 0; fieldIndex < record.fieldRange.count; ++fieldIndex)
+        {
+            const Variable &fieldRecord = getField(record.fieldRange, fieldIndex);
+            GetShaderVariable(*this, fieldRecord, &block.fields[fieldIndex]);
+            block.fields[fieldIndex].isRowMajorLayout = fieldRecord.isRowMajorLayout;
+        }
+    }
+}
+
 void WorkGroupSize::fill(int fillValue)
 {
     localSizeQualifiers[0] = fillValue;
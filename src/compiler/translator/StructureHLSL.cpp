@@ -17,6 +17,32 @@
 namespace sh
 {
 
+namespace
+{
+
+// The code of a built-in type constructor only depends on the shapes of the constructed type and
+// of its arguments, so these identify it without generating it.
+void AppendTypeShape(const TType &type, TString *signature)
+{
+    signature->push_back(static_cast<char>(type.getBasicType()));
+    signature->push_back(static_cast<char>(type.getNominalSize()));
+    signature->push_back(static_cast<char>(type.getSecondarySize()));
+}
+
+TString BuiltInConstructorSignature(const TType &type, const TIntermSequence &parameters)
+{
+    TString signature;
+    signature.reserve(3 * (parameters.size() + 1));
+    AppendTypeShape(type, &signature);
+    for (TIntermNode *parameter : parameters)
+    {
+        AppendTypeShape(parameter->getAsTyped()->getType(), &signature);
+    }
+    return signature;
+}
+
+}  // anonymous namespace
+
 Std140PaddingHelper::Std140PaddingHelper(const std::map<TString, int> &structElementIndexes,
                                          unsigned *uniqueCounter)
     : mPaddingCounter(uniqueCounter), mElementIndex(0), mStructElementIndexes(&structElementIndexes)
@@ -288,12 +314,18 @@ TString StructureHLSL::addConstructor(const TType &type,
     }
     else if (parameters)
     {
+        constructorFunctionName = TString(name) + DisambiguateFunctionName(parameters);
+        const TString &signature = BuiltInConstructorSignature(ctorType, *parameters);
+        if (!mBuiltInConstructorSignatures.insert(signature).second)
+        {
+            return constructorFunctionName;  // Already added
+        }
+
         for (auto parameter : *parameters)
         {
             const TType &paramType = parameter->getAsTyped()->getType();
             ctorParameters.push_back(paramType);
         }
-        constructorFunctionName = TString(name) + DisambiguateFunctionName(parameters);
     }
     else
         UNREACHABLE();
@@ -73,6 +73,7 @@ class StructureHLSL : angle::NonCopyable
 
     typedef std::set<TString> Constructors;
     Constructors mConstructors;
+    std::set<TString> mBuiltInConstructorSignatures;
 
     typedef std::vector<TString> StructDeclarations;
     StructDeclarations mStructDeclarations;
@@ -22,7 +22,7 @@
 namespace sh
 {
 
-int TSymbolTable::uniqueIdCounter = 0;
+std::atomic<int> TSymbolTable::uniqueIdCounter(0);
 
 TSymbol::TSymbol(const TString *n) : uniqueId(TSymbolTable::nextUniqueId()), name(n)
 {
@@ -55,48 +55,114 @@ void TFunction::swapParameters(const TFunction &parametersSource)
 
 const TString *TFunction::buildMangledName() const
 {
-    std::string newName = mangleName(getName()).c_str();
+    // Built straight into the pool string: this runs for every function call the parser looks up.
+    size_t length = getName().size() + 1;
+    for (const auto &p : parameters)
+    {
+        length += p.type->getMangledName().size();
+    }
 
+    TString *newName = new (GetGlobalPoolAllocator()->allocate(sizeof(TString))) TString();
+    newName->reserve(length);
+    *newName += getName();
+    *newName += '(';
     for (const auto &p : parameters)
     {
-        newName += p.type->getMangledName().c_str();
+        *newName += p.type->getMangledName();
     }
 
-    return NewPoolTString(newName.c_str());
+    return newName;
 }
 
 //
-// Symbol table levels are a map of pointers to symbols that have to be deleted.
+// Symbol table levels are a hash table of pointers to symbols that have to be deleted.
 //
 TSymbolTableLevel::~TSymbolTableLevel()
 {
-    for (tLevel::iterator it = level.begin(); it != level.end(); ++it)
-        delete (*it).second;
+    for (const Entry &entry : mEntries)
+        delete entry.symbol;
 }
 
-bool TSymbolTableLevel::insert(TSymbol *symbol)
+size_t TSymbolTableLevel::HashName(const TString &name)
 {
-    // returning true means symbol was added to the table
-    tInsertResult result = level.insert(tLevelPair(symbol->getMangledName(), symbol));
+    // FNV-1a. Names are short, so this is cheaper than one string compare per level of a map.
+    size_t hash = static_cast<size_t>(2166136261u);
+    for (char c : name)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= static_cast<size_t>(16777619u);
+    }
+    return hash;
+}
 
-    return result.second;
+bool TSymbolTableLevel::insert(TSymbol *symbol)
+{
+    return insert(symbol->getMangledName(), symbol);
 }
 
 bool TSymbolTableLevel::insertUnmangled(TFunction *function)
 {
+    return insert(function->getName(), function);
+}
+
+bool TSymbolTableLevel::insert(const TString &name, TSymbol *symbol)
+{
+    // Keep the table at most half full so that probe sequences stay short.
+    if ((mSymbolCount + 1) * 2 > mEntries.size())
+        grow();
+
     // returning true means symbol was added to the table
-    tInsertResult result = level.insert(tLevelPair(function->getName(), function));
+    size_t hash = HashName(name);
+    size_t mask = mEntries.size() - 1;
+    for (size_t index = hash & mask;; index = (index + 1) & mask)
+    {
+        Entry &entry = mEntries[index];
+        if (entry.symbol == nullptr)
+        {
+            entry.hash   = hash;
+            entry.name   = &name;
+            entry.symbol = symbol;
+            ++mSymbolCount;
+            return true;
+        }
+        if (entry.hash == hash && *entry.name == name)
+            return false;
+    }
+}
+
+void TSymbolTableLevel::grow()
+{
+    std::vector<Entry> oldEntries;
+    oldEntries.swap(mEntries);
+    mEntries.resize(oldEntries.empty() ? 16 : oldEntries.size() * 2, Entry{0, nullptr, nullptr});
 
-    return result.second;
+    size_t mask = mEntries.size() - 1;
+    for (const Entry &entry : oldEntries)
+    {
+        if (entry.symbol == nullptr)
+            continue;
+
+        size_t index = entry.hash & mask;
+        while (mEntries[index].symbol != nullptr)
+            index = (index + 1) & mask;
+        mEntries[index] = entry;
+    }
 }
 
-TSymbol *TSymbolTableLevel::find(const TString &name) const
+TSymbol *TSymbolTableLevel::find(const TString &name, size_t hash) const
 {
-    tLevel::const_iterator it = level.find(name);
-    if (it == level.end())
+    if (mSymbolCount == 0)
         return 0;
-    else
-        return (*it).second;
+
+    size_t mask = mEntries.size() - 1;
+    for (size_t index = hash & mask;; index = (index + 1) & mask)
+    {
+        const Entry &entry = mEntries[index];
+        if (entry.symbol == nullptr)
+            return 0;
+        if (entry.hash == hash && *entry.name == name)
+            return entry.symbol;
+    }
 }
 
 TSymbol *TSymbolTable::find(const TString &name,
@@ -104,7 +170,8 @@ TSymbol *TSymbolTable::find(const TString &name,
                             bool *builtIn,
                             bool *sameScope) const
 {
-    int level = currentLevel();
+    int level   = currentLevel();
+    size_t hash = TSymbolTableLevel::HashName(name);
     TSymbol *symbol;
 
     do
@@ -116,7 +183,7 @@ TSymbol *TSymbolTable::find(const TString &name,
         if (level == ESSL1_BUILTINS && shaderVersion != 100)
             level--;
 
-        symbol = table[level]->find(name);
+        symbol = table[level]->find(name, hash);
     } while (symbol == 0 && --level >= 0);
 
     if (builtIn)
@@ -135,6 +202,7 @@ TSymbol *TSymbolTable::findGlobal(const TString &name) const
 
 TSymbol *TSymbolTable::findBuiltIn(const TString &name, int shaderVersion) const
 {
+    size_t hash = TSymbolTableLevel::HashName(name);
     for (int level = LAST_BUILTIN_LEVEL; level >= 0; level--)
     {
         if (level == ESSL3_1_BUILTINS && shaderVersion != 310)
@@ -144,7 +212,7 @@ TSymbol *TSymbolTable::findBuiltIn(const TString &name, int shaderVersion) const
         if (level == ESSL1_BUILTINS && shaderVersion != 100)
             level--;
 
-        TSymbol *symbol = table[level]->find(name);
+        TSymbol *symbol = table[level]->find(name, hash);
 
         if (symbol)
             return symbol;
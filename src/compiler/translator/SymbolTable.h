@@ -32,7 +32,9 @@
 
 #include <array>
 #include <assert.h>
+#include <atomic>
 #include <set>
+#include <vector>
 
 #include "common/angleutils.h"
 #include "compiler/translator/InfoSink.h"
@@ -215,23 +217,26 @@ class TInterfaceBlockName : public TSymbol
     virtual ~TInterfaceBlockName() {}
 };
 
+// A scope of the symbol table. Symbols are kept in an open-addressed hash table, with the hash of
+// each name stored next to it, so that a lookup hashes the name once for all the levels it
+// searches and only compares strings whose hashes match.
 class TSymbolTableLevel
 {
   public:
-    typedef TMap<TString, TSymbol *> tLevel;
-    typedef tLevel::const_iterator const_iterator;
-    typedef const tLevel::value_type tLevelPair;
-    typedef std::pair<tLevel::iterator, bool> tInsertResult;
-
-    TSymbolTableLevel() : mGlobalInvariant(false) {}
+    TSymbolTableLevel() : mSymbolCount(0), mGlobalInvariant(false) {}
     ~TSymbolTableLevel();
 
+    static size_t HashName(const TString &name);
+
     bool insert(TSymbol *symbol);
 
     // Insert a function using its unmangled name as the key.
     bool insertUnmangled(TFunction *function);
 
-    TSymbol *find(const TString &name) const;
+    TSymbol *find(const TString &name) const { return find(name, HashName(name)); }
+    TSymbol *find(const TString &name, size_t hash) const;
+
+    size_t size() const { return mSymbolCount; }
 
     void addInvariantVarying(const std::string &name) { mInvariantVaryings.insert(name); }
 
@@ -253,7 +258,19 @@ class TSymbolTableLevel
     }
 
   protected:
-    tLevel level;
+    struct Entry
+    {
+        size_t hash;
+        // Points into the symbol, which keeps its names for as long as it's in the table.
+        const TString *name;
+        TSymbol *symbol;
+    };
+
+    bool insert(const TString &name, TSymbol *symbol);
+    void grow();
+
+    std::vector<Entry> mEntries;  // Size is zero or a power of two. Empty entries have no symbol.
+    size_t mSymbolCount;
     std::set<std::string> mInvariantVaryings;
     bool mGlobalInvariant;
 
@@ -465,6 +482,12 @@ class TSymbolTable : angle::NonCopyable
 
     static int nextUniqueId() { return ++uniqueIdCounter; }
 
+    // Returns the number of symbols declared at |level|, or 0 if that level isn't pushed.
+    size_t getSymbolCount(ESymbolLevel level) const
+    {
+        return level <= currentLevel() ? table[level]->size() : 0;
+    }
+
     // Checks whether there is a built-in accessible by a shader with the specified version.
     bool hasUnmangledBuiltInForShaderVersion(const char *name, int shaderVersion);
 
@@ -481,7 +504,8 @@ class TSymbolTable : angle::NonCopyable
     typedef TMap<TBasicType, TPrecision> PrecisionStackLevel;
     std::vector<PrecisionStackLevel *> precisionStack;
 
-    static int uniqueIdCounter;
+    // Shared by the compilers on all threads.
+    static std::atomic<int> uniqueIdCounter;
 };
 
 }  // namespace sh
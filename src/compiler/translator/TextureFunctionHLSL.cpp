@@ -19,6 +19,76 @@ namespace sh
 namespace
 {
 
+typedef TextureFunctionHLSL::TextureFunction TextureFunction;
+
+struct ESSLTextureFunction
+{
+    const char *name;
+    TextureFunction::Method method;
+    bool proj;
+    bool offset;
+};
+
+// The ESSL texture functions, sorted by name so that a call can be looked up with a binary
+// search. IMPLICIT lookups may still turn into BIAS, LOD0 or LOD0BIAS depending on the call.
+constexpr ESSLTextureFunction kESSLTextureFunctions[] = {
+    {"texelFetch", TextureFunction::FETCH, false, false},
+    {"texelFetchOffset", TextureFunction::FETCH, false, true},
+    {"texture", TextureFunction::IMPLICIT, false, false},
+    {"texture2D", TextureFunction::IMPLICIT, false, false},
+    {"texture2DGradEXT", TextureFunction::GRAD, false, false},
+    {"texture2DLod", TextureFunction::LOD, false, false},
+    {"texture2DLodEXT", TextureFunction::LOD, false, false},
+    {"texture2DProj", TextureFunction::IMPLICIT, true, false},
+    {"texture2DProjGradEXT", TextureFunction::GRAD, true, false},
+    {"texture2DProjLod", TextureFunction::LOD, true, false},
+    {"texture2DProjLodEXT", TextureFunction::LOD, true, false},
+    {"textureCube", TextureFunction::IMPLICIT, false, false},
+    {"textureCubeGradEXT", TextureFunction::GRAD, true, false},
+    {"textureCubeLod", TextureFunction::LOD, false, false},
+    {"textureCubeLodEXT", TextureFunction::LOD, false, false},
+    {"textureGrad", TextureFunction::GRAD, false, false},
+    {"textureGradOffset", TextureFunction::GRAD, false, true},
+    {"textureLod", TextureFunction::LOD, false, false},
+    {"textureLodOffset", TextureFunction::LOD, false, true},
+    {"textureOffset", TextureFunction::IMPLICIT, false, true},
+    {"textureProj", TextureFunction::IMPLICIT, true, false},
+    {"textureProjGrad", TextureFunction::GRAD, true, false},
+    {"textureProjGradOffset", TextureFunction::GRAD, true, true},
+    {"textureProjLod", TextureFunction::LOD, true, false},
+    {"textureProjLodOffset", TextureFunction::LOD, true, true},
+    {"textureProjOffset", TextureFunction::IMPLICIT, true, true},
+    {"textureSize", TextureFunction::SIZE, false, false},
+};
+
+const ESSLTextureFunction *FindESSLTextureFunction(const TString &name)
+{
+    const ESSLTextureFunction *end = kESSLTextureFunctions + ArraySize(kESSLTextureFunctions);
+    const ESSLTextureFunction *function =
+        std::lower_bound(kESSLTextureFunctions, end, name,
+                         [](const ESSLTextureFunction &entry, const TString &value) {
+                             return value.compare(entry.name) > 0;
+                         });
+    if (function == end || name != function->name)
+    {
+        return nullptr;
+    }
+    return function;
+}
+
+// Name suffixes of the implementations of each method. The methods that have an extra parameter
+// don't need a suffix to make the signature unique.
+constexpr const char *kMethodSuffixes[] = {
+    "",       // IMPLICIT
+    "",       // BIAS
+    "Lod",    // LOD
+    "Lod0",   // LOD0
+    "Lod0",   // LOD0BIAS
+    "Size",   // SIZE
+    "Fetch",  // FETCH
+    "Grad",   // GRAD
+};
+
 void OutputIntTexCoordWrap(TInfoSinkBase &out,
                            const char *wrapMode,
                            const char *size,
@@ -1002,33 +1072,8 @@ TString TextureFunctionHLSL::TextureFunction::name() const
         name += "Offset";
     }
 
-    switch (method)
-    {
-        case IMPLICIT:
-            break;
-        case BIAS:
-            break;  // Extra parameter makes the signature unique
-        case LOD:
-            name += "Lod";
-            break;
-        case LOD0:
-            name += "Lod0";
-            break;
-        case LOD0BIAS:
-            name += "Lod0";
-            break;  // Extra parameter makes the signature unique
-        case SIZE:
-            name += "Size";
-            break;
-        case FETCH:
-            name += "Fetch";
-            break;
-        case GRAD:
-            name += "Grad";
-            break;
-        default:
-            UNREACHABLE();
-    }
+    ASSERT(static_cast<size_t>(method) < ArraySize(kMethodSuffixes));
+    name += kMethodSuffixes[method];
 
     return name;
 }
@@ -1112,81 +1157,12 @@ TString TextureFunctionHLSL::useTextureFunction(const TString &name,
     textureFunction.proj    = false;
     textureFunction.offset  = false;
 
-    if (name == "texture2D" || name == "textureCube" || name == "texture")
-    {
-        textureFunction.method = TextureFunction::IMPLICIT;
-    }
-    else if (name == "texture2DProj" || name == "textureProj")
-    {
-        textureFunction.method = TextureFunction::IMPLICIT;
-        textureFunction.proj   = true;
-    }
-    else if (name == "texture2DLod" || name == "textureCubeLod" || name == "textureLod" ||
-             name == "texture2DLodEXT" || name == "textureCubeLodEXT")
-    {
-        textureFunction.method = TextureFunction::LOD;
-    }
-    else if (name == "texture2DProjLod" || name == "textureProjLod" ||
-             name == "texture2DProjLodEXT")
-    {
-        textureFunction.method = TextureFunction::LOD;
-        textureFunction.proj   = true;
-    }
-    else if (name == "textureSize")
-    {
-        textureFunction.method = TextureFunction::SIZE;
-    }
-    else if (name == "textureOffset")
-    {
-        textureFunction.method = TextureFunction::IMPLICIT;
-        textureFunction.offset = true;
-    }
-    else if (name == "textureProjOffset")
-    {
-        textureFunction.method = TextureFunction::IMPLICIT;
-        textureFunction.offset = true;
-        textureFunction.proj   = true;
-    }
-    else if (name == "textureLodOffset")
-    {
-        textureFunction.method = TextureFunction::LOD;
-        textureFunction.offset = true;
-    }
-    else if (name == "textureProjLodOffset")
-    {
-        textureFunction.method = TextureFunction::LOD;
-        textureFunction.proj   = true;
-        textureFunction.offset = true;
-    }
-    else if (name == "texelFetch")
-    {
-        textureFunction.method = TextureFunction::FETCH;
-    }
-    else if (name == "texelFetchOffset")
-    {
-        textureFunction.method = TextureFunction::FETCH;
-        textureFunction.offset = true;
-    }
-    else if (name == "textureGrad" || name == "texture2DGradEXT")
-    {
-        textureFunction.method = TextureFunction::GRAD;
-    }
-    else if (name == "textureGradOffset")
-    {
-        textureFunction.method = TextureFunction::GRAD;
-        textureFunction.offset = true;
-    }
-    else if (name == "textureProjGrad" || name == "texture2DProjGradEXT" ||
-             name == "textureCubeGradEXT")
-    {
-        textureFunction.method = TextureFunction::GRAD;
-        textureFunction.proj   = true;
-    }
-    else if (name == "textureProjGradOffset")
+    const ESSLTextureFunction *esslFunction = FindESSLTextureFunction(name);
+    if (esslFunction != nullptr)
     {
-        textureFunction.method = TextureFunction::GRAD;
-        textureFunction.proj   = true;
-        textureFunction.offset = true;
+        textureFunction.method = esslFunction->method;
+        textureFunction.proj   = esslFunction->proj;
+        textureFunction.offset = esslFunction->offset;
     }
     else
         UNREACHABLE();
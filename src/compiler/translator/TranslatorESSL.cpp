@@ -8,6 +8,7 @@
 
 #include "compiler/translator/BuiltInFunctionEmulatorGLSL.h"
 #include "compiler/translator/EmulatePrecision.h"
+#include "compiler/translator/MinifyOutput.h"
 #include "compiler/translator/RecordConstantPrecision.h"
 #include "compiler/translator/OutputESSL.h"
 #include "angle_gl.h"
@@ -90,11 +91,21 @@ void TranslatorESSL::translate(TIntermNode *root, ShCompileOptions compileOption
              << ", local_size_z=" << localSize[2] << ") in;\n";
     }
 
+    if (compileOptions & SH_MINIFY_OUTPUT)
+    {
+        MinifyNames(root, &getMinifiedNameMap());
+    }
+
     // Write translated shader.
     TOutputESSL outputESSL(sink, getArrayIndexClampingStrategy(), getHashFunction(), getNameMap(),
                            getSymbolTable(), getShaderType(), shaderVer, precisionEmulation,
-                           compileOptions);
+                           compileOptions, getMinifiedNameMap());
     root->traverse(&outputESSL);
+
+    if (compileOptions & SH_MINIFY_OUTPUT)
+    {
+        MinifyWhitespace(&sink);
+    }
 }
 
 bool TranslatorESSL::shouldFlattenPragmaStdglInvariantAll()
@@ -10,6 +10,7 @@
 #include "compiler/translator/BuiltInFunctionEmulatorGLSL.h"
 #include "compiler/translator/EmulatePrecision.h"
 #include "compiler/translator/ExtensionGLSL.h"
+#include "compiler/translator/MinifyOutput.h"
 #include "compiler/translator/OutputGLSL.h"
 #include "compiler/translator/RewriteTexelFetchOffset.h"
 #include "compiler/translator/RewriteUnaryMinusOperatorFloat.h"
@@ -139,17 +140,18 @@ void TranslatorGLSL::translate(TIntermNode *root, ShCompileOptions compileOption
         bool hasGLSecondaryFragColor = false;
         bool hasGLSecondaryFragData  = false;
 
-        for (const auto &outputVar : outputVariables)
+        const ShaderReflection &reflection = getReflection();
+        for (const auto &outputVar : reflection.outputVariables)
         {
             if (declareGLFragmentOutputs)
             {
-                if (outputVar.name == "gl_FragColor")
+                if (reflection.stringEquals(outputVar.name, "gl_FragColor"))
                 {
                     ASSERT(!hasGLFragColor);
                     hasGLFragColor = true;
                     continue;
                 }
-                else if (outputVar.name == "gl_FragData")
+                else if (reflection.stringEquals(outputVar.name, "gl_FragData"))
                 {
                     ASSERT(!hasGLFragData);
                     hasGLFragData = true;
@@ -158,13 +160,13 @@ void TranslatorGLSL::translate(TIntermNode *root, ShCompileOptions compileOption
             }
             if (mayHaveESSL1SecondaryOutputs)
             {
-                if (outputVar.name == "gl_SecondaryFragColorEXT")
+                if (reflection.stringEquals(outputVar.name, "gl_SecondaryFragColorEXT"))
                 {
                     ASSERT(!hasGLSecondaryFragColor);
                     hasGLSecondaryFragColor = true;
                     continue;
                 }
-                else if (outputVar.name == "gl_SecondaryFragDataEXT")
+                else if (reflection.stringEquals(outputVar.name, "gl_SecondaryFragDataEXT"))
                 {
                     ASSERT(!hasGLSecondaryFragData);
                     hasGLSecondaryFragData = true;
@@ -200,11 +202,21 @@ void TranslatorGLSL::translate(TIntermNode *root, ShCompileOptions compileOption
              << ", local_size_z=" << localSize[2] << ") in;\n";
     }
 
+    if (compileOptions & SH_MINIFY_OUTPUT)
+    {
+        MinifyNames(root, &getMinifiedNameMap());
+    }
+
     // Write translated shader.
     TOutputGLSL outputGLSL(sink, getArrayIndexClampingStrategy(), getHashFunction(), getNameMap(),
                            getSymbolTable(), getShaderType(), getShaderVersion(), getOutputType(),
-                           compileOptions);
+                           compileOptions, getMinifiedNameMap());
     root->traverse(&outputGLSL);
+
+    if (compileOptions & SH_MINIFY_OUTPUT)
+    {
+        MinifyWhitespace(&sink);
+    }
 }
 
 bool TranslatorGLSL::shouldFlattenPragmaStdglInvariantAll()
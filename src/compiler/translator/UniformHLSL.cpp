@@ -218,10 +218,10 @@ void UniformHLSL::outputHLSL4_0_FL9_3Sampler(TInfoSinkBase &out,
                                              const unsigned int registerIndex)
 {
     out << "uniform " << SamplerString(type.getBasicType()) << " sampler_"
-        << DecorateUniform(name, type) << ArrayString(type) << " : register(s" << str(registerIndex)
+        << DecorateUniform(name, type) << ArrayString(type) << " : register(s" << registerIndex
         << ");\n";
     out << "uniform " << TextureString(type.getBasicType()) << " texture_"
-        << DecorateUniform(name, type) << ArrayString(type) << " : register(t" << str(registerIndex)
+        << DecorateUniform(name, type) << ArrayString(type) << " : register(t" << registerIndex
         << ");\n";
 }
 
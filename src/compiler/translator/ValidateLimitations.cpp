@@ -6,8 +6,7 @@
 
 #include "compiler/translator/ValidateLimitations.h"
 #include "compiler/translator/InfoSink.h"
-#include "compiler/translator/InitializeParseContext.h"
-#include "compiler/translator/ParseContext.h"
+#include "compiler/translator/SymbolTable.h"
 #include "angle_gl.h"
 
 namespace sh
@@ -66,9 +65,14 @@ class ValidateConstIndexExpr : public TIntermTraverser
 
 }  // namespace anonymous
 
-ValidateLimitations::ValidateLimitations(sh::GLenum shaderType, TInfoSinkBase *sink)
+ValidateLimitations::ValidateLimitations(sh::GLenum shaderType,
+                                         const TSymbolTable *symbolTable,
+                                         int shaderVersion,
+                                         TInfoSinkBase *sink)
     : TIntermTraverser(true, false, false),
       mShaderType(shaderType),
+      mSymbolTable(symbolTable),
+      mShaderVersion(shaderVersion),
       mSink(sink),
       mNumErrors(0),
       mValidateIndexing(true),
@@ -79,8 +83,8 @@ ValidateLimitations::ValidateLimitations(sh::GLenum shaderType, TInfoSinkBase *s
 // static
 bool ValidateLimitations::IsLimitedForLoop(TIntermLoop *loop)
 {
-    // The shader type doesn't matter in this case.
-    ValidateLimitations validate(GL_FRAGMENT_SHADER, nullptr);
+    // The shader type and version don't matter in this case.
+    ValidateLimitations validate(GL_FRAGMENT_SHADER, nullptr, 100, nullptr);
     validate.mValidateIndexing   = false;
     validate.mValidateInnerLoops = false;
     if (!validate.validateLoopType(loop))
@@ -407,7 +411,7 @@ bool ValidateLimitations::validateFunctionCall(TIntermAggregate *node)
     ASSERT(node->getOp() == EOpFunctionCall);
 
     // If not within loop body, there is nothing to check.
-    if (!withinLoopBody())
+    if (!withinLoopBody() || mSymbolTable == nullptr)
         return true;
 
     // List of param indices for which loop indices are used as argument.
@@ -425,10 +429,8 @@ bool ValidateLimitations::validateFunctionCall(TIntermAggregate *node)
     if (pIndex.empty())
         return true;
 
-    bool valid                = true;
-    TSymbolTable &symbolTable = GetGlobalParseContext()->symbolTable;
-    TSymbol *symbol           = symbolTable.find(node->getFunctionSymbolInfo()->getName(),
-                                       GetGlobalParseContext()->getShaderVersion());
+    bool valid      = true;
+    TSymbol *symbol = mSymbolTable->find(node->getFunctionSymbolInfo()->getName(), mShaderVersion);
     ASSERT(symbol && symbol->isFunction());
     TFunction *function = static_cast<TFunction *>(symbol);
     for (ParamIndex::const_iterator i = pIndex.begin(); i != pIndex.end(); ++i)
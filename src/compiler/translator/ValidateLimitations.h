@@ -13,13 +13,19 @@ namespace sh
 {
 
 class TInfoSinkBase;
+class TSymbolTable;
 
 // Traverses intermediate tree to ensure that the shader does not exceed the
 // minimum functionality mandated in GLSL 1.0 spec, Appendix A.
 class ValidateLimitations : public TIntermTraverser
 {
   public:
-    ValidateLimitations(sh::GLenum shaderType, TInfoSinkBase *sink);
+    // |symbolTable| is used to look up the parameters of called functions. Without it, loop
+    // indices passed to functions aren't checked.
+    ValidateLimitations(sh::GLenum shaderType,
+                        const TSymbolTable *symbolTable,
+                        int shaderVersion,
+                        TInfoSinkBase *sink);
 
     int numErrors() const { return mNumErrors; }
 
@@ -55,6 +61,8 @@ class ValidateLimitations : public TIntermTraverser
     bool validateIndexing(TIntermBinary *node);
 
     sh::GLenum mShaderType;
+    const TSymbolTable *mSymbolTable;
+    int mShaderVersion;
     TInfoSinkBase *mSink;
     int mNumErrors;
     std::vector<int> mLoopSymbolIds;
@@ -4,6 +4,9 @@
 // found in the LICENSE file.
 //
 
+#include <string.h>
+#include <utility>
+
 #include "angle_gl.h"
 #include "compiler/translator/SymbolTable.h"
 #include "compiler/translator/VariableInfo.h"
@@ -49,35 +52,14 @@ void ExpandUserDefinedVariable(const ShaderVariable &variable,
                        markStaticUse, expanded);
     }
 }
-
-template <class VarT>
-VarT *FindVariable(const TString &name, std::vector<VarT> *infoList)
-{
-    // TODO(zmo): optimize this function.
-    for (size_t ii = 0; ii < infoList->size(); ++ii)
-    {
-        if ((*infoList)[ii].name.c_str() == name)
-            return &((*infoList)[ii]);
-    }
-
-    return NULL;
-}
 }
 
-CollectVariables::CollectVariables(std::vector<sh::Attribute> *attribs,
-                                   std::vector<sh::OutputVariable> *outputVariables,
-                                   std::vector<sh::Uniform> *uniforms,
-                                   std::vector<sh::Varying> *varyings,
-                                   std::vector<sh::InterfaceBlock> *interfaceBlocks,
+CollectVariables::CollectVariables(ShaderReflection *reflection,
                                    ShHashFunction64 hashFunction,
                                    const TSymbolTable &symbolTable,
                                    const TExtensionBehavior &extensionBehavior)
     : TIntermTraverser(true, false, false),
-      mAttribs(attribs),
-      mOutputVariables(outputVariables),
-      mUniforms(uniforms),
-      mVaryings(varyings),
-      mInterfaceBlocks(interfaceBlocks),
+      mReflection(reflection),
       mDepthRangeAdded(false),
       mPointCoordAdded(false),
       mFrontFacingAdded(false),
@@ -99,6 +81,91 @@ CollectVariables::CollectVariables(std::vector<sh::Attribute> *attribs,
 {
 }
 
+ShaderReflection::Variable *CollectVariables::findVariable(
+    const TString &name,
+    std::vector<ShaderReflection::Variable> *records)
+{
+    for (ShaderReflection::Variable &record : *records)
+    {
+        if (mReflection->stringEquals(record.name, name.c_str(), name.length()))
+            return &record;
+    }
+
+    return nullptr;
+}
+
+ShaderReflection::Block *CollectVariables::findInterfaceBlock(const TString &name)
+{
+    for (ShaderReflection::Block &block : mReflection->interfaceBlocks)
+    {
+        if (mReflection->stringEquals(block.name, name.c_str(), name.length()))
+            return &block;
+    }
+
+    return nullptr;
+}
+
+ShaderReflection::StringRange CollectVariables::addMappedName(
+    const TString &name,
+    ShaderReflection::StringRange nameRange)
+{
+    TString mappedName = TIntermTraverser::hash(name, mHashFunction);
+    // Names that aren't hashed share the pool entry of the name.
+    if (mappedName == name)
+    {
+        return nameRange;
+    }
+    return mReflection->addString(mappedName.c_str(), mappedName.length());
+}
+
+ShaderReflection::Variable CollectVariables::recordVariable(const TType &type,
+                                                            const TString &name)
+{
+    ShaderReflection::Variable record;
+    record.name       = mReflection->addString(name.c_str(), name.length());
+    record.mappedName = addMappedName(name, record.name);
+    record.arraySize  = type.getArraySize();
+
+    const TStructure *structure = type.getStruct();
+    if (!structure)
+    {
+        record.type      = GLVariableType(type);
+        record.precision = GLVariablePrecision(type);
+        return record;
+    }
+
+    // Note: this enum value is not exposed outside ANGLE
+    record.type       = GL_STRUCT_ANGLEX;
+    record.structName = mReflection->addString(structure->name().c_str(),
+                                               structure->name().length());
+
+    // The fields take consecutive records, and the records of their own fields follow them.
+    const TFieldList &fields = structure->fields();
+    record.fieldRange        = mReflection->addFields(fields.size());
+    for (size_t fieldIndex = 0; fieldIndex < fields.size(); ++fieldIndex)
+    {
+        const TField *field = fields[fieldIndex];
+        ShaderReflection::Variable fieldRecord = recordVariable(*field->type(), field->name());
+        mReflection->getField(record.fieldRange, fieldIndex) = fieldRecord;
+    }
+    return record;
+}
+
+ShaderReflection::Variable CollectVariables::recordBuiltIn(const char *name,
+                                                           GLenum type,
+                                                           GLenum precision,
+                                                           unsigned int arraySize)
+{
+    ShaderReflection::Variable record;
+    record.name       = mReflection->addString(name, strlen(name));
+    record.mappedName = record.name;
+    record.type       = type;
+    record.precision  = precision;
+    record.arraySize  = arraySize;
+    record.staticUse  = true;
+    return record;
+}
+
 // We want to check whether a uniform/varying is statically used
 // because we only count the used ones in packing computing.
 // Also, gl_FragCoord, gl_PointCoord, and gl_FrontFacing count
@@ -107,12 +174,12 @@ CollectVariables::CollectVariables(std::vector<sh::Attribute> *attribs,
 void CollectVariables::visitSymbol(TIntermSymbol *symbol)
 {
     ASSERT(symbol != NULL);
-    ShaderVariable *var       = NULL;
-    const TString &symbolName = symbol->getSymbol();
+    ShaderReflection::Variable *var = nullptr;
+    const TString &symbolName       = symbol->getSymbol();
 
     if (IsVarying(symbol->getQualifier()))
     {
-        var = FindVariable(symbolName, mVaryings);
+        var = findVariable(symbolName, &mReflection->varyings);
     }
     else if (symbol->getType().getBasicType() == EbtInterfaceBlock)
     {
@@ -124,47 +191,19 @@ void CollectVariables::visitSymbol(TIntermSymbol *symbol)
 
         if (!mDepthRangeAdded)
         {
-            Uniform info;
-            const char kName[] = "gl_DepthRange";
-            info.name          = kName;
-            info.mappedName    = kName;
-            info.type          = GL_STRUCT_ANGLEX;
-            info.arraySize     = 0;
-            info.precision     = GL_NONE;
-            info.staticUse     = true;
-
-            ShaderVariable nearInfo;
-            const char kNearName[] = "near";
-            nearInfo.name          = kNearName;
-            nearInfo.mappedName    = kNearName;
-            nearInfo.type          = GL_FLOAT;
-            nearInfo.arraySize     = 0;
-            nearInfo.precision     = GL_HIGH_FLOAT;
-            nearInfo.staticUse     = true;
-
-            ShaderVariable farInfo;
-            const char kFarName[] = "far";
-            farInfo.name          = kFarName;
-            farInfo.mappedName    = kFarName;
-            farInfo.type          = GL_FLOAT;
-            farInfo.arraySize     = 0;
-            farInfo.precision     = GL_HIGH_FLOAT;
-            farInfo.staticUse     = true;
-
-            ShaderVariable diffInfo;
-            const char kDiffName[] = "diff";
-            diffInfo.name          = kDiffName;
-            diffInfo.mappedName    = kDiffName;
-            diffInfo.type          = GL_FLOAT;
-            diffInfo.arraySize     = 0;
-            diffInfo.precision     = GL_HIGH_FLOAT;
-            diffInfo.staticUse     = true;
-
-            info.fields.push_back(nearInfo);
-            info.fields.push_back(farInfo);
-            info.fields.push_back(diffInfo);
-
-            mUniforms->push_back(info);
+            ShaderReflection::Variable info =
+                recordBuiltIn("gl_DepthRange", GL_STRUCT_ANGLEX, GL_NONE, 0);
+
+            const char *const kFieldNames[] = {"near", "far", "diff"};
+            info.fieldRange = mReflection->addFields(ArraySize(kFieldNames));
+            for (size_t fieldIndex = 0; fieldIndex < ArraySize(kFieldNames); ++fieldIndex)
+            {
+                ShaderReflection::Variable fieldInfo =
+                    recordBuiltIn(kFieldNames[fieldIndex], GL_FLOAT, GL_HIGH_FLOAT, 0);
+                mReflection->getField(info.fieldRange, fieldIndex) = fieldInfo;
+            }
+
+            mReflection->uniforms.push_back(info);
             mDepthRangeAdded = true;
         }
     }
@@ -174,27 +213,38 @@ void CollectVariables::visitSymbol(TIntermSymbol *symbol)
         {
             case EvqAttribute:
             case EvqVertexIn:
-                var = FindVariable(symbolName, mAttribs);
+                var = findVariable(symbolName, &mReflection->attributes);
                 break;
             case EvqFragmentOut:
-                var = FindVariable(symbolName, mOutputVariables);
+                var = findVariable(symbolName, &mReflection->outputVariables);
                 break;
             case EvqUniform:
             {
                 const TInterfaceBlock *interfaceBlock = symbol->getType().getInterfaceBlock();
                 if (interfaceBlock)
                 {
-                    InterfaceBlock *namedBlock =
-                        FindVariable(interfaceBlock->name(), mInterfaceBlocks);
+                    ShaderReflection::Block *namedBlock =
+                        findInterfaceBlock(interfaceBlock->name());
                     ASSERT(namedBlock);
-                    var = FindVariable(symbolName, &namedBlock->fields);
+                    for (size_t fieldIndex = 0; fieldIndex < namedBlock->fieldRange.count;
+                         ++fieldIndex)
+                    {
+                        ShaderReflection::Variable &field =
+                            mReflection->getField(namedBlock->fieldRange, fieldIndex);
+                        if (mReflection->stringEquals(field.name, symbolName.c_str(),
+                                                      symbolName.length()))
+                        {
+                            var = &field;
+                            break;
+                        }
+                    }
 
                     // Set static use on the parent interface block here
                     namedBlock->staticUse = true;
                 }
                 else
                 {
-                    var = FindVariable(symbolName, mUniforms);
+                    var = findVariable(symbolName, &mReflection->uniforms);
                 }
 
                 // It's an internal error to reference an undefined user uniform
@@ -204,237 +254,162 @@ void CollectVariables::visitSymbol(TIntermSymbol *symbol)
             case EvqFragCoord:
                 if (!mFragCoordAdded)
                 {
-                    Varying info;
                     const char kName[] = "gl_FragCoord";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_FLOAT_VEC4;
-                    info.arraySize     = 0;
-                    info.precision     = GL_MEDIUM_FLOAT;  // Defined by spec.
-                    info.staticUse     = true;
-                    info.isInvariant   = mSymbolTable.isVaryingInvariant(kName);
-                    mVaryings->push_back(info);
+                    // Precision defined by spec.
+                    ShaderReflection::Variable info =
+                        recordBuiltIn(kName, GL_FLOAT_VEC4, GL_MEDIUM_FLOAT, 0);
+                    info.isInvariant = mSymbolTable.isVaryingInvariant(kName);
+                    mReflection->varyings.push_back(info);
                     mFragCoordAdded = true;
                 }
                 return;
             case EvqFrontFacing:
                 if (!mFrontFacingAdded)
                 {
-                    Varying info;
                     const char kName[] = "gl_FrontFacing";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_BOOL;
-                    info.arraySize     = 0;
-                    info.precision     = GL_NONE;
-                    info.staticUse     = true;
-                    info.isInvariant   = mSymbolTable.isVaryingInvariant(kName);
-                    mVaryings->push_back(info);
+                    ShaderReflection::Variable info = recordBuiltIn(kName, GL_BOOL, GL_NONE, 0);
+                    info.isInvariant = mSymbolTable.isVaryingInvariant(kName);
+                    mReflection->varyings.push_back(info);
                     mFrontFacingAdded = true;
                 }
                 return;
             case EvqPointCoord:
                 if (!mPointCoordAdded)
                 {
-                    Varying info;
                     const char kName[] = "gl_PointCoord";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_FLOAT_VEC2;
-                    info.arraySize     = 0;
-                    info.precision     = GL_MEDIUM_FLOAT;  // Defined by spec.
-                    info.staticUse     = true;
-                    info.isInvariant   = mSymbolTable.isVaryingInvariant(kName);
-                    mVaryings->push_back(info);
+                    // Precision defined by spec.
+                    ShaderReflection::Variable info =
+                        recordBuiltIn(kName, GL_FLOAT_VEC2, GL_MEDIUM_FLOAT, 0);
+                    info.isInvariant = mSymbolTable.isVaryingInvariant(kName);
+                    mReflection->varyings.push_back(info);
                     mPointCoordAdded = true;
                 }
                 return;
             case EvqInstanceID:
                 if (!mInstanceIDAdded)
                 {
-                    Attribute info;
-                    const char kName[] = "gl_InstanceID";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_INT;
-                    info.arraySize     = 0;
-                    info.precision     = GL_HIGH_INT;  // Defined by spec.
-                    info.staticUse     = true;
-                    info.location      = -1;
-                    mAttribs->push_back(info);
+                    // Precision defined by spec.
+                    mReflection->attributes.push_back(
+                        recordBuiltIn("gl_InstanceID", GL_INT, GL_HIGH_INT, 0));
                     mInstanceIDAdded = true;
                 }
                 return;
             case EvqVertexID:
                 if (!mVertexIDAdded)
                 {
-                    Attribute info;
-                    const char kName[] = "gl_VertexID";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_INT;
-                    info.arraySize     = 0;
-                    info.precision     = GL_HIGH_INT;  // Defined by spec.
-                    info.staticUse     = true;
-                    info.location      = -1;
-                    mAttribs->push_back(info);
+                    // Precision defined by spec.
+                    mReflection->attributes.push_back(
+                        recordBuiltIn("gl_VertexID", GL_INT, GL_HIGH_INT, 0));
                     mVertexIDAdded = true;
                 }
                 return;
             case EvqPosition:
                 if (!mPositionAdded)
                 {
-                    Varying info;
                     const char kName[] = "gl_Position";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_FLOAT_VEC4;
-                    info.arraySize     = 0;
-                    info.precision     = GL_HIGH_FLOAT;  // Defined by spec.
-                    info.staticUse     = true;
-                    info.isInvariant   = mSymbolTable.isVaryingInvariant(kName);
-                    mVaryings->push_back(info);
+                    // Precision defined by spec.
+                    ShaderReflection::Variable info =
+                        recordBuiltIn(kName, GL_FLOAT_VEC4, GL_HIGH_FLOAT, 0);
+                    info.isInvariant = mSymbolTable.isVaryingInvariant(kName);
+                    mReflection->varyings.push_back(info);
                     mPositionAdded = true;
                 }
                 return;
             case EvqPointSize:
                 if (!mPointSizeAdded)
                 {
-                    Varying info;
                     const char kName[] = "gl_PointSize";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_FLOAT;
-                    info.arraySize     = 0;
-                    info.precision     = GL_MEDIUM_FLOAT;  // Defined by spec.
-                    info.staticUse     = true;
-                    info.isInvariant   = mSymbolTable.isVaryingInvariant(kName);
-                    mVaryings->push_back(info);
+                    // Precision defined by spec.
+                    ShaderReflection::Variable info =
+                        recordBuiltIn(kName, GL_FLOAT, GL_MEDIUM_FLOAT, 0);
+                    info.isInvariant = mSymbolTable.isVaryingInvariant(kName);
+                    mReflection->varyings.push_back(info);
                     mPointSizeAdded = true;
                 }
                 return;
             case EvqLastFragData:
                 if (!mLastFragDataAdded)
                 {
-                    Varying info;
-                    const char kName[] = "gl_LastFragData";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_FLOAT_VEC4;
-                    info.arraySize     = static_cast<const TVariable *>(
-                                         mSymbolTable.findBuiltIn("gl_MaxDrawBuffers", 100))
-                                         ->getConstPointer()
-                                         ->getIConst();
-                    info.precision   = GL_MEDIUM_FLOAT;  // Defined by spec.
-                    info.staticUse   = true;
+                    const char kName[]          = "gl_LastFragData";
+                    const unsigned int arraySize = static_cast<const TVariable *>(
+                                                       mSymbolTable.findBuiltIn("gl_MaxDrawBuffers",
+                                                                                100))
+                                                       ->getConstPointer()
+                                                       ->getIConst();
+                    // Precision defined by spec.
+                    ShaderReflection::Variable info =
+                        recordBuiltIn(kName, GL_FLOAT_VEC4, GL_MEDIUM_FLOAT, arraySize);
                     info.isInvariant = mSymbolTable.isVaryingInvariant(kName);
-                    mVaryings->push_back(info);
+                    mReflection->varyings.push_back(info);
                     mLastFragDataAdded = true;
                 }
                 return;
             case EvqFragColor:
                 if (!mFragColorAdded)
                 {
-                    OutputVariable info;
-                    const char kName[] = "gl_FragColor";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_FLOAT_VEC4;
-                    info.arraySize     = 0;
-                    info.precision     = GL_MEDIUM_FLOAT;  // Defined by spec.
-                    info.staticUse     = true;
-                    mOutputVariables->push_back(info);
+                    // Precision defined by spec.
+                    mReflection->outputVariables.push_back(
+                        recordBuiltIn("gl_FragColor", GL_FLOAT_VEC4, GL_MEDIUM_FLOAT, 0));
                     mFragColorAdded = true;
                 }
                 return;
             case EvqFragData:
                 if (!mFragDataAdded)
                 {
-                    OutputVariable info;
-                    const char kName[] = "gl_FragData";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_FLOAT_VEC4;
+                    unsigned int arraySize = 1;
                     if (::IsExtensionEnabled(mExtensionBehavior, "GL_EXT_draw_buffers"))
                     {
-                        info.arraySize = static_cast<const TVariable *>(
-                                             mSymbolTable.findBuiltIn("gl_MaxDrawBuffers", 100))
-                                             ->getConstPointer()
-                                             ->getIConst();
-                    }
-                    else
-                    {
-                        info.arraySize = 1;
+                        arraySize = static_cast<const TVariable *>(
+                                        mSymbolTable.findBuiltIn("gl_MaxDrawBuffers", 100))
+                                        ->getConstPointer()
+                                        ->getIConst();
                     }
-                    info.precision = GL_MEDIUM_FLOAT;  // Defined by spec.
-                    info.staticUse = true;
-                    mOutputVariables->push_back(info);
+                    // Precision defined by spec.
+                    mReflection->outputVariables.push_back(
+                        recordBuiltIn("gl_FragData", GL_FLOAT_VEC4, GL_MEDIUM_FLOAT, arraySize));
                     mFragDataAdded = true;
                 }
                 return;
             case EvqFragDepthEXT:
                 if (!mFragDepthEXTAdded)
                 {
-                    OutputVariable info;
-                    const char kName[] = "gl_FragDepthEXT";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_FLOAT;
-                    info.arraySize     = 0;
-                    info.precision =
+                    const GLenum precision =
                         GLVariablePrecision(static_cast<const TVariable *>(
                                                 mSymbolTable.findBuiltIn("gl_FragDepthEXT", 100))
                                                 ->getType());
-                    info.staticUse = true;
-                    mOutputVariables->push_back(info);
+                    mReflection->outputVariables.push_back(
+                        recordBuiltIn("gl_FragDepthEXT", GL_FLOAT, precision, 0));
                     mFragDepthEXTAdded = true;
                 }
                 return;
             case EvqFragDepth:
                 if (!mFragDepthAdded)
                 {
-                    OutputVariable info;
-                    const char kName[] = "gl_FragDepth";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_FLOAT;
-                    info.arraySize     = 0;
-                    info.precision     = GL_HIGH_FLOAT;
-                    info.staticUse     = true;
-                    mOutputVariables->push_back(info);
+                    mReflection->outputVariables.push_back(
+                        recordBuiltIn("gl_FragDepth", GL_FLOAT, GL_HIGH_FLOAT, 0));
                     mFragDepthAdded = true;
                 }
                 return;
             case EvqSecondaryFragColorEXT:
                 if (!mSecondaryFragColorEXTAdded)
                 {
-                    OutputVariable info;
-                    const char kName[] = "gl_SecondaryFragColorEXT";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_FLOAT_VEC4;
-                    info.arraySize     = 0;
-                    info.precision     = GL_MEDIUM_FLOAT;  // Defined by spec.
-                    info.staticUse     = true;
-                    mOutputVariables->push_back(info);
+                    // Precision defined by spec.
+                    mReflection->outputVariables.push_back(recordBuiltIn(
+                        "gl_SecondaryFragColorEXT", GL_FLOAT_VEC4, GL_MEDIUM_FLOAT, 0));
                     mSecondaryFragColorEXTAdded = true;
                 }
                 return;
             case EvqSecondaryFragDataEXT:
                 if (!mSecondaryFragDataEXTAdded)
                 {
-                    OutputVariable info;
-                    const char kName[] = "gl_SecondaryFragDataEXT";
-                    info.name          = kName;
-                    info.mappedName    = kName;
-                    info.type          = GL_FLOAT_VEC4;
-
                     const TVariable *maxDualSourceDrawBuffersVar = static_cast<const TVariable *>(
                         mSymbolTable.findBuiltIn("gl_MaxDualSourceDrawBuffersEXT", 100));
-                    info.arraySize = maxDualSourceDrawBuffersVar->getConstPointer()->getIConst();
-                    info.precision = GL_MEDIUM_FLOAT;  // Defined by spec.
-                    info.staticUse = true;
-                    mOutputVariables->push_back(info);
+                    const unsigned int arraySize =
+                        maxDualSourceDrawBuffersVar->getConstPointer()->getIConst();
+                    // Precision defined by spec.
+                    mReflection->outputVariables.push_back(
+                        recordBuiltIn("gl_SecondaryFragDataEXT", GL_FLOAT_VEC4, GL_MEDIUM_FLOAT,
+                                      arraySize));
                     mSecondaryFragDataEXTAdded = true;
                 }
                 return;
@@ -448,120 +423,75 @@ void CollectVariables::visitSymbol(TIntermSymbol *symbol)
     }
 }
 
-class NameHashingTraverser : public GetVariableTraverser
+void CollectVariables::visitInterfaceBlock(const TIntermSymbol *variable)
 {
-  public:
-    NameHashingTraverser(ShHashFunction64 hashFunction, const TSymbolTable &symbolTable)
-        : GetVariableTraverser(symbolTable), mHashFunction(hashFunction)
-    {
-    }
-
-  private:
-    void visitVariable(ShaderVariable *variable) override
-    {
-        TString stringName   = TString(variable->name.c_str());
-        variable->mappedName = TIntermTraverser::hash(stringName, mHashFunction).c_str();
-    }
-
-    ShHashFunction64 mHashFunction;
-};
-
-// Attributes, which cannot have struct fields, are a special case
-template <>
-void CollectVariables::visitVariable(const TIntermSymbol *variable,
-                                     std::vector<Attribute> *infoList) const
-{
-    ASSERT(variable);
-    const TType &type = variable->getType();
-    ASSERT(!type.getStruct());
-
-    Attribute attribute;
-
-    attribute.type       = GLVariableType(type);
-    attribute.precision  = GLVariablePrecision(type);
-    attribute.name       = variable->getSymbol().c_str();
-    attribute.arraySize  = type.getArraySize();
-    attribute.mappedName = TIntermTraverser::hash(variable->getSymbol(), mHashFunction).c_str();
-    attribute.location   = variable->getType().getLayoutQualifier().location;
-
-    infoList->push_back(attribute);
-}
-
-template <>
-void CollectVariables::visitVariable(const TIntermSymbol *variable,
-                                     std::vector<OutputVariable> *infoList) const
-{
-    ASSERT(variable);
-    const TType &type = variable->getType();
-    ASSERT(!type.getStruct());
-
-    OutputVariable attribute;
-
-    attribute.type       = GLVariableType(type);
-    attribute.precision  = GLVariablePrecision(type);
-    attribute.name       = variable->getSymbol().c_str();
-    attribute.arraySize  = type.getArraySize();
-    attribute.mappedName = TIntermTraverser::hash(variable->getSymbol(), mHashFunction).c_str();
-    attribute.location   = variable->getType().getLayoutQualifier().location;
-
-    infoList->push_back(attribute);
-}
-
-template <>
-void CollectVariables::visitVariable(const TIntermSymbol *variable,
-                                     std::vector<InterfaceBlock> *infoList) const
-{
-    InterfaceBlock interfaceBlock;
     const TInterfaceBlock *blockType = variable->getType().getInterfaceBlock();
     ASSERT(blockType);
 
-    interfaceBlock.name = blockType->name().c_str();
-    interfaceBlock.mappedName =
-        TIntermTraverser::hash(blockType->name().c_str(), mHashFunction).c_str();
-    interfaceBlock.instanceName =
-        (blockType->hasInstanceName() ? blockType->instanceName().c_str() : "");
-    interfaceBlock.arraySize        = variable->getArraySize();
-    interfaceBlock.isRowMajorLayout = (blockType->matrixPacking() == EmpRowMajor);
-    interfaceBlock.layout           = GetBlockLayoutType(blockType->blockStorage());
+    ShaderReflection::Block block;
+    const TString &blockName = blockType->name();
+    block.name       = mReflection->addString(blockName.c_str(), blockName.length());
+    block.mappedName = addMappedName(blockName, block.name);
+    if (blockType->hasInstanceName())
+    {
+        const TString &instanceName = blockType->instanceName();
+        block.instanceName = mReflection->addString(instanceName.c_str(), instanceName.length());
+    }
+    block.arraySize        = variable->getArraySize();
+    block.isRowMajorLayout = (blockType->matrixPacking() == EmpRowMajor);
+    block.layout           = GetBlockLayoutType(blockType->blockStorage());
 
     // Gather field information
-    for (const TField *field : blockType->fields())
+    const TFieldList &fields = blockType->fields();
+    block.fieldRange         = mReflection->addFields(fields.size());
+    for (size_t fieldIndex = 0; fieldIndex < fields.size(); ++fieldIndex)
     {
-        const TType &fieldType = *field->type();
+        const TType &fieldType = *fields[fieldIndex]->type();
 
-        NameHashingTraverser traverser(mHashFunction, mSymbolTable);
-        traverser.traverse(fieldType, field->name(), &interfaceBlock.fields);
-
-        interfaceBlock.fields.back().isRowMajorLayout =
+        ShaderReflection::Variable fieldRecord =
+            recordVariable(fieldType, fields[fieldIndex]->name());
+        fieldRecord.isRowMajorLayout =
             (fieldType.getLayoutQualifier().matrixPacking == EmpRowMajor);
+        mReflection->getField(block.fieldRange, fieldIndex) = fieldRecord;
     }
 
-    infoList->push_back(interfaceBlock);
+    mReflection->interfaceBlocks.push_back(block);
 }
 
-template <typename VarT>
 void CollectVariables::visitVariable(const TIntermSymbol *variable,
-                                     std::vector<VarT> *infoList) const
+                                     std::vector<ShaderReflection::Variable> *records)
 {
-    NameHashingTraverser traverser(mHashFunction, mSymbolTable);
-    traverser.traverse(variable->getType(), variable->getSymbol(), infoList);
-}
+    ASSERT(variable);
+    const TType &type = variable->getType();
 
-template <typename VarT>
-void CollectVariables::visitInfoList(const TIntermSequence &sequence,
-                                     std::vector<VarT> *infoList) const
-{
-    for (size_t seqIndex = 0; seqIndex < sequence.size(); seqIndex++)
+    ShaderReflection::Variable record = recordVariable(type, variable->getSymbol());
+    if (records == &mReflection->attributes || records == &mReflection->outputVariables)
     {
-        const TIntermSymbol *variable = sequence[seqIndex]->getAsSymbolNode();
-        // The only case in which the sequence will not contain a
-        // TIntermSymbol node is initialization. It will contain a
-        // TInterBinary node in that case. Since attributes, uniforms,
-        // and varyings cannot be initialized in a shader, we must have
-        // only TIntermSymbol nodes in the sequence.
-        ASSERT(variable != NULL);
-        visitVariable(variable, infoList);
+        // Attributes and output variables can't have struct fields.
+        ASSERT(!type.getStruct());
+        record.location = type.getLayoutQualifier().location;
+    }
+    else if (records == &mReflection->varyings)
+    {
+        switch (type.getQualifier())
+        {
+            case EvqVaryingIn:
+            case EvqVaryingOut:
+            case EvqVertexOut:
+            case EvqSmoothOut:
+            case EvqFlatOut:
+            case EvqCentroidOut:
+                record.isInvariant =
+                    mSymbolTable.isVaryingInvariant(std::string(variable->getSymbol().c_str())) ||
+                    type.isInvariant();
+                break;
+            default:
+                break;
+        }
+        record.interpolation = GetInterpolationType(type.getQualifier());
     }
+
+    records->push_back(record);
 }
 
 bool CollectVariables::visitDeclaration(Visit, TIntermDeclaration *node)
@@ -572,35 +502,52 @@ bool CollectVariables::visitDeclaration(Visit, TIntermDeclaration *node)
     const TIntermTyped &typedNode = *(sequence.front()->getAsTyped());
     TQualifier qualifier          = typedNode.getQualifier();
 
+    std::vector<ShaderReflection::Variable> *records = nullptr;
     if (typedNode.getBasicType() == EbtInterfaceBlock)
     {
-        visitInfoList(sequence, mInterfaceBlocks);
-        return false;
+        // Interface blocks are recorded separately below.
     }
-    else if (qualifier == EvqAttribute || qualifier == EvqVertexIn || qualifier == EvqFragmentOut ||
-             qualifier == EvqUniform || IsVarying(qualifier))
+    else if (qualifier == EvqAttribute || qualifier == EvqVertexIn)
     {
-        switch (qualifier)
+        records = &mReflection->attributes;
+    }
+    else if (qualifier == EvqFragmentOut)
+    {
+        records = &mReflection->outputVariables;
+    }
+    else if (qualifier == EvqUniform)
+    {
+        records = &mReflection->uniforms;
+    }
+    else if (IsVarying(qualifier))
+    {
+        records = &mReflection->varyings;
+    }
+    else
+    {
+        return true;
+    }
+
+    for (TIntermNode *declarator : sequence)
+    {
+        const TIntermSymbol *variable = declarator->getAsSymbolNode();
+        // The only case in which the sequence will not contain a
+        // TIntermSymbol node is initialization. It will contain a
+        // TInterBinary node in that case. Since attributes, uniforms,
+        // and varyings cannot be initialized in a shader, we must have
+        // only TIntermSymbol nodes in the sequence.
+        ASSERT(variable != NULL);
+        if (records)
         {
-            case EvqAttribute:
-            case EvqVertexIn:
-                visitInfoList(sequence, mAttribs);
-                break;
-            case EvqFragmentOut:
-                visitInfoList(sequence, mOutputVariables);
-                break;
-            case EvqUniform:
-                visitInfoList(sequence, mUniforms);
-                break;
-            default:
-                visitInfoList(sequence, mVaryings);
-                break;
+            visitVariable(variable, records);
+        }
+        else
+        {
+            visitInterfaceBlock(variable);
         }
-
-        return false;
     }
 
-    return true;
+    return false;
 }
 
 bool CollectVariables::visitBinary(Visit, TIntermBinary *binaryNode)
@@ -615,13 +562,12 @@ bool CollectVariables::visitBinary(Visit, TIntermBinary *binaryNode)
         ASSERT(constantUnion);
 
         const TInterfaceBlock *interfaceBlock = blockNode->getType().getInterfaceBlock();
-        InterfaceBlock *namedBlock = FindVariable(interfaceBlock->name(), mInterfaceBlocks);
+        ShaderReflection::Block *namedBlock   = findInterfaceBlock(interfaceBlock->name());
         ASSERT(namedBlock);
         namedBlock->staticUse = true;
 
         unsigned int fieldIndex = constantUnion->getUConst(0);
-        ASSERT(fieldIndex < namedBlock->fields.size());
-        namedBlock->fields[fieldIndex].staticUse = true;
+        mReflection->getField(namedBlock->fieldRange, fieldIndex).staticUse = true;
         return false;
     }
 
@@ -670,7 +616,7 @@ void ExpandVariable(const ShaderVariable &variable,
             expandedVar.mappedName += "[0]";
         }
 
-        expanded->push_back(expandedVar);
+        expanded->push_back(std::move(expandedVar));
     }
 }
 
@@ -21,11 +21,7 @@ namespace sh
 class CollectVariables : public TIntermTraverser
 {
   public:
-    CollectVariables(std::vector<Attribute> *attribs,
-                     std::vector<OutputVariable> *outputVariables,
-                     std::vector<Uniform> *uniforms,
-                     std::vector<Varying> *varyings,
-                     std::vector<InterfaceBlock> *interfaceBlocks,
+    CollectVariables(ShaderReflection *reflection,
                      ShHashFunction64 hashFunction,
                      const TSymbolTable &symbolTable,
                      const TExtensionBehavior &extensionBehavior);
@@ -35,19 +31,25 @@ class CollectVariables : public TIntermTraverser
     bool visitBinary(Visit visit, TIntermBinary *binaryNode) override;
 
   private:
-    template <typename VarT>
-    void visitVariable(const TIntermSymbol *variable, std::vector<VarT> *infoList) const;
-
-    template <typename VarT>
-    void visitInfoList(const TIntermSequence &sequence, std::vector<VarT> *infoList) const;
-
-    std::vector<Attribute> *mAttribs;
-    std::vector<OutputVariable> *mOutputVariables;
-    std::vector<Uniform> *mUniforms;
-    std::vector<Varying> *mVaryings;
-    std::vector<InterfaceBlock> *mInterfaceBlocks;
-
-    std::map<std::string, InterfaceBlockField *> mInterfaceBlockFields;
+    // Returns the record of a variable of the given type, appending the records of its struct
+    // fields to the reflection.
+    ShaderReflection::Variable recordVariable(const TType &type, const TString &name);
+    ShaderReflection::Variable recordBuiltIn(const char *name,
+                                             GLenum type,
+                                             GLenum precision,
+                                             unsigned int arraySize);
+    ShaderReflection::StringRange addMappedName(const TString &name,
+                                                ShaderReflection::StringRange nameRange);
+
+    void visitInterfaceBlock(const TIntermSymbol *variable);
+    void visitVariable(const TIntermSymbol *variable,
+                       std::vector<ShaderReflection::Variable> *records);
+
+    ShaderReflection::Variable *findVariable(const TString &name,
+                                             std::vector<ShaderReflection::Variable> *records);
+    ShaderReflection::Block *findInterfaceBlock(const TString &name);
+
+    ShaderReflection *mReflection;
 
     bool mDepthRangeAdded;
     bool mPointCoordAdded;
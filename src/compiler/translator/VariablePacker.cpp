@@ -9,6 +9,7 @@
 #include "angle_gl.h"
 
 #include "compiler/translator/VariablePacker.h"
+#include "common/RegisterAllocator.h"
 #include "common/utilities.h"
 
 int VariablePacker::GetNumComponentsPerRow(sh::GLenum type)
@@ -82,91 +83,12 @@ struct TVariableInfoComparer
     }
 };
 
-unsigned VariablePacker::makeColumnFlags(int column, int numComponentsPerRow)
-{
-    return ((kColumnMask << (kNumColumns - numComponentsPerRow)) & kColumnMask) >> column;
-}
-
-void VariablePacker::fillColumns(int topRow, int numRows, int column, int numComponentsPerRow)
-{
-    unsigned columnFlags = makeColumnFlags(column, numComponentsPerRow);
-    for (int r = 0; r < numRows; ++r)
-    {
-        int row = topRow + r;
-        ASSERT((rows_[row] & columnFlags) == 0);
-        rows_[row] |= columnFlags;
-    }
-}
-
-bool VariablePacker::searchColumn(int column, int numRows, int *destRow, int *destSize)
-{
-    ASSERT(destRow);
-
-    for (; topNonFullRow_ < maxRows_ && rows_[topNonFullRow_] == kColumnMask; ++topNonFullRow_)
-    {
-    }
-
-    for (; bottomNonFullRow_ >= 0 && rows_[bottomNonFullRow_] == kColumnMask; --bottomNonFullRow_)
-    {
-    }
-
-    if (bottomNonFullRow_ - topNonFullRow_ + 1 < numRows)
-    {
-        return false;
-    }
-
-    unsigned columnFlags = makeColumnFlags(column, 1);
-    int topGoodRow       = 0;
-    int smallestGoodTop  = -1;
-    int smallestGoodSize = maxRows_ + 1;
-    int bottomRow        = bottomNonFullRow_ + 1;
-    bool found           = false;
-    for (int row = topNonFullRow_; row <= bottomRow; ++row)
-    {
-        bool rowEmpty = row < bottomRow ? ((rows_[row] & columnFlags) == 0) : false;
-        if (rowEmpty)
-        {
-            if (!found)
-            {
-                topGoodRow = row;
-                found      = true;
-            }
-        }
-        else
-        {
-            if (found)
-            {
-                int size = row - topGoodRow;
-                if (size >= numRows && size < smallestGoodSize)
-                {
-                    smallestGoodSize = size;
-                    smallestGoodTop  = topGoodRow;
-                }
-            }
-            found = false;
-        }
-    }
-    if (smallestGoodTop < 0)
-    {
-        return false;
-    }
-
-    *destRow = smallestGoodTop;
-    if (destSize)
-    {
-        *destSize = smallestGoodSize;
-    }
-    return true;
-}
-
 bool VariablePacker::CheckVariablesWithinPackingLimits(
     unsigned int maxVectors,
     const std::vector<sh::ShaderVariable> &in_variables)
 {
     ASSERT(maxVectors > 0);
-    maxRows_          = maxVectors;
-    topNonFullRow_    = 0;
-    bottomNonFullRow_ = maxRows_ - 1;
+    int maxRows = maxVectors;
     std::vector<sh::ShaderVariable> variables;
 
     for (const auto &variable : in_variables)
@@ -188,11 +110,11 @@ bool VariablePacker::CheckVariablesWithinPackingLimits(
     // As per GLSL 1.017 Appendix A, Section 7 variables are packed in specific
     // order by type, then by size of array, largest first.
     std::sort(variables.begin(), variables.end(), TVariableInfoComparer());
-    rows_.clear();
-    rows_.resize(maxVectors, 0);
+    angle::RegisterAllocator registers(maxVectors);
 
     // Packs the 4 column variables.
-    size_t ii = 0;
+    size_t ii          = 0;
+    int num4ColumnRows = 0;
     for (; ii < variables.size(); ++ii)
     {
         const sh::ShaderVariable &variable = variables[ii];
@@ -200,14 +122,16 @@ bool VariablePacker::CheckVariablesWithinPackingLimits(
         {
             break;
         }
-        topNonFullRow_ += GetNumRows(variable.type) * variable.elementCount();
+        num4ColumnRows += GetNumRows(variable.type) * variable.elementCount();
     }
 
-    if (topNonFullRow_ > maxRows_)
+    if (num4ColumnRows > maxRows)
     {
         return false;
     }
 
+    registers.allocate(0, 0, num4ColumnRows, 4);
+
     // Packs the 3 column variables.
     int num3ColumnRows = 0;
     for (; ii < variables.size(); ++ii)
@@ -220,16 +144,16 @@ bool VariablePacker::CheckVariablesWithinPackingLimits(
         num3ColumnRows += GetNumRows(variable.type) * variable.elementCount();
     }
 
-    if (topNonFullRow_ + num3ColumnRows > maxRows_)
+    if (num4ColumnRows + num3ColumnRows > maxRows)
     {
         return false;
     }
 
-    fillColumns(topNonFullRow_, num3ColumnRows, 0, 3);
+    registers.allocate(num4ColumnRows, 0, num3ColumnRows, 3);
 
     // Packs the 2 column variables.
-    int top2ColumnRow            = topNonFullRow_ + num3ColumnRows;
-    int twoColumnRowsAvailable   = maxRows_ - top2ColumnRow;
+    int top2ColumnRow            = num4ColumnRows + num3ColumnRows;
+    int twoColumnRowsAvailable   = maxRows - top2ColumnRow;
     int rowsAvailableInColumns01 = twoColumnRowsAvailable;
     int rowsAvailableInColumns23 = twoColumnRowsAvailable;
     for (; ii < variables.size(); ++ii)
@@ -256,30 +180,28 @@ bool VariablePacker::CheckVariablesWithinPackingLimits(
 
     int numRowsUsedInColumns01 = twoColumnRowsAvailable - rowsAvailableInColumns01;
     int numRowsUsedInColumns23 = twoColumnRowsAvailable - rowsAvailableInColumns23;
-    fillColumns(top2ColumnRow, numRowsUsedInColumns01, 0, 2);
-    fillColumns(maxRows_ - numRowsUsedInColumns23, numRowsUsedInColumns23, 2, 2);
+    registers.allocate(top2ColumnRow, 0, numRowsUsedInColumns01, 2);
+    registers.allocate(maxRows - numRowsUsedInColumns23, 2, numRowsUsedInColumns23, 2);
 
-    // Packs the 1 column variables.
+    // Packs the 1 column variables, each into the smallest run of free rows that holds it.
     for (; ii < variables.size(); ++ii)
     {
         const sh::ShaderVariable &variable = variables[ii];
         ASSERT(1 == GetNumComponentsPerRow(variable.type));
-        int numRows        = GetNumRows(variable.type) * variable.elementCount();
-        int smallestColumn = -1;
-        int smallestSize   = maxRows_ + 1;
-        int topRow         = -1;
-        for (int column = 0; column < kNumColumns; ++column)
+        unsigned int numRows      = GetNumRows(variable.type) * variable.elementCount();
+        int smallestColumn        = -1;
+        unsigned int smallestSize = maxVectors + 1;
+        unsigned int topRow       = 0;
+        for (unsigned int column = 0; column < angle::RegisterAllocator::kColumnCount; ++column)
         {
-            int row  = 0;
-            int size = 0;
-            if (searchColumn(column, numRows, &row, &size))
+            unsigned int row  = 0;
+            unsigned int size = 0;
+            if (registers.findSmallestFreeRun(column, numRows, &row, &size) &&
+                size < smallestSize)
             {
-                if (size < smallestSize)
-                {
-                    smallestSize   = size;
-                    smallestColumn = column;
-                    topRow         = row;
-                }
+                smallestSize   = size;
+                smallestColumn = column;
+                topRow         = row;
             }
         }
 
@@ -288,7 +210,7 @@ bool VariablePacker::CheckVariablesWithinPackingLimits(
             return false;
         }
 
-        fillColumns(topRow, numRows, smallestColumn, 1);
+        registers.allocate(topRow, smallestColumn, numRows, 1);
     }
 
     ASSERT(variables.size() == ii);
@@ -23,19 +23,6 @@ class VariablePacker
 
     // Gets how many rows a data type takes.
     static int GetNumRows(sh::GLenum type);
-
-  private:
-    static const int kNumColumns      = 4;
-    static const unsigned kColumnMask = (1 << kNumColumns) - 1;
-
-    unsigned makeColumnFlags(int column, int numComponentsPerRow);
-    void fillColumns(int topRow, int numRows, int column, int numComponentsPerRow);
-    bool searchColumn(int column, int numRows, int *destRow, int *destSize);
-
-    int topNonFullRow_;
-    int bottomNonFullRow_;
-    int maxRows_;
-    std::vector<unsigned> rows_;
 };
 
 #endif  // COMPILER_TRANSLATOR_VARIABLEPACKER_H_
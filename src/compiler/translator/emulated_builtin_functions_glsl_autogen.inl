@@ -0,0 +1,274 @@
+// GENERATED FILE - DO NOT EDIT.
+// Generated by gen_emulated_builtin_function_tables.py using data from
+// emulated_builtin_function_data_glsl.json.
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// emulated_builtin_functions_glsl_autogen.inl:
+//   Tables of GLSL emulated built-in functions, keyed by operator and parameter types.
+
+namespace sh
+{
+
+namespace
+{
+
+typedef BuiltInFunctionEmulator::EmulatedFunction EmulatedFunction;
+typedef BuiltInFunctionEmulator::FunctionId FunctionId;
+typedef BuiltInFunctionEmulator::ParamType ParamType;
+
+constexpr ParamType kFloat1(EbtFloat);
+constexpr ParamType kFloat2(EbtFloat, 2);
+constexpr ParamType kFloat3(EbtFloat, 3);
+constexpr ParamType kFloat4(EbtFloat, 4);
+constexpr ParamType kInt1(EbtInt);
+constexpr ParamType kUInt1(EbtUInt);
+
+constexpr EmulatedFunction kGLSLAbsFunctions[] = {
+    {FunctionId(EOpAbs, kInt1),
+     FunctionId(),
+     "int webgl_abs_emu(int x) { return x * sign(x); }"},
+};
+
+constexpr EmulatedFunction kGLSLAtanFunctions[] = {
+    {FunctionId(EOpAtan, kFloat1, kFloat1),
+     FunctionId(),
+     "webgl_emu_precision float webgl_atan_emu(webgl_emu_precision float y, "
+     "webgl_emu_precision float x)\n"
+     "{\n"
+     "    if (x > 0.0) return atan(y / x);\n"
+     "    else if (x < 0.0 && y >= 0.0) return atan(y / x) + 3.14159265;\n"
+     "    else if (x < 0.0 && y < 0.0) return atan(y / x) - 3.14159265;\n"
+     "    else return 1.57079632 * sign(y);\n"
+     "}\n"},
+    {FunctionId(EOpAtan, kFloat2, kFloat2),
+     FunctionId(EOpAtan, kFloat1, kFloat1),
+     "webgl_emu_precision vec2 webgl_atan_emu(webgl_emu_precision vec2 y, webgl_emu_precision "
+     "vec2 x)\n"
+     "{\n"
+     "    return vec2(webgl_atan_emu(y[0], x[0]), webgl_atan_emu(y[1], x[1]));\n"
+     "}\n"},
+    {FunctionId(EOpAtan, kFloat3, kFloat3),
+     FunctionId(EOpAtan, kFloat1, kFloat1),
+     "webgl_emu_precision vec3 webgl_atan_emu(webgl_emu_precision vec3 y, webgl_emu_precision "
+     "vec3 x)\n"
+     "{\n"
+     "    return vec3(webgl_atan_emu(y[0], x[0]), webgl_atan_emu(y[1], x[1]), "
+     "webgl_atan_emu(y[2], x[2]));\n"
+     "}\n"},
+    {FunctionId(EOpAtan, kFloat4, kFloat4),
+     FunctionId(EOpAtan, kFloat1, kFloat1),
+     "webgl_emu_precision vec4 webgl_atan_emu(webgl_emu_precision vec4 y, webgl_emu_precision "
+     "vec4 x)\n"
+     "{\n"
+     "    return vec4(webgl_atan_emu(y[0], x[0]), webgl_atan_emu(y[1], x[1]), "
+     "webgl_atan_emu(y[2], x[2]), webgl_atan_emu(y[3], x[3]));\n"
+     "}\n"},
+};
+
+constexpr EmulatedFunction kGLSLIsnanFunctions[] = {
+    // !(x > 0.0 || x < 0.0 || x == 0.0) will be optimized and always equal to false.
+    {FunctionId(EOpIsNan, kFloat1),
+     FunctionId(),
+     "bool webgl_isnan_emu(float x) { return (x > 0.0 || x < 0.0) ? false : x != 0.0; }"},
+    {FunctionId(EOpIsNan, kFloat2),
+     FunctionId(),
+     "bvec2 webgl_isnan_emu(vec2 x)\n"
+     "{\n"
+     "    bvec2 isnan;\n"
+     "    for (int i = 0; i < 2; i++)\n"
+     "    {\n"
+     "        isnan[i] = (x[i] > 0.0 || x[i] < 0.0) ? false : x[i] != 0.0;\n"
+     "    }\n"
+     "    return isnan;\n"
+     "}\n"},
+    {FunctionId(EOpIsNan, kFloat3),
+     FunctionId(),
+     "bvec3 webgl_isnan_emu(vec3 x)\n"
+     "{\n"
+     "    bvec3 isnan;\n"
+     "    for (int i = 0; i < 3; i++)\n"
+     "    {\n"
+     "        isnan[i] = (x[i] > 0.0 || x[i] < 0.0) ? false : x[i] != 0.0;\n"
+     "    }\n"
+     "    return isnan;\n"
+     "}\n"},
+    {FunctionId(EOpIsNan, kFloat4),
+     FunctionId(),
+     "bvec4 webgl_isnan_emu(vec4 x)\n"
+     "{\n"
+     "    bvec4 isnan;\n"
+     "    for (int i = 0; i < 4; i++)\n"
+     "    {\n"
+     "        isnan[i] = (x[i] > 0.0 || x[i] < 0.0) ? false : x[i] != 0.0;\n"
+     "    }\n"
+     "    return isnan;\n"
+     "}\n"},
+};
+
+constexpr EmulatedFunction kGLSLPackSnormHalfFunctions[] = {
+    {FunctionId(EOpPackSnorm2x16, kFloat2),
+     FunctionId(),
+     "uint webgl_packSnorm2x16_emu(vec2 v)\n"
+     "{\n"
+     "    #if defined(GL_ARB_shading_language_packing)\n"
+     "        return packSnorm2x16(v);\n"
+     "    #else\n"
+     "        int x = int(round(clamp(v.x, -1.0, 1.0) * 32767.0));\n"
+     "        int y = int(round(clamp(v.y, -1.0, 1.0) * 32767.0));\n"
+     "        return uint((y << 16) | (x & 0xFFFF));\n"
+     "    #endif\n"
+     "}\n"},
+    {FunctionId(EOpUnpackSnorm2x16, kUInt1),
+     FunctionId(),
+     "#if !defined(GL_ARB_shading_language_packing)\n"
+     "    float webgl_fromSnorm(uint x)\n"
+     "    {\n"
+     "        int xi = (int(x) & 0x7FFF) - (int(x) & 0x8000);\n"
+     "        return clamp(float(xi) / 32767.0, -1.0, 1.0);\n"
+     "    }\n"
+     "#endif\n"
+     "\n"
+     "vec2 webgl_unpackSnorm2x16_emu(uint u)\n"
+     "{\n"
+     "    #if defined(GL_ARB_shading_language_packing)\n"
+     "        return unpackSnorm2x16(u);\n"
+     "    #else\n"
+     "        uint y = (u >> 16);\n"
+     "        uint x = u;\n"
+     "        return vec2(webgl_fromSnorm(x), webgl_fromSnorm(y));\n"
+     "    #endif\n"
+     "}\n"},
+    // Functions uint webgl_f32tof16(float val) and float webgl_f16tof32(uint val) are
+    // based on the OpenGL redbook Appendix Session "Floating-Point Formats Used in OpenGL".
+    {FunctionId(EOpPackHalf2x16, kFloat2),
+     FunctionId(),
+     "#if !defined(GL_ARB_shading_language_packing)\n"
+     "    uint webgl_f32tof16(float val)\n"
+     "    {\n"
+     "        uint f32 = floatBitsToUint(val);\n"
+     "        uint f16 = 0u;\n"
+     "        uint sign = (f32 >> 16) & 0x8000u;\n"
+     "        int exponent = int((f32 >> 23) & 0xFFu) - 127;\n"
+     "        uint mantissa = f32 & 0x007FFFFFu;\n"
+     "        if (exponent == 128)\n"
+     "        {\n"
+     "            // Infinity or NaN\n"
+     "            // NaN bits that are masked out by 0x3FF get discarded.\n"
+     "            // This can turn some NaNs to infinity, but this is allowed by the spec.\n"
+     "            f16 = sign | (0x1Fu << 10);\n"
+     "            f16 |= (mantissa & 0x3FFu);\n"
+     "        }\n"
+     "        else if (exponent > 15)\n"
+     "        {\n"
+     "            // Overflow - flush to Infinity\n"
+     "            f16 = sign | (0x1Fu << 10);\n"
+     "        }\n"
+     "        else if (exponent > -15)\n"
+     "        {\n"
+     "            // Representable value\n"
+     "            exponent += 15;\n"
+     "            mantissa >>= 13;\n"
+     "            f16 = sign | uint(exponent << 10) | mantissa;\n"
+     "        }\n"
+     "        else\n"
+     "        {\n"
+     "            f16 = sign;\n"
+     "        }\n"
+     "        return f16;\n"
+     "    }\n"
+     "#endif\n"
+     "\n"
+     "uint webgl_packHalf2x16_emu(vec2 v)\n"
+     "{\n"
+     "    #if defined(GL_ARB_shading_language_packing)\n"
+     "        return packHalf2x16(v);\n"
+     "    #else\n"
+     "        uint x = webgl_f32tof16(v.x);\n"
+     "        uint y = webgl_f32tof16(v.y);\n"
+     "        return (y << 16) | x;\n"
+     "    #endif\n"
+     "}\n"},
+    {FunctionId(EOpUnpackHalf2x16, kUInt1),
+     FunctionId(),
+     "#if !defined(GL_ARB_shading_language_packing)\n"
+     "    float webgl_f16tof32(uint val)\n"
+     "    {\n"
+     "        uint sign = (val & 0x8000u) << 16;\n"
+     "        int exponent = int((val & 0x7C00u) >> 10);\n"
+     "        uint mantissa = val & 0x03FFu;\n"
+     "        float f32 = 0.0;\n"
+     "        if(exponent == 0)\n"
+     "        {\n"
+     "            if (mantissa != 0u)\n"
+     "            {\n"
+     "                const float scale = 1.0 / (1 << 24);\n"
+     "                f32 = scale * mantissa;\n"
+     "            }\n"
+     "        }\n"
+     "        else if (exponent == 31)\n"
+     "        {\n"
+     "            return uintBitsToFloat(sign | 0x7F800000u | mantissa);\n"
+     "        }\n"
+     "        else\n"
+     "        {\n"
+     "            exponent -= 15;\n"
+     "            float scale;\n"
+     "            if(exponent < 0)\n"
+     "            {\n"
+     "                // The negative unary operator is buggy on OSX.\n"
+     "                // Work around this by using abs instead.\n"
+     "                scale = 1.0 / (1 << abs(exponent));\n"
+     "            }\n"
+     "            else\n"
+     "            {\n"
+     "                scale = 1 << exponent;\n"
+     "            }\n"
+     "            float decimal = 1.0 + float(mantissa) / float(1 << 10);\n"
+     "            f32 = scale * decimal;\n"
+     "        }\n"
+     "\n"
+     "        if (sign != 0u)\n"
+     "        {\n"
+     "            f32 = -f32;\n"
+     "        }\n"
+     "\n"
+     "        return f32;\n"
+     "    }\n"
+     "#endif\n"
+     "\n"
+     "vec2 webgl_unpackHalf2x16_emu(uint u)\n"
+     "{\n"
+     "    #if defined(GL_ARB_shading_language_packing)\n"
+     "        return unpackHalf2x16(u);\n"
+     "    #else\n"
+     "        uint y = (u >> 16);\n"
+     "        uint x = u & 0xFFFFu;\n"
+     "        return vec2(webgl_f16tof32(x), webgl_f16tof32(y));\n"
+     "    #endif\n"
+     "}\n"},
+};
+
+constexpr EmulatedFunction kGLSLPackUnormFunctions[] = {
+    {FunctionId(EOpPackUnorm2x16, kFloat2),
+     FunctionId(),
+     "uint webgl_packUnorm2x16_emu(vec2 v)\n"
+     "{\n"
+     "    int x = int(round(clamp(v.x, 0.0, 1.0) * 65535.0));\n"
+     "    int y = int(round(clamp(v.y, 0.0, 1.0) * 65535.0));\n"
+     "    return uint((y << 16) | (x & 0xFFFF));\n"
+     "}\n"},
+    {FunctionId(EOpUnpackUnorm2x16, kUInt1),
+     FunctionId(),
+     "vec2 webgl_unpackUnorm2x16_emu(uint u)\n"
+     "{\n"
+     "    float x = float(u & 0xFFFFu) / 65535.0;\n"
+     "    float y = float(u >> 16) / 65535.0;\n"
+     "    return vec2(x, y);\n"
+     "}\n"},
+};
+}  // anonymous namespace
+
+}  // namespace sh
@@ -0,0 +1,142 @@
+#!/usr/bin/python
+# Copyright 2016 The ANGLE Project Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+#
+# gen_emulated_builtin_function_tables.py:
+#  Code generation for the tables of emulated built-in functions. The translator looks up the
+#  definitions in these tables by operator and parameter types instead of building them at
+#  each compile.
+
+from datetime import date
+import json
+import sys
+
+template_inl = """// GENERATED FILE - DO NOT EDIT.
+// Generated by {script_name} using data from
+// {data_source_name}.
+//
+// Copyright {copyright_year} The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// {file_name}:
+//   Tables of {language} emulated built-in functions, keyed by operator and parameter types.
+
+namespace sh
+{{
+
+namespace
+{{
+
+typedef BuiltInFunctionEmulator::EmulatedFunction EmulatedFunction;
+typedef BuiltInFunctionEmulator::FunctionId FunctionId;
+typedef BuiltInFunctionEmulator::ParamType ParamType;
+
+{param_types}
+{tables}}}  // anonymous namespace
+
+}}  // namespace sh
+"""
+
+template_table = """constexpr EmulatedFunction k{table_name}[] = {{
+{functions}}};
+"""
+
+template_function = """{comment}    {{{function_id},
+     {dependency},
+{definition}}},
+"""
+
+# Parameter type names used in the data files, mapped to the arguments of the ParamType
+# constructor.
+param_types = {
+    'bool1': ('kBool1', 'EbtBool'),
+    'bool2': ('kBool2', 'EbtBool, 2'),
+    'bool3': ('kBool3', 'EbtBool, 3'),
+    'bool4': ('kBool4', 'EbtBool, 4'),
+    'float1': ('kFloat1', 'EbtFloat'),
+    'float2': ('kFloat2', 'EbtFloat, 2'),
+    'float3': ('kFloat3', 'EbtFloat, 3'),
+    'float4': ('kFloat4', 'EbtFloat, 4'),
+    'int1': ('kInt1', 'EbtInt'),
+    'mat2': ('kMat2', 'EbtFloat, 2, 2'),
+    'mat3': ('kMat3', 'EbtFloat, 3, 3'),
+    'mat4': ('kMat4', 'EbtFloat, 4, 4'),
+    'uint1': ('kUInt1', 'EbtUInt'),
+}
+
+# Long lines of the definitions are split into several string literals to keep the generated
+# code readable.
+max_literal_length = 88
+
+def gen_function_id(function_id, used_param_types):
+    args = [function_id['op']]
+    for param in function_id['params']:
+        used_param_types.add(param)
+        args.append(param_types[param][0])
+    return 'FunctionId(' + ', '.join(args) + ')'
+
+def escape(text):
+    return text.replace('\\', '\\\\').replace('"', '\\"')
+
+def gen_definition(code):
+    # The lines are joined with newlines, so a definition that ends with a newline ends with an
+    # empty line in the data.
+    lines = [line + '\n' for line in code[:-1]]
+    if code[-1]:
+        lines.append(code[-1])
+    literals = []
+    for line in lines:
+        while len(line) > max_literal_length:
+            split = line.rfind(' ', 0, max_literal_length) + 1 or max_literal_length
+            literals.append(line[:split])
+            line = line[split:]
+        literals.append(line)
+    return '\n'.join('     "' + escape(literal).replace('\n', '\\n') + '"'
+                     for literal in literals)
+
+def gen_table(table_name, functions, used_param_types):
+    functions_text = ''
+    for function in functions:
+        comment = ''.join(('    // ' + line).rstrip() + '\n'
+                          for line in function.get('comment', []))
+        dependency = 'FunctionId()'
+        if 'dependency' in function:
+            dependency = gen_function_id(function['dependency'], used_param_types)
+        functions_text += template_function.format(
+            comment = comment,
+            function_id = gen_function_id(function, used_param_types),
+            dependency = dependency,
+            definition = gen_definition(function['code']))
+    return template_table.format(table_name = table_name, functions = functions_text)
+
+def gen_tables(language):
+    data_source_name = 'emulated_builtin_function_data_' + language.lower() + '.json'
+    file_name = 'emulated_builtin_functions_' + language.lower() + '_autogen.inl'
+
+    with open(data_source_name) as data_file:
+        json_data = json.load(data_file)
+
+    used_param_types = set()
+    tables = [gen_table(table_name, json_data[table_name], used_param_types)
+              for table_name in sorted(json_data)]
+    param_types_text = ''.join(
+        'constexpr ParamType {0}({1});\n'.format(*param_types[param])
+        for param in sorted(used_param_types, key = lambda param: param_types[param][0]))
+
+    output_inl = template_inl.format(
+        script_name = sys.argv[0],
+        data_source_name = data_source_name,
+        copyright_year = date.today().year,
+        file_name = file_name,
+        language = language,
+        param_types = param_types_text,
+        tables = '\n'.join(tables))
+
+    with open(file_name, 'wt') as out_file:
+        out_file.write(output_inl)
+        out_file.close()
+
+gen_tables('GLSL')
+gen_tables('HLSL')
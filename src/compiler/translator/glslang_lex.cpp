@@ -3311,9 +3311,9 @@ void yyfree (void * ptr , yyscan_t yyscanner)
 yy_size_t string_input(char* buf, yy_size_t max_size, yyscan_t yyscanner) {
     pp::Token token;
     yyget_extra(yyscanner)->getPreprocessor().lex(&token);
-    yy_size_t len = token.type == pp::Token::LAST ? 0 : token.text.size();
+    yy_size_t len = token.type == pp::Token::LAST ? 0 : token.text().size();
     if (len < max_size)
-        memcpy(buf, token.text.c_str(), len);
+        memcpy(buf, token.text().c_str(), len);
     yyset_column(token.location.file,yyscanner);
     yyset_lineno(token.location.line,yyscanner);
 
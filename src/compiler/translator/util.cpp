@@ -7,6 +7,7 @@
 #include "compiler/translator/util.h"
 
 #include <limits>
+#include <utility>
 
 #include "common/utilities.h"
 #include "compiler/preprocessor/numeric_lex.h"
@@ -770,7 +771,7 @@ void GetVariableTraverser::traverse(const TType &type,
     visitVariable(&variable);
 
     ASSERT(output);
-    output->push_back(variable);
+    output->push_back(std::move(variable));
 }
 
 template void GetVariableTraverser::traverse(const TType &,
@@ -11,8 +11,10 @@
 
 #include <cstddef>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <stdint.h>
+#include <string.h>
 
 #include "common/angleutils.h"
 #include "common/mathutil.h"
@@ -93,6 +95,45 @@ class BinaryInputStream : angle::NonCopyable
         mOffset = checkedOffset.ValueOrDie();
     }
 
+    // Returns the next |length| bytes of the stream without copying them, or nullptr if the stream
+    // is too short.
+    const uint8_t *readInPlace(size_t length)
+    {
+        const uint8_t *bytes = mData + mOffset;
+        skip(length);
+        return (mError ? nullptr : bytes);
+    }
+
+    // Reads the count of an array written with writeRecords, and returns the array in place. The
+    // records may not be aligned, so GetRecord copies them out one at a time.
+    template <class RecordT>
+    const uint8_t *readRecords(size_t *countOut)
+    {
+        static_assert(std::is_pod<RecordT>::value, "RecordT must be a POD type.");
+
+        size_t count = readInt<size_t>();
+        angle::CheckedNumeric<size_t> checkedLength(count);
+        checkedLength *= sizeof(RecordT);
+        if (mError || !checkedLength.IsValid())
+        {
+            mError    = true;
+            *countOut = 0;
+            return nullptr;
+        }
+
+        const uint8_t *records = readInPlace(checkedLength.ValueOrDie());
+        *countOut              = (records ? count : 0);
+        return records;
+    }
+
+    template <class RecordT>
+    static RecordT GetRecord(const uint8_t *records, size_t index)
+    {
+        RecordT record;
+        memcpy(&record, records + index * sizeof(RecordT), sizeof(RecordT));
+        return record;
+    }
+
     void skip(size_t length)
     {
         angle::CheckedNumeric<size_t> checkedOffset(mOffset);
@@ -208,6 +249,20 @@ class BinaryOutputStream : angle::NonCopyable
         write(bytes, count);
     }
 
+    // Writes an array of fixed-layout records and its count, to be read with readRecords. The
+    // records are copied byte for byte, so RecordT must not have padding.
+    template <class RecordT>
+    void writeRecords(const std::vector<RecordT> &records)
+    {
+        static_assert(std::is_pod<RecordT>::value, "RecordT must be a POD type.");
+
+        writeInt(records.size());
+        if (!records.empty())
+        {
+            write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(RecordT));
+        }
+    }
+
     size_t length() const
     {
         return mData.size();
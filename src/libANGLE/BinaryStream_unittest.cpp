@@ -68,4 +68,72 @@ TEST(BinaryInputStream, Overflow)
         stream.readBytes(outputData.data(), std::numeric_limits<size_t>::max() - dataSize - 2);
     }
 }
+
+// Test that records written as an array are read back in place, and that a count too large for the
+// stream is an error.
+TEST(BinaryInputStream, Records)
+{
+    struct Record
+    {
+        uint32_t a;
+        uint8_t b;
+    };
+
+    std::vector<Record> records(3);
+    for (size_t index = 0; index < records.size(); ++index)
+    {
+        records[index].a = static_cast<uint32_t>(index * 1000);
+        records[index].b = static_cast<uint8_t>(index);
+    }
+
+    gl::BinaryOutputStream output;
+    output.writeInt(7);
+    output.writeRecords(records);
+    output.writeRecords(std::vector<Record>());
+
+    {
+        gl::BinaryInputStream stream(output.data(), output.length());
+        ASSERT_EQ(7, stream.readInt<int>());
+
+        size_t count             = 0;
+        const uint8_t *inputData = stream.readRecords<Record>(&count);
+        ASSERT_FALSE(stream.error());
+        ASSERT_EQ(records.size(), count);
+        for (size_t index = 0; index < count; ++index)
+        {
+            Record record = gl::BinaryInputStream::GetRecord<Record>(inputData, index);
+            EXPECT_EQ(records[index].a, record.a);
+            EXPECT_EQ(records[index].b, record.b);
+        }
+
+        stream.readRecords<Record>(&count);
+        ASSERT_FALSE(stream.error());
+        EXPECT_EQ(0u, count);
+        EXPECT_TRUE(stream.endOfStream());
+    }
+
+    {
+        // Cut off the count of the empty array, which writeRecords writes as an int, and the last
+        // byte of the last record
+        gl::BinaryInputStream stream(output.data(), output.length() - sizeof(int) - 1);
+        stream.readInt<int>();
+
+        size_t count = 0;
+        EXPECT_EQ(nullptr, stream.readRecords<Record>(&count));
+        EXPECT_TRUE(stream.error());
+        EXPECT_EQ(0u, count);
+    }
+
+    {
+        // A count whose size in bytes overflows: -1 is read back as the largest size_t
+        gl::BinaryOutputStream badOutput;
+        badOutput.writeInt(-1);
+        gl::BinaryInputStream stream(badOutput.data(), badOutput.length());
+
+        size_t count = 0;
+        EXPECT_EQ(nullptr, stream.readRecords<Record>(&count));
+        EXPECT_TRUE(stream.error());
+        EXPECT_EQ(0u, count);
+    }
+}
 }
@@ -75,45 +75,98 @@ TextureCaps GenerateMinimumTextureCaps(GLenum internalFormat,
     return caps;
 }
 
-void TextureCapsMap::insert(GLenum internalFormat, const TextureCaps &caps)
+TextureCapsMap::const_iterator::const_iterator(const std::vector<Entry> &entries, size_t index)
+    : mEntries(&entries), mIndex(index)
 {
-    mCapsMap[internalFormat] = caps;
+    skipEmpty();
+}
+
+TextureCapsMap::const_iterator &TextureCapsMap::const_iterator::operator++()
+{
+    mIndex++;
+    skipEmpty();
+    return *this;
+}
+
+TextureCapsMap::const_iterator TextureCapsMap::const_iterator::operator++(int)
+{
+    const_iterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+void TextureCapsMap::const_iterator::skipEmpty()
+{
+    while (mIndex < mEntries->size() && (*mEntries)[mIndex].first == GL_NONE)
+    {
+        mIndex++;
+    }
+}
+
+TextureCapsMap::TextureCapsMap() : mSize(0)
+{
+}
+
+bool TextureCapsMap::insert(GLenum internalFormat, const TextureCaps &caps)
+{
+    size_t id = GetInternalFormatID(internalFormat);
+    if (id == 0)
+    {
+        return false;
+    }
+
+    if (mEntries.empty())
+    {
+        mEntries.resize(GetInternalFormatCount(), Entry(GL_NONE, TextureCaps()));
+    }
+
+    Entry &entry = mEntries[id];
+    if (entry.first == GL_NONE)
+    {
+        entry.first = internalFormat;
+        mSize++;
+    }
+    entry.second = caps;
+    return true;
 }
 
 void TextureCapsMap::remove(GLenum internalFormat)
 {
-    InternalFormatToCapsMap::iterator i = mCapsMap.find(internalFormat);
-    if (i != mCapsMap.end())
+    size_t id = GetInternalFormatID(internalFormat);
+    if (id < mEntries.size() && mEntries[id].first != GL_NONE)
     {
-        mCapsMap.erase(i);
+        mEntries[id] = Entry(GL_NONE, TextureCaps());
+        mSize--;
     }
 }
 
 void TextureCapsMap::clear()
 {
-    mCapsMap.clear();
+    mEntries.clear();
+    mSize = 0;
 }
 
 const TextureCaps &TextureCapsMap::get(GLenum internalFormat) const
 {
     static TextureCaps defaultUnsupportedTexture;
-    InternalFormatToCapsMap::const_iterator iter = mCapsMap.find(internalFormat);
-    return (iter != mCapsMap.end()) ? iter->second : defaultUnsupportedTexture;
+    size_t id = GetInternalFormatID(internalFormat);
+    return (id < mEntries.size() && mEntries[id].first != GL_NONE) ? mEntries[id].second
+                                                                   : defaultUnsupportedTexture;
 }
 
 TextureCapsMap::const_iterator TextureCapsMap::begin() const
 {
-    return mCapsMap.begin();
+    return const_iterator(mEntries, 0);
 }
 
 TextureCapsMap::const_iterator TextureCapsMap::end() const
 {
-    return mCapsMap.end();
+    return const_iterator(mEntries, mEntries.size());
 }
 
 size_t TextureCapsMap::size() const
 {
-    return mCapsMap.size();
+    return mSize;
 }
 
 TextureCapsMap GenerateMinimumTextureCapsMap(const Version &clientVersion,
@@ -52,12 +52,39 @@ TextureCaps GenerateMinimumTextureCaps(GLenum internalFormat,
                                        const Version &clientVersion,
                                        const Extensions &extensions);
 
+// Texture caps for each internal format, stored densely by internal format ID.
 class TextureCapsMap
 {
   public:
-    typedef std::map<GLenum, TextureCaps>::const_iterator const_iterator;
+    typedef std::pair<GLenum, TextureCaps> Entry;
 
-    void insert(GLenum internalFormat, const TextureCaps &caps);
+    // Iterates over the inserted formats in increasing GLenum order.
+    class const_iterator
+    {
+      public:
+        const_iterator(const std::vector<Entry> &entries, size_t index);
+
+        const Entry &operator*() const { return (*mEntries)[mIndex]; }
+        const Entry *operator->() const { return &(*mEntries)[mIndex]; }
+
+        const_iterator &operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator &other) const { return mIndex == other.mIndex; }
+        bool operator!=(const const_iterator &other) const { return mIndex != other.mIndex; }
+
+      private:
+        void skipEmpty();
+
+        const std::vector<Entry> *mEntries;
+        size_t mIndex;
+    };
+
+    TextureCapsMap();
+
+    // Formats are stored by internal format ID. Returns false, and stores nothing, for an
+    // internalFormat that has no ID.
+    bool insert(GLenum internalFormat, const TextureCaps &caps);
     void remove(GLenum internalFormat);
     void clear();
 
@@ -69,8 +96,9 @@ class TextureCapsMap
     size_t size() const;
 
   private:
-    typedef std::map<GLenum, TextureCaps> InternalFormatToCapsMap;
-    InternalFormatToCapsMap mCapsMap;
+    // Absent formats have GL_NONE as their key.
+    std::vector<Entry> mEntries;
+    size_t mSize;
 };
 
 TextureCapsMap GenerateMinimumTextureCapsMap(const Version &clientVersion,
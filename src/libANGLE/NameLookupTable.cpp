@@ -0,0 +1,126 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// NameLookupTable.cpp: Implements the gl::NameLookupTable class.
+
+#include "libANGLE/NameLookupTable.h"
+
+#include <string.h>
+
+#include "common/debug.h"
+
+namespace gl
+{
+
+namespace
+{
+const size_t kMinSlotCount = 16;
+}  // anonymous namespace
+
+NameLookupTable::NameLookupTable()
+{
+}
+
+NameLookupTable::~NameLookupTable()
+{
+}
+
+void NameLookupTable::insert(const std::string &name, unsigned int value)
+{
+    // Keep the table at most half full so that probe sequences stay short.
+    if ((mEntries.size() + 1) * 2 > mSlots.size())
+    {
+        resize(mSlots.empty() ? kMinSlotCount : mSlots.size() * 2);
+    }
+
+    size_t hash = HashName(name.c_str(), name.length());
+    size_t slot = findSlot(name.c_str(), name.length(), hash);
+    if (mSlots[slot] != 0)
+    {
+        return;
+    }
+
+    Entry entry;
+    entry.hash  = hash;
+    entry.name  = name;
+    entry.value = value;
+    mEntries.push_back(entry);
+    mSlots[slot] = static_cast<unsigned int>(mEntries.size());
+}
+
+void NameLookupTable::clear()
+{
+    mEntries.clear();
+    mSlots.clear();
+}
+
+bool NameLookupTable::find(const char *name, size_t length, unsigned int *valueOut) const
+{
+    if (mEntries.empty())
+    {
+        return false;
+    }
+
+    size_t slot = findSlot(name, length, HashName(name, length));
+    if (mSlots[slot] == 0)
+    {
+        return false;
+    }
+
+    *valueOut = mEntries[mSlots[slot] - 1].value;
+    return true;
+}
+
+size_t NameLookupTable::HashName(const char *name, size_t length)
+{
+    // FNV-1a. Variable names are short and differ mostly in their last characters.
+    size_t hash = static_cast<size_t>(2166136261u);
+    for (size_t index = 0; index < length; ++index)
+    {
+        hash ^= static_cast<unsigned char>(name[index]);
+        hash *= static_cast<size_t>(16777619u);
+    }
+    return hash;
+}
+
+size_t NameLookupTable::findSlot(const char *name, size_t length, size_t hash) const
+{
+    ASSERT(!mSlots.empty());
+    const size_t mask = mSlots.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+    {
+        unsigned int entryIndex = mSlots[slot];
+        if (entryIndex == 0)
+        {
+            return slot;
+        }
+
+        const Entry &entry = mEntries[entryIndex - 1];
+        if (entry.hash == hash && entry.name.length() == length &&
+            memcmp(entry.name.c_str(), name, length) == 0)
+        {
+            return slot;
+        }
+    }
+}
+
+void NameLookupTable::resize(size_t slotCount)
+{
+    mSlots.assign(slotCount, 0);
+
+    const size_t mask = slotCount - 1;
+    for (size_t entryIndex = 0; entryIndex < mEntries.size(); ++entryIndex)
+    {
+        size_t slot = mEntries[entryIndex].hash & mask;
+        while (mSlots[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        mSlots[slot] = static_cast<unsigned int>(entryIndex + 1);
+    }
+}
+
+}  // namespace gl
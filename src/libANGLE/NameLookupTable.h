@@ -0,0 +1,63 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// NameLookupTable.h: Defines the gl::NameLookupTable class, an open-addressed hash table from
+// variable names to indices. Programs fill it at link time so that the name queries don't scan
+// their variable lists, and it can look up part of a string so that stripping an array subscript
+// from a name doesn't need a copy of it.
+
+#ifndef LIBANGLE_NAMELOOKUPTABLE_H_
+#define LIBANGLE_NAMELOOKUPTABLE_H_
+
+#include <string>
+#include <vector>
+
+#include "common/angleutils.h"
+
+namespace gl
+{
+
+class NameLookupTable final : angle::NonCopyable
+{
+  public:
+    NameLookupTable();
+    ~NameLookupTable();
+
+    // Maps |name| to |value|. The first value given for a name is kept.
+    void insert(const std::string &name, unsigned int value);
+    void clear();
+
+    // Looks up the first |length| characters of |name|.
+    bool find(const char *name, size_t length, unsigned int *valueOut) const;
+    bool find(const std::string &name, unsigned int *valueOut) const
+    {
+        return find(name.c_str(), name.length(), valueOut);
+    }
+
+    size_t size() const { return mEntries.size(); }
+
+  private:
+    static size_t HashName(const char *name, size_t length);
+
+    // Returns the slot holding |name|, or the empty slot where it would go.
+    size_t findSlot(const char *name, size_t length, size_t hash) const;
+    void resize(size_t slotCount);
+
+    struct Entry
+    {
+        size_t hash;
+        std::string name;
+        unsigned int value;
+    };
+
+    // The entries in insertion order, and a power-of-two count of slots holding one plus the
+    // index of an entry, or zero when empty.
+    std::vector<Entry> mEntries;
+    std::vector<unsigned int> mSlots;
+};
+
+}  // namespace gl
+
+#endif  // LIBANGLE_NAMELOOKUPTABLE_H_
@@ -0,0 +1,84 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Unit tests for NameLookupTable.
+//
+
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "libANGLE/NameLookupTable.h"
+
+namespace
+{
+
+// Test that inserted names are found, and that the first value given for a name is kept.
+TEST(NameLookupTableTest, InsertAndFind)
+{
+    gl::NameLookupTable table;
+    unsigned int value = 0;
+    EXPECT_FALSE(table.find("a", &value));
+
+    table.insert("a", 1);
+    table.insert("b.c", 2);
+    table.insert("a", 3);
+    EXPECT_EQ(2u, table.size());
+
+    ASSERT_TRUE(table.find("a", &value));
+    EXPECT_EQ(1u, value);
+    ASSERT_TRUE(table.find("b.c", &value));
+    EXPECT_EQ(2u, value);
+    EXPECT_FALSE(table.find("b", &value));
+    EXPECT_FALSE(table.find("", &value));
+
+    table.clear();
+    EXPECT_EQ(0u, table.size());
+    EXPECT_FALSE(table.find("a", &value));
+}
+
+// Test looking up the start of a string, as is done for names with an array subscript.
+TEST(NameLookupTableTest, FindPrefix)
+{
+    gl::NameLookupTable table;
+    table.insert("color", 4);
+    table.insert("colors", 5);
+
+    const std::string name = "colors[2]";
+    unsigned int value     = 0;
+    ASSERT_TRUE(table.find(name.c_str(), 6, &value));
+    EXPECT_EQ(5u, value);
+    ASSERT_TRUE(table.find(name.c_str(), 5, &value));
+    EXPECT_EQ(4u, value);
+    EXPECT_FALSE(table.find(name.c_str(), 4, &value));
+}
+
+// Test that the table keeps every name as it grows.
+TEST(NameLookupTableTest, ManyNames)
+{
+    const unsigned int kNameCount = 1000;
+
+    gl::NameLookupTable table;
+    for (unsigned int index = 0; index < kNameCount; ++index)
+    {
+        std::stringstream name;
+        name << "u" << index;
+        table.insert(name.str(), index);
+    }
+    EXPECT_EQ(kNameCount, table.size());
+
+    for (unsigned int index = 0; index < kNameCount; ++index)
+    {
+        std::stringstream name;
+        name << "u" << index;
+        unsigned int value = 0;
+        ASSERT_TRUE(table.find(name.str(), &value));
+        EXPECT_EQ(index, value);
+    }
+    unsigned int value = 0;
+    EXPECT_FALSE(table.find("u1000", &value));
+}
+
+}  // anonymous namespace
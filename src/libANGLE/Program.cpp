@@ -10,6 +10,10 @@
 #include "libANGLE/Program.h"
 
 #include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include "common/BitSetIterator.h"
 #include "common/debug.h"
@@ -31,27 +35,175 @@ namespace gl
 namespace
 {
 
-void WriteShaderVar(BinaryOutputStream *stream, const sh::ShaderVariable &var)
+// The front-end part of a program binary stores its variables as arrays of fixed-layout records
+// with their strings in a single table, so that loading reads them in place instead of one field
+// at a time. Bump the version whenever the records change.
+const uint32_t kProgramBinaryFormatVersion = 1;
+
+// A range of the string table.
+struct BinaryString
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct BinaryShaderVariable
+{
+    uint32_t type;
+    uint32_t precision;
+    BinaryString name;
+    BinaryString mappedName;
+    BinaryString structName;
+    uint32_t arraySize;
+    uint32_t staticUse;
+};
+
+struct BinaryAttribute
+{
+    BinaryShaderVariable variable;
+    int32_t location;
+};
+
+struct BinaryUniform
+{
+    BinaryShaderVariable variable;
+    int32_t blockIndex;
+    int32_t offset;
+    int32_t arrayStride;
+    int32_t matrixStride;
+    uint32_t isRowMajorMatrix;
+};
+
+// The name of a used location is the name of its uniform, so it isn't stored.
+struct BinaryUniformLocation
+{
+    uint32_t element;
+    uint32_t index;
+    uint32_t used;
+    uint32_t ignored;
+};
+
+// The member uniform indices of all the blocks are stored in one array.
+struct BinaryUniformBlock
+{
+    BinaryString name;
+    uint32_t isArray;
+    uint32_t arrayElement;
+    uint32_t dataSize;
+    uint32_t vertexStaticUse;
+    uint32_t fragmentStaticUse;
+    uint32_t firstMember;
+    uint32_t memberCount;
+};
+
+struct BinaryTransformFeedbackVarying
+{
+    BinaryString name;
+    uint32_t type;
+    uint32_t arraySize;
+};
+
+struct BinaryOutputVariable
+{
+    int32_t location;
+    uint32_t element;
+    uint32_t index;
+    BinaryString name;
+};
+
+// writeRecords copies records byte for byte, so any padding would put uninitialized bytes in the
+// binary. Records are value-initialized before they are filled in, and must stay free of padding.
+static_assert(sizeof(BinaryString) == 2 * sizeof(uint32_t), "BinaryString must not have padding.");
+static_assert(sizeof(BinaryShaderVariable) == 4 * sizeof(uint32_t) + 3 * sizeof(BinaryString),
+              "BinaryShaderVariable must not have padding.");
+static_assert(sizeof(BinaryAttribute) == sizeof(BinaryShaderVariable) + sizeof(int32_t),
+              "BinaryAttribute must not have padding.");
+static_assert(sizeof(BinaryUniform) == sizeof(BinaryShaderVariable) + 5 * sizeof(int32_t),
+              "BinaryUniform must not have padding.");
+static_assert(sizeof(BinaryUniformLocation) == 4 * sizeof(uint32_t),
+              "BinaryUniformLocation must not have padding.");
+static_assert(sizeof(BinaryUniformBlock) == sizeof(BinaryString) + 7 * sizeof(uint32_t),
+              "BinaryUniformBlock must not have padding.");
+static_assert(sizeof(BinaryTransformFeedbackVarying) == sizeof(BinaryString) + 2 * sizeof(uint32_t),
+              "BinaryTransformFeedbackVarying must not have padding.");
+static_assert(sizeof(BinaryOutputVariable) == 3 * sizeof(uint32_t) + sizeof(BinaryString),
+              "BinaryOutputVariable must not have padding.");
+
+class BinaryStringTableWriter final : angle::NonCopyable
+{
+  public:
+    BinaryString add(const std::string &value)
+    {
+        BinaryString string = {};
+        string.offset = static_cast<uint32_t>(mData.length());
+        string.length = static_cast<uint32_t>(value.length());
+        mData.append(value);
+        return string;
+    }
+
+    void write(BinaryOutputStream *stream) const
+    {
+        stream->writeInt(mData.length());
+        stream->writeBytes(reinterpret_cast<const unsigned char *>(mData.c_str()), mData.length());
+    }
+
+  private:
+    std::string mData;
+};
+
+class BinaryStringTableReader final : angle::NonCopyable
+{
+  public:
+    BinaryStringTableReader(BinaryInputStream *stream)
+    {
+        mLength = stream->readInt<size_t>();
+        mData   = reinterpret_cast<const char *>(stream->readInPlace(mLength));
+    }
+
+    // Returns false if the string is outside of the table.
+    bool read(const BinaryString &string, std::string *valueOut) const
+    {
+        if (mData == nullptr || string.offset > mLength || string.length > mLength - string.offset)
+        {
+            return false;
+        }
+
+        valueOut->assign(mData + string.offset, string.length);
+        return true;
+    }
+
+  private:
+    const char *mData;
+    size_t mLength;
+};
+
+BinaryShaderVariable WriteBinaryShaderVariable(const sh::ShaderVariable &var,
+                                               BinaryStringTableWriter *strings)
 {
-    stream->writeInt(var.type);
-    stream->writeInt(var.precision);
-    stream->writeString(var.name);
-    stream->writeString(var.mappedName);
-    stream->writeInt(var.arraySize);
-    stream->writeInt(var.staticUse);
-    stream->writeString(var.structName);
     ASSERT(var.fields.empty());
+
+    BinaryShaderVariable binary = {};
+    binary.type       = var.type;
+    binary.precision  = var.precision;
+    binary.name       = strings->add(var.name);
+    binary.mappedName = strings->add(var.mappedName);
+    binary.structName = strings->add(var.structName);
+    binary.arraySize  = var.arraySize;
+    binary.staticUse  = var.staticUse;
+    return binary;
 }
 
-void LoadShaderVar(BinaryInputStream *stream, sh::ShaderVariable *var)
+bool LoadBinaryShaderVariable(const BinaryShaderVariable &binary,
+                              const BinaryStringTableReader &strings,
+                              sh::ShaderVariable *var)
 {
-    var->type       = stream->readInt<GLenum>();
-    var->precision  = stream->readInt<GLenum>();
-    var->name       = stream->readString();
-    var->mappedName = stream->readString();
-    var->arraySize  = stream->readInt<unsigned int>();
-    var->staticUse  = stream->readBool();
-    var->structName = stream->readString();
+    var->type      = binary.type;
+    var->precision = binary.precision;
+    var->arraySize = binary.arraySize;
+    var->staticUse = (binary.staticUse != 0);
+    return strings.read(binary.name, &var->name) &&
+           strings.read(binary.mappedName, &var->mappedName) &&
+           strings.read(binary.structName, &var->structName);
 }
 
 // This simplified cast function doesn't need to worry about advanced concepts like
@@ -124,16 +276,45 @@ void UniformStateQueryCastLoop(DestT *dataOut, const uint8_t *srcPointer, int co
     }
 }
 
-bool UniformInList(const std::vector<LinkedUniform> &list, const std::string &name)
+// A name in the string pool of a shader reflection, or in a string, that keys the maps below
+// without being copied out.
+struct PooledName
 {
-    for (const LinkedUniform &uniform : list)
+    PooledName(const sh::ShaderReflection &reflection, sh::ShaderReflection::StringRange range)
+        : data(reflection.strings.data() + range.offset), length(range.length)
     {
-        if (uniform.name == name)
-            return true;
     }
+    explicit PooledName(const std::string &str) : data(str.data()), length(str.length()) {}
 
-    return false;
-}
+    const char *data;
+    size_t length;
+};
+
+struct PooledNameHash
+{
+    size_t operator()(const PooledName &name) const
+    {
+        // FNV-1a
+        size_t hash = 2166136261u;
+        for (size_t index = 0; index < name.length; ++index)
+        {
+            hash = (hash ^ static_cast<unsigned char>(name.data[index])) * 16777619u;
+        }
+        return hash;
+    }
+};
+
+struct PooledNameEqual
+{
+    bool operator()(const PooledName &a, const PooledName &b) const
+    {
+        return a.length == b.length && memcmp(a.data, b.data, a.length) == 0;
+    }
+};
+
+template <typename T>
+using PooledNameMap = std::unordered_map<PooledName, T, PooledNameHash, PooledNameEqual>;
+using PooledNameSet = std::unordered_set<PooledName, PooledNameHash, PooledNameEqual>;
 
 }  // anonymous namespace
 
@@ -269,59 +450,51 @@ const std::string &ProgramState::getLabel()
 
 const LinkedUniform *ProgramState::getUniformByName(const std::string &name) const
 {
-    for (const LinkedUniform &linkedUniform : mUniforms)
+    unsigned int uniformIndex = 0;
+    if (!mUniformIndicesByName.find(name, &uniformIndex))
     {
-        if (linkedUniform.name == name)
-        {
-            return &linkedUniform;
-        }
+        return nullptr;
     }
 
-    return nullptr;
+    return &mUniforms[uniformIndex];
 }
 
 GLint ProgramState::getUniformLocation(const std::string &name) const
 {
-    size_t subscript     = GL_INVALID_INDEX;
-    std::string baseName = ParseUniformName(name, &subscript);
+    size_t nameLength = 0;
+    size_t subscript  = ParseArrayIndex(name, &nameLength);
 
-    for (size_t location = 0; location < mUniformLocations.size(); ++location)
+    unsigned int uniformIndex = 0;
+    if (!mUniformIndicesByName.find(name.c_str(), nameLength, &uniformIndex))
     {
-        const VariableLocation &uniformLocation = mUniformLocations[location];
-        if (!uniformLocation.used)
-        {
-            continue;
-        }
+        return -1;
+    }
 
-        const LinkedUniform &uniform = mUniforms[uniformLocation.index];
+    // Uniform block members have no location.
+    const LinkedUniform &uniform = mUniforms[uniformIndex];
+    if (!uniform.isInDefaultBlock())
+    {
+        return -1;
+    }
 
-        if (uniform.name == baseName)
+    // Without a subscript, the name of an array refers to its first element.
+    size_t element = 0;
+    if (subscript != GL_INVALID_INDEX)
+    {
+        if (!uniform.isArray() || subscript >= uniform.elementCount())
         {
-            if (uniform.isArray())
-            {
-                if (uniformLocation.element == subscript ||
-                    (uniformLocation.element == 0 && subscript == GL_INVALID_INDEX))
-                {
-                    return static_cast<GLint>(location);
-                }
-            }
-            else
-            {
-                if (subscript == GL_INVALID_INDEX)
-                {
-                    return static_cast<GLint>(location);
-                }
-            }
+            return -1;
         }
+        element = subscript;
     }
 
-    return -1;
+    return mUniformElementLocations[mUniformElementOffsets[uniformIndex] + element];
 }
 
 GLuint ProgramState::getUniformIndex(const std::string &name) const
 {
-    size_t subscript     = GL_INVALID_INDEX;
-    std::string baseName = ParseUniformName(name, &subscript);
+    size_t nameLength = 0;
+    size_t subscript  = ParseArrayIndex(name, &nameLength);
 
     // The app is not allowed to specify array indices other than 0 for arrays of basic types
     if (subscript != 0 && subscript != GL_INVALID_INDEX)
@@ -329,19 +502,79 @@ GLuint ProgramState::getUniformIndex(const std::string &name) const
         return GL_INVALID_INDEX;
     }
 
-    for (size_t index = 0; index < mUniforms.size(); index++)
+    unsigned int uniformIndex = 0;
+    if (!mUniformIndicesByName.find(name.c_str(), nameLength, &uniformIndex))
+    {
+        return GL_INVALID_INDEX;
+    }
+
+    if (mUniforms[uniformIndex].isArray() || subscript == GL_INVALID_INDEX)
+    {
+        return uniformIndex;
+    }
+
+    return GL_INVALID_INDEX;
+}
+
+void ProgramState::updateNameLookupTables()
+{
+    clearNameLookupTables();
+
+    for (const sh::Attribute &attribute : mAttributes)
     {
-        const LinkedUniform &uniform = mUniforms[index];
-        if (uniform.name == baseName)
+        if (attribute.staticUse)
         {
-            if (uniform.isArray() || subscript == GL_INVALID_INDEX)
-            {
-                return static_cast<GLuint>(index);
-            }
+            mAttributeLocationsByName.insert(attribute.name,
+                                             static_cast<unsigned int>(attribute.location));
         }
     }
 
-    return GL_INVALID_INDEX;
+    size_t elementCount = 0;
+    mUniformElementOffsets.reserve(mUniforms.size());
+    for (size_t uniformIndex = 0; uniformIndex < mUniforms.size(); ++uniformIndex)
+    {
+        const LinkedUniform &uniform = mUniforms[uniformIndex];
+        mUniformIndicesByName.insert(uniform.name, static_cast<unsigned int>(uniformIndex));
+        mUniformElementOffsets.push_back(elementCount);
+        if (uniform.isInDefaultBlock())
+        {
+            elementCount += uniform.elementCount();
+        }
+    }
+
+    mUniformElementLocations.assign(elementCount, -1);
+    for (size_t location = 0; location < mUniformLocations.size(); ++location)
+    {
+        const VariableLocation &uniformLocation = mUniformLocations[location];
+        if (!uniformLocation.used)
+        {
+            continue;
+        }
+
+        ASSERT(uniformLocation.element < mUniforms[uniformLocation.index].elementCount());
+        GLint &elementLocation =
+            mUniformElementLocations[mUniformElementOffsets[uniformLocation.index] +
+                                     uniformLocation.element];
+        if (elementLocation == -1)
+        {
+            elementLocation = static_cast<GLint>(location);
+        }
+    }
+
+    for (size_t blockIndex = 0; blockIndex < mUniformBlocks.size(); ++blockIndex)
+    {
+        mUniformBlockIndicesByName.insert(mUniformBlocks[blockIndex].name,
+                                          static_cast<unsigned int>(blockIndex));
+    }
+}
+
+void ProgramState::clearNameLookupTables()
+{
+    mAttributeLocationsByName.clear();
+    mUniformIndicesByName.clear();
+    mUniformBlockIndicesByName.clear();
+    mUniformElementOffsets.clear();
+    mUniformElementLocations.clear();
 }
 
 Program::Program(rx::GLImplFactory *factory, ResourceManager *manager, GLuint handle)
@@ -483,7 +716,7 @@ BindingInfo Program::getFragmentInputBindingInfo(GLint index) const
     ASSERT(fragmentShader);
 
     // Find the actual fragment shader varying we're interested in
-    const std::vector<sh::Varying> &inputs = fragmentShader->getVaryings();
+    const sh::ShaderReflection &reflection = fragmentShader->getReflection();
 
     for (const auto &binding : mFragmentInputBindings)
     {
@@ -495,9 +728,9 @@ BindingInfo Program::getFragmentInputBindingInfo(GLint index) const
         std::string originalName = binding.first;
         unsigned int arrayIndex  = ParseAndStripArrayIndex(&originalName);
 
-        for (const auto &in : inputs)
+        for (const auto &in : reflection.varyings)
         {
-            if (in.name == originalName)
+            if (reflection.stringEquals(in.name, originalName))
             {
                 if (in.isArray())
                 {
@@ -509,11 +742,12 @@ BindingInfo Program::getFragmentInputBindingInfo(GLint index) const
                     if (arrayIndex == GL_INVALID_INDEX)
                         arrayIndex = 0;
 
-                    ret.name = in.mappedName + "[" + ToString(arrayIndex) + "]";
+                    ret.name =
+                        reflection.getString(in.mappedName) + "[" + ToString(arrayIndex) + "]";
                 }
                 else
                 {
-                    ret.name = in.mappedName;
+                    ret.name = reflection.getString(in.mappedName);
                 }
                 ret.type = in.type;
                 return ret;
@@ -663,6 +897,7 @@ Error Program::link(const ContextState &data)
     }
 
     gatherInterfaceBlockInfo();
+    mState.updateNameLookupTables();
 
     return NoError();
 }
@@ -699,6 +934,7 @@ void Program::unlink(bool destroy)
     mState.mUniformBlocks.clear();
     mState.mOutputVariables.clear();
     mState.mComputeShaderLocalSize.fill(1);
+    mState.clearNameLookupTables();
 
     mValidated = false;
 
@@ -732,7 +968,8 @@ Error Program::loadBinary(const Context *context,
     unsigned char commitString[ANGLE_COMMIT_HASH_SIZE];
     stream.readBytes(commitString, ANGLE_COMMIT_HASH_SIZE);
     if (memcmp(commitString, ANGLE_COMMIT_HASH, sizeof(unsigned char) * ANGLE_COMMIT_HASH_SIZE) !=
-        0)
+            0 ||
+        stream.readInt<uint32_t>() != kProgramBinaryFormatVersion)
     {
         mInfoLog << "Invalid program binary version.";
         return Error(GL_NO_ERROR);
@@ -755,109 +992,26 @@ Error Program::loadBinary(const Context *context,
                   "Too many vertex attribs for mask");
     mState.mActiveAttribLocationsMask = stream.readInt<unsigned long>();
 
-    unsigned int attribCount = stream.readInt<unsigned int>();
-    ASSERT(mState.mAttributes.empty());
-    for (unsigned int attribIndex = 0; attribIndex < attribCount; ++attribIndex)
-    {
-        sh::Attribute attrib;
-        LoadShaderVar(&stream, &attrib);
-        attrib.location = stream.readInt<int>();
-        mState.mAttributes.push_back(attrib);
-    }
+    bool variablesValid = loadBinaryVariables(&stream);
 
-    unsigned int uniformCount = stream.readInt<unsigned int>();
-    ASSERT(mState.mUniforms.empty());
-    for (unsigned int uniformIndex = 0; uniformIndex < uniformCount; ++uniformIndex)
-    {
-        LinkedUniform uniform;
-        LoadShaderVar(&stream, &uniform);
-
-        uniform.blockIndex                 = stream.readInt<int>();
-        uniform.blockInfo.offset           = stream.readInt<int>();
-        uniform.blockInfo.arrayStride      = stream.readInt<int>();
-        uniform.blockInfo.matrixStride     = stream.readInt<int>();
-        uniform.blockInfo.isRowMajorMatrix = stream.readBool();
-
-        mState.mUniforms.push_back(uniform);
-    }
-
-    const unsigned int uniformIndexCount = stream.readInt<unsigned int>();
-    ASSERT(mState.mUniformLocations.empty());
-    for (unsigned int uniformIndexIndex = 0; uniformIndexIndex < uniformIndexCount;
-         uniformIndexIndex++)
-    {
-        VariableLocation variable;
-        stream.readString(&variable.name);
-        stream.readInt(&variable.element);
-        stream.readInt(&variable.index);
-        stream.readBool(&variable.used);
-        stream.readBool(&variable.ignored);
-
-        mState.mUniformLocations.push_back(variable);
-    }
-
-    unsigned int uniformBlockCount = stream.readInt<unsigned int>();
-    ASSERT(mState.mUniformBlocks.empty());
-    for (unsigned int uniformBlockIndex = 0; uniformBlockIndex < uniformBlockCount;
-         ++uniformBlockIndex)
-    {
-        UniformBlock uniformBlock;
-        stream.readString(&uniformBlock.name);
-        stream.readBool(&uniformBlock.isArray);
-        stream.readInt(&uniformBlock.arrayElement);
-        stream.readInt(&uniformBlock.dataSize);
-        stream.readBool(&uniformBlock.vertexStaticUse);
-        stream.readBool(&uniformBlock.fragmentStaticUse);
-
-        unsigned int numMembers = stream.readInt<unsigned int>();
-        for (unsigned int blockMemberIndex = 0; blockMemberIndex < numMembers; blockMemberIndex++)
-        {
-            uniformBlock.memberUniformIndexes.push_back(stream.readInt<unsigned int>());
-        }
-
-        mState.mUniformBlocks.push_back(uniformBlock);
-    }
-
-    for (GLuint bindingIndex = 0; bindingIndex < mState.mUniformBlockBindings.size();
-         ++bindingIndex)
-    {
-        stream.readInt(&mState.mUniformBlockBindings[bindingIndex]);
-        mState.mActiveUniformBlockBindings.set(bindingIndex,
-                                               mState.mUniformBlockBindings[bindingIndex] != 0);
-    }
+    stream.readInt(&mSamplerUniformRange.start);
+    stream.readInt(&mSamplerUniformRange.end);
 
-    unsigned int transformFeedbackVaryingCount = stream.readInt<unsigned int>();
-    ASSERT(mState.mTransformFeedbackVaryingVars.empty());
-    for (unsigned int transformFeedbackVaryingIndex = 0;
-        transformFeedbackVaryingIndex < transformFeedbackVaryingCount;
-        ++transformFeedbackVaryingIndex)
+    if (!variablesValid || stream.error() ||
+        mSamplerUniformRange.start > mSamplerUniformRange.end ||
+        mSamplerUniformRange.end > mState.mUniforms.size())
     {
-        sh::Varying varying;
-        stream.readInt(&varying.arraySize);
-        stream.readInt(&varying.type);
-        stream.readString(&varying.name);
-
-        mState.mTransformFeedbackVaryingVars.push_back(varying);
+        unlink(false);
+        mInfoLog << "Invalid program binary.";
+        return Error(GL_NO_ERROR);
     }
 
-    stream.readInt(&mState.mTransformFeedbackBufferMode);
-
-    unsigned int outputVarCount = stream.readInt<unsigned int>();
-    for (unsigned int outputIndex = 0; outputIndex < outputVarCount; ++outputIndex)
+    ANGLE_TRY_RESULT(mProgram->load(context->getImplementation(), mInfoLog, &stream), mLinked);
+    if (mLinked)
     {
-        int locationIndex = stream.readInt<int>();
-        VariableLocation locationData;
-        stream.readInt(&locationData.element);
-        stream.readInt(&locationData.index);
-        stream.readString(&locationData.name);
-        mState.mOutputVariables[locationIndex] = locationData;
+        mState.updateNameLookupTables();
     }
 
-    stream.readInt(&mSamplerUniformRange.start);
-    stream.readInt(&mSamplerUniformRange.end);
-
-    ANGLE_TRY_RESULT(mProgram->load(context->getImplementation(), mInfoLog, &stream), mLinked);
-
     return NoError();
 #endif  // #if ANGLE_PROGRAM_BINARY_LOAD == ANGLE_ENABLED
 }
@@ -876,6 +1030,7 @@ Error Program::saveBinary(const Context *context,
     BinaryOutputStream stream;
 
     stream.writeBytes(reinterpret_cast<const unsigned char*>(ANGLE_COMMIT_HASH), ANGLE_COMMIT_HASH_SIZE);
+    stream.writeInt(kProgramBinaryFormatVersion);
 
     // nullptr context is supported when computing binary length.
     if (context)
@@ -895,116 +1050,339 @@ Error Program::saveBinary(const Context *context,
 
     stream.writeInt(mState.mActiveAttribLocationsMask.to_ulong());
 
-    stream.writeInt(mState.mAttributes.size());
-    for (const sh::Attribute &attrib : mState.mAttributes)
+    saveBinaryVariables(&stream);
+
+    stream.writeInt(mSamplerUniformRange.start);
+    stream.writeInt(mSamplerUniformRange.end);
+
+    ANGLE_TRY(mProgram->save(&stream));
+
+    GLsizei streamLength   = static_cast<GLsizei>(stream.length());
+    const void *streamState = stream.data();
+
+    if (streamLength > bufSize)
     {
-        WriteShaderVar(&stream, attrib);
-        stream.writeInt(attrib.location);
+        if (length)
+        {
+            *length = 0;
+        }
+
+        // TODO: This should be moved to the validation layer but computing the size of the binary before saving
+        // it causes the save to happen twice.  It may be possible to write the binary to a separate buffer, validate
+        // sizes and then copy it.
+        return Error(GL_INVALID_OPERATION);
     }
 
-    stream.writeInt(mState.mUniforms.size());
-    for (const LinkedUniform &uniform : mState.mUniforms)
+    if (binary)
     {
-        WriteShaderVar(&stream, uniform);
+        char *ptr = reinterpret_cast<char*>(binary);
 
-        // FIXME: referenced
+        memcpy(ptr, streamState, streamLength);
+        ptr += streamLength;
 
-        stream.writeInt(uniform.blockIndex);
-        stream.writeInt(uniform.blockInfo.offset);
-        stream.writeInt(uniform.blockInfo.arrayStride);
-        stream.writeInt(uniform.blockInfo.matrixStride);
-        stream.writeInt(uniform.blockInfo.isRowMajorMatrix);
+        ASSERT(ptr - streamLength == binary);
     }
 
-    stream.writeInt(mState.mUniformLocations.size());
-    for (const auto &variable : mState.mUniformLocations)
+    if (length)
     {
-        stream.writeString(variable.name);
-        stream.writeInt(variable.element);
-        stream.writeInt(variable.index);
-        stream.writeInt(variable.used);
-        stream.writeInt(variable.ignored);
+        *length = streamLength;
     }
 
-    stream.writeInt(mState.mUniformBlocks.size());
-    for (const UniformBlock &uniformBlock : mState.mUniformBlocks)
-    {
-        stream.writeString(uniformBlock.name);
-        stream.writeInt(uniformBlock.isArray);
-        stream.writeInt(uniformBlock.arrayElement);
-        stream.writeInt(uniformBlock.dataSize);
+    return Error(GL_NO_ERROR);
+}
 
-        stream.writeInt(uniformBlock.vertexStaticUse);
-        stream.writeInt(uniformBlock.fragmentStaticUse);
+void Program::saveBinaryVariables(BinaryOutputStream *stream) const
+{
+    // Gather the records first, since the string table that they refer to goes before them.
+    BinaryStringTableWriter strings;
 
-        stream.writeInt(uniformBlock.memberUniformIndexes.size());
-        for (unsigned int memberUniformIndex : uniformBlock.memberUniformIndexes)
-        {
-            stream.writeInt(memberUniformIndex);
-        }
+    std::vector<BinaryAttribute> attributes;
+    attributes.reserve(mState.mAttributes.size());
+    for (const sh::Attribute &attrib : mState.mAttributes)
+    {
+        BinaryAttribute binary = {};
+        binary.variable = WriteBinaryShaderVariable(attrib, &strings);
+        binary.location = attrib.location;
+        attributes.push_back(binary);
     }
 
-    for (GLuint binding : mState.mUniformBlockBindings)
+    std::vector<BinaryUniform> uniforms;
+    uniforms.reserve(mState.mUniforms.size());
+    for (const LinkedUniform &uniform : mState.mUniforms)
     {
-        stream.writeInt(binding);
+        BinaryUniform binary = {};
+        binary.variable         = WriteBinaryShaderVariable(uniform, &strings);
+        binary.blockIndex       = uniform.blockIndex;
+        binary.offset           = uniform.blockInfo.offset;
+        binary.arrayStride      = uniform.blockInfo.arrayStride;
+        binary.matrixStride     = uniform.blockInfo.matrixStride;
+        binary.isRowMajorMatrix = uniform.blockInfo.isRowMajorMatrix;
+        uniforms.push_back(binary);
     }
 
-    stream.writeInt(mState.mTransformFeedbackVaryingVars.size());
-    for (const sh::Varying &varying : mState.mTransformFeedbackVaryingVars)
+    std::vector<BinaryUniformLocation> uniformLocations;
+    uniformLocations.reserve(mState.mUniformLocations.size());
+    for (const VariableLocation &location : mState.mUniformLocations)
     {
-        stream.writeInt(varying.arraySize);
-        stream.writeInt(varying.type);
-        stream.writeString(varying.name);
+        ASSERT(!location.used || location.name == mState.mUniforms[location.index].name);
+
+        BinaryUniformLocation binary = {};
+        binary.element = location.element;
+        binary.index   = location.index;
+        binary.used    = location.used;
+        binary.ignored = location.ignored;
+        uniformLocations.push_back(binary);
     }
 
-    stream.writeInt(mState.mTransformFeedbackBufferMode);
+    std::vector<BinaryUniformBlock> uniformBlocks;
+    std::vector<uint32_t> uniformBlockMembers;
+    uniformBlocks.reserve(mState.mUniformBlocks.size());
+    for (const UniformBlock &uniformBlock : mState.mUniformBlocks)
+    {
+        BinaryUniformBlock binary = {};
+        binary.name              = strings.add(uniformBlock.name);
+        binary.isArray           = uniformBlock.isArray;
+        binary.arrayElement      = uniformBlock.arrayElement;
+        binary.dataSize          = static_cast<uint32_t>(uniformBlock.dataSize);
+        binary.vertexStaticUse   = uniformBlock.vertexStaticUse;
+        binary.fragmentStaticUse = uniformBlock.fragmentStaticUse;
+        binary.firstMember       = static_cast<uint32_t>(uniformBlockMembers.size());
+        binary.memberCount       = static_cast<uint32_t>(uniformBlock.memberUniformIndexes.size());
+        uniformBlockMembers.insert(uniformBlockMembers.end(),
+                                   uniformBlock.memberUniformIndexes.begin(),
+                                   uniformBlock.memberUniformIndexes.end());
+        uniformBlocks.push_back(binary);
+    }
+
+    std::vector<BinaryTransformFeedbackVarying> transformFeedbackVaryings;
+    transformFeedbackVaryings.reserve(mState.mTransformFeedbackVaryingVars.size());
+    for (const sh::Varying &varying : mState.mTransformFeedbackVaryingVars)
+    {
+        BinaryTransformFeedbackVarying binary = {};
+        binary.name      = strings.add(varying.name);
+        binary.type      = varying.type;
+        binary.arraySize = varying.arraySize;
+        transformFeedbackVaryings.push_back(binary);
+    }
 
-    stream.writeInt(mState.mOutputVariables.size());
+    std::vector<BinaryOutputVariable> outputVariables;
+    outputVariables.reserve(mState.mOutputVariables.size());
     for (const auto &outputPair : mState.mOutputVariables)
     {
-        stream.writeInt(outputPair.first);
-        stream.writeIntOrNegOne(outputPair.second.element);
-        stream.writeInt(outputPair.second.index);
-        stream.writeString(outputPair.second.name);
+        BinaryOutputVariable binary = {};
+        binary.location = outputPair.first;
+        binary.element  = outputPair.second.element;
+        binary.index    = outputPair.second.index;
+        binary.name     = strings.add(outputPair.second.name);
+        outputVariables.push_back(binary);
     }
 
-    stream.writeInt(mSamplerUniformRange.start);
-    stream.writeInt(mSamplerUniformRange.end);
+    strings.write(stream);
+    stream->writeRecords(attributes);
+    stream->writeRecords(uniforms);
+    stream->writeRecords(uniformLocations);
+    stream->writeRecords(uniformBlocks);
+    stream->writeRecords(uniformBlockMembers);
 
-    ANGLE_TRY(mProgram->save(&stream));
+    for (GLuint binding : mState.mUniformBlockBindings)
+    {
+        stream->writeInt(binding);
+    }
 
-    GLsizei streamLength   = static_cast<GLsizei>(stream.length());
-    const void *streamState = stream.data();
+    stream->writeRecords(transformFeedbackVaryings);
+    stream->writeInt(mState.mTransformFeedbackBufferMode);
+    stream->writeRecords(outputVariables);
+}
 
-    if (streamLength > bufSize)
+// The records aren't aligned in the stream, so each one is copied out before use, and every
+// variable is rebuilt with its strings here. The back-ends read this reflection as soon as they
+// load their part of the binary, so names and fields are not created lazily on first query.
+// TODO: Build the reflection lazily once the back-ends no longer need it at load time.
+bool Program::loadBinaryVariables(BinaryInputStream *stream)
+{
+    const BinaryStringTableReader strings(stream);
+
+    size_t attribCount        = 0;
+    const uint8_t *attributes = stream->readRecords<BinaryAttribute>(&attribCount);
+    ASSERT(mState.mAttributes.empty());
+    mState.mAttributes.resize(attribCount);
+    for (size_t attribIndex = 0; attribIndex < attribCount; ++attribIndex)
     {
-        if (length)
+        const auto binary = BinaryInputStream::GetRecord<BinaryAttribute>(attributes, attribIndex);
+        sh::Attribute &attrib = mState.mAttributes[attribIndex];
+        if (!LoadBinaryShaderVariable(binary.variable, strings, &attrib))
         {
-            *length = 0;
+            return false;
         }
+        attrib.location = binary.location;
+    }
 
-        // TODO: This should be moved to the validation layer but computing the size of the binary before saving
-        // it causes the save to happen twice.  It may be possible to write the binary to a separate buffer, validate
-        // sizes and then copy it.
-        return Error(GL_INVALID_OPERATION);
+    size_t uniformCount     = 0;
+    const uint8_t *uniforms = stream->readRecords<BinaryUniform>(&uniformCount);
+    ASSERT(mState.mUniforms.empty());
+    mState.mUniforms.resize(uniformCount);
+    for (size_t uniformIndex = 0; uniformIndex < uniformCount; ++uniformIndex)
+    {
+        const auto binary = BinaryInputStream::GetRecord<BinaryUniform>(uniforms, uniformIndex);
+        LinkedUniform &uniform = mState.mUniforms[uniformIndex];
+        if (!LoadBinaryShaderVariable(binary.variable, strings, &uniform))
+        {
+            return false;
+        }
+        uniform.blockIndex                 = binary.blockIndex;
+        uniform.blockInfo.offset           = binary.offset;
+        uniform.blockInfo.arrayStride      = binary.arrayStride;
+        uniform.blockInfo.matrixStride     = binary.matrixStride;
+        uniform.blockInfo.isRowMajorMatrix = (binary.isRowMajorMatrix != 0);
     }
 
-    if (binary)
+    size_t locationCount            = 0;
+    const uint8_t *uniformLocations = stream->readRecords<BinaryUniformLocation>(&locationCount);
+    ASSERT(mState.mUniformLocations.empty());
+    mState.mUniformLocations.resize(locationCount);
+    for (size_t locationIndex = 0; locationIndex < locationCount; ++locationIndex)
+    {
+        const auto binary =
+            BinaryInputStream::GetRecord<BinaryUniformLocation>(uniformLocations, locationIndex);
+        VariableLocation &location = mState.mUniformLocations[locationIndex];
+        location.element           = binary.element;
+        location.index             = binary.index;
+        location.used              = (binary.used != 0);
+        location.ignored           = (binary.ignored != 0);
+        if (location.used)
+        {
+            if (location.index >= uniformCount ||
+                location.element >= mState.mUniforms[location.index].elementCount())
+            {
+                return false;
+            }
+            location.name = mState.mUniforms[location.index].name;
+        }
+    }
+
+    // Every element of a default-block uniform has a location, except in the built-ins.
+    size_t elementCount = 0;
+    for (const LinkedUniform &uniform : mState.mUniforms)
     {
-        char *ptr = reinterpret_cast<char*>(binary);
+        if (uniform.isInDefaultBlock())
+        {
+            if (uniform.elementCount() > locationCount + uniformCount - elementCount)
+            {
+                return false;
+            }
+            elementCount += uniform.elementCount();
+        }
+    }
 
-        memcpy(ptr, streamState, streamLength);
-        ptr += streamLength;
+    size_t blockCount            = 0;
+    const uint8_t *uniformBlocks = stream->readRecords<BinaryUniformBlock>(&blockCount);
+    size_t memberCount           = 0;
+    const uint8_t *blockMembers  = stream->readRecords<uint32_t>(&memberCount);
+    ASSERT(mState.mUniformBlocks.empty());
+    mState.mUniformBlocks.resize(blockCount);
+    for (size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex)
+    {
+        const auto binary =
+            BinaryInputStream::GetRecord<BinaryUniformBlock>(uniformBlocks, blockIndex);
+        UniformBlock &uniformBlock = mState.mUniformBlocks[blockIndex];
+        if (!strings.read(binary.name, &uniformBlock.name) || binary.firstMember > memberCount ||
+            binary.memberCount > memberCount - binary.firstMember)
+        {
+            return false;
+        }
+        uniformBlock.isArray           = (binary.isArray != 0);
+        uniformBlock.arrayElement      = binary.arrayElement;
+        uniformBlock.dataSize          = binary.dataSize;
+        uniformBlock.vertexStaticUse   = (binary.vertexStaticUse != 0);
+        uniformBlock.fragmentStaticUse = (binary.fragmentStaticUse != 0);
 
-        ASSERT(ptr - streamLength == binary);
+        uniformBlock.memberUniformIndexes.resize(binary.memberCount);
+        for (uint32_t memberIndex = 0; memberIndex < binary.memberCount; ++memberIndex)
+        {
+            uint32_t uniformIndex = BinaryInputStream::GetRecord<uint32_t>(
+                blockMembers, binary.firstMember + memberIndex);
+            if (uniformIndex >= uniformCount)
+            {
+                return false;
+            }
+            uniformBlock.memberUniformIndexes[memberIndex] = uniformIndex;
+        }
     }
 
-    if (length)
+    // -1 is the default block.
+    for (const LinkedUniform &uniform : mState.mUniforms)
     {
-        *length = streamLength;
+        if (uniform.blockIndex < -1 || uniform.blockIndex >= static_cast<int>(blockCount))
+        {
+            return false;
+        }
     }
 
-    return Error(GL_NO_ERROR);
+    for (GLuint bindingIndex = 0; bindingIndex < mState.mUniformBlockBindings.size();
+         ++bindingIndex)
+    {
+        stream->readInt(&mState.mUniformBlockBindings[bindingIndex]);
+        mState.mActiveUniformBlockBindings.set(bindingIndex,
+                                               mState.mUniformBlockBindings[bindingIndex] != 0);
+    }
+
+    size_t varyingCount = 0;
+    const uint8_t *transformFeedbackVaryings =
+        stream->readRecords<BinaryTransformFeedbackVarying>(&varyingCount);
+    ASSERT(mState.mTransformFeedbackVaryingVars.empty());
+    mState.mTransformFeedbackVaryingVars.resize(varyingCount);
+    for (size_t varyingIndex = 0; varyingIndex < varyingCount; ++varyingIndex)
+    {
+        const auto binary = BinaryInputStream::GetRecord<BinaryTransformFeedbackVarying>(
+            transformFeedbackVaryings, varyingIndex);
+        sh::Varying &varying = mState.mTransformFeedbackVaryingVars[varyingIndex];
+        if (!strings.read(binary.name, &varying.name))
+        {
+            return false;
+        }
+        varying.type      = binary.type;
+        varying.arraySize = binary.arraySize;
+    }
+
+    stream->readInt(&mState.mTransformFeedbackBufferMode);
+
+    // Each location of an output variable has a record, and the records of an array share the
+    // index of the variable in the fragment shader, so there are at least as many records as
+    // variables.
+    size_t outputCount             = 0;
+    const uint8_t *outputVariables = stream->readRecords<BinaryOutputVariable>(&outputCount);
+    std::vector<const std::string *> outputNamesByIndex(outputCount, nullptr);
+    ASSERT(mState.mOutputVariables.empty());
+    for (size_t outputIndex = 0; outputIndex < outputCount; ++outputIndex)
+    {
+        const auto binary =
+            BinaryInputStream::GetRecord<BinaryOutputVariable>(outputVariables, outputIndex);
+        if (binary.location < 0 || binary.index >= outputCount ||
+            mState.mOutputVariables.count(binary.location) != 0)
+        {
+            return false;
+        }
+
+        VariableLocation &locationData = mState.mOutputVariables[binary.location];
+        locationData.element           = binary.element;
+        locationData.index             = binary.index;
+        if (!strings.read(binary.name, &locationData.name))
+        {
+            return false;
+        }
+
+        const std::string *&variableName = outputNamesByIndex[binary.index];
+        if (variableName == nullptr)
+        {
+            variableName = &locationData.name;
+        }
+        else if (*variableName != locationData.name)
+        {
+            return false;
+        }
+    }
+
+    return !stream->error();
 }
 
 GLint Program::getBinaryLength() const
@@ -1100,15 +1478,13 @@ void Program::getAttachedShaders(GLsizei maxCount, GLsizei *count, GLuint *shade
 
 GLuint Program::getAttributeLocation(const std::string &name) const
 {
-    for (const sh::Attribute &attribute : mState.mAttributes)
+    unsigned int location = 0;
+    if (!mState.mAttributeLocationsByName.find(name, &location))
     {
-        if (attribute.name == name && attribute.staticUse)
-        {
-            return attribute.location;
-        }
+        return static_cast<GLuint>(-1);
     }
 
-    return static_cast<GLuint>(-1);
+    return location;
 }
 
 bool Program::isAttribLocationActive(size_t attribLocation) const
@@ -1667,26 +2043,32 @@ GLint Program::getActiveUniformBlockMaxLength() const
 
 GLuint Program::getUniformBlockIndex(const std::string &name) const
 {
-    size_t subscript     = GL_INVALID_INDEX;
-    std::string baseName = ParseUniformName(name, &subscript);
+    size_t nameLength = 0;
+    size_t subscript  = ParseArrayIndex(name, &nameLength);
 
-    unsigned int numUniformBlocks = static_cast<unsigned int>(mState.mUniformBlocks.size());
-    for (unsigned int blockIndex = 0; blockIndex < numUniformBlocks; blockIndex++)
+    unsigned int firstBlockIndex = 0;
+    if (!mState.mUniformBlockIndicesByName.find(name.c_str(), nameLength, &firstBlockIndex))
     {
-        const UniformBlock &uniformBlock = mState.mUniformBlocks[blockIndex];
-        if (uniformBlock.name == baseName)
-        {
-            const bool arrayElementZero =
-                (subscript == GL_INVALID_INDEX &&
-                 (!uniformBlock.isArray || uniformBlock.arrayElement == 0));
-            if (subscript == uniformBlock.arrayElement || arrayElementZero)
-            {
-                return blockIndex;
-            }
-        }
+        return GL_INVALID_INDEX;
     }
 
-    return GL_INVALID_INDEX;
+    // The elements of an array of blocks are consecutive and share its name. Without a subscript,
+    // the name refers to the first element.
+    const size_t element    = (subscript == GL_INVALID_INDEX ? 0 : subscript);
+    const size_t blockIndex = firstBlockIndex + element;
+    if (blockIndex >= mState.mUniformBlocks.size())
+    {
+        return GL_INVALID_INDEX;
+    }
+
+    const UniformBlock &uniformBlock = mState.mUniformBlocks[blockIndex];
+    if (uniformBlock.arrayElement != element ||
+        uniformBlock.name.compare(0, std::string::npos, name, 0, nameLength) != 0)
+    {
+        return GL_INVALID_INDEX;
+    }
+
+    return static_cast<GLuint>(blockIndex);
 }
 
 const UniformBlock &Program::getUniformBlockByIndex(GLuint index) const
@@ -1795,41 +2177,50 @@ bool Program::linkVaryings(InfoLog &infoLog,
 {
     ASSERT(vertexShader->getShaderVersion() == fragmentShader->getShaderVersion());
 
-    const std::vector<sh::Varying> &vertexVaryings   = vertexShader->getVaryings();
-    const std::vector<sh::Varying> &fragmentVaryings = fragmentShader->getVaryings();
+    const sh::ShaderReflection &vertexReflection   = vertexShader->getReflection();
+    const sh::ShaderReflection &fragmentReflection = fragmentShader->getReflection();
 
     std::map<GLuint, std::string> staticFragmentInputLocations;
 
-    for (const sh::Varying &output : fragmentVaryings)
+    // Index the vertex outputs by name so that matching the fragment inputs is linear.
+    PooledNameMap<const sh::ShaderReflection::Variable *> vertexVaryingsByName;
+    vertexVaryingsByName.reserve(vertexReflection.varyings.size());
+    for (const sh::ShaderReflection::Variable &input : vertexReflection.varyings)
+    {
+        vertexVaryingsByName.insert(
+            std::make_pair(PooledName(vertexReflection, input.name), &input));
+    }
+
+    for (const sh::ShaderReflection::Variable &output : fragmentReflection.varyings)
     {
         bool matched = false;
 
         // Built-in varyings obey special rules
-        if (output.isBuiltIn())
+        if (fragmentReflection.isBuiltIn(output))
         {
             continue;
         }
 
-        for (const sh::Varying &input : vertexVaryings)
+        auto input = vertexVaryingsByName.find(PooledName(fragmentReflection, output.name));
+        if (input != vertexVaryingsByName.end())
         {
-            if (output.name == input.name)
+            ASSERT(!vertexReflection.isBuiltIn(*input->second));
+            if (!linkValidateVaryings(infoLog, fragmentReflection.getString(output.name),
+                                      VariableRecord(vertexReflection, *input->second),
+                                      VariableRecord(fragmentReflection, output),
+                                      vertexShader->getShaderVersion()))
             {
-                ASSERT(!input.isBuiltIn());
-                if (!linkValidateVaryings(infoLog, output.name, input, output,
-                                          vertexShader->getShaderVersion()))
-                {
-                    return false;
-                }
-
-                matched = true;
-                break;
+                return false;
             }
+
+            matched = true;
         }
 
         // We permit unmatched, unreferenced varyings
         if (!matched && output.staticUse)
         {
-            infoLog << "Fragment varying " << output.name << " does not match any vertex varying";
+            infoLog << "Fragment varying " << fragmentReflection.getString(output.name)
+                    << " does not match any vertex varying";
             return false;
         }
 
@@ -1837,21 +2228,22 @@ bool Program::linkVaryings(InfoLog &infoLog,
         // If more than one binding refer statically to the same
         // location the link must fail.
 
-        if (!output.staticUse)
+        if (!output.staticUse || mFragmentInputBindings.begin() == mFragmentInputBindings.end())
             continue;
 
-        const auto inputBinding = mFragmentInputBindings.getBinding(output.name);
+        const std::string outputName = fragmentReflection.getString(output.name);
+        const auto inputBinding      = mFragmentInputBindings.getBinding(outputName);
         if (inputBinding == -1)
             continue;
 
         const auto it = staticFragmentInputLocations.find(inputBinding);
         if (it == std::end(staticFragmentInputLocations))
         {
-            staticFragmentInputLocations.insert(std::make_pair(inputBinding, output.name));
+            staticFragmentInputLocations.insert(std::make_pair(inputBinding, outputName));
         }
         else
         {
-            infoLog << "Binding for fragment input " << output.name << " conflicts with "
+            infoLog << "Binding for fragment input " << outputName << " conflicts with "
                     << it->second;
             return false;
         }
@@ -1865,24 +2257,26 @@ bool Program::linkVaryings(InfoLog &infoLog,
 bool Program::validateVertexAndFragmentUniforms(InfoLog &infoLog) const
 {
     // Check that uniforms defined in the vertex and fragment shaders are identical
-    std::map<std::string, LinkedUniform> linkedUniforms;
-    const std::vector<sh::Uniform> &vertexUniforms = mState.mAttachedVertexShader->getUniforms();
-    const std::vector<sh::Uniform> &fragmentUniforms =
-        mState.mAttachedFragmentShader->getUniforms();
+    const sh::ShaderReflection &vertexReflection = mState.mAttachedVertexShader->getReflection();
+    const sh::ShaderReflection &fragmentReflection =
+        mState.mAttachedFragmentShader->getReflection();
 
-    for (const sh::Uniform &vertexUniform : vertexUniforms)
+    PooledNameMap<const sh::ShaderReflection::Variable *> linkedUniforms;
+    linkedUniforms.reserve(vertexReflection.uniforms.size());
+    for (const sh::ShaderReflection::Variable &vertexUniform : vertexReflection.uniforms)
     {
-        linkedUniforms[vertexUniform.name] = LinkedUniform(vertexUniform);
+        linkedUniforms[PooledName(vertexReflection, vertexUniform.name)] = &vertexUniform;
     }
 
-    for (const sh::Uniform &fragmentUniform : fragmentUniforms)
+    for (const sh::ShaderReflection::Variable &fragmentUniform : fragmentReflection.uniforms)
     {
-        auto entry = linkedUniforms.find(fragmentUniform.name);
+        auto entry = linkedUniforms.find(PooledName(fragmentReflection, fragmentUniform.name));
         if (entry != linkedUniforms.end())
         {
-            LinkedUniform *vertexUniform   = &entry->second;
-            const std::string &uniformName = "uniform '" + vertexUniform->name + "'";
-            if (!linkValidateUniforms(infoLog, uniformName, *vertexUniform, fragmentUniform))
+            const VariableRecord vertexUniform(vertexReflection, *entry->second);
+            const std::string &uniformName = "uniform '" + vertexUniform.getName() + "'";
+            if (!linkValidateUniforms(infoLog, uniformName, vertexUniform,
+                                      VariableRecord(fragmentReflection, fragmentUniform)))
             {
                 return false;
             }
@@ -2010,8 +2404,8 @@ bool Program::indexUniforms(InfoLog &infoLog, const Caps &caps, const Bindings &
 
 bool Program::linkValidateInterfaceBlockFields(InfoLog &infoLog,
                                                const std::string &uniformName,
-                                               const sh::InterfaceBlockField &vertexUniform,
-                                               const sh::InterfaceBlockField &fragmentUniform)
+                                               const VariableRecord &vertexUniform,
+                                               const VariableRecord &fragmentUniform)
 {
     // We don't validate precision on UBO fields. See resolution of Khronos bug 10287.
     if (!linkValidateVariablesBase(infoLog, uniformName, vertexUniform, fragmentUniform, false))
@@ -2019,7 +2413,7 @@ bool Program::linkValidateInterfaceBlockFields(InfoLog &infoLog,
         return false;
     }
 
-    if (vertexUniform.isRowMajorLayout != fragmentUniform.isRowMajorLayout)
+    if (vertexUniform.variable->isRowMajorLayout != fragmentUniform.variable->isRowMajorLayout)
     {
         infoLog << "Matrix packings for " << uniformName << " differ between vertex and fragment shaders";
         return false;
@@ -2034,8 +2428,8 @@ bool Program::linkAttributes(const ContextState &data, InfoLog &infoLog)
     const auto *vertexShader = mState.getAttachedVertexShader();
 
     unsigned int usedLocations = 0;
-    mState.mAttributes         = vertexShader->getActiveAttributes();
     GLuint maxAttribs          = data.getCaps().maxVertexAttributes;
+    vertexShader->getReflection().getAttributes(&mState.mAttributes);
 
     // TODO(jmadill): handle aliasing robustly
     if (mState.mAttributes.size() > maxAttribs)
@@ -2135,12 +2529,12 @@ bool Program::linkAttributes(const ContextState &data, InfoLog &infoLog)
 }
 
 bool Program::validateUniformBlocksCount(GLuint maxUniformBlocks,
-                                         const std::vector<sh::InterfaceBlock> &intefaceBlocks,
+                                         const sh::ShaderReflection &reflection,
                                          const std::string &errorMessage,
                                          InfoLog &infoLog) const
 {
     GLuint blockCount = 0;
-    for (const sh::InterfaceBlock &block : intefaceBlocks)
+    for (const sh::ShaderReflection::Block &block : reflection.interfaceBlocks)
     {
         if (block.staticUse || block.layout != sh::BLOCKLAYOUT_PACKED)
         {
@@ -2155,26 +2549,30 @@ bool Program::validateUniformBlocksCount(GLuint maxUniformBlocks,
 }
 
 bool Program::validateVertexAndFragmentInterfaceBlocks(
-    const std::vector<sh::InterfaceBlock> &vertexInterfaceBlocks,
-    const std::vector<sh::InterfaceBlock> &fragmentInterfaceBlocks,
+    const sh::ShaderReflection &vertexReflection,
+    const sh::ShaderReflection &fragmentReflection,
     InfoLog &infoLog) const
 {
     // Check that interface blocks defined in the vertex and fragment shaders are identical
-    typedef std::map<std::string, const sh::InterfaceBlock *> UniformBlockMap;
-    UniformBlockMap linkedUniformBlocks;
+    PooledNameMap<const sh::ShaderReflection::Block *> linkedUniformBlocks;
 
-    for (const sh::InterfaceBlock &vertexInterfaceBlock : vertexInterfaceBlocks)
+    linkedUniformBlocks.reserve(vertexReflection.interfaceBlocks.size());
+    for (const sh::ShaderReflection::Block &vertexInterfaceBlock : vertexReflection.interfaceBlocks)
     {
-        linkedUniformBlocks[vertexInterfaceBlock.name] = &vertexInterfaceBlock;
+        linkedUniformBlocks[PooledName(vertexReflection, vertexInterfaceBlock.name)] =
+            &vertexInterfaceBlock;
     }
 
-    for (const sh::InterfaceBlock &fragmentInterfaceBlock : fragmentInterfaceBlocks)
+    for (const sh::ShaderReflection::Block &fragmentInterfaceBlock :
+         fragmentReflection.interfaceBlocks)
     {
-        auto entry = linkedUniformBlocks.find(fragmentInterfaceBlock.name);
+        auto entry =
+            linkedUniformBlocks.find(PooledName(fragmentReflection, fragmentInterfaceBlock.name));
         if (entry != linkedUniformBlocks.end())
         {
-            const sh::InterfaceBlock &vertexInterfaceBlock = *entry->second;
-            if (!areMatchingInterfaceBlocks(infoLog, vertexInterfaceBlock, fragmentInterfaceBlock))
+            const sh::ShaderReflection::Block &vertexInterfaceBlock = *entry->second;
+            if (!areMatchingInterfaceBlocks(infoLog, vertexReflection, vertexInterfaceBlock,
+                                            fragmentReflection, fragmentInterfaceBlock))
             {
                 return false;
             }
@@ -2187,11 +2585,10 @@ bool Program::linkUniformBlocks(InfoLog &infoLog, const Caps &caps)
 {
     if (mState.mAttachedComputeShader)
     {
-        const Shader &computeShader        = *mState.mAttachedComputeShader;
-        const auto &computeInterfaceBlocks = computeShader.getInterfaceBlocks();
+        const Shader &computeShader = *mState.mAttachedComputeShader;
 
         if (!validateUniformBlocksCount(
-                caps.maxComputeUniformBlocks, computeInterfaceBlocks,
+                caps.maxComputeUniformBlocks, computeShader.getReflection(),
                 "Compute shader uniform block count exceeds GL_MAX_COMPUTE_UNIFORM_BLOCKS (",
                 infoLog))
         {
@@ -2200,28 +2597,26 @@ bool Program::linkUniformBlocks(InfoLog &infoLog, const Caps &caps)
         return true;
     }
 
-    const Shader &vertexShader   = *mState.mAttachedVertexShader;
-    const Shader &fragmentShader = *mState.mAttachedFragmentShader;
-
-    const auto &vertexInterfaceBlocks   = vertexShader.getInterfaceBlocks();
-    const auto &fragmentInterfaceBlocks = fragmentShader.getInterfaceBlocks();
+    const sh::ShaderReflection &vertexReflection =
+        mState.mAttachedVertexShader->getReflection();
+    const sh::ShaderReflection &fragmentReflection =
+        mState.mAttachedFragmentShader->getReflection();
 
     if (!validateUniformBlocksCount(
-            caps.maxVertexUniformBlocks, vertexInterfaceBlocks,
+            caps.maxVertexUniformBlocks, vertexReflection,
             "Vertex shader uniform block count exceeds GL_MAX_VERTEX_UNIFORM_BLOCKS (", infoLog))
     {
         return false;
     }
     if (!validateUniformBlocksCount(
-            caps.maxFragmentUniformBlocks, fragmentInterfaceBlocks,
+            caps.maxFragmentUniformBlocks, fragmentReflection,
             "Fragment shader uniform block count exceeds GL_MAX_FRAGMENT_UNIFORM_BLOCKS (",
             infoLog))
     {
 
         return false;
     }
-    if (!validateVertexAndFragmentInterfaceBlocks(vertexInterfaceBlocks, fragmentInterfaceBlocks,
-                                                  infoLog))
+    if (!validateVertexAndFragmentInterfaceBlocks(vertexReflection, fragmentReflection, infoLog))
     {
         return false;
     }
@@ -2229,13 +2624,16 @@ bool Program::linkUniformBlocks(InfoLog &infoLog, const Caps &caps)
     return true;
 }
 
-bool Program::areMatchingInterfaceBlocks(InfoLog &infoLog,
-                                         const sh::InterfaceBlock &vertexInterfaceBlock,
-                                         const sh::InterfaceBlock &fragmentInterfaceBlock) const
+bool Program::areMatchingInterfaceBlocks(
+    InfoLog &infoLog,
+    const sh::ShaderReflection &vertexReflection,
+    const sh::ShaderReflection::Block &vertexInterfaceBlock,
+    const sh::ShaderReflection &fragmentReflection,
+    const sh::ShaderReflection::Block &fragmentInterfaceBlock) const
 {
-    const char* blockName = vertexInterfaceBlock.name.c_str();
+    const std::string blockName = vertexReflection.getString(vertexInterfaceBlock.name);
     // validate blocks for the same member types
-    if (vertexInterfaceBlock.fields.size() != fragmentInterfaceBlock.fields.size())
+    if (vertexInterfaceBlock.fieldRange.count != fragmentInterfaceBlock.fieldRange.count)
     {
         infoLog << "Types for interface block '" << blockName
                 << "' differ between vertex and fragment shaders";
@@ -2253,21 +2651,26 @@ bool Program::areMatchingInterfaceBlocks(InfoLog &infoLog,
                 << "' between vertex and fragment shaders";
         return false;
     }
-    const unsigned int numBlockMembers =
-        static_cast<unsigned int>(vertexInterfaceBlock.fields.size());
+    const unsigned int numBlockMembers = vertexInterfaceBlock.fieldRange.count;
     for (unsigned int blockMemberIndex = 0; blockMemberIndex < numBlockMembers; blockMemberIndex++)
     {
-        const sh::InterfaceBlockField &vertexMember = vertexInterfaceBlock.fields[blockMemberIndex];
-        const sh::InterfaceBlockField &fragmentMember = fragmentInterfaceBlock.fields[blockMemberIndex];
-        if (vertexMember.name != fragmentMember.name)
+        const VariableRecord vertexMember(
+            vertexReflection,
+            vertexReflection.getField(vertexInterfaceBlock.fieldRange, blockMemberIndex));
+        const VariableRecord fragmentMember(
+            fragmentReflection,
+            fragmentReflection.getField(fragmentInterfaceBlock.fieldRange, blockMemberIndex));
+        if (!sh::ShaderReflection::StringsEqual(vertexReflection, vertexMember.variable->name,
+                                                fragmentReflection, fragmentMember.variable->name))
         {
             infoLog << "Name mismatch for field " << blockMemberIndex
                     << " of interface block '" << blockName
-                    << "': (in vertex: '" << vertexMember.name
-                    << "', in fragment: '" << fragmentMember.name << "')";
+                    << "': (in vertex: '" << vertexMember.getName()
+                    << "', in fragment: '" << fragmentMember.getName() << "')";
             return false;
         }
-        std::string memberName = "interface block '" + vertexInterfaceBlock.name + "' member '" + vertexMember.name + "'";
+        std::string memberName =
+            "interface block '" + blockName + "' member '" + vertexMember.getName() + "'";
         if (!linkValidateInterfaceBlockFields(infoLog, memberName, vertexMember, fragmentMember))
         {
             return false;
@@ -2276,49 +2679,56 @@ bool Program::areMatchingInterfaceBlocks(InfoLog &infoLog,
     return true;
 }
 
-bool Program::linkValidateVariablesBase(InfoLog &infoLog, const std::string &variableName, const sh::ShaderVariable &vertexVariable,
-                                              const sh::ShaderVariable &fragmentVariable, bool validatePrecision)
+bool Program::linkValidateVariablesBase(InfoLog &infoLog,
+                                        const std::string &variableName,
+                                        const VariableRecord &vertexVariable,
+                                        const VariableRecord &fragmentVariable,
+                                        bool validatePrecision)
 {
-    if (vertexVariable.type != fragmentVariable.type)
+    const sh::ShaderReflection::Variable &vertexRecord   = *vertexVariable.variable;
+    const sh::ShaderReflection::Variable &fragmentRecord = *fragmentVariable.variable;
+
+    if (vertexRecord.type != fragmentRecord.type)
     {
         infoLog << "Types for " << variableName << " differ between vertex and fragment shaders";
         return false;
     }
-    if (vertexVariable.arraySize != fragmentVariable.arraySize)
+    if (vertexRecord.arraySize != fragmentRecord.arraySize)
     {
         infoLog << "Array sizes for " << variableName << " differ between vertex and fragment shaders";
         return false;
     }
-    if (validatePrecision && vertexVariable.precision != fragmentVariable.precision)
+    if (validatePrecision && vertexRecord.precision != fragmentRecord.precision)
     {
         infoLog << "Precisions for " << variableName << " differ between vertex and fragment shaders";
         return false;
     }
 
-    if (vertexVariable.fields.size() != fragmentVariable.fields.size())
+    if (vertexRecord.fieldRange.count != fragmentRecord.fieldRange.count)
     {
         infoLog << "Structure lengths for " << variableName << " differ between vertex and fragment shaders";
         return false;
     }
-    const unsigned int numMembers = static_cast<unsigned int>(vertexVariable.fields.size());
+    const unsigned int numMembers = vertexRecord.fieldRange.count;
     for (unsigned int memberIndex = 0; memberIndex < numMembers; memberIndex++)
     {
-        const sh::ShaderVariable &vertexMember = vertexVariable.fields[memberIndex];
-        const sh::ShaderVariable &fragmentMember = fragmentVariable.fields[memberIndex];
+        const VariableRecord vertexMember   = vertexVariable.getField(memberIndex);
+        const VariableRecord fragmentMember = fragmentVariable.getField(memberIndex);
 
-        if (vertexMember.name != fragmentMember.name)
+        if (!sh::ShaderReflection::StringsEqual(*vertexMember.reflection,
+                                                vertexMember.variable->name,
+                                                *fragmentMember.reflection,
+                                                fragmentMember.variable->name))
         {
             infoLog << "Name mismatch for field '" << memberIndex
                     << "' of " << variableName
-                    << ": (in vertex: '" << vertexMember.name
-                    << "', in fragment: '" << fragmentMember.name << "')";
+                    << ": (in vertex: '" << vertexMember.getName()
+                    << "', in fragment: '" << fragmentMember.getName() << "')";
             return false;
         }
 
-        const std::string memberName = variableName.substr(0, variableName.length() - 1) + "." +
-                                       vertexMember.name + "'";
-
-        if (!linkValidateVariablesBase(infoLog, vertexMember.name, vertexMember, fragmentMember, validatePrecision))
+        if (!linkValidateVariablesBase(infoLog, vertexMember.getName(), vertexMember,
+                                       fragmentMember, validatePrecision))
         {
             return false;
         }
@@ -2327,7 +2737,10 @@ bool Program::linkValidateVariablesBase(InfoLog &infoLog, const std::string &var
     return true;
 }
 
-bool Program::linkValidateUniforms(InfoLog &infoLog, const std::string &uniformName, const sh::Uniform &vertexUniform, const sh::Uniform &fragmentUniform)
+bool Program::linkValidateUniforms(InfoLog &infoLog,
+                                   const std::string &uniformName,
+                                   const VariableRecord &vertexUniform,
+                                   const VariableRecord &fragmentUniform)
 {
 #if ANGLE_PROGRAM_LINK_VALIDATE_UNIFORM_PRECISION == ANGLE_ENABLED
     const bool validatePrecision = true;
@@ -2345,8 +2758,8 @@ bool Program::linkValidateUniforms(InfoLog &infoLog, const std::string &uniformN
 
 bool Program::linkValidateVaryings(InfoLog &infoLog,
                                    const std::string &varyingName,
-                                   const sh::Varying &vertexVarying,
-                                   const sh::Varying &fragmentVarying,
+                                   const VariableRecord &vertexVarying,
+                                   const VariableRecord &fragmentVarying,
                                    int shaderVersion)
 {
     if (!linkValidateVariablesBase(infoLog, varyingName, vertexVarying, fragmentVarying, false))
@@ -2354,14 +2767,16 @@ bool Program::linkValidateVaryings(InfoLog &infoLog,
         return false;
     }
 
-    if (!sh::InterpolationTypesMatch(vertexVarying.interpolation, fragmentVarying.interpolation))
+    if (!sh::InterpolationTypesMatch(vertexVarying.variable->interpolation,
+                                     fragmentVarying.variable->interpolation))
     {
         infoLog << "Interpolation types for " << varyingName
                 << " differ between vertex and fragment shaders.";
         return false;
     }
 
-    if (shaderVersion == 100 && vertexVarying.isInvariant != fragmentVarying.isInvariant)
+    if (shaderVersion == 100 &&
+        vertexVarying.variable->isInvariant != fragmentVarying.variable->isInvariant)
     {
         infoLog << "Invariance for " << varyingName
                 << " differs between vertex and fragment shaders.";
@@ -2372,49 +2787,53 @@ bool Program::linkValidateVaryings(InfoLog &infoLog,
 }
 
 bool Program::linkValidateTransformFeedback(InfoLog &infoLog,
-                                            const std::vector<const sh::Varying *> &varyings,
+                                            const std::vector<VariableRecord> &varyings,
                                             const Caps &caps) const
 {
     size_t totalComponents = 0;
 
-    std::set<std::string> uniqueNames;
+    std::unordered_set<std::string> uniqueNames;
+    PooledNameMap<const sh::ShaderReflection::Variable *> varyingsByName;
+    varyingsByName.reserve(varyings.size());
+    for (const VariableRecord &varying : varyings)
+    {
+        varyingsByName.insert(std::make_pair(
+            PooledName(*varying.reflection, varying.variable->name), varying.variable));
+    }
 
     for (const std::string &tfVaryingName : mState.mTransformFeedbackVaryingNames)
     {
         bool found = false;
-        for (const sh::Varying *varying : varyings)
+        auto entry = varyingsByName.find(PooledName(tfVaryingName));
+        if (entry != varyingsByName.end())
         {
-            if (tfVaryingName == varying->name)
+            const sh::ShaderReflection::Variable *varying = entry->second;
+            if (!uniqueNames.insert(tfVaryingName).second)
             {
-                if (uniqueNames.count(tfVaryingName) > 0)
-                {
-                    infoLog << "Two transform feedback varyings specify the same output variable ("
-                            << tfVaryingName << ").";
-                    return false;
-                }
-                uniqueNames.insert(tfVaryingName);
-
-                if (varying->isArray())
-                {
-                    infoLog << "Capture of arrays is undefined and not supported.";
-                    return false;
-                }
+                infoLog << "Two transform feedback varyings specify the same output variable ("
+                        << tfVaryingName << ").";
+                return false;
+            }
 
-                // TODO(jmadill): Investigate implementation limits on D3D11
-                size_t componentCount = VariableComponentCount(varying->type);
-                if (mState.mTransformFeedbackBufferMode == GL_SEPARATE_ATTRIBS &&
-                    componentCount > caps.maxTransformFeedbackSeparateComponents)
-                {
-                    infoLog << "Transform feedback varying's " << varying->name << " components ("
-                            << componentCount << ") exceed the maximum separate components ("
-                            << caps.maxTransformFeedbackSeparateComponents << ").";
-                    return false;
-                }
+            if (varying->isArray())
+            {
+                infoLog << "Capture of arrays is undefined and not supported.";
+                return false;
+            }
 
-                totalComponents += componentCount;
-                found = true;
-                break;
+            // TODO(jmadill): Investigate implementation limits on D3D11
+            size_t componentCount = VariableComponentCount(varying->type);
+            if (mState.mTransformFeedbackBufferMode == GL_SEPARATE_ATTRIBS &&
+                componentCount > caps.maxTransformFeedbackSeparateComponents)
+            {
+                infoLog << "Transform feedback varying's " << tfVaryingName << " components ("
+                        << componentCount << ") exceed the maximum separate components ("
+                        << caps.maxTransformFeedbackSeparateComponents << ").";
+                return false;
             }
+
+            totalComponents += componentCount;
+            found = true;
         }
 
         if (tfVaryingName.find('[') != std::string::npos)
@@ -2439,43 +2858,51 @@ bool Program::linkValidateTransformFeedback(InfoLog &infoLog,
     return true;
 }
 
-void Program::gatherTransformFeedbackVaryings(const std::vector<const sh::Varying *> &varyings)
+void Program::gatherTransformFeedbackVaryings(const std::vector<VariableRecord> &varyings)
 {
     // Gather the linked varyings that are used for transform feedback, they should all exist.
     mState.mTransformFeedbackVaryingVars.clear();
+    PooledNameMap<const VariableRecord *> varyingsByName;
+    varyingsByName.reserve(varyings.size());
+    for (const VariableRecord &varying : varyings)
+    {
+        varyingsByName.insert(
+            std::make_pair(PooledName(*varying.reflection, varying.variable->name), &varying));
+    }
     for (const std::string &tfVaryingName : mState.mTransformFeedbackVaryingNames)
     {
-        for (const sh::Varying *varying : varyings)
+        auto entry = varyingsByName.find(PooledName(tfVaryingName));
+        if (entry != varyingsByName.end())
         {
-            if (tfVaryingName == varying->name)
-            {
-                mState.mTransformFeedbackVaryingVars.push_back(*varying);
-                break;
-            }
+            const VariableRecord &varying = *entry->second;
+            mState.mTransformFeedbackVaryingVars.emplace_back();
+            varying.reflection->getVarying(*varying.variable,
+                                           &mState.mTransformFeedbackVaryingVars.back());
         }
     }
 }
 
-std::vector<const sh::Varying *> Program::getMergedVaryings() const
+std::vector<Program::VariableRecord> Program::getMergedVaryings() const
 {
-    std::set<std::string> uniqueNames;
-    std::vector<const sh::Varying *> varyings;
+    PooledNameSet uniqueNames;
+    std::vector<VariableRecord> varyings;
 
-    for (const sh::Varying &varying : mState.mAttachedVertexShader->getVaryings())
+    const sh::ShaderReflection &vertexReflection = mState.mAttachedVertexShader->getReflection();
+    for (const sh::ShaderReflection::Variable &varying : vertexReflection.varyings)
     {
-        if (uniqueNames.count(varying.name) == 0)
+        if (uniqueNames.insert(PooledName(vertexReflection, varying.name)).second)
         {
-            uniqueNames.insert(varying.name);
-            varyings.push_back(&varying);
+            varyings.push_back(VariableRecord(vertexReflection, varying));
         }
     }
 
-    for (const sh::Varying &varying : mState.mAttachedFragmentShader->getVaryings())
+    const sh::ShaderReflection &fragmentReflection =
+        mState.mAttachedFragmentShader->getReflection();
+    for (const sh::ShaderReflection::Variable &varying : fragmentReflection.varyings)
     {
-        if (uniqueNames.count(varying.name) == 0)
+        if (uniqueNames.insert(PooledName(fragmentReflection, varying.name)).second)
         {
-            uniqueNames.insert(varying.name);
-            varyings.push_back(&varying);
+            varyings.push_back(VariableRecord(fragmentReflection, varying));
         }
     }
 
@@ -2491,19 +2918,23 @@ void Program::linkOutputVariables()
     if (fragmentShader->getShaderVersion() == 100)
         return;
 
-    const auto &shaderOutputVars = fragmentShader->getActiveOutputVariables();
+    const sh::ShaderReflection &reflection = fragmentShader->getReflection();
+    const auto &shaderOutputVars           = reflection.outputVariables;
 
     // TODO(jmadill): any caps validation here?
 
     for (unsigned int outputVariableIndex = 0; outputVariableIndex < shaderOutputVars.size();
          outputVariableIndex++)
     {
-        const sh::OutputVariable &outputVariable = shaderOutputVars[outputVariableIndex];
+        const sh::ShaderReflection::Variable &outputVariable =
+            shaderOutputVars[outputVariableIndex];
 
         // Don't store outputs for gl_FragDepth, gl_FragColor, etc.
-        if (outputVariable.isBuiltIn())
+        if (reflection.isBuiltIn(outputVariable))
             continue;
 
+        const std::string outputName = reflection.getString(outputVariable.name);
+
         // Since multiple output locations must be specified, use 0 for non-specified locations.
         int baseLocation = (outputVariable.location == -1 ? 0 : outputVariable.location);
 
@@ -2516,7 +2947,7 @@ void Program::linkOutputVariables()
             ASSERT(mState.mOutputVariables.count(location) == 0);
             unsigned int element = outputVariable.isArray() ? elementIndex : GL_INVALID_INDEX;
             mState.mOutputVariables[location] =
-                VariableLocation(outputVariable.name, element, outputVariableIndex);
+                VariableLocation(outputName, element, outputVariableIndex);
         }
     }
 }
@@ -2527,14 +2958,18 @@ bool Program::flattenUniformsAndCheckCapsForShader(const Shader &shader,
                                                    const std::string &componentsErrorMessage,
                                                    const std::string &samplerErrorMessage,
                                                    std::vector<LinkedUniform> &samplerUniforms,
+                                                   std::unordered_set<std::string> &uniformNames,
                                                    InfoLog &infoLog)
 {
     VectorAndSamplerCount vasCount;
-    for (const sh::Uniform &uniform : shader.getUniforms())
+    const sh::ShaderReflection &reflection = shader.getReflection();
+    for (const sh::ShaderReflection::Variable &uniform : reflection.uniforms)
     {
         if (uniform.staticUse)
         {
-            vasCount += flattenUniform(uniform, uniform.name, &samplerUniforms);
+            vasCount += flattenUniform(VariableRecord(reflection, uniform),
+                                       reflection.getString(uniform.name), &samplerUniforms,
+                                       &uniformNames);
         }
     }
 
@@ -2557,6 +2992,14 @@ bool Program::flattenUniformsAndCheckCaps(const Caps &caps, InfoLog &infoLog)
 {
     std::vector<LinkedUniform> samplerUniforms;
 
+    // The names of the uniforms flattened so far, so that a uniform shared by both shaders is
+    // only added once without searching the lists.
+    std::unordered_set<std::string> uniformNames;
+    for (const LinkedUniform &uniform : mState.mUniforms)
+    {
+        uniformNames.insert(uniform.name);
+    }
+
     if (mState.mAttachedComputeShader)
     {
         const Shader *computeShader = mState.getAttachedComputeShader();
@@ -2567,7 +3010,7 @@ bool Program::flattenUniformsAndCheckCaps(const Caps &caps, InfoLog &infoLog)
                 caps.maxComputeTextureImageUnits,
                 "Compute shader active uniforms exceed MAX_COMPUTE_UNIFORM_COMPONENTS (",
                 "Compute shader sampler count exceeds MAX_COMPUTE_TEXTURE_IMAGE_UNITS (",
-                samplerUniforms, infoLog))
+                samplerUniforms, uniformNames, infoLog))
         {
             return false;
         }
@@ -2580,7 +3023,7 @@ bool Program::flattenUniformsAndCheckCaps(const Caps &caps, InfoLog &infoLog)
                 *vertexShader, caps.maxVertexUniformVectors, caps.maxVertexTextureImageUnits,
                 "Vertex shader active uniforms exceed MAX_VERTEX_UNIFORM_VECTORS (",
                 "Vertex shader sampler count exceeds MAX_VERTEX_TEXTURE_IMAGE_UNITS (",
-                samplerUniforms, infoLog))
+                samplerUniforms, uniformNames, infoLog))
         {
             return false;
         }
@@ -2590,7 +3033,7 @@ bool Program::flattenUniformsAndCheckCaps(const Caps &caps, InfoLog &infoLog)
                 *fragmentShader, caps.maxFragmentUniformVectors, caps.maxTextureImageUnits,
                 "Fragment shader active uniforms exceed MAX_FRAGMENT_UNIFORM_VECTORS (",
                 "Fragment shader sampler count exceeds MAX_TEXTURE_IMAGE_UNITS (", samplerUniforms,
-                infoLog))
+                uniformNames, infoLog))
         {
             return false;
         }
@@ -2600,16 +3043,21 @@ bool Program::flattenUniformsAndCheckCaps(const Caps &caps, InfoLog &infoLog)
     mSamplerUniformRange.end =
         mSamplerUniformRange.start + static_cast<unsigned int>(samplerUniforms.size());
 
-    mState.mUniforms.insert(mState.mUniforms.end(), samplerUniforms.begin(), samplerUniforms.end());
+    mState.mUniforms.insert(mState.mUniforms.end(),
+                            std::make_move_iterator(samplerUniforms.begin()),
+                            std::make_move_iterator(samplerUniforms.end()));
 
     return true;
 }
 
-Program::VectorAndSamplerCount Program::flattenUniform(const sh::ShaderVariable &uniform,
-                                                       const std::string &fullName,
-                                                       std::vector<LinkedUniform> *samplerUniforms)
+Program::VectorAndSamplerCount Program::flattenUniform(
+    const VariableRecord &uniformRecord,
+    const std::string &fullName,
+    std::vector<LinkedUniform> *samplerUniforms,
+    std::unordered_set<std::string> *uniformNames)
 {
     VectorAndSamplerCount vectorAndSamplerCount;
+    const sh::ShaderReflection::Variable &uniform = *uniformRecord.variable;
 
     if (uniform.isStruct())
     {
@@ -2617,12 +3065,14 @@ Program::VectorAndSamplerCount Program::flattenUniform(const sh::ShaderVariable
         {
             const std::string &elementString = (uniform.isArray() ? ArrayString(elementIndex) : "");
 
-            for (size_t fieldIndex = 0; fieldIndex < uniform.fields.size(); fieldIndex++)
+            for (size_t fieldIndex = 0; fieldIndex < uniform.fieldRange.count; fieldIndex++)
             {
-                const sh::ShaderVariable &field  = uniform.fields[fieldIndex];
-                const std::string &fieldFullName = (fullName + elementString + "." + field.name);
+                const VariableRecord field       = uniformRecord.getField(fieldIndex);
+                const std::string &fieldFullName =
+                    (fullName + elementString + "." + field.getName());
 
-                vectorAndSamplerCount += flattenUniform(field, fieldFullName, samplerUniforms);
+                vectorAndSamplerCount +=
+                    flattenUniform(field, fieldFullName, samplerUniforms, uniformNames);
             }
         }
 
@@ -2631,8 +3081,7 @@ Program::VectorAndSamplerCount Program::flattenUniform(const sh::ShaderVariable
 
     // Not a struct
     bool isSampler = IsSamplerType(uniform.type);
-    if (!UniformInList(mState.getUniforms(), fullName) &&
-        !UniformInList(*samplerUniforms, fullName))
+    if (uniformNames->insert(fullName).second)
     {
         LinkedUniform linkedUniform(uniform.type, uniform.precision, fullName, uniform.arraySize,
                                     -1, sh::BlockMemberInfo::getDefaultBlockInfo());
@@ -2641,11 +3090,11 @@ Program::VectorAndSamplerCount Program::flattenUniform(const sh::ShaderVariable
         // Store sampler uniforms separately, so we'll append them to the end of the list.
         if (isSampler)
         {
-            samplerUniforms->push_back(linkedUniform);
+            samplerUniforms->push_back(std::move(linkedUniform));
         }
         else
         {
-            mState.mUniforms.push_back(linkedUniform);
+            mState.mUniforms.push_back(std::move(linkedUniform));
         }
     }
 
@@ -2666,9 +3115,10 @@ void Program::gatherInterfaceBlockInfo()
 
     if (mState.mAttachedComputeShader)
     {
-        const Shader *computeShader = mState.getAttachedComputeShader();
+        const sh::ShaderReflection &computeReflection =
+            mState.getAttachedComputeShader()->getReflection();
 
-        for (const sh::InterfaceBlock &computeBlock : computeShader->getInterfaceBlocks())
+        for (const sh::ShaderReflection::Block &computeBlock : computeReflection.interfaceBlocks)
         {
 
             // Only 'packed' blocks are allowed to be considered inactive.
@@ -2677,68 +3127,86 @@ void Program::gatherInterfaceBlockInfo()
 
             for (UniformBlock &block : mState.mUniformBlocks)
             {
-                if (block.name == computeBlock.name)
+                if (computeReflection.stringEquals(computeBlock.name, block.name))
                 {
                     block.computeStaticUse = computeBlock.staticUse;
                 }
             }
 
-            defineUniformBlock(computeBlock, GL_COMPUTE_SHADER);
+            defineUniformBlock(computeReflection, computeBlock, GL_COMPUTE_SHADER);
         }
         return;
     }
 
-    std::set<std::string> visitedList;
+    PooledNameSet visitedList;
 
-    const Shader *vertexShader = mState.getAttachedVertexShader();
+    // Index the vertex shader's blocks by name for the fragment shader's static use below. The
+    // elements of an array of blocks share its name and are consecutive, so keep the first one.
+    PooledNameMap<size_t> blockIndicesByName;
 
-    for (const sh::InterfaceBlock &vertexBlock : vertexShader->getInterfaceBlocks())
+    const sh::ShaderReflection &vertexReflection =
+        mState.getAttachedVertexShader()->getReflection();
+
+    for (const sh::ShaderReflection::Block &vertexBlock : vertexReflection.interfaceBlocks)
     {
         // Only 'packed' blocks are allowed to be considered inactive.
         if (!vertexBlock.staticUse && vertexBlock.layout == sh::BLOCKLAYOUT_PACKED)
             continue;
 
-        if (visitedList.count(vertexBlock.name) > 0)
+        const PooledName blockName(vertexReflection, vertexBlock.name);
+        if (!visitedList.insert(blockName).second)
             continue;
 
-        defineUniformBlock(vertexBlock, GL_VERTEX_SHADER);
-        visitedList.insert(vertexBlock.name);
+        const size_t blockIndex = mState.mUniformBlocks.size();
+        defineUniformBlock(vertexReflection, vertexBlock, GL_VERTEX_SHADER);
+        if (blockIndex < mState.mUniformBlocks.size())
+        {
+            blockIndicesByName.insert(std::make_pair(blockName, blockIndex));
+        }
     }
 
-    const Shader *fragmentShader = mState.getAttachedFragmentShader();
+    const sh::ShaderReflection &fragmentReflection =
+        mState.getAttachedFragmentShader()->getReflection();
 
-    for (const sh::InterfaceBlock &fragmentBlock : fragmentShader->getInterfaceBlocks())
+    for (const sh::ShaderReflection::Block &fragmentBlock : fragmentReflection.interfaceBlocks)
     {
         // Only 'packed' blocks are allowed to be considered inactive.
         if (!fragmentBlock.staticUse && fragmentBlock.layout == sh::BLOCKLAYOUT_PACKED)
             continue;
 
-        if (visitedList.count(fragmentBlock.name) > 0)
+        const PooledName blockName(fragmentReflection, fragmentBlock.name);
+        if (!visitedList.insert(blockName).second)
         {
-            for (UniformBlock &block : mState.mUniformBlocks)
+            auto entry = blockIndicesByName.find(blockName);
+            if (entry != blockIndicesByName.end())
             {
-                if (block.name == fragmentBlock.name)
+                for (size_t blockIndex = entry->second;
+                     blockIndex < mState.mUniformBlocks.size() &&
+                     fragmentReflection.stringEquals(fragmentBlock.name,
+                                                     mState.mUniformBlocks[blockIndex].name);
+                     ++blockIndex)
                 {
-                    block.fragmentStaticUse = fragmentBlock.staticUse;
+                    mState.mUniformBlocks[blockIndex].fragmentStaticUse = fragmentBlock.staticUse;
                 }
             }
 
             continue;
         }
 
-        defineUniformBlock(fragmentBlock, GL_FRAGMENT_SHADER);
-        visitedList.insert(fragmentBlock.name);
+        defineUniformBlock(fragmentReflection, fragmentBlock, GL_FRAGMENT_SHADER);
     }
 }
 
-template <typename VarT>
-void Program::defineUniformBlockMembers(const std::vector<VarT> &fields,
+void Program::defineUniformBlockMembers(const sh::ShaderReflection &reflection,
+                                        sh::ShaderReflection::FieldRange fields,
                                         const std::string &prefix,
                                         int blockIndex)
 {
-    for (const VarT &field : fields)
+    for (size_t fieldIndex = 0; fieldIndex < fields.count; ++fieldIndex)
     {
-        const std::string &fullName = (prefix.empty() ? field.name : prefix + "." + field.name);
+        const sh::ShaderReflection::Variable &field = reflection.getField(fields, fieldIndex);
+        const std::string &fieldName                = reflection.getString(field.name);
+        const std::string &fullName = (prefix.empty() ? fieldName : prefix + "." + fieldName);
 
         if (field.isStruct())
         {
@@ -2746,7 +3214,8 @@ void Program::defineUniformBlockMembers(const std::vector<VarT> &fields,
             {
                 const std::string uniformElementName =
                     fullName + (field.isArray() ? ArrayString(arrayElement) : "");
-                defineUniformBlockMembers(field.fields, uniformElementName, blockIndex);
+                defineUniformBlockMembers(reflection, field.fieldRange, uniformElementName,
+                                          blockIndex);
             }
         }
         else
@@ -2763,19 +3232,22 @@ void Program::defineUniformBlockMembers(const std::vector<VarT> &fields,
 
             // Since block uniforms have no location, we don't need to store them in the uniform
             // locations list.
-            mState.mUniforms.push_back(newUniform);
+            mState.mUniforms.push_back(std::move(newUniform));
         }
     }
 }
 
-void Program::defineUniformBlock(const sh::InterfaceBlock &interfaceBlock, GLenum shaderType)
+void Program::defineUniformBlock(const sh::ShaderReflection &reflection,
+                                 const sh::ShaderReflection::Block &interfaceBlock,
+                                 GLenum shaderType)
 {
     int blockIndex   = static_cast<int>(mState.mUniformBlocks.size());
     size_t blockSize = 0;
+    const std::string blockName = reflection.getString(interfaceBlock.name);
 
     // Don't define this block at all if it's not active in the implementation.
     std::stringstream blockNameStr;
-    blockNameStr << interfaceBlock.name;
+    blockNameStr << blockName;
     if (interfaceBlock.arraySize > 0)
     {
         blockNameStr << "[0]";
@@ -2788,7 +3260,9 @@ void Program::defineUniformBlock(const sh::InterfaceBlock &interfaceBlock, GLenu
     // Track the first and last uniform index to determine the range of active uniforms in the
     // block.
     size_t firstBlockUniformIndex = mState.mUniforms.size();
-    defineUniformBlockMembers(interfaceBlock.fields, interfaceBlock.fieldPrefix(), blockIndex);
+    // The fields of blocks with an instance name are prefixed with the block name.
+    const std::string fieldPrefix = (interfaceBlock.instanceName.length == 0 ? "" : blockName);
+    defineUniformBlockMembers(reflection, interfaceBlock.fieldRange, fieldPrefix, blockIndex);
     size_t lastBlockUniformIndex = mState.mUniforms.size();
 
     std::vector<unsigned int> blockUniformIndexes;
@@ -2802,7 +3276,7 @@ void Program::defineUniformBlock(const sh::InterfaceBlock &interfaceBlock, GLenu
     {
         for (unsigned int arrayElement = 0; arrayElement < interfaceBlock.arraySize; ++arrayElement)
         {
-            UniformBlock block(interfaceBlock.name, true, arrayElement);
+            UniformBlock block(blockName, true, arrayElement);
             block.memberUniformIndexes = blockUniformIndexes;
 
             switch (shaderType)
@@ -2835,7 +3309,7 @@ void Program::defineUniformBlock(const sh::InterfaceBlock &interfaceBlock, GLenu
     }
     else
     {
-        UniformBlock block(interfaceBlock.name, false, 0);
+        UniformBlock block(blockName, false, 0);
         block.memberUniformIndexes = blockUniformIndexes;
 
         switch (shaderType)
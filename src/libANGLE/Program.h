@@ -18,6 +18,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "common/angleutils.h"
@@ -28,6 +29,7 @@
 #include "libANGLE/Constants.h"
 #include "libANGLE/Debug.h"
 #include "libANGLE/Error.h"
+#include "libANGLE/NameLookupTable.h"
 #include "libANGLE/RefCountObject.h"
 
 namespace rx
@@ -39,6 +41,8 @@ struct TranslatedAttribute;
 
 namespace gl
 {
+class BinaryInputStream;
+class BinaryOutputStream;
 struct Caps;
 class Context;
 class ContextState;
@@ -200,6 +204,10 @@ class ProgramState final : angle::NonCopyable
   private:
     friend class Program;
 
+    // Fills the name lookup tables from the linked variables, or empties them.
+    void updateNameLookupTables();
+    void clearNameLookupTables();
+
     std::string mLabel;
 
     sh::WorkGroupSize mComputeShaderLocalSize;
@@ -227,6 +235,15 @@ class ProgramState final : angle::NonCopyable
     std::vector<VariableLocation> mUniformLocations;
     std::vector<UniformBlock> mUniformBlocks;
 
+    // The indices of the variables by name, and the locations of the uniform elements. The
+    // elements of mUniforms[i] start at mUniformElementLocations[mUniformElementOffsets[i]], and
+    // have a location of -1 when they have none.
+    NameLookupTable mAttributeLocationsByName;
+    NameLookupTable mUniformIndicesByName;
+    NameLookupTable mUniformBlockIndicesByName;
+    std::vector<size_t> mUniformElementOffsets;
+    std::vector<GLint> mUniformElementLocations;
+
     // TODO(jmadill): use unordered/hash map when available
     std::map<int, VariableLocation> mOutputVariables;
 
@@ -353,9 +370,6 @@ class Program final : angle::NonCopyable, public LabeledObject
     GLsizei getTransformFeedbackVaryingMaxLength() const;
     GLenum getTransformFeedbackBufferMode() const;
 
-    static bool linkValidateUniforms(InfoLog &infoLog, const std::string &uniformName, const sh::Uniform &vertexUniform, const sh::Uniform &fragmentUniform);
-    static bool linkValidateInterfaceBlockFields(InfoLog &infoLog, const std::string &uniformName, const sh::InterfaceBlockField &vertexUniform, const sh::InterfaceBlockField &fragmentUniform);
-
     void addRef();
     void release();
     unsigned int getRefCount() const;
@@ -386,47 +400,80 @@ class Program final : angle::NonCopyable, public LabeledObject
         std::unordered_map<std::string, GLuint> mBindings;
     };
 
+    // A variable of an attached shader, read from the shader's reflection in place.
+    struct VariableRecord
+    {
+        VariableRecord(const sh::ShaderReflection &reflection,
+                       const sh::ShaderReflection::Variable &variable)
+            : reflection(&reflection), variable(&variable)
+        {
+        }
+
+        VariableRecord getField(size_t index) const
+        {
+            return VariableRecord(*reflection, reflection->getField(variable->fieldRange, index));
+        }
+        std::string getName() const { return reflection->getString(variable->name); }
+
+        const sh::ShaderReflection *reflection;
+        const sh::ShaderReflection::Variable *variable;
+    };
+
     void unlink(bool destroy = false);
     void resetUniformBlockBindings();
 
     bool linkAttributes(const ContextState &data, InfoLog &infoLog);
     bool validateUniformBlocksCount(GLuint maxUniformBlocks,
-                                    const std::vector<sh::InterfaceBlock> &block,
+                                    const sh::ShaderReflection &reflection,
                                     const std::string &errorMessage,
                                     InfoLog &infoLog) const;
-    bool validateVertexAndFragmentInterfaceBlocks(
-        const std::vector<sh::InterfaceBlock> &vertexInterfaceBlocks,
-        const std::vector<sh::InterfaceBlock> &fragmentInterfaceBlocks,
-        InfoLog &infoLog) const;
+    bool validateVertexAndFragmentInterfaceBlocks(const sh::ShaderReflection &vertexReflection,
+                                                  const sh::ShaderReflection &fragmentReflection,
+                                                  InfoLog &infoLog) const;
     bool linkUniformBlocks(InfoLog &infoLog, const Caps &caps);
     bool linkVaryings(InfoLog &infoLog, const Shader *vertexShader, const Shader *fragmentShader) const;
     bool validateVertexAndFragmentUniforms(InfoLog &infoLog) const;
     bool linkUniforms(InfoLog &infoLog, const Caps &caps, const Bindings &uniformBindings);
     bool indexUniforms(InfoLog &infoLog, const Caps &caps, const Bindings &uniformBindings);
-    bool areMatchingInterfaceBlocks(InfoLog &infoLog,
-                                    const sh::InterfaceBlock &vertexInterfaceBlock,
-                                    const sh::InterfaceBlock &fragmentInterfaceBlock) const;
+    bool areMatchingInterfaceBlocks(
+        InfoLog &infoLog,
+        const sh::ShaderReflection &vertexReflection,
+        const sh::ShaderReflection::Block &vertexInterfaceBlock,
+        const sh::ShaderReflection &fragmentReflection,
+        const sh::ShaderReflection::Block &fragmentInterfaceBlock) const;
 
     static bool linkValidateVariablesBase(InfoLog &infoLog,
                                           const std::string &variableName,
-                                          const sh::ShaderVariable &vertexVariable,
-                                          const sh::ShaderVariable &fragmentVariable,
+                                          const VariableRecord &vertexVariable,
+                                          const VariableRecord &fragmentVariable,
                                           bool validatePrecision);
 
+    static bool linkValidateUniforms(InfoLog &infoLog,
+                                     const std::string &uniformName,
+                                     const VariableRecord &vertexUniform,
+                                     const VariableRecord &fragmentUniform);
+    static bool linkValidateInterfaceBlockFields(InfoLog &infoLog,
+                                                 const std::string &uniformName,
+                                                 const VariableRecord &vertexUniform,
+                                                 const VariableRecord &fragmentUniform);
     static bool linkValidateVaryings(InfoLog &infoLog,
                                      const std::string &varyingName,
-                                     const sh::Varying &vertexVarying,
-                                     const sh::Varying &fragmentVarying,
+                                     const VariableRecord &vertexVarying,
+                                     const VariableRecord &fragmentVarying,
                                      int shaderVersion);
     bool linkValidateTransformFeedback(InfoLog &infoLog,
-                                       const std::vector<const sh::Varying *> &linkedVaryings,
+                                       const std::vector<VariableRecord> &linkedVaryings,
                                        const Caps &caps) const;
 
-    void gatherTransformFeedbackVaryings(const std::vector<const sh::Varying *> &varyings);
+    void gatherTransformFeedbackVaryings(const std::vector<VariableRecord> &varyings);
     bool assignUniformBlockRegister(InfoLog &infoLog, UniformBlock *uniformBlock, GLenum shader, unsigned int registerIndex, const Caps &caps);
     void defineOutputVariables(Shader *fragmentShader);
 
-    std::vector<const sh::Varying *> getMergedVaryings() const;
+    // Write and read the front-end variables of program binaries.
+    void saveBinaryVariables(BinaryOutputStream *stream) const;
+    bool loadBinaryVariables(BinaryInputStream *stream);
+
+    std::vector<VariableRecord> getMergedVaryings() const;
     void linkOutputVariables();
 
     bool flattenUniformsAndCheckCapsForShader(const Shader &shader,
@@ -435,6 +482,7 @@ class Program final : angle::NonCopyable, public LabeledObject
                                               const std::string &componentsErrorMessage,
                                               const std::string &samplerErrorMessage,
                                               std::vector<LinkedUniform> &samplerUniforms,
+                                              std::unordered_set<std::string> &uniformNames,
                                               InfoLog &infoLog);
     bool flattenUniformsAndCheckCaps(const Caps &caps, InfoLog &infoLog);
 
@@ -455,17 +503,20 @@ class Program final : angle::NonCopyable, public LabeledObject
         unsigned int samplerCount;
     };
 
-    VectorAndSamplerCount flattenUniform(const sh::ShaderVariable &uniform,
+    VectorAndSamplerCount flattenUniform(const VariableRecord &uniform,
                                          const std::string &fullName,
-                                         std::vector<LinkedUniform> *samplerUniforms);
+                                         std::vector<LinkedUniform> *samplerUniforms,
+                                         std::unordered_set<std::string> *uniformNames);
 
     void gatherInterfaceBlockInfo();
-    template <typename VarT>
-    void defineUniformBlockMembers(const std::vector<VarT> &fields,
+    void defineUniformBlockMembers(const sh::ShaderReflection &reflection,
+                                   sh::ShaderReflection::FieldRange fields,
                                    const std::string &prefix,
                                    int blockIndex);
 
-    void defineUniformBlock(const sh::InterfaceBlock &interfaceBlock, GLenum shaderType);
+    void defineUniformBlock(const sh::ShaderReflection &reflection,
+                            const sh::ShaderReflection::Block &interfaceBlock,
+                            GLenum shaderType);
 
     // Both these function update the cached uniform values and return a modified "count"
     // so that the uniform update doesn't overflow the uniform.
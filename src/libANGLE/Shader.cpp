@@ -10,7 +10,9 @@
 
 #include "libANGLE/Shader.h"
 
+#include <algorithm>
 #include <sstream>
+#include <utility>
 
 #include "common/utilities.h"
 #include "GLSLANG/ShaderLang.h"
@@ -27,33 +29,16 @@ namespace gl
 
 namespace
 {
-template <typename VarT>
-std::vector<VarT> GetActiveShaderVariables(const std::vector<VarT> *variableList)
+void RemoveInactiveShaderVariables(std::vector<sh::ShaderReflection::Variable> *variableList)
 {
-    ASSERT(variableList);
-    std::vector<VarT> result;
-    for (size_t varIndex = 0; varIndex < variableList->size(); varIndex++)
-    {
-        const VarT &var = variableList->at(varIndex);
-        if (var.staticUse)
-        {
-            result.push_back(var);
-        }
-    }
-    return result;
+    variableList->erase(
+        std::remove_if(variableList->begin(), variableList->end(),
+                       [](const sh::ShaderReflection::Variable &var) { return !var.staticUse; }),
+        variableList->end());
 }
 
 template <typename VarT>
-const std::vector<VarT> &GetShaderVariables(const std::vector<VarT> *variableList)
-{
-    ASSERT(variableList);
-    return *variableList;
-}
-
-}  // anonymous namespace
-
-// true if varying x has a higher priority in packing than y
-bool CompareShaderVar(const sh::ShaderVariable &x, const sh::ShaderVariable &y)
+bool CompareShaderVarTypes(const VarT &x, const VarT &y)
 {
     if (x.type == y.type)
     {
@@ -74,6 +59,34 @@ bool CompareShaderVar(const sh::ShaderVariable &x, const sh::ShaderVariable &y)
     return gl::VariableSortOrder(x.type) < gl::VariableSortOrder(y.type);
 }
 
+template <typename VarT>
+const std::vector<VarT> &GetVariableList(const sh::ShaderReflection &reflection,
+                                         void (sh::ShaderReflection::*getList)(std::vector<VarT> *)
+                                             const,
+                                         std::unique_ptr<std::vector<VarT>> *list)
+{
+    if (!*list)
+    {
+        list->reset(new std::vector<VarT>());
+        (reflection.*getList)(list->get());
+    }
+    return **list;
+}
+
+}  // anonymous namespace
+
+// true if varying x has a higher priority in packing than y
+bool CompareShaderVar(const sh::ShaderVariable &x, const sh::ShaderVariable &y)
+{
+    return CompareShaderVarTypes(x, y);
+}
+
+bool CompareShaderVar(const sh::ShaderReflection::Variable &x,
+                      const sh::ShaderReflection::Variable &y)
+{
+    return CompareShaderVarTypes(x, y);
+}
+
 ShaderState::ShaderState(GLenum shaderType) : mLabel(), mShaderType(shaderType), mShaderVersion(100)
 {
     mLocalSize.fill(-1);
@@ -83,6 +96,43 @@ ShaderState::~ShaderState()
 {
 }
 
+const std::vector<sh::Varying> &ShaderState::getVaryings() const
+{
+    return GetVariableList(mReflection, &sh::ShaderReflection::getVaryings, &mVaryings);
+}
+
+const std::vector<sh::Uniform> &ShaderState::getUniforms() const
+{
+    return GetVariableList(mReflection, &sh::ShaderReflection::getUniforms, &mUniforms);
+}
+
+const std::vector<sh::InterfaceBlock> &ShaderState::getInterfaceBlocks() const
+{
+    return GetVariableList(mReflection, &sh::ShaderReflection::getInterfaceBlocks,
+                           &mInterfaceBlocks);
+}
+
+const std::vector<sh::Attribute> &ShaderState::getActiveAttributes() const
+{
+    return GetVariableList(mReflection, &sh::ShaderReflection::getAttributes, &mActiveAttributes);
+}
+
+const std::vector<sh::OutputVariable> &ShaderState::getActiveOutputVariables() const
+{
+    return GetVariableList(mReflection, &sh::ShaderReflection::getOutputVariables,
+                           &mActiveOutputVariables);
+}
+
+void ShaderState::clearVariables()
+{
+    mReflection.clear();
+    mVaryings.reset();
+    mUniforms.reset();
+    mInterfaceBlocks.reset();
+    mActiveAttributes.reset();
+    mActiveOutputVariables.reset();
+}
+
 Shader::Shader(ResourceManager *manager,
                rx::GLImplFactory *implFactory,
                const gl::Limitations &rendererLimitations,
@@ -233,11 +283,7 @@ void Shader::compile(const Context *context)
     mState.mTranslatedSource.clear();
     mInfoLog.clear();
     mState.mShaderVersion = 100;
-    mState.mVaryings.clear();
-    mState.mUniforms.clear();
-    mState.mInterfaceBlocks.clear();
-    mState.mActiveAttributes.clear();
-    mState.mActiveOutputVariables.clear();
+    mState.clearVariables();
 
     Compiler *compiler = context->getCompiler();
     ShHandle compilerHandle = compiler->getCompilerHandle(mState.mShaderType);
@@ -313,28 +359,36 @@ void Shader::compile(const Context *context)
     // Gather the shader information
     mState.mShaderVersion = sh::GetShaderVersion(compilerHandle);
 
-    mState.mVaryings        = GetShaderVariables(sh::GetVaryings(compilerHandle));
-    mState.mUniforms        = GetShaderVariables(sh::GetUniforms(compilerHandle));
-    mState.mInterfaceBlocks = GetShaderVariables(sh::GetInterfaceBlocks(compilerHandle));
+    // The compiler's reflection is moved rather than copied, since it is cleared by the next
+    // compilation anyway.
+    sh::ShaderReflection &reflection = mState.mReflection;
+    sh::TakeReflection(compilerHandle, &reflection);
 
     switch (mState.mShaderType)
     {
         case GL_COMPUTE_SHADER:
         {
             mState.mLocalSize = sh::GetComputeShaderLocalGroupSize(compilerHandle);
+            reflection.attributes.clear();
+            reflection.outputVariables.clear();
             break;
         }
         case GL_VERTEX_SHADER:
         {
-            mState.mActiveAttributes = GetActiveShaderVariables(sh::GetAttributes(compilerHandle));
+            RemoveInactiveShaderVariables(&reflection.attributes);
+            reflection.outputVariables.clear();
             break;
         }
         case GL_FRAGMENT_SHADER:
         {
             // TODO(jmadill): Figure out why we only sort in the FS, and if we need to.
-            std::sort(mState.mVaryings.begin(), mState.mVaryings.end(), CompareShaderVar);
-            mState.mActiveOutputVariables =
-                GetActiveShaderVariables(sh::GetOutputVariables(compilerHandle));
+            std::sort(reflection.varyings.begin(), reflection.varyings.end(),
+                      [](const sh::ShaderReflection::Variable &x,
+                         const sh::ShaderReflection::Variable &y) {
+                          return CompareShaderVar(x, y);
+                      });
+            RemoveInactiveShaderVariables(&reflection.outputVariables);
+            reflection.attributes.clear();
             break;
         }
         default:
@@ -410,14 +464,12 @@ int Shader::getSemanticIndex(const std::string &attributeName) const
 {
     if (!attributeName.empty())
     {
-        const auto &activeAttributes = mState.getActiveAttributes();
+        const sh::ShaderReflection &reflection = mState.getReflection();
 
         int semanticIndex = 0;
-        for (size_t attributeIndex = 0; attributeIndex < activeAttributes.size(); attributeIndex++)
+        for (const sh::ShaderReflection::Variable &attribute : reflection.attributes)
         {
-            const sh::ShaderVariable &attribute = activeAttributes[attributeIndex];
-
-            if (attribute.name == attributeName)
+            if (reflection.stringEquals(attribute.name, attributeName))
             {
                 return semanticIndex;
             }
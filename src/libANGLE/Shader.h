@@ -14,6 +14,7 @@
 
 #include <string>
 #include <list>
+#include <memory>
 #include <vector>
 
 #include "angle_gl.h"
@@ -52,18 +53,21 @@ class ShaderState final : angle::NonCopyable
     GLenum getShaderType() const { return mShaderType; }
     int getShaderVersion() const { return mShaderVersion; }
 
-    const std::vector<sh::Varying> &getVaryings() const { return mVaryings; }
-    const std::vector<sh::Uniform> &getUniforms() const { return mUniforms; }
-    const std::vector<sh::InterfaceBlock> &getInterfaceBlocks() const { return mInterfaceBlocks; }
-    const std::vector<sh::Attribute> &getActiveAttributes() const { return mActiveAttributes; }
-    const std::vector<sh::OutputVariable> &getActiveOutputVariables() const
-    {
-        return mActiveOutputVariables;
-    }
+    // Holds only the active attributes and output variables.
+    const sh::ShaderReflection &getReflection() const { return mReflection; }
+
+    // Lists of the variables in the reflection, built on first use.
+    const std::vector<sh::Varying> &getVaryings() const;
+    const std::vector<sh::Uniform> &getUniforms() const;
+    const std::vector<sh::InterfaceBlock> &getInterfaceBlocks() const;
+    const std::vector<sh::Attribute> &getActiveAttributes() const;
+    const std::vector<sh::OutputVariable> &getActiveOutputVariables() const;
 
   private:
     friend class Shader;
 
+    void clearVariables();
+
     std::string mLabel;
 
     GLenum mShaderType;
@@ -73,11 +77,14 @@ class ShaderState final : angle::NonCopyable
 
     sh::WorkGroupSize mLocalSize;
 
-    std::vector<sh::Varying> mVaryings;
-    std::vector<sh::Uniform> mUniforms;
-    std::vector<sh::InterfaceBlock> mInterfaceBlocks;
-    std::vector<sh::Attribute> mActiveAttributes;
-    std::vector<sh::OutputVariable> mActiveOutputVariables;
+    sh::ShaderReflection mReflection;
+
+    // The lists returned by the getters, or null until they are first used.
+    mutable std::unique_ptr<std::vector<sh::Varying>> mVaryings;
+    mutable std::unique_ptr<std::vector<sh::Uniform>> mUniforms;
+    mutable std::unique_ptr<std::vector<sh::InterfaceBlock>> mInterfaceBlocks;
+    mutable std::unique_ptr<std::vector<sh::Attribute>> mActiveAttributes;
+    mutable std::unique_ptr<std::vector<sh::OutputVariable>> mActiveOutputVariables;
 };
 
 class Shader final : angle::NonCopyable, public LabeledObject
@@ -127,6 +134,7 @@ class Shader final : angle::NonCopyable, public LabeledObject
     const std::vector<sh::InterfaceBlock> &getInterfaceBlocks() const;
     const std::vector<sh::Attribute> &getActiveAttributes() const;
     const std::vector<sh::OutputVariable> &getActiveOutputVariables() const;
+    const sh::ShaderReflection &getReflection() const { return mState.getReflection(); }
 
     int getSemanticIndex(const std::string &attributeName) const;
 
@@ -149,6 +157,8 @@ class Shader final : angle::NonCopyable, public LabeledObject
 };
 
 bool CompareShaderVar(const sh::ShaderVariable &x, const sh::ShaderVariable &y);
+bool CompareShaderVar(const sh::ShaderReflection::Variable &x,
+                      const sh::ShaderReflection::Variable &y);
 }
 
 #endif   // LIBANGLE_SHADER_H_
@@ -9,6 +9,7 @@
 #include "common/utilities.h"
 
 #include <cstring>
+#include <utility>
 
 namespace gl
 {
@@ -56,6 +57,24 @@ LinkedUniform &LinkedUniform::operator=(const LinkedUniform &uniform)
     return *this;
 }
 
+LinkedUniform::LinkedUniform(LinkedUniform &&uniform) noexcept
+    : sh::Uniform(std::move(uniform)), blockIndex(uniform.blockIndex), blockInfo(uniform.blockInfo)
+{
+    // Like the copy, this is only used while linking, before there is any uniform data.
+    ASSERT(uniform.mLazyData.empty());
+}
+
+LinkedUniform &LinkedUniform::operator=(LinkedUniform &&uniform) noexcept
+{
+    ASSERT(uniform.mLazyData.empty());
+
+    sh::Uniform::operator=(std::move(uniform));
+    blockIndex           = uniform.blockIndex;
+    blockInfo            = uniform.blockInfo;
+
+    return *this;
+}
+
 LinkedUniform::~LinkedUniform()
 {
 }
@@ -27,6 +27,8 @@ struct LinkedUniform : public sh::Uniform
     LinkedUniform(const sh::Uniform &uniform);
     LinkedUniform(const LinkedUniform &uniform);
     LinkedUniform &operator=(const LinkedUniform &uniform);
+    LinkedUniform(LinkedUniform &&uniform) noexcept;
+    LinkedUniform &operator=(LinkedUniform &&uniform) noexcept;
     ~LinkedUniform();
 
     size_t dataSize() const;
@@ -46,7 +46,30 @@ const Type &GetTypeInfo(GLenum type);
 
 struct InternalFormat
 {
+    typedef bool (*SupportCheckFunction)(const Version &, const Extensions &);
+
     InternalFormat();
+    constexpr InternalFormat(GLenum internalFormat,
+                             GLuint redBits,
+                             GLuint greenBits,
+                             GLuint blueBits,
+                             GLuint luminanceBits,
+                             GLuint alphaBits,
+                             GLuint sharedBits,
+                             GLuint depthBits,
+                             GLuint stencilBits,
+                             GLuint pixelBytes,
+                             GLuint componentCount,
+                             bool compressed,
+                             GLuint compressedBlockWidth,
+                             GLuint compressedBlockHeight,
+                             GLenum format,
+                             GLenum type,
+                             GLenum componentType,
+                             GLenum colorEncoding,
+                             SupportCheckFunction textureSupport,
+                             SupportCheckFunction renderSupport,
+                             SupportCheckFunction filterSupport);
 
     GLuint computePixelBytes(GLenum formatType) const;
 
@@ -112,12 +135,56 @@ struct InternalFormat
     GLenum componentType;
     GLenum colorEncoding;
 
-    typedef bool (*SupportCheckFunction)(const Version &, const Extensions &);
     SupportCheckFunction textureSupport;
     SupportCheckFunction renderSupport;
     SupportCheckFunction filterSupport;
 };
 
+constexpr InternalFormat::InternalFormat(GLenum internalFormat,
+                                         GLuint redBits,
+                                         GLuint greenBits,
+                                         GLuint blueBits,
+                                         GLuint luminanceBits,
+                                         GLuint alphaBits,
+                                         GLuint sharedBits,
+                                         GLuint depthBits,
+                                         GLuint stencilBits,
+                                         GLuint pixelBytes,
+                                         GLuint componentCount,
+                                         bool compressed,
+                                         GLuint compressedBlockWidth,
+                                         GLuint compressedBlockHeight,
+                                         GLenum format,
+                                         GLenum type,
+                                         GLenum componentType,
+                                         GLenum colorEncoding,
+                                         SupportCheckFunction textureSupport,
+                                         SupportCheckFunction renderSupport,
+                                         SupportCheckFunction filterSupport)
+    : internalFormat(internalFormat),
+      redBits(redBits),
+      greenBits(greenBits),
+      blueBits(blueBits),
+      luminanceBits(luminanceBits),
+      alphaBits(alphaBits),
+      sharedBits(sharedBits),
+      depthBits(depthBits),
+      stencilBits(stencilBits),
+      pixelBytes(pixelBytes),
+      componentCount(componentCount),
+      compressed(compressed),
+      compressedBlockWidth(compressedBlockWidth),
+      compressedBlockHeight(compressedBlockHeight),
+      format(format),
+      type(type),
+      componentType(componentType),
+      colorEncoding(colorEncoding),
+      textureSupport(textureSupport),
+      renderSupport(renderSupport),
+      filterSupport(filterSupport)
+{
+}
+
 // A "Format" is either a sized format, or an {unsized format, type} combination.
 struct Format
 {
@@ -146,6 +213,12 @@ struct Format
 
 const InternalFormat &GetInternalFormatInfo(GLenum internalFormat);
 
+// Every known internal format has a compact ID, assigned in increasing GLenum order, that can
+// index dense per-format tables. ID 0 is GL_NONE and is also returned for unknown formats.
+size_t GetInternalFormatCount();
+size_t GetInternalFormatID(GLenum internalFormat);
+GLenum GetInternalFormatFromID(size_t id);
+
 GLenum GetSizedInternalFormat(GLenum internalFormat, GLenum type);
 
 typedef std::set<GLenum> FormatSet;
@@ -0,0 +1,86 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// formatutils_unittest:
+//   Tests the internal format ID lookup and the dense TextureCapsMap built on it.
+
+#include <gtest/gtest.h>
+
+#include "libANGLE/formatutils.h"
+
+using namespace gl;
+
+namespace
+{
+
+// Tests that every format ID maps back to a format whose info reports that same format.
+TEST(FormatUtilsTest, InternalFormatIDRoundTrip)
+{
+    ASSERT_GT(GetInternalFormatCount(), 1u);
+    EXPECT_EQ(static_cast<GLenum>(GL_NONE), GetInternalFormatFromID(0));
+    EXPECT_EQ(0u, GetInternalFormatID(GL_NONE));
+
+    GLenum previous = GL_NONE;
+    for (size_t id = 1; id < GetInternalFormatCount(); id++)
+    {
+        GLenum internalFormat = GetInternalFormatFromID(id);
+        EXPECT_GT(internalFormat, previous);
+        EXPECT_EQ(id, GetInternalFormatID(internalFormat));
+        EXPECT_EQ(internalFormat, GetInternalFormatInfo(internalFormat).internalFormat);
+        previous = internalFormat;
+    }
+}
+
+// Tests that enums that aren't internal formats resolve to the default info.
+TEST(FormatUtilsTest, UnknownInternalFormat)
+{
+    const GLenum unknownFormats[] = {GL_TEXTURE_2D, GL_UNSIGNED_BYTE, 0xFFFFFFFFu, 1u};
+    for (GLenum unknownFormat : unknownFormats)
+    {
+        EXPECT_EQ(0u, GetInternalFormatID(unknownFormat));
+        EXPECT_EQ(0u, GetInternalFormatInfo(unknownFormat).pixelBytes);
+    }
+
+    EXPECT_EQ(static_cast<GLenum>(GL_RGBA8), GetSizedInternalFormat(GL_RGBA, GL_UNSIGNED_BYTE));
+    EXPECT_EQ(4u, GetInternalFormatInfo(GL_RGBA8).pixelBytes);
+}
+
+// Tests insertion, removal and ordered iteration of TextureCapsMap.
+TEST(FormatUtilsTest, TextureCapsMap)
+{
+    TextureCapsMap capsMap;
+    EXPECT_EQ(0u, capsMap.size());
+    EXPECT_TRUE(capsMap.begin() == capsMap.end());
+    EXPECT_FALSE(capsMap.get(GL_RGBA8).texturable);
+
+    TextureCaps caps;
+    caps.texturable = true;
+    EXPECT_TRUE(capsMap.insert(GL_RGBA8, caps));
+    EXPECT_TRUE(capsMap.insert(GL_R8, caps));
+    EXPECT_TRUE(capsMap.insert(GL_RGBA8, caps));
+    EXPECT_EQ(2u, capsMap.size());
+
+    // Enums that aren't internal formats are rejected rather than stored.
+    EXPECT_FALSE(capsMap.insert(GL_TEXTURE_2D, caps));
+    EXPECT_EQ(2u, capsMap.size());
+    EXPECT_FALSE(capsMap.get(GL_TEXTURE_2D).texturable);
+    EXPECT_TRUE(capsMap.get(GL_RGBA8).texturable);
+    EXPECT_FALSE(capsMap.get(GL_RG8).texturable);
+
+    TextureCapsMap::const_iterator iter = capsMap.begin();
+    EXPECT_EQ(static_cast<GLenum>(GL_RGBA8), iter->first);
+    ++iter;
+    EXPECT_EQ(static_cast<GLenum>(GL_R8), iter->first);
+    ++iter;
+    EXPECT_TRUE(iter == capsMap.end());
+
+    capsMap.remove(GL_RGBA8);
+    capsMap.remove(GL_RGBA8);
+    EXPECT_EQ(1u, capsMap.size());
+    EXPECT_FALSE(capsMap.get(GL_RGBA8).texturable);
+    EXPECT_EQ(static_cast<GLenum>(GL_R8), capsMap.begin()->first);
+}
+
+}  // anonymous namespace
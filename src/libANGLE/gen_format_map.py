@@ -5,9 +5,11 @@
 #
 # gen_format_map.py:
 #  Code generation for GL format map. The format map matches between
-#  {format,type} and internal format.
+#  {format,type} and internal format. Also generates the table of internal
+#  format info and the perfect hash that finds a format's row in it.
 
 from datetime import date
+import re
 import sys
 
 sys.path.append('renderer')
@@ -185,3 +187,200 @@ with open('format_map_autogen.cpp', 'wt') as out_file:
         es3_combo_cases = es3_combo_cases)
     out_file.write(output_cpp)
     out_file.close()
+
+template_internal_format_inl = """// GENERATED FILE - DO NOT EDIT.
+// Generated by {script_name} using data from {data_source_name}.
+//
+// Copyright {copyright_year} The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// internal_format_table_autogen.inl:
+//   Info for every internal format, indexed by internal format ID, and the perfect hash that
+//   maps an internal format enum to its ID. IDs follow the GLenum order and GL_NONE is ID 0.
+//   Included by formatutils.cpp after the support checks the rows reference.
+
+constexpr size_t kInternalFormatCount = {format_count};
+
+// clang-format off
+constexpr InternalFormat kInternalFormatInfos[kInternalFormatCount] = {{
+{format_rows}}};
+// clang-format on
+
+constexpr uint32_t kInternalFormatHashMultiplier = {multiplier};
+constexpr unsigned int kInternalFormatHashShift  = {shift};
+
+// The internal format ID for each hash slot. Slots that no format hashes to hold ID 0.
+constexpr uint16_t kInternalFormatHashSlots[{slot_count}] = {{
+{slots}}};
+"""
+
+internal_format_columns = [
+    "Internal format", "R", "G", "B", "L", "A", "S", "D", "St", "Bytes", "CC", "Compressed",
+    "BW", "BH", "Format", "Type", "Component type", "Encoding", "Texture supported", "Renderable",
+    "Filterable"]
+
+# The columns of each kind of row in internal_format_data.json:
+#  color:           internal format, red, green, blue, alpha and shared bits, format, type,
+#                   component type, sRGB, texture, render and filter support
+#  depth_stencil:   internal format, depth, stencil and unused bits, format, type, component type,
+#                   texture, render and filter support
+#  luminance_alpha: internal format, luminance and alpha bits, format, type, component type,
+#                   texture, render and filter support
+#  unsized:         internal format, format, texture, render and filter support
+#  compressed:      internal format, block width, block height, block bits, component count, type,
+#                   sRGB, texture, render and filter support
+def component_count(*bits):
+    return len([b for b in bits if b > 0])
+
+def color_encoding(srgb):
+    return "GL_SRGB" if srgb else "GL_LINEAR"
+
+def parse_color_row(row):
+    (internal_format, red, green, blue, alpha, shared, format, type, component_type, srgb,
+     texture, render, filter) = row
+    return [internal_format, red, green, blue, 0, alpha, shared, 0, 0,
+            (red + green + blue + alpha + shared) / 8, component_count(red, green, blue, alpha),
+            "false", 0, 0, format, type, component_type, color_encoding(srgb),
+            texture, render, filter]
+
+def parse_depth_stencil_row(row):
+    (internal_format, depth, stencil, unused, format, type, component_type,
+     texture, render, filter) = row
+    return [internal_format, 0, 0, 0, 0, 0, 0, depth, stencil, (depth + stencil + unused) / 8,
+            component_count(depth, stencil), "false", 0, 0, format, type, component_type,
+            "GL_LINEAR", texture, render, filter]
+
+def parse_luminance_alpha_row(row):
+    (internal_format, luminance, alpha, format, type, component_type, texture, render, filter) = row
+    return [internal_format, 0, 0, 0, luminance, alpha, 0, 0, 0, (luminance + alpha) / 8,
+            component_count(luminance, alpha), "false", 0, 0, format, type, component_type,
+            "GL_LINEAR", texture, render, filter]
+
+def parse_unsized_row(row):
+    (internal_format, format, texture, render, filter) = row
+    return [internal_format, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, "false", 0, 0, format, "GL_NONE",
+            "GL_NONE", "GL_NONE", texture, render, filter]
+
+def parse_compressed_row(row):
+    (internal_format, block_width, block_height, block_bits, components, type, srgb,
+     texture, render, filter) = row
+    return [internal_format, 0, 0, 0, 0, 0, 0, 0, 0, block_bits / 8, components, "true",
+            block_width, block_height, internal_format, type, "GL_UNSIGNED_NORMALIZED",
+            color_encoding(srgb), texture, render, filter]
+
+internal_format_row_parsers = {
+    "color": parse_color_row,
+    "depth_stencil": parse_depth_stencil_row,
+    "luminance_alpha": parse_luminance_alpha_row,
+    "unsized": parse_unsized_row,
+    "compressed": parse_compressed_row,
+}
+
+gl_header_files = [
+    '../../include/GLES2/gl2.h',
+    '../../include/GLES2/gl2ext.h',
+    '../../include/GLES3/gl3.h',
+    '../common/angleutils.h',
+]
+
+def load_gl_enum_values():
+    values = {}
+    for header_file in gl_header_files:
+        with open(header_file) as header:
+            for line in header:
+                match = re.match(r'#define\s+(GL_\w+)\s+(0x[0-9a-fA-F]+|[0-9]+)\b', line)
+                if match:
+                    values[match.group(1)] = int(match.group(2), 0)
+    return values
+
+def hash_slot(value, multiplier, shift):
+    return ((value * multiplier) & 0xFFFFFFFF) >> shift
+
+# Finds a multiplier that sends every format to a different slot, growing the slot table until
+# one is found. GL_NONE doesn't get a slot: empty slots already resolve to ID 0.
+def find_perfect_hash(values):
+    slot_bits = 1
+    while (1 << slot_bits) < len(values) * 2:
+        slot_bits += 1
+
+    while slot_bits <= 16:
+        shift = 32 - slot_bits
+        for attempt in range(4096):
+            multiplier = 0x9E3779B1 + attempt * 2
+            slots = [0] * (1 << slot_bits)
+            for format_id, value in enumerate(values):
+                slot = hash_slot(value, multiplier, shift)
+                if format_id == 0:
+                    continue
+                if slots[slot] != 0:
+                    break
+                slots[slot] = format_id
+            else:
+                return multiplier, shift, slots
+        slot_bits += 1
+
+    sys.exit("No perfect hash found for the internal formats")
+
+def format_internal_format_rows(rows):
+    cells = [[str(cell) for cell in row] for row in rows]
+    widths = [max(len(row[i]) + 1 for row in cells) for i in range(len(internal_format_columns))]
+    for i, column in enumerate(internal_format_columns):
+        widths[i] = max(widths[i], len(column))
+
+    header = "    //".ljust(17) + "|"
+    for i, column in enumerate(internal_format_columns):
+        header += " " + column.ljust(widths[i]) + "|"
+    lines = [header]
+    for row in cells:
+        line = "    InternalFormat("
+        for i, cell in enumerate(row):
+            if i == len(row) - 1:
+                line += cell + "),"
+            else:
+                line += (cell + ",").ljust(widths[i] + 1) + " "
+        lines.append(line)
+    return "\n".join(lines) + "\n"
+
+def format_hash_slots(slots):
+    lines = []
+    for start in range(0, len(slots), 16):
+        lines.append("    " + " ".join(str(slot) + "," for slot in slots[start:start + 16]))
+    return "\n".join(lines) + "\n"
+
+internal_format_data_file = 'internal_format_data.json'
+internal_format_data = angle_format.load_json(internal_format_data_file)
+gl_enum_values = load_gl_enum_values()
+
+internal_format_rows = {"GL_NONE": [
+    "GL_NONE", 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, "false", 0, 0, "GL_NONE", "GL_NONE", "GL_NONE",
+    "GL_NONE", "NeverSupported", "NeverSupported", "NeverSupported"]}
+
+for kind, groups in sorted(internal_format_data.iteritems()):
+    for description, rows in sorted(groups.iteritems()):
+        for row in rows:
+            info = internal_format_row_parsers[kind](row)
+            if info[0] in internal_format_rows:
+                sys.exit("Duplicate internal format " + info[0])
+            if info[0] not in gl_enum_values:
+                sys.exit("Unknown GL enum " + info[0])
+            internal_format_rows[info[0]] = info
+
+sorted_internal_formats = sorted(internal_format_rows.keys(), key=lambda name: gl_enum_values[name])
+multiplier, shift, slots = find_perfect_hash(
+    [gl_enum_values[name] for name in sorted_internal_formats])
+
+with open('internal_format_table_autogen.inl', 'wt') as out_file:
+    output_inl = template_internal_format_inl.format(
+        script_name = sys.argv[0],
+        data_source_name = internal_format_data_file,
+        copyright_year = date.today().year,
+        format_count = len(sorted_internal_formats),
+        format_rows = format_internal_format_rows(
+            [internal_format_rows[name] for name in sorted_internal_formats]),
+        multiplier = "0x%Xu" % multiplier,
+        shift = shift,
+        slot_count = len(slots),
+        slots = format_hash_slots(slots))
+    out_file.write(output_inl)
+    out_file.close()
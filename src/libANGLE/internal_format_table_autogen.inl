@@ -0,0 +1,228 @@
+// GENERATED FILE - DO NOT EDIT.
+// Generated by gen_format_map.py using data from internal_format_data.json.
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// internal_format_table_autogen.inl:
+//   Info for every internal format, indexed by internal format ID, and the perfect hash that
+//   maps an internal format enum to its ID. IDs follow the GLenum order and GL_NONE is ID 0.
+//   Included by formatutils.cpp after the support checks the rows reference.
+
+constexpr size_t kInternalFormatCount = 138;
+
+// clang-format off
+constexpr InternalFormat kInternalFormatInfos[kInternalFormatCount] = {
+    //           | Internal format                              | R  | G  | B  | L  | A  | S | D  | St| Bytes| CC| Compressed| BW | BH | Format                                       | Type                              | Component type         | Encoding  | Texture supported                                                                               | Renderable                                                                             | Filterable                                       |
+    InternalFormat(GL_NONE,                                       0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_NONE,                                       GL_NONE,                            GL_NONE,                 GL_NONE,    NeverSupported,                                                                                   NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_DEPTH_COMPONENT,                            0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_DEPTH_COMPONENT,                            GL_NONE,                            GL_NONE,                 GL_NONE,    RequireES<2, 0>,                                                                                  RequireES<2, 0>,                                                                         AlwaysSupported),
+    InternalFormat(GL_RED,                                        0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_RED,                                        GL_NONE,                            GL_NONE,                 GL_NONE,    RequireESOrExt<3, 0, &Extensions::textureRG>,                                                     NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_ALPHA,                                      0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_ALPHA,                                      GL_NONE,                            GL_NONE,                 GL_NONE,    RequireES<2, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RGB,                                        0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_RGB,                                        GL_NONE,                            GL_NONE,                 GL_NONE,    RequireES<2, 0>,                                                                                  RequireES<2, 0>,                                                                         AlwaysSupported),
+    InternalFormat(GL_RGBA,                                       0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_RGBA,                                       GL_NONE,                            GL_NONE,                 GL_NONE,    RequireES<2, 0>,                                                                                  RequireES<2, 0>,                                                                         AlwaysSupported),
+    InternalFormat(GL_LUMINANCE,                                  0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_LUMINANCE,                                  GL_NONE,                            GL_NONE,                 GL_NONE,    RequireES<2, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_LUMINANCE_ALPHA,                            0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_LUMINANCE_ALPHA,                            GL_NONE,                            GL_NONE,                 GL_NONE,    RequireES<2, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_BGR565_ANGLEX,                              5,   6,   5,   0,   1,   0,  0,   0,  2,     4,  false,      0,   0,   GL_BGRA_EXT,                                   GL_UNSIGNED_SHORT_5_6_5,            GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  NeverSupported,                                                                                   NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_BGRA4_ANGLEX,                               4,   4,   4,   0,   4,   0,  0,   0,  2,     4,  false,      0,   0,   GL_BGRA_EXT,                                   GL_UNSIGNED_SHORT_4_4_4_4_REV_EXT,  GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureFormatBGRA8888>,                                                   RequireExt<&Extensions::textureFormatBGRA8888>,                                          AlwaysSupported),
+    InternalFormat(GL_BGR5_A1_ANGLEX,                             5,   5,   5,   0,   1,   0,  0,   0,  2,     4,  false,      0,   0,   GL_BGRA_EXT,                                   GL_UNSIGNED_SHORT_1_5_5_5_REV_EXT,  GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureFormatBGRA8888>,                                                   RequireExt<&Extensions::textureFormatBGRA8888>,                                          AlwaysSupported),
+    InternalFormat(GL_ALPHA8_EXT,                                 0,   0,   0,   0,   8,   0,  0,   0,  1,     1,  false,      0,   0,   GL_ALPHA,                                      GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureStorage>,                                                          NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_LUMINANCE8_EXT,                             0,   0,   0,   8,   0,   0,  0,   0,  1,     1,  false,      0,   0,   GL_LUMINANCE,                                  GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureStorage>,                                                          NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_LUMINANCE8_ALPHA8_EXT,                      0,   0,   0,   8,   8,   0,  0,   0,  2,     2,  false,      0,   0,   GL_LUMINANCE_ALPHA,                            GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureStorage>,                                                          NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RGB8,                                       8,   8,   8,   0,   0,   0,  0,   0,  3,     3,  false,      0,   0,   GL_RGB,                                        GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireESOrExt<3, 0, &Extensions::rgb8rgba8>,                                                     RequireESOrExt<3, 0, &Extensions::rgb8rgba8>,                                            AlwaysSupported),
+    InternalFormat(GL_RGB16_EXT,                                  16,  16,  16,  0,   0,   0,  0,   0,  6,     3,  false,      0,   0,   GL_RGB,                                        GL_UNSIGNED_SHORT,                  GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureNorm16>,                                                           NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RGBA4,                                      4,   4,   4,   0,   4,   0,  0,   0,  2,     4,  false,      0,   0,   GL_RGBA,                                       GL_UNSIGNED_SHORT_4_4_4_4,          GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<2, 0>,                                                                                  RequireES<2, 0>,                                                                         AlwaysSupported),
+    InternalFormat(GL_RGB5_A1,                                    5,   5,   5,   0,   1,   0,  0,   0,  2,     4,  false,      0,   0,   GL_RGBA,                                       GL_UNSIGNED_SHORT_5_5_5_1,          GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<2, 0>,                                                                                  RequireES<2, 0>,                                                                         AlwaysSupported),
+    InternalFormat(GL_RGBA8,                                      8,   8,   8,   0,   8,   0,  0,   0,  4,     4,  false,      0,   0,   GL_RGBA,                                       GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireESOrExt<3, 0, &Extensions::rgb8rgba8>,                                                     RequireESOrExt<3, 0, &Extensions::rgb8rgba8>,                                            AlwaysSupported),
+    InternalFormat(GL_RGB10_A2,                                   10,  10,  10,  0,   2,   0,  0,   0,  4,     4,  false,      0,   0,   GL_RGBA,                                       GL_UNSIGNED_INT_2_10_10_10_REV,     GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         AlwaysSupported),
+    InternalFormat(GL_RGBA16_EXT,                                 16,  16,  16,  0,   16,  0,  0,   0,  8,     4,  false,      0,   0,   GL_RGBA,                                       GL_UNSIGNED_SHORT,                  GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureNorm16>,                                                           RequireExt<&Extensions::textureNorm16>,                                                  AlwaysSupported),
+    InternalFormat(GL_BGRA_EXT,                                   0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_BGRA_EXT,                                   GL_NONE,                            GL_NONE,                 GL_NONE,    RequireExt<&Extensions::textureFormatBGRA8888>,                                                   RequireExt<&Extensions::textureFormatBGRA8888>,                                          AlwaysSupported),
+    InternalFormat(GL_DEPTH_COMPONENT16,                          0,   0,   0,   0,   0,   0,  16,  0,  2,     1,  false,      0,   0,   GL_DEPTH_COMPONENT,                            GL_UNSIGNED_SHORT,                  GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<2, 0>,                                                                                  RequireES<2, 0>,                                                                         RequireESOrExt<3, 0, &Extensions::depthTextures>),
+    InternalFormat(GL_DEPTH_COMPONENT24,                          0,   0,   0,   0,   0,   0,  24,  0,  3,     1,  false,      0,   0,   GL_DEPTH_COMPONENT,                            GL_UNSIGNED_INT,                    GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         RequireESOrExt<3, 0, &Extensions::depthTextures>),
+    InternalFormat(GL_DEPTH_COMPONENT32_OES,                      0,   0,   0,   0,   0,   0,  32,  0,  4,     1,  false,      0,   0,   GL_DEPTH_COMPONENT,                            GL_UNSIGNED_INT,                    GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::depthTextures, &Extensions::depth32>,                                RequireExtOrExt<&Extensions::depthTextures, &Extensions::depth32>,                       AlwaysSupported),
+    InternalFormat(GL_RG,                                         0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_RG,                                         GL_NONE,                            GL_NONE,                 GL_NONE,    RequireESOrExt<3, 0, &Extensions::textureRG>,                                                     NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RG_INTEGER,                                 0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_RG_INTEGER,                                 GL_NONE,                            GL_NONE,                 GL_NONE,    RequireES<3, 0>,                                                                                  NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_R8,                                         8,   0,   0,   0,   0,   0,  0,   0,  1,     1,  false,      0,   0,   GL_RED,                                        GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireESOrExt<3, 0, &Extensions::textureRG>,                                                     RequireESOrExt<3, 0, &Extensions::textureRG>,                                            AlwaysSupported),
+    InternalFormat(GL_R16_EXT,                                    16,  0,   0,   0,   0,   0,  0,   0,  2,     1,  false,      0,   0,   GL_RED,                                        GL_UNSIGNED_SHORT,                  GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureNorm16>,                                                           RequireExt<&Extensions::textureNorm16>,                                                  AlwaysSupported),
+    InternalFormat(GL_RG8,                                        8,   8,   0,   0,   0,   0,  0,   0,  2,     2,  false,      0,   0,   GL_RG,                                         GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireESOrExt<3, 0, &Extensions::textureRG>,                                                     RequireESOrExt<3, 0, &Extensions::textureRG>,                                            AlwaysSupported),
+    InternalFormat(GL_RG16_EXT,                                   16,  16,  0,   0,   0,   0,  0,   0,  4,     2,  false,      0,   0,   GL_RG,                                         GL_UNSIGNED_SHORT,                  GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureNorm16>,                                                           RequireExt<&Extensions::textureNorm16>,                                                  AlwaysSupported),
+    InternalFormat(GL_R16F,                                       16,  0,   0,   0,   0,   0,  0,   0,  2,     1,  false,      0,   0,   GL_RED,                                        GL_HALF_FLOAT,                      GL_FLOAT,                GL_LINEAR,  HalfFloatSupportRG,                                                                               HalfFloatRenderableSupportRG,                                                            RequireExt<&Extensions::textureHalfFloatLinear>),
+    InternalFormat(GL_R32F,                                       32,  0,   0,   0,   0,   0,  0,   0,  4,     1,  false,      0,   0,   GL_RED,                                        GL_FLOAT,                           GL_FLOAT,                GL_LINEAR,  FloatSupportRG,                                                                                   FloatRenderableSupportRG,                                                                RequireExt<&Extensions::textureFloatLinear>),
+    InternalFormat(GL_RG16F,                                      16,  16,  0,   0,   0,   0,  0,   0,  4,     2,  false,      0,   0,   GL_RG,                                         GL_HALF_FLOAT,                      GL_FLOAT,                GL_LINEAR,  HalfFloatSupportRG,                                                                               HalfFloatRenderableSupportRG,                                                            RequireExt<&Extensions::textureHalfFloatLinear>),
+    InternalFormat(GL_RG32F,                                      32,  32,  0,   0,   0,   0,  0,   0,  8,     2,  false,      0,   0,   GL_RG,                                         GL_FLOAT,                           GL_FLOAT,                GL_LINEAR,  FloatSupportRG,                                                                                   FloatRenderableSupportRG,                                                                RequireExt<&Extensions::textureFloatLinear>),
+    InternalFormat(GL_R8I,                                        8,   0,   0,   0,   0,   0,  0,   0,  1,     1,  false,      0,   0,   GL_RED_INTEGER,                                GL_BYTE,                            GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_R8UI,                                       8,   0,   0,   0,   0,   0,  0,   0,  1,     1,  false,      0,   0,   GL_RED_INTEGER,                                GL_UNSIGNED_BYTE,                   GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_R16I,                                       16,  0,   0,   0,   0,   0,  0,   0,  2,     1,  false,      0,   0,   GL_RED_INTEGER,                                GL_SHORT,                           GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_R16UI,                                      16,  0,   0,   0,   0,   0,  0,   0,  2,     1,  false,      0,   0,   GL_RED_INTEGER,                                GL_UNSIGNED_SHORT,                  GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_R32I,                                       32,  0,   0,   0,   0,   0,  0,   0,  4,     1,  false,      0,   0,   GL_RED_INTEGER,                                GL_INT,                             GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_R32UI,                                      32,  0,   0,   0,   0,   0,  0,   0,  4,     1,  false,      0,   0,   GL_RED_INTEGER,                                GL_UNSIGNED_INT,                    GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RG8I,                                       8,   8,   0,   0,   0,   0,  0,   0,  2,     2,  false,      0,   0,   GL_RG_INTEGER,                                 GL_BYTE,                            GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RG8UI,                                      8,   8,   0,   0,   0,   0,  0,   0,  2,     2,  false,      0,   0,   GL_RG_INTEGER,                                 GL_UNSIGNED_BYTE,                   GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RG16I,                                      16,  16,  0,   0,   0,   0,  0,   0,  4,     2,  false,      0,   0,   GL_RG_INTEGER,                                 GL_SHORT,                           GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RG16UI,                                     16,  16,  0,   0,   0,   0,  0,   0,  4,     2,  false,      0,   0,   GL_RG_INTEGER,                                 GL_UNSIGNED_SHORT,                  GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RG32I,                                      32,  32,  0,   0,   0,   0,  0,   0,  8,     2,  false,      0,   0,   GL_RG_INTEGER,                                 GL_INT,                             GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RG32UI,                                     32,  32,  0,   0,   0,   0,  0,   0,  8,     2,  false,      0,   0,   GL_RG_INTEGER,                                 GL_UNSIGNED_INT,                    GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_COMPRESSED_RGB_S3TC_DXT1_EXT,               0,   0,   0,   0,   0,   0,  0,   0,  8,     3,  true,       4,   4,   GL_COMPRESSED_RGB_S3TC_DXT1_EXT,               GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureCompressionDXT1>,                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,              0,   0,   0,   0,   0,   0,  0,   0,  8,     4,  true,       4,   4,   GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,              GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureCompressionDXT1>,                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_S3TC_DXT3_ANGLE,            0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       4,   4,   GL_COMPRESSED_RGBA_S3TC_DXT3_ANGLE,            GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureCompressionDXT5>,                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_S3TC_DXT5_ANGLE,            0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       4,   4,   GL_COMPRESSED_RGBA_S3TC_DXT5_ANGLE,            GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureCompressionDXT5>,                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_DEPTH_STENCIL,                              0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_DEPTH_STENCIL,                              GL_NONE,                            GL_NONE,                 GL_NONE,    RequireESOrExt<3, 0, &Extensions::packedDepthStencil>,                                            RequireESOrExt<3, 0, &Extensions::packedDepthStencil>,                                   AlwaysSupported),
+    InternalFormat(GL_RGBA32F,                                    32,  32,  32,  0,   32,  0,  0,   0,  16,    4,  false,      0,   0,   GL_RGBA,                                       GL_FLOAT,                           GL_FLOAT,                GL_LINEAR,  FloatSupport,                                                                                     FloatRenderableSupport,                                                                  RequireExt<&Extensions::textureFloatLinear>),
+    InternalFormat(GL_RGB32F,                                     32,  32,  32,  0,   0,   0,  0,   0,  12,    3,  false,      0,   0,   GL_RGB,                                        GL_FLOAT,                           GL_FLOAT,                GL_LINEAR,  FloatSupport,                                                                                     FloatRenderableSupport,                                                                  RequireExt<&Extensions::textureFloatLinear>),
+    InternalFormat(GL_ALPHA32F_EXT,                               0,   0,   0,   0,   32,  0,  0,   0,  4,     1,  false,      0,   0,   GL_ALPHA,                                      GL_FLOAT,                           GL_FLOAT,                GL_LINEAR,  RequireExtAndExt<&Extensions::textureStorage, &Extensions::textureFloat>,                         NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_LUMINANCE32F_EXT,                           0,   0,   0,   32,  0,   0,  0,   0,  4,     1,  false,      0,   0,   GL_LUMINANCE,                                  GL_FLOAT,                           GL_FLOAT,                GL_LINEAR,  RequireExtAndExt<&Extensions::textureStorage, &Extensions::textureFloat>,                         NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_LUMINANCE_ALPHA32F_EXT,                     0,   0,   0,   32,  32,  0,  0,   0,  8,     2,  false,      0,   0,   GL_LUMINANCE_ALPHA,                            GL_FLOAT,                           GL_FLOAT,                GL_LINEAR,  RequireExtAndExt<&Extensions::textureStorage, &Extensions::textureFloat>,                         NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RGBA16F,                                    16,  16,  16,  0,   16,  0,  0,   0,  8,     4,  false,      0,   0,   GL_RGBA,                                       GL_HALF_FLOAT,                      GL_FLOAT,                GL_LINEAR,  HalfFloatSupport,                                                                                 HalfFloatRenderableSupport,                                                              RequireExt<&Extensions::textureHalfFloatLinear>),
+    InternalFormat(GL_RGB16F,                                     16,  16,  16,  0,   0,   0,  0,   0,  6,     3,  false,      0,   0,   GL_RGB,                                        GL_HALF_FLOAT,                      GL_FLOAT,                GL_LINEAR,  HalfFloatSupport,                                                                                 HalfFloatRenderableSupport,                                                              RequireExt<&Extensions::textureHalfFloatLinear>),
+    InternalFormat(GL_ALPHA16F_EXT,                               0,   0,   0,   0,   16,  0,  0,   0,  2,     1,  false,      0,   0,   GL_ALPHA,                                      GL_HALF_FLOAT,                      GL_FLOAT,                GL_LINEAR,  RequireExtAndExt<&Extensions::textureStorage, &Extensions::textureHalfFloat>,                     NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_LUMINANCE16F_EXT,                           0,   0,   0,   16,  0,   0,  0,   0,  2,     1,  false,      0,   0,   GL_LUMINANCE,                                  GL_HALF_FLOAT,                      GL_FLOAT,                GL_LINEAR,  RequireExtAndExt<&Extensions::textureStorage, &Extensions::textureHalfFloat>,                     NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_LUMINANCE_ALPHA16F_EXT,                     0,   0,   0,   16,  16,  0,  0,   0,  4,     2,  false,      0,   0,   GL_LUMINANCE_ALPHA,                            GL_HALF_FLOAT,                      GL_FLOAT,                GL_LINEAR,  RequireExtAndExt<&Extensions::textureStorage, &Extensions::textureHalfFloat>,                     NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_DEPTH24_STENCIL8,                           0,   0,   0,   0,   0,   0,  24,  8,  4,     2,  false,      0,   0,   GL_DEPTH_STENCIL,                              GL_UNSIGNED_INT_24_8,               GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireESOrExt<3, 0, &Extensions::depthTextures>,                                                 RequireESOrExtOrExt<3, 0, &Extensions::depthTextures, &Extensions::packedDepthStencil>,  AlwaysSupported),
+    InternalFormat(GL_R11F_G11F_B10F,                             11,  11,  10,  0,   0,   0,  0,   0,  4,     3,  false,      0,   0,   GL_RGB,                                        GL_UNSIGNED_INT_10F_11F_11F_REV,    GL_FLOAT,                GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireExt<&Extensions::colorBufferFloat>,                                               AlwaysSupported),
+    InternalFormat(GL_RGB9_E5,                                    9,   9,   9,   0,   0,   5,  0,   0,  4,     3,  false,      0,   0,   GL_RGB,                                        GL_UNSIGNED_INT_5_9_9_9_REV,        GL_FLOAT,                GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_SRGB_EXT,                                   0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_RGB,                                        GL_NONE,                            GL_NONE,                 GL_NONE,    RequireESOrExt<3, 0, &Extensions::sRGB>,                                                          NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_SRGB8,                                      8,   8,   8,   0,   0,   0,  0,   0,  3,     3,  false,      0,   0,   GL_RGB,                                        GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireESOrExt<3, 0, &Extensions::sRGB>,                                                          NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_SRGB_ALPHA_EXT,                             0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_RGBA,                                       GL_NONE,                            GL_NONE,                 GL_NONE,    RequireESOrExt<3, 0, &Extensions::sRGB>,                                                          RequireESOrExt<3, 0, &Extensions::sRGB>,                                                 AlwaysSupported),
+    InternalFormat(GL_SRGB8_ALPHA8,                               8,   8,   8,   0,   8,   0,  0,   0,  4,     4,  false,      0,   0,   GL_RGBA,                                       GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireESOrExt<3, 0, &Extensions::sRGB>,                                                          RequireESOrExt<3, 0, &Extensions::sRGB>,                                                 AlwaysSupported),
+    InternalFormat(GL_DEPTH_COMPONENT32F,                         0,   0,   0,   0,   0,   0,  32,  0,  4,     1,  false,      0,   0,   GL_DEPTH_COMPONENT,                            GL_FLOAT,                           GL_FLOAT,                GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         RequireESOrExt<3, 0, &Extensions::depthTextures>),
+    InternalFormat(GL_DEPTH32F_STENCIL8,                          0,   0,   0,   0,   0,   0,  32,  8,  8,     2,  false,      0,   0,   GL_DEPTH_STENCIL,                              GL_FLOAT_32_UNSIGNED_INT_24_8_REV,  GL_FLOAT,                GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         AlwaysSupported),
+    InternalFormat(GL_STENCIL_INDEX8,                             0,   0,   0,   0,   0,   0,  0,   8,  1,     1,  false,      0,   0,   GL_STENCIL,                                    GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<2, 0>,                                                                                  RequireES<2, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RGB565,                                     5,   6,   5,   0,   0,   0,  0,   0,  2,     3,  false,      0,   0,   GL_RGB,                                        GL_UNSIGNED_SHORT_5_6_5,            GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<2, 0>,                                                                                  RequireES<2, 0>,                                                                         AlwaysSupported),
+    InternalFormat(GL_ETC1_RGB8_OES,                              0,   0,   0,   0,   0,   0,  0,   0,  8,     3,  true,       4,   4,   GL_ETC1_RGB8_OES,                              GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::compressedETC1RGB8Texture>,                                               NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RGBA32UI,                                   32,  32,  32,  0,   32,  0,  0,   0,  16,    4,  false,      0,   0,   GL_RGBA_INTEGER,                               GL_UNSIGNED_INT,                    GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RGB32UI,                                    32,  32,  32,  0,   0,   0,  0,   0,  12,    3,  false,      0,   0,   GL_RGB_INTEGER,                                GL_UNSIGNED_INT,                    GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_RGBA16UI,                                   16,  16,  16,  0,   16,  0,  0,   0,  8,     4,  false,      0,   0,   GL_RGBA_INTEGER,                               GL_UNSIGNED_SHORT,                  GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RGB16UI,                                    16,  16,  16,  0,   0,   0,  0,   0,  6,     3,  false,      0,   0,   GL_RGB_INTEGER,                                GL_UNSIGNED_SHORT,                  GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_RGBA8UI,                                    8,   8,   8,   0,   8,   0,  0,   0,  4,     4,  false,      0,   0,   GL_RGBA_INTEGER,                               GL_UNSIGNED_BYTE,                   GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RGB8UI,                                     8,   8,   8,   0,   0,   0,  0,   0,  3,     3,  false,      0,   0,   GL_RGB_INTEGER,                                GL_UNSIGNED_BYTE,                   GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_RGBA32I,                                    32,  32,  32,  0,   32,  0,  0,   0,  16,    4,  false,      0,   0,   GL_RGBA_INTEGER,                               GL_INT,                             GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RGB32I,                                     32,  32,  32,  0,   0,   0,  0,   0,  12,    3,  false,      0,   0,   GL_RGB_INTEGER,                                GL_INT,                             GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_RGBA16I,                                    16,  16,  16,  0,   16,  0,  0,   0,  8,     4,  false,      0,   0,   GL_RGBA_INTEGER,                               GL_SHORT,                           GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RGB16I,                                     16,  16,  16,  0,   0,   0,  0,   0,  6,     3,  false,      0,   0,   GL_RGB_INTEGER,                                GL_SHORT,                           GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_RGBA8I,                                     8,   8,   8,   0,   8,   0,  0,   0,  4,     4,  false,      0,   0,   GL_RGBA_INTEGER,                               GL_BYTE,                            GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_RGB8I,                                      8,   8,   8,   0,   0,   0,  0,   0,  3,     3,  false,      0,   0,   GL_RGB_INTEGER,                                GL_BYTE,                            GL_INT,                  GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_RED_INTEGER,                                0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_RED_INTEGER,                                GL_NONE,                            GL_NONE,                 GL_NONE,    RequireES<3, 0>,                                                                                  NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_RGB_INTEGER,                                0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_RGB_INTEGER,                                GL_NONE,                            GL_NONE,                 GL_NONE,    RequireES<3, 0>,                                                                                  NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_RGBA_INTEGER,                               0,   0,   0,   0,   0,   0,  0,   0,  0,     0,  false,      0,   0,   GL_RGBA_INTEGER,                               GL_NONE,                            GL_NONE,                 GL_NONE,    RequireES<3, 0>,                                                                                  NeverSupported,                                                                          NeverSupported),
+    InternalFormat(GL_R8_SNORM,                                   8,   0,   0,   0,   0,   0,  0,   0,  1,     1,  false,      0,   0,   GL_RED,                                        GL_BYTE,                            GL_SIGNED_NORMALIZED,    GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RG8_SNORM,                                  8,   8,   0,   0,   0,   0,  0,   0,  2,     2,  false,      0,   0,   GL_RG,                                         GL_BYTE,                            GL_SIGNED_NORMALIZED,    GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RGB8_SNORM,                                 8,   8,   8,   0,   0,   0,  0,   0,  3,     3,  false,      0,   0,   GL_RGB,                                        GL_BYTE,                            GL_SIGNED_NORMALIZED,    GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RGBA8_SNORM,                                8,   8,   8,   0,   8,   0,  0,   0,  4,     4,  false,      0,   0,   GL_RGBA,                                       GL_BYTE,                            GL_SIGNED_NORMALIZED,    GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_R16_SNORM_EXT,                              16,  0,   0,   0,   0,   0,  0,   0,  2,     1,  false,      0,   0,   GL_RED,                                        GL_SHORT,                           GL_SIGNED_NORMALIZED,    GL_LINEAR,  RequireExt<&Extensions::textureNorm16>,                                                           NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RG16_SNORM_EXT,                             16,  16,  0,   0,   0,   0,  0,   0,  4,     2,  false,      0,   0,   GL_RG,                                         GL_SHORT,                           GL_SIGNED_NORMALIZED,    GL_LINEAR,  RequireExt<&Extensions::textureNorm16>,                                                           NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RGB16_SNORM_EXT,                            16,  16,  16,  0,   0,   0,  0,   0,  6,     3,  false,      0,   0,   GL_RGB,                                        GL_SHORT,                           GL_SIGNED_NORMALIZED,    GL_LINEAR,  RequireExt<&Extensions::textureNorm16>,                                                           NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RGBA16_SNORM_EXT,                           16,  16,  16,  0,   16,  0,  0,   0,  8,     4,  false,      0,   0,   GL_RGBA,                                       GL_SHORT,                           GL_SIGNED_NORMALIZED,    GL_LINEAR,  RequireExt<&Extensions::textureNorm16>,                                                           NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_RGB10_A2UI,                                 10,  10,  10,  0,   2,   0,  0,   0,  4,     4,  false,      0,   0,   GL_RGBA_INTEGER,                               GL_UNSIGNED_INT_2_10_10_10_REV,     GL_UNSIGNED_INT,         GL_LINEAR,  RequireES<3, 0>,                                                                                  RequireES<3, 0>,                                                                         NeverSupported),
+    InternalFormat(GL_COMPRESSED_R11_EAC,                         0,   0,   0,   0,   0,   0,  0,   0,  8,     1,  true,       4,   4,   GL_COMPRESSED_R11_EAC,                         GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SIGNED_R11_EAC,                  0,   0,   0,   0,   0,   0,  0,   0,  8,     1,  true,       4,   4,   GL_COMPRESSED_SIGNED_R11_EAC,                  GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RG11_EAC,                        0,   0,   0,   0,   0,   0,  0,   0,  16,    2,  true,       4,   4,   GL_COMPRESSED_RG11_EAC,                        GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SIGNED_RG11_EAC,                 0,   0,   0,   0,   0,   0,  0,   0,  16,    2,  true,       4,   4,   GL_COMPRESSED_SIGNED_RG11_EAC,                 GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGB8_ETC2,                       0,   0,   0,   0,   0,   0,  0,   0,  8,     3,  true,       4,   4,   GL_COMPRESSED_RGB8_ETC2,                       GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ETC2,                      0,   0,   0,   0,   0,   0,  0,   0,  8,     3,  true,       4,   4,   GL_COMPRESSED_SRGB8_ETC2,                      GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2,   0,   0,   0,   0,   0,   0,  0,   0,  8,     3,  true,       4,   4,   GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2,   GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2,  0,   0,   0,   0,   0,   0,  0,   0,  8,     3,  true,       4,   4,   GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2,  GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA8_ETC2_EAC,                  0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       4,   4,   GL_COMPRESSED_RGBA8_ETC2_EAC,                  GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC,           0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       4,   4,   GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC,           GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireES<3, 0>,                                                                                  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_BGRA8_EXT,                                  8,   8,   8,   0,   8,   0,  0,   0,  4,     4,  false,      0,   0,   GL_BGRA_EXT,                                   GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::textureFormatBGRA8888>,                                                   RequireExt<&Extensions::textureFormatBGRA8888>,                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_4x4_KHR,               0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       4,   4,   GL_COMPRESSED_RGBA_ASTC_4x4_KHR,               GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_5x4_KHR,               0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       5,   4,   GL_COMPRESSED_RGBA_ASTC_5x4_KHR,               GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_5x5_KHR,               0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       5,   5,   GL_COMPRESSED_RGBA_ASTC_5x5_KHR,               GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_6x5_KHR,               0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       6,   5,   GL_COMPRESSED_RGBA_ASTC_6x5_KHR,               GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_6x6_KHR,               0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       6,   6,   GL_COMPRESSED_RGBA_ASTC_6x6_KHR,               GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_8x5_KHR,               0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       8,   5,   GL_COMPRESSED_RGBA_ASTC_8x5_KHR,               GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_8x6_KHR,               0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       8,   6,   GL_COMPRESSED_RGBA_ASTC_8x6_KHR,               GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_8x8_KHR,               0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       8,   8,   GL_COMPRESSED_RGBA_ASTC_8x8_KHR,               GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_10x5_KHR,              0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       10,  5,   GL_COMPRESSED_RGBA_ASTC_10x5_KHR,              GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_10x6_KHR,              0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       10,  6,   GL_COMPRESSED_RGBA_ASTC_10x6_KHR,              GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_10x8_KHR,              0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       10,  8,   GL_COMPRESSED_RGBA_ASTC_10x8_KHR,              GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_10x10_KHR,             0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       10,  10,  GL_COMPRESSED_RGBA_ASTC_10x10_KHR,             GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_12x10_KHR,             0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       12,  10,  GL_COMPRESSED_RGBA_ASTC_12x10_KHR,             GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_RGBA_ASTC_12x12_KHR,             0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       12,  12,  GL_COMPRESSED_RGBA_ASTC_12x12_KHR,             GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR,       0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       4,   4,   GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR,       GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR,       0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       5,   4,   GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR,       GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR,       0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       5,   5,   GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR,       GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR,       0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       6,   5,   GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR,       GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR,       0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       6,   6,   GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR,       GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR,       0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       8,   5,   GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR,       GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR,       0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       8,   6,   GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR,       GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR,       0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       8,   8,   GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR,       GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR,      0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       10,  5,   GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR,      GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR,      0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       10,  6,   GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR,      GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR,      0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       10,  8,   GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR,      GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR,     0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       10,  10,  GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR,     GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR,     0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       12,  10,  GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR,     GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR,     0,   0,   0,   0,   0,   0,  0,   0,  16,    4,  true,       12,  12,  GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR,     GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_SRGB,    RequireExtOrExt<&Extensions::textureCompressionASTCHDR, &Extensions::textureCompressionASTCLDR>,  NeverSupported,                                                                          AlwaysSupported),
+    InternalFormat(GL_ETC1_RGB8_LOSSY_DECODE_ANGLE,               0,   0,   0,   0,   0,   0,  0,   0,  8,     3,  true,       4,   4,   GL_ETC1_RGB8_LOSSY_DECODE_ANGLE,               GL_UNSIGNED_BYTE,                   GL_UNSIGNED_NORMALIZED,  GL_LINEAR,  RequireExt<&Extensions::lossyETCDecode>,                                                          NeverSupported,                                                                          AlwaysSupported),
+};
+// clang-format on
+
+constexpr uint32_t kInternalFormatHashMultiplier = 0x9E378257u;
+constexpr unsigned int kInternalFormatHashShift  = 22;
+
+// The internal format ID for each hash slot. Slots that no format hashes to hold ID 0.
+constexpr uint16_t kInternalFormatHashSlots[1024] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 60, 0,
+    0, 0, 0, 44, 0, 0, 0, 0, 0, 0, 0, 86, 124, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 64, 0, 0, 0, 0, 0,
+    0, 0, 121, 0, 0, 0, 0, 0, 0, 71, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0, 36, 0, 0, 0,
+    90, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 100, 0, 0, 0, 0, 0, 77, 113, 0, 0, 0, 0,
+    0, 0, 0, 0, 3, 0, 0, 88, 129, 0, 0, 0, 0, 0, 0, 0,
+    72, 18, 0, 0, 0, 28, 67, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 9, 0, 58, 0, 0, 0, 41, 0, 0, 24, 95, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 63,
+    105, 0, 0, 0, 0, 0, 78, 118, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 134, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 33, 0, 0, 0, 0, 0, 0, 0, 83, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    110, 0, 0, 0, 46, 0, 0, 0, 0, 2, 0, 70, 0, 0, 126, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 25, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 12, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 55, 0, 0, 0, 38, 0, 0,
+    0, 0, 92, 0, 0, 0, 84, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 102, 0, 48, 0, 0, 0, 0, 0, 115, 0, 0,
+    0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 131, 0, 0, 0, 0, 0,
+    0, 73, 0, 108, 0, 0, 30, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 13, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 75, 0, 0, 0, 0, 43, 0, 0, 0, 0, 0,
+    0, 0, 0, 123, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 107, 0, 0, 0, 0, 0, 0, 120, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 136, 0, 0, 0, 0, 0, 0, 0, 53,
+    0, 0, 0, 35, 0, 0, 0, 89, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 99, 0, 0, 0, 0,
+    0, 76, 112, 0, 0, 0, 0, 0, 0, 0, 0, 0, 51, 0, 87, 0,
+    128, 0, 0, 0, 0, 0, 137, 0, 17, 0, 0, 0, 27, 66, 0, 0,
+    0, 0, 0, 0, 81, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 57, 0, 0, 0, 40,
+    0, 0, 23, 94, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 104, 0, 50, 0, 0, 0, 0, 117, 0,
+    0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0, 0, 133, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 32, 0, 0, 0, 0, 0, 0, 0,
+    0, 82, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 61, 109, 0, 0, 45, 0, 0, 0, 0,
+    1, 0, 69, 0, 0, 125, 0, 0, 0, 0, 0, 0, 0, 15, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 122, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 37, 0, 0, 0, 0, 91, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 101, 47, 0,
+    0, 0, 0, 0, 114, 0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0,
+    0, 130, 0, 0, 0, 0, 0, 0, 0, 19, 0, 0, 0, 0, 29, 68,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 74, 59, 0, 0,
+    0, 42, 0, 0, 0, 96, 0, 0, 0, 0, 0, 0, 0, 0, 0, 21,
+    0, 0, 14, 0, 0, 62, 0, 0, 0, 106, 0, 0, 0, 97, 0, 79,
+    119, 0, 0, 0, 0, 0, 0, 0, 11, 0, 0, 0, 0, 0, 135, 0,
+    0, 0, 0, 0, 0, 0, 52, 0, 0, 0, 34, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 98, 0, 0, 0, 0, 0, 0, 111, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 127, 0, 0, 0, 0, 0, 0, 0, 16,
+    0, 0, 0, 26, 65, 0, 0, 0, 0, 0, 0, 80, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 56, 0, 0, 0, 39, 0, 0, 22, 0, 93, 0, 0, 0, 85,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 103, 0,
+    49, 0, 0, 0, 0, 0, 116, 0, 0, 0, 0, 0, 0, 0, 6, 0,
+    0, 0, 0, 132, 0, 0, 0, 0, 0, 0, 0, 20, 0, 0, 0, 31,
+};
@@ -0,0 +1,184 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ImageUploadPipeline:
+//   Implementation of the banded texture upload pipeline.
+//
+
+#include "libANGLE/renderer/ImageUploadPipeline.h"
+
+#include <algorithm>
+
+namespace rx
+{
+
+class ImageUploadPipeline::ConvertBandTask : public angle::Closure
+{
+  public:
+    ConvertBandTask()
+        : loadFunction(nullptr),
+          input(nullptr),
+          inputRowPitch(0),
+          inputDepthPitch(0),
+          output(nullptr),
+          outputRowPitch(0),
+          outputDepthPitch(0)
+    {
+    }
+
+    void operator()() override
+    {
+        const uint8_t *bandInput = input + area.z * inputDepthPitch + area.y * inputRowPitch;
+        loadFunction(area.width, area.height, area.depth, bandInput, inputRowPitch,
+                     inputDepthPitch, output, outputRowPitch, outputDepthPitch);
+    }
+
+    LoadImageFunction loadFunction;
+    gl::Box area;
+    const uint8_t *input;
+    size_t inputRowPitch;
+    size_t inputDepthPitch;
+    uint8_t *output;
+    size_t outputRowPitch;
+    size_t outputDepthPitch;
+};
+
+constexpr size_t ImageUploadPipeline::kStagingBufferCount;
+constexpr size_t ImageUploadPipeline::kDefaultBandSize;
+
+ImageUploadPipeline::ImageUploadPipeline(angle::WorkerThreadPool *workerPool,
+                                         ScratchBufferPool *scratchPool,
+                                         size_t bandSize)
+    : mWorkerPool(workerPool), mScratchPool(scratchPool), mBandSize(bandSize)
+{
+    ASSERT(mBandSize > 0);
+}
+
+ImageUploadPipeline::~ImageUploadPipeline()
+{
+}
+
+gl::Error ImageUploadPipeline::upload(const gl::Extents &size,
+                                      LoadImageFunction loadFunction,
+                                      const uint8_t *input,
+                                      size_t inputRowPitch,
+                                      size_t inputDepthPitch,
+                                      size_t outputPixelBytes,
+                                      CopyDelegate *copyDelegate)
+{
+    ASSERT(loadFunction && copyDelegate);
+
+    if (size.width == 0 || size.height == 0 || size.depth == 0)
+    {
+        return gl::NoError();
+    }
+
+    const size_t outputRowPitch = outputPixelBytes * size.width;
+    computeBands(size, outputRowPitch);
+
+    size_t largestBand = 0;
+    for (const gl::Box &band : mBands)
+    {
+        largestBand = std::max(largestBand, outputRowPitch * band.height * band.depth);
+    }
+
+    std::array<ScratchBufferLease, kStagingBufferCount> staging;
+    const size_t stagingCount = std::min(mBands.size(), kStagingBufferCount);
+    for (size_t stagingIndex = 0; stagingIndex < stagingCount; ++stagingIndex)
+    {
+        if (!mScratchPool->lease(largestBand, &staging[stagingIndex]))
+        {
+            return gl::Error(GL_OUT_OF_MEMORY, "Failed to allocate internal staging buffer.");
+        }
+    }
+
+    std::array<ConvertBandTask, kStagingBufferCount> tasks;
+    std::array<angle::WaitableEvent, kStagingBufferCount> events;
+
+    auto postBand = [&](size_t bandIndex) {
+        size_t slot           = bandIndex % kStagingBufferCount;
+        ConvertBandTask &task = tasks[slot];
+        task.loadFunction     = loadFunction;
+        task.area             = mBands[bandIndex];
+        task.input            = input;
+        task.inputRowPitch    = inputRowPitch;
+        task.inputDepthPitch  = inputDepthPitch;
+        task.output           = staging[slot].data();
+        task.outputRowPitch   = outputRowPitch;
+        task.outputDepthPitch = outputRowPitch * task.area.height;
+
+        // A single band gains nothing from a worker thread, so convert it inline.
+        if (mBands.size() == 1)
+        {
+            task();
+        }
+        else
+        {
+            events[slot] = mWorkerPool->postWorkerTask(&task);
+        }
+    };
+
+    postBand(0);
+
+    for (size_t bandIndex = 0; bandIndex < mBands.size(); ++bandIndex)
+    {
+        // Start converting the next band before copying this one. Its staging buffer was last
+        // used by band (bandIndex - 1), whose copy has already finished.
+        if (bandIndex + 1 < mBands.size())
+        {
+            postBand(bandIndex + 1);
+        }
+
+        size_t slot = bandIndex % kStagingBufferCount;
+        events[slot].wait();
+
+        const ConvertBandTask &task = tasks[slot];
+        gl::Error error = copyDelegate->copyBand(task.area, task.output, task.outputRowPitch,
+                                                 task.outputDepthPitch);
+        if (error.isError())
+        {
+            // Don't leave a worker writing into a staging buffer after we return.
+            for (angle::WaitableEvent &event : events)
+            {
+                event.wait();
+            }
+            return error;
+        }
+    }
+
+    return gl::NoError();
+}
+
+void ImageUploadPipeline::computeBands(const gl::Extents &size, size_t outputRowPitch)
+{
+    mBands.clear();
+
+    const size_t sliceBytes = outputRowPitch * size.height;
+
+    if (size.depth > 1 && sliceBytes <= mBandSize)
+    {
+        // Group whole slices together.
+        int slicesPerBand = static_cast<int>(std::max<size_t>(1, mBandSize / sliceBytes));
+        for (int z = 0; z < size.depth; z += slicesPerBand)
+        {
+            int depth = std::min(slicesPerBand, size.depth - z);
+            mBands.push_back(gl::Box(0, 0, z, size.width, size.height, depth));
+        }
+        return;
+    }
+
+    // Split each slice into bands of rows.
+    int rowsPerBand = static_cast<int>(std::max<size_t>(1, mBandSize / outputRowPitch));
+    for (int z = 0; z < size.depth; ++z)
+    {
+        for (int y = 0; y < size.height; y += rowsPerBand)
+        {
+            int height = std::min(rowsPerBand, size.height - y);
+            mBands.push_back(gl::Box(0, y, z, size.width, height, 1));
+        }
+    }
+}
+
+}  // namespace rx
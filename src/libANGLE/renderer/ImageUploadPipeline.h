@@ -0,0 +1,77 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ImageUploadPipeline:
+//   Splits large texture uploads that need a CPU format conversion into bands of rows (or
+//   slices). The conversion of band N+1 runs on a worker thread while the back-end copies band
+//   N out of a small, bounded set of staging buffers leased from a ScratchBufferPool.
+//
+
+#ifndef LIBANGLE_RENDERER_IMAGEUPLOADPIPELINE_H_
+#define LIBANGLE_RENDERER_IMAGEUPLOADPIPELINE_H_
+
+#include <array>
+#include <vector>
+
+#include "common/MemoryBuffer.h"
+#include "libANGLE/Error.h"
+#include "libANGLE/WorkerThread.h"
+#include "libANGLE/angletypes.h"
+#include "libANGLE/renderer/renderer_utils.h"
+
+namespace rx
+{
+
+class ImageUploadPipeline : angle::NonCopyable
+{
+  public:
+    // Receives each converted band on the thread that called upload(). |area| is relative to the
+    // origin of the uploaded region and |data| is tightly packed with the given pitches.
+    class CopyDelegate : angle::NonCopyable
+    {
+      public:
+        virtual ~CopyDelegate() {}
+        virtual gl::Error copyBand(const gl::Box &area,
+                                   const uint8_t *data,
+                                   size_t rowPitch,
+                                   size_t depthPitch) = 0;
+    };
+
+    // Two staging buffers are enough to keep one band converting while the other is copied.
+    static constexpr size_t kStagingBufferCount = 2;
+    // Target size of a single converted band. Uploads smaller than this are never split.
+    static constexpr size_t kDefaultBandSize = 1024 * 1024;
+
+    ImageUploadPipeline(angle::WorkerThreadPool *workerPool,
+                        ScratchBufferPool *scratchPool,
+                        size_t bandSize = kDefaultBandSize);
+    ~ImageUploadPipeline();
+
+    // Converts |size| pixels from |input| with |loadFunction| and passes the result to
+    // |copyDelegate| band by band. Only uncompressed formats can be split into bands.
+    gl::Error upload(const gl::Extents &size,
+                     LoadImageFunction loadFunction,
+                     const uint8_t *input,
+                     size_t inputRowPitch,
+                     size_t inputDepthPitch,
+                     size_t outputPixelBytes,
+                     CopyDelegate *copyDelegate);
+
+    size_t getBandCount() const { return mBands.size(); }
+
+  private:
+    class ConvertBandTask;
+
+    void computeBands(const gl::Extents &size, size_t outputRowPitch);
+
+    angle::WorkerThreadPool *mWorkerPool;
+    ScratchBufferPool *mScratchPool;
+    size_t mBandSize;
+    std::vector<gl::Box> mBands;
+};
+
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_IMAGEUPLOADPIPELINE_H_
@@ -0,0 +1,191 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ImageUploadPipeline_unittest:
+//   Tests that banded uploads reassemble into the same image as a single conversion.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "libANGLE/renderer/ImageUploadPipeline.h"
+
+using namespace rx;
+
+namespace
+{
+
+// Expands one byte per pixel into two: the value and its complement.
+void LoadExpand(size_t width,
+                size_t height,
+                size_t depth,
+                const uint8_t *input,
+                size_t inputRowPitch,
+                size_t inputDepthPitch,
+                uint8_t *output,
+                size_t outputRowPitch,
+                size_t outputDepthPitch)
+{
+    for (size_t z = 0; z < depth; z++)
+    {
+        for (size_t y = 0; y < height; y++)
+        {
+            const uint8_t *source = input + z * inputDepthPitch + y * inputRowPitch;
+            uint8_t *dest         = output + z * outputDepthPitch + y * outputRowPitch;
+            for (size_t x = 0; x < width; x++)
+            {
+                dest[x * 2]     = source[x];
+                dest[x * 2 + 1] = static_cast<uint8_t>(~source[x]);
+            }
+        }
+    }
+}
+
+class CollectingDelegate : public ImageUploadPipeline::CopyDelegate
+{
+  public:
+    CollectingDelegate(const gl::Extents &size)
+        : mSize(size), mData(size.width * 2 * size.height * size.depth, 0), mBandsCopied(0)
+    {
+    }
+
+    gl::Error copyBand(const gl::Box &area,
+                       const uint8_t *data,
+                       size_t rowPitch,
+                       size_t depthPitch) override
+    {
+        size_t destRowPitch   = mSize.width * 2;
+        size_t destDepthPitch = destRowPitch * mSize.height;
+        for (int z = 0; z < area.depth; z++)
+        {
+            for (int y = 0; y < area.height; y++)
+            {
+                const uint8_t *source = data + z * depthPitch + y * rowPitch;
+                uint8_t *dest = &mData[(area.z + z) * destDepthPitch + (area.y + y) * destRowPitch];
+                std::copy(source, source + area.width * 2, dest);
+            }
+        }
+        mBandsCopied++;
+        return gl::NoError();
+    }
+
+    gl::Extents mSize;
+    std::vector<uint8_t> mData;
+    size_t mBandsCopied;
+};
+
+class FailingDelegate : public ImageUploadPipeline::CopyDelegate
+{
+  public:
+    gl::Error copyBand(const gl::Box &, const uint8_t *, size_t, size_t) override
+    {
+        return gl::Error(GL_OUT_OF_MEMORY);
+    }
+};
+
+std::vector<uint8_t> MakeSource(const gl::Extents &size)
+{
+    std::vector<uint8_t> source(size.width * size.height * size.depth);
+    for (size_t i = 0; i < source.size(); i++)
+    {
+        source[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+    return source;
+}
+
+std::vector<uint8_t> ConvertWhole(const gl::Extents &size, const std::vector<uint8_t> &source)
+{
+    std::vector<uint8_t> expected(source.size() * 2);
+    LoadExpand(size.width, size.height, size.depth, source.data(), size.width,
+               size.width * size.height, expected.data(), size.width * 2,
+               size.width * 2 * size.height);
+    return expected;
+}
+
+// Tests that a 2D upload is split into row bands that reassemble correctly.
+TEST(ImageUploadPipelineTest, RowBands)
+{
+    angle::WorkerThreadPool workerPool(4);
+    ScratchBufferPool scratchPool;
+    ImageUploadPipeline pipeline(&workerPool, &scratchPool, 256);
+
+    gl::Extents size(37, 29, 1);
+    std::vector<uint8_t> source = MakeSource(size);
+    CollectingDelegate delegate(size);
+
+    EXPECT_FALSE(pipeline
+                     .upload(size, LoadExpand, source.data(), size.width,
+                             size.width * size.height, 2, &delegate)
+                     .isError());
+
+    EXPECT_GT(pipeline.getBandCount(), 1u);
+    EXPECT_EQ(pipeline.getBandCount(), delegate.mBandsCopied);
+    EXPECT_EQ(ConvertWhole(size, source), delegate.mData);
+}
+
+// Tests that small 3D slices are grouped into bands.
+TEST(ImageUploadPipelineTest, SliceBands)
+{
+    angle::WorkerThreadPool workerPool(4);
+    ScratchBufferPool scratchPool;
+    ImageUploadPipeline pipeline(&workerPool, &scratchPool, 256);
+
+    gl::Extents size(8, 4, 9);
+    std::vector<uint8_t> source = MakeSource(size);
+    CollectingDelegate delegate(size);
+
+    EXPECT_FALSE(pipeline
+                     .upload(size, LoadExpand, source.data(), size.width,
+                             size.width * size.height, 2, &delegate)
+                     .isError());
+
+    EXPECT_EQ(3u, pipeline.getBandCount());
+    EXPECT_EQ(ConvertWhole(size, source), delegate.mData);
+}
+
+// Tests that staging buffers are bounded and reused across uploads.
+TEST(ImageUploadPipelineTest, StagingReuse)
+{
+    angle::WorkerThreadPool workerPool(4);
+    ScratchBufferPool scratchPool;
+    ImageUploadPipeline pipeline(&workerPool, &scratchPool, 256);
+
+    gl::Extents size(64, 64, 1);
+    std::vector<uint8_t> source = MakeSource(size);
+
+    for (int iteration = 0; iteration < 3; iteration++)
+    {
+        CollectingDelegate delegate(size);
+        EXPECT_FALSE(pipeline
+                         .upload(size, LoadExpand, source.data(), size.width,
+                                 size.width * size.height, 2, &delegate)
+                         .isError());
+        EXPECT_EQ(ConvertWhole(size, source), delegate.mData);
+    }
+
+    const ScratchBufferPool::Counters &counters = scratchPool.getCounters();
+    EXPECT_EQ(3 * ImageUploadPipeline::kStagingBufferCount, counters.leases);
+    EXPECT_EQ(ImageUploadPipeline::kStagingBufferCount, counters.allocations);
+    EXPECT_EQ(ImageUploadPipeline::kStagingBufferCount * 256, counters.peakLeasedBytes);
+    EXPECT_EQ(0u, counters.leasedBytes);
+}
+
+// Tests that copy errors stop the upload and are returned.
+TEST(ImageUploadPipelineTest, CopyError)
+{
+    angle::WorkerThreadPool workerPool(4);
+    ScratchBufferPool scratchPool;
+    ImageUploadPipeline pipeline(&workerPool, &scratchPool, 256);
+
+    gl::Extents size(64, 64, 1);
+    std::vector<uint8_t> source = MakeSource(size);
+    FailingDelegate delegate;
+
+    gl::Error error = pipeline.upload(size, LoadExpand, source.data(), size.width,
+                                      size.width * size.height, 2, &delegate);
+    EXPECT_EQ(static_cast<GLenum>(GL_OUT_OF_MEMORY), error.getCode());
+}
+
+}  // anonymous namespace
@@ -0,0 +1,290 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SubImageUploadQueue:
+//   Implementation of the sub-image upload coalescing queue.
+//
+
+#include "libANGLE/renderer/SubImageUploadQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/debug.h"
+#include "libANGLE/formatutils.h"
+
+namespace rx
+{
+
+namespace
+{
+
+size_t GetPixelBytes(GLenum format, GLenum type)
+{
+    const gl::InternalFormat &formatInfo =
+        gl::GetInternalFormatInfo(gl::GetSizedInternalFormat(format, type));
+    return formatInfo.computePixelBytes(type);
+}
+
+size_t GetAreaBytes(const gl::Box &area, size_t pixelBytes)
+{
+    return pixelBytes * area.width * area.height * area.depth;
+}
+
+bool Covers(const gl::Box &outer, const gl::Box &inner)
+{
+    return inner.x >= outer.x && inner.x + inner.width <= outer.x + outer.width &&
+           inner.y >= outer.y && inner.y + inner.height <= outer.y + outer.height &&
+           inner.z >= outer.z && inner.z + inner.depth <= outer.z + outer.depth;
+}
+
+// True if the two spans overlap or are adjacent.
+bool SpansTouch(int startA, int sizeA, int startB, int sizeB)
+{
+    return startA <= startB + sizeB && startB <= startA + sizeA;
+}
+
+bool SpansOverlap(int startA, int sizeA, int startB, int sizeB)
+{
+    return startA < startB + sizeB && startB < startA + sizeA;
+}
+
+bool Intersects(const gl::Box &a, const gl::Box &b)
+{
+    return SpansOverlap(a.x, a.width, b.x, b.width) && SpansOverlap(a.y, a.height, b.y, b.height) &&
+           SpansOverlap(a.z, a.depth, b.z, b.depth);
+}
+
+// The bounding box of two areas is exactly covered by them if one contains the other, or if they
+// share their extent along two axes and overlap or touch along the third.
+bool CanMerge(const gl::Box &a, const gl::Box &b)
+{
+    if (Covers(a, b) || Covers(b, a))
+    {
+        return true;
+    }
+
+    bool sameX = a.x == b.x && a.width == b.width;
+    bool sameY = a.y == b.y && a.height == b.height;
+    bool sameZ = a.z == b.z && a.depth == b.depth;
+
+    return (sameY && sameZ && SpansTouch(a.x, a.width, b.x, b.width)) ||
+           (sameX && sameZ && SpansTouch(a.y, a.height, b.y, b.height)) ||
+           (sameX && sameY && SpansTouch(a.z, a.depth, b.z, b.depth));
+}
+
+gl::Box Union(const gl::Box &a, const gl::Box &b)
+{
+    int x0 = std::min(a.x, b.x);
+    int y0 = std::min(a.y, b.y);
+    int z0 = std::min(a.z, b.z);
+    int x1 = std::max(a.x + a.width, b.x + b.width);
+    int y1 = std::max(a.y + a.height, b.y + b.height);
+    int z1 = std::max(a.z + a.depth, b.z + b.depth);
+    return gl::Box(x0, y0, z0, x1 - x0, y1 - y0, z1 - z0);
+}
+
+}  // anonymous namespace
+
+// Definitions for the ODR-used constants.
+constexpr size_t SubImageUploadQueue::kMaxQueuedUploadBytes;
+constexpr size_t SubImageUploadQueue::kMaxPendingBytes;
+constexpr size_t SubImageUploadQueue::kMaxPendingUploads;
+
+SubImageUploadQueue::SubImageUploadQueue()
+    : mFormat(GL_NONE), mType(GL_NONE), mPixelBytes(0), mPendingBytes(0)
+{
+}
+
+SubImageUploadQueue::~SubImageUploadQueue()
+{
+}
+
+// static
+bool SubImageUploadQueue::IsQueueable(const gl::Box &area, GLenum format, GLenum type)
+{
+    size_t areaBytes = GetAreaBytes(area, GetPixelBytes(format, type));
+    return areaBytes > 0 && areaBytes <= kMaxQueuedUploadBytes;
+}
+
+bool SubImageUploadQueue::canQueue(const gl::Box &area, GLenum format, GLenum type) const
+{
+    if (mUploads.empty())
+    {
+        return true;
+    }
+
+    return format == mFormat && type == mType && mUploads.size() < kMaxPendingUploads &&
+           mPendingBytes + GetAreaBytes(area, mPixelBytes) <= kMaxPendingBytes;
+}
+
+gl::Error SubImageUploadQueue::queue(const gl::Box &area,
+                                     GLenum format,
+                                     GLenum type,
+                                     const gl::PixelUnpackState &unpack,
+                                     bool is3D,
+                                     const uint8_t *pixels)
+{
+    ASSERT(canQueue(area, format, type) && unpack.pixelBuffer.get() == nullptr);
+
+    const gl::InternalFormat &formatInfo =
+        gl::GetInternalFormatInfo(gl::GetSizedInternalFormat(format, type));
+    GLuint rowBytes = 0;
+    ANGLE_TRY_RESULT(formatInfo.computeRowPitch(type, area.width, unpack.alignment, unpack.rowLength),
+                     rowBytes);
+    GLuint imageBytes = 0;
+    ANGLE_TRY_RESULT(formatInfo.computeDepthPitch(area.height, unpack.imageHeight, rowBytes),
+                     imageBytes);
+    GLuint skipBytes = 0;
+    ANGLE_TRY_RESULT(formatInfo.computeSkipBytes(rowBytes, imageBytes, unpack, is3D), skipBytes);
+
+    mFormat     = format;
+    mType       = type;
+    mPixelBytes = formatInfo.computePixelBytes(type);
+
+    Upload upload;
+    upload.area = area;
+    upload.pixels.resize(GetAreaBytes(area, mPixelBytes));
+
+    size_t packedRowBytes   = mPixelBytes * area.width;
+    size_t packedImageBytes = packedRowBytes * area.height;
+    const uint8_t *source   = pixels + skipBytes;
+    for (int z = 0; z < area.depth; z++)
+    {
+        for (int y = 0; y < area.height; y++)
+        {
+            memcpy(&upload.pixels[z * packedImageBytes + y * packedRowBytes],
+                   source + z * imageBytes + y * rowBytes, packedRowBytes);
+        }
+    }
+
+    mPendingBytes += upload.pixels.size();
+    mUploads.push_back(std::move(upload));
+
+    return gl::NoError();
+}
+
+gl::Error SubImageUploadQueue::flush(UploadDelegate *delegate)
+{
+    std::vector<gl::Box> areas;
+    for (const Upload &upload : mUploads)
+    {
+        areas.push_back(upload.area);
+    }
+
+    // Every coalesced area gets the final contents of all of its pixels, so areas that still
+    // overlap each other can be uploaded in any order.
+    gl::Error error = gl::NoError();
+    std::vector<uint8_t> staging;
+    for (const gl::Box &area : CoalesceUploadAreas(areas))
+    {
+        const Upload *onlyUpload = nullptr;
+        size_t intersectingCount = 0;
+        for (const Upload &upload : mUploads)
+        {
+            if (Intersects(upload.area, area))
+            {
+                onlyUpload = &upload;
+                intersectingCount++;
+            }
+        }
+
+        if (intersectingCount == 1 && onlyUpload->area == area)
+        {
+            error = delegate->uploadArea(area, onlyUpload->pixels.data());
+        }
+        else
+        {
+            staging.resize(GetAreaBytes(area, mPixelBytes));
+            for (const Upload &upload : mUploads)
+            {
+                copyIntersection(upload, area, staging.data());
+            }
+            error = delegate->uploadArea(area, staging.data());
+        }
+
+        if (error.isError())
+        {
+            break;
+        }
+    }
+
+    clear();
+    return error;
+}
+
+void SubImageUploadQueue::clear()
+{
+    mUploads.clear();
+    mPendingBytes = 0;
+}
+
+void SubImageUploadQueue::copyIntersection(const Upload &upload,
+                                           const gl::Box &area,
+                                           uint8_t *dest) const
+{
+    if (!Intersects(upload.area, area))
+    {
+        return;
+    }
+
+    int x0 = std::max(upload.area.x, area.x);
+    int y0 = std::max(upload.area.y, area.y);
+    int z0 = std::max(upload.area.z, area.z);
+    int x1 = std::min(upload.area.x + upload.area.width, area.x + area.width);
+    int y1 = std::min(upload.area.y + upload.area.height, area.y + area.height);
+    int z1 = std::min(upload.area.z + upload.area.depth, area.z + area.depth);
+
+    size_t sourceRowBytes   = mPixelBytes * upload.area.width;
+    size_t sourceImageBytes = sourceRowBytes * upload.area.height;
+    size_t destRowBytes     = mPixelBytes * area.width;
+    size_t destImageBytes   = destRowBytes * area.height;
+    size_t copyBytes        = mPixelBytes * (x1 - x0);
+
+    for (int z = z0; z < z1; z++)
+    {
+        for (int y = y0; y < y1; y++)
+        {
+            const uint8_t *source = upload.pixels.data() +
+                                    (z - upload.area.z) * sourceImageBytes +
+                                    (y - upload.area.y) * sourceRowBytes +
+                                    (x0 - upload.area.x) * mPixelBytes;
+            uint8_t *destRow = dest + (z - area.z) * destImageBytes + (y - area.y) * destRowBytes +
+                               (x0 - area.x) * mPixelBytes;
+            memcpy(destRow, source, copyBytes);
+        }
+    }
+}
+
+std::vector<gl::Box> CoalesceUploadAreas(const std::vector<gl::Box> &areas)
+{
+    std::vector<gl::Box> result = areas;
+
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (size_t i = 0; i < result.size(); i++)
+        {
+            for (size_t j = i + 1; j < result.size();)
+            {
+                if (CanMerge(result[i], result[j]))
+                {
+                    result[i] = Union(result[i], result[j]);
+                    result.erase(result.begin() + j);
+                    merged = true;
+                }
+                else
+                {
+                    j++;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+}  // namespace rx
@@ -0,0 +1,92 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SubImageUploadQueue:
+//   Holds back small sub-image uploads from client memory to a single image so that runs of
+//   overlapping or adjacent updates (glyph caches, sprite atlases) reach the back-end as a few
+//   larger uploads instead of one call per update.
+//
+
+#ifndef LIBANGLE_RENDERER_SUBIMAGEUPLOADQUEUE_H_
+#define LIBANGLE_RENDERER_SUBIMAGEUPLOADQUEUE_H_
+
+#include <vector>
+
+#include "angle_gl.h"
+#include "libANGLE/Error.h"
+#include "libANGLE/angletypes.h"
+
+namespace rx
+{
+
+class SubImageUploadQueue : angle::NonCopyable
+{
+  public:
+    // Receives each coalesced area when the queue is flushed. |pixels| are tightly packed.
+    class UploadDelegate : angle::NonCopyable
+    {
+      public:
+        virtual ~UploadDelegate() {}
+        virtual gl::Error uploadArea(const gl::Box &area, const uint8_t *pixels) = 0;
+    };
+
+    // Uploads larger than this are cheaper to pass through than to copy.
+    static constexpr size_t kMaxQueuedUploadBytes = 64 * 1024;
+    // Bounds the memory held by the queue and the cost of coalescing.
+    static constexpr size_t kMaxPendingBytes   = 4 * 1024 * 1024;
+    static constexpr size_t kMaxPendingUploads = 128;
+
+    SubImageUploadQueue();
+    ~SubImageUploadQueue();
+
+    // True if an upload of |area| is small enough to be worth queueing at all.
+    static bool IsQueueable(const gl::Box &area, GLenum format, GLenum type);
+
+    bool empty() const { return mUploads.empty(); }
+    GLenum getFormat() const { return mFormat; }
+    GLenum getType() const { return mType; }
+    size_t getPendingBytes() const { return mPendingBytes; }
+    size_t getPendingUploadCount() const { return mUploads.size(); }
+
+    // True if an upload of |area| with |format| and |type| can be added without flushing first.
+    bool canQueue(const gl::Box &area, GLenum format, GLenum type) const;
+
+    // Copies |area| out of client memory laid out according to |unpack|.
+    gl::Error queue(const gl::Box &area,
+                    GLenum format,
+                    GLenum type,
+                    const gl::PixelUnpackState &unpack,
+                    bool is3D,
+                    const uint8_t *pixels);
+
+    // Coalesces the queued uploads into as few fully covered areas as possible and passes each of
+    // them to |delegate| in the queue's format and type. The queue is empty afterwards.
+    gl::Error flush(UploadDelegate *delegate);
+
+    void clear();
+
+  private:
+    struct Upload
+    {
+        gl::Box area;
+        std::vector<uint8_t> pixels;
+    };
+
+    void copyIntersection(const Upload &upload, const gl::Box &area, uint8_t *dest) const;
+
+    GLenum mFormat;
+    GLenum mType;
+    size_t mPixelBytes;
+    size_t mPendingBytes;
+    std::vector<Upload> mUploads;
+};
+
+// Merges |areas| whenever the bounding box of two of them is exactly covered by the pair, until
+// no more merges are possible. The union of the result is the union of the input.
+std::vector<gl::Box> CoalesceUploadAreas(const std::vector<gl::Box> &areas);
+
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_SUBIMAGEUPLOADQUEUE_H_
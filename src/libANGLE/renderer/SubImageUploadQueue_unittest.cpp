@@ -0,0 +1,164 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SubImageUploadQueue_unittest:
+//   Tests that queued sub-image uploads coalesce into fewer uploads with the same result.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "libANGLE/renderer/SubImageUploadQueue.h"
+
+using namespace rx;
+
+namespace
+{
+
+constexpr int kImageSize = 32;
+
+// Applies uploads of one byte per pixel to a kImageSize x kImageSize image.
+class ImageDelegate : public SubImageUploadQueue::UploadDelegate
+{
+  public:
+    ImageDelegate() : mImage(kImageSize * kImageSize, 0) {}
+
+    gl::Error uploadArea(const gl::Box &area, const uint8_t *pixels) override
+    {
+        Apply(area, pixels, area.width, &mImage);
+        mAreas.push_back(area);
+        return gl::NoError();
+    }
+
+    static void Apply(const gl::Box &area,
+                      const uint8_t *pixels,
+                      size_t rowPitch,
+                      std::vector<uint8_t> *image)
+    {
+        for (int y = 0; y < area.height; y++)
+        {
+            for (int x = 0; x < area.width; x++)
+            {
+                (*image)[(area.y + y) * kImageSize + area.x + x] = pixels[y * rowPitch + x];
+            }
+        }
+    }
+
+    std::vector<uint8_t> mImage;
+    std::vector<gl::Box> mAreas;
+};
+
+// Queues an upload of |area| filled with |value| and applies it to |expected| directly.
+void QueueFill(SubImageUploadQueue *queue,
+               const gl::Box &area,
+               uint8_t value,
+               std::vector<uint8_t> *expected)
+{
+    gl::PixelUnpackState unpack(1, 0);
+    std::vector<uint8_t> pixels(area.width * area.height, value);
+    ASSERT_TRUE(queue->canQueue(area, GL_ALPHA, GL_UNSIGNED_BYTE));
+    ASSERT_FALSE(
+        queue->queue(area, GL_ALPHA, GL_UNSIGNED_BYTE, unpack, false, pixels.data()).isError());
+    ImageDelegate::Apply(area, pixels.data(), area.width, expected);
+}
+
+// Tests that a row of adjacent glyphs and the rows below it merge into one upload.
+TEST(SubImageUploadQueueTest, AdjacentUploadsMerge)
+{
+    SubImageUploadQueue queue;
+    std::vector<uint8_t> expected(kImageSize * kImageSize, 0);
+
+    for (int row = 0; row < 2; row++)
+    {
+        for (int glyph = 0; glyph < 4; glyph++)
+        {
+            QueueFill(&queue, gl::Box(glyph * 8, row * 8, 0, 8, 8, 1),
+                      static_cast<uint8_t>(row * 4 + glyph + 1), &expected);
+        }
+    }
+    EXPECT_EQ(8u, queue.getPendingUploadCount());
+
+    ImageDelegate delegate;
+    EXPECT_FALSE(queue.flush(&delegate).isError());
+    ASSERT_EQ(1u, delegate.mAreas.size());
+    EXPECT_EQ(gl::Box(0, 0, 0, 32, 16, 1), delegate.mAreas[0]);
+    EXPECT_EQ(expected, delegate.mImage);
+    EXPECT_TRUE(queue.empty());
+}
+
+// Tests that later uploads win where uploads overlap, even across areas that can't be merged.
+TEST(SubImageUploadQueueTest, OverlappingUploadsKeepOrder)
+{
+    SubImageUploadQueue queue;
+    std::vector<uint8_t> expected(kImageSize * kImageSize, 0);
+
+    QueueFill(&queue, gl::Box(0, 0, 0, 10, 10, 1), 1, &expected);
+    QueueFill(&queue, gl::Box(5, 5, 0, 10, 10, 1), 2, &expected);
+    QueueFill(&queue, gl::Box(2, 2, 0, 4, 4, 1), 3, &expected);
+    QueueFill(&queue, gl::Box(2, 2, 0, 4, 4, 1), 4, &expected);
+
+    ImageDelegate delegate;
+    EXPECT_FALSE(queue.flush(&delegate).isError());
+    EXPECT_EQ(2u, delegate.mAreas.size());
+    EXPECT_EQ(expected, delegate.mImage);
+}
+
+// Tests that uploads are read according to the unpack state.
+TEST(SubImageUploadQueueTest, UnpackState)
+{
+    SubImageUploadQueue queue;
+
+    // Rows of 3 pixels padded to 4 bytes, skipping the first row and pixel.
+    gl::PixelUnpackState unpack(4, 0);
+    unpack.skipRows   = 1;
+    unpack.skipPixels = 1;
+    std::vector<uint8_t> pixels(4 * 3, 0);
+    pixels[5]  = 7;
+    pixels[10] = 9;
+
+    gl::Box area(1, 1, 0, 2, 2, 1);
+    ASSERT_FALSE(queue.queue(area, GL_ALPHA, GL_UNSIGNED_BYTE, unpack, false, pixels.data())
+                     .isError());
+
+    ImageDelegate delegate;
+    EXPECT_FALSE(queue.flush(&delegate).isError());
+    EXPECT_EQ(7u, delegate.mImage[1 * kImageSize + 1]);
+    EXPECT_EQ(9u, delegate.mImage[2 * kImageSize + 2]);
+}
+
+// Tests the limits that force a flush before queueing.
+TEST(SubImageUploadQueueTest, Limits)
+{
+    SubImageUploadQueue queue;
+    std::vector<uint8_t> expected(kImageSize * kImageSize, 0);
+
+    EXPECT_FALSE(SubImageUploadQueue::IsQueueable(gl::Box(0, 0, 0, 1024, 1024, 1), GL_RGBA,
+                                                  GL_UNSIGNED_BYTE));
+    EXPECT_FALSE(
+        SubImageUploadQueue::IsQueueable(gl::Box(0, 0, 0, 0, 0, 1), GL_RGBA, GL_UNSIGNED_BYTE));
+
+    QueueFill(&queue, gl::Box(0, 0, 0, 1, 1, 1), 1, &expected);
+    EXPECT_FALSE(queue.canQueue(gl::Box(1, 0, 0, 1, 1, 1), GL_LUMINANCE, GL_UNSIGNED_BYTE));
+
+    for (size_t i = 1; i < SubImageUploadQueue::kMaxPendingUploads; i++)
+    {
+        QueueFill(&queue, gl::Box(0, 0, 0, 1, 1, 1), 1, &expected);
+    }
+    EXPECT_FALSE(queue.canQueue(gl::Box(0, 0, 0, 1, 1, 1), GL_ALPHA, GL_UNSIGNED_BYTE));
+}
+
+// Tests that areas are only merged when their bounding box is fully covered.
+TEST(SubImageUploadQueueTest, CoalesceOnlyCoveredAreas)
+{
+    std::vector<gl::Box> areas = {gl::Box(0, 0, 0, 4, 4, 1), gl::Box(4, 0, 0, 4, 4, 1),
+                                  gl::Box(0, 8, 0, 4, 4, 1), gl::Box(1, 1, 0, 2, 2, 1)};
+    std::vector<gl::Box> coalesced = CoalesceUploadAreas(areas);
+
+    ASSERT_EQ(2u, coalesced.size());
+    EXPECT_EQ(gl::Box(0, 0, 0, 8, 4, 1), coalesced[0]);
+    EXPECT_EQ(gl::Box(0, 8, 0, 4, 4, 1), coalesced[1]);
+}
+
+}  // anonymous namespace
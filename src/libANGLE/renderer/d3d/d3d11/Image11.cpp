@@ -370,15 +370,20 @@ gl::Error Image11::copyFromFramebuffer(const gl::Offset &destOffset,
     if (loadFunction.requiresConversion)
     {
         size_t bufferSize = destFormatInfo.pixelBytes * sourceArea.width * sourceArea.height;
-        MemoryBuffer *memoryBuffer = nullptr;
-        mRenderer->getScratchMemoryBuffer(bufferSize, &memoryBuffer);
+        ScratchBufferLease memoryBuffer;
+        error = mRenderer->getScratchMemoryBuffer(bufferSize, &memoryBuffer);
+        if (error.isError())
+        {
+            unmap();
+            return error;
+        }
         GLuint memoryBufferRowPitch = destFormatInfo.pixelBytes * sourceArea.width;
 
         error = mRenderer->readFromAttachment(*srcAttachment, sourceArea, destFormatInfo.format,
                                               destFormatInfo.type, memoryBufferRowPitch,
-                                              gl::PixelPackState(), memoryBuffer->data());
+                                              gl::PixelPackState(), memoryBuffer.data());
 
-        loadFunction.loadFunction(sourceArea.width, sourceArea.height, 1, memoryBuffer->data(),
+        loadFunction.loadFunction(sourceArea.width, sourceArea.height, 1, memoryBuffer.data(),
                                   memoryBufferRowPitch, 0, dataOffset, mappedImage.RowPitch,
                                   mappedImage.DepthPitch);
     }
@@ -377,11 +377,6 @@ int GetWrapBits(GLenum wrap)
     }
 }
 
-// If we request a scratch buffer requesting a smaller size this many times,
-// release and recreate the scratch buffer. This ensures we don't have a
-// degenerate case where we are stuck hogging memory.
-const int ScratchMemoryBufferLifetime = 1000;
-
 }  // anonymous namespace
 
 Renderer11::Renderer11(egl::Display *display)
@@ -390,7 +385,7 @@ Renderer11::Renderer11(egl::Display *display)
       mStateManager(this),
       mLastHistogramUpdateTime(ANGLEPlatformCurrent()->monotonicallyIncreasingTime()),
       mDebug(nullptr),
-      mScratchMemoryBufferResetCounter(0),
+      mImageUploadPipeline(getWorkerThreadPool(), &mScratchBufferPool),
       mAnnotator(nullptr)
 {
     mVertexDataManager = NULL;
@@ -2693,7 +2688,7 @@ void Renderer11::release()
 {
     RendererD3D::cleanup();
 
-    mScratchMemoryBuffer.resize(0);
+    mScratchBufferPool.clear();
 
     if (mAnnotator != nullptr)
     {
@@ -4286,6 +4281,16 @@ void Renderer11::updateHistograms()
         ANGLE_HISTOGRAM_MEMORY_MB("GPU.ANGLE.Buffer11CPUMemoryMB",
                                   static_cast<int>(sizeSum) / kOneMegaByte);
     }
+
+    // Update the scratch buffer pool histograms
+    {
+        const ScratchBufferPool::Counters &counters = mScratchBufferPool.getCounters();
+        const int kOneKiloByte                      = 1024;
+        ANGLE_HISTOGRAM_MEMORY_KB("GPU.ANGLE.Renderer11ScratchPeakMemoryKB",
+                                  static_cast<int>(counters.peakLeasedBytes / kOneKiloByte));
+        ANGLE_HISTOGRAM_COUNTS("GPU.ANGLE.Renderer11ScratchAllocations",
+                               static_cast<int>(counters.allocations));
+    }
 }
 
 void Renderer11::onBufferCreate(const Buffer11 *created)
@@ -4552,33 +4557,13 @@ FramebufferImpl *Renderer11::createDefaultFramebuffer(const gl::FramebufferState
     return new Framebuffer11(state, this);
 }
 
-gl::Error Renderer11::getScratchMemoryBuffer(size_t requestedSize, MemoryBuffer **bufferOut)
+gl::Error Renderer11::getScratchMemoryBuffer(size_t requestedSize, ScratchBufferLease *leaseOut)
 {
-    if (mScratchMemoryBuffer.size() == requestedSize)
-    {
-        mScratchMemoryBufferResetCounter = ScratchMemoryBufferLifetime;
-        *bufferOut                       = &mScratchMemoryBuffer;
-        return gl::NoError();
-    }
-
-    if (mScratchMemoryBuffer.size() > requestedSize)
+    if (!mScratchBufferPool.lease(requestedSize, leaseOut))
     {
-        mScratchMemoryBufferResetCounter--;
+        return gl::Error(GL_OUT_OF_MEMORY, "Failed to allocate internal buffer.");
     }
 
-    if (mScratchMemoryBufferResetCounter <= 0 || mScratchMemoryBuffer.size() < requestedSize)
-    {
-        mScratchMemoryBuffer.resize(0);
-        if (!mScratchMemoryBuffer.resize(requestedSize))
-        {
-            return gl::Error(GL_OUT_OF_MEMORY, "Failed to allocate internal buffer.");
-        }
-        mScratchMemoryBufferResetCounter = ScratchMemoryBufferLifetime;
-    }
-
-    ASSERT(mScratchMemoryBuffer.size() >= requestedSize);
-
-    *bufferOut = &mScratchMemoryBuffer;
     return gl::NoError();
 }
 
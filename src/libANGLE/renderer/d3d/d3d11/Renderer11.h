@@ -13,6 +13,7 @@
 #include "common/mathutil.h"
 #include "libANGLE/AttributeMap.h"
 #include "libANGLE/angletypes.h"
+#include "libANGLE/renderer/ImageUploadPipeline.h"
 #include "libANGLE/renderer/d3d/HLSLCompiler.h"
 #include "libANGLE/renderer/d3d/ProgramD3D.h"
 #include "libANGLE/renderer/d3d/RendererD3D.h"
@@ -373,7 +374,8 @@ class Renderer11 : public RendererD3D
     // Necessary hack for default framebuffers in D3D.
     FramebufferImpl *createDefaultFramebuffer(const gl::FramebufferState &state) override;
 
-    gl::Error getScratchMemoryBuffer(size_t requestedSize, MemoryBuffer **bufferOut);
+    gl::Error getScratchMemoryBuffer(size_t requestedSize, ScratchBufferLease *leaseOut);
+    ImageUploadPipeline *getImageUploadPipeline() { return &mImageUploadPipeline; }
 
     gl::Version getMaxSupportedESVersion() const override;
 
@@ -569,8 +571,9 @@ class Renderer11 : public RendererD3D
 
     std::vector<GLuint> mScratchIndexDataBuffer;
 
-    MemoryBuffer mScratchMemoryBuffer;
-    unsigned int mScratchMemoryBufferResetCounter;
+    ScratchBufferPool mScratchBufferPool;
+
+    ImageUploadPipeline mImageUploadPipeline;
 
     gl::DebugAnnotator *mAnnotator;
 
@@ -16,6 +16,7 @@
 #include "common/utilities.h"
 #include "libANGLE/formatutils.h"
 #include "libANGLE/ImageIndex.h"
+#include "libANGLE/renderer/ImageUploadPipeline.h"
 #include "libANGLE/renderer/d3d/d3d11/Blit11.h"
 #include "libANGLE/renderer/d3d/d3d11/formatutils11.h"
 #include "libANGLE/renderer/d3d/d3d11/Image11.h"
@@ -31,6 +32,48 @@
 namespace rx
 {
 
+namespace
+{
+
+// Copies each converted band of a pipelined upload into the destination subresource.
+class UpdateSubresourceBandDelegate : public ImageUploadPipeline::CopyDelegate
+{
+  public:
+    UpdateSubresourceBandDelegate(ID3D11DeviceContext *context,
+                                  ID3D11Resource *resource,
+                                  UINT subresource,
+                                  const gl::Offset &destOffset)
+        : mContext(context), mResource(resource), mSubresource(subresource), mDestOffset(destOffset)
+    {
+    }
+
+    gl::Error copyBand(const gl::Box &area,
+                       const uint8_t *data,
+                       size_t rowPitch,
+                       size_t depthPitch) override
+    {
+        D3D11_BOX destD3DBox;
+        destD3DBox.left   = mDestOffset.x + area.x;
+        destD3DBox.right  = destD3DBox.left + area.width;
+        destD3DBox.top    = mDestOffset.y + area.y;
+        destD3DBox.bottom = destD3DBox.top + area.height;
+        destD3DBox.front  = mDestOffset.z + area.z;
+        destD3DBox.back   = destD3DBox.front + area.depth;
+
+        mContext->UpdateSubresource(mResource, mSubresource, &destD3DBox, data,
+                                    static_cast<UINT>(rowPitch), static_cast<UINT>(depthPitch));
+        return gl::NoError();
+    }
+
+  private:
+    ID3D11DeviceContext *mContext;
+    ID3D11Resource *mResource;
+    UINT mSubresource;
+    gl::Offset mDestOffset;
+};
+
+}  // anonymous namespace
+
 TextureStorage11::SRVKey::SRVKey(int baseLevel, int mipLevels, bool swizzle, bool dropStencil)
     : baseLevel(baseLevel), mipLevels(mipLevels), swizzle(swizzle), dropStencil(dropStencil)
 {
@@ -641,18 +684,36 @@ gl::Error TextureStorage11::setData(const gl::ImageIndex &index,
     UINT bufferRowPitch   = static_cast<unsigned int>(outputPixelSize) * width;
     UINT bufferDepthPitch = bufferRowPitch * height;
 
-    const size_t neededSize        = bufferDepthPitch * depth;
-    MemoryBuffer *conversionBuffer = nullptr;
-    const uint8_t *data            = nullptr;
+    const size_t neededSize = bufferDepthPitch * depth;
+    ScratchBufferLease conversionBuffer;
+    const uint8_t *data = nullptr;
+
+    ID3D11DeviceContext *immediateContext = mRenderer->getDeviceContext();
 
     LoadImageFunctionInfo loadFunctionInfo = d3d11Format.getLoadFunctions()(type);
+
+    // Color conversions are split into bands so the CPU conversion overlaps the copy to the GPU.
+    // Depth/stencil resources can't be updated with a destination box, so they are converted in
+    // one go below.
+    if (loadFunctionInfo.requiresConversion && internalFormatInfo.depthBits == 0 &&
+        internalFormatInfo.stencilBits == 0)
+    {
+        gl::Offset destOffset =
+            destBox ? gl::Offset(destBox->x, destBox->y, destBox->z) : gl::Offset();
+        UpdateSubresourceBandDelegate copyDelegate(immediateContext, resource, destSubresource,
+                                                   destOffset);
+        return mRenderer->getImageUploadPipeline()->upload(
+            gl::Extents(width, height, depth), loadFunctionInfo.loadFunction,
+            pixelData + srcSkipBytes, srcRowPitch, srcDepthPitch, outputPixelSize, &copyDelegate);
+    }
+
     if (loadFunctionInfo.requiresConversion)
     {
         ANGLE_TRY(mRenderer->getScratchMemoryBuffer(neededSize, &conversionBuffer));
         loadFunctionInfo.loadFunction(width, height, depth, pixelData + srcSkipBytes, srcRowPitch,
-                                      srcDepthPitch, conversionBuffer->data(), bufferRowPitch,
+                                      srcDepthPitch, conversionBuffer.data(), bufferRowPitch,
                                       bufferDepthPitch);
-        data = conversionBuffer->data();
+        data = conversionBuffer.data();
     }
     else
     {
@@ -661,8 +722,6 @@ gl::Error TextureStorage11::setData(const gl::ImageIndex &index,
         bufferDepthPitch = srcDepthPitch;
     }
 
-    ID3D11DeviceContext *immediateContext = mRenderer->getDeviceContext();
-
     if (!fullUpdate)
     {
         ASSERT(destBox);
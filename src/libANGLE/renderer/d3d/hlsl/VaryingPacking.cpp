@@ -43,7 +43,7 @@ void VaryingPacking::BuiltinVarying::enable(const std::string &semanticVal, unsi
 
 // Implementation of VaryingPacking
 VaryingPacking::VaryingPacking(GLuint maxVaryingVectors)
-    : mRegisterMap(maxVaryingVectors), mBuiltinInfo(SHADER_TYPE_MAX)
+    : mRegisters(maxVaryingVectors), mBuiltinInfo(SHADER_TYPE_MAX)
 {
 }
 
@@ -67,7 +67,7 @@ bool VaryingPacking::packVarying(const PackedVarying &packedVarying)
     // "Arrays of size N are assumed to take N times the size of the base type"
     varyingRows *= varying.elementCount();
 
-    unsigned int maxVaryingVectors = static_cast<unsigned int>(mRegisterMap.size());
+    unsigned int maxVaryingVectors = mRegisters.getRowCount();
 
     // Fail if we are packing a single over-large varying.
     if (varyingRows > maxVaryingVectors)
@@ -79,28 +79,20 @@ bool VaryingPacking::packVarying(const PackedVarying &packedVarying)
     // Variables are then allocated to successive rows, aligning them to the 1st column."
     if (varyingColumns >= 2 && varyingColumns <= 4)
     {
-        for (unsigned int row = 0; row <= maxVaryingVectors - varyingRows; ++row)
+        unsigned int row = 0;
+        if (mRegisters.findFirstFreeRows(0, varyingColumns, varyingRows, &row))
         {
-            if (isFree(row, 0, varyingRows, varyingColumns))
-            {
-                insert(row, 0, packedVarying);
-                return true;
-            }
+            insert(row, 0, packedVarying);
+            return true;
         }
 
         // "For 2 component variables, when there are no spare rows, the strategy is switched to
         // using the highest numbered row and the lowest numbered column where the variable will
         // fit."
-        if (varyingColumns == 2)
+        if (varyingColumns == 2 && mRegisters.findLastFreeRows(2, 2, varyingRows, &row))
         {
-            for (unsigned int r = maxVaryingVectors - varyingRows + 1; r-- >= 1;)
-            {
-                if (isFree(r, 2, varyingRows, 2))
-                {
-                    insert(r, 2, packedVarying);
-                    return true;
-                }
-            }
+            insert(row, 2, packedVarying);
+            return true;
         }
 
         return false;
@@ -110,29 +102,13 @@ bool VaryingPacking::packVarying(const PackedVarying &packedVarying)
     // first. Each variable is placed in the column that leaves the least amount of space in the
     // column and aligned to the lowest available rows within that column."
     ASSERT(varyingColumns == 1);
-    unsigned int contiguousSpace[4]     = {0};
     unsigned int bestContiguousSpace[4] = {0};
     unsigned int totalSpace[4]          = {0};
 
-    for (unsigned int row = 0; row < maxVaryingVectors; ++row)
+    for (unsigned int column = 0; column < 4; ++column)
     {
-        for (unsigned int column = 0; column < 4; ++column)
-        {
-            if (mRegisterMap[row][column])
-            {
-                contiguousSpace[column] = 0;
-            }
-            else
-            {
-                contiguousSpace[column]++;
-                totalSpace[column]++;
-
-                if (contiguousSpace[column] > bestContiguousSpace[column])
-                {
-                    bestContiguousSpace[column] = contiguousSpace[column];
-                }
-            }
-        }
+        bestContiguousSpace[column] = mRegisters.getLongestFreeRun(column);
+        totalSpace[column]          = mRegisters.getFreeRowCount(column);
     }
 
     unsigned int bestColumn = 0;
@@ -146,54 +122,27 @@ bool VaryingPacking::packVarying(const PackedVarying &packedVarying)
         }
     }
 
-    if (bestContiguousSpace[bestColumn] >= varyingRows)
+    unsigned int row = 0;
+    if (mRegisters.findFirstFreeRows(bestColumn, 1, varyingRows, &row))
     {
-        for (unsigned int row = 0; row < maxVaryingVectors; row++)
+        for (unsigned int arrayIndex = 0; arrayIndex < varyingRows; ++arrayIndex)
         {
-            if (isFree(row, bestColumn, varyingRows, 1))
-            {
-                for (unsigned int arrayIndex = 0; arrayIndex < varyingRows; ++arrayIndex)
-                {
-                    // If varyingRows > 1, it must be an array.
-                    PackedVaryingRegister registerInfo;
-                    registerInfo.packedVarying     = &packedVarying;
-                    registerInfo.registerRow       = row + arrayIndex;
-                    registerInfo.registerColumn    = bestColumn;
-                    registerInfo.varyingArrayIndex = arrayIndex;
-                    registerInfo.varyingRowIndex   = 0;
-                    mRegisterList.push_back(registerInfo);
-                    mRegisterMap[row + arrayIndex][bestColumn] = true;
-                }
-                break;
-            }
+            // If varyingRows > 1, it must be an array.
+            PackedVaryingRegister registerInfo;
+            registerInfo.packedVarying     = &packedVarying;
+            registerInfo.registerRow       = row + arrayIndex;
+            registerInfo.registerColumn    = bestColumn;
+            registerInfo.varyingArrayIndex = arrayIndex;
+            registerInfo.varyingRowIndex   = 0;
+            mRegisterList.push_back(registerInfo);
         }
+        mRegisters.allocate(row, bestColumn, varyingRows, 1);
         return true;
     }
 
     return false;
 }
 
-bool VaryingPacking::isFree(unsigned int registerRow,
-                            unsigned int registerColumn,
-                            unsigned int varyingRows,
-                            unsigned int varyingColumns) const
-{
-    for (unsigned int row = 0; row < varyingRows; ++row)
-    {
-        ASSERT(registerRow + row < mRegisterMap.size());
-        for (unsigned int column = 0; column < varyingColumns; ++column)
-        {
-            ASSERT(registerColumn + column < 4);
-            if (mRegisterMap[registerRow + row][registerColumn + column])
-            {
-                return false;
-            }
-        }
-    }
-
-    return true;
-}
-
 void VaryingPacking::insert(unsigned int registerRow,
                             unsigned int registerColumn,
                             const PackedVarying &packedVarying)
@@ -219,13 +168,11 @@ void VaryingPacking::insert(unsigned int registerRow,
             registerInfo.varyingRowIndex = varyingRow;
             registerInfo.varyingArrayIndex = arrayElement;
             mRegisterList.push_back(registerInfo);
-
-            for (unsigned int columnIndex = 0; columnIndex < varyingColumns; ++columnIndex)
-            {
-                mRegisterMap[registerInfo.registerRow][registerColumn + columnIndex] = true;
-            }
         }
     }
+
+    mRegisters.allocate(registerRow, registerColumn, varyingRows * varying.elementCount(),
+                        varyingColumns);
 }
 
 // See comment on packVarying.
@@ -317,20 +264,12 @@ bool VaryingPacking::packUserVaryings(gl::InfoLog &infoLog,
 
 bool VaryingPacking::validateBuiltins() const
 {
-    return (static_cast<size_t>(getRegisterCount()) <= mRegisterMap.size());
+    return getRegisterCount() <= mRegisters.getRowCount();
 }
 
 unsigned int VaryingPacking::getRegisterCount() const
 {
-    unsigned int count = 0;
-
-    for (const Register &reg : mRegisterMap)
-    {
-        if (reg.data[0] || reg.data[1] || reg.data[2] || reg.data[3])
-        {
-            ++count;
-        }
-    }
+    unsigned int count = mRegisters.getUsedRowCount();
 
     if (mBuiltinInfo[SHADER_PIXEL].glFragCoord.enabled)
     {
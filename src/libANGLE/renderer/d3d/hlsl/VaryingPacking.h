@@ -14,6 +14,7 @@
 #include <GLSLANG/ShaderVars.h>
 
 #include "angle_gl.h"
+#include "common/RegisterAllocator.h"
 #include "common/angleutils.h"
 #include "libANGLE/renderer/d3d/hlsl/hlsl_utils.h"
 
@@ -116,19 +117,6 @@ class VaryingPacking final : angle::NonCopyable
     // checks that we're within the register limits of the implementation.
     bool validateBuiltins() const;
 
-    struct Register
-    {
-        Register() { data[0] = data[1] = data[2] = data[3] = false; }
-
-        bool &operator[](unsigned int index) { return data[index]; }
-        bool operator[](unsigned int index) const { return data[index]; }
-
-        bool data[4];
-    };
-
-    Register &operator[](unsigned int index) { return mRegisterMap[index]; }
-    const Register &operator[](unsigned int index) const { return mRegisterMap[index]; }
-
     const std::vector<PackedVaryingRegister> &getRegisterList() const { return mRegisterList; }
     unsigned int getMaxSemanticIndex() const
     {
@@ -166,15 +154,11 @@ class VaryingPacking final : angle::NonCopyable
 
   private:
     bool packVarying(const PackedVarying &packedVarying);
-    bool isFree(unsigned int registerRow,
-                unsigned int registerColumn,
-                unsigned int varyingRows,
-                unsigned int varyingColumns) const;
     void insert(unsigned int registerRow,
                 unsigned int registerColumn,
                 const PackedVarying &packedVarying);
 
-    std::vector<Register> mRegisterMap;
+    angle::RegisterAllocator mRegisters;
     std::vector<PackedVaryingRegister> mRegisterList;
 
     std::vector<BuiltinInfo> mBuiltinInfo;
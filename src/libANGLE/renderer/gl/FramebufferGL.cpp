@@ -165,6 +165,7 @@ Error FramebufferGL::invalidateSub(size_t count,
 
 Error FramebufferGL::clear(ContextImpl *context, GLbitfield mask)
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
     syncClearState(mask);
     mStateManager->bindFramebuffer(GL_FRAMEBUFFER, mFramebufferID);
     mFunctions->clear(mask);
@@ -177,6 +178,7 @@ Error FramebufferGL::clearBufferfv(ContextImpl *context,
                                    GLint drawbuffer,
                                    const GLfloat *values)
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
     syncClearBufferState(buffer, drawbuffer);
     mStateManager->bindFramebuffer(GL_FRAMEBUFFER, mFramebufferID);
     mFunctions->clearBufferfv(buffer, drawbuffer, values);
@@ -189,6 +191,7 @@ Error FramebufferGL::clearBufferuiv(ContextImpl *context,
                                     GLint drawbuffer,
                                     const GLuint *values)
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
     syncClearBufferState(buffer, drawbuffer);
     mStateManager->bindFramebuffer(GL_FRAMEBUFFER, mFramebufferID);
     mFunctions->clearBufferuiv(buffer, drawbuffer, values);
@@ -201,6 +204,7 @@ Error FramebufferGL::clearBufferiv(ContextImpl *context,
                                    GLint drawbuffer,
                                    const GLint *values)
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
     syncClearBufferState(buffer, drawbuffer);
     mStateManager->bindFramebuffer(GL_FRAMEBUFFER, mFramebufferID);
     mFunctions->clearBufferiv(buffer, drawbuffer, values);
@@ -214,6 +218,7 @@ Error FramebufferGL::clearBufferfi(ContextImpl *context,
                                    GLfloat depth,
                                    GLint stencil)
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
     syncClearBufferState(buffer, drawbuffer);
     mStateManager->bindFramebuffer(GL_FRAMEBUFFER, mFramebufferID);
     mFunctions->clearBufferfi(buffer, drawbuffer, depth, stencil);
@@ -241,6 +246,8 @@ Error FramebufferGL::readPixels(ContextImpl *context,
                                 GLenum type,
                                 GLvoid *pixels) const
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
+
     // TODO: don't sync the pixel pack state here once the dirty bits contain the pixel pack buffer
     // binding
     const PixelPackState &packState = context->getGLState().getPackState();
@@ -285,6 +292,8 @@ Error FramebufferGL::blit(ContextImpl *context,
                           GLbitfield mask,
                           GLenum filter)
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
+
     const Framebuffer *sourceFramebuffer     = context->getGLState().getReadFramebuffer();
     const Framebuffer *destFramebuffer       = context->getGLState().getDrawFramebuffer();
 
@@ -494,6 +503,8 @@ gl::Error FramebufferGL::readPixelsRowByRowWorkaround(const gl::Rectangle &area,
                                                       const gl::PixelPackState &pack,
                                                       GLvoid *pixels) const
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
+
     intptr_t offset = reinterpret_cast<intptr_t>(pixels);
 
     const gl::InternalFormat &glFormat =
@@ -527,6 +538,8 @@ gl::Error FramebufferGL::readPixelsPaddingWorkaround(const gl::Rectangle &area,
                                                      const gl::PixelPackState &pack,
                                                      GLvoid *pixels) const
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
+
     const gl::InternalFormat &glFormat =
         gl::GetInternalFormatInfo(gl::GetSizedInternalFormat(format, type));
     GLuint rowBytes = 0;
@@ -159,12 +159,15 @@ RendererGL::~RendererGL()
 
 gl::Error RendererGL::flush()
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
     mFunctions->flush();
     return gl::Error(GL_NO_ERROR);
 }
 
 gl::Error RendererGL::finish()
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
+
 #ifdef NDEBUG
     if (mWorkarounds.finishDoesNotCauseQueriesToBeAvailable && mHasDebugOutput)
     {
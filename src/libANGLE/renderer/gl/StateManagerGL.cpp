@@ -54,6 +54,7 @@ StateManagerGL::StateManagerGL(const FunctionsGL *functions, const gl::Caps &ren
       mQueries(),
       mPrevDrawTransformFeedback(nullptr),
       mCurrentQueries(),
+      mTexturesWithPendingUploads(),
       mPrevDrawContext(0),
       mUnpackAlignment(4),
       mUnpackRowLength(0),
@@ -611,6 +612,27 @@ void StateManagerGL::onDeleteQueryObject(QueryGL *query)
     mCurrentQueries.erase(query);
 }
 
+void StateManagerGL::onTextureUploadsQueued(TextureGL *texture)
+{
+    mTexturesWithPendingUploads.insert(texture);
+}
+
+void StateManagerGL::onTextureUploadsFlushed(TextureGL *texture)
+{
+    mTexturesWithPendingUploads.erase(texture);
+}
+
+gl::Error StateManagerGL::flushPendingTextureUploads()
+{
+    // Flushing a texture removes it from the set, even on failure.
+    while (!mTexturesWithPendingUploads.empty())
+    {
+        ANGLE_TRY((*mTexturesWithPendingUploads.begin())->flushPendingUploads());
+    }
+
+    return gl::NoError();
+}
+
 gl::Error StateManagerGL::setDrawArraysState(const gl::ContextState &data,
                                              GLint first,
                                              GLsizei count,
@@ -760,6 +782,9 @@ gl::Error StateManagerGL::setGenericDrawState(const gl::ContextState &data)
 {
     const gl::State &state = data.getState();
 
+    // Sampled textures and render targets must see every queued update.
+    ANGLE_TRY(flushPendingTextureUploads());
+
     // Sync the current program state
     const gl::Program *program = state.getProgram();
     const ProgramGL *programGL = GetImplAs<ProgramGL>(program);
@@ -31,6 +31,7 @@ class FramebufferGL;
 class FunctionsGL;
 class TransformFeedbackGL;
 class QueryGL;
+class TextureGL;
 
 class StateManagerGL final : angle::NonCopyable
 {
@@ -63,6 +64,12 @@ class StateManagerGL final : angle::NonCopyable
     void endQuery(GLenum type, GLuint query);
     void onBeginQuery(QueryGL *query);
 
+    // Textures with queued sub-image updates. These are flushed before anything that can read or
+    // render to a texture.
+    void onTextureUploadsQueued(TextureGL *texture);
+    void onTextureUploadsFlushed(TextureGL *texture);
+    gl::Error flushPendingTextureUploads();
+
     void setAttributeCurrentData(size_t index, const gl::VertexAttribCurrentValueData &data);
 
     void setScissorTestEnabled(bool enabled);
@@ -196,6 +203,7 @@ class StateManagerGL final : angle::NonCopyable
 
     TransformFeedbackGL *mPrevDrawTransformFeedback;
     std::set<QueryGL *> mCurrentQueries;
+    std::set<TextureGL *> mTexturesWithPendingUploads;
     uintptr_t mPrevDrawContext;
 
     GLint mUnpackAlignment;
@@ -101,6 +101,36 @@ gl::Texture::DirtyBits GetLevelWorkaroundDirtyBits()
     return bits;
 }
 
+class TexSubImageDelegate : public SubImageUploadQueue::UploadDelegate
+{
+  public:
+    TexSubImageDelegate(const FunctionsGL *functions,
+                        GLenum target,
+                        size_t level,
+                        const nativegl::TexSubImageFormat &texSubImageFormat)
+        : mFunctions(functions),
+          mTarget(target),
+          mLevel(level),
+          mTexSubImageFormat(texSubImageFormat)
+    {
+    }
+
+    gl::Error uploadArea(const gl::Box &area, const uint8_t *pixels) override
+    {
+        ASSERT(area.z == 0 && area.depth == 1);
+        mFunctions->texSubImage2D(mTarget, static_cast<GLint>(mLevel), area.x, area.y, area.width,
+                                  area.height, mTexSubImageFormat.format, mTexSubImageFormat.type,
+                                  pixels);
+        return gl::NoError();
+    }
+
+  private:
+    const FunctionsGL *mFunctions;
+    GLenum mTarget;
+    size_t mLevel;
+    nativegl::TexSubImageFormat mTexSubImageFormat;
+};
+
 }  // anonymous namespace
 
 LUMAWorkaroundGL::LUMAWorkaroundGL() : LUMAWorkaroundGL(false, GL_NONE)
@@ -152,6 +182,7 @@ TextureGL::TextureGL(const gl::TextureState &state,
 
 TextureGL::~TextureGL()
 {
+    discardAllPendingUploads();
     mStateManager->deleteTexture(mTextureID);
     mTextureID = 0;
 }
@@ -165,6 +196,8 @@ gl::Error TextureGL::setImage(GLenum target,
                               const gl::PixelUnpackState &unpack,
                               const uint8_t *pixels)
 {
+    discardPendingUploads(target, level);
+
     if (mWorkarounds.unpackOverlappingRowsSeparatelyUnpackBuffer && unpack.pixelBuffer.get() &&
         unpack.rowLength != 0 && unpack.rowLength < size.width)
     {
@@ -268,6 +301,21 @@ gl::Error TextureGL::setSubImage(GLenum target, size_t level, const gl::Box &are
     ASSERT(mLevelInfo[level].lumaWorkaround.enabled ==
            GetLevelInfo(format, texSubImageFormat.format).lumaWorkaround.enabled);
 
+    // Small updates from client memory are held back so that the ones that follow can be
+    // coalesced with them.
+    if (UseTexImage2D(getTarget()) && unpack.pixelBuffer.get() == nullptr && pixels != nullptr &&
+        SubImageUploadQueue::IsQueueable(area, format, type))
+    {
+        return queueSubImage(target, level, area, format, type, unpack, pixels);
+    }
+
+    // Anything else must land after the queued updates.
+    if (!mPendingUploads.empty())
+    {
+        ANGLE_TRY(flushPendingUploads());
+        mStateManager->setPixelUnpackState(unpack);
+    }
+
     mStateManager->bindTexture(getTarget(), mTextureID);
     if (mWorkarounds.unpackOverlappingRowsSeparatelyUnpackBuffer && unpack.pixelBuffer.get() &&
         unpack.rowLength != 0 && unpack.rowLength < area.width)
@@ -310,6 +358,28 @@ gl::Error TextureGL::setSubImage(GLenum target, size_t level, const gl::Box &are
     return gl::Error(GL_NO_ERROR);
 }
 
+gl::Error TextureGL::queueSubImage(GLenum target,
+                                   size_t level,
+                                   const gl::Box &area,
+                                   GLenum format,
+                                   GLenum type,
+                                   const gl::PixelUnpackState &unpack,
+                                   const uint8_t *pixels)
+{
+    SubImageUploadQueue &queue = mPendingUploads[std::make_pair(target, level)];
+    if (!queue.canQueue(area, format, type))
+    {
+        ANGLE_TRY(flushPendingUploads());
+        mStateManager->setPixelUnpackState(unpack);
+        return queueSubImage(target, level, area, format, type, unpack, pixels);
+    }
+
+    ANGLE_TRY(queue.queue(area, format, type, unpack, false, pixels));
+    mStateManager->onTextureUploadsQueued(this);
+
+    return gl::NoError();
+}
+
 gl::Error TextureGL::setSubImageRowByRowWorkaround(GLenum target,
                                                    size_t level,
                                                    const gl::Box &area,
@@ -455,6 +525,8 @@ gl::Error TextureGL::setSubImagePaddingWorkaround(GLenum target,
 gl::Error TextureGL::setCompressedImage(GLenum target, size_t level, GLenum internalFormat, const gl::Extents &size,
                                         const gl::PixelUnpackState &unpack, size_t imageSize, const uint8_t *pixels)
 {
+    discardPendingUploads(target, level);
+
     ASSERT(CompatibleTextureTarget(getTarget(), target));
 
     nativegl::CompressedTexImageFormat compressedTexImageFormat =
@@ -522,6 +594,10 @@ gl::Error TextureGL::setCompressedSubImage(GLenum target, size_t level, const gl
 gl::Error TextureGL::copyImage(GLenum target, size_t level, const gl::Rectangle &sourceArea, GLenum internalFormat,
                                const gl::Framebuffer *source)
 {
+    // The source framebuffer may have textures with queued updates attached.
+    discardPendingUploads(target, level);
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
+
     nativegl::CopyTexImageImageFormat copyTexImageFormat = nativegl::GetCopyTexImageImageFormat(
         mFunctions, mWorkarounds, internalFormat, source->getImplementationColorReadType());
 
@@ -564,6 +640,8 @@ gl::Error TextureGL::copyImage(GLenum target, size_t level, const gl::Rectangle
 gl::Error TextureGL::copySubImage(GLenum target, size_t level, const gl::Offset &destOffset, const gl::Rectangle &sourceArea,
                                   const gl::Framebuffer *source)
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
+
     const FramebufferGL *sourceFramebufferGL = GetImplAs<FramebufferGL>(source);
 
     mStateManager->bindTexture(getTarget(), mTextureID);
@@ -616,6 +694,7 @@ gl::Error TextureGL::copyTexture(GLenum internalFormat,
     gl::Rectangle sourceArea(0, 0, sourceImageDesc.size.width, sourceImageDesc.size.height);
 
     GLenum sizedInternalFormat = gl::GetSizedInternalFormat(internalFormat, type);
+    discardPendingUploads(getTarget(), 0);
     reserveTexImageToBeFilled(getTarget(), 0, sizedInternalFormat, sourceImageDesc.size,
                               internalFormat, type);
 
@@ -643,6 +722,8 @@ gl::Error TextureGL::copySubTextureHelper(const gl::Offset &destOffset,
                                           bool unpackUnmultiplyAlpha,
                                           const gl::Texture *source)
 {
+    ANGLE_TRY(mStateManager->flushPendingTextureUploads());
+
     TextureGL *sourceGL                  = GetImplAs<TextureGL>(source);
     const gl::ImageDesc &sourceImageDesc = sourceGL->mState.getImageDesc(source->getTarget(), 0);
 
@@ -672,6 +753,8 @@ gl::Error TextureGL::setStorage(GLenum target,
                                 GLenum internalFormat,
                                 const gl::Extents &size)
 {
+    discardAllPendingUploads();
+
     nativegl::TexStorageFormat texStorageFormat =
         nativegl::GetTexStorageFormat(mFunctions, mWorkarounds, internalFormat);
 
@@ -817,6 +900,8 @@ gl::Error TextureGL::setImageExternal(GLenum target,
 
 gl::Error TextureGL::generateMipmap()
 {
+    ANGLE_TRY(flushPendingUploads());
+
     mStateManager->bindTexture(getTarget(), mTextureID);
     mFunctions->generateMipmap(getTarget());
 
@@ -833,6 +918,7 @@ gl::Error TextureGL::generateMipmap()
 void TextureGL::bindTexImage(egl::Surface *surface)
 {
     ASSERT(getTarget() == GL_TEXTURE_2D);
+    discardAllPendingUploads();
 
     // Make sure this texture is bound
     mStateManager->bindTexture(getTarget(), mTextureID);
@@ -844,6 +930,7 @@ void TextureGL::releaseTexImage()
 {
     // Not all Surface implementations reset the size of mip 0 when releasing, do it manually
     ASSERT(getTarget() == GL_TEXTURE_2D);
+    discardAllPendingUploads();
 
     mStateManager->bindTexture(getTarget(), mTextureID);
     if (UseTexImage2D(getTarget()))
@@ -1135,6 +1222,59 @@ void TextureGL::syncTextureStateSwizzle(const FunctionsGL *functions,
     functions->texParameteri(getTarget(), name, resultSwizzle);
 }
 
+gl::Error TextureGL::flushPendingUploads()
+{
+    if (mPendingUploads.empty())
+    {
+        return gl::NoError();
+    }
+
+    mStateManager->bindTexture(getTarget(), mTextureID);
+
+    gl::PixelUnpackState directUnpack;
+    directUnpack.alignment = 1;
+    mStateManager->setPixelUnpackState(directUnpack);
+
+    gl::Error error = gl::NoError();
+    for (auto &pendingUpload : mPendingUploads)
+    {
+        SubImageUploadQueue &queue = pendingUpload.second;
+        if (queue.empty())
+        {
+            continue;
+        }
+
+        nativegl::TexSubImageFormat texSubImageFormat = nativegl::GetTexSubImageFormat(
+            mFunctions, mWorkarounds, queue.getFormat(), queue.getType());
+        TexSubImageDelegate delegate(mFunctions, pendingUpload.first.first,
+                                     pendingUpload.first.second, texSubImageFormat);
+
+        gl::Error flushError = queue.flush(&delegate);
+        if (!error.isError())
+        {
+            error = flushError;
+        }
+    }
+
+    discardAllPendingUploads();
+    return error;
+}
+
+void TextureGL::discardPendingUploads(GLenum target, size_t level)
+{
+    mPendingUploads.erase(std::make_pair(target, level));
+    if (mPendingUploads.empty())
+    {
+        mStateManager->onTextureUploadsFlushed(this);
+    }
+}
+
+void TextureGL::discardAllPendingUploads()
+{
+    mPendingUploads.clear();
+    mStateManager->onTextureUploadsFlushed(this);
+}
+
 void TextureGL::setLevelInfo(size_t level, size_t levelCount, const LevelInfoGL &levelInfo)
 {
     ASSERT(levelCount > 0 && level + levelCount < mLevelInfo.size());
@@ -9,7 +9,10 @@
 #ifndef LIBANGLE_RENDERER_GL_TEXTUREGL_H_
 #define LIBANGLE_RENDERER_GL_TEXTUREGL_H_
 
+#include <map>
+
 #include "libANGLE/angletypes.h"
+#include "libANGLE/renderer/SubImageUploadQueue.h"
 #include "libANGLE/renderer/TextureImpl.h"
 #include "libANGLE/Texture.h"
 
@@ -120,7 +123,22 @@ class TextureGL : public TextureImpl
 
     void setSwizzle(GLint swizzle[4]);
 
+    // Uploads the sub-image updates that are still queued. This changes the current pixel unpack
+    // state and texture binding.
+    gl::Error flushPendingUploads();
+
   private:
+    gl::Error queueSubImage(GLenum target,
+                            size_t level,
+                            const gl::Box &area,
+                            GLenum format,
+                            GLenum type,
+                            const gl::PixelUnpackState &unpack,
+                            const uint8_t *pixels);
+    // Drops queued updates to images that are about to be redefined.
+    void discardPendingUploads(GLenum target, size_t level);
+    void discardAllPendingUploads();
+
     void setImageHelper(GLenum target,
                         size_t level,
                         GLenum internalFormat,
@@ -172,6 +190,9 @@ class TextureGL : public TextureImpl
     GLuint mAppliedMaxLevel;
 
     GLuint mTextureID;
+
+    // Small texSubImage updates from client memory, per (target, level), waiting to be coalesced.
+    std::map<std::pair<GLenum, size_t>, SubImageUploadQueue> mPendingUploads;
 };
 
 }
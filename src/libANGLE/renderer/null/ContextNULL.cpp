@@ -35,6 +35,7 @@ ContextNULL::ContextNULL(const gl::ContextState &state) : ContextImpl(state)
 {
     const gl::Version maxClientVersion(3, 1);
     mCaps        = GenerateMinimumCaps(maxClientVersion);
+    mCaps.programBinaryFormats.push_back(GL_PROGRAM_BINARY_ANGLE);
     mExtensions  = gl::Extensions();
     mTextureCaps = GenerateMinimumTextureCapsMap(maxClientVersion, mExtensions);
 }
@@ -0,0 +1,71 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BuiltInFunctionEmulator_test.cpp:
+//   Tests for replacing built-in function calls with emulated functions.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "tests/test_utils/compiler_test.h"
+
+using namespace sh;
+
+namespace
+{
+
+const char kAtanShader[] =
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "uniform vec3 u;\n"
+    "out vec4 color;\n"
+    "void main() {\n"
+    "   color = vec4(atan(u, u.zyx), atan(u.x, u.y));\n"
+    "}\n";
+
+class BuiltInFunctionEmulatorTest : public MatchOutputCodeTest
+{
+  public:
+    BuiltInFunctionEmulatorTest()
+        : MatchOutputCodeTest(GL_FRAGMENT_SHADER,
+                              SH_EMULATE_ATAN2_FLOAT_FUNCTION,
+                              SH_GLSL_COMPATIBILITY_OUTPUT)
+    {
+    }
+};
+
+// Test that the definition that an emulated function depends on is output once, whether or not
+// the shader calls it directly.
+TEST_F(BuiltInFunctionEmulatorTest, DependencyIsOutputOnce)
+{
+    compile(kAtanShader);
+    ASSERT_TRUE(foundInCode("vec3 webgl_atan_emu(", 1));
+    ASSERT_TRUE(foundInCode("float webgl_atan_emu(", 1));
+    ASSERT_TRUE(notFoundInCode("vec2 webgl_atan_emu("));
+}
+
+// Test that a compiler only emulates the functions that the options of the current compilation
+// ask for.
+TEST(BuiltInFunctionEmulatorReuseTest, EmulationFollowsCompileOptions)
+{
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    ShHandle compiler = sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC,
+                                              SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
+    ASSERT_TRUE(compiler != nullptr);
+
+    const char *shaderStrings[] = {kAtanShader};
+    ASSERT_TRUE(sh::Compile(compiler, shaderStrings, 1,
+                            SH_OBJECT_CODE | SH_EMULATE_ATAN2_FLOAT_FUNCTION));
+    EXPECT_NE(std::string::npos, sh::GetObjectCode(compiler).find("webgl_atan_emu("));
+
+    ASSERT_TRUE(sh::Compile(compiler, shaderStrings, 1, SH_OBJECT_CODE));
+    EXPECT_EQ(std::string::npos, sh::GetObjectCode(compiler).find("webgl_atan_emu("));
+
+    sh::Destruct(compiler);
+}
+
+}  // anonymous namespace
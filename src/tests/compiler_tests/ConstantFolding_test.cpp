@@ -7,6 +7,9 @@
 //   Tests for constant folding
 //
 
+#include <chrono>
+#include <sstream>
+
 #include "tests/test_utils/ConstantFoldingTest.h"
 
 using namespace sh;
@@ -1244,3 +1247,63 @@ TEST_F(ConstantFoldingExpressionTest, FoldDivideByInfinity)
     evaluateFloat(floatString);
     ASSERT_TRUE(constantFoundInAST(0.0f));
 }
+
+// Test that an expression that folds with a warning warns each time it appears, even though the
+// results of folding identical expressions are shared.
+TEST_F(ConstantFoldingTest, RepeatedExpressionWarnsEachTime)
+{
+    const std::string &shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "out vec4 my_FragColor;\n"
+        "void main() {\n"
+        "    float a = pow(-1.0, 2.0);\n"
+        "    float b = pow(-1.0, 2.0);\n"
+        "    my_FragColor = vec4(a, b, 0.0, 1.0);\n"
+        "}\n";
+    compile(shaderString);
+    const std::string &infoLog = getInfoLog();
+    size_t firstWarning        = infoLog.find("WARNING: 0:5");
+    ASSERT_NE(std::string::npos, firstWarning);
+    ASSERT_NE(std::string::npos, infoLog.find("WARNING: 0:6", firstWarning));
+}
+
+// Stress test for folding many vector and matrix expressions, most of them repeated. The time the
+// compilation takes is recorded as the compileMilliseconds property of the test.
+TEST_F(ConstantFoldingTest, FoldRepeatedMatrixExpressionsStress)
+{
+    const int kRepetitions = 400;
+    std::stringstream shaderStream;
+    shaderStream << "#version 300 es\n"
+                    "precision highp float;\n"
+                    "out vec4 my_FragColor;\n"
+                    "const mat4 m = mat4(2.0, 0.0, 0.0, 0.0, 0.0, 4.0, 0.0, 0.0,\n"
+                    "                    0.0, 0.0, 8.0, 0.0, 0.0, 0.0, 0.0, 0.5);\n"
+                    "void main() {\n"
+                    "    vec4 sum = vec4(0.0);\n";
+    for (int i = 0; i < kRepetitions; ++i)
+    {
+        shaderStream << "    sum += inverse(m) * (m * vec4(" << i << ".0, 1.0, 2.0, 3.0));\n"
+                     << "    sum += pow(vec4(4.0, 9.0, 16.0, 25.0), vec4(0.5)) * sqrt(vec4(4.0));\n"
+                     << "    sum += (m * m * transpose(m))[" << i % 4 << "] - vec4(" << i
+                     << ".0) * 0.5;\n";
+    }
+    shaderStream << "    my_FragColor = sum;\n"
+                    "}\n";
+
+    auto start = std::chrono::steady_clock::now();
+    compile(shaderStream.str());
+    auto end = std::chrono::steady_clock::now();
+    RecordProperty("compileMilliseconds",
+                   static_cast<int>(
+                       std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()));
+
+    ASSERT_FALSE(hasWarning());
+    std::vector<float> lastVector = {static_cast<float>(kRepetitions - 1), 1.0f, 2.0f, 3.0f};
+    ASSERT_TRUE(constantVectorFoundInAST(lastVector));
+    std::vector<float> roots = {4.0f, 6.0f, 8.0f, 10.0f};
+    ASSERT_TRUE(constantVectorNearFoundInAST(roots, 1.0e-5f));
+    // The second column of m * m * transpose(m), minus vec4(397.0) * 0.5.
+    std::vector<float> column = {-198.5f, -134.5f, -198.5f, -198.5f};
+    ASSERT_TRUE(constantVectorFoundInAST(column));
+}
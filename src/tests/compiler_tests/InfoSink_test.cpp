@@ -0,0 +1,114 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// InfoSink_test.cpp:
+//   Tests for the number formatting of TInfoSinkBase, which the output backends rely on.
+//
+
+#include <locale.h>
+#include <string.h>
+
+#include <iostream>
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "compiler/translator/InfoSink.h"
+#include "compiler/translator/PoolAlloc.h"
+
+using namespace sh;
+
+namespace
+{
+
+template <typename T>
+std::string Format(T value)
+{
+    TInfoSinkBase sink;
+    sink << value;
+    return sink.str();
+}
+
+// Test that integers of every width are written in decimal, limits included.
+TEST(InfoSinkTest, Integers)
+{
+    EXPECT_EQ("0", Format(0));
+    EXPECT_EQ("-17", Format(-17));
+    EXPECT_EQ("-2147483648", Format(std::numeric_limits<int>::min()));
+    EXPECT_EQ("4294967295", Format(std::numeric_limits<unsigned int>::max()));
+    EXPECT_EQ("-9223372036854775808", Format(std::numeric_limits<long long>::min()));
+    EXPECT_EQ("18446744073709551615", Format(std::numeric_limits<unsigned long long>::max()));
+    EXPECT_EQ("42", Format(size_t(42)));
+}
+
+// Test that floats keep a decimal point when they are integral, and eight significant digits
+// otherwise.
+TEST(InfoSinkTest, Floats)
+{
+    EXPECT_EQ("1.0", Format(1.0f));
+    EXPECT_EQ("-0.0", Format(-0.0f));
+    EXPECT_EQ("16777216.0", Format(16777216.0f));
+    EXPECT_EQ("0.5", Format(0.5f));
+    EXPECT_EQ("0.12345679", Format(0.123456789f));
+    EXPECT_EQ("1e-07", Format(1e-7f));
+    EXPECT_EQ("340282346638528859811704183484516925440.0",
+              Format(std::numeric_limits<float>::max()));
+}
+
+// Test that floats are written with a decimal point when the host process has set a C locale
+// that writes a comma instead.
+TEST(InfoSinkTest, FloatsIgnoreLocale)
+{
+    const char *kCommaLocales[] = {"de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8",
+                                   "fr_FR.utf8",  "fr_FR",      "German", "French"};
+
+    std::string previousLocale = setlocale(LC_NUMERIC, nullptr);
+    bool foundCommaLocale      = false;
+    for (const char *locale : kCommaLocales)
+    {
+        if (setlocale(LC_NUMERIC, locale) != nullptr &&
+            strcmp(localeconv()->decimal_point, ",") == 0)
+        {
+            foundCommaLocale = true;
+            break;
+        }
+    }
+    if (!foundCommaLocale)
+    {
+        setlocale(LC_NUMERIC, previousLocale.c_str());
+        std::cout << "Test skipped: no locale with a comma decimal point is installed."
+                  << std::endl;
+        return;
+    }
+
+    std::string integral   = Format(1.0f);
+    std::string fractional = Format(0.5f);
+    std::string exponent   = Format(-9.5367432e-07f);
+    setlocale(LC_NUMERIC, previousLocale.c_str());
+
+    EXPECT_EQ("1.0", integral);
+    EXPECT_EQ("0.5", fractional);
+    EXPECT_EQ("-9.5367432e-07", exponent);
+}
+
+// Test that the sink appends strings with their lengths, and source locations.
+TEST(InfoSinkTest, StringsAndLocations)
+{
+    TPoolAllocator allocator;
+    allocator.push();
+    SetGlobalPoolAllocator(&allocator);
+
+    TInfoSinkBase sink;
+    sink.reserve(64);
+    sink << TString("ab\0c", 4);
+    sink.append("def", 2);
+    sink.location(1, 12);
+    sink.location(2, 0);
+    EXPECT_EQ(std::string("ab\0cde1:12: 2:? : ", 18), sink.str());
+
+    SetGlobalPoolAllocator(nullptr);
+    allocator.pop();
+}
+
+}  // anonymous namespace
@@ -43,7 +43,7 @@ class IntermNodeTest : public testing::Test
         TIntermSymbol *node = new TIntermSymbol(0, symbolName, type);
         node->setLine(createUniqueSourceLoc());
         node->setInternal(true);
-        node->getTypePointer()->setQualifier(EvqTemporary);
+        node->setQualifier(EvqTemporary);
         return node;
     }
 
@@ -230,3 +230,39 @@ TEST_F(IntermNodeTest, DeepCopyTernaryNode)
     checkSymbolCopy(original->getFalseExpression(), copy->getFalseExpression());
 }
 
+
+// Check that nodes of the same basic type share one copy of it, and that changing the qualifier
+// or precision of a node doesn't change the type of the others.
+TEST_F(IntermNodeTest, NodesShareBasicTypes)
+{
+    TIntermSymbol *a = createTestSymbol(TType(EbtFloat, EbpHigh, EvqTemporary, 4));
+    TIntermSymbol *b = createTestSymbol(TType(EbtFloat, EbpHigh, EvqTemporary, 4));
+    ASSERT_EQ(&a->getType(), &b->getType());
+
+    b->setQualifier(EvqConst);
+    EXPECT_EQ(EvqTemporary, a->getQualifier());
+    EXPECT_EQ(EvqConst, b->getQualifier());
+
+    b->setPrecision(EbpMedium);
+    EXPECT_EQ(EbpHigh, a->getPrecision());
+    EXPECT_EQ(EbpMedium, b->getPrecision());
+    EXPECT_EQ(4, b->getNominalSize());
+
+    b->setQualifier(EvqTemporary);
+    b->setPrecision(EbpHigh);
+    EXPECT_EQ(&a->getType(), &b->getType());
+}
+
+// Check that an array type, which isn't shared through the cache, belongs to its node.
+TEST_F(IntermNodeTest, ArrayTypesAreNotShared)
+{
+    TType arrayType(EbtFloat, EbpHigh, EvqTemporary);
+    arrayType.setArraySize(3);
+    TIntermSymbol *a = createTestSymbol(arrayType);
+    TIntermSymbol *b = createTestSymbol(arrayType);
+    ASSERT_NE(&a->getType(), &b->getType());
+
+    b->setQualifier(EvqConst);
+    EXPECT_EQ(EvqTemporary, a->getQualifier());
+    EXPECT_EQ(3u, b->getArraySize());
+}
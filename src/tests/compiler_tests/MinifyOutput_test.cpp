@@ -0,0 +1,183 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// MinifyOutput_test.cpp:
+//   Tests for SH_MINIFY_OUTPUT, which shortens the names, whitespace and parentheses of the ESSL
+//   and GLSL outputs.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "tests/test_utils/compiler_test.h"
+
+using namespace sh;
+
+namespace
+{
+
+class MinifyOutputTest : public MatchOutputCodeTest
+{
+  public:
+    MinifyOutputTest() : MatchOutputCodeTest(GL_FRAGMENT_SHADER, SH_MINIFY_OUTPUT, SH_ESSL_OUTPUT)
+    {
+        addOutputType(SH_GLSL_COMPATIBILITY_OUTPUT);
+    }
+};
+
+// Test that local variables, parameters, functions and global variables get short names, and that
+// the names of the shader interface are kept.
+TEST_F(MinifyOutputTest, NamesOutsideTheInterfaceAreShortened)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 uniformColor;\n"
+        "vec4 globalValue;\n"
+        "vec4 scaleColor(vec4 colorParameter, float scaleParameter)\n"
+        "{\n"
+        "    vec4 scaledColor = colorParameter * scaleParameter;\n"
+        "    return scaledColor + globalValue;\n"
+        "}\n"
+        "void main()\n"
+        "{\n"
+        "    globalValue = uniformColor;\n"
+        "    gl_FragColor = scaleColor(uniformColor, 2.0);\n"
+        "}\n";
+    compile(shaderString);
+    ASSERT_TRUE(foundInCode("uniformColor"));
+    ASSERT_TRUE(foundInCode("gl_FragColor"));
+    ASSERT_TRUE(foundInCode("void main()"));
+    ASSERT_TRUE(notFoundInCode("globalValue"));
+    ASSERT_TRUE(notFoundInCode("scaleColor"));
+    ASSERT_TRUE(notFoundInCode("Parameter"));
+    ASSERT_TRUE(notFoundInCode("scaledColor"));
+}
+
+// Test that whitespace, comments and the parentheses that the precedence of the operators makes
+// redundant are left out, and that constants are written in their shortest form.
+TEST_F(MinifyOutputTest, RedundantCharactersAreLeftOut)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "uniform float a, b;\n"
+        "void main()\n"
+        "{\n"
+        "    // A comment.\n"
+        "    gl_FragColor = (u * a) + (u * vec4(0.5, 0.5, 0.5, 0.5)) + vec4(1.0, 0.25, 0.0, 0.0);\n"
+        "    gl_FragColor.x = a > b ? a * b : (a < 0.0 ? -a : b);\n"
+        "}\n";
+    compile(shaderString);
+    ASSERT_TRUE(foundInCode("{gl_FragColor=u*a+u*vec4(.5)+vec4(1.,.25,0.,0.);"));
+    ASSERT_TRUE(foundInCode("gl_FragColor.x=a>b?a*b:a<0.?-a:b;}"));
+    ASSERT_TRUE(notFoundInCode("comment"));
+    ASSERT_TRUE(notFoundInCode("  "));
+}
+
+// Test that the parentheses and whitespace that change the meaning of an expression are kept.
+TEST_F(MinifyOutputTest, NeededParenthesesAreKept)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform float a, b, c;\n"
+        "uniform int i;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(a - (b - c), a - -b, -(-a), (a + b) * c);\n"
+        "    gl_FragColor.x = (a > b ? a : b) * c;\n"
+        "    gl_FragColor.y = float(i * (i + 1)) + vec2(a, b)[i - 1];\n"
+        "}\n";
+    compile(shaderString);
+    ASSERT_TRUE(foundInCode("a-(b-c)"));
+    ASSERT_TRUE(foundInCode("a- -b"));
+    ASSERT_TRUE(foundInCode("-(-a)"));
+    ASSERT_TRUE(foundInCode("(a+b)*c"));
+    ASSERT_TRUE(foundInCode("(a>b?a:b)*c"));
+    ASSERT_TRUE(foundInCode("float(i*(i+1))"));
+    ASSERT_TRUE(foundInCode("[i-1]"));
+}
+
+// Test that preprocessor directives are kept on lines of their own.
+TEST_F(MinifyOutputTest, DirectivesKeepTheirLines)
+{
+    const std::string shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "out vec4 color;\n"
+        "void main()\n"
+        "{\n"
+        "    color = u;\n"
+        "}\n";
+    compile(shaderString);
+    ASSERT_TRUE(foundInESSLCode("#version 300 es\nuniform"));
+    ASSERT_TRUE(foundInCode("{color=u;}\n"));
+}
+
+// Test that nothing changes without the option.
+TEST_F(MinifyOutputTest, OutputIsUnchangedWithoutTheOption)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "vec4 scaleColor(vec4 color) { return color * 0.5; }\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = scaleColor(u);\n"
+        "}\n";
+    compile(shaderString, SH_VARIABLES);
+    ASSERT_TRUE(foundInCode("scaleColor"));
+    ASSERT_TRUE(foundInCode("(color * 0.5)"));
+}
+
+khronos_uint64_t LengthHash(const char *str, size_t len)
+{
+    return static_cast<khronos_uint64_t>(len);
+}
+
+// Test that the replaced names can be queried, and that they aren't hashed like the names of the
+// shader interface are.
+TEST(MinifiedNameMapTest, ReplacedNamesAreReported)
+{
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    resources.HashFunction = LengthHash;
+    ShHandle compiler =
+        sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, compiler);
+
+    const char *shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "vec4 halve(vec4 value) { return value * 0.5; }\n"
+        "void main()\n"
+        "{\n"
+        "    vec4 color = halve(u);\n"
+        "    gl_FragColor = color + color;\n"
+        "}\n";
+    ASSERT_TRUE(sh::Compile(compiler, &shaderString, 1, SH_OBJECT_CODE | SH_MINIFY_OUTPUT));
+
+    const std::map<std::string, std::string> *minifiedNames = sh::GetMinifiedNameMap(compiler);
+    ASSERT_NE(nullptr, minifiedNames);
+    EXPECT_EQ(3u, minifiedNames->size());
+    EXPECT_EQ(0u, minifiedNames->count("u"));
+    EXPECT_EQ(0u, minifiedNames->count("main"));
+
+    // The most referenced name gets the shortest replacement.
+    ASSERT_EQ(1u, minifiedNames->count("color"));
+    EXPECT_EQ("a", minifiedNames->at("color"));
+
+    const std::string &objectCode = sh::GetObjectCode(compiler);
+    EXPECT_NE(std::string::npos, objectCode.find("gl_FragColor=a+a;"));
+    EXPECT_EQ(std::string::npos, objectCode.find("value"));
+    // The uniform is still hashed.
+    EXPECT_NE(std::string::npos, objectCode.find(minifiedNames->at("halve") + "(webgl_1)"));
+    EXPECT_EQ(1u, sh::GetNameHashingMap(compiler)->count("u"));
+    EXPECT_EQ(0u, sh::GetNameHashingMap(compiler)->count("color"));
+
+    sh::Destruct(compiler);
+}
+
+}  // namespace
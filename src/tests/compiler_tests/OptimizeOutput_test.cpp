@@ -0,0 +1,192 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// OptimizeOutput_test.cpp:
+//   Tests for SH_OPTIMIZE_OUTPUT, which removes code that can't affect the results of a shader and
+//   computes repeated built-in calls once.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "tests/test_utils/compiler_test.h"
+
+using namespace sh;
+
+namespace
+{
+
+class OptimizeOutputTest : public MatchOutputCodeTest
+{
+  public:
+    OptimizeOutputTest()
+        : MatchOutputCodeTest(GL_FRAGMENT_SHADER, SH_OPTIMIZE_OUTPUT, SH_ESSL_OUTPUT)
+    {
+        addOutputType(SH_GLSL_COMPATIBILITY_OUTPUT);
+    }
+};
+
+// Test that a local variable that is initialized with a constant and never written again is
+// replaced by the constant, and that the expressions using it are folded.
+TEST_F(OptimizeOutputTest, ConstantLocalsArePropagatedAndFolded)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void main()\n"
+        "{\n"
+        "    float scaleFactor = 2.0;\n"
+        "    float halfScale = scaleFactor * 0.25;\n"
+        "    gl_FragColor = u * halfScale;\n"
+        "}\n";
+    compile(shaderString);
+    ASSERT_TRUE(foundInCode("(u * 0.5)"));
+    ASSERT_TRUE(notFoundInCode("scaleFactor"));
+    ASSERT_TRUE(notFoundInCode("halfScale"));
+}
+
+// Test that a variable that is written after its declaration keeps its reads.
+TEST_F(OptimizeOutputTest, WrittenLocalsAreNotPropagated)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void scale(inout float factor) { factor *= 2.0; }\n"
+        "void main()\n"
+        "{\n"
+        "    float assigned = 1.0;\n"
+        "    if (u.x > 0.0) assigned = u.y;\n"
+        "    float passedOut = 1.0;\n"
+        "    scale(passedOut);\n"
+        "    vec4 c = vec4(0.0);\n"
+        "    for (int i = 0; i < 4; ++i) { c += u * float(i); }\n"
+        "    gl_FragColor = c * assigned * passedOut;\n"
+        "}\n";
+    compile(shaderString);
+    ASSERT_TRUE(foundInCode("assigned = u.y"));
+    ASSERT_TRUE(foundInCode("scale(passedOut)"));
+    ASSERT_TRUE(foundInCode("float(i)"));
+}
+
+// Test that stores to variables that are never read, and variables that are never used, are
+// removed, but that stores with side effects are kept.
+TEST_F(OptimizeOutputTest, DeadStoresAndUnusedLocalsAreRemoved)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "float counter;\n"
+        "float next() { counter += 1.0; return counter; }\n"
+        "void main()\n"
+        "{\n"
+        "    float unusedValue = sin(u.x);\n"
+        "    vec4 deadTarget = vec4(1.0);\n"
+        "    deadTarget.x = u.y * 3.0;\n"
+        "    deadTarget++;\n"
+        "    float sideEffectTarget = next();\n"
+        "    sideEffectTarget = next();\n"
+        "    gl_FragColor = u;\n"
+        "}\n";
+    compile(shaderString);
+    ASSERT_TRUE(notFoundInCode("unusedValue"));
+    ASSERT_TRUE(notFoundInCode("deadTarget"));
+    ASSERT_TRUE(notFoundInCode("sin("));
+    ASSERT_TRUE(foundInCode("= next()", 2));
+}
+
+// Test that only the unused declarators of a declaration are removed.
+TEST_F(OptimizeOutputTest, UnusedDeclaratorsAreRemoved)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void main()\n"
+        "{\n"
+        "    float unusedFirst = u.x, used = u.y, unusedLast;\n"
+        "    gl_FragColor = vec4(used);\n"
+        "}\n";
+    compile(shaderString);
+    ASSERT_TRUE(foundInCode("used = u.y"));
+    ASSERT_TRUE(notFoundInCode("unusedFirst"));
+    ASSERT_TRUE(notFoundInCode("unusedLast"));
+}
+
+// Test that branches that become unreachable once their conditions are folded are removed.
+TEST_F(OptimizeOutputTest, ConstantBranchesArePruned)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "uniform vec4 unreachable;\n"
+        "void main()\n"
+        "{\n"
+        "    bool enabled = false;\n"
+        "    gl_FragColor = u;\n"
+        "    if (enabled) { gl_FragColor = unreachable; }\n"
+        "    while (enabled) { gl_FragColor += unreachable; }\n"
+        "    gl_FragColor.x = enabled ? unreachable.x : u.x;\n"
+        "}\n";
+    compile(shaderString);
+    ASSERT_TRUE(notFoundInCode("= unreachable"));
+    ASSERT_TRUE(notFoundInCode("unreachable.x"));
+    ASSERT_TRUE(notFoundInCode("while"));
+    ASSERT_TRUE(notFoundInCode("if ("));
+}
+
+// Test that built-in calls that a statement repeats are computed once.
+TEST_F(OptimizeOutputTest, RepeatedBuiltInCallsAreComputedOnce)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void main()\n"
+        "{\n"
+        "    vec3 n = normalize(u.xyz) * dot(normalize(u.xyz), vec3(0.5));\n"
+        "    gl_FragColor = vec4(n, sin(u.w) * cos(u.w) + sin(u.w));\n"
+        "}\n";
+    compile(shaderString);
+    ASSERT_TRUE(foundInCode("normalize(", 1));
+    ASSERT_TRUE(foundInCode("sin(", 1));
+    ASSERT_TRUE(foundInCode("cos(", 1));
+}
+
+// Test that calls that are only evaluated depending on a condition aren't moved before the
+// statement, and that calls that differ in their arguments aren't merged.
+TEST_F(OptimizeOutputTest, ConditionalAndDifferentCallsAreKept)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void main()\n"
+        "{\n"
+        "    float x = u.x > 0.0 ? sqrt(u.x) : sqrt(u.x) + 1.0;\n"
+        "    bool b = u.y > 0.0 && exp(u.y) > exp(u.y);\n"
+        "    gl_FragColor = vec4(x, b, max(u.z, 1.0), max(u.z, 2.0));\n"
+        "}\n";
+    compile(shaderString);
+    ASSERT_TRUE(foundInCode("sqrt(", 2));
+    ASSERT_TRUE(foundInCode("exp(", 2));
+    ASSERT_TRUE(foundInCode("max(", 2));
+}
+
+// Test that nothing is removed without the option.
+TEST_F(OptimizeOutputTest, OutputIsUnchangedWithoutTheOption)
+{
+    const std::string shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "void main()\n"
+        "{\n"
+        "    float unusedValue = sin(u.x);\n"
+        "    float scaleFactor = 2.0;\n"
+        "    gl_FragColor = u * scaleFactor + sin(u.x);\n"
+        "}\n";
+    compile(shaderString, SH_VARIABLES);
+    ASSERT_TRUE(foundInCode("unusedValue"));
+    ASSERT_TRUE(foundInCode("scaleFactor"));
+    ASSERT_TRUE(foundInCode("sin(", 2));
+}
+
+}  // namespace
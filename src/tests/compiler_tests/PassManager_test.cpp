@@ -0,0 +1,209 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PassManager_test.cpp:
+//   Tests that fused analysis passes see the tree the same way as separate traversals.
+//
+
+#include <algorithm>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/Compiler.h"
+#include "compiler/translator/IntermNode.h"
+#include "compiler/translator/PassManager.h"
+#include "compiler/translator/PoolAlloc.h"
+
+using namespace sh;
+
+namespace
+{
+
+// Records every node it visits, and optionally declines to visit the children of binary nodes.
+class RecordingTraverser : public TIntermTraverser
+{
+  public:
+    RecordingTraverser(bool skipBinaryOperands)
+        : TIntermTraverser(true, false, false), mSkipBinaryOperands(skipBinaryOperands)
+    {
+    }
+
+    void visitSymbol(TIntermSymbol *node) override { mVisited.push_back(node); }
+
+    bool visitBinary(Visit visit, TIntermBinary *node) override
+    {
+        mVisited.push_back(node);
+        return !mSkipBinaryOperands;
+    }
+
+    bool visitUnary(Visit visit, TIntermUnary *node) override
+    {
+        mVisited.push_back(node);
+        return true;
+    }
+
+    bool visitBlock(Visit visit, TIntermBlock *node) override
+    {
+        mVisited.push_back(node);
+        return true;
+    }
+
+    const std::vector<TIntermNode *> &getVisited() const { return mVisited; }
+
+  private:
+    bool mSkipBinaryOperands;
+    std::vector<TIntermNode *> mVisited;
+};
+
+class PassManagerTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        allocator.push();
+        SetGlobalPoolAllocator(&allocator);
+    }
+
+    void TearDown() override
+    {
+        SetGlobalPoolAllocator(nullptr);
+        allocator.pop();
+    }
+
+    TIntermSymbol *createSymbol(const char *name)
+    {
+        TIntermSymbol *node = new TIntermSymbol(0, name, TType(EbtFloat, EbpHigh, EvqTemporary));
+        return node;
+    }
+
+    // { a = b + -c; -(d + e); }
+    TIntermBlock *createTree()
+    {
+        TIntermBlock *block = new TIntermBlock();
+        TIntermTyped *sum =
+            new TIntermBinary(EOpAdd, createSymbol("b"), new TIntermUnary(EOpNegative,
+                                                                          createSymbol("c")));
+        block->appendStatement(new TIntermBinary(EOpAssign, createSymbol("a"), sum));
+        block->appendStatement(new TIntermUnary(
+            EOpNegative, new TIntermBinary(EOpAdd, createSymbol("d"), createSymbol("e"))));
+        return block;
+    }
+
+    TPoolAllocator allocator;
+};
+
+// Analyses that don't depend on each other share one traversal and see the same nodes in the same
+// order as they would on their own.
+TEST_F(PassManagerTest, IndependentAnalysesAreFused)
+{
+    TIntermBlock *root = createTree();
+
+    RecordingTraverser reference(false);
+    root->traverse(&reference);
+
+    RecordingTraverser first(false);
+    RecordingTraverser second(false);
+    PassManager passes;
+    passes.addAnalysis("First", &first, PassManager::DEPENDENCY_NONE,
+                       PassManager::DEPENDENCY_EMULATED_FUNCTIONS);
+    passes.addAnalysis("Second", &second, PassManager::DEPENDENCY_NONE,
+                       PassManager::DEPENDENCY_INDEX_CLAMPING);
+    passes.runAnalyses(root);
+
+    ASSERT_EQ(1u, passes.getTimings().size());
+    EXPECT_EQ("First+Second", passes.getTimings()[0].name);
+    EXPECT_EQ(reference.getVisited(), first.getVisited());
+    EXPECT_EQ(reference.getVisited(), second.getVisited());
+}
+
+// A fused analysis that skips a subtree only misses that subtree. The others still visit it.
+TEST_F(PassManagerTest, SkippedSubtreesAreTrackedPerAnalysis)
+{
+    TIntermBlock *root = createTree();
+
+    RecordingTraverser referenceSkipping(true);
+    root->traverse(&referenceSkipping);
+    RecordingTraverser referenceFull(false);
+    root->traverse(&referenceFull);
+
+    RecordingTraverser skipping(true);
+    RecordingTraverser full(false);
+    PassManager passes;
+    passes.addAnalysis("Skipping", &skipping, PassManager::DEPENDENCY_NONE,
+                       PassManager::DEPENDENCY_NONE);
+    passes.addAnalysis("Full", &full, PassManager::DEPENDENCY_NONE,
+                       PassManager::DEPENDENCY_NONE);
+    passes.runAnalyses(root);
+
+    EXPECT_EQ(referenceSkipping.getVisited(), skipping.getVisited());
+    EXPECT_EQ(referenceFull.getVisited(), full.getVisited());
+    EXPECT_LT(skipping.getVisited().size(), full.getVisited().size());
+}
+
+// An analysis that reads what an earlier one writes gets a traversal of its own.
+TEST_F(PassManagerTest, DependentAnalysesAreNotFused)
+{
+    TIntermBlock *root = createTree();
+
+    RecordingTraverser writer(false);
+    RecordingTraverser reader(false);
+    RecordingTraverser independent(false);
+    PassManager passes;
+    passes.addAnalysis("Writer", &writer, PassManager::DEPENDENCY_NONE,
+                       PassManager::DEPENDENCY_INDEX_CLAMPING);
+    passes.addAnalysis("Reader", &reader, PassManager::DEPENDENCY_INDEX_CLAMPING,
+                       PassManager::DEPENDENCY_NONE);
+    passes.addAnalysis("Independent", &independent, PassManager::DEPENDENCY_NONE,
+                       PassManager::DEPENDENCY_NONE);
+    passes.runAnalyses(root);
+
+    ASSERT_EQ(2u, passes.getTimings().size());
+    EXPECT_EQ("Writer", passes.getTimings()[0].name);
+    EXPECT_EQ("Reader+Independent", passes.getTimings()[1].name);
+    EXPECT_EQ(writer.getVisited(), reader.getVisited());
+}
+
+// The compiler records its passes, and validation and marking share a traversal.
+TEST(PassManagerCompilerTest, CompilerRecordsPassTimings)
+{
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    ShHandle handle =
+        sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, handle);
+
+    const char *shaderString =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform int u;\n"
+        "out vec4 color;\n"
+        "void main() {\n"
+        "    vec4 v = vec4(1.0);\n"
+        "    color = vec4(v[u]);\n"
+        "}\n";
+    ASSERT_TRUE(sh::Compile(handle, &shaderString, 1, SH_OBJECT_CODE |
+                                                          SH_CLAMP_INDIRECT_ARRAY_BOUNDS |
+                                                          SH_COLLECT_COMPILE_STATISTICS));
+
+    TCompiler *compiler = static_cast<TShHandleBase *>(handle)->getAsCompiler();
+    ASSERT_NE(nullptr, compiler);
+
+    std::vector<std::string> names;
+    for (const PassManager::PassTiming &timing : compiler->getPassTimings())
+    {
+        EXPECT_GE(timing.seconds, 0.0);
+        names.push_back(timing.name);
+    }
+
+    EXPECT_NE(names.end(), std::find(names.begin(), names.end(), "Parse"));
+    EXPECT_NE(names.end(), std::find(names.begin(), names.end(),
+                                     "ValidateOutputs+MarkIndirectArrayBoundsForClamping"));
+    EXPECT_NE(names.end(), std::find(names.begin(), names.end(), "Translate"));
+
+    sh::Destruct(handle);
+}
+
+}  // anonymous namespace
@@ -0,0 +1,168 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PoolAlloc_test.cpp:
+//   Tests for the page growth, page retention and rewind markers of the pool allocator.
+//
+
+#include "gtest/gtest.h"
+#include "compiler/translator/PoolAlloc.h"
+
+namespace
+{
+
+#if !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+
+const int kPageSize    = 4 * 1024;
+const int kMaxPageSize = 64 * 1024;
+
+// Test that pages double in size up to the maximum, so that a large amount of small allocations
+// needs few pages from the OS.
+TEST(PoolAllocTest, PagesGrowGeometrically)
+{
+    TPoolAllocator allocator(kPageSize, 16, kMaxPageSize);
+    allocator.push();
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        ASSERT_NE(nullptr, allocator.allocate(64));
+    }
+
+    // 640KB in 4, 8, 16, 32 and then 64KB pages.
+    TPoolAllocator::Statistics statistics = allocator.getStatistics();
+    EXPECT_EQ(10000u, statistics.allocationCount);
+    EXPECT_EQ(640000u, statistics.allocatedBytes);
+    EXPECT_GE(14u, statistics.pageAllocationCount);
+    EXPECT_LE(640000u, statistics.reservedBytes);
+
+    allocator.pop();
+}
+
+// Test that popping keeps the pages, large blocks included, so that the same work again doesn't
+// go to the OS.
+TEST(PoolAllocTest, PagesAreKeptAcrossPops)
+{
+    TPoolAllocator allocator(kPageSize, 16, kMaxPageSize);
+
+    allocator.push();
+    for (int i = 0; i < 1000; ++i)
+    {
+        allocator.allocate(100);
+    }
+    allocator.allocate(kMaxPageSize * 2);
+    allocator.pop();
+
+    TPoolAllocator::Statistics first = allocator.getStatistics();
+
+    allocator.push();
+    for (int i = 0; i < 1000; ++i)
+    {
+        allocator.allocate(100);
+    }
+    allocator.allocate(kMaxPageSize * 2);
+    allocator.pop();
+
+    TPoolAllocator::Statistics second = allocator.getStatistics();
+    EXPECT_EQ(first.pageAllocationCount, second.pageAllocationCount);
+    EXPECT_EQ(first.reservedBytes, second.reservedBytes);
+    EXPECT_EQ(first.pageAllocationCount, second.pageReuseCount);
+
+    allocator.releaseUnusedPages();
+    EXPECT_EQ(0u, allocator.getStatistics().reservedBytes);
+}
+
+// Test that rewinding to a marker frees what was allocated after it, including whole pages, and
+// leaves what was allocated before it alone.
+TEST(PoolAllocTest, RewindFreesAllocationsAfterTheMarker)
+{
+    TPoolAllocator allocator(kPageSize, 16, kMaxPageSize);
+    allocator.push();
+
+    char *before = static_cast<char *>(allocator.allocate(16));
+    memset(before, 0x5a, 16);
+
+    TPoolAllocator::Marker marker = allocator.mark();
+    void *first                   = allocator.allocate(32);
+    for (int i = 0; i < 1000; ++i)
+    {
+        allocator.allocate(128);
+    }
+    size_t reservedBytes = allocator.getStatistics().reservedBytes;
+    allocator.rewind(marker);
+
+    // Allocation resumes where the marker was, and the pages that were freed are re-used.
+    EXPECT_EQ(first, allocator.allocate(32));
+    for (int i = 0; i < 1000; ++i)
+    {
+        allocator.allocate(128);
+    }
+    EXPECT_EQ(reservedBytes, allocator.getStatistics().reservedBytes);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        EXPECT_EQ(0x5a, before[i]);
+    }
+
+    allocator.pop();
+}
+
+// Test that scoped rewinds nest.
+TEST(PoolAllocTest, ScopedRewindsNest)
+{
+    TPoolAllocator allocator(kPageSize, 16, kMaxPageSize);
+    allocator.push();
+
+    void *outer = nullptr;
+    void *inner = nullptr;
+    {
+        TScopedPoolRewind outerRewind(&allocator);
+        outer = allocator.allocate(48);
+        {
+            TScopedPoolRewind innerRewind(&allocator);
+            inner = allocator.allocate(48);
+        }
+        EXPECT_EQ(inner, allocator.allocate(48));
+    }
+    EXPECT_EQ(outer, allocator.allocate(48));
+
+    allocator.pop();
+}
+
+// Test that push() carries on from the current page rather than starting a new one.
+TEST(PoolAllocTest, PushDoesNotStartANewPage)
+{
+    TPoolAllocator allocator(kPageSize, 16, kMaxPageSize);
+    allocator.push();
+    allocator.allocate(16);
+
+    size_t pages = allocator.getStatistics().pageAllocationCount;
+    allocator.push();
+    allocator.allocate(16);
+    EXPECT_EQ(pages, allocator.getStatistics().pageAllocationCount);
+    allocator.pop();
+
+    allocator.pop();
+}
+
+#endif  // !defined(ANGLE_TRANSLATOR_DISABLE_POOL_ALLOC)
+
+// Test that allocations are aligned, whatever their size.
+TEST(PoolAllocTest, AllocationsAreAligned)
+{
+    TPoolAllocator allocator(4 * 1024, 16);
+    allocator.push();
+
+    for (size_t size : {1u, 3u, 16u, 17u, 1000u, 5000u, 300000u, 7u})
+    {
+        void *memory = allocator.allocate(size);
+        ASSERT_NE(nullptr, memory);
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(memory) % 16) << size;
+        memset(memory, 0, size);
+    }
+
+    allocator.pop();
+}
+
+}  // anonymous namespace
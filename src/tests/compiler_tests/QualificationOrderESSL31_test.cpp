@@ -23,6 +23,8 @@ class QualificationVertexShaderTestESSL31 : public testing::Test
   protected:
     virtual void SetUp()
     {
+        allocator.push();
+        SetGlobalPoolAllocator(&allocator);
         ShBuiltInResources resources;
         InitBuiltInResources(&resources);
 
@@ -30,7 +32,12 @@ class QualificationVertexShaderTestESSL31 : public testing::Test
         ASSERT_TRUE(mTranslator->Init(resources));
     }
 
-    virtual void TearDown() { delete mTranslator; }
+    virtual void TearDown()
+    {
+        delete mTranslator;
+        SetGlobalPoolAllocator(nullptr);
+        allocator.pop();
+    }
 
     // Return true when compilation succeeds
     bool compile(const std::string &shaderString)
@@ -51,6 +58,7 @@ class QualificationVertexShaderTestESSL31 : public testing::Test
   protected:
     TranslatorESSL *mTranslator;
     TIntermNode *mASTRoot;
+    TPoolAllocator allocator;
     std::string mInfoLog;
 };
 
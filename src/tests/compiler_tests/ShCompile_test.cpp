@@ -41,6 +41,15 @@ class ShCompileTest : public testing::Test
         EXPECT_EQ(expectation, success) << compileLog;
     }
 
+    const ShCompileStatistics *compileWithStatistics(const char *shaderString,
+                                                     ShCompileOptions compileOptions,
+                                                     bool expectation)
+    {
+        bool success = sh::Compile(mCompiler, &shaderString, 1, compileOptions);
+        EXPECT_EQ(expectation, success) << sh::GetInfoLog(mCompiler);
+        return sh::GetCompileStatistics(mCompiler);
+    }
+
   private:
     ShBuiltInResources mResources;
     ShHandle mCompiler;
@@ -81,3 +90,74 @@ TEST_F(ShCompileTest, TokensSplitInShaderStrings)
 
     testCompile(shaderStrings, 3, true);
 }
+
+// Test that statistics are only collected when they are asked for.
+TEST_F(ShCompileTest, CompileStatisticsAreOptional)
+{
+    const char *shaderString =
+        "precision mediump float;\n"
+        "void main() {\n"
+        "    gl_FragColor = vec4(0.0);\n"
+        "}";
+
+    EXPECT_EQ(nullptr, compileWithStatistics(shaderString, SH_OBJECT_CODE, true));
+    EXPECT_NE(nullptr, compileWithStatistics(shaderString,
+                                             SH_OBJECT_CODE | SH_COLLECT_COMPILE_STATISTICS, true));
+    EXPECT_EQ(nullptr, compileWithStatistics(shaderString, SH_OBJECT_CODE, true));
+}
+
+// Test that the statistics describe the passes that ran and the size of the shader.
+TEST_F(ShCompileTest, CompileStatistics)
+{
+    const char *shaderString =
+        "precision mediump float;\n"
+        "uniform vec4 u;\n"
+        "vec4 f(vec4 v) {\n"
+        "    return v * 2.0;\n"
+        "}\n"
+        "void main() {\n"
+        "    gl_FragColor = f(u);\n"
+        "}";
+
+    const ShCompileStatistics *statistics =
+        compileWithStatistics(shaderString, SH_OBJECT_CODE | SH_COLLECT_COMPILE_STATISTICS, true);
+    ASSERT_NE(nullptr, statistics);
+
+    ASSERT_FALSE(statistics->passes.empty());
+    EXPECT_EQ("Parse", statistics->passes.front().name);
+    EXPECT_EQ("Translate", statistics->passes.back().name);
+
+    double passSeconds = 0.0;
+    for (const ShCompilePassStatistics &pass : statistics->passes)
+    {
+        EXPECT_GE(pass.seconds, 0.0);
+        passSeconds += pass.seconds;
+    }
+    EXPECT_LE(passSeconds, statistics->totalSeconds);
+
+    EXPECT_GT(statistics->astNodeCount, 0u);
+    EXPECT_GT(statistics->astBytes, statistics->astNodeCount);
+    // u, f and main.
+    EXPECT_GE(statistics->globalSymbolCount, 3u);
+    EXPECT_GT(statistics->builtInSymbolCount, statistics->globalSymbolCount);
+    EXPECT_GT(statistics->poolAllocatedBytes, 0u);
+}
+
+// Test that the statistics of a compilation that fails cover the passes that ran before the error.
+TEST_F(ShCompileTest, CompileStatisticsOfFailedCompilation)
+{
+    const char *shaderString =
+        "precision mediump float;\n"
+        "void main() {\n"
+        "    gl_FragColor = undeclared;\n"
+        "}";
+
+    const ShCompileStatistics *statistics =
+        compileWithStatistics(shaderString, SH_OBJECT_CODE | SH_COLLECT_COMPILE_STATISTICS, false);
+    ASSERT_NE(nullptr, statistics);
+    ASSERT_EQ(1u, statistics->passes.size());
+    EXPECT_EQ("Parse", statistics->passes[0].name);
+    EXPECT_EQ(0u, statistics->astNodeCount);
+    EXPECT_EQ(0u, statistics->astBytes);
+    EXPECT_GT(statistics->poolAllocatedBytes, 0u);
+}
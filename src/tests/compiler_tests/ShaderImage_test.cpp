@@ -119,6 +119,8 @@ class ShaderImageTest : public testing::Test
   protected:
     virtual void SetUp()
     {
+        allocator.push();
+        SetGlobalPoolAllocator(&allocator);
         ShBuiltInResources resources;
         sh::InitBuiltInResources(&resources);
 
@@ -126,7 +128,12 @@ class ShaderImageTest : public testing::Test
         ASSERT_TRUE(mTranslator->Init(resources));
     }
 
-    virtual void TearDown() { delete mTranslator; }
+    virtual void TearDown()
+    {
+        delete mTranslator;
+        SetGlobalPoolAllocator(nullptr);
+        allocator.pop();
+    }
 
     // Return true when compilation succeeds
     bool compile(const std::string &shaderString)
@@ -144,6 +151,7 @@ class ShaderImageTest : public testing::Test
     std::string mInfoLog;
     sh::TranslatorESSL *mTranslator;
     TIntermNode *mASTRoot;
+    TPoolAllocator allocator;
 };
 
 // Test that an image2D is properly parsed and exported as a uniform.
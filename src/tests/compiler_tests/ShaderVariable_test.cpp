@@ -418,4 +418,93 @@ TEST(ShaderVariableTest, BuiltinInvariantVarying)
     EXPECT_FALSE(sh::Compile(compiler, program3, 1, SH_VARIABLES));
 }
 
+
+// Test that TakeReflection moves the variables of the last compilation out of the compiler as flat
+// records, that the lists built from the records match the ones the compiler returned, and that
+// the next compilation collects them again.
+TEST(ShaderVariableTest, TakeReflection)
+{
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+
+    ShHandle compiler = sh::ConstructCompiler(GL_VERTEX_SHADER, SH_GLES3_SPEC,
+                                              SH_GLSL_COMPATIBILITY_OUTPUT, &resources);
+    EXPECT_NE(static_cast<ShHandle>(0), compiler);
+
+    const char *program[] =
+    {
+        "#version 300 es\n"
+        "struct S { vec4 a; float b[2]; };\n"
+        "uniform S s;\n"
+        "uniform B { vec4 x; } b;\n"
+        "in vec4 position;\n"
+        "out vec4 v_varying;\n"
+        "void main() {\n"
+        "  v_varying = s.a + b.x;\n"
+        "  gl_Position = position * s.b[1];\n"
+        "}"
+    };
+
+    EXPECT_TRUE(sh::Compile(compiler, program, 1, SH_VARIABLES));
+    const std::vector<sh::Uniform> expectedUniforms = *sh::GetUniforms(compiler);
+    const std::vector<sh::Varying> expectedVaryings = *sh::GetVaryings(compiler);
+    const std::vector<sh::Attribute> expectedAttributes = *sh::GetAttributes(compiler);
+    const std::vector<sh::InterfaceBlock> expectedInterfaceBlocks =
+        *sh::GetInterfaceBlocks(compiler);
+    ASSERT_EQ(1u, expectedUniforms.size());
+
+    ShaderReflection reflection;
+    sh::TakeReflection(compiler, &reflection);
+
+    ASSERT_EQ(1u, reflection.uniforms.size());
+    const ShaderReflection::Variable &uniform = reflection.uniforms[0];
+    EXPECT_TRUE(reflection.stringEquals(uniform.name, "s"));
+    EXPECT_TRUE(reflection.stringEquals(uniform.structName, "S"));
+    EXPECT_TRUE(uniform.staticUse);
+    ASSERT_EQ(2u, uniform.fieldRange.count);
+    const ShaderReflection::Variable &field = reflection.getField(uniform.fieldRange, 1);
+    EXPECT_TRUE(reflection.stringEquals(field.name, "b"));
+    EXPECT_EQ(static_cast<GLenum>(GL_FLOAT), field.type);
+    EXPECT_EQ(2u, field.arraySize);
+
+    ASSERT_EQ(1u, reflection.interfaceBlocks.size());
+    const ShaderReflection::Block &block = reflection.interfaceBlocks[0];
+    EXPECT_TRUE(reflection.stringEquals(block.name, "B"));
+    EXPECT_TRUE(reflection.stringEquals(block.instanceName, "b"));
+    ASSERT_EQ(1u, block.fieldRange.count);
+    EXPECT_TRUE(reflection.stringEquals(reflection.getField(block.fieldRange, 0).name, "x"));
+
+    ASSERT_EQ(1u, reflection.attributes.size());
+    EXPECT_TRUE(reflection.stringEquals(reflection.attributes[0].name, "position"));
+    EXPECT_FALSE(reflection.varyings.empty());
+
+    std::vector<sh::Uniform> uniforms;
+    reflection.getUniforms(&uniforms);
+    EXPECT_EQ(expectedUniforms, uniforms);
+    std::vector<sh::Varying> varyings;
+    reflection.getVaryings(&varyings);
+    EXPECT_EQ(expectedVaryings, varyings);
+    std::vector<sh::Attribute> attributes;
+    reflection.getAttributes(&attributes);
+    EXPECT_EQ(expectedAttributes, attributes);
+    std::vector<sh::InterfaceBlock> interfaceBlocks;
+    reflection.getInterfaceBlocks(&interfaceBlocks);
+    ASSERT_EQ(expectedInterfaceBlocks.size(), interfaceBlocks.size());
+    EXPECT_EQ(expectedInterfaceBlocks[0].mappedName, interfaceBlocks[0].mappedName);
+    EXPECT_EQ(expectedInterfaceBlocks[0].instanceName, interfaceBlocks[0].instanceName);
+    EXPECT_EQ(expectedInterfaceBlocks[0].staticUse, interfaceBlocks[0].staticUse);
+    EXPECT_EQ(expectedInterfaceBlocks[0].fields, interfaceBlocks[0].fields);
+    EXPECT_TRUE(expectedInterfaceBlocks[0].isSameInterfaceBlockAtLinkTime(interfaceBlocks[0]));
+
+    EXPECT_TRUE(sh::GetUniforms(compiler)->empty());
+    EXPECT_TRUE(sh::GetVaryings(compiler)->empty());
+    EXPECT_TRUE(sh::GetAttributes(compiler)->empty());
+    EXPECT_TRUE(sh::GetInterfaceBlocks(compiler)->empty());
+
+    EXPECT_TRUE(sh::Compile(compiler, program, 1, SH_VARIABLES));
+    EXPECT_EQ(expectedUniforms, *sh::GetUniforms(compiler));
+
+    sh::Destruct(compiler);
+}
+
 }  // namespace sh
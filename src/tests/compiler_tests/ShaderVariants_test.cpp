@@ -0,0 +1,222 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShaderVariants_test.cpp:
+//   Tests that compiling shader variants gives the same results as compiling each variant's full
+//   source, and that variants that preprocess to the same source are only compiled once.
+//
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace
+{
+
+const char kPreamble[] =
+    "#version 300 es\n"
+    "#extension GL_EXT_shader_texture_lod : enable\n";
+
+const char kBody[] =
+    "precision mediump float;\n"
+    "out vec4 color;\n"
+    "#ifdef USE_TINT\n"
+    "uniform vec4 tint;\n"
+    "#endif\n"
+    "void main() {\n"
+    "    float scale = float(SCALE);\n"
+    "#if SCALE > 2\n"
+    "    scale = sqrt(scale);\n"
+    "#endif\n"
+    "    color = vec4(scale, float(__LINE__), 0.0, 1.0);\n"
+    "#ifdef USE_TINT\n"
+    "    color *= tint;\n"
+    "#endif\n"
+    "#line 100\n"
+    "    color.z = float(__LINE__);\n"
+    "#ifdef BROKEN\n"
+    "    color = undefined;\n"
+    "#endif\n"
+    "}\n";
+
+class ShaderVariantsTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        ShBuiltInResources resources;
+        sh::InitBuiltInResources(&resources);
+        resources.EXT_shader_texture_lod = 1;
+        // Otherwise the compiler enables it after the first ESSL 3.00 compilation, and the first
+        // variant preprocesses differently from the others.
+        resources.FragmentPrecisionHigh  = 1;
+        mCompiler =
+            sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_ESSL_OUTPUT, &resources);
+        ASSERT_NE(nullptr, mCompiler);
+    }
+
+    void TearDown() override { sh::Destruct(mCompiler); }
+
+    using Defines = std::vector<std::pair<std::string, std::string>>;
+
+    static ShShaderVariant MakeVariant(const std::string &name, const Defines &defines)
+    {
+        ShShaderVariant variant;
+        variant.name    = name;
+        variant.defines = defines;
+        return variant;
+    }
+
+    // Compiles the variant's full source, without the variant API.
+    ShBatchResult compileFullSource(const ShShaderVariantSet &variantSet,
+                                    const ShShaderVariant &variant)
+    {
+        std::string defines;
+        if (!variantSet.preamble.empty() && variantSet.preamble.back() != '\n')
+        {
+            defines = "\n";
+        }
+        for (const auto &define : variant.defines)
+        {
+            defines += "#define " + define.first + " " + define.second + "\n";
+        }
+        if (defines.empty())
+        {
+            defines = "\n";
+        }
+        const char *shaderStrings[] = {variantSet.preamble.c_str(), defines.c_str(),
+                                       variantSet.body.c_str()};
+
+        ShBatchResult result;
+        result.success = sh::Compile(mCompiler, shaderStrings, 3, kCompileOptions);
+        result.infoLog = sh::GetInfoLog(mCompiler);
+        if (result.success)
+        {
+            result.objectCode = sh::GetObjectCode(mCompiler);
+        }
+        return result;
+    }
+
+    void expectResultsMatchFullSources(const ShShaderVariantSet &variantSet,
+                                       const std::vector<ShBatchResult> &results)
+    {
+        ASSERT_EQ(variantSet.variants.size(), results.size());
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            ShBatchResult expected = compileFullSource(variantSet, variantSet.variants[i]);
+            EXPECT_EQ(variantSet.variants[i].name, results[i].name);
+            EXPECT_EQ(expected.success, results[i].success) << results[i].name;
+            EXPECT_EQ(expected.infoLog, results[i].infoLog) << results[i].name;
+            EXPECT_EQ(expected.objectCode, results[i].objectCode) << results[i].name;
+        }
+    }
+
+    static const ShCompileOptions kCompileOptions = SH_OBJECT_CODE | SH_VARIABLES;
+
+    ShHandle mCompiler;
+};
+
+// Test that each variant gets the results of compiling its full source, locations, #line
+// directives and errors included.
+TEST_F(ShaderVariantsTest, ResultsMatchCompilingFullSources)
+{
+    ShShaderVariantSet variantSet;
+    variantSet.preamble = kPreamble;
+    variantSet.body     = kBody;
+    variantSet.variants.push_back(MakeVariant("plain", {{"SCALE", "1"}}));
+    variantSet.variants.push_back(MakeVariant("tinted", {{"SCALE", "3"}, {"USE_TINT", ""}}));
+    variantSet.variants.push_back(MakeVariant("broken", {{"SCALE", "2"}, {"BROKEN", "1"}}));
+    variantSet.variants.push_back(MakeVariant("undefined", {}));
+
+    std::vector<ShBatchResult> results;
+    ShVariantStatistics statistics;
+    EXPECT_FALSE(sh::CompileVariants(mCompiler, variantSet, kCompileOptions, &results,
+                                     &statistics));
+
+    EXPECT_TRUE(statistics.bodyTokensReused);
+    EXPECT_EQ(4u, statistics.variantCount);
+    EXPECT_EQ(4u, statistics.compiledVariantCount);
+    EXPECT_EQ(0.0, statistics.dedupRate);
+
+    ASSERT_EQ(4u, results.size());
+    EXPECT_TRUE(results[0].success);
+    EXPECT_TRUE(results[1].success);
+    EXPECT_FALSE(results[2].success);
+    EXPECT_NE(std::string::npos, results[2].infoLog.find("2:102"));
+    EXPECT_FALSE(results[3].success);
+    expectResultsMatchFullSources(variantSet, results);
+}
+
+// Test that variants that only differ in macros the body doesn't look at are compiled once.
+TEST_F(ShaderVariantsTest, IdenticalPreprocessedSourcesAreCompiledOnce)
+{
+    ShShaderVariantSet variantSet;
+    variantSet.preamble = kPreamble;
+    variantSet.body     = kBody;
+    variantSet.variants.push_back(MakeVariant("a", {{"SCALE", "1"}}));
+    variantSet.variants.push_back(MakeVariant("b", {{"SCALE", "1"}, {"UNUSED", "7"}}));
+    variantSet.variants.push_back(MakeVariant("c", {{"SCALE", "4"}}));
+    variantSet.variants.push_back(MakeVariant("d", {{"UNUSED", "1"}, {"SCALE", "1"}}));
+
+    std::vector<ShBatchResult> results;
+    ShVariantStatistics statistics;
+    EXPECT_TRUE(
+        sh::CompileVariants(mCompiler, variantSet, kCompileOptions, &results, &statistics));
+
+    EXPECT_EQ(4u, statistics.variantCount);
+    EXPECT_EQ(2u, statistics.compiledVariantCount);
+    EXPECT_DOUBLE_EQ(0.5, statistics.dedupRate);
+
+    ASSERT_EQ(4u, results.size());
+    EXPECT_EQ(results[0].objectCode, results[1].objectCode);
+    EXPECT_EQ(results[0].objectCode, results[3].objectCode);
+    EXPECT_NE(results[0].objectCode, results[2].objectCode);
+    expectResultsMatchFullSources(variantSet, results);
+}
+
+// Test that a body that can't be tokenized ahead of time without errors is compiled from its
+// source for each variant, so that each of them reports the error.
+TEST_F(ShaderVariantsTest, BodyWithTokenizerErrors)
+{
+    ShShaderVariantSet variantSet;
+    variantSet.preamble = kPreamble;
+    variantSet.body     = std::string(kBody) + "/* unterminated";
+    variantSet.variants.push_back(MakeVariant("a", {{"SCALE", "1"}}));
+    variantSet.variants.push_back(MakeVariant("b", {{"SCALE", "2"}}));
+
+    std::vector<ShBatchResult> results;
+    ShVariantStatistics statistics;
+    EXPECT_FALSE(
+        sh::CompileVariants(mCompiler, variantSet, kCompileOptions, &results, &statistics));
+
+    EXPECT_FALSE(statistics.bodyTokensReused);
+    EXPECT_EQ(2u, statistics.compiledVariantCount);
+    ASSERT_EQ(2u, results.size());
+    EXPECT_NE(std::string::npos, results[0].infoLog.find("unexpected end of file"));
+    expectResultsMatchFullSources(variantSet, results);
+}
+
+// Test that the defines start on a line of their own when the preamble's last line isn't ended.
+TEST_F(ShaderVariantsTest, PreambleWithoutTrailingNewline)
+{
+    ShShaderVariantSet variantSet;
+    variantSet.preamble = "#version 300 es";
+    variantSet.body     = kBody;
+    variantSet.variants.push_back(MakeVariant("defines", {{"SCALE", "1"}}));
+    variantSet.variants.push_back(MakeVariant("no_defines", {}));
+
+    std::vector<ShBatchResult> results;
+    ShVariantStatistics statistics;
+    EXPECT_FALSE(
+        sh::CompileVariants(mCompiler, variantSet, kCompileOptions, &results, &statistics));
+
+    EXPECT_TRUE(statistics.bodyTokensReused);
+    ASSERT_EQ(2u, results.size());
+    EXPECT_TRUE(results[0].success) << results[0].infoLog;
+    EXPECT_FALSE(results[1].success);
+    expectResultsMatchFullSources(variantSet, results);
+}
+
+}  // anonymous namespace
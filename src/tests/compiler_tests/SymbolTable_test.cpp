@@ -0,0 +1,124 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SymbolTable_test.cpp:
+//   Tests for the hash table levels of the symbol table.
+//
+
+#include <sstream>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/PoolAlloc.h"
+#include "compiler/translator/SymbolTable.h"
+
+using namespace sh;
+
+namespace
+{
+
+class SymbolTableTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        allocator.push();
+        SetGlobalPoolAllocator(&allocator);
+    }
+
+    void TearDown() override
+    {
+        SetGlobalPoolAllocator(nullptr);
+        allocator.pop();
+    }
+
+    TVariable *createVariable(const TString &name)
+    {
+        return new TVariable(NewPoolTString(name.c_str()), TType(EbtFloat, EbpHigh, EvqTemporary));
+    }
+
+    TPoolAllocator allocator;
+};
+
+// Test that a level finds every symbol inserted into it as it grows, and refuses duplicates.
+TEST_F(SymbolTableTest, LevelInsertAndFind)
+{
+    TSymbolTableLevel level;
+    EXPECT_EQ(nullptr, level.find("missing"));
+
+    std::vector<TVariable *> variables;
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::stringstream name;
+        name << "v" << i;
+        variables.push_back(createVariable(name.str().c_str()));
+        ASSERT_TRUE(level.insert(variables.back()));
+    }
+    EXPECT_EQ(1000u, level.size());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::stringstream name;
+        name << "v" << i;
+        EXPECT_EQ(variables[i], level.find(name.str().c_str()));
+    }
+    EXPECT_EQ(nullptr, level.find("v1000"));
+    EXPECT_EQ(nullptr, level.find("v"));
+
+    TVariable *duplicate = createVariable("v10");
+    EXPECT_FALSE(level.insert(duplicate));
+    EXPECT_EQ(variables[10], level.find("v10"));
+    EXPECT_EQ(1000u, level.size());
+    delete duplicate;
+}
+
+// Test that functions can be found by both their mangled and unmangled names.
+TEST_F(SymbolTableTest, LevelFunctionNames)
+{
+    TSymbolTableLevel level;
+
+    TFunction *function = new TFunction(NewPoolTString("f"), new TType(EbtFloat));
+    function->addParameter(TConstParameter(new TType(EbtInt)));
+    ASSERT_TRUE(level.insert(function));
+    ASSERT_TRUE(level.insertUnmangled(function));
+
+    EXPECT_EQ(function, level.find(function->getMangledName()));
+    EXPECT_EQ(function, level.find("f"));
+    EXPECT_EQ(TString("f(") + TType(EbtInt).getMangledName(), function->getMangledName());
+
+    // The level owns the symbols under their mangled names only.
+    EXPECT_EQ(2u, level.size());
+}
+
+// Test that the symbol table finds the innermost declaration of a name.
+TEST_F(SymbolTableTest, InnerScopesShadowOuterOnes)
+{
+    TSymbolTable table;
+    for (int level = COMMON_BUILTINS; level <= GLOBAL_LEVEL; ++level)
+    {
+        table.push();
+    }
+
+    TVariable *global = createVariable("x");
+    ASSERT_TRUE(table.declare(global));
+
+    table.push();
+    TVariable *local = createVariable("x");
+    ASSERT_TRUE(table.declare(local));
+
+    bool builtIn   = true;
+    bool sameScope = false;
+    EXPECT_EQ(local, table.find("x", 100, &builtIn, &sameScope));
+    EXPECT_FALSE(builtIn);
+    EXPECT_TRUE(sameScope);
+
+    table.pop();
+    EXPECT_EQ(global, table.find("x", 100, &builtIn, &sameScope));
+    EXPECT_EQ(global, table.findGlobal("x"));
+    EXPECT_EQ(nullptr, table.find("y", 100));
+}
+
+}  // anonymous namespace
@@ -0,0 +1,195 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ThreadSafety_test.cpp:
+//   Tests that compilers on different threads don't share per-compilation state, and that a
+//   compiler only binds its pool allocator to the thread while it's in use.
+//
+
+#include <sstream>
+#include <thread>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/Common.h"
+#include "compiler/translator/PoolAlloc.h"
+
+using namespace sh;
+
+namespace
+{
+
+const size_t kThreadCount      = 8;
+const size_t kShadersPerThread = 12;
+
+// A shader with a loop, a function call and some constant folding, varied by index so that each
+// thread produces output of its own.
+std::string MakeShader(size_t index)
+{
+    std::stringstream source;
+    source << "precision mediump float;\n"
+              "uniform vec4 u"
+           << index << ";\n"
+                       "float f(float x) { return x * "
+           << index << ".0 + sin(2.0 * 3.0); }\n"
+                       "void main() {\n"
+                       "    vec4 sum = vec4(0.0);\n"
+                       "    for (int i = 0; i < "
+           << (index % 7 + 1) << "; ++i) {\n"
+                                 "        sum += u"
+           << index << " * f(float(i));\n"
+                       "    }\n"
+                       "    gl_FragColor = sum;\n"
+                       "}\n";
+    return source.str();
+}
+
+class ThreadSafetyTest : public testing::Test
+{
+  protected:
+    void SetUp() override { sh::InitBuiltInResources(&mResources); }
+
+    ShHandle constructCompiler()
+    {
+        return sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_WEBGL_SPEC, SH_ESSL_OUTPUT,
+                                     &mResources);
+    }
+
+    // Returns the object code, or the info log prefixed with "error" if compilation failed.
+    static std::string Compile(ShHandle compiler, const std::string &source)
+    {
+        const char *sourceString = source.c_str();
+        if (!sh::Compile(compiler, &sourceString, 1,
+                         SH_OBJECT_CODE | SH_VARIABLES | SH_VALIDATE_LOOP_INDEXING))
+        {
+            return "error" + sh::GetInfoLog(compiler);
+        }
+        return sh::GetObjectCode(compiler);
+    }
+
+    ShBuiltInResources mResources;
+};
+
+// Test that many threads compiling at once, each with its own compiler, get the same results as
+// compiling one shader at a time.
+TEST_F(ThreadSafetyTest, ConcurrentCompilersMatchSequentialCompilation)
+{
+    std::vector<std::string> expected;
+    ShHandle reference = constructCompiler();
+    ASSERT_NE(nullptr, reference);
+    for (size_t i = 0; i < kThreadCount * kShadersPerThread; ++i)
+    {
+        expected.push_back(Compile(reference, MakeShader(i)));
+        EXPECT_EQ(std::string::npos, expected.back().find("error")) << expected.back();
+    }
+    sh::Destruct(reference);
+
+    std::vector<std::string> results(expected.size());
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < kThreadCount; ++thread)
+    {
+        threads.emplace_back([this, thread, &results]() {
+            // Every thread constructs its compiler while the others are compiling, so that
+            // building the built-in symbol tables also overlaps.
+            ShHandle compiler = constructCompiler();
+            for (size_t i = 0; i < kShadersPerThread; ++i)
+            {
+                size_t index   = i * kThreadCount + thread;
+                results[index] = compiler ? Compile(compiler, MakeShader(index)) : "no compiler";
+            }
+            sh::Destruct(compiler);
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(expected[i], results[i]) << "shader " << i;
+    }
+}
+
+// Test that a compiler can be constructed on one thread and used on others.
+TEST_F(ThreadSafetyTest, CompilerMovesBetweenThreads)
+{
+    ShHandle compiler = constructCompiler();
+    ASSERT_NE(nullptr, compiler);
+
+    std::string expected = Compile(compiler, MakeShader(0));
+
+    std::string onOtherThread;
+    std::thread thread([&compiler, &onOtherThread]() {
+        onOtherThread = Compile(compiler, MakeShader(0));
+    });
+    thread.join();
+    EXPECT_EQ(expected, onOtherThread);
+
+    EXPECT_EQ(expected, Compile(compiler, MakeShader(0)));
+    sh::Destruct(compiler);
+}
+
+// Test that constructing and using a compiler leaves the thread's current pool as it was.
+TEST_F(ThreadSafetyTest, CompilerRestoresCurrentPool)
+{
+    TPoolAllocator outerAllocator;
+    outerAllocator.push();
+    SetGlobalPoolAllocator(&outerAllocator);
+
+    ShHandle compiler = constructCompiler();
+    ASSERT_NE(nullptr, compiler);
+    EXPECT_EQ(&outerAllocator, GetGlobalPoolAllocator());
+
+    Compile(compiler, MakeShader(1));
+    EXPECT_EQ(&outerAllocator, GetGlobalPoolAllocator());
+
+    sh::Destruct(compiler);
+    EXPECT_EQ(&outerAllocator, GetGlobalPoolAllocator());
+
+    SetGlobalPoolAllocator(nullptr);
+    outerAllocator.pop();
+}
+
+// Test that a container keeps allocating from the pool it was created with, whichever pool is
+// current.
+TEST(PoolAllocatorTest, ContainersAllocateFromTheirOwnPool)
+{
+    TPoolAllocator first;
+    TPoolAllocator second;
+    first.push();
+    second.push();
+
+    SetGlobalPoolAllocator(&first);
+    TVector<int> boundToFirst;
+    TVector<int> explicitlySecond{pool_allocator<int>(second)};
+
+    size_t firstBytes  = first.getTotalAllocatedBytes();
+    size_t secondBytes = second.getTotalAllocatedBytes();
+
+    SetGlobalPoolAllocator(&second);
+    boundToFirst.resize(100);
+    EXPECT_LT(firstBytes, first.getTotalAllocatedBytes());
+    EXPECT_EQ(secondBytes, second.getTotalAllocatedBytes());
+
+    firstBytes = first.getTotalAllocatedBytes();
+    SetGlobalPoolAllocator(&first);
+    explicitlySecond.resize(100);
+    EXPECT_EQ(firstBytes, first.getTotalAllocatedBytes());
+    EXPECT_LT(secondBytes, second.getTotalAllocatedBytes());
+
+    // Copies allocate from the current pool.
+    secondBytes = second.getTotalAllocatedBytes();
+    TVector<int> copy(explicitlySecond);
+    EXPECT_EQ(secondBytes, second.getTotalAllocatedBytes());
+    EXPECT_LT(firstBytes, first.getTotalAllocatedBytes());
+
+    SetGlobalPoolAllocator(nullptr);
+    second.pop();
+    first.pop();
+}
+
+}  // anonymous namespace
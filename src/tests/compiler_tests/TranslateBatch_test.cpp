@@ -0,0 +1,148 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslateBatch_test.cpp:
+//   Tests that translating shaders in a batch on several threads gives the same results as
+//   compiling them one by one.
+//
+
+#include <sstream>
+
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace
+{
+
+class TranslateBatchTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        sh::InitBuiltInResources(&mOptions.resources);
+        mOptions.spec           = SH_GLES2_SPEC;
+        mOptions.output         = SH_GLSL_COMPATIBILITY_OUTPUT;
+        mOptions.compileOptions = SH_OBJECT_CODE | SH_VARIABLES;
+        mOptions.threadCount    = 4;
+    }
+
+    void addShader(sh::GLenum type, const std::string &source)
+    {
+        std::stringstream name;
+        name << "shader" << mShaders.size();
+        mShaders.push_back({name.str(), type, source});
+    }
+
+    // Adds vertex and fragment shaders that use their index as a constant, with every fifth
+    // fragment shader failing to compile.
+    void addShaders(size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::stringstream source;
+            if (i % 2 == 0)
+            {
+                source << "attribute vec4 position;\n"
+                          "void main() {\n"
+                          "    gl_Position = position * "
+                       << i << ".0;\n"
+                               "}\n";
+                addShader(GL_VERTEX_SHADER, source.str());
+            }
+            else
+            {
+                source << "precision mediump float;\n"
+                          "void main() {\n"
+                          "    gl_FragColor = vec4("
+                       << i << ".0)" << (i % 5 == 0 ? " + undefined" : "")
+                       << ";\n"
+                          "}\n";
+                addShader(GL_FRAGMENT_SHADER, source.str());
+            }
+        }
+    }
+
+    // Compiles a shader with a compiler of its own.
+    ShBatchResult compileAlone(const ShBatchShader &shader)
+    {
+        ShHandle compiler =
+            sh::ConstructCompiler(shader.type, mOptions.spec, mOptions.output, &mOptions.resources);
+        EXPECT_NE(nullptr, compiler);
+
+        ShBatchResult result;
+        result.name        = shader.name;
+        const char *source = shader.source.c_str();
+        result.success     = sh::Compile(compiler, &source, 1, mOptions.compileOptions);
+        result.infoLog     = sh::GetInfoLog(compiler);
+        if (result.success)
+        {
+            result.objectCode = sh::GetObjectCode(compiler);
+        }
+        result.seconds = 0.0;
+
+        sh::Destruct(compiler);
+        return result;
+    }
+
+    ShBatchOptions mOptions;
+    std::vector<ShBatchShader> mShaders;
+};
+
+// Test that the results of a batch come back in order and match separate compilations.
+TEST_F(TranslateBatchTest, MatchesSeparateCompilation)
+{
+    addShaders(40);
+
+    std::vector<ShBatchResult> results;
+    EXPECT_FALSE(sh::TranslateBatch(mOptions, mShaders, &results));
+    ASSERT_EQ(mShaders.size(), results.size());
+
+    for (size_t i = 0; i < mShaders.size(); ++i)
+    {
+        ShBatchResult expected = compileAlone(mShaders[i]);
+        EXPECT_EQ(mShaders[i].name, results[i].name);
+        EXPECT_EQ(expected.success, results[i].success) << results[i].infoLog;
+        EXPECT_EQ(expected.infoLog, results[i].infoLog);
+        EXPECT_EQ(expected.objectCode, results[i].objectCode);
+        EXPECT_GE(results[i].seconds, 0.0);
+    }
+}
+
+// Test that a batch in which every shader compiles succeeds, whatever the number of threads.
+TEST_F(TranslateBatchTest, SucceedsWhenAllShadersCompile)
+{
+    for (size_t i = 0; i < 8; ++i)
+    {
+        addShader(GL_FRAGMENT_SHADER,
+                  "precision mediump float;\n"
+                  "void main() {\n"
+                  "    gl_FragColor = vec4(1.0);\n"
+                  "}\n");
+    }
+
+    for (unsigned int threadCount : {0u, 1u, 3u, 16u})
+    {
+        mOptions.threadCount = threadCount;
+        std::vector<ShBatchResult> results;
+        EXPECT_TRUE(sh::TranslateBatch(mOptions, mShaders, &results));
+        ASSERT_EQ(mShaders.size(), results.size());
+        for (const ShBatchResult &result : results)
+        {
+            EXPECT_TRUE(result.success);
+            EXPECT_FALSE(result.objectCode.empty());
+        }
+    }
+}
+
+// Test that an empty batch succeeds without results.
+TEST_F(TranslateBatchTest, EmptyBatch)
+{
+    std::vector<ShBatchResult> results;
+    EXPECT_TRUE(sh::TranslateBatch(mOptions, mShaders, &results));
+    EXPECT_TRUE(results.empty());
+}
+
+}  // anonymous namespace
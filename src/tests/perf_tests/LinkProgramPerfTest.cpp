@@ -4,12 +4,15 @@
 // found in the LICENSE file.
 //
 // LinkProgramPerfTest:
-//   Performance tests compiling a lot of shaders.
+//   Performance tests compiling a lot of shaders, and linking programs with hundreds of uniforms,
+//   varyings and uniform block fields, or loading the same programs from their binaries.
 //
 
 #include "ANGLEPerfTest.h"
 
 #include <array>
+#include <sstream>
+#include <vector>
 
 #include "common/vector_utils.h"
 #include "shader_utils.h"
@@ -19,6 +22,14 @@ using namespace angle;
 namespace
 {
 
+enum class ProgramSize
+{
+    // Tiny shaders, compiled and linked on every iteration.
+    Small,
+    // Large ES3 shaders, compiled once so that only the link is timed.
+    Large,
+};
+
 struct LinkProgramParams final : public RenderTestParams
 {
     LinkProgramParams()
@@ -27,6 +38,8 @@ struct LinkProgramParams final : public RenderTestParams
         minorVersion = 0;
         windowWidth  = 256;
         windowHeight = 256;
+        programSize  = ProgramSize::Small;
+        loadBinary   = false;
     }
 
     std::string suffix() const override
@@ -39,8 +52,23 @@ struct LinkProgramParams final : public RenderTestParams
             strstr << "_null";
         }
 
+        if (programSize == ProgramSize::Large)
+        {
+            strstr << "_large";
+        }
+
+        if (loadBinary)
+        {
+            strstr << "_binary";
+        }
+
         return strstr.str();
     }
+
+    ProgramSize programSize;
+
+    // Time glProgramBinary with the binary of the large program instead of linking it.
+    bool loadBinary;
 };
 
 std::ostream &operator<<(std::ostream &os, const LinkProgramParams &params)
@@ -60,9 +88,129 @@ class LinkProgramBenchmark : public ANGLERenderTest,
     void drawBenchmark() override;
 
   protected:
-    GLuint mVertexBuffer = 0;
+    void drawSmallProgram();
+    void linkLargeProgram();
+    void loadLargeProgramBinary();
+
+    GLuint mVertexBuffer   = 0;
+    GLuint mVertexShader   = 0;
+    GLuint mFragmentShader = 0;
+
+    GLenum mProgramBinaryFormat = GL_NONE;
+    std::vector<uint8_t> mProgramBinary;
 };
 
+// Counts of the variables in the large program. They stay within the minimum ES 3.0 limits, which
+// are those of the null back-end.
+constexpr size_t kLargeFloatUniformCount = 100;
+constexpr size_t kLargeVec4UniformCount  = 80;
+constexpr size_t kLargeLightCount        = 8;
+constexpr size_t kLargeBlockCount        = 12;
+constexpr size_t kLargeBlockFieldCount   = 16;
+constexpr size_t kLargeVaryingCount      = 48;
+
+// Both stages declare the same uniforms and uniform blocks, and use all of them, so that linking
+// has to match every one of them between the stages.
+std::string LargeProgramDeclarations()
+{
+    std::stringstream strstr;
+    strstr << "#version 300 es\n"
+              "precision highp float;\n"
+              "struct Light { vec3 position; vec3 color; float intensity; };\n"
+              "uniform Light lights["
+           << kLargeLightCount << "];\n";
+
+    for (size_t index = 0; index < kLargeFloatUniformCount; ++index)
+    {
+        strstr << "uniform float f" << index << ";\n";
+    }
+    for (size_t index = 0; index < kLargeVec4UniformCount; ++index)
+    {
+        strstr << "uniform vec4 v" << index << ";\n";
+    }
+    for (size_t blockIndex = 0; blockIndex < kLargeBlockCount; ++blockIndex)
+    {
+        strstr << "uniform Block" << blockIndex << " {\n";
+        for (size_t fieldIndex = 0; fieldIndex < kLargeBlockFieldCount; ++fieldIndex)
+        {
+            strstr << "    vec4 field" << fieldIndex << ";\n";
+        }
+        strstr << "} block" << blockIndex << ";\n";
+    }
+    return strstr.str();
+}
+
+// Sums all the uniforms into "float sum" and "vec4 value".
+std::string LargeProgramUniformSum()
+{
+    std::stringstream strstr;
+    strstr << "    float sum = 0.0;\n"
+              "    vec4 value = vec4(0.0);\n";
+    strstr << "    for (int i = 0; i < " << kLargeLightCount << "; ++i)\n";
+    strstr << "    {\n"
+              "        value.xyz += lights[i].position * lights[i].intensity + lights[i].color;\n"
+              "    }\n";
+
+    for (size_t index = 0; index < kLargeFloatUniformCount; ++index)
+    {
+        strstr << "    sum += f" << index << ";\n";
+    }
+    for (size_t index = 0; index < kLargeVec4UniformCount; ++index)
+    {
+        strstr << "    value += v" << index << ";\n";
+    }
+    for (size_t blockIndex = 0; blockIndex < kLargeBlockCount; ++blockIndex)
+    {
+        for (size_t fieldIndex = 0; fieldIndex < kLargeBlockFieldCount; ++fieldIndex)
+        {
+            strstr << "    value += block" << blockIndex << ".field" << fieldIndex << ";\n";
+        }
+    }
+    return strstr.str();
+}
+
+std::string LargeVertexShader()
+{
+    std::stringstream strstr;
+    strstr << LargeProgramDeclarations() << "in vec2 position;\n";
+    for (size_t index = 0; index < kLargeVaryingCount; ++index)
+    {
+        strstr << "out float varying" << index << ";\n";
+    }
+
+    strstr << "void main()\n"
+              "{\n"
+           << LargeProgramUniformSum();
+    for (size_t index = 0; index < kLargeVaryingCount; ++index)
+    {
+        strstr << "    varying" << index << " = sum + float(" << index << ");\n";
+    }
+    strstr << "    gl_Position = vec4(position, 0, 1) + value;\n"
+              "}\n";
+    return strstr.str();
+}
+
+std::string LargeFragmentShader()
+{
+    std::stringstream strstr;
+    strstr << LargeProgramDeclarations() << "out vec4 color;\n";
+    for (size_t index = 0; index < kLargeVaryingCount; ++index)
+    {
+        strstr << "in float varying" << index << ";\n";
+    }
+
+    strstr << "void main()\n"
+              "{\n"
+           << LargeProgramUniformSum();
+    for (size_t index = 0; index < kLargeVaryingCount; ++index)
+    {
+        strstr << "    sum += varying" << index << ";\n";
+    }
+    strstr << "    color = value * sum;\n"
+              "}\n";
+    return strstr.str();
+}
+
 LinkProgramBenchmark::LinkProgramBenchmark() : ANGLERenderTest("LinkProgram", GetParam())
 {
 }
@@ -77,14 +225,57 @@ void LinkProgramBenchmark::initializeBenchmark()
     glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vector3), vertices.data(),
                  GL_STATIC_DRAW);
+
+    if (GetParam().programSize == ProgramSize::Large)
+    {
+        mVertexShader   = CompileShader(GL_VERTEX_SHADER, LargeVertexShader());
+        mFragmentShader = CompileShader(GL_FRAGMENT_SHADER, LargeFragmentShader());
+        ASSERT_NE(0u, mVertexShader);
+        ASSERT_NE(0u, mFragmentShader);
+    }
+
+    if (GetParam().loadBinary)
+    {
+        GLuint program = glCreateProgram();
+        glAttachShader(program, mVertexShader);
+        glAttachShader(program, mFragmentShader);
+        glLinkProgram(program);
+
+        GLint binaryLength = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+        mProgramBinary.resize(binaryLength);
+        glGetProgramBinary(program, binaryLength, nullptr, &mProgramBinaryFormat,
+                           mProgramBinary.data());
+        glDeleteProgram(program);
+        ASSERT_GL_NO_ERROR();
+        ASSERT_NE(0, binaryLength);
+    }
 };
 
 void LinkProgramBenchmark::destroyBenchmark()
 {
     glDeleteBuffers(1, &mVertexBuffer);
+    glDeleteShader(mVertexShader);
+    glDeleteShader(mFragmentShader);
 }
 
 void LinkProgramBenchmark::drawBenchmark()
+{
+    if (GetParam().loadBinary)
+    {
+        loadLargeProgramBinary();
+    }
+    else if (GetParam().programSize == ProgramSize::Large)
+    {
+        linkLargeProgram();
+    }
+    else
+    {
+        drawSmallProgram();
+    }
+}
+
+void LinkProgramBenchmark::drawSmallProgram()
 {
     static const char *vertexShader =
         "attribute vec2 position;\n"
@@ -112,6 +303,31 @@ void LinkProgramBenchmark::drawBenchmark()
     glDeleteProgram(program);
 }
 
+void LinkProgramBenchmark::linkLargeProgram()
+{
+    GLuint program = glCreateProgram();
+    glAttachShader(program, mVertexShader);
+    glAttachShader(program, mFragmentShader);
+    glLinkProgram(program);
+
+    GLint linkStatus = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+    glDeleteProgram(program);
+    ASSERT_EQ(GL_TRUE, linkStatus);
+}
+
+void LinkProgramBenchmark::loadLargeProgramBinary()
+{
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, mProgramBinaryFormat, mProgramBinary.data(),
+                    static_cast<GLsizei>(mProgramBinary.size()));
+
+    GLint linkStatus = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+    glDeleteProgram(program);
+    ASSERT_EQ(GL_TRUE, linkStatus);
+}
+
 using namespace egl_platform;
 
 LinkProgramParams LinkProgramD3D11Params()
@@ -135,6 +351,22 @@ LinkProgramParams LinkProgramOpenGLParams()
     return params;
 }
 
+LinkProgramParams LinkProgramNullLargeParams()
+{
+    LinkProgramParams params;
+    params.eglParameters = EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE);
+    params.majorVersion  = 3;
+    params.programSize   = ProgramSize::Large;
+    return params;
+}
+
+LinkProgramParams LinkProgramNullLargeBinaryParams()
+{
+    LinkProgramParams params = LinkProgramNullLargeParams();
+    params.loadBinary        = true;
+    return params;
+}
+
 TEST_P(LinkProgramBenchmark, Run)
 {
     run();
@@ -143,6 +375,8 @@ TEST_P(LinkProgramBenchmark, Run)
 ANGLE_INSTANTIATE_TEST(LinkProgramBenchmark,
                        LinkProgramD3D11Params(),
                        LinkProgramD3D9Params(),
-                       LinkProgramOpenGLParams());
+                       LinkProgramOpenGLParams(),
+                       LinkProgramNullLargeParams(),
+                       LinkProgramNullLargeBinaryParams());
 
 }  // anonymous namespace
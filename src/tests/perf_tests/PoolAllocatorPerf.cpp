@@ -0,0 +1,263 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PoolAllocatorPerf:
+//   Performance test for the translator's pool allocator, on its own and through compiles of a
+//   corpus of small shaders and of one large shader.
+//
+
+#include <sstream>
+
+#include "ANGLEPerfTest.h"
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+#include "compiler/translator/PoolAlloc.h"
+
+namespace
+{
+
+enum class PoolWorkload
+{
+    // Allocation pattern of a compile straight on the pool: many small nodes and strings, the odd
+    // large block, and a pop at the end.
+    Allocations,
+    // The sort of shaders the constant folding and malformed shader tests compile.
+    SmallShaders,
+    LargeShader,
+};
+
+struct PoolAllocatorPerfParams final
+{
+    std::string suffix() const
+    {
+        switch (workload)
+        {
+            case PoolWorkload::Allocations:
+                return "_allocations";
+            case PoolWorkload::SmallShaders:
+                return "_small_shaders";
+            case PoolWorkload::LargeShader:
+                return "_large_shader";
+            default:
+                return "";
+        }
+    }
+
+    PoolWorkload workload;
+};
+
+std::ostream &operator<<(std::ostream &stream, const PoolAllocatorPerfParams &param)
+{
+    stream << param.suffix().substr(1);
+    return stream;
+}
+
+const char *kSmallShaders[] = {
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "out vec4 my_FragColor;\n"
+    "void main() {\n"
+    "    const mat3 m = mat3(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0);\n"
+    "    vec3 v = m * vec3(1.0, 0.5, 0.25) + inverse(mat2(2.0, 1.0, 1.0, 2.0))[0].xyx;\n"
+    "    my_FragColor = vec4(v, dot(v, vec3(1.0)));\n"
+    "}\n",
+
+    "#version 300 es\n"
+    "precision highp float;\n"
+    "uniform ivec4 u;\n"
+    "out vec4 my_FragColor;\n"
+    "void main() {\n"
+    "    const int i = (0x7fffffff + 1) >> 3;\n"
+    "    const uint r = uint(i) % 7u;\n"
+    "    my_FragColor = vec4(float(r) * 1e20 * 1e20, u.x, isnan(0.0 / 0.0) ? 1.0 : 0.0, 1.0);\n"
+    "}\n",
+
+    "precision mediump float;\n"
+    "struct S { vec4 a; float b[3]; };\n"
+    "uniform S s;\n"
+    "vec4 f(S x, float y) { return x.a * y + x.b[1]; }\n"
+    "void main() {\n"
+    "    gl_FragColor = f(s, 2.0) + vec4(sin(0.5), cos(0.5), tan(0.5), exp(1.0));\n"
+    "}\n",
+
+    // Fails to compile, as half of the malformed shader tests do.
+    "precision mediump float;\n"
+    "void main() {\n"
+    "    float f = undefined + 1.0;\n"
+    "    gl_FragColor = vec4(f);\n"
+    "}\n",
+};
+
+// A long shader with many small functions, as an uber-shader would have.
+std::string GenerateLargeShader()
+{
+    std::stringstream source;
+    source << "precision highp float;\n"
+              "uniform vec4 u[16];\n";
+    const int functionCount = 150;
+    for (int i = 0; i < functionCount; ++i)
+    {
+        source << "vec4 f" << i << "(vec4 a, float b) {\n"
+               << "    vec4 r = a * " << i << ".0 + u[" << i % 16 << "];\n"
+               << "    for (int j = 0; j < 4; ++j) { r += vec4(b * float(j), r.yzx) * 0.5; }\n"
+               << "    return clamp(r, vec4(-1.0), vec4(1.0)) * b;\n"
+               << "}\n";
+    }
+    source << "void main() {\n"
+              "    vec4 v = u[0];\n";
+    for (int i = 0; i < functionCount; ++i)
+    {
+        source << "    v = f" << i << "(v, " << i << ".0 * 0.01);\n";
+    }
+    source << "    gl_FragColor = v;\n"
+              "}\n";
+    return source.str();
+}
+
+class PoolAllocatorPerfTest : public ANGLEPerfTest,
+                              public ::testing::WithParamInterface<PoolAllocatorPerfParams>
+{
+  public:
+    PoolAllocatorPerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    void compile(ShHandle compiler, const char *source);
+
+    TPoolAllocator mAllocator;
+    ShHandle mFragmentCompiler;
+    ShHandle mES3FragmentCompiler;
+    std::string mLargeShader;
+    size_t mPoolBytes;
+    size_t mASTBytes;
+};
+
+PoolAllocatorPerfTest::PoolAllocatorPerfTest()
+    : ANGLEPerfTest("PoolAllocatorPerf", GetParam().suffix()),
+      mFragmentCompiler(nullptr),
+      mES3FragmentCompiler(nullptr),
+      mPoolBytes(0),
+      mASTBytes(0)
+{
+    mRunTimeSeconds = 3.0;
+}
+
+void PoolAllocatorPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    ASSERT_TRUE(sh::Initialize());
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    // The large shader uses highp.
+    resources.FragmentPrecisionHigh = 1;
+    mFragmentCompiler =
+        sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+    mES3FragmentCompiler =
+        sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, mFragmentCompiler);
+    ASSERT_NE(nullptr, mES3FragmentCompiler);
+
+    mLargeShader = GenerateLargeShader();
+}
+
+void PoolAllocatorPerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    if (GetParam().workload == PoolWorkload::Allocations)
+    {
+        TPoolAllocator::Statistics statistics = mAllocator.getStatistics();
+        printResult("page_allocations", statistics.pageAllocationCount, "pages", false);
+        printResult("reserved_bytes", statistics.reservedBytes, "bytes", false);
+    }
+    else
+    {
+        printResult("pool_bytes_per_step", mPoolBytes, "bytes", false);
+        printResult("ast_bytes_per_step", mASTBytes, "bytes", false);
+    }
+
+    sh::Destruct(mFragmentCompiler);
+    sh::Destruct(mES3FragmentCompiler);
+    sh::Finalize();
+}
+
+void PoolAllocatorPerfTest::compile(ShHandle compiler, const char *source)
+{
+    sh::Compile(compiler, &source, 1, SH_OBJECT_CODE | SH_COLLECT_COMPILE_STATISTICS);
+    const ShCompileStatistics *statistics = sh::GetCompileStatistics(compiler);
+    if (statistics)
+    {
+        mPoolBytes += statistics->poolAllocatedBytes;
+        mASTBytes += statistics->astBytes;
+    }
+}
+
+void PoolAllocatorPerfTest::step()
+{
+    mPoolBytes = 0;
+    mASTBytes  = 0;
+
+    switch (GetParam().workload)
+    {
+        case PoolWorkload::Allocations:
+        {
+            mAllocator.push();
+            for (size_t i = 0; i < 20000; ++i)
+            {
+                mAllocator.allocate(16 + (i % 7) * 24);
+                if (i % 5000 == 0)
+                {
+                    mAllocator.allocate(300 * 1024);
+                }
+                if (i % 100 == 0)
+                {
+                    TScopedPoolRewind temporaries(&mAllocator);
+                    for (size_t j = 0; j < 50; ++j)
+                    {
+                        mAllocator.allocate(32);
+                    }
+                }
+            }
+            mAllocator.pop();
+            break;
+        }
+        case PoolWorkload::SmallShaders:
+            for (const char *source : kSmallShaders)
+            {
+                compile(source[0] == '#' ? mES3FragmentCompiler : mFragmentCompiler, source);
+            }
+            break;
+        case PoolWorkload::LargeShader:
+            compile(mFragmentCompiler, mLargeShader.c_str());
+            break;
+        default:
+            UNREACHABLE();
+            break;
+    }
+}
+
+TEST_P(PoolAllocatorPerfTest, Run)
+{
+    run();
+}
+
+PoolAllocatorPerfParams WorkloadParams(PoolWorkload workload)
+{
+    PoolAllocatorPerfParams params;
+    params.workload = workload;
+    return params;
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        PoolAllocatorPerfTest,
+                        ::testing::Values(WorkloadParams(PoolWorkload::Allocations),
+                                          WorkloadParams(PoolWorkload::SmallShaders),
+                                          WorkloadParams(PoolWorkload::LargeShader)));
+
+}  // anonymous namespace
@@ -0,0 +1,146 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PreprocessorPerf:
+//   Performance test for preprocessing large, macro-heavy shaders.
+//
+
+#include <sstream>
+
+#include "ANGLEPerfTest.h"
+#include "compiler/preprocessor/Preprocessor.h"
+#include "compiler/preprocessor/Token.h"
+#include "preprocessor_tests/MockDiagnostics.h"
+#include "preprocessor_tests/MockDirectiveHandler.h"
+
+using namespace testing;
+
+namespace
+{
+
+struct PreprocessorPerfParams final
+{
+    std::string suffix() const { return functionMacros ? "_function_macros" : "_object_macros"; }
+
+    unsigned int macroCount;
+    unsigned int statementCount;
+    bool functionMacros;
+};
+
+std::ostream &operator<<(std::ostream &stream, const PreprocessorPerfParams &param)
+{
+    stream << param.suffix().substr(1);
+    return stream;
+}
+
+// Builds an uber-shader style source: a long block of #defines followed by a body that uses them.
+std::string GenerateShaderSource(const PreprocessorPerfParams &params)
+{
+    std::stringstream source;
+    source << "precision mediump float;\n";
+    for (unsigned int i = 0; i < params.macroCount; ++i)
+    {
+        source << "#define SCALE_FACTOR_" << i << " (" << i << ".0 * 0.5)\n";
+        if (params.functionMacros)
+        {
+            source << "#define BLEND_CHANNEL_" << i << "(a, b) ((a) * SCALE_FACTOR_" << i
+                   << " + (b) * (1.0 - SCALE_FACTOR_" << i << "))\n";
+        }
+    }
+
+    source << "void main()\n{\n    float accumulator = 0.0;\n";
+    for (unsigned int i = 0; i < params.statementCount; ++i)
+    {
+        unsigned int macro = (i * 7) % params.macroCount;
+        if (params.functionMacros)
+        {
+            source << "    accumulator = BLEND_CHANNEL_" << macro << "(accumulator, SCALE_FACTOR_"
+                   << (macro + 1) % params.macroCount << ");\n";
+        }
+        else
+        {
+            source << "    accumulator += SCALE_FACTOR_" << macro << " * accumulator;\n";
+        }
+    }
+    source << "    gl_FragColor = vec4(accumulator);\n}\n";
+    return source.str();
+}
+
+class PreprocessorPerfTest : public ANGLEPerfTest,
+                             public ::testing::WithParamInterface<PreprocessorPerfParams>
+{
+  public:
+    PreprocessorPerfTest();
+
+    void step() override;
+    void TearDown() override;
+
+  private:
+    std::string mSource;
+    size_t mTokenCount;
+    NiceMock<MockDiagnostics> mDiagnostics;
+    NiceMock<MockDirectiveHandler> mDirectiveHandler;
+};
+
+PreprocessorPerfTest::PreprocessorPerfTest()
+    : ANGLEPerfTest("PreprocessorPerf", GetParam().suffix()),
+      mSource(GenerateShaderSource(GetParam())),
+      mTokenCount(0)
+{
+    mRunTimeSeconds = 3.0;
+}
+
+void PreprocessorPerfTest::step()
+{
+    pp::Preprocessor preprocessor(&mDiagnostics, &mDirectiveHandler, pp::PreprocessorSettings());
+
+    const char *source = mSource.c_str();
+    ASSERT_TRUE(preprocessor.init(1, &source, nullptr));
+
+    size_t tokenCount = 0;
+    pp::Token token;
+    do
+    {
+        preprocessor.lex(&token);
+        tokenCount++;
+    } while (token.type != pp::Token::LAST);
+
+    mTokenCount = tokenCount;
+}
+
+void PreprocessorPerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+    printResult("tokens", mTokenCount, "tokens", false);
+}
+
+TEST_P(PreprocessorPerfTest, Run)
+{
+    run();
+}
+
+PreprocessorPerfParams ObjectMacroParams()
+{
+    PreprocessorPerfParams params;
+    params.macroCount     = 500;
+    params.statementCount = 2000;
+    params.functionMacros = false;
+    return params;
+}
+
+PreprocessorPerfParams FunctionMacroParams()
+{
+    PreprocessorPerfParams params;
+    params.macroCount     = 500;
+    params.statementCount = 2000;
+    params.functionMacros = true;
+    return params;
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        PreprocessorPerfTest,
+                        ::testing::Values(ObjectMacroParams(), FunctionMacroParams()));
+
+}  // anonymous namespace
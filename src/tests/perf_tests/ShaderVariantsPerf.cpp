@@ -0,0 +1,180 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ShaderVariantsPerf:
+//   Performance test for compiling the variants of an uber-shader, one full source at a time or
+//   all together with sh::CompileVariants().
+//
+
+#include <sstream>
+
+#include "ANGLEPerfTest.h"
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace
+{
+
+struct ShaderVariantsPerfParams final
+{
+    std::string suffix() const { return compileVariants ? "_variants" : "_separate"; }
+
+    bool compileVariants;
+};
+
+std::ostream &operator<<(std::ostream &stream, const ShaderVariantsPerfParams &param)
+{
+    stream << param.suffix().substr(1);
+    return stream;
+}
+
+// A lighting shader with optional features. The engine also defines macros that this shader
+// doesn't use, so some of the variants preprocess to the same source.
+std::string GenerateBody()
+{
+    std::stringstream source;
+    source << "precision mediump float;\n"
+              "uniform vec4 lights[LIGHT_COUNT];\n"
+              "#ifdef USE_FOG\n"
+              "uniform vec4 fogColor;\n"
+              "#endif\n"
+              "varying vec3 normal;\n";
+    for (int i = 0; i < 40; ++i)
+    {
+        source << "vec4 shade" << i << "(vec4 color, vec3 n) {\n"
+               << "    vec4 result = color * " << i << ".0;\n"
+               << "    for (int j = 0; j < LIGHT_COUNT; ++j) {\n"
+               << "        result += lights[j] * max(dot(n, lights[j].xyz), 0.0);\n"
+               << "    }\n"
+               << "#ifdef USE_FOG\n"
+               << "    result = mix(result, fogColor, 0.5);\n"
+               << "#endif\n"
+               << "    return result;\n"
+               << "}\n";
+    }
+    source << "void main() {\n"
+              "    vec4 color = vec4(1.0);\n";
+    for (int i = 0; i < 40; ++i)
+    {
+        source << "    color = shade" << i << "(color, normalize(normal));\n";
+    }
+    source << "    gl_FragColor = color;\n"
+              "}\n";
+    return source.str();
+}
+
+class ShaderVariantsPerfTest : public ANGLEPerfTest,
+                               public ::testing::WithParamInterface<ShaderVariantsPerfParams>
+{
+  public:
+    ShaderVariantsPerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    ShHandle mCompiler;
+    ShShaderVariantSet mVariantSet;
+    std::vector<std::string> mFullSources;
+    ShVariantStatistics mStatistics;
+};
+
+ShaderVariantsPerfTest::ShaderVariantsPerfTest()
+    : ANGLEPerfTest("ShaderVariantsPerf", GetParam().suffix()), mCompiler(nullptr), mStatistics()
+{
+    mRunTimeSeconds = 3.0;
+}
+
+void ShaderVariantsPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    ASSERT_TRUE(sh::Initialize());
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    mCompiler =
+        sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, mCompiler);
+
+    mVariantSet.body = GenerateBody();
+    for (int lightCount = 1; lightCount <= 4; ++lightCount)
+    {
+        for (int features = 0; features < 8; ++features)
+        {
+            ShShaderVariant variant;
+            variant.name = std::to_string(lightCount) + "_" + std::to_string(features);
+            variant.defines.push_back(std::make_pair("LIGHT_COUNT", std::to_string(lightCount)));
+            if (features & 1)
+                variant.defines.push_back(std::make_pair("USE_FOG", "1"));
+            if (features & 2)
+                variant.defines.push_back(std::make_pair("USE_SHADOWS", "1"));
+            if (features & 4)
+                variant.defines.push_back(std::make_pair("USE_SKINNING", "1"));
+
+            std::string fullSource;
+            for (const auto &define : variant.defines)
+            {
+                fullSource += "#define " + define.first + " " + define.second + "\n";
+            }
+            mFullSources.push_back(fullSource + mVariantSet.body);
+            mVariantSet.variants.push_back(variant);
+        }
+    }
+}
+
+void ShaderVariantsPerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    if (GetParam().compileVariants)
+    {
+        printResult("compiled_variants", mStatistics.compiledVariantCount, "variants", false);
+        printResult("dedup_rate", mStatistics.dedupRate * 100.0, "%", false);
+    }
+
+    sh::Destruct(mCompiler);
+    sh::Finalize();
+}
+
+void ShaderVariantsPerfTest::step()
+{
+    if (GetParam().compileVariants)
+    {
+        std::vector<ShBatchResult> results;
+        if (!sh::CompileVariants(mCompiler, mVariantSet, SH_OBJECT_CODE, &results, &mStatistics))
+        {
+            abortTest();
+        }
+        return;
+    }
+
+    for (const std::string &fullSource : mFullSources)
+    {
+        const char *source = fullSource.c_str();
+        if (!sh::Compile(mCompiler, &source, 1, SH_OBJECT_CODE))
+        {
+            abortTest();
+        }
+    }
+}
+
+TEST_P(ShaderVariantsPerfTest, Run)
+{
+    run();
+}
+
+ShaderVariantsPerfParams VariantParams(bool compileVariants)
+{
+    ShaderVariantsPerfParams params;
+    params.compileVariants = compileVariants;
+    return params;
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        ShaderVariantsPerfTest,
+                        ::testing::Values(VariantParams(false), VariantParams(true)));
+
+}  // anonymous namespace
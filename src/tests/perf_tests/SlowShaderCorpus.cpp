@@ -0,0 +1,106 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SlowShaderCorpus.cpp:
+//   The slow shader corpus. To add a shader that translator_fuzzer reported, paste the entry from
+//   its report, give it a name and make it small enough that translating it takes milliseconds,
+//   not seconds.
+//
+
+#include "SlowShaderCorpus.h"
+
+#include "common/angleutils.h"
+
+namespace
+{
+
+// Nested blocks, parentheses and ternary operators. The parser stack limits how deep they go.
+const char kDeepNestingSource[] =
+    "precision mediump float;\n"
+    "uniform float u;\n"
+    "#define IF4 if (x > u) { if (x < 4.0) { if (x != 1.0) { if (x > 0.5) {\n"
+    "#define END4 x += u; } x *= u; } x -= u; } x += 1.0; }\n"
+    "#define OPEN10 ((((((((((\n"
+    "#define CLOSE10 * u) * u) * u) * u) * u) * u) * u) * u) * u) * u)\n"
+    "#define COND4(a) (x > 0.0 ? (x > 1.0 ? (x > 2.0 ? (x > 3.0 ? a : u) : u) : u) : u)\n"
+    "void main()\n"
+    "{\n"
+    "    float x = u;\n"
+    "    for (int i = 0; i < 4; ++i)\n"
+    "    {\n"
+    "        for (int j = 0; j < 4; ++j)\n"
+    "        {\n"
+    "            IF4 IF4 IF4 IF4\n"
+    "            x = OPEN10 OPEN10 OPEN10 OPEN10 x CLOSE10 CLOSE10 CLOSE10 CLOSE10;\n"
+    "            x = COND4(COND4(COND4(x)));\n"
+    "            END4 END4 END4 END4\n"
+    "        }\n"
+    "    }\n"
+    "    gl_FragColor = vec4(x);\n"
+    "}\n";
+
+// Each macro expands the previous one twice, so the expression has 4096 operands.
+const char kMacroExpansionSource[] =
+    "precision mediump float;\n"
+    "uniform float u;\n"
+    "#define E0 u\n"
+    "#define E1 (E0 * E0)\n"
+    "#define E2 (E1 * E1)\n"
+    "#define E3 (E2 * E2)\n"
+    "#define E4 (E3 * E3)\n"
+    "#define E5 (E4 * E4)\n"
+    "#define E6 (E5 * E5)\n"
+    "#define E7 (E6 * E6)\n"
+    "#define E8 (E7 * E7)\n"
+    "#define E9 (E8 * E8)\n"
+    "#define E10 (E9 * E9)\n"
+    "#define E11 (E10 * E10)\n"
+    "#define E12 (E11 * E11)\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = vec4(E12);\n"
+    "}\n";
+
+// A constant array that is indexed both with a constant and with a dynamic index.
+const char kConstantArraySource[] =
+    "#version 300 es\n"
+    "precision highp float;\n"
+    "#define R4 0.25, 0.5, 0.75, 1.0\n"
+    "#define R16 R4, R4, R4, R4\n"
+    "#define R64 R16, R16, R16, R16\n"
+    "#define R1024 R64, R64, R64, R64, R64, R64, R64, R64, R64, R64, R64, R64, R64, R64, R64, R64\n"
+    "uniform int index;\n"
+    "out vec4 color;\n"
+    "void main()\n"
+    "{\n"
+    "    const float kTable[1024] = float[1024](R1024);\n"
+    "    float sum = kTable[512];\n"
+    "    for (int i = 0; i < 4; ++i)\n"
+    "    {\n"
+    "        sum += kTable[index + i];\n"
+    "    }\n"
+    "    color = vec4(sum);\n"
+    "}\n";
+
+}  // anonymous namespace
+
+const SlowShader kSlowShaderCorpus[] = {
+    {"deep_nesting", GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, SH_OBJECT_CODE,
+     kDeepNestingSource},
+    {"macro_expansion", GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_GLSL_COMPATIBILITY_OUTPUT,
+     SH_OBJECT_CODE, kMacroExpansionSource},
+    {"constant_array", GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_ESSL_OUTPUT, SH_OBJECT_CODE,
+     kConstantArraySource},
+#if defined(ANGLE_ENABLE_HLSL)
+    {"deep_nesting_hlsl", GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_HLSL_4_1_OUTPUT, SH_OBJECT_CODE,
+     kDeepNestingSource},
+    {"macro_expansion_hlsl", GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_HLSL_4_1_OUTPUT,
+     SH_OBJECT_CODE, kMacroExpansionSource},
+    {"constant_array_hlsl", GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_HLSL_4_1_OUTPUT, SH_OBJECT_CODE,
+     kConstantArraySource},
+#endif  // defined(ANGLE_ENABLE_HLSL)
+};
+
+const size_t kSlowShaderCorpusSize = ArraySize(kSlowShaderCorpus);
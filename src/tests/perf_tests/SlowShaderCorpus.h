@@ -0,0 +1,33 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SlowShaderCorpus.h:
+//   Shaders that have taken the translator a long time or a lot of memory, kept to catch
+//   regressions. translator_fuzzer reports new ones in the format of the entries.
+//
+
+#ifndef PERF_TESTS_SLOW_SHADER_CORPUS_H_
+#define PERF_TESTS_SLOW_SHADER_CORPUS_H_
+
+#include <stddef.h>
+
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+
+struct SlowShader
+{
+    // Names the perf test that translates the shader.
+    const char *name;
+    GLenum type;
+    ShShaderSpec spec;
+    ShShaderOutput output;
+    ShCompileOptions compileOptions;
+    const char *source;
+};
+
+extern const SlowShader kSlowShaderCorpus[];
+extern const size_t kSlowShaderCorpusSize;
+
+#endif  // PERF_TESTS_SLOW_SHADER_CORPUS_H_
@@ -0,0 +1,114 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SymbolTablePerf:
+//   Performance test for symbol resolution in the parser, on a shader with thousands of
+//   identifiers and function calls.
+//
+
+#include <sstream>
+
+#include "ANGLEPerfTest.h"
+#include "angle_gl.h"
+#include "GLSLANG/ShaderLang.h"
+
+namespace
+{
+
+// Globals, locals, user function calls and built-in calls, so that lookups hit every level of the
+// symbol table.
+std::string GenerateShaderSource(int functionCount)
+{
+    std::stringstream source;
+    source << "precision mediump float;\n"
+              "uniform vec4 u[8];\n";
+    for (int i = 0; i < functionCount; ++i)
+    {
+        source << "float g" << i << " = " << i << ".0;\n";
+    }
+    for (int i = 0; i < functionCount; ++i)
+    {
+        source << "vec4 f" << i << "(vec4 a, float b) {\n"
+               << "    float l" << i << " = g" << i << " * b + sin(b);\n"
+               << "    vec4 m" << i << " = a * l" << i << " + vec4(dot(a.xyz, vec3(g"
+               << (i * 7) % functionCount << ")), clamp(b, 0.0, 1.0), max(l" << i << ", g"
+               << (i * 3) % functionCount << "), mix(b, l" << i << ", 0.5));\n";
+        if (i > 0)
+        {
+            source << "    m" << i << " += f" << i - 1 << "(m" << i << ", l" << i << ");\n";
+        }
+        source << "    return normalize(m" << i << ") * length(m" << i << ".xy) + abs(a);\n"
+               << "}\n";
+    }
+    source << "void main() {\n"
+              "    vec4 v = u[0];\n";
+    for (int i = 0; i < functionCount; i += 3)
+    {
+        source << "    v = f" << i << "(v, g" << i << ") + f" << (i + 1) % functionCount
+               << "(v.wzyx, pow(g" << i << ", 2.0));\n";
+    }
+    source << "    gl_FragColor = v;\n"
+              "}\n";
+    return source.str();
+}
+
+class SymbolTablePerfTest : public ANGLEPerfTest
+{
+  public:
+    SymbolTablePerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    ShHandle mCompiler;
+    std::string mSource;
+};
+
+SymbolTablePerfTest::SymbolTablePerfTest()
+    : ANGLEPerfTest("SymbolTablePerf", "_parse"),
+      mCompiler(nullptr),
+      mSource(GenerateShaderSource(600))
+{
+    mRunTimeSeconds = 3.0;
+}
+
+void SymbolTablePerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    ASSERT_TRUE(sh::Initialize());
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+    mCompiler =
+        sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES2_SPEC, SH_ESSL_OUTPUT, &resources);
+    ASSERT_NE(nullptr, mCompiler);
+}
+
+void SymbolTablePerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    sh::Destruct(mCompiler);
+    sh::Finalize();
+}
+
+void SymbolTablePerfTest::step()
+{
+    // No object code, so that parsing, and the lookups in it, dominate.
+    const char *source = mSource.c_str();
+    if (!sh::Compile(mCompiler, &source, 1, 0))
+    {
+        abortTest();
+    }
+}
+
+TEST_F(SymbolTablePerfTest, Run)
+{
+    run();
+}
+
+}  // anonymous namespace
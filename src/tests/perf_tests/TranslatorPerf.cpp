@@ -0,0 +1,119 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslatorPerf:
+//   Performance test for translating the shaders of the slow shader corpus, to catch shaders that
+//   become slow again.
+//
+
+#include "ANGLEPerfTest.h"
+#include "SlowShaderCorpus.h"
+
+namespace
+{
+
+std::string SlowShaderSuffix(const SlowShader &shader)
+{
+    return std::string("_") + shader.name;
+}
+
+std::ostream &operator<<(std::ostream &stream, const SlowShader &shader)
+{
+    stream << shader.name;
+    return stream;
+}
+
+class TranslatorPerfTest : public ANGLEPerfTest, public ::testing::WithParamInterface<SlowShader>
+{
+  public:
+    TranslatorPerfTest();
+
+    void SetUp() override;
+    void TearDown() override;
+    void step() override;
+
+  private:
+    ShHandle mCompiler;
+    size_t mPoolAllocatedBytes;
+    size_t mASTNodeCount;
+};
+
+TranslatorPerfTest::TranslatorPerfTest()
+    : ANGLEPerfTest("TranslatorPerf", SlowShaderSuffix(GetParam())),
+      mCompiler(nullptr),
+      mPoolAllocatedBytes(0),
+      mASTNodeCount(0)
+{
+    mRunTimeSeconds = 3.0;
+}
+
+void TranslatorPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const SlowShader &shader = GetParam();
+
+    ASSERT_TRUE(sh::Initialize());
+    ShBuiltInResources resources;
+    sh::InitBuiltInResources(&resources);
+
+    // The extensions that translator_fuzzer enables, so that the shaders it reports translate the
+    // same way here.
+    resources.OES_standard_derivatives        = 1;
+    resources.OES_EGL_image_external          = 1;
+    resources.OES_EGL_image_external_essl3    = 1;
+    resources.NV_EGL_stream_consumer_external = 1;
+    resources.ARB_texture_rectangle           = 1;
+    resources.EXT_blend_func_extended         = 1;
+    resources.EXT_draw_buffers                = 1;
+    resources.EXT_frag_depth                  = 1;
+    resources.EXT_shader_texture_lod          = 1;
+    resources.WEBGL_debug_shader_precision    = 1;
+    resources.EXT_shader_framebuffer_fetch    = 1;
+    resources.NV_shader_framebuffer_fetch     = 1;
+    resources.ARM_shader_framebuffer_fetch    = 1;
+    resources.MaxDualSourceDrawBuffers        = 1;
+
+    mCompiler = sh::ConstructCompiler(shader.type, shader.spec, shader.output, &resources);
+    ASSERT_NE(nullptr, mCompiler);
+
+    // Measure the memory once. Shaders from the fuzzer don't need to be valid, so the result of
+    // the compilation isn't checked.
+    const char *source = shader.source;
+    sh::Compile(mCompiler, &source, 1, shader.compileOptions | SH_COLLECT_COMPILE_STATISTICS);
+    const ShCompileStatistics *statistics = sh::GetCompileStatistics(mCompiler);
+    ASSERT_NE(nullptr, statistics);
+    mPoolAllocatedBytes = statistics->poolAllocatedBytes;
+    mASTNodeCount       = statistics->astNodeCount;
+}
+
+void TranslatorPerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    printResult("pool_allocated", mPoolAllocatedBytes, "bytes", false);
+    printResult("ast_nodes", mASTNodeCount, "nodes", false);
+
+    sh::Destruct(mCompiler);
+    sh::Finalize();
+}
+
+void TranslatorPerfTest::step()
+{
+    const char *source = GetParam().source;
+    sh::Compile(mCompiler, &source, 1, GetParam().compileOptions);
+}
+
+TEST_P(TranslatorPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        TranslatorPerfTest,
+                        ::testing::ValuesIn(kSlowShaderCorpus,
+                                            kSlowShaderCorpus + kSlowShaderCorpusSize));
+
+}  // anonymous namespace
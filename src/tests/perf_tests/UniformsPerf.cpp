@@ -4,7 +4,8 @@
 // found in the LICENSE file.
 //
 // UniformsBenchmark:
-//   Performance test for setting uniform data.
+//   Performance test for setting uniform data, optionally looking up every location by name first
+//   like applications that don't cache them.
 //
 
 #include "ANGLEPerfTest.h"
@@ -33,12 +34,16 @@ struct UniformsParams final : public RenderTestParams
 
         numVertexUniforms   = 200;
         numFragmentUniforms = 200;
+        lookUpLocations     = false;
     }
 
     std::string suffix() const override;
     size_t numVertexUniforms;
     size_t numFragmentUniforms;
 
+    // Call glGetUniformLocation for every uniform on every iteration.
+    bool lookUpLocations;
+
     // static parameters
     size_t iterations;
 };
@@ -57,6 +62,11 @@ std::string UniformsParams::suffix() const
     strstr << "_" << numVertexUniforms << "_vertex_uniforms";
     strstr << "_" << numFragmentUniforms << "_fragment_uniforms";
 
+    if (lookUpLocations)
+    {
+        strstr << "_lookup";
+    }
+
     return strstr.str();
 }
 
@@ -76,6 +86,7 @@ class UniformsBenchmark : public ANGLERenderTest,
     void initTextures();
 
     GLuint mProgram;
+    std::vector<std::string> mUniformNames;
     std::vector<GLuint> mUniformLocations;
 };
 
@@ -159,13 +170,15 @@ void UniformsBenchmark::initShaders()
 
     for (size_t i = 0; i < params.numVertexUniforms; ++i)
     {
-        GLint location = glGetUniformLocation(mProgram, GetUniformLocationName(i, true).c_str());
-        ASSERT_NE(-1, location);
-        mUniformLocations.push_back(location);
+        mUniformNames.push_back(GetUniformLocationName(i, true));
     }
     for (size_t i = 0; i < params.numFragmentUniforms; ++i)
     {
-        GLint location = glGetUniformLocation(mProgram, GetUniformLocationName(i, false).c_str());
+        mUniformNames.push_back(GetUniformLocationName(i, false));
+    }
+    for (const std::string &name : mUniformNames)
+    {
+        GLint location = glGetUniformLocation(mProgram, name.c_str());
         ASSERT_NE(-1, location);
         mUniformLocations.push_back(location);
     }
@@ -187,8 +200,14 @@ void UniformsBenchmark::drawBenchmark()
     {
         for (size_t uniform = 0; uniform < mUniformLocations.size(); ++uniform)
         {
+            GLint location = mUniformLocations[uniform];
+            if (params.lookUpLocations)
+            {
+                location = glGetUniformLocation(mProgram, mUniformNames[uniform].c_str());
+            }
+
             float value = static_cast<float>(uniform);
-            glUniform4f(mUniformLocations[uniform], value, value, value, value);
+            glUniform4f(location, value, value, value, value);
         }
 
         glDrawArrays(GL_TRIANGLES, 0, 3);
@@ -218,6 +237,14 @@ UniformsParams OpenGLParams()
     return params;
 }
 
+UniformsParams NullLookUpParams()
+{
+    UniformsParams params;
+    params.eglParameters   = EGLPlatformParameters(EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE);
+    params.lookUpLocations = true;
+    return params;
+}
+
 }  // anonymous namespace
 
 TEST_P(UniformsBenchmark, Run)
@@ -225,4 +252,8 @@ TEST_P(UniformsBenchmark, Run)
     run();
 }
 
-ANGLE_INSTANTIATE_TEST(UniformsBenchmark, D3D11Params(), D3D9Params(), OpenGLParams());
+ANGLE_INSTANTIATE_TEST(UniformsBenchmark,
+                       D3D11Params(),
+                       D3D9Params(),
+                       OpenGLParams(),
+                       NullLookUpParams());
@@ -0,0 +1,114 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// VariablePackerPerf:
+//   Performance test for the translator's check of the uniform and varying packing limits, with
+//   hundreds to thousands of variables.
+//
+
+#include <sstream>
+
+#include "ANGLEPerfTest.h"
+#include "angle_gl.h"
+#include "compiler/translator/VariablePacker.h"
+
+namespace
+{
+
+struct VariablePackerPerfParams final
+{
+    std::string suffix() const
+    {
+        std::stringstream strstr;
+        strstr << "_" << maxVectors << "_vectors";
+        return strstr.str();
+    }
+
+    unsigned int maxVectors;
+};
+
+std::ostream &operator<<(std::ostream &stream, const VariablePackerPerfParams &param)
+{
+    stream << param.suffix().substr(1);
+    return stream;
+}
+
+// Eight variables for every four vectors, so that the variables fill nearly all of them and most
+// of the time goes into placing the one-component variables.
+std::vector<sh::ShaderVariable> GenerateVariables(unsigned int maxVectors)
+{
+    const GLenum kTypes[] = {GL_FLOAT_VEC3, GL_FLOAT_VEC2, GL_INT_VEC2, GL_FLOAT,
+                             GL_FLOAT,      GL_INT,        GL_BOOL,     GL_FLOAT};
+
+    const unsigned int kArraySizes[] = {0, 0, 0, 0, 2, 0, 0, 3};
+
+    std::vector<sh::ShaderVariable> variables;
+    for (unsigned int index = 0; index < maxVectors * 2; ++index)
+    {
+        sh::ShaderVariable variable(kTypes[index % 8], kArraySizes[index % 8]);
+        std::stringstream strstr;
+        strstr << "v" << index;
+        variable.name       = strstr.str();
+        variable.mappedName = variable.name;
+        variable.staticUse  = true;
+        variables.push_back(variable);
+    }
+    return variables;
+}
+
+class VariablePackerPerfTest : public ANGLEPerfTest,
+                               public ::testing::WithParamInterface<VariablePackerPerfParams>
+{
+  public:
+    VariablePackerPerfTest();
+
+    void SetUp() override;
+    void step() override;
+
+  private:
+    std::vector<sh::ShaderVariable> mVariables;
+};
+
+VariablePackerPerfTest::VariablePackerPerfTest()
+    : ANGLEPerfTest("VariablePackerPerf", GetParam().suffix())
+{
+    mRunTimeSeconds = 3.0;
+}
+
+void VariablePackerPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    mVariables = GenerateVariables(GetParam().maxVectors);
+    VariablePacker packer;
+    ASSERT_TRUE(packer.CheckVariablesWithinPackingLimits(GetParam().maxVectors, mVariables));
+}
+
+void VariablePackerPerfTest::step()
+{
+    VariablePacker packer;
+    if (!packer.CheckVariablesWithinPackingLimits(GetParam().maxVectors, mVariables))
+    {
+        abortTest();
+    }
+}
+
+TEST_P(VariablePackerPerfTest, Run)
+{
+    run();
+}
+
+VariablePackerPerfParams PackerParams(unsigned int maxVectors)
+{
+    VariablePackerPerfParams params;
+    params.maxVectors = maxVectors;
+    return params;
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        VariablePackerPerfTest,
+                        ::testing::Values(PackerParams(256), PackerParams(1024)));
+
+}  // anonymous namespace
@@ -0,0 +1,132 @@
+//
+// Copyright 2016 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// VaryingPackingPerf:
+//   Performance test for the D3D varying packing at link time, with register counts well past
+//   those of current hardware so that the cost of finding free registers shows.
+//
+
+#include <sstream>
+
+#include "ANGLEPerfTest.h"
+#include "libANGLE/Program.h"
+#include "libANGLE/renderer/d3d/hlsl/VaryingPacking.h"
+
+namespace
+{
+
+struct VaryingPackingPerfParams final
+{
+    std::string suffix() const
+    {
+        std::stringstream strstr;
+        strstr << "_" << maxVaryingVectors << "_vectors";
+        return strstr.str();
+    }
+
+    GLuint maxVaryingVectors;
+};
+
+std::ostream &operator<<(std::ostream &stream, const VaryingPackingPerfParams &param)
+{
+    stream << param.suffix().substr(1);
+    return stream;
+}
+
+void AddVaryings(std::vector<sh::Varying> *varyings, GLenum type, size_t count, size_t arraySize)
+{
+    for (size_t index = 0; index < count; ++index)
+    {
+        std::stringstream strstr;
+        strstr << "v" << varyings->size();
+
+        sh::Varying varying;
+        varying.type          = type;
+        varying.precision     = GL_MEDIUM_FLOAT;
+        varying.name          = strstr.str();
+        varying.mappedName    = strstr.str();
+        varying.arraySize     = static_cast<unsigned int>(arraySize);
+        varying.staticUse     = true;
+        varying.interpolation = sh::INTERPOLATION_SMOOTH;
+        varying.isInvariant   = false;
+        varyings->push_back(varying);
+    }
+}
+
+class VaryingPackingPerfTest : public ANGLEPerfTest,
+                               public ::testing::WithParamInterface<VaryingPackingPerfParams>
+{
+  public:
+    VaryingPackingPerfTest();
+
+    void SetUp() override;
+    void step() override;
+
+  private:
+    bool packVaryings();
+
+    std::vector<sh::Varying> mVaryings;
+    std::vector<rx::PackedVarying> mPackedVaryings;
+};
+
+VaryingPackingPerfTest::VaryingPackingPerfTest()
+    : ANGLEPerfTest("VaryingPackingPerf", GetParam().suffix())
+{
+    mRunTimeSeconds = 3.0;
+}
+
+void VaryingPackingPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    // In the order of the packing rules, filling most of the registers and leaving most of the
+    // work to the one-component varyings.
+    const size_t quarter = GetParam().maxVaryingVectors / 4;
+    AddVaryings(&mVaryings, GL_FLOAT_VEC3, quarter, 0);
+    AddVaryings(&mVaryings, GL_FLOAT_VEC2, quarter * 2, 0);
+    AddVaryings(&mVaryings, GL_FLOAT, quarter / 2, 3);
+    AddVaryings(&mVaryings, GL_FLOAT, quarter / 2, 2);
+    AddVaryings(&mVaryings, GL_FLOAT, quarter * 6, 0);
+
+    for (const sh::Varying &varying : mVaryings)
+    {
+        mPackedVaryings.push_back(rx::PackedVarying(varying, varying.interpolation));
+    }
+    ASSERT_TRUE(packVaryings());
+}
+
+bool VaryingPackingPerfTest::packVaryings()
+{
+    rx::VaryingPacking varyingPacking(GetParam().maxVaryingVectors);
+    gl::InfoLog infoLog;
+    std::vector<std::string> transformFeedbackVaryings;
+    return varyingPacking.packUserVaryings(infoLog, mPackedVaryings, transformFeedbackVaryings);
+}
+
+void VaryingPackingPerfTest::step()
+{
+    if (!packVaryings())
+    {
+        abortTest();
+    }
+}
+
+TEST_P(VaryingPackingPerfTest, Run)
+{
+    run();
+}
+
+VaryingPackingPerfParams PackingParams(GLuint maxVaryingVectors)
+{
+    VaryingPackingPerfParams params;
+    params.maxVaryingVectors = maxVaryingVectors;
+    return params;
+}
+
+INSTANTIATE_TEST_CASE_P(,
+                        VaryingPackingPerfTest,
+                        ::testing::Values(PackingParams(32), PackingParams(256)));
+
+}  // anonymous namespace
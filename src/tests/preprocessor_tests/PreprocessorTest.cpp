@@ -52,16 +52,16 @@ void SimplePreprocessorTest::preprocess(const char *input, const char *expected)
 
 void SimplePreprocessorTest::lexSingleToken(const char *input, pp::Token *token)
 {
-    pp::Preprocessor preprocessor(&mDiagnostics, &mDirectiveHandler, pp::PreprocessorSettings());
-    ASSERT_TRUE(preprocessor.init(1, &input, nullptr));
-    preprocessor.lex(token);
+    lexSingleToken(1, &input, token);
 }
 
 void SimplePreprocessorTest::lexSingleToken(size_t count,
                                             const char *const input[],
                                             pp::Token *token)
 {
-    pp::Preprocessor preprocessor(&mDiagnostics, &mDirectiveHandler, pp::PreprocessorSettings());
-    ASSERT_TRUE(preprocessor.init(count, input, nullptr));
-    preprocessor.lex(token);
+    // The token's text belongs to the preprocessor, so it is kept alive until the next call.
+    mLexPreprocessor.reset(
+        new pp::Preprocessor(&mDiagnostics, &mDirectiveHandler, pp::PreprocessorSettings()));
+    ASSERT_TRUE(mLexPreprocessor->init(count, input, nullptr));
+    mLexPreprocessor->lex(token);
 }
\ No newline at end of file
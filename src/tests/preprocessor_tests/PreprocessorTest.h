@@ -4,6 +4,8 @@
 // found in the LICENSE file.
 //
 
+#include <memory>
+
 #include "gtest/gtest.h"
 
 #include "MockDiagnostics.h"
@@ -45,6 +47,8 @@ class SimplePreprocessorTest : public testing::Test
 
   private:
     void preprocess(const char *input, std::stringstream *output, pp::Preprocessor *preprocessor);
+
+    std::unique_ptr<pp::Preprocessor> mLexPreprocessor;
 };
 
 #endif  // PREPROCESSOR_TESTS_PREPROCESSOR_TEST_H_
@@ -46,7 +46,7 @@ TEST_F(BlockCommentTest, CommentReplacedWithSpace)
     pp::Token token;
     lexSingleToken(str, &token);
     EXPECT_EQ(pp::Token::IDENTIFIER, token.type);
-    EXPECT_EQ("bar", token.text);
+    EXPECT_EQ("bar", token.text());
     EXPECT_TRUE(token.hasLeadingSpace());
 }
 
@@ -855,7 +855,7 @@ TEST_F(DefineTest, Predefined_LINE1)
     pp::Token token;
     lexSingleToken(str, &token);
     EXPECT_EQ(pp::Token::CONST_INT, token.type);
-    EXPECT_EQ("3", token.text);
+    EXPECT_EQ("3", token.text());
 }
 
 TEST_F(DefineTest, Predefined_LINE2)
@@ -866,7 +866,7 @@ TEST_F(DefineTest, Predefined_LINE2)
     pp::Token token;
     lexSingleToken(str, &token);
     EXPECT_EQ(pp::Token::CONST_INT, token.type);
-    EXPECT_EQ("10", token.text);
+    EXPECT_EQ("10", token.text());
 }
 
 TEST_F(DefineTest, Predefined_FILE1)
@@ -876,7 +876,7 @@ TEST_F(DefineTest, Predefined_FILE1)
     pp::Token token;
     lexSingleToken(3, str, &token);
     EXPECT_EQ(pp::Token::CONST_INT, token.type);
-    EXPECT_EQ("2", token.text);
+    EXPECT_EQ("2", token.text());
 }
 
 TEST_F(DefineTest, Predefined_FILE2)
@@ -886,7 +886,7 @@ TEST_F(DefineTest, Predefined_FILE2)
     pp::Token token;
     lexSingleToken(2, str, &token);
     EXPECT_EQ(pp::Token::CONST_INT, token.type);
-    EXPECT_EQ("21", token.text);
+    EXPECT_EQ("21", token.text());
 }
 
 // Defined operator produced by macro expansion should be parsed inside #if directives
@@ -19,7 +19,7 @@ protected:
         pp::Token token;
         lexSingleToken(cstr, &token);
         EXPECT_EQ(pp::Token::IDENTIFIER, token.type);
-        EXPECT_EQ(str, token.text);
+        EXPECT_EQ(str, token.text());
     }
 };
 
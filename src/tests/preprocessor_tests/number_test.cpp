@@ -45,7 +45,7 @@ TEST_P(IntegerTest, Identified)
     pp::Token token;
     lexSingleToken(cstr, &token);
     EXPECT_EQ(pp::Token::CONST_INT, token.type);
-    EXPECT_EQ(str, token.text);
+    EXPECT_EQ(str, token.text());
 }
 
 INSTANTIATE_TEST_CASE_P(DecimalInteger,
@@ -83,7 +83,7 @@ class FloatTest : public SimplePreprocessorTest
         pp::Token token;
         lexSingleToken(cstr, &token);
         EXPECT_EQ(pp::Token::CONST_FLOAT, token.type);
-        EXPECT_EQ(str, token.text);
+        EXPECT_EQ(str, token.text());
     }
 };
 
@@ -25,7 +25,7 @@ TEST_P(OperatorTest, Identified)
     pp::Token token;
     lexSingleToken(param.str, &token);
     EXPECT_EQ(param.op, token.type);
-    EXPECT_EQ(param.str, token.text);
+    EXPECT_EQ(param.str, token.text());
 }
 
 static const OperatorTestParam kOperators[] = {
@@ -6,6 +6,7 @@
 
 #include "gtest/gtest.h"
 
+#include "compiler/preprocessor/StringTable.h"
 #include "compiler/preprocessor/Token.h"
 
 TEST(TokenTest, DefaultConstructor)
@@ -15,28 +16,30 @@ TEST(TokenTest, DefaultConstructor)
     EXPECT_EQ(0u, token.flags);
     EXPECT_EQ(0, token.location.line);
     EXPECT_EQ(0, token.location.file);
-    EXPECT_EQ("", token.text);
+    EXPECT_EQ("", token.text());
 }
 
 TEST(TokenTest, Assignment)
 {
+    pp::StringTable strings;
     pp::Token token;
     token.type = 1;
     token.flags = 1;
     token.location.line = 1;
     token.location.file = 1;
-    token.text.assign("foo");
+    token.setText(strings.intern("foo"));
 
     token = pp::Token();
     EXPECT_EQ(0, token.type);
     EXPECT_EQ(0u, token.flags);
     EXPECT_EQ(0, token.location.line);
     EXPECT_EQ(0, token.location.file);
-    EXPECT_EQ("", token.text);
+    EXPECT_EQ("", token.text());
 }
 
 TEST(TokenTest, Equals)
 {
+    pp::StringTable strings;
     pp::Token token;
     EXPECT_TRUE(token.equals(pp::Token()));
 
@@ -56,9 +59,9 @@ TEST(TokenTest, Equals)
     EXPECT_FALSE(token.equals(pp::Token()));
     token.location.file = 0;
 
-    token.text.assign("foo");
+    token.setText(strings.intern("foo"));
     EXPECT_FALSE(token.equals(pp::Token()));
-    token.text.clear();
+    token.setText(nullptr);
 
     EXPECT_TRUE(token.equals(pp::Token()));
 }
@@ -75,8 +78,9 @@ TEST(TokenTest, HasLeadingSpace)
 
 TEST(TokenTest, Write)
 {
+    pp::StringTable strings;
     pp::Token token;
-    token.text.assign("foo");
+    token.setText(strings.intern("foo"));
     std::stringstream out1;
     out1 << token;
     EXPECT_TRUE(out1.good());
@@ -88,3 +92,21 @@ TEST(TokenTest, Write)
     EXPECT_TRUE(out2.good());
     EXPECT_EQ(" foo", out2.str());
 }
+
+TEST(TokenTest, InternedText)
+{
+    pp::StringTable strings;
+    pp::Token token1;
+    token1.setText(strings.intern("foo"));
+    pp::Token token2;
+    token2.setText(strings.intern(std::string("fo") + "o"));
+    EXPECT_EQ(token1.internedText(), token2.internedText());
+    EXPECT_NE(token1.internedText(), strings.intern("bar"));
+
+    // Text interned in different tables is still equal.
+    pp::StringTable otherStrings;
+    pp::Token token3;
+    token3.setText(otherStrings.intern("foo"));
+    EXPECT_NE(token1.internedText(), token3.internedText());
+    EXPECT_TRUE(token1.equals(token3));
+}
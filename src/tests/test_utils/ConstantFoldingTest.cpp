@@ -51,6 +51,11 @@ bool ConstantFoldingTest::hasWarning()
     return infoSink.info.str().find("WARNING:") != std::string::npos;
 }
 
+std::string ConstantFoldingTest::getInfoLog()
+{
+    return mTranslatorESSL->getInfoSink().info.str();
+}
+
 void ConstantFoldingExpressionTest::evaluateFloat(const std::string &floatExpression)
 {
     std::stringstream shaderStream;
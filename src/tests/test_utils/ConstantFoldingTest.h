@@ -147,6 +147,9 @@ class ConstantFoldingTest : public testing::Test
     // Must be called after compile()
     bool hasWarning();
 
+    // Must be called after compile()
+    std::string getInfoLog();
+
     template <typename T>
     bool constantFoundInAST(T constant)
     {
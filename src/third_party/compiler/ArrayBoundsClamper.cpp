@@ -46,9 +46,9 @@ namespace
 
 class ArrayBoundsClamperMarker : public TIntermTraverser {
 public:
-    ArrayBoundsClamperMarker()
+    ArrayBoundsClamperMarker(bool *needsClamp)
         : TIntermTraverser(true, false, false),
-          mNeedsClamp(false)
+          mNeedsClamp(needsClamp)
    {
    }
 
@@ -60,16 +60,14 @@ public:
            if (left->isArray() || left->isVector() || left->isMatrix())
            {
                node->setAddIndexClamp();
-               mNeedsClamp = true;
+               *mNeedsClamp = true;
            }
        }
        return true;
    }
 
-    bool GetNeedsClamp() { return mNeedsClamp; }
-
 private:
-    bool mNeedsClamp;
+    bool *mNeedsClamp;
 };
 
 }  // anonymous namespace
@@ -89,12 +87,13 @@ void ArrayBoundsClamper::MarkIndirectArrayBoundsForClamping(TIntermNode* root)
 {
     ASSERT(root);
 
-    ArrayBoundsClamperMarker clamper;
+    ArrayBoundsClamperMarker clamper(&mArrayBoundsClampDefinitionNeeded);
     root->traverse(&clamper);
-    if (clamper.GetNeedsClamp())
-    {
-        SetArrayBoundsClampDefinitionNeeded();
-    }
+}
+
+TIntermTraverser *ArrayBoundsClamper::CreateMarker()
+{
+    return new ArrayBoundsClamperMarker(&mArrayBoundsClampDefinitionNeeded);
 }
 
 void ArrayBoundsClamper::OutputClampingFunctionDefinition(TInfoSinkBase& out) const
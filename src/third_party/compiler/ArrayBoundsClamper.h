@@ -45,6 +45,10 @@ class ArrayBoundsClamper
     // requiring clamping.
     void MarkIndirectArrayBoundsForClamping(TIntermNode* root);
 
+    // Returns a traverser that does the marking, so that it can share a traversal with other
+    // passes. It is allocated from the pool allocator of the current compilation.
+    TIntermTraverser *CreateMarker();
+
     // If necessary, output array clamp function source into the shader source.
     void OutputClampingFunctionDefinition(TInfoSinkBase& out) const;
 